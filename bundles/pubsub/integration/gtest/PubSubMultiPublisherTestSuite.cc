@@ -0,0 +1,88 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "celix_launcher.h"
+#include "celix_bundle_context.h"
+#include "receive_count_service.h"
+
+/**
+ * Test suite for containers where the sut bundle publishes from multiple threads
+ * (CELIX_PUBSUB_TEST_NR_OF_PUBLISHER_THREADS) without a send interval.
+ */
+class PubSubMultiPublisherTestSuite : public ::testing::Test {
+public:
+    PubSubMultiPublisherTestSuite() {
+        celixLauncher_launch("config.properties", &fw);
+        ctx = celix_framework_getFrameworkContext(fw);
+    }
+
+    ~PubSubMultiPublisherTestSuite() override {
+        celixLauncher_stop(fw);
+        celixLauncher_waitForShutdown(fw);
+        celixLauncher_destroy(fw);
+    }
+
+    PubSubMultiPublisherTestSuite(const PubSubMultiPublisherTestSuite&) = delete;
+    PubSubMultiPublisherTestSuite(PubSubMultiPublisherTestSuite&&) = delete;
+    PubSubMultiPublisherTestSuite& operator=(const PubSubMultiPublisherTestSuite&) = delete;
+    PubSubMultiPublisherTestSuite& operator=(PubSubMultiPublisherTestSuite&&) = delete;
+
+    int receiveCount() {
+        int count = 0;
+        celix_bundleContext_useService(ctx, CELIX_RECEIVE_COUNT_SERVICE_NAME, &count, [](void *handle, void *svc) {
+            auto *count_ptr = static_cast<int *>(handle);
+            auto *count = static_cast<celix_receive_count_service_t *>(svc);
+            *count_ptr = (int)count->receiveCount(count->handle);
+        });
+        return count;
+    }
+
+    celix_framework_t* fw = nullptr;
+    celix_bundle_context_t* ctx = nullptr;
+};
+
+TEST_F(PubSubMultiPublisherTestSuite, throughputTest) {
+    constexpr int MSG_COUNT = 10000;
+    constexpr auto TIMEOUT = std::chrono::seconds{60};
+
+    //wait for the first message, so that the measurement does not include the setup of the connections
+    auto start = std::chrono::steady_clock::now();
+    int startCount = receiveCount();
+    while (startCount == 0 && std::chrono::steady_clock::now() - start < TIMEOUT) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        startCount = receiveCount();
+    }
+    ASSERT_GT(startCount, 0);
+
+    start = std::chrono::steady_clock::now();
+    int count = startCount;
+    while (count - startCount < MSG_COUNT && std::chrono::steady_clock::now() - start < TIMEOUT) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{100});
+        count = receiveCount();
+    }
+    auto durationInMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    printf("Received %i messages in %li ms (%.0f msg/s)\n", count - startCount, (long)durationInMs,
+           (count - startCount) * 1000.0 / (double)(durationInMs > 0 ? durationInMs : 1));
+    EXPECT_GE(count - startCount, MSG_COUNT);
+}
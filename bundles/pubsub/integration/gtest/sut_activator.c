@@ -26,17 +26,21 @@
 #include "pubsub/api.h"
 #include "msg.h"
 
+#define SUT_MAX_NR_OF_PUBLISHER_THREADS 16
+
 static void sut_pubSet(void *handle, void *service);
 static void* sut_sendThread(void *data);
 
 struct activator {
     bool addMetadata;
+    long nrOfPublisherThreads;
+    long sendIntervalInUs;
 
     long pubTrkId;
 
-    pthread_t sendThread;
+    pthread_t sendThreads[SUT_MAX_NR_OF_PUBLISHER_THREADS];
 
-    pthread_mutex_t mutex;
+    pthread_rwlock_t lock; //protects pubSvc, note send calls are done with a read lock so publishers can send concurrently
     bool running;
     pubsub_publisher_t* pubSvc;
 };
@@ -44,6 +48,19 @@ struct activator {
 celix_status_t bnd_start(struct activator *act, celix_bundle_context_t *ctx) {
 
     act->addMetadata = celix_bundleContext_getPropertyAsBool(ctx, "CELIX_PUBSUB_TEST_ADD_METADATA", false);
+    act->nrOfPublisherThreads = celix_bundleContext_getPropertyAsLong(ctx, "CELIX_PUBSUB_TEST_NR_OF_PUBLISHER_THREADS", 1);
+    if (act->nrOfPublisherThreads < 1 || act->nrOfPublisherThreads > SUT_MAX_NR_OF_PUBLISHER_THREADS) {
+        act->nrOfPublisherThreads = 1;
+    }
+    act->sendIntervalInUs = celix_bundleContext_getPropertyAsLong(ctx, "CELIX_PUBSUB_TEST_SEND_INTERVAL_IN_US", 10000);
+    pthread_rwlockattr_t attr;
+    pthread_rwlockattr_init(&attr);
+#if defined(__GLIBC__)
+    //note the send threads only shortly release the read lock, so prefer writers to prevent writer starvation
+    pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+    pthread_rwlock_init(&act->lock, &attr);
+    pthread_rwlockattr_destroy(&attr);
 
     char filter[512];
     bool useNegativeScopeFilter = celix_bundleContext_getPropertyAsBool(ctx, "CELIX_PUBSUB_TEST_USE_NEGATIVE_SCOPE_FILTER", true);
@@ -60,16 +77,20 @@ celix_status_t bnd_start(struct activator *act, celix_bundle_context_t *ctx) {
     act->pubTrkId = celix_bundleContext_trackServicesWithOptions(ctx, &opts);
 
     __atomic_store_n(&act->running, true, __ATOMIC_RELEASE);
-    pthread_create(&act->sendThread, NULL, sut_sendThread, act);
+    for (long i = 0; i < act->nrOfPublisherThreads; ++i) {
+        pthread_create(&act->sendThreads[i], NULL, sut_sendThread, act);
+    }
 
     return CELIX_SUCCESS;
 }
 
 celix_status_t bnd_stop(struct activator *act, celix_bundle_context_t *ctx) {
     __atomic_store_n(&act->running, false, __ATOMIC_RELEASE);
-    pthread_join(act->sendThread, NULL);
+    for (long i = 0; i < act->nrOfPublisherThreads; ++i) {
+        pthread_join(act->sendThreads[i], NULL);
+    }
     celix_bundleContext_stopTracker(ctx, act->pubTrkId);
-    pthread_mutex_destroy(&act->mutex);
+    pthread_rwlock_destroy(&act->lock);
     return CELIX_SUCCESS;
 }
 
@@ -77,9 +98,9 @@ CELIX_GEN_BUNDLE_ACTIVATOR(struct activator, bnd_start, bnd_stop)
 
 static void sut_pubSet(void *handle, void *service) {
     struct activator* act = handle;
-    pthread_mutex_lock(&act->mutex);
+    pthread_rwlock_wrlock(&act->lock);
     act->pubSvc = service;
-    pthread_mutex_unlock(&act->mutex);
+    pthread_rwlock_unlock(&act->lock);
 }
 
 static void* sut_sendThread(void *data) {
@@ -90,8 +111,9 @@ static void* sut_sendThread(void *data) {
     msg.seqNr = 1;
 
     while (__atomic_load_n(&act->running, __ATOMIC_ACQUIRE)) {
-        pthread_mutex_lock(&act->mutex);
-        if (act->pubSvc != NULL) {
+        pthread_rwlock_rdlock(&act->lock);
+        bool send = act->pubSvc != NULL;
+        if (send) {
             if (msgId == 0) {
                 act->pubSvc->localMsgTypeIdForMsgType(act->pubSvc->handle, MSG_NAME, &msgId);
             }
@@ -108,9 +130,11 @@ static void* sut_sendThread(void *data) {
             msg.seqNr += 1;
 
         }
-        pthread_mutex_unlock(&act->mutex);
+        pthread_rwlock_unlock(&act->lock);
 
-        usleep(10000);
+        if (!send || act->sendIntervalInUs > 0) {
+            usleep(send ? act->sendIntervalInUs : 10000);
+        }
     }
     printf("Send %i messages\n", msg.seqNr);
 
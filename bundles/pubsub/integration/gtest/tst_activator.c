@@ -30,6 +30,8 @@
 
 static int tst_receive(void *handle, const char *msgType, unsigned int msgTypeId, void *msg, const celix_properties_t *metadata, bool *release);
 static int tst_receive2(void *handle, const char *msgType, unsigned int msgTypeId, void *msg, const celix_properties_t *metadata, bool *release);
+static int tst_receive3(void *handle, const char *msgType, unsigned int msgTypeId, void *msg, const celix_properties_t *metadata, bool *release);
+static int tst_receiveShared(void *handle, const char *msgType, unsigned int msgTypeId, pubsub_shared_msg_t *msg, const celix_properties_t *metadata);
 static size_t tst_count(void *handle);
 
 struct activator {
@@ -39,16 +41,23 @@ struct activator {
     pubsub_subscriber_t subSvc2;
     long subSvcId2;
 
+    pubsub_subscriber_t subSvc3;
+    long subSvcId3;
+
     celix_receive_count_service_t countSvc;
     long countSvcId;
 
+    bool checkSeqNr; //note only when there is a single publisher thread, the seqNr should be increasing
     pthread_mutex_t mutex;
     unsigned int count1;
     unsigned int count2;
+    unsigned int count3;
+    pubsub_shared_msg_t *retainedMsg; //last received shared msg
 };
 
 celix_status_t bnd_start(struct activator *act, celix_bundle_context_t *ctx) {
     pthread_mutex_init(&act->mutex, NULL);
+    act->checkSeqNr = celix_bundleContext_getPropertyAsLong(ctx, "CELIX_PUBSUB_TEST_NR_OF_PUBLISHER_THREADS", 1) <= 1;
 
     {
         celix_properties_t *props = celix_properties_create();
@@ -66,6 +75,15 @@ celix_status_t bnd_start(struct activator *act, celix_bundle_context_t *ctx) {
         act->subSvcId2 = celix_bundleContext_registerService(ctx, &act->subSvc2, PUBSUB_SUBSCRIBER_SERVICE_NAME, props);
     }
 
+    {
+        celix_properties_t *props = celix_properties_create();
+        celix_properties_set(props, PUBSUB_SUBSCRIBER_TOPIC, "ping");
+        act->subSvc3.handle = act;
+        act->subSvc3.receive = tst_receive3; //note only used by pubsub admins without receiveShared support
+        act->subSvc3.receiveShared = tst_receiveShared;
+        act->subSvcId3 = celix_bundleContext_registerService(ctx, &act->subSvc3, PUBSUB_SUBSCRIBER_SERVICE_NAME, props);
+    }
+
     {
         act->countSvc.handle = act;
         act->countSvc.receiveCount = tst_count;
@@ -78,6 +96,10 @@ celix_status_t bnd_start(struct activator *act, celix_bundle_context_t *ctx) {
 celix_status_t bnd_stop(struct activator *act, celix_bundle_context_t *ctx) {
     celix_bundleContext_unregisterService(ctx, act->subSvcId1);
     celix_bundleContext_unregisterService(ctx, act->subSvcId2);
+    celix_bundleContext_unregisterService(ctx, act->subSvcId3);
+    if (act->retainedMsg != NULL) {
+        act->retainedMsg->release(act->retainedMsg->handle);
+    }
     celix_bundleContext_unregisterService(ctx, act->countSvcId);
     pthread_mutex_destroy(&act->mutex);
     return CELIX_SUCCESS;
@@ -92,7 +114,7 @@ static int tst_receive(void *handle, const char * msgType __attribute__((unused)
     msg_t *msg = voidMsg;
     static uint32_t prevSeqNr = 0;
     long delta = msg->seqNr - prevSeqNr;
-    if (delta != 1 && msg->seqNr > 1 && prevSeqNr < msg->seqNr) {
+    if (act->checkSeqNr && delta != 1 && msg->seqNr > 1 && prevSeqNr < msg->seqNr) {
         fprintf(stderr, "Warning: missing messages. seq jumped from %i to %i\n", prevSeqNr, msg->seqNr);
     }
     prevSeqNr = msg->seqNr;
@@ -113,7 +135,7 @@ static int tst_receive2(void *handle, const char * msgType __attribute__((unused
     msg_t *msg = voidMsg;
     static int prevSeqNr = 0;
     int delta = msg->seqNr - prevSeqNr;
-    if (delta != 1) {
+    if (act->checkSeqNr && delta != 1) {
         fprintf(stderr, "Warning: missing messages. seq jumped from %i to %i\n", prevSeqNr, msg->seqNr);
     }
     prevSeqNr = msg->seqNr;
@@ -124,14 +146,46 @@ static int tst_receive2(void *handle, const char * msgType __attribute__((unused
     return CELIX_SUCCESS;
 }
 
+static int tst_receive3(void *handle, const char * msgType __attribute__((unused)), unsigned int msgTypeId  __attribute__((unused)), void * voidMsg __attribute__((unused)), const celix_properties_t *metadata  __attribute__((unused)), bool *release  __attribute__((unused))) {
+    struct activator *act = handle;
+    pthread_mutex_lock(&act->mutex);
+    act->count3 += 1;
+    pthread_mutex_unlock(&act->mutex);
+    return CELIX_SUCCESS;
+}
+
+static int tst_receiveShared(void *handle, const char * msgType __attribute__((unused)), unsigned int msgTypeId  __attribute__((unused)), pubsub_shared_msg_t *sharedMsg, const celix_properties_t *metadata  __attribute__((unused))) {
+    struct activator *act = handle;
+
+    const msg_t *msg = sharedMsg->msg;
+    sharedMsg->retain(sharedMsg->handle);
+
+    pthread_mutex_lock(&act->mutex);
+    pubsub_shared_msg_t *prevMsg = act->retainedMsg;
+    if (act->checkSeqNr && prevMsg != NULL && ((const msg_t*)prevMsg->msg)->seqNr >= msg->seqNr && msg->seqNr > 1) {
+        fprintf(stderr, "Warning: shared msg out of order. seq %i after %i\n", msg->seqNr, ((const msg_t*)prevMsg->msg)->seqNr);
+    }
+    act->retainedMsg = sharedMsg;
+    act->count3 += 1;
+    pthread_mutex_unlock(&act->mutex);
+
+    if (prevMsg != NULL) {
+        prevMsg->release(prevMsg->handle);
+    }
+    return CELIX_SUCCESS;
+}
+
 static size_t tst_count(void *handle) {
     struct activator *act = handle;
     size_t count1;
     size_t count2;
+    size_t count3;
     pthread_mutex_lock(&act->mutex);
     count1 = act->count1;
     count2 = act->count2;
+    count3 = act->count3;
     pthread_mutex_unlock(&act->mutex);
-    printf("msg count1 is %lu and msg count 2 is %lu\n", (long unsigned int) count1, (long unsigned int) count2);
-    return count1 >= count2 ? count1 : count2;
+    printf("msg count1 is %lu, msg count 2 is %lu and msg count 3 is %lu\n", (long unsigned int) count1, (long unsigned int) count2, (long unsigned int) count3);
+    size_t count = count1 >= count2 ? count1 : count2;
+    return count <= count3 ? count : count3;
 }
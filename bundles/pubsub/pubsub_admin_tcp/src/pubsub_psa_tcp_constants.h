@@ -56,6 +56,30 @@
 #define PUBSUB_TCP_SUBSCRIBER_RETRY_CNT_KEY     "PUBSUB_TCP_SUBSCRIBER_RETRY_COUNT"
 #define PUBSUB_TCP_SUBSCRIBER_RETRY_CNT_DEFAULT 5
 
+/**
+ * If true the publisher encodes a message once and queues it for every connection. The queues are written
+ * by the socket thread, so a slow subscriber does not block the publisher send call.
+ * Can be set in the topic properties or as framework property.
+ */
+#define PUBSUB_TCP_PUBLISHER_ASYNC_SEND_KEY     "PUBSUB_TCP_PUBLISHER_ASYNC_SEND"
+#define PUBSUB_TCP_PUBLISHER_ASYNC_SEND_DEFAULT false
+
+/**
+ * The max nr of messages queued per connection when async send is enabled.
+ * Can be set in the topic properties or as framework property.
+ */
+#define PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE_KEY        "PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE"
+#define PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE_DEFAULT    64
+
+/**
+ * What to do when the send queue of a connection is full: "drop_newest" (drop the message for that connection),
+ * "drop_oldest" (drop the oldest not yet send message) or "block" (backpressure, the publisher writes the
+ * queue of the connection until there is room again).
+ * Can be set in the topic properties or as framework property.
+ */
+#define PUBSUB_TCP_PUBLISHER_SEND_QUEUE_POLICY_KEY      "PUBSUB_TCP_PUBLISHER_SEND_QUEUE_POLICY"
+#define PUBSUB_TCP_PUBLISHER_SEND_QUEUE_POLICY_DEFAULT  "drop_oldest"
+
 
 //Time-out settings are only for BLOCKING connections
 #define PUBSUB_TCP_PUBLISHER_SNDTIMEO_KEY       "PUBSUB_TCP_PUBLISHER_SEND_TIMEOUT"
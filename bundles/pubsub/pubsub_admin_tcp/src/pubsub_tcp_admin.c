@@ -706,5 +706,18 @@ bool pubsub_tcpAdmin_executeCommand(void *handle, const char *commandLine __attr
 }
 
 pubsub_admin_metrics_t *pubsub_tcpAdmin_metrics(void *handle) {
-    return NULL;
+    pubsub_tcp_admin_t *psa = handle;
+    pubsub_admin_metrics_t *result = calloc(1, sizeof(*result));
+    snprintf(result->psaType, PUBSUB_AMDIN_METRICS_NAME_MAX, "%s", PUBSUB_TCP_ADMIN_TYPE);
+    result->senders = celix_arrayList_create();
+    result->receivers = celix_arrayList_create();
+
+    celixThreadMutex_lock(&psa->topicSenders.mutex);
+    hash_map_iterator_t iter = hashMapIterator_construct(psa->topicSenders.map);
+    while (hashMapIterator_hasNext(&iter)) {
+        pubsub_tcp_topic_sender_t *sender = hashMapIterator_nextValue(&iter);
+        celix_arrayList_add(result->senders, pubsub_tcpTopicSender_metrics(sender));
+    }
+    celixThreadMutex_unlock(&psa->topicSenders.mutex);
+    return result;
 }
@@ -64,6 +64,16 @@
 #define L_ERROR(...) \
     celix_logHelper_log(handle->logHelper, CELIX_LOG_LEVEL_ERROR, __VA_ARGS__)
 
+//
+// Ref counted buffer with a complete encoded message (all segments), shared by the send queues of the connections
+//
+typedef struct psa_tcp_send_buffer {
+    int refCount; //atomic
+    size_t size;
+    size_t capacity;
+    char *data;
+} psa_tcp_send_buffer_t;
+
 //
 // Entry administration
 //
@@ -96,6 +106,17 @@ typedef struct psa_tcp_connection_entry {
     unsigned int retryCount;
     celix_thread_mutex_t writeMutex;
     struct msghdr readMsg;
+    unsigned int events; // registered poll events, excluding EPOLLOUT
+    struct {
+        psa_tcp_send_buffer_t **buffers; // ring buffer, protected by writeMutex
+        size_t capacity;
+        size_t first;
+        size_t size;
+        size_t firstOffset; // nr of bytes of the first buffer already written
+        size_t nrOfBytes;
+        unsigned long nrOfDroppedMessages;
+        bool writeEventEnabled;
+    } sendQueue;
 } psa_tcp_connection_entry_t;
 
 //
@@ -128,6 +149,9 @@ struct pubsub_tcpHandler {
     celix_thread_t thread;
     bool running;
     bool enableReceiveEvent;
+    bool asyncSend;
+    unsigned int sendQueueSize;
+    pubsub_tcpHandler_sendQueuePolicy_e sendQueuePolicy;
 };
 
 static inline int pubsub_tcpHandler_closeConnectionEntry(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry, bool lock);
@@ -144,6 +168,9 @@ static inline long int pubsub_tcpHandler_readPayload(pubsub_tcpHandler_t *handle
 static inline void pubsub_tcpHandler_connectionHandler(pubsub_tcpHandler_t *handle, int fd);
 static inline void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle);
 static void *pubsub_tcpHandler_thread(void *data);
+static inline void pubsub_tcpHandler_releaseSendBuffer(psa_tcp_send_buffer_t *buffer);
+static inline int pubsub_tcpHandler_flushSendQueue(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry, bool block);
+static inline int pubsub_tcpHandler_writeSendQueue(pubsub_tcpHandler_t *handle, int fd);
 
 
 
@@ -348,6 +375,10 @@ pubsub_tcpHandler_createEntry(pubsub_tcpHandler_t *handle, int fd, char *url, ch
         if (entry->bufferSize) entry->buffer = calloc(sizeof(char), entry->bufferSize);
         memset(&entry->readMsg, 0x00, sizeof(struct msghdr));
         entry->readMsg.msg_iov = calloc(sizeof(struct iovec), IOV_MAX);
+        if (handle->asyncSend) {
+            entry->sendQueue.capacity = MAX(handle->sendQueueSize, 1u);
+            entry->sendQueue.buffers = calloc(sizeof(psa_tcp_send_buffer_t*), entry->sendQueue.capacity);
+        }
     }
     return entry;
 }
@@ -369,6 +400,10 @@ pubsub_tcpHandler_freeEntry(psa_tcp_connection_entry_t *entry) {
         free(entry->readMetaBuffer);
         free(entry->writeMetaBuffer);
         free(entry->readMsg.msg_iov);
+        for (size_t i = 0; i < entry->sendQueue.size; ++i) {
+            pubsub_tcpHandler_releaseSendBuffer(entry->sendQueue.buffers[(entry->sendQueue.first + i) % entry->sendQueue.capacity]);
+        }
+        free(entry->sendQueue.buffers);
         celixThreadMutex_destroy(&entry->writeMutex);
         free(entry);
     }
@@ -424,6 +459,7 @@ int pubsub_tcpHandler_connect(pubsub_tcpHandler_t *handle, char *url) {
             bzero(&event,  sizeof(struct epoll_event)); // zero the struct
             event.events = EPOLLIN | EPOLLRDHUP | EPOLLERR;
             event.data.fd = entry->fd;
+            entry->events = event.events;
             rc = epoll_ctl(handle->efd, EPOLL_CTL_ADD, entry->fd, &event);
 #endif
             if (rc < 0) {
@@ -759,6 +795,46 @@ void pubsub_tcpHandler_enableReceiveEvent(pubsub_tcpHandler_t *handle,bool enabl
     }
 }
 
+//
+// Setup asynchronous send. Only applies to connections created after this call.
+//
+void pubsub_tcpHandler_setAsyncSend(pubsub_tcpHandler_t *handle, bool enable, unsigned int queueSize,
+                                    pubsub_tcpHandler_sendQueuePolicy_e policy) {
+    if (handle != NULL) {
+        celixThreadRwlock_writeLock(&handle->dbLock);
+        handle->asyncSend = enable;
+        handle->sendQueueSize = queueSize;
+        handle->sendQueuePolicy = policy;
+        celixThreadRwlock_unlock(&handle->dbLock);
+    }
+}
+
+//
+// Returns the send queue metrics of the connections. The caller is owner of the returned array.
+//
+unsigned int pubsub_tcpHandler_getConnectionMetrics(pubsub_tcpHandler_t *handle,
+                                                    pubsub_admin_sender_connection_metrics_t **connections) {
+    unsigned int nrOfConnections = 0;
+    *connections = NULL;
+    if (handle != NULL) {
+        celixThreadRwlock_readLock(&handle->dbLock);
+        *connections = calloc(hashMap_size(handle->connection_fd_map) + 1, sizeof(**connections));
+        hash_map_iterator_t iter = hashMapIterator_construct(handle->connection_fd_map);
+        while (hashMapIterator_hasNext(&iter)) {
+            psa_tcp_connection_entry_t *entry = hashMapIterator_nextValue(&iter);
+            pubsub_admin_sender_connection_metrics_t *metrics = &(*connections)[nrOfConnections++];
+            snprintf(metrics->url, PUBSUB_AMDIN_METRICS_NAME_MAX, "%s", entry->url ? entry->url : "");
+            celixThreadMutex_lock(&entry->writeMutex);
+            metrics->nrOfQueuedMessages = entry->sendQueue.size;
+            metrics->nrOfQueuedBytes = entry->sendQueue.nrOfBytes;
+            metrics->nrOfDroppedMessages = entry->sendQueue.nrOfDroppedMessages;
+            celixThreadMutex_unlock(&entry->writeMutex);
+        }
+        celixThreadRwlock_unlock(&handle->dbLock);
+    }
+    return nrOfConnections;
+}
+
 static inline long int pubsub_tcpHandler_getMsgSize(psa_tcp_connection_entry_t *entry) {
     // Note header message is already read
     return (long int)entry->header.header.payloadPartSize + (long int)entry->header.header.metadataSize + (long int)entry->readFooterSize;
@@ -983,6 +1059,343 @@ int pubsub_tcpHandler_addReceiverConnectionCallback(pubsub_tcpHandler_t *handle,
     return result;
 }
 
+//
+// Appends data to a send buffer, growing the buffer if needed
+//
+static inline bool pubsub_tcpHandler_appendSendBuffer(psa_tcp_send_buffer_t *buffer, const void *data, size_t size) {
+    if (buffer->size + size > buffer->capacity) {
+        size_t capacity = MAX(buffer->capacity * 2, buffer->size + size);
+        char *newData = realloc(buffer->data, capacity);
+        if (newData == NULL) {
+            return false;
+        }
+        buffer->data = newData;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+    return true;
+}
+
+static inline void pubsub_tcpHandler_retainSendBuffer(psa_tcp_send_buffer_t *buffer) {
+    __atomic_fetch_add(&buffer->refCount, 1, __ATOMIC_RELAXED);
+}
+
+static inline void pubsub_tcpHandler_releaseSendBuffer(psa_tcp_send_buffer_t *buffer) {
+    if (buffer != NULL && __atomic_sub_fetch(&buffer->refCount, 1, __ATOMIC_ACQ_REL) == 0) {
+        free(buffer->data);
+        free(buffer);
+    }
+}
+
+//
+// Encodes a message (all segments, including header, metadata and footer) once in a send buffer,
+// so that the same buffer can be queued for all connections.
+// Note that the payload is copied, because the serialized message is freed after the send call.
+//
+static psa_tcp_send_buffer_t *pubsub_tcpHandler_encodeSendBuffer(pubsub_tcpHandler_t *handle,
+                                                                 pubsub_protocol_message_t *message,
+                                                                 struct iovec *msgIoVec,
+                                                                 size_t msg_iov_len) {
+    void *payloadData = NULL;
+    size_t payloadSize = 0;
+    if (msg_iov_len == 1) {
+        handle->protocol->encodePayload(handle->protocol->handle, message, &payloadData, &payloadSize);
+    } else {
+        for (size_t i = 0; i < msg_iov_len; i++) {
+            payloadSize += msgIoVec[i].iov_len;
+        }
+    }
+
+    size_t protocolHeaderBufferSize = 0;
+    size_t footerSize = 0;
+    // Get HeaderBufferSize of the Protocol Header, when headerBufferSize == 0, the protocol header is included in the payload (needed for endpoints)
+    handle->protocol->getHeaderBufferSize(handle->protocol->handle, &protocolHeaderBufferSize);
+    handle->protocol->getFooterSize(handle->protocol->handle, &footerSize);
+    size_t maxMsgSize = handle->maxMsgSize ? handle->maxMsgSize : LONG_MAX;
+    size_t maxPartSize = maxMsgSize > protocolHeaderBufferSize + footerSize ? maxMsgSize - protocolHeaderBufferSize - footerSize : 0;
+
+    bool isMessageSegmentationSupported = false;
+    handle->protocol->isMessageSegmentationSupported(handle->protocol->handle, &isMessageSegmentationSupported);
+    if (maxPartSize == 0 || (!isMessageSegmentationSupported && payloadSize > maxMsgSize)) {
+        L_WARN("[TCP Socket] Failed to encode message, message too large and segmentation is not supported\n");
+        if (payloadData && (payloadData != message->payload.payload)) {
+            free(payloadData);
+        }
+        return NULL;
+    }
+
+    void *metadataBuffer = NULL;
+    size_t metadataBufferSize = 0;
+    size_t metadataSize = 0;
+    if (message->metadata.metadata) {
+        handle->protocol->encodeMetadata(handle->protocol->handle, message, &metadataBuffer, &metadataBufferSize, &metadataSize);
+        // When maxMsgSize is smaller then meta data is disabled
+        if (metadataSize > maxPartSize) {
+            metadataSize = 0;
+        }
+    }
+
+    psa_tcp_send_buffer_t *buffer = calloc(1, sizeof(*buffer));
+    buffer->refCount = 1;
+    buffer->capacity = payloadSize + metadataSize + protocolHeaderBufferSize + footerSize;
+    buffer->data = malloc(MAX(buffer->capacity, 1u));
+
+    message->header.convertEndianess = 0;
+    message->header.payloadSize = payloadSize;
+    void *headerData = NULL;
+    size_t headerSize = 0;
+    void *footerData = NULL;
+    size_t footerDataSize = 0;
+    size_t payloadOffset = 0;
+    size_t iovIndex = 0;
+    size_t iovOffset = 0;
+    bool metadataAdded = (metadataSize == 0);
+    bool ok = buffer->data != NULL;
+    while (ok && (payloadSize + metadataSize) > 0) {
+        size_t partSize = MIN(payloadSize - payloadOffset, maxPartSize);
+        bool addMetadata = !metadataAdded && (payloadOffset + partSize >= payloadSize) && (partSize + metadataSize <= maxPartSize);
+        message->header.payloadPartSize = partSize;
+        message->header.payloadOffset = payloadOffset;
+        message->header.metadataSize = addMetadata ? metadataSize : 0;
+        message->header.isLastSegment = (payloadOffset + partSize >= payloadSize) && (metadataAdded || addMetadata);
+
+        if (protocolHeaderBufferSize) {
+            handle->protocol->encodeHeader(handle->protocol->handle, message, &headerData, &headerSize);
+            ok = headerData != NULL && pubsub_tcpHandler_appendSendBuffer(buffer, headerData, headerSize);
+        }
+        if (ok && payloadData) {
+            ok = pubsub_tcpHandler_appendSendBuffer(buffer, (char *) payloadData + payloadOffset, partSize);
+        } else if (ok) {
+            // copy serialized vector into the send buffer
+            size_t remaining = partSize;
+            while (ok && remaining > 0 && iovIndex < msg_iov_len) {
+                size_t len = MIN(msgIoVec[iovIndex].iov_len - iovOffset, remaining);
+                ok = pubsub_tcpHandler_appendSendBuffer(buffer, (char *) msgIoVec[iovIndex].iov_base + iovOffset, len);
+                remaining -= len;
+                iovOffset += len;
+                if (iovOffset >= msgIoVec[iovIndex].iov_len) {
+                    iovIndex++;
+                    iovOffset = 0;
+                }
+            }
+        }
+        if (ok && addMetadata) {
+            ok = pubsub_tcpHandler_appendSendBuffer(buffer, metadataBuffer, metadataSize);
+            metadataAdded = true;
+        }
+        if (ok && footerSize) {
+            handle->protocol->encodeFooter(handle->protocol->handle, message, &footerData, &footerDataSize);
+            ok = footerData != NULL && pubsub_tcpHandler_appendSendBuffer(buffer, footerData, footerDataSize);
+        }
+        payloadOffset += partSize;
+        if (message->header.isLastSegment) {
+            break;
+        }
+    }
+
+    free(headerData);
+    free(footerData);
+    free(metadataBuffer);
+    // Note: serialized Payload is deleted by serializer
+    if (payloadData && (payloadData != message->payload.payload)) {
+        free(payloadData);
+    }
+    if (!ok) {
+        L_ERROR("[TCP Socket] Failed to encode message seq %d\n", message->header.seqNr);
+        pubsub_tcpHandler_releaseSendBuffer(buffer);
+        buffer = NULL;
+    }
+    return buffer;
+}
+
+//
+// Enables or disables the write event (EPOLLOUT) for a connection. Called with the entry writeMutex locked.
+//
+static inline void pubsub_tcpHandler_enableWriteEvent(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry, bool enable) {
+    if (entry->sendQueue.writeEventEnabled == enable || handle->efd < 0) {
+        return;
+    }
+#if defined(__APPLE__)
+    struct kevent ev;
+    EV_SET (&ev, entry->fd, EVFILT_WRITE, enable ? (EV_ADD | EV_ENABLE) : EV_DELETE, 0, 0, 0);
+    int rc = kevent (handle->efd, &ev, 1, NULL, 0, NULL);
+#else
+    struct epoll_event event;
+    bzero(&event, sizeof(struct epoll_event)); // zero the struct
+    event.events = entry->events | (enable ? EPOLLOUT : 0);
+    event.data.fd = entry->fd;
+    int rc = epoll_ctl(handle->efd, EPOLL_CTL_MOD, entry->fd, &event);
+#endif
+    if (rc == 0) {
+        entry->sendQueue.writeEventEnabled = enable;
+    } else {
+        L_ERROR("[TCP Socket] Cannot update poll event (fd: %d) %s\n", entry->fd, strerror(errno));
+    }
+}
+
+//
+// Removes the first buffer of the send queue. Called with the entry writeMutex locked.
+//
+static inline void pubsub_tcpHandler_popSendQueue(psa_tcp_connection_entry_t *entry) {
+    psa_tcp_send_buffer_t *buffer = entry->sendQueue.buffers[entry->sendQueue.first];
+    entry->sendQueue.buffers[entry->sendQueue.first] = NULL;
+    entry->sendQueue.nrOfBytes -= buffer->size - entry->sendQueue.firstOffset;
+    entry->sendQueue.first = (entry->sendQueue.first + 1) % entry->sendQueue.capacity;
+    entry->sendQueue.firstOffset = 0;
+    entry->sendQueue.size -= 1;
+    pubsub_tcpHandler_releaseSendBuffer(buffer);
+}
+
+//
+// Writes the send queue of a connection until the queue is empty or the socket would block.
+// If block is true, the socket is written blocking (limited by the socket send timeout).
+// Called with the entry writeMutex locked.
+// Returns -1 if the connection should be closed.
+//
+static inline int pubsub_tcpHandler_flushSendQueue(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry, bool block) {
+    int rc = 0;
+    while (entry->sendQueue.size > 0) {
+        psa_tcp_send_buffer_t *buffer = entry->sendQueue.buffers[entry->sendQueue.first];
+        size_t offset = entry->sendQueue.firstOffset;
+        long int nbytes = send(entry->fd, buffer->data + offset, buffer->size - offset, MSG_NOSIGNAL | (block ? 0 : MSG_DONTWAIT));
+        if (nbytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            } else if (!block && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else if (entry->retryCount < handle->maxSendRetryCount) {
+                entry->retryCount++;
+                L_ERROR(
+                    "[TCP Socket] Failed to send message (fd: %d), try again. Retry count %u of %u, error(%d): %s.",
+                    entry->fd, entry->retryCount, handle->maxSendRetryCount, errno, strerror(errno));
+                rc = block ? -1 : 0;
+                break;
+            } else {
+                L_ERROR(
+                    "[TCP Socket] Failed to send message (fd: %d) after %u retries! Closing connection... Error: %s", entry->fd, handle->maxSendRetryCount, strerror(errno));
+                rc = -1;
+                break;
+            }
+        }
+        entry->retryCount = 0;
+        entry->sendQueue.firstOffset += nbytes;
+        entry->sendQueue.nrOfBytes -= nbytes;
+        if (entry->sendQueue.firstOffset >= buffer->size) {
+            pubsub_tcpHandler_popSendQueue(entry);
+        }
+    }
+    pubsub_tcpHandler_enableWriteEvent(handle, entry, entry->sendQueue.size > 0);
+    return rc;
+}
+
+//
+// Adds a send buffer to the send queue of a connection, applying the send queue policy if the queue is full.
+// Called with the entry writeMutex locked.
+// Returns false if the buffer is not queued.
+//
+static inline bool pubsub_tcpHandler_enqueue(pubsub_tcpHandler_t *handle, psa_tcp_connection_entry_t *entry, psa_tcp_send_buffer_t *buffer) {
+    if (entry->sendQueue.size == entry->sendQueue.capacity) {
+        if (handle->sendQueuePolicy == PUBSUB_TCP_SEND_QUEUE_POLICY_BLOCK) {
+            // backpressure, write the queue of the connection on the publisher thread
+            pubsub_tcpHandler_flushSendQueue(handle, entry, true);
+        } else if (handle->sendQueuePolicy == PUBSUB_TCP_SEND_QUEUE_POLICY_DROP_OLDEST) {
+            if (entry->sendQueue.firstOffset == 0) {
+                pubsub_tcpHandler_popSendQueue(entry);
+            } else if (entry->sendQueue.size > 1) {
+                // the first buffer is partly written, so drop the second buffer
+                size_t second = (entry->sendQueue.first + 1) % entry->sendQueue.capacity;
+                psa_tcp_send_buffer_t *dropped = entry->sendQueue.buffers[second];
+                entry->sendQueue.buffers[second] = entry->sendQueue.buffers[entry->sendQueue.first];
+                entry->sendQueue.buffers[entry->sendQueue.first] = NULL;
+                entry->sendQueue.first = second;
+                entry->sendQueue.size -= 1;
+                entry->sendQueue.nrOfBytes -= dropped->size;
+                pubsub_tcpHandler_releaseSendBuffer(dropped);
+            }
+            if (entry->sendQueue.size < entry->sendQueue.capacity) {
+                entry->sendQueue.nrOfDroppedMessages++;
+            }
+        }
+    }
+    if (entry->sendQueue.size == entry->sendQueue.capacity) {
+        entry->sendQueue.nrOfDroppedMessages++;
+        return false;
+    }
+    size_t last = (entry->sendQueue.first + entry->sendQueue.size) % entry->sendQueue.capacity;
+    pubsub_tcpHandler_retainSendBuffer(buffer);
+    entry->sendQueue.buffers[last] = buffer;
+    entry->sendQueue.size += 1;
+    entry->sendQueue.nrOfBytes += buffer->size;
+    return true;
+}
+
+//
+// Write to TCP using the send queues of the connections. The message is encoded once and
+// written by the socket thread, a connection which cannot keep up only fills its own queue.
+//
+static int pubsub_tcpHandler_writeAsync(pubsub_tcpHandler_t *handle, pubsub_protocol_message_t *message,
+                                        struct iovec *msgIoVec, size_t msg_iov_len) {
+    psa_tcp_send_buffer_t *buffer = pubsub_tcpHandler_encodeSendBuffer(handle, message, msgIoVec, msg_iov_len);
+    if (buffer == NULL) {
+        return -1;
+    } else if (buffer->size == 0) {
+        // nothing to send
+        pubsub_tcpHandler_releaseSendBuffer(buffer);
+        return 0;
+    }
+    int result = 0;
+    celixThreadRwlock_readLock(&handle->dbLock);
+    int connFdCloseQueue[hashMap_size(handle->connection_fd_map)+1]; // +1 to ensure a size of 0 never occurs.
+    int nofConnToClose = 0;
+    hash_map_iterator_t iter = hashMapIterator_construct(handle->connection_fd_map);
+    while (hashMapIterator_hasNext(&iter)) {
+        psa_tcp_connection_entry_t *entry = hashMapIterator_nextValue(&iter);
+        if (!__atomic_load_n(&entry->connected, __ATOMIC_ACQUIRE) || entry->maxMsgSize == 0) {
+            continue;
+        }
+        celixThreadMutex_lock(&entry->writeMutex);
+        if (entry->sendQueue.buffers == NULL) {
+            // connection created before async send was enabled
+            entry->sendQueue.capacity = MAX(handle->sendQueueSize, 1u);
+            entry->sendQueue.buffers = calloc(sizeof(psa_tcp_send_buffer_t*), entry->sendQueue.capacity);
+        }
+        if (!pubsub_tcpHandler_enqueue(handle, entry, buffer) && handle->sendQueuePolicy == PUBSUB_TCP_SEND_QUEUE_POLICY_BLOCK) {
+            result = -1; // backpressure did not result in room in the send queue
+        }
+        // Try to write directly, if the socket would block the socket thread writes the rest
+        if (!entry->sendQueue.writeEventEnabled && pubsub_tcpHandler_flushSendQueue(handle, entry, false) != 0) {
+            connFdCloseQueue[nofConnToClose++] = entry->fd;
+            result = -1;
+        }
+        celixThreadMutex_unlock(&entry->writeMutex);
+    }
+    celixThreadRwlock_unlock(&handle->dbLock);
+    pubsub_tcpHandler_releaseSendBuffer(buffer);
+    //Force close all connections that are queued in a list, done outside of locking handle->dbLock to prevent deadlock
+    for (int i = 0; i < nofConnToClose; i++) {
+        pubsub_tcpHandler_close(handle, connFdCloseQueue[i]);
+    }
+    return result;
+}
+
+//
+// Writes the send queue of a connection, called by the socket thread when the socket is writable.
+// Returns -1 if the connection should be closed.
+//
+static inline int pubsub_tcpHandler_writeSendQueue(pubsub_tcpHandler_t *handle, int fd) {
+    int rc = 0;
+    celixThreadRwlock_readLock(&handle->dbLock);
+    psa_tcp_connection_entry_t *entry = hashMap_get(handle->connection_fd_map, (void *) (intptr_t) fd);
+    if (entry != NULL) {
+        celixThreadMutex_lock(&entry->writeMutex);
+        rc = pubsub_tcpHandler_flushSendQueue(handle, entry, false);
+        celixThreadMutex_unlock(&entry->writeMutex);
+    }
+    celixThreadRwlock_unlock(&handle->dbLock);
+    return rc;
+}
+
 //
 // Write large data to TCP. .
 //
@@ -992,6 +1405,9 @@ int pubsub_tcpHandler_write(pubsub_tcpHandler_t *handle, pubsub_protocol_message
     if (handle == NULL) {
         return -1;
     }
+    if (handle->asyncSend) {
+        return pubsub_tcpHandler_writeAsync(handle, message, msgIoVec, msg_iov_len);
+    }
     int connFdCloseQueue[hashMap_size(handle->connection_fd_map)+1]; // +1 to ensure a size of 0 never occurs.
     int nofConnToClose = 0;
     if (handle) {
@@ -1293,6 +1709,7 @@ int pubsub_tcpHandler_acceptHandler(pubsub_tcpHandler_t *handle, psa_tcp_connect
         event.events = EPOLLRDHUP | EPOLLERR;
         if (handle->enableReceiveEvent) event.events |= EPOLLIN;
         event.data.fd = entry->fd;
+        entry->events = event.events;
         // Register Read to epoll
         rc = epoll_ctl(handle->efd, EPOLL_CTL_ADD, entry->fd, &event);
 #endif
@@ -1360,6 +1777,9 @@ void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle) {
       if (pendingConnectionEntry) {
         int fd = pubsub_tcpHandler_acceptHandler(handle, pendingConnectionEntry);
         pubsub_tcpHandler_connectionHandler(handle, fd);
+      } else if (events[i].filter == EVFILT_WRITE) {
+        int rc = pubsub_tcpHandler_writeSendQueue(handle, events[i].ident);
+        if (rc < 0) pubsub_tcpHandler_close(handle, events[i].ident);
       } else if (events[i].filter & EVFILT_READ) {
         int rc = pubsub_tcpHandler_read(handle, events[i].ident);
         if (rc == 0) pubsub_tcpHandler_close(handle, events[i].ident);
@@ -1410,6 +1830,9 @@ void pubsub_tcpHandler_handler(pubsub_tcpHandler_t *handle) {
             if (pendingConnectionEntry) {
                int fd = pubsub_tcpHandler_acceptHandler(handle, pendingConnectionEntry);
                pubsub_tcpHandler_connectionHandler(handle, fd);
+            } else if (events[i].events & EPOLLOUT) {
+                rc = pubsub_tcpHandler_writeSendQueue(handle, events[i].data.fd);
+                if (rc < 0) pubsub_tcpHandler_close(handle, events[i].data.fd);
             } else if (events[i].events & EPOLLIN) {
                 rc = pubsub_tcpHandler_read(handle, events[i].data.fd);
                 if (rc == 0) pubsub_tcpHandler_close(handle, events[i].data.fd);
@@ -36,6 +36,7 @@
 #include "celix_threads.h"
 #include "pubsub_utils_url.h"
 #include <pubsub_protocol.h>
+#include "pubsub_admin_metrics.h"
 
 #ifndef MIN
 #define MIN(a, b) ((a<b) ? (a) : (b))
@@ -46,6 +47,13 @@
 #endif
 
 typedef struct pubsub_tcpHandler pubsub_tcpHandler_t;
+
+typedef enum pubsub_tcpHandler_sendQueuePolicy {
+    PUBSUB_TCP_SEND_QUEUE_POLICY_DROP_NEWEST = 0,
+    PUBSUB_TCP_SEND_QUEUE_POLICY_DROP_OLDEST = 1,
+    PUBSUB_TCP_SEND_QUEUE_POLICY_BLOCK = 2
+} pubsub_tcpHandler_sendQueuePolicy_e;
+
 typedef void(*pubsub_tcpHandler_processMessage_callback_t)
     (void *payload, const pubsub_protocol_message_t *header, bool *release, struct timespec *receiveTime);
 typedef void (*pubsub_tcpHandler_receiverConnectMessage_callback_t)(void *payload, const char *url, bool lock);
@@ -66,6 +74,10 @@ void pubsub_tcpHandler_setReceiveRetryCnt(pubsub_tcpHandler_t *handle, unsigned
 void pubsub_tcpHandler_setSendTimeOut(pubsub_tcpHandler_t *handle, double timeout);
 void pubsub_tcpHandler_setReceiveTimeOut(pubsub_tcpHandler_t *handle, double timeout);
 void pubsub_tcpHandler_enableReceiveEvent(pubsub_tcpHandler_t *handle, bool enable);
+void pubsub_tcpHandler_setAsyncSend(pubsub_tcpHandler_t *handle, bool enable, unsigned int queueSize,
+                                    pubsub_tcpHandler_sendQueuePolicy_e policy);
+unsigned int pubsub_tcpHandler_getConnectionMetrics(pubsub_tcpHandler_t *handle,
+                                                    pubsub_admin_sender_connection_metrics_t **connections);
 
 int pubsub_tcpHandler_read(pubsub_tcpHandler_t *handle, int fd);
 int pubsub_tcpHandler_write(pubsub_tcpHandler_t *handle,
@@ -83,6 +83,7 @@ struct pubsub_tcp_topic_receiver {
     long subscriberTrackerId;
     struct {
         celix_thread_mutex_t mutex;
+        celix_thread_cond_t cond; //signaled when the use count of a subscriber entry is decreased
         celix_long_hash_map_t *map; //key = long svc id, value = psa_tcp_subscriber_entry_t
         bool allInitialized;
     } subscribers;
@@ -98,6 +99,7 @@ typedef struct psa_tcp_requested_connection_entry {
 typedef struct psa_tcp_subscriber_entry {
     pubsub_subscriber_t* subscriberSvc;
     bool initialized; //true if the init function is called through the receive thread
+    int useCount; //nr of receive calls in progress, the entry is freed when the use count is 0
 } psa_tcp_subscriber_entry_t;
 
 static void pubsub_tcpTopicReceiver_addSubscriber(void *handle, void *svc, const celix_properties_t *props);
@@ -159,6 +161,7 @@ pubsub_tcp_topic_receiver_t *pubsub_tcpTopicReceiver_create(celix_bundle_context
     //receiver->socketHandler depend on belows, we should initialize them first.
     celixThreadMutex_create(&receiver->requestedConnections.mutex, NULL);
     celixThreadMutex_create(&receiver->subscribers.mutex, NULL);
+    celixThreadCondition_init(&receiver->subscribers.cond, NULL);
     celix_string_hash_map_create_options_t reqConsMapOpts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
     reqConsMapOpts.storeKeysWeakly = true;
     receiver->requestedConnections.map = celix_stringHashMap_createWithOptions(&reqConsMapOpts);
@@ -247,6 +250,7 @@ pubsub_tcp_topic_receiver_t *pubsub_tcpTopicReceiver_create(celix_bundle_context
     if (receiver->socketHandler == NULL) {
         celix_longHashMap_destroy(receiver->subscribers.map);
         celix_stringHashMap_destroy(receiver->requestedConnections.map);
+        celixThreadCondition_destroy(&receiver->subscribers.cond);
         celixThreadMutex_destroy(&receiver->subscribers.mutex);
         celixThreadMutex_destroy(&receiver->requestedConnections.mutex);
         celixThreadMutex_destroy(&receiver->thread.mutex);
@@ -300,6 +304,7 @@ void pubsub_tcpTopicReceiver_destroy(pubsub_tcp_topic_receiver_t *receiver) {
         celix_stringHashMap_destroy(receiver->requestedConnections.map);
         celixThreadMutex_unlock(&receiver->requestedConnections.mutex);
 
+        celixThreadCondition_destroy(&receiver->subscribers.cond);
         celixThreadMutex_destroy(&receiver->subscribers.mutex);
         celixThreadMutex_destroy(&receiver->requestedConnections.mutex);
         celixThreadMutex_destroy(&receiver->thread.mutex);
@@ -443,39 +448,77 @@ static void pubsub_tcpTopicReceiver_removeSubscriber(void *handle, void *svc __a
     celixThreadMutex_lock(&receiver->subscribers.mutex);
     psa_tcp_subscriber_entry_t *entry = celix_longHashMap_get(receiver->subscribers.map, svcId);
     celix_longHashMap_remove(receiver->subscribers.map, svcId);
+    while (entry != NULL && entry->useCount > 0) {
+        //note receive calls are done outside the lock, wait till the subscriber is no longer in use
+        celixThreadCondition_wait(&receiver->subscribers.cond, &receiver->subscribers.mutex);
+    }
     free(entry);
     celixThreadMutex_unlock(&receiver->subscribers.mutex);
 }
 
 static void callReceivers(pubsub_tcp_topic_receiver_t *receiver, const char* msgFqn, const pubsub_protocol_message_t *message, void** msg, bool* release, const celix_properties_t* metadata) {
     *release = true;
+
+    //snapshot the subscribers, so that the receive functions are called without holding the subscribers lock
     celixThreadMutex_lock(&receiver->subscribers.mutex);
-    celix_long_hash_map_iterator_t iter = celix_longHashMap_begin(receiver->subscribers.map);
-    while(!celix_longHashMapIterator_isEnd(&iter)) {
+    size_t nrOfEntries = 0;
+    size_t nrOfSharedReceivers = 0;
+    psa_tcp_subscriber_entry_t* entries[celix_longHashMap_size(receiver->subscribers.map) + 1];
+    CELIX_LONG_HASH_MAP_ITERATE(receiver->subscribers.map, iter) {
         psa_tcp_subscriber_entry_t* entry = iter.value.ptrValue;
-        celix_longHashMapIterator_next(&iter);
-        if (entry != NULL && entry->subscriberSvc->receive != NULL) {
-            entry->subscriberSvc->receive(entry->subscriberSvc->handle, msgFqn, message->header.msgId, *msg, metadata, release);
-            if (!(*release) && !celix_longHashMapIterator_isEnd(&iter)) { //receive function has taken ownership, deserialize again for new message
-                struct iovec deSerializeBuffer;
-                deSerializeBuffer.iov_base = message->payload.payload;
-                deSerializeBuffer.iov_len = message->payload.length;
-                celix_status_t status = pubsub_serializerHandler_deserialize(receiver->serializerHandler,
-                                                                             message->header.msgId,
-                                                                             message->header.msgMajorVersion,
-                                                                             message->header.msgMinorVersion,
-                                                                             &deSerializeBuffer, 0, msg);
-                if (status != CELIX_SUCCESS) {
-                    L_WARN("[PSA_TCP_TR] Cannot deserialize msg type %s for scope/topic %s/%s", msgFqn,
-                           receiver->scope == NULL ? "(null)" : receiver->scope, receiver->topic);
-                    break;
-                }
-            } else if (!(*release)) { //receive function has taken ownership, but no receive left anymore. set msg to null
-                *msg = NULL;
+        entry->useCount += 1;
+        entries[nrOfEntries++] = entry;
+        if (entry->subscriberSvc->receiveShared != NULL) {
+            nrOfSharedReceivers += 1;
+        }
+    }
+    celixThreadMutex_unlock(&receiver->subscribers.mutex);
+
+    if (nrOfSharedReceivers > 0) {
+        //all shared receivers get the same read-only msg
+        pubsub_shared_msg_t* sharedMsg = pubsub_serializerHandler_createSharedMsg(receiver->serializerHandler, message->header.msgId, *msg);
+        for (size_t i = 0; i < nrOfEntries; ++i) {
+            pubsub_subscriber_t* svc = entries[i]->subscriberSvc;
+            if (svc->receiveShared != NULL) {
+                svc->receiveShared(svc->handle, msgFqn, message->header.msgId, sharedMsg, metadata);
+            }
+        }
+        //if the shared msg is retained, it owns the msg -> msg is NULL and will be deserialized again if needed
+        *msg = pubsub_serializerHandler_reclaimSharedMsg(sharedMsg);
+    }
+
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        pubsub_subscriber_t* svc = entries[i]->subscriberSvc;
+        if (svc->receiveShared != NULL || svc->receive == NULL) {
+            continue;
+        }
+        if (*msg == NULL) { //previous receive function has taken ownership, deserialize again for new message
+            struct iovec deSerializeBuffer;
+            deSerializeBuffer.iov_base = message->payload.payload;
+            deSerializeBuffer.iov_len = message->payload.length;
+            celix_status_t status = pubsub_serializerHandler_deserialize(receiver->serializerHandler,
+                                                                         message->header.msgId,
+                                                                         message->header.msgMajorVersion,
+                                                                         message->header.msgMinorVersion,
+                                                                         &deSerializeBuffer, 0, msg);
+            if (status != CELIX_SUCCESS) {
+                L_WARN("[PSA_TCP_TR] Cannot deserialize msg type %s for scope/topic %s/%s", msgFqn,
+                       receiver->scope == NULL ? "(null)" : receiver->scope, receiver->topic);
+                break;
             }
-            *release = true;
         }
+        svc->receive(svc->handle, msgFqn, message->header.msgId, *msg, metadata, release);
+        if (!(*release)) { //receive function has taken ownership
+            *msg = NULL;
+        }
+        *release = true;
+    }
+
+    celixThreadMutex_lock(&receiver->subscribers.mutex);
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        entries[i]->useCount -= 1;
     }
+    celixThreadCondition_broadcast(&receiver->subscribers.cond);
     celixThreadMutex_unlock(&receiver->subscribers.mutex);
 }
 
@@ -21,6 +21,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <memory.h>
+#include <strings.h>
 #include <pubsub_constants.h>
 #include <pubsub/publisher.h>
 #include <utils.h>
@@ -98,6 +99,8 @@ static void psa_tcp_ungetPublisherService(void *handle, const celix_bundle_t *re
 static int
 psa_tcp_topicPublicationSend(void *handle, unsigned int msgTypeId, const void *msg, celix_properties_t *metadata);
 
+static pubsub_tcpHandler_sendQueuePolicy_e psa_tcp_sendQueuePolicy(const char *policy);
+
 pubsub_tcp_topic_sender_t *pubsub_tcpTopicSender_create(
     celix_bundle_context_t *ctx,
     celix_log_helper_t *logHelper,
@@ -181,6 +184,22 @@ pubsub_tcp_topic_sender_t *pubsub_tcpTopicSender_create(
         pubsub_tcpHandler_setTimeout(sender->socketHandler, (unsigned int) timeout);
     }
 
+    if (sender->socketHandler != NULL) {
+        bool asyncSend = celix_bundleContext_getPropertyAsBool(ctx, PUBSUB_TCP_PUBLISHER_ASYNC_SEND_KEY, PUBSUB_TCP_PUBLISHER_ASYNC_SEND_DEFAULT);
+        long queueSize = celix_bundleContext_getPropertyAsLong(ctx, PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE_KEY, PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE_DEFAULT);
+        const char *policy = celix_bundleContext_getProperty(ctx, PUBSUB_TCP_PUBLISHER_SEND_QUEUE_POLICY_KEY, PUBSUB_TCP_PUBLISHER_SEND_QUEUE_POLICY_DEFAULT);
+        if (topicProperties != NULL) {
+            asyncSend = celix_properties_getAsBool(topicProperties, PUBSUB_TCP_PUBLISHER_ASYNC_SEND_KEY, asyncSend);
+            queueSize = celix_properties_getAsLong(topicProperties, PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE_KEY, queueSize);
+            policy = celix_properties_get(topicProperties, PUBSUB_TCP_PUBLISHER_SEND_QUEUE_POLICY_KEY, policy);
+        }
+        if (queueSize <= 0) {
+            L_WARN("Invalid send queue size %li for topic %s, using %i", queueSize, topic, PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE_DEFAULT);
+            queueSize = PUBSUB_TCP_PUBLISHER_SEND_QUEUE_SIZE_DEFAULT;
+        }
+        pubsub_tcpHandler_setAsyncSend(sender->socketHandler, asyncSend, (unsigned int) queueSize, psa_tcp_sendQueuePolicy(policy));
+    }
+
     if (!sender->isPassive) {
         //setting up tcp socket for TCP TopicSender
         if (discUrl != NULL) {
@@ -311,6 +330,24 @@ bool pubsub_tcpTopicSender_isPassive(pubsub_tcp_topic_sender_t *sender) {
     return sender->isPassive;
 }
 
+pubsub_admin_sender_metrics_t *pubsub_tcpTopicSender_metrics(pubsub_tcp_topic_sender_t *sender) {
+    pubsub_admin_sender_metrics_t *result = calloc(1, sizeof(*result));
+    snprintf(result->scope, PUBSUB_AMDIN_METRICS_NAME_MAX, "%s", sender->scope == NULL ? "" : sender->scope);
+    snprintf(result->topic, PUBSUB_AMDIN_METRICS_NAME_MAX, "%s", sender->topic);
+    result->nrOfConnections = pubsub_tcpHandler_getConnectionMetrics(sender->socketHandler, &result->connections);
+    return result;
+}
+
+static pubsub_tcpHandler_sendQueuePolicy_e psa_tcp_sendQueuePolicy(const char *policy) {
+    pubsub_tcpHandler_sendQueuePolicy_e result = PUBSUB_TCP_SEND_QUEUE_POLICY_DROP_OLDEST;
+    if (policy != NULL && strcasecmp(policy, "drop_newest") == 0) {
+        result = PUBSUB_TCP_SEND_QUEUE_POLICY_DROP_NEWEST;
+    } else if (policy != NULL && strcasecmp(policy, "block") == 0) {
+        result = PUBSUB_TCP_SEND_QUEUE_POLICY_BLOCK;
+    }
+    return result;
+}
+
 static void *psa_tcp_getPublisherService(void *handle, const celix_bundle_t *requestingBundle,
                                          const celix_properties_t *svcProperties __attribute__((unused))) {
     pubsub_tcp_topic_sender_t *sender = handle;
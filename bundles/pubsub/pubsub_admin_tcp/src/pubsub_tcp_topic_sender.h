@@ -48,5 +48,6 @@ const char* pubsub_tcpTopicSender_serializerType(pubsub_tcp_topic_sender_t *send
 bool pubsub_tcpTopicSender_isStatic(pubsub_tcp_topic_sender_t *sender);
 bool pubsub_tcpTopicSender_isPassive(pubsub_tcp_topic_sender_t *sender);
 long pubsub_tcpTopicSender_protocolSvcId(pubsub_tcp_topic_sender_t *sender);
+pubsub_admin_sender_metrics_t *pubsub_tcpTopicSender_metrics(pubsub_tcp_topic_sender_t *sender);
 
 #endif //CELIX_PUBSUB_TCP_TOPIC_SENDER_H
@@ -493,6 +493,10 @@ static void psa_udpmc_processMsg(pubsub_udpmc_topic_receiver_t *receiver, pubsub
                     bool release = true;
                     while (hashMapIterator_hasNext(&iter2)) {
                         pubsub_subscriber_t *svc = hashMapIterator_nextValue(&iter2);
+                        if (svc->receive == NULL) {
+                            //note receiveShared is not supported by the udpmc admin
+                            continue;
+                        }
                         svc->receive(svc->handle, msgSer->msgName, msg->header.type, msgInst, NULL, &release);
                         if (!release && hashMapIterator_hasNext(&iter2)) {
                             //receive function has taken ownership and still more receive function to come ..
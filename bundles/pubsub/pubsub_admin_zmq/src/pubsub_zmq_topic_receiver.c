@@ -94,6 +94,7 @@ struct pubsub_zmq_topic_receiver {
     long subscriberTrackerId;
     struct {
         celix_thread_mutex_t mutex;
+        celix_thread_cond_t cond; //signaled when the use count of a subscriber entry is decreased
         hash_map_t *map; //key = long svc id, value = psa_zmq_subscriber_entry_t
         bool allInitialized;
     } subscribers;
@@ -108,6 +109,7 @@ typedef struct psa_zmq_requested_connection_entry {
 typedef struct psa_zmq_subscriber_entry {
     pubsub_subscriber_t* subscriberSvc;
     bool initialized; //true if the init function is called through the receive thread
+    int useCount; //nr of receive calls in progress, the entry is freed when the use count is 0
 } psa_zmq_subscriber_entry_t;
 
 
@@ -202,6 +204,7 @@ pubsub_zmq_topic_receiver_t* pubsub_zmqTopicReceiver_create(celix_bundle_context
 
     if (receiver->zmqSock != NULL) {
         celixThreadMutex_create(&receiver->subscribers.mutex, NULL);
+        celixThreadCondition_init(&receiver->subscribers.cond, NULL);
         celixThreadMutex_create(&receiver->requestedConnections.mutex, NULL);
         celixThreadMutex_create(&receiver->recvThread.mutex, NULL);
 
@@ -292,6 +295,7 @@ void pubsub_zmqTopicReceiver_destroy(pubsub_zmq_topic_receiver_t *receiver) {
         hashMap_destroy(receiver->requestedConnections.map, false, false);
         celixThreadMutex_unlock(&receiver->requestedConnections.mutex);
 
+        celixThreadCondition_destroy(&receiver->subscribers.cond);
         celixThreadMutex_destroy(&receiver->subscribers.mutex);
         celixThreadMutex_destroy(&receiver->requestedConnections.mutex);
         celixThreadMutex_destroy(&receiver->recvThread.mutex);
@@ -414,37 +418,79 @@ static void pubsub_zmqTopicReceiver_removeSubscriber(void *handle, void *svc, co
 
     celixThreadMutex_lock(&receiver->subscribers.mutex);
     psa_zmq_subscriber_entry_t *entry = hashMap_remove(receiver->subscribers.map, (void*)svcId);
+    while (entry != NULL && entry->useCount > 0) {
+        //note receive calls are done outside the lock, wait till the subscriber is no longer in use
+        celixThreadCondition_wait(&receiver->subscribers.cond, &receiver->subscribers.mutex);
+    }
     free(entry);
     celixThreadMutex_unlock(&receiver->subscribers.mutex);
 }
 
 static void callReceivers(pubsub_zmq_topic_receiver_t *receiver, const char* msgFqn, const pubsub_protocol_message_t *message, void** msg, bool* release, const celix_properties_t* metadata) {
     *release = true;
+
+    //snapshot the subscribers, so that the receive functions are called without holding the subscribers lock
     celixThreadMutex_lock(&receiver->subscribers.mutex);
+    size_t nrOfEntries = 0;
+    size_t nrOfSharedReceivers = 0;
+    psa_zmq_subscriber_entry_t* entries[hashMap_size(receiver->subscribers.map) + 1];
     hash_map_iterator_t iter = hashMapIterator_construct(receiver->subscribers.map);
     while (hashMapIterator_hasNext(&iter)) {
         psa_zmq_subscriber_entry_t* entry = hashMapIterator_nextValue(&iter);
-        if (entry != NULL && entry->subscriberSvc->receive != NULL) {
-            entry->subscriberSvc->receive(entry->subscriberSvc->handle, msgFqn, message->header.msgId, *msg, metadata, release);
-            if (!(*release)) {
-                //receive function has taken ownership, deserialize again for new message
-                struct iovec deSerializeBuffer;
-                deSerializeBuffer.iov_base = message->payload.payload;
-                deSerializeBuffer.iov_len = message->payload.length;
-                celix_status_t status = pubsub_serializerHandler_deserialize(receiver->serializerHandler,
-                                                             message->header.msgId,
-                                                             message->header.msgMajorVersion,
-                                                             message->header.msgMinorVersion,
-                                                              &deSerializeBuffer, 0, msg);
-                if (status != CELIX_SUCCESS) {
-                    L_WARN("[PSA_ZMQ_TR] Cannot deserialize msg type %s for scope/topic %s/%s", msgFqn,
-                           receiver->scope == NULL ? "(null)" : receiver->scope, receiver->topic);
-                    break;
-                }
+        entry->useCount += 1;
+        entries[nrOfEntries++] = entry;
+        if (entry->subscriberSvc->receiveShared != NULL) {
+            nrOfSharedReceivers += 1;
+        }
+    }
+    celixThreadMutex_unlock(&receiver->subscribers.mutex);
+
+    if (nrOfSharedReceivers > 0) {
+        //all shared receivers get the same read-only msg
+        pubsub_shared_msg_t* sharedMsg = pubsub_serializerHandler_createSharedMsg(receiver->serializerHandler, message->header.msgId, *msg);
+        for (size_t i = 0; i < nrOfEntries; ++i) {
+            pubsub_subscriber_t* svc = entries[i]->subscriberSvc;
+            if (svc->receiveShared != NULL) {
+                svc->receiveShared(svc->handle, msgFqn, message->header.msgId, sharedMsg, metadata);
+            }
+        }
+        //if the shared msg is retained, it owns the msg -> msg is NULL and will be deserialized again if needed
+        *msg = pubsub_serializerHandler_reclaimSharedMsg(sharedMsg);
+    }
+
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        pubsub_subscriber_t* svc = entries[i]->subscriberSvc;
+        if (svc->receiveShared != NULL || svc->receive == NULL) {
+            continue;
+        }
+        if (*msg == NULL) {
+            //previous receive function has taken ownership, deserialize again for new message
+            struct iovec deSerializeBuffer;
+            deSerializeBuffer.iov_base = message->payload.payload;
+            deSerializeBuffer.iov_len = message->payload.length;
+            celix_status_t status = pubsub_serializerHandler_deserialize(receiver->serializerHandler,
+                                                                         message->header.msgId,
+                                                                         message->header.msgMajorVersion,
+                                                                         message->header.msgMinorVersion,
+                                                                         &deSerializeBuffer, 0, msg);
+            if (status != CELIX_SUCCESS) {
+                L_WARN("[PSA_ZMQ_TR] Cannot deserialize msg type %s for scope/topic %s/%s", msgFqn,
+                       receiver->scope == NULL ? "(null)" : receiver->scope, receiver->topic);
+                break;
             }
-            *release = true;
         }
+        svc->receive(svc->handle, msgFqn, message->header.msgId, *msg, metadata, release);
+        if (!(*release)) { //receive function has taken ownership
+            *msg = NULL;
+        }
+        *release = true;
     }
+
+    celixThreadMutex_lock(&receiver->subscribers.mutex);
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        entries[i]->useCount -= 1;
+    }
+    celixThreadCondition_broadcast(&receiver->subscribers.cond);
     celixThreadMutex_unlock(&receiver->subscribers.mutex);
 }
 
@@ -473,7 +519,20 @@ static inline void processMsg(pubsub_zmq_topic_receiver_t *receiver, pubsub_prot
             bool release = true;
             if (cont) {
                 callReceivers(receiver, msgFqn, message, &deserializedMsg, &release, metadata);
-                pubsubInterceptorHandler_invokePostReceive(receiver->interceptorsHandler, msgFqn, message->header.msgId, deserializedMsg, metadata);
+                if (deserializedMsg == NULL && pubsubInterceptorHandler_nrOfInterceptors(receiver->interceptorsHandler) > 0) {
+                    //message taken by a subscriber, but still need to call interceptors -> deserialize new message
+                    status = pubsub_serializerHandler_deserialize(receiver->serializerHandler, message->header.msgId,
+                                                                  message->header.msgMajorVersion,
+                                                                  message->header.msgMinorVersion,
+                                                                  &deSerializeBuffer, 0, &deserializedMsg);
+                    if (status != CELIX_SUCCESS) {
+                        L_WARN("[PSA_ZMQ_TR] Cannot deserialize msg type %s for scope/topic %s/%s", msgFqn,
+                               receiver->scope == NULL ? "(null)" : receiver->scope, receiver->topic);
+                    }
+                }
+                if (deserializedMsg != NULL) {
+                    pubsubInterceptorHandler_invokePostReceive(receiver->interceptorsHandler, msgFqn, message->header.msgId, deserializedMsg, metadata);
+                }
             } else {
                 L_TRACE("Skipping receive for msg type %s, based on pre receive interceptor result", msgFqn);
             }
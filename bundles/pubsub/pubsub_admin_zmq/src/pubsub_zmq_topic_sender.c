@@ -26,6 +26,8 @@
 #include <uuid/uuid.h>
 
 #include "celix_utils.h"
+#include "celix_threads.h"
+#include "celix_array_list.h"
 #include "pubsub_constants.h"
 #include "pubsub/publisher.h"
 #include "celix_log_helper.h"
@@ -39,6 +41,7 @@
 
 #define FIRST_SEND_DELAY_IN_SECONDS             2
 #define ZMQ_BIND_MAX_RETRY                      10
+#define PSA_ZMQ_SEND_THREAD_TIMEOUT             100 //ms
 
 #define L_DEBUG(...) \
     celix_logHelper_log(sender->logHelper, CELIX_LOG_LEVEL_DEBUG, __VA_ARGS__)
@@ -69,20 +72,29 @@ struct pubsub_zmq_topic_sender {
     long seqNr; //atomic
 
     struct {
-        bool dataLock; //atomic, protects below and protect zmq internal data
-        void *headerBuffer;
-        size_t headerBufferSize;
-        void *metadataBuffer;
-        size_t metadataBufferSize;
-        void *footerBuffer;
-        size_t footerBufferSize;
-    } zmqBuffers;
-
-    struct {
-        zsock_t *socket;
+        zsock_t *socket; //note only used by the send thread
         zcert_t *cert;
     } zmq;
 
+    /**
+     * Publishing threads do not share the (not thread-safe) zmq pub socket. Every publishing thread gets its own
+     * send context with a zmq push socket and encode buffers, the send thread forwards the messages from the
+     * inproc pull socket to the zmq pub socket.
+     */
+    struct {
+        celix_tss_key_t key; //value = psa_zmq_send_context_t*
+        char *url; //inproc url of the pull socket
+        zsock_t *socket; //pull socket, only used by the send thread
+        celix_thread_mutex_t mutex; //protects list
+        celix_array_list_t *list; //all created send contexts
+    } sendContexts;
+
+    struct {
+        celix_thread_t thread;
+        celix_thread_mutex_t mutex;
+        bool running;
+    } sendThread;
+
     struct {
         long svcId;
         celix_service_factory_t factory;
@@ -101,6 +113,17 @@ typedef struct psa_zmq_bounded_service_entry {
     int getCount;
 } psa_zmq_bounded_service_entry_t;
 
+typedef struct psa_zmq_send_context {
+    pubsub_zmq_topic_sender_t *parent;
+    zsock_t *socket; //push socket connected to the inproc pull socket of the sender
+    void *headerBuffer;
+    size_t headerBufferSize;
+    void *metadataBuffer;
+    size_t metadataBufferSize;
+    void *footerBuffer;
+    size_t footerBufferSize;
+} psa_zmq_send_context_t;
+
 typedef struct psa_zmq_zerocopy_free_entry {
     uint32_t msgId;
     pubsub_serializer_handler_t *serHandler;
@@ -113,6 +136,9 @@ static void* psa_zmq_getPublisherService(void *handle, const celix_bundle_t *req
 static void psa_zmq_ungetPublisherService(void *handle, const celix_bundle_t *requestingBundle, const celix_properties_t *svcProperties);
 static unsigned int rand_range(unsigned int min, unsigned int max);
 static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, const void *msg, celix_properties_t *metadata);
+static void* psa_zmq_sendThread(void *data);
+static void psa_zmq_destroySendContext(void *data);
+static void psa_zmq_destroyTssSendContext(void *data);
 
 pubsub_zmq_topic_sender_t* pubsub_zmqTopicSender_create(
         celix_bundle_context_t *ctx,
@@ -252,12 +278,45 @@ pubsub_zmq_topic_sender_t* pubsub_zmqTopicSender_create(
         }
     }
 
+    //setting up the inproc pull socket for the publishing threads
+    if (sender->url != NULL) {
+        if (asprintf(&sender->sendContexts.url, "inproc://psa_zmq_ts_%p", (void*)sender) < 0) {
+            L_ERROR("[PSA_ZMQ_TS] Cannot create inproc url for topic %s", topic);
+            sender->sendContexts.url = NULL;
+            zsock_destroy(&sender->zmq.socket);
+            free(sender->url);
+            sender->url = NULL;
+        }
+    }
+
+    if (sender->url != NULL) {
+        sender->sendContexts.socket = zsock_new_pull(sender->sendContexts.url); //note zsock_new_pull binds by default
+        if (sender->sendContexts.socket == NULL) {
+            L_ERROR("[PSA_ZMQ_TS] Cannot bind inproc pull socket %s", sender->sendContexts.url);
+            zsock_destroy(&sender->zmq.socket);
+            free(sender->sendContexts.url);
+            free(sender->url);
+            sender->url = NULL;
+        }
+    }
+
     if (sender->url != NULL) {
         sender->scope = scope == NULL ? NULL : celix_utils_strdup(scope);
         sender->topic = celix_utils_strdup(topic);
 
         celixThreadMutex_create(&sender->boundedServices.mutex, NULL);
         sender->boundedServices.map = hashMap_create(NULL, NULL, NULL, NULL);
+
+        celix_tss_create(&sender->sendContexts.key, psa_zmq_destroyTssSendContext);
+        celixThreadMutex_create(&sender->sendContexts.mutex, NULL);
+        sender->sendContexts.list = celix_arrayList_create();
+
+        celixThreadMutex_create(&sender->sendThread.mutex, NULL);
+        sender->sendThread.running = true;
+        celixThread_create(&sender->sendThread.thread, NULL, psa_zmq_sendThread, sender);
+        char name[64];
+        snprintf(name, 64, "ZMQ TS %s/%s", scope == NULL ? "(null)" : scope, topic);
+        celixThread_setName(&sender->sendThread.thread, name);
     }
 
     //register publisher services using a service factory
@@ -293,6 +352,25 @@ void pubsub_zmqTopicSender_destroy(pubsub_zmq_topic_sender_t *sender) {
     if (sender != NULL) {
         celix_bundleContext_unregisterService(sender->ctx, sender->publisher.svcId);
 
+        celixThreadMutex_lock(&sender->sendThread.mutex);
+        sender->sendThread.running = false;
+        celixThreadMutex_unlock(&sender->sendThread.mutex);
+        celixThread_join(sender->sendThread.thread, NULL);
+        celixThreadMutex_destroy(&sender->sendThread.mutex);
+
+        //note publisher service is unregistered, so the send contexts are no longer used.
+        //The tss key is deleted first, so that exiting threads no longer destroy their send context.
+        celixThreadMutex_lock(&sender->sendContexts.mutex);
+        celix_tss_delete(sender->sendContexts.key);
+        for (int i = 0; i < celix_arrayList_size(sender->sendContexts.list); ++i) {
+            psa_zmq_destroySendContext(celix_arrayList_get(sender->sendContexts.list, i));
+        }
+        celix_arrayList_destroy(sender->sendContexts.list);
+        celixThreadMutex_unlock(&sender->sendContexts.mutex);
+        celixThreadMutex_destroy(&sender->sendContexts.mutex);
+        zsock_destroy(&sender->sendContexts.socket);
+        free(sender->sendContexts.url);
+
         zsock_destroy(&sender->zmq.socket);
 
         celixThreadMutex_lock(&sender->boundedServices.mutex);
@@ -308,9 +386,6 @@ void pubsub_zmqTopicSender_destroy(pubsub_zmq_topic_sender_t *sender) {
         }
         free(sender->topic);
         free(sender->url);
-        free(sender->zmqBuffers.headerBuffer);
-        free(sender->zmqBuffers.metadataBuffer);
-        free(sender->zmqBuffers.footerBuffer);
         free(sender);
     }
 }
@@ -391,6 +466,58 @@ static void psa_zmq_freeMsg(void *msg, void *hint) {
     free(entry);
 }
 
+static void psa_zmq_destroySendContext(void *data) {
+    psa_zmq_send_context_t *sendCtx = data;
+    zsock_destroy(&sendCtx->socket);
+    free(sendCtx->headerBuffer);
+    free(sendCtx->metadataBuffer);
+    free(sendCtx->footerBuffer);
+    free(sendCtx);
+}
+
+/**
+ * Called when a publishing thread exits, closes the push socket and removes the send context of the thread.
+ */
+static void psa_zmq_destroyTssSendContext(void *data) {
+    psa_zmq_send_context_t *sendCtx = data;
+    pubsub_zmq_topic_sender_t *sender = sendCtx->parent;
+    celixThreadMutex_lock(&sender->sendContexts.mutex);
+    celix_arrayList_remove(sender->sendContexts.list, sendCtx);
+    celixThreadMutex_unlock(&sender->sendContexts.mutex);
+    psa_zmq_destroySendContext(sendCtx);
+}
+
+/**
+ * Returns the send context of the calling thread, creating it on first use.
+ * Only the creation of a send context is done under a lock.
+ */
+static psa_zmq_send_context_t* psa_zmq_getSendContext(pubsub_zmq_topic_sender_t *sender) {
+    psa_zmq_send_context_t *sendCtx = celix_tss_get(sender->sendContexts.key);
+    if (sendCtx == NULL) {
+        zsock_t *socket = zsock_new_push(sender->sendContexts.url); //note zsock_new_push connects by default
+        if (socket == NULL) {
+            L_ERROR("[PSA_ZMQ_TS] Cannot connect inproc push socket to %s", sender->sendContexts.url);
+            return NULL;
+        }
+        sendCtx = calloc(1, sizeof(*sendCtx));
+        sendCtx->parent = sender;
+        sendCtx->socket = socket;
+        celixThreadMutex_lock(&sender->sendContexts.mutex);
+        celix_arrayList_add(sender->sendContexts.list, sendCtx);
+        celixThreadMutex_unlock(&sender->sendContexts.mutex);
+        celix_tss_set(sender->sendContexts.key, sendCtx);
+    }
+    return sendCtx;
+}
+
+/**
+ * Init a zmq msg with a copy of a (small) encode buffer, so that the thread local buffer can directly be reused.
+ */
+static void psa_zmq_initMsgWithCopy(zmq_msg_t *msg, const void *buffer, size_t size) {
+    zmq_msg_init_size(msg, size);
+    memcpy(zmq_msg_data(msg), buffer, size);
+}
+
 static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, const void *inMsg, celix_properties_t *metadata) {
     psa_zmq_bounded_service_entry_t *bound = handle;
     pubsub_zmq_topic_sender_t *sender = bound->parent;
@@ -405,6 +532,12 @@ static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, co
         return status;
     }
 
+    psa_zmq_send_context_t *sendCtx = psa_zmq_getSendContext(sender);
+    if (sendCtx == NULL) {
+        celix_properties_destroy(metadata);
+        return CELIX_ILLEGAL_STATE;
+    }
+
     bool cont = pubsubInterceptorHandler_invokePreSend(sender->interceptorsHandler, msgFqn, msgTypeId, inMsg, &metadata);
     if (!cont) {
         L_DEBUG("Cancel send based on pubsub interceptor cancel return");
@@ -422,14 +555,6 @@ static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, co
         return status;
     }
 
-    // Some ZMQ functions are not thread-safe, but this atomic compare exchange ensures one access at a time.
-    // Also protect sender->zmqBuffers (header, meta and footer)
-    bool expected = false;
-    while(!__atomic_compare_exchange_n(&sender->zmqBuffers.dataLock, &expected, true, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
-        expected = false;
-        usleep(5);
-    }
-
     pubsub_protocol_message_t message;
     message.payload.payload = serializedIoVecOutput->iov_base;
     message.payload.length = serializedIoVecOutput->iov_len;
@@ -442,12 +567,12 @@ static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, co
     size_t metadataSize = 0;
     if (metadata != NULL) {
         message.metadata.metadata = metadata;
-        sender->protocol->encodeMetadata(sender->protocol->handle, &message, &sender->zmqBuffers.metadataBuffer, &sender->zmqBuffers.metadataBufferSize, &metadataSize);
+        sender->protocol->encodeMetadata(sender->protocol->handle, &message, &sendCtx->metadataBuffer, &sendCtx->metadataBufferSize, &metadataSize);
     } else {
         message.metadata.metadata = NULL;
     }
 
-    sender->protocol->encodeFooter(sender->protocol->handle, &message, &sender->zmqBuffers.footerBuffer, &sender->zmqBuffers.footerBufferSize);
+    sender->protocol->encodeFooter(sender->protocol->handle, &message, &sendCtx->footerBuffer, &sendCtx->footerBufferSize);
 
     message.header.msgId = msgTypeId;
     message.header.seqNr = __atomic_fetch_add(&sender->seqNr, 1, __ATOMIC_RELAXED);
@@ -459,7 +584,7 @@ static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, co
     message.header.payloadOffset = 0;
     message.header.isLastSegment = 1;
 
-    sender->protocol->encodeHeader(sender->protocol->handle, &message, &sender->zmqBuffers.headerBuffer, &sender->zmqBuffers.headerBufferSize);
+    sender->protocol->encodeHeader(sender->protocol->handle, &message, &sendCtx->headerBuffer, &sendCtx->headerBufferSize);
 
     errno = 0;
     bool sendOk;
@@ -468,14 +593,14 @@ static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, co
         zmq_msg_t msg2; // Payload
         zmq_msg_t msg3; // Metadata
         zmq_msg_t msg4; // Footer
-        void *socket = zsock_resolve(sender->zmq.socket);
+        void *socket = zsock_resolve(sendCtx->socket);
         psa_zmq_zerocopy_free_entry *freeMsgEntry = malloc(sizeof(psa_zmq_zerocopy_free_entry)); //NOTE should be improved. Not really zero copy
         freeMsgEntry->serHandler = sender->serializerHandler;
         freeMsgEntry->msgId = msgTypeId;
         freeMsgEntry->serializedOutput = serializedIoVecOutput;
         freeMsgEntry->serializedOutputLen = serializedIoVecOutputLen;
 
-        zmq_msg_init_data(&msg1, sender->zmqBuffers.headerBuffer, sender->zmqBuffers.headerBufferSize, NULL, NULL);
+        psa_zmq_initMsgWithCopy(&msg1, sendCtx->headerBuffer, sendCtx->headerBufferSize);
         //send header
         int rc = zmq_msg_send(&msg1, socket, ZMQ_SNDMORE);
         if (rc == -1) {
@@ -485,19 +610,21 @@ static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, co
 
         //send Payload
         if (rc > 0) {
-            int flag = ((metadataSize > 0)  || (sender->zmqBuffers.footerBufferSize > 0)) ? ZMQ_SNDMORE : 0;
+            int flag = ((metadataSize > 0)  || (sendCtx->footerBufferSize > 0)) ? ZMQ_SNDMORE : 0;
             zmq_msg_init_data(&msg2, payloadData, payloadLength, psa_zmq_freeMsg, freeMsgEntry);
             rc = zmq_msg_send(&msg2, socket, flag);
             if (rc == -1) {
                 L_WARN("Error sending payload msg. %s", strerror(errno));
                 zmq_msg_close(&msg2);
             }
+        } else {
+            psa_zmq_freeMsg(NULL, freeMsgEntry);
         }
 
         //send MetaData
         if (rc > 0 && metadataSize > 0) {
-            int flag = (sender->zmqBuffers.footerBufferSize > 0 ) ? ZMQ_SNDMORE : 0;
-            zmq_msg_init_data(&msg3, sender->zmqBuffers.metadataBuffer, metadataSize, NULL, NULL);
+            int flag = (sendCtx->footerBufferSize > 0 ) ? ZMQ_SNDMORE : 0;
+            psa_zmq_initMsgWithCopy(&msg3, sendCtx->metadataBuffer, metadataSize);
             rc = zmq_msg_send(&msg3, socket, flag);
             if (rc == -1) {
                 L_WARN("Error sending metadata msg. %s", strerror(errno));
@@ -506,8 +633,8 @@ static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, co
         }
 
         //send Footer
-        if (rc > 0 && sender->zmqBuffers.footerBufferSize > 0) {
-            zmq_msg_init_data(&msg4, sender->zmqBuffers.footerBuffer, sender->zmqBuffers.footerBufferSize, NULL, NULL);
+        if (rc > 0 && sendCtx->footerBufferSize > 0) {
+            psa_zmq_initMsgWithCopy(&msg4, sendCtx->footerBuffer, sendCtx->footerBufferSize);
             rc = zmq_msg_send(&msg4, socket, 0);
             if (rc == -1) {
                 L_WARN("Error sending footer msg. %s", strerror(errno));
@@ -518,15 +645,15 @@ static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, co
     } else {
         //no zero copy
         zmsg_t *msg = zmsg_new();
-        zmsg_addmem(msg, sender->zmqBuffers.headerBuffer, sender->zmqBuffers.headerBufferSize);
+        zmsg_addmem(msg, sendCtx->headerBuffer, sendCtx->headerBufferSize);
         zmsg_addmem(msg, payloadData, payloadLength);
         if (metadataSize > 0) {
-            zmsg_addmem(msg, sender->zmqBuffers.metadataBuffer, metadataSize);
+            zmsg_addmem(msg, sendCtx->metadataBuffer, metadataSize);
         }
-        if (sender->zmqBuffers.footerBufferSize > 0) {
-            zmsg_addmem(msg, sender->zmqBuffers.footerBuffer, sender->zmqBuffers.footerBufferSize);
+        if (sendCtx->footerBufferSize > 0) {
+            zmsg_addmem(msg, sendCtx->footerBuffer, sendCtx->footerBufferSize);
         }
-        int rc = zmsg_send(&msg, sender->zmq.socket);
+        int rc = zmsg_send(&msg, sendCtx->socket);
         sendOk = rc == 0;
 
         if (!sendOk) {
@@ -538,7 +665,6 @@ static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, co
             free(payloadData);
         }
     }
-    __atomic_store_n(&sender->zmqBuffers.dataLock, false, __ATOMIC_RELEASE);
     pubsubInterceptorHandler_invokePostSend(sender->interceptorsHandler, msgFqn, msgTypeId, inMsg, metadata);
 
     if (!bound->parent->zeroCopyEnabled && serializedIoVecOutput) {
@@ -553,6 +679,51 @@ static int psa_zmq_topicPublicationSend(void* handle, unsigned int msgTypeId, co
     return status;
 }
 
+/**
+ * Forwards all available (multipart) messages from the inproc pull socket to the zmq pub socket.
+ * Note that the zmq msg parts are moved, so a zero copy payload stays zero copy.
+ */
+static void psa_zmq_forwardMessages(pubsub_zmq_topic_sender_t *sender, void *in, void *out) {
+    zmq_msg_t part;
+    while (true) {
+        zmq_msg_init(&part);
+        int rc = zmq_msg_recv(&part, in, ZMQ_DONTWAIT);
+        if (rc == -1) { //note EAGAIN, no more messages available
+            zmq_msg_close(&part);
+            break;
+        }
+        int flag = zmq_msg_more(&part) ? ZMQ_SNDMORE : 0;
+        rc = zmq_msg_send(&part, out, flag);
+        if (rc == -1) {
+            L_WARN("[PSA_ZMQ_TS] Error forwarding zmq msg. %s", strerror(errno));
+            zmq_msg_close(&part);
+        }
+    }
+}
+
+static void* psa_zmq_sendThread(void *data) {
+    pubsub_zmq_topic_sender_t *sender = data;
+    void *in = zsock_resolve(sender->sendContexts.socket);
+    void *out = zsock_resolve(sender->zmq.socket);
+
+    celixThreadMutex_lock(&sender->sendThread.mutex);
+    bool running = sender->sendThread.running;
+    celixThreadMutex_unlock(&sender->sendThread.mutex);
+
+    while (running) {
+        zmq_pollitem_t item = { .socket = in, .fd = 0, .events = ZMQ_POLLIN, .revents = 0 };
+        int rc = zmq_poll(&item, 1, PSA_ZMQ_SEND_THREAD_TIMEOUT);
+        if (rc > 0) {
+            psa_zmq_forwardMessages(sender, in, out);
+        }
+
+        celixThreadMutex_lock(&sender->sendThread.mutex);
+        running = sender->sendThread.running;
+        celixThreadMutex_unlock(&sender->sendThread.mutex);
+    }
+    return NULL;
+}
+
 static unsigned int rand_range(unsigned int min, unsigned int max) {
     double scaled = ((double)random())/((double)RAND_MAX);
     return (unsigned int)((max-min+1)*scaled + min);
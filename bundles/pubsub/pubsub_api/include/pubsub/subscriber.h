@@ -29,13 +29,43 @@ extern "C" {
 #include "celix_properties.h"
 
 #define PUBSUB_SUBSCRIBER_SERVICE_NAME          "pubsub.subscriber"
-#define PUBSUB_SUBSCRIBER_SERVICE_VERSION       "3.0.0"
+#define PUBSUB_SUBSCRIBER_SERVICE_VERSION       "3.1.0"
  
 //properties
 #define PUBSUB_SUBSCRIBER_TOPIC                "topic"
 #define PUBSUB_SUBSCRIBER_SCOPE                "scope"
 #define PUBSUB_SUBSCRIBER_CONFIG               "pubsub.config"
 
+/**
+ * A ref counted, read-only deserialized message.
+ *
+ * The same shared message is provided to all subscribers which use the receiveShared callback, so the message
+ * is deserialized only once. A subscriber which needs the message after the receiveShared call can retain
+ * the shared message (only during the receiveShared call) and must release it when done.
+ * The message itself must not be modified.
+ */
+struct pubsub_shared_msg_struct {
+    void *handle;
+
+    /**
+     * The deserialized message. Read-only.
+     */
+    const void *msg;
+
+    /**
+     * Increase the reference count of the shared message.
+     * Should only be called during the receiveShared callback or on an already retained shared message.
+     */
+    void (*retain)(void *handle);
+
+    /**
+     * Decrease the reference count of the shared message. The message is freed when the last reference is released.
+     * A retained shared message should be released at the latest when the subscriber service is unregistered.
+     */
+    void (*release)(void *handle);
+};
+typedef struct pubsub_shared_msg_struct pubsub_shared_msg_t;
+
 struct pubsub_subscriber_struct {
     void *handle;
 
@@ -71,6 +101,23 @@ struct pubsub_subscriber_struct {
       */
     int (*receive)(void *handle, const char *msgType, unsigned int msgTypeId, void *msg, const celix_properties_t *metadata, bool *release);
 
+    /**
+     * When a new message for a topic is available the receiveShared will be called, instead of receive.
+     *
+     * The provided shared message is read-only and shared with other subscribers, so a message is only deserialized
+     * once for all subscribers using receiveShared. To keep the message after the call, retain the shared message.
+     *
+     * this method can be NULL. Note added in version 3.1.0, pubsub admins supporting only version 3.0.0 will
+     * call receive.
+     *
+     * @param handle       The subscriber handle
+     * @param msgType      The fully qualified type name
+     * @param msgTypeId    The local type id of the type, how this is calculated/created is up to the pubsub admin.
+     * @param msg          The shared message, only valid during the callback unless retained.
+     * @param metadata     The meta data provided with the data. Can be NULL and is only valid during the callback.
+     * @return Return 0 implies a successful handling.
+     */
+    int (*receiveShared)(void *handle, const char *msgType, unsigned int msgTypeId, pubsub_shared_msg_t *msg, const celix_properties_t *metadata);
 };
 typedef struct pubsub_subscriber_struct pubsub_subscriber_t;
 
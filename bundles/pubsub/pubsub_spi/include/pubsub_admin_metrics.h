@@ -44,12 +44,21 @@ typedef struct pubsub_admin_sender_msg_type_metrics {
     double averageSerializationTimeInSeconds;
 } pubsub_admin_sender_msg_type_metrics_t;
 
+typedef struct pubsub_admin_sender_connection_metrics {
+    char url[PUBSUB_AMDIN_METRICS_NAME_MAX];
+    unsigned long nrOfQueuedMessages;
+    unsigned long nrOfQueuedBytes;
+    unsigned long nrOfDroppedMessages;
+} pubsub_admin_sender_connection_metrics_t;
+
 typedef struct pubsub_admin_sender_metrics {
     char scope[PUBSUB_AMDIN_METRICS_NAME_MAX];
     char topic[PUBSUB_AMDIN_METRICS_NAME_MAX];
     unsigned long nrOfUnknownMessagesRetrieved;
     unsigned int nrOfmsgMetrics;
     pubsub_admin_sender_msg_type_metrics_t *msgMetrics; //size = nrOfMessageTypes
+    unsigned int nrOfConnections;
+    pubsub_admin_sender_connection_metrics_t *connections; //size = nrOfConnections, optional send queue metrics per connection
 } pubsub_admin_sender_metrics_t;
 
 typedef struct pubsub_admin_receiver_metrics {
@@ -1354,6 +1354,12 @@ static celix_status_t pubsub_topologyManager_metrics(pubsub_topology_manager_t *
                 fprintf(os, "      |- average serialization time = %f s\n", sm->msgMetrics[j].averageSerializationTimeInSeconds);
                 fprintf(os, "      |- average time between messages = %f s\n", sm->msgMetrics[j].averageTimeBetweenMessagesInSeconds);
             }
+            for (int j = 0; j < sm->nrOfConnections; ++j) {
+                fprintf(os, "   |- Connection %s:\n", sm->connections[j].url);
+                fprintf(os, "      |- queued messages = %lu\n", sm->connections[j].nrOfQueuedMessages);
+                fprintf(os, "      |- queued bytes = %lu\n", sm->connections[j].nrOfQueuedBytes);
+                fprintf(os, "      |- dropped messages = %lu\n", sm->connections[j].nrOfDroppedMessages);
+            }
         }
         for (int k = 0; k < celix_arrayList_size(metrics->receivers); ++k) {
             pubsub_admin_receiver_metrics_t *rm = celix_arrayList_get(metrics->receivers, k);
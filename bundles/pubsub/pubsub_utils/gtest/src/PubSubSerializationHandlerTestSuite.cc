@@ -336,4 +336,53 @@ TEST_F(PubSubSerializationHandlerTestSuite, CallingFreeWithNULLWillBeSilentlyIgn
 
     celix_bundleContext_unregisterService(ctx.get(), svcId1);
     pubsub_serializerHandler_destroy(handler);
-}
\ No newline at end of file
+}
+TEST_F(PubSubSerializationHandlerTestSuite, SharedMsg) {
+    auto *handler = pubsub_serializerHandler_create(ctx.get(), "json", false);
+    long svcId1 = registerSerSvc("json", 42, "example::Msg1", "1.0.0");
+    void* dummyMsg = (void*)0x42;
+
+    EXPECT_EQ(nullptr, pubsub_serializerHandler_createSharedMsg(handler, 42, nullptr));
+
+    //not retained, so the ownership of the msg is returned.
+    auto* sharedMsg = pubsub_serializerHandler_createSharedMsg(handler, 42, dummyMsg);
+    ASSERT_NE(nullptr, sharedMsg);
+    EXPECT_EQ(dummyMsg, sharedMsg->msg);
+    EXPECT_EQ(dummyMsg, pubsub_serializerHandler_reclaimSharedMsg(sharedMsg));
+    EXPECT_EQ(0, freeDeserializedMsgCallCount);
+
+    //retained, so the msg is freed with the last release.
+    sharedMsg = pubsub_serializerHandler_createSharedMsg(handler, 42, dummyMsg);
+    sharedMsg->retain(sharedMsg->handle);
+    sharedMsg->retain(sharedMsg->handle);
+    EXPECT_EQ(nullptr, pubsub_serializerHandler_reclaimSharedMsg(sharedMsg));
+    sharedMsg->release(sharedMsg->handle);
+    EXPECT_EQ(0, freeDeserializedMsgCallCount);
+    sharedMsg->release(sharedMsg->handle);
+    EXPECT_EQ(1, freeDeserializedMsgCallCount);
+
+    celix_bundleContext_unregisterService(ctx.get(), svcId1);
+    pubsub_serializerHandler_destroy(handler);
+}
+
+TEST_F(PubSubSerializationHandlerTestSuite, ReleaseSharedMsgAfterHandlerIsDestroyed) {
+    //note a topic receiver destroys its serializer handler, a subscriber can still have a retained shared msg
+    auto *handler = pubsub_serializerHandler_create(ctx.get(), "json", false);
+    long svcId1 = registerSerSvc("json", 42, "example::Msg1", "1.0.0");
+    void* dummyMsg = (void*)0x42;
+
+    auto* sharedMsg = pubsub_serializerHandler_createSharedMsg(handler, 42, dummyMsg);
+    ASSERT_NE(nullptr, sharedMsg);
+    sharedMsg->retain(sharedMsg->handle);
+    EXPECT_EQ(nullptr, pubsub_serializerHandler_reclaimSharedMsg(sharedMsg));
+
+    pubsub_serializerHandler_destroy(handler);
+    celix_bundleContext_waitForEvents(ctx.get());
+    celix_bundleContext_unregisterService(ctx.get(), svcId1);
+
+    //the shared msg keeps the (destroyed) handler alive, the msg cannot be freed because the serialization service is
+    //no longer tracked.
+    EXPECT_EQ(dummyMsg, sharedMsg->msg);
+    sharedMsg->release(sharedMsg->handle);
+    EXPECT_EQ(0, freeDeserializedMsgCallCount);
+}
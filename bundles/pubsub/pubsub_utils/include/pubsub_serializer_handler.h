@@ -25,6 +25,7 @@
 
 #include "celix_log_helper.h"
 #include "celix_bundle_context.h"
+#include "pubsub/subscriber.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -130,6 +131,27 @@ celix_status_t pubsub_serializerHandler_deserialize(pubsub_serializer_handler_t*
  */
 celix_status_t pubsub_serializerHandler_freeDeserializedMsg(pubsub_serializer_handler_t* handler, uint32_t msgId, void* msg);
 
+/**
+ * @brief Creates a ref counted shared message for a deserialized message, with a reference count of 1.
+ *
+ * The shared message takes over the ownership of the deserialized message and frees it - using
+ * pubsub_serializerHandler_freeDeserializedMsg - when the last reference is released.
+ * The shared message keeps the serializer handler alive, so the shared message can be released after the serializer
+ * handler is destroyed. In that case the serialization services are no longer tracked and the deserialized message
+ * cannot be freed; a warning is logged.
+ * @return The shared message or NULL if msg is NULL.
+ */
+pubsub_shared_msg_t* pubsub_serializerHandler_createSharedMsg(pubsub_serializer_handler_t* handler, uint32_t msgId, void* msg);
+
+/**
+ * @brief Releases the reference from pubsub_serializerHandler_createSharedMsg.
+ *
+ * If that was the last reference, the shared message is destroyed and the ownership of the deserialized message is
+ * returned to the caller. Otherwise the deserialized message will be freed when the last reference is released and
+ * NULL is returned.
+ */
+void* pubsub_serializerHandler_reclaimSharedMsg(pubsub_shared_msg_t* sharedMsg);
+
 /**
  * @brief Whether the msg is support. More specifically:
  *  - msg id is known and
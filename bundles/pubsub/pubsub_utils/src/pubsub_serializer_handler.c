@@ -30,6 +30,7 @@
 #include "celix_constants.h"
 #include "celix_threads.h"
 #include "celix_utils.h"
+#include "celix_log_utils.h"
 
 #define L_DEBUG(...) \
     celix_logHelper_debug(handler->logHelper, __VA_ARGS__)
@@ -57,7 +58,10 @@ struct pubsub_serializer_handler {
     long serializationSvcTrackerId;
     celix_log_helper_t *logHelper;
 
+    int refCount; //atomic, 1 for the handler itself and 1 for every not yet released shared msg
+
     celix_thread_rwlock_t lock;
+    bool stopped; //true if the serialization services are no longer tracked (handler is destroyed)
     hash_map_t *serializationServices; //key = msg id, value = sorted array list with pubsub_serialization_service_entry_t*
     hash_map_t *msgFullyQualifiedNames; //key = msg id, value = msg fqn. Non destructive map with msg fqn
 };
@@ -114,6 +118,7 @@ pubsub_serializer_handler_t* pubsub_serializerHandler_create(celix_bundle_contex
     handler->ctx = ctx;
     handler->serType = celix_utils_strdup(serializerType);
     handler->backwardCompatible = backwardCompatible;
+    handler->refCount = 1;
 
     handler->logHelper = celix_logHelper_create(ctx, "celix_pubsub_serialization_handler");
 
@@ -180,8 +185,14 @@ pubsub_serializer_handler_t* pubsub_serializerHandler_createForMarkerService(cel
     return data.handler;
 }
 
-static void pubsub_serializerHandler_destroyCallback(void* data) {
-    pubsub_serializer_handler_t* handler = data;
+static void pubsub_serializerHandler_retain(pubsub_serializer_handler_t* handler) {
+    __atomic_add_fetch(&handler->refCount, 1, __ATOMIC_RELAXED);
+}
+
+static void pubsub_serializerHandler_release(pubsub_serializer_handler_t* handler) {
+    if (__atomic_sub_fetch(&handler->refCount, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
     celixThreadRwlock_destroy(&handler->lock);
     hash_map_iterator_t iter = hashMapIterator_construct(handler->serializationServices);
     while (hashMapIterator_hasNext(&iter)) {
@@ -195,12 +206,22 @@ static void pubsub_serializerHandler_destroyCallback(void* data) {
     }
     hashMap_destroy(handler->serializationServices, false, false);
     hashMap_destroy(handler->msgFullyQualifiedNames, false, true);
-    celix_logHelper_destroy(handler->logHelper);
     free(handler->serType);
     free(handler->filter);
     free(handler);
 }
 
+static void pubsub_serializerHandler_destroyCallback(void* data) {
+    pubsub_serializer_handler_t* handler = data;
+    //note the log helper uses the bundle context, so it is destroyed now and not when the last shared msg is released
+    celixThreadRwlock_writeLock(&handler->lock);
+    handler->stopped = true;
+    celix_logHelper_destroy(handler->logHelper);
+    handler->logHelper = NULL;
+    celixThreadRwlock_unlock(&handler->lock);
+    pubsub_serializerHandler_release(handler);
+}
+
 void pubsub_serializerHandler_destroy(pubsub_serializer_handler_t* handler) {
     if (handler != NULL) {
         celix_bundleContext_stopTrackerAsync(handler->ctx, handler->serializationSvcTrackerId, handler, pubsub_serializerHandler_destroyCallback);
@@ -374,6 +395,73 @@ celix_status_t pubsub_serializerHandler_freeDeserializedMsg(pubsub_serializer_ha
     return status;
 }
 
+typedef struct pubsub_serializer_handler_shared_msg {
+    pubsub_shared_msg_t sharedMsg; //note first member, so the shared msg can be cast to this struct
+    pubsub_serializer_handler_t* handler;
+    uint32_t msgId;
+    int refCount;
+} pubsub_serializer_handler_shared_msg_t;
+
+static void pubsub_serializerHandler_retainSharedMsg(void* handle) {
+    pubsub_serializer_handler_shared_msg_t* entry = handle;
+    __atomic_add_fetch(&entry->refCount, 1, __ATOMIC_RELAXED);
+}
+
+static void pubsub_serializerHandler_releaseSharedMsg(void* handle) {
+    pubsub_serializer_handler_shared_msg_t* entry = handle;
+    if (__atomic_sub_fetch(&entry->refCount, 1, __ATOMIC_ACQ_REL) != 0) {
+        return;
+    }
+    pubsub_serializer_handler_t* handler = entry->handler;
+    celixThreadRwlock_readLock(&handler->lock);
+    if (handler->stopped) {
+        //note the serialization services are no longer tracked, so the msg cannot be safely freed.
+        celix_logUtils_logToStdout("celix_pubsub_serialization_handler", CELIX_LOG_LEVEL_WARNING,
+                                   "Shared msg with msg id %u released after the serializer handler is destroyed. Cannot free msg.",
+                                   entry->msgId);
+    } else {
+        pubsub_serialization_service_entry_t* svcEntry = findEntry(handler, entry->msgId);
+        if (svcEntry != NULL) {
+            svcEntry->svc->freeDeserializedMsg(svcEntry->svc->handle, (void*)entry->sharedMsg.msg);
+        } else {
+            L_ERROR("Cannot find message serialization service for msg id %u.", entry->msgId);
+        }
+    }
+    celixThreadRwlock_unlock(&handler->lock);
+    free(entry);
+    pubsub_serializerHandler_release(handler);
+}
+
+pubsub_shared_msg_t* pubsub_serializerHandler_createSharedMsg(pubsub_serializer_handler_t* handler, uint32_t msgId, void* msg) {
+    if (msg == NULL) {
+        return NULL;
+    }
+    pubsub_serializer_handler_shared_msg_t* entry = calloc(1, sizeof(*entry));
+    pubsub_serializerHandler_retain(handler); //note a shared msg can outlive the (destroyed) serializer handler
+    entry->handler = handler;
+    entry->msgId = msgId;
+    entry->refCount = 1;
+    entry->sharedMsg.handle = entry;
+    entry->sharedMsg.msg = msg;
+    entry->sharedMsg.retain = pubsub_serializerHandler_retainSharedMsg;
+    entry->sharedMsg.release = pubsub_serializerHandler_releaseSharedMsg;
+    return &entry->sharedMsg;
+}
+
+void* pubsub_serializerHandler_reclaimSharedMsg(pubsub_shared_msg_t* sharedMsg) {
+    if (sharedMsg == NULL) {
+        return NULL;
+    }
+    pubsub_serializer_handler_shared_msg_t* entry = sharedMsg->handle;
+    void* msg = NULL;
+    if (__atomic_sub_fetch(&entry->refCount, 1, __ATOMIC_ACQ_REL) == 0) {
+        msg = (void*)entry->sharedMsg.msg;
+        pubsub_serializerHandler_release(entry->handler);
+        free(entry);
+    }
+    return msg;
+}
+
 bool pubsub_serializerHandler_isMessageSupported(pubsub_serializer_handler_t* handler, uint32_t msgId, int majorVersion, int minorVersion) {
     celixThreadRwlock_readLock(&handler->lock);
     bool compatible = false;
@@ -0,0 +1,133 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "curl_handle_pool.h"
+
+class CurlHandlePoolTestSuite : public ::testing::Test {
+public:
+    CurlHandlePoolTestSuite() {
+        curl_global_init(CURL_GLOBAL_ALL);
+    }
+
+    ~CurlHandlePoolTestSuite() override {
+        curlHandlePool_destroy(pool);
+        curl_global_cleanup();
+    }
+
+    CurlHandlePoolTestSuite(const CurlHandlePoolTestSuite&) = delete;
+    CurlHandlePoolTestSuite& operator=(const CurlHandlePoolTestSuite&) = delete;
+
+    curl_handle_pool_t *pool{nullptr};
+};
+
+static const char *URL1 = "http://127.0.0.1:8888/services/1";
+static const char *URL2 = "http://127.0.0.1:8888/services/2";
+
+TEST_F(CurlHandlePoolTestSuite, ReuseHandleTest) {
+    ASSERT_EQ(CELIX_SUCCESS, curlHandlePool_create(2, &pool));
+
+    CURL *handle = curlHandlePool_acquire(pool, URL1);
+    ASSERT_NE(nullptr, handle);
+    curlHandlePool_release(pool, URL1, handle, true, 10);
+
+    //the idle handle is reused for the same endpoint, but not for another endpoint
+    EXPECT_EQ(handle, curlHandlePool_acquire(pool, URL1));
+    CURL *handle2 = curlHandlePool_acquire(pool, URL2);
+    EXPECT_NE(handle, handle2);
+
+    curlHandlePool_release(pool, URL1, handle, true, 10);
+    curlHandlePool_release(pool, URL2, handle2, true, 10);
+}
+
+TEST_F(CurlHandlePoolTestSuite, FailedCallHandleIsNotReusedTest) {
+    ASSERT_EQ(CELIX_SUCCESS, curlHandlePool_create(2, &pool));
+
+    CURL *handle = curlHandlePool_acquire(pool, URL1);
+    curlHandlePool_release(pool, URL1, handle, false, 10);
+
+    curl_handle_pool_statistics_t stats;
+    ASSERT_EQ(CELIX_SUCCESS, curlHandlePool_getStatistics(pool, URL1, &stats));
+    EXPECT_EQ(1, stats.nrOfCalls);
+    EXPECT_EQ(0, stats.nrOfIdleHandles);
+}
+
+TEST_F(CurlHandlePoolTestSuite, MaxIdleHandlesTest) {
+    ASSERT_EQ(CELIX_SUCCESS, curlHandlePool_create(2, &pool));
+
+    CURL *handles[3];
+    for (auto& handle : handles) {
+        handle = curlHandlePool_acquire(pool, URL1);
+        ASSERT_NE(nullptr, handle);
+    }
+    for (auto& handle : handles) {
+        curlHandlePool_release(pool, URL1, handle, true, 10);
+    }
+
+    curl_handle_pool_statistics_t stats;
+    ASSERT_EQ(CELIX_SUCCESS, curlHandlePool_getStatistics(pool, URL1, &stats));
+    EXPECT_EQ(2, stats.nrOfIdleHandles);
+}
+
+TEST_F(CurlHandlePoolTestSuite, PoolingDisabledTest) {
+    ASSERT_EQ(CELIX_SUCCESS, curlHandlePool_create(0, &pool));
+
+    CURL *handle = curlHandlePool_acquire(pool, URL1);
+    ASSERT_NE(nullptr, handle);
+    curlHandlePool_release(pool, URL1, handle, true, 10);
+
+    curl_handle_pool_statistics_t stats;
+    ASSERT_EQ(CELIX_SUCCESS, curlHandlePool_getStatistics(pool, URL1, &stats));
+    EXPECT_EQ(1, stats.nrOfCalls);
+    EXPECT_EQ(0, stats.nrOfIdleHandles);
+}
+
+TEST_F(CurlHandlePoolTestSuite, StatisticsTest) {
+    ASSERT_EQ(CELIX_SUCCESS, curlHandlePool_create(2, &pool));
+
+    curl_handle_pool_statistics_t stats;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, curlHandlePool_getStatistics(pool, URL1, &stats));
+
+    curlHandlePool_release(pool, URL1, curlHandlePool_acquire(pool, URL1), true, 10);
+    curlHandlePool_release(pool, URL1, curlHandlePool_acquire(pool, URL1), true, 30);
+    curlHandlePool_release(pool, URL1, curlHandlePool_acquire(pool, URL1), false, 20);
+
+    ASSERT_EQ(CELIX_SUCCESS, curlHandlePool_getStatistics(pool, URL1, &stats));
+    EXPECT_EQ(3, stats.nrOfCalls);
+    EXPECT_EQ(60, stats.totalLatencyUs);
+    EXPECT_EQ(30, stats.maxLatencyUs);
+    //no transfers are done, so no connections are set up
+    EXPECT_EQ(0, stats.nrOfNewConnections);
+    EXPECT_EQ(2, stats.nrOfReusedConnections);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, curlHandlePool_getStatistics(pool, URL2, &stats));
+}
+
+TEST_F(CurlHandlePoolTestSuite, RemoveEndpointTest) {
+    ASSERT_EQ(CELIX_SUCCESS, curlHandlePool_create(2, &pool));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, curlHandlePool_removeEndpoint(pool, URL1, nullptr));
+
+    curlHandlePool_release(pool, URL1, curlHandlePool_acquire(pool, URL1), true, 10);
+
+    curl_handle_pool_statistics_t stats;
+    EXPECT_EQ(CELIX_SUCCESS, curlHandlePool_removeEndpoint(pool, URL1, &stats));
+    EXPECT_EQ(1, stats.nrOfCalls);
+    EXPECT_EQ(1, stats.nrOfIdleHandles);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, curlHandlePool_getStatistics(pool, URL1, &stats));
+}
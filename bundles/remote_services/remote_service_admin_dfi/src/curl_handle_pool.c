@@ -0,0 +1,173 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include "curl_handle_pool.h"
+#include "celix_string_hash_map.h"
+#include "celix_threads.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+typedef struct curl_handle_pool_entry {
+    CURL **idleHandles; //stack with maxIdleHandlesPerEndpoint capacity
+    curl_handle_pool_statistics_t stats;
+} curl_handle_pool_entry_t;
+
+struct curl_handle_pool {
+    size_t maxIdleHandlesPerEndpoint;
+    celix_thread_mutex_t mutex; //protects entries
+    celix_string_hash_map_t *entries; //key = endpoint url, value = curl_handle_pool_entry_t*
+};
+
+static void curlHandlePool_destroyEntry(void *data) {
+    curl_handle_pool_entry_t *entry = data;
+    for (unsigned long i = 0; i < entry->stats.nrOfIdleHandles; ++i) {
+        curl_easy_cleanup(entry->idleHandles[i]);
+    }
+    free(entry->idleHandles);
+    free(entry);
+}
+
+static curl_handle_pool_entry_t* curlHandlePool_getOrCreateEntry(curl_handle_pool_t *pool, const char *endpointUrl) {
+    curl_handle_pool_entry_t *entry = celix_stringHashMap_get(pool->entries, endpointUrl);
+    if (entry == NULL) {
+        entry = calloc(1, sizeof(*entry));
+        if (entry == NULL) {
+            return NULL;
+        }
+        if (pool->maxIdleHandlesPerEndpoint > 0) {
+            entry->idleHandles = calloc(pool->maxIdleHandlesPerEndpoint, sizeof(CURL *));
+            if (entry->idleHandles == NULL) {
+                free(entry);
+                return NULL;
+            }
+        }
+        celix_stringHashMap_put(pool->entries, endpointUrl, entry);
+    }
+    return entry;
+}
+
+celix_status_t curlHandlePool_create(size_t maxIdleHandlesPerEndpoint, curl_handle_pool_t **poolOut) {
+    assert(poolOut != NULL);
+    celix_status_t status = CELIX_SUCCESS;
+    curl_handle_pool_t *pool = calloc(1, sizeof(*pool));
+    if (pool == NULL) {
+        return CELIX_ENOMEM;
+    }
+    pool->maxIdleHandlesPerEndpoint = maxIdleHandlesPerEndpoint;
+    status = celixThreadMutex_create(&pool->mutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        goto mutex_err;
+    }
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.simpleRemovedCallback = curlHandlePool_destroyEntry;
+    pool->entries = celix_stringHashMap_createWithOptions(&opts);
+    if (pool->entries == NULL) {
+        status = CELIX_ENOMEM;
+        goto entries_err;
+    }
+    *poolOut = pool;
+    return CELIX_SUCCESS;
+entries_err:
+    celixThreadMutex_destroy(&pool->mutex);
+mutex_err:
+    free(pool);
+    return status;
+}
+
+void curlHandlePool_destroy(curl_handle_pool_t *pool) {
+    if (pool != NULL) {
+        celix_stringHashMap_destroy(pool->entries);
+        celixThreadMutex_destroy(&pool->mutex);
+        free(pool);
+    }
+}
+
+CURL* curlHandlePool_acquire(curl_handle_pool_t *pool, const char *endpointUrl) {
+    CURL *handle = NULL;
+    celixThreadMutex_lock(&pool->mutex);
+    curl_handle_pool_entry_t *entry = celix_stringHashMap_get(pool->entries, endpointUrl);
+    if (entry != NULL && entry->stats.nrOfIdleHandles > 0) {
+        entry->stats.nrOfIdleHandles -= 1;
+        handle = entry->idleHandles[entry->stats.nrOfIdleHandles];
+    }
+    celixThreadMutex_unlock(&pool->mutex);
+    return handle != NULL ? handle : curl_easy_init();
+}
+
+void curlHandlePool_release(curl_handle_pool_t *pool, const char *endpointUrl, CURL *handle, bool callSucceeded,
+                            uint64_t latencyUs) {
+    long nrOfConnects = 0;
+    (void)curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &nrOfConnects);
+    curl_easy_reset(handle); //keeps the open connections and the dns cache
+
+    celixThreadMutex_lock(&pool->mutex);
+    curl_handle_pool_entry_t *entry = curlHandlePool_getOrCreateEntry(pool, endpointUrl);
+    if (entry != NULL) {
+        entry->stats.nrOfCalls += 1;
+        if (nrOfConnects > 0) {
+            entry->stats.nrOfNewConnections += 1;
+        } else if (callSucceeded) {
+            entry->stats.nrOfReusedConnections += 1;
+        }
+        entry->stats.totalLatencyUs += latencyUs;
+        if (latencyUs > entry->stats.maxLatencyUs) {
+            entry->stats.maxLatencyUs = latencyUs;
+        }
+        if (callSucceeded && entry->stats.nrOfIdleHandles < pool->maxIdleHandlesPerEndpoint) {
+            entry->idleHandles[entry->stats.nrOfIdleHandles++] = handle;
+            handle = NULL;
+        }
+    }
+    celixThreadMutex_unlock(&pool->mutex);
+
+    if (handle != NULL) {
+        curl_easy_cleanup(handle);
+    }
+}
+
+celix_status_t curlHandlePool_getStatistics(curl_handle_pool_t *pool, const char *endpointUrl,
+                                            curl_handle_pool_statistics_t *stats) {
+    celix_status_t status = CELIX_ILLEGAL_ARGUMENT;
+    celixThreadMutex_lock(&pool->mutex);
+    curl_handle_pool_entry_t *entry = celix_stringHashMap_get(pool->entries, endpointUrl);
+    if (entry != NULL) {
+        *stats = entry->stats;
+        status = CELIX_SUCCESS;
+    }
+    celixThreadMutex_unlock(&pool->mutex);
+    return status;
+}
+
+celix_status_t curlHandlePool_removeEndpoint(curl_handle_pool_t *pool, const char *endpointUrl,
+                                             curl_handle_pool_statistics_t *stats) {
+    celix_status_t status = CELIX_ILLEGAL_ARGUMENT;
+    celixThreadMutex_lock(&pool->mutex);
+    curl_handle_pool_entry_t *entry = celix_stringHashMap_get(pool->entries, endpointUrl);
+    if (entry != NULL) {
+        if (stats != NULL) {
+            *stats = entry->stats;
+        }
+        celix_stringHashMap_remove(pool->entries, endpointUrl);
+        status = CELIX_SUCCESS;
+    }
+    celixThreadMutex_unlock(&pool->mutex);
+    return status;
+}
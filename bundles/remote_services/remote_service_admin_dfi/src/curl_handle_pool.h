@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef CELIX_CURL_HANDLE_POOL_H
+#define CELIX_CURL_HANDLE_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <curl/curl.h>
+#include "celix_errno.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Per endpoint pool of idle curl easy handles.
+ *
+ * A curl easy handle keeps its connections open after a transfer, so reusing a handle for the next call to the
+ * same endpoint reuses the (keep-alive) connection instead of setting up a new one.
+ * The pool is thread safe; the lock is only held to take a handle from or return a handle to the pool.
+ */
+typedef struct curl_handle_pool curl_handle_pool_t;
+
+typedef struct curl_handle_pool_statistics {
+    unsigned long nrOfCalls;
+    unsigned long nrOfNewConnections; //calls which had to set up a new connection
+    unsigned long nrOfReusedConnections; //calls which reused an open connection
+    unsigned long nrOfIdleHandles;
+    uint64_t totalLatencyUs;
+    uint64_t maxLatencyUs;
+} curl_handle_pool_statistics_t;
+
+/**
+ * @brief Create a curl handle pool.
+ * @param[in] maxIdleHandlesPerEndpoint The max number of idle handles kept per endpoint. 0 disables pooling.
+ */
+celix_status_t curlHandlePool_create(size_t maxIdleHandlesPerEndpoint, curl_handle_pool_t **poolOut);
+
+/**
+ * @brief Destroy the pool and clean up all idle handles.
+ */
+void curlHandlePool_destroy(curl_handle_pool_t *pool);
+
+/**
+ * @brief Take an idle handle of the endpoint from the pool, or create a new handle if there is no idle handle.
+ * @return The handle or NULL if no handle could be created.
+ */
+CURL* curlHandlePool_acquire(curl_handle_pool_t *pool, const char *endpointUrl);
+
+/**
+ * @brief Return a handle of a call to the endpoint to the pool and update the statistics of the endpoint.
+ *
+ * The handle is reset, so the next user has to set all options. If the call failed or the pool of the endpoint is full,
+ * the handle is cleaned up.
+ * @param[in] callSucceeded Whether the call with the handle succeeded.
+ * @param[in] latencyUs The latency of the call in microseconds.
+ */
+void curlHandlePool_release(curl_handle_pool_t *pool, const char *endpointUrl, CURL *handle, bool callSucceeded,
+                            uint64_t latencyUs);
+
+/**
+ * @brief Get the statistics of an endpoint.
+ * @return CELIX_ILLEGAL_ARGUMENT if the pool has no handles or statistics for the endpoint.
+ */
+celix_status_t curlHandlePool_getStatistics(curl_handle_pool_t *pool, const char *endpointUrl,
+                                            curl_handle_pool_statistics_t *stats);
+
+/**
+ * @brief Clean up the idle handles and the statistics of an endpoint.
+ * @param[out] stats If not NULL, the final statistics of the endpoint.
+ * @return CELIX_ILLEGAL_ARGUMENT if the pool has no handles or statistics for the endpoint.
+ */
+celix_status_t curlHandlePool_removeEndpoint(curl_handle_pool_t *pool, const char *endpointUrl,
+                                             curl_handle_pool_statistics_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CELIX_CURL_HANDLE_POOL_H
@@ -24,6 +24,7 @@
 #include <service_tracker_customizer.h>
 #include <service_tracker.h>
 #include <json_rpc.h>
+#include <binary_rpc.h>
 #include "celix_constants.h"
 #include "export_registration_dfi.h"
 #include "dfi_utils.h"
@@ -55,6 +56,8 @@ struct export_registration {
 
     remote_interceptors_handler_t *interceptorsHandler;
 
+    bool binarySerialization;
+
     FILE *logFile;
 };
 
@@ -90,6 +93,8 @@ celix_status_t exportRegistration_create(celix_log_helper_t *helper, service_ref
         reg->servId = strndup(servId, 1024);
         reg->trackerId = -1L;
         reg->active = true;
+        const char *serialization = celix_properties_get(endpoint->properties, CELIX_RSA_RPC_SERIALIZATION, CELIX_RSA_RPC_SERIALIZATION_JSON);
+        reg->binarySerialization = strcmp(serialization, CELIX_RSA_RPC_SERIALIZATION_BINARY) == 0;
 
         remoteInterceptorsHandler_create(context, &reg->interceptorsHandler);
 
@@ -158,17 +163,34 @@ celix_status_t exportRegistration_call(export_registration_t *export, char *data
     int status = CELIX_SUCCESS;
 
     char* response = NULL;
+    size_t responseSize = 0;
     *responseLength = -1;
-    json_error_t error;
-    json_t *js_request = json_loads(data, 0, &error);
-    const char *sig;
-    if (js_request) {
-        if (json_unpack(js_request, "{s:s}", "m", &sig) == 0) {
+    json_t *js_request = NULL;
+    const char *sig = NULL;
+    bool parsed;
+    if (export->binarySerialization) {
+        parsed = datalength >= 0 && binaryRpc_getMethodId(data, (size_t)datalength, &sig) == 0;
+    } else {
+        json_error_t error;
+        js_request = json_loads(data, 0, &error);
+        parsed = js_request != NULL;
+        if (parsed && json_unpack(js_request, "{s:s}", "m", &sig) != 0) {
+            sig = NULL;
+        }
+    }
+    if (parsed) {
+        if (sig != NULL) {
             bool cont = remoteInterceptorHandler_invokePreExportCall(export->interceptorsHandler, export->exportReference.endpoint->properties, sig, metadata);
             if (cont) {
                 celixThreadMutex_lock(&export->mutex);
                 if (export->active && export->service != NULL) {
-                    int rc = jsonRpc_call(export->intf, export->service, data, &response);
+                    int rc;
+                    if (export->binarySerialization) {
+                        rc = binaryRpc_call(export->intf, export->service, data, (size_t)datalength, (void **)&response, &responseSize);
+                    } else {
+                        rc = jsonRpc_call(export->intf, export->service, data, &response);
+                        responseSize = (response != NULL) ? strlen(response) : 0;
+                    }
                     status = (rc != 0) ? CELIX_BUNDLE_EXCEPTION : CELIX_SUCCESS;
                 } else if (!export->active) {
                     status = CELIX_ILLEGAL_STATE;
@@ -182,13 +204,18 @@ celix_status_t exportRegistration_call(export_registration_t *export, char *data
                 remoteInterceptorHandler_invokePostExportCall(export->interceptorsHandler, export->exportReference.endpoint->properties, sig, *metadata);
             }
             *responseOut = response;
+            *responseLength = (response != NULL) ? (int)responseSize : -1;
 
             //printf("calling for '%s'\n");
             if (export->logFile != NULL) {
                 static int callCount = 0;
                 char *name = NULL;
                 dynInterface_getName(export->intf, &name);
-                fprintf(export->logFile, "REMOTE CALL %i\n\tservice=%s\n\tservice_id=%s\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n", callCount, name, export->servId, data, response, status);
+                if (export->binarySerialization) {
+                    fprintf(export->logFile, "REMOTE CALL %i\n\tservice=%s\n\tservice_id=%s\n\trequest_payload=<binary, %i bytes>\n\trequest_response=<binary, %zu bytes>\n\tstatus=%i\n", callCount, name, export->servId, datalength, responseSize, status);
+                } else {
+                    fprintf(export->logFile, "REMOTE CALL %i\n\tservice=%s\n\tservice_id=%s\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n", callCount, name, export->servId, data, response, status);
+                }
                 fflush(export->logFile);
                 callCount += 1;
             }
@@ -18,7 +18,9 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <json_rpc.h>
+#include <binary_rpc.h>
 #include <assert.h>
 #include "version.h"
 #include "dyn_interface.h"
@@ -27,6 +29,7 @@
 #include "remote_service_admin_dfi.h"
 #include "remote_interceptors_handler.h"
 #include "remote_service_admin_dfi_constants.h"
+#include "remote_constants.h"
 
 struct import_registration {
     celix_bundle_context_t *context;
@@ -36,6 +39,7 @@ struct import_registration {
 
     send_func_type send;
     void *sendHandle;
+    bool binarySerialization;
 
     celix_service_factory_t factory;
     long factorySvcId;
@@ -61,7 +65,6 @@ static celix_status_t importRegistration_createProxy(import_registration_t *impo
 static void importRegistration_proxyFunc(void *userData, void *args[], void *returnVal);
 static void importRegistration_destroyProxy(struct service_proxy *proxy);
 static void importRegistration_clearProxies(import_registration_t *import);
-static const char* importRegistration_getUrl(import_registration_t *reg);
 static const char* importRegistration_getServiceName(import_registration_t *reg);
 static void* importRegistration_getService(void *handle, const celix_bundle_t *requestingBundle, const celix_properties_t *svcProperties);
 void importRegistration_ungetService(void *handle, const celix_bundle_t *requestingBundle, const celix_properties_t *svcProperties);
@@ -82,6 +85,8 @@ celix_status_t importRegistration_create(
     reg->classObject = classObject;
     reg->send = sendFn;
     reg->sendHandle = sendFnHandle;
+    const char *serialization = celix_properties_get(endpoint->properties, CELIX_RSA_RPC_SERIALIZATION, CELIX_RSA_RPC_SERIALIZATION_JSON);
+    reg->binarySerialization = strcmp(serialization, CELIX_RSA_RPC_SERIALIZATION_BINARY) == 0;
     reg->proxies = hashMap_create(NULL, NULL, NULL, NULL);
 
     remoteInterceptorsHandler_create(context, &reg->interceptorsHandler);
@@ -323,8 +328,15 @@ static void importRegistration_proxyFunc(void *userData, void *args[], void *ret
 
 
     char *invokeRequest = NULL;
+    size_t invokeRequestLength = 0;
     if (status == CELIX_SUCCESS) {
-        int rc = jsonRpc_prepareInvokeRequest(entry->dynFunc, entry->id, args, &invokeRequest);
+        int rc;
+        if (import->binarySerialization) {
+            rc = binaryRpc_prepareInvokeRequest(entry->dynFunc, entry->id, args, (void **)&invokeRequest, &invokeRequestLength);
+        } else {
+            rc = jsonRpc_prepareInvokeRequest(entry->dynFunc, entry->id, args, &invokeRequest);
+            invokeRequestLength = (rc == 0) ? strlen(invokeRequest) : 0;
+        }
         status = (rc != 0) ? CELIX_BUNDLE_EXCEPTION : CELIX_SUCCESS;
         //printf("Need to send following json '%s'\n", invokeRequest);
     }
@@ -332,18 +344,21 @@ static void importRegistration_proxyFunc(void *userData, void *args[], void *ret
 
     if (status == CELIX_SUCCESS) {
         char *reply = NULL;
+        size_t replyLength = 0;
         int rc = 0;
         //printf("sending request\n");
         celix_properties_t *metadata = NULL;
         bool cont = remoteInterceptorHandler_invokePreProxyCall(import->interceptorsHandler, import->endpoint->properties, entry->name, &metadata);
         if (cont) {
-            status = import->send(import->sendHandle, import->endpoint, invokeRequest, metadata, &reply, &rc);
+            status = import->send(import->sendHandle, import->endpoint, invokeRequest, invokeRequestLength, metadata, &reply, &replyLength, &rc);
             //printf("request sended. got reply '%s' with status %i\n", reply, rc);
 
             if (status == CELIX_SUCCESS && rc == CELIX_SUCCESS && dynFunction_hasReturn(entry->dynFunc)) {
                 //fjprintf("Handling reply '%s'\n", reply);
                 int rsErrno = CELIX_SUCCESS;
-                int retVal = jsonRpc_handleReply(entry->dynFunc, reply, args, &rsErrno);
+                int retVal = import->binarySerialization ?
+                             binaryRpc_handleReply(entry->dynFunc, reply, replyLength, args, &rsErrno) :
+                             jsonRpc_handleReply(entry->dynFunc, reply, args, &rsErrno);
                 if(retVal != 0) {
                     status = CELIX_BUNDLE_EXCEPTION;
                 } else if (rsErrno != CELIX_SUCCESS) {
@@ -368,12 +383,17 @@ static void importRegistration_proxyFunc(void *userData, void *args[], void *ret
             static int callCount = 0;
             const char *url = importRegistration_getUrl(import);
             const char *svcName = importRegistration_getServiceName(import);
-            fprintf(import->logFile, "REMOTE CALL NR %i\n\turl=%s\n\tservice=%s\n\tpayload=%s\n\treturn_code=%i\n\treply=%s\n",
-                                       callCount, url, svcName, invokeRequest, rc, reply);
+            if (import->binarySerialization) {
+                fprintf(import->logFile, "REMOTE CALL NR %i\n\turl=%s\n\tservice=%s\n\tpayload=<binary, %zu bytes>\n\treturn_code=%i\n\treply=<binary, %zu bytes>\n",
+                                           callCount, url, svcName, invokeRequestLength, rc, replyLength);
+            } else {
+                fprintf(import->logFile, "REMOTE CALL NR %i\n\turl=%s\n\tservice=%s\n\tpayload=%s\n\treturn_code=%i\n\treply=%s\n",
+                                           callCount, url, svcName, invokeRequest, rc, reply);
+            }
             fflush(import->logFile);
             callCount += 1;
         }
-        free(invokeRequest); //Allocated by json_dumps in jsonRpc_prepareInvokeRequest
+        free(invokeRequest); //Allocated by json_dumps in jsonRpc_prepareInvokeRequest or by binaryRpc_prepareInvokeRequest
         free(reply); //Allocated by json_dumps in remoteServiceAdmin_send through curl call
     }
 
@@ -417,7 +437,7 @@ celix_status_t importReference_getImportedService(import_reference_t *reference)
     return status;
 }
 
-static const char* importRegistration_getUrl(import_registration_t *reg) {
+const char* importRegistration_getUrl(import_registration_t *reg) {
     return celix_properties_get(reg->endpoint->properties, RSA_DFI_ENDPOINT_URL, "!Error!");
 }
 
@@ -25,7 +25,7 @@
 
 #include <celix_errno.h>
 
-typedef celix_status_t (*send_func_type)(void *handle, endpoint_description_t *endpointDescription, char *request, celix_properties_t *metadata, char **reply, int* replyStatus);
+typedef celix_status_t (*send_func_type)(void *handle, endpoint_description_t *endpointDescription, char *request, size_t requestLength, celix_properties_t *metadata, char **reply, size_t *replyLength, int* replyStatus);
 
 celix_status_t importRegistration_create(
         celix_bundle_context_t *context,
@@ -40,4 +40,6 @@ void importRegistration_destroy(import_registration_t *import);
 
 celix_status_t importRegistration_start(import_registration_t *import);
 
+const char* importRegistration_getUrl(import_registration_t *import);
+
 #endif //CELIX_IMPORT_REGISTRATION_DFI_H
@@ -36,9 +36,11 @@
 #include "celix_utils.h"
 
 #include "import_registration_dfi.h"
+#include "curl_handle_pool.h"
 #include "export_registration_dfi.h"
 #include "remote_service_admin_dfi.h"
 #include "json_rpc.h"
+#include "binary_rpc.h"
 
 #include "remote_constants.h"
 #include "celix_constants.h"
@@ -101,12 +103,8 @@ struct remote_service_admin {
     pthread_mutex_t curlMutexConnect;
     pthread_mutex_t curlMutexCookie;
     pthread_mutex_t curlMutexDns;
-};
 
-struct celix_post_data {
-    const char *readptr;
-    size_t size;
-    size_t read;
+    curl_handle_pool_t *curlPool;
 };
 
 struct celix_get_data_reply {
@@ -122,19 +120,21 @@ static const char *data_response_headers =
         "HTTP/1.1 200 OK\r\n"
                 "Cache: no-cache\r\n"
                 "Content-Type: application/json\r\n"
+                "Content-Length: %i\r\n"
                 "\r\n";
 
 static const char *no_content_response_headers =
-        "HTTP/1.1 204 OK\r\n";
+        "HTTP/1.1 204 No Content\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n";
 
 static const unsigned int DEFAULT_TIMEOUT = 0;
 
 static int remoteServiceAdmin_callback(struct mg_connection *conn);
 static celix_status_t remoteServiceAdmin_createEndpointDescription(remote_service_admin_t *admin, service_reference_pt reference, celix_properties_t *props, char *interface, endpoint_description_t **description);
-static celix_status_t remoteServiceAdmin_send(void *handle, endpoint_description_t *endpointDescription, char *request, celix_properties_t *metadata, char **reply, int* replyStatus);
+static celix_status_t remoteServiceAdmin_send(void *handle, endpoint_description_t *endpointDescription, char *request, size_t requestLength, celix_properties_t *metadata, char **reply, size_t *replyLength, int* replyStatus);
 static celix_status_t remoteServiceAdmin_getIpAddress(char* interface, char** ip);
 static char* remoteServiceAdmin_getIFNameForIP(const char *ip);
-static size_t remoteServiceAdmin_readCallback(void *ptr, size_t size, size_t nmemb, void *userp);
 static size_t remoteServiceAdmin_write(void *contents, size_t size, size_t nmemb, void *userp);
 static void remoteServiceAdmin_log(remote_service_admin_t *admin, int level, const char *file, int line, const char *msg, ...);
 static void remoteServiceAdmin_setupStopExportsThread(remote_service_admin_t* admin);
@@ -203,6 +203,7 @@ celix_status_t remoteServiceAdmin_create(celix_bundle_context_t *context, remote
         dynInterface_logSetup((void *)remoteServiceAdmin_log, *admin, 1);
         jsonSerializer_logSetup((void *)remoteServiceAdmin_log, *admin, 1);
         jsonRpc_logSetup((void *)remoteServiceAdmin_log, *admin, 1);
+        binaryRpc_logSetup((void *)remoteServiceAdmin_log, *admin, 1);
 
         long port = celix_bundleContext_getPropertyAsLong(context, RSA_PORT_KEY, RSA_PORT_DEFAULT);
         const char *ip = celix_bundleContext_getProperty(context, RSA_IP_KEY, RSA_IP_DEFAULT);
@@ -268,6 +269,11 @@ celix_status_t remoteServiceAdmin_create(celix_bundle_context_t *context, remote
             status = EPERM;
         }
 
+        long curlPoolSize = celix_bundleContext_getPropertyAsLong(context, RSA_DFI_CURL_POOL_SIZE, RSA_DFI_CURL_POOL_SIZE_DEFAULT);
+        if (status == CELIX_SUCCESS) {
+            status = curlHandlePool_create(curlPoolSize > 0 ? (size_t)curlPoolSize : 0, &(*admin)->curlPool);
+        }
+
         remoteServiceAdmin_setupStopExportsThread(*admin);
 
         // Prepare callbacks structure. We have only one callback, the rest are NULL.
@@ -288,7 +294,7 @@ celix_status_t remoteServiceAdmin_create(celix_bundle_context_t *context, remote
                 asprintf(&listeningPorts,"%s:%s", (*admin)->ip, newPort);
             }
 
-            const char *options[] = { "listening_ports", listeningPorts, "num_threads", "5", NULL};
+            const char *options[] = { "listening_ports", listeningPorts, "num_threads", "5", "enable_keep_alive", "yes", NULL};
 
             (*admin)->ctx = mg_start(&callbacks, (*admin), options);
 
@@ -341,6 +347,7 @@ celix_status_t remoteServiceAdmin_destroy(remote_service_admin_t **admin) {
     free((*admin)->discoveryInterface);
     free((*admin)->ip);
     free((*admin)->port);
+    curlHandlePool_destroy((*admin)->curlPool);
     curl_share_cleanup((*admin)->curlShare);
     pthread_mutex_destroy(&(*admin)->curlMutexConnect);
     pthread_mutex_destroy(&(*admin)->curlMutexCookie);
@@ -540,22 +547,23 @@ static int remoteServiceAdmin_callback(struct mg_connection *conn) {
 
             char *response = NULL;
             int responceLength = 0;
-            int rc = exportRegistration_call(export, data, -1, &metadata, &response, &responceLength);
+            int rc = exportRegistration_call(export, data, (int)datalength, &metadata, &response, &responceLength);
             if (rc != CELIX_SUCCESS) {
                 RSA_LOG_ERROR(rsa, "Error trying to invoke remove service, got error %i\n", rc);
             }
 
             if (rc == CELIX_SUCCESS && response != NULL) {
-                mg_write(conn, data_response_headers, strlen(data_response_headers));
+                //NOTE the content length lets the client keep the connection open for the next call
+                mg_printf(conn, data_response_headers, responceLength);
 
                 char *bufLoc = response;
-                size_t bytesLeft = strlen(response);
+                size_t bytesLeft = (size_t)responceLength;
                 if (bytesLeft > INT_MAX) {
                     //NOTE arcording to civetweb mg_write, there is a limit on mg_write for INT_MAX.
                     RSA_LOG_WARNING(rsa, "nr of bytes to send for a remote call is > INT_MAX, this can lead to issues\n");
                 }
                 while (bytesLeft > 0) {
-                    int send = mg_write(conn, bufLoc, strlen(bufLoc));
+                    int send = mg_write(conn, bufLoc, bytesLeft);
                     if (send > 0) {
                         bytesLeft -= send;
                         bufLoc += send;
@@ -752,10 +760,8 @@ static celix_status_t remoteServiceAdmin_createEndpointDescription(remote_servic
         }
     }
 
-    hash_map_entry_pt entry = hashMap_getEntry(endpointProperties, (void *) OSGI_FRAMEWORK_SERVICE_ID);
-
-    char* key = hashMapEntry_getKey(entry);
-    char *serviceId = (char *) hashMap_remove(endpointProperties, (void *) OSGI_FRAMEWORK_SERVICE_ID);
+    char *serviceId = celix_utils_strdup(celix_properties_get(endpointProperties, OSGI_FRAMEWORK_SERVICE_ID, NULL));
+    celix_properties_unset(endpointProperties, OSGI_FRAMEWORK_SERVICE_ID);
     const char *uuid = NULL;
 
     char buf[512];
@@ -782,12 +788,10 @@ static celix_status_t remoteServiceAdmin_createEndpointDescription(remote_servic
     }
 
     if (props != NULL) {
-        hash_map_iterator_pt propIter = hashMapIterator_create(props);
-        while (hashMapIterator_hasNext(propIter)) {
-            hash_map_entry_pt entry = hashMapIterator_nextEntry(propIter);
-            celix_properties_set(endpointProperties, (char*)hashMapEntry_getKey(entry), (char*)hashMapEntry_getValue(entry));
+        const char* propKey;
+        CELIX_PROPERTIES_FOR_EACH(props, propKey) {
+            celix_properties_set(endpointProperties, propKey, celix_properties_get(props, propKey, NULL));
         }
-        hashMapIterator_destroy(propIter);
     }
 
     *endpoint = calloc(1, sizeof(**endpoint));
@@ -801,7 +805,6 @@ static celix_status_t remoteServiceAdmin_createEndpointDescription(remote_servic
         (*endpoint)->properties = endpointProperties;
     }
 
-    free(key);
     free(serviceId);
     free(keys);
 
@@ -958,6 +961,15 @@ celix_status_t remoteServiceAdmin_removeImportedService(remote_service_admin_t *
         current = arrayList_get(admin->importedServices, i);
         if (current == registration) {
             arrayList_remove(admin->importedServices, i);
+            curl_handle_pool_statistics_t stats;
+            if (curlHandlePool_removeEndpoint(admin->curlPool, importRegistration_getUrl(current), &stats) == CELIX_SUCCESS) {
+                celix_logHelper_log(admin->loghelper, CELIX_LOG_LEVEL_INFO,
+                                    "RSA_DFI: Endpoint %s: %lu calls, %lu new and %lu reused connections, avg latency %lu us, max latency %lu us",
+                                    importRegistration_getUrl(current), stats.nrOfCalls, stats.nrOfNewConnections,
+                                    stats.nrOfReusedConnections,
+                                    stats.nrOfCalls > 0 ? (unsigned long)(stats.totalLatencyUs / stats.nrOfCalls) : 0UL,
+                                    (unsigned long)stats.maxLatencyUs);
+            }
             importRegistration_destroy(current);
             break;
         }
@@ -967,21 +979,13 @@ celix_status_t remoteServiceAdmin_removeImportedService(remote_service_admin_t *
     return status;
 }
 
-static celix_status_t remoteServiceAdmin_send(void *handle, endpoint_description_t *endpointDescription, char *request, celix_properties_t *metadata, char **reply, int* replyStatus) {
+static celix_status_t remoteServiceAdmin_send(void *handle, endpoint_description_t *endpointDescription, char *request, size_t requestLength, celix_properties_t *metadata, char **reply, size_t *replyLength, int* replyStatus) {
     remote_service_admin_t * rsa = handle;
-    struct celix_post_data post;
-    post.readptr = request;
-    post.size = strlen(request);
-    post.read = 0;
 
-    struct celix_get_data_reply get;
-    get.buf = NULL;
-    get.size = 0;
-    get.stream = open_memstream(&get.buf, &get.size);
-
-    const char *serviceUrl = celix_properties_get(endpointDescription->properties, (char*) RSA_DFI_ENDPOINT_URL, NULL);
-    char url[256];
-    snprintf(url, 256, "%s", serviceUrl);
+    const char *url = celix_properties_get(endpointDescription->properties, (char*) RSA_DFI_ENDPOINT_URL, NULL);
+    if (url == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
 
     // assume the default timeout
     int timeout = DEFAULT_TIMEOUT;
@@ -1003,10 +1007,15 @@ static celix_status_t remoteServiceAdmin_send(void *handle, endpoint_description
     CURL *curl;
     CURLcode res;
 
-    curl = curl_easy_init();
+    curl = curlHandlePool_acquire(rsa->curlPool, url);
     if(!curl) {
         status = CELIX_ILLEGAL_STATE;
     } else {
+        struct celix_get_data_reply get;
+        get.buf = NULL;
+        get.size = 0;
+        get.stream = open_memstream(&get.buf, &get.size);
+
         struct curl_slist *metadataHeader = NULL;
         if (metadata != NULL && celix_properties_size(metadata) > 0) {
             const char *key = NULL;
@@ -1026,42 +1035,33 @@ static celix_status_t remoteServiceAdmin_send(void *handle, endpoint_description
         curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1);
         curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout);
         curl_easy_setopt(curl, CURLOPT_URL, url);
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-        curl_easy_setopt(curl, CURLOPT_READFUNCTION, remoteServiceAdmin_readCallback);
-        curl_easy_setopt(curl, CURLOPT_READDATA, &post);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        //NOTE post fields (instead of a read callback) lets curl resend the request if a reused connection was closed
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, (curl_off_t)requestLength);
         curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, remoteServiceAdmin_write);
         curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&get);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, (curl_off_t)post.size);
         if (rsa->curlShareEnabled) {
             curl_easy_setopt(curl, CURLOPT_SHARE, rsa->curlShare);
         }
+        struct timespec start = celix_gettime(CLOCK_MONOTONIC);
         res = curl_easy_perform(curl);
+        uint64_t latencyUs = (uint64_t)(celix_elapsedtime(CLOCK_MONOTONIC, start) * 1000000.0);
 
         fputc('\0', get.stream);
         fclose(get.stream);
         *reply = get.buf;
+        *replyLength = get.size - 1; //excluding the added '\0'
+
         *replyStatus = (res == CURLE_OK) ? CELIX_SUCCESS:CELIX_ERROR_MAKE(CELIX_FACILITY_HTTP,res);
 
-        curl_easy_cleanup(curl);
+        curlHandlePool_release(rsa->curlPool, url, curl, res == CURLE_OK, latencyUs);
         curl_slist_free_all(metadataHeader);
     }
 
     return status;
 }
 
-static size_t remoteServiceAdmin_readCallback(void *voidBuffer, size_t size, size_t nmemb, void *userp) {
-    struct celix_post_data *post = userp;
-    size_t buffSize = size * nmemb;
-    size_t readSize = post->size - post->read;
-    if (readSize > buffSize) {
-        readSize = buffSize;
-    }
-    void *startRead = (void*)(post->readptr + post->read);
-    memcpy(voidBuffer, startRead, readSize);
-    post->read += readSize;
-    return readSize;
-}
-
 static size_t remoteServiceAdmin_write(void *contents, size_t size, size_t nmemb, void *userp) {
     struct celix_get_data_reply *get = userp;
     fwrite(contents, size, nmemb, get->stream);
@@ -52,6 +52,22 @@
  */
 #define RSA_DFI_USE_CURL_SHARE_HANDLE_DEFAULT   false
 
+/**
+ * @brief Remote Service Admin DFI environment property (named "RSA_DFI_CURL_POOL_SIZE") which specifies
+ * the max number of idle curl handles kept per imported endpoint.
+ *
+ * A pooled curl handle keeps its (keep-alive) connection to the endpoint open, so a next call to the endpoint
+ * does not need to set up a new connection. A value of 0 disables the pooling.
+ *
+ * The property is of the type long and the default is 4
+ */
+#define RSA_DFI_CURL_POOL_SIZE                  "RSA_DFI_CURL_POOL_SIZE"
+
+/**
+ * @brief Default value for the enviroment property RSA_DFI_CURL_POOL_SIZE
+ */
+#define RSA_DFI_CURL_POOL_SIZE_DEFAULT          4
+
 /**
  * @brief Remote Service Admin DFI environment property (named "CELIX_RSA_BIND_ON_ALL_INTERFACES") which specifies
  * whether the RSA server is reachable from all network interfaces.
@@ -0,0 +1,143 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "rsa_shm_server.h"
+#include "rsa_shm_client.h"
+#include "rsa_shm_constants.h"
+#include "celix_log_helper.h"
+#include "celix_framework.h"
+#include "celix_framework_factory.h"
+#include "celix_properties.h"
+#include "celix_constants.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+    constexpr long SERVER_ID = 100;//dummy id
+    constexpr const char* SERVER_NAME = "shm_benchmark_server";
+
+    celix_status_t echoCallback(void *handle, rsa_shm_server_t *server, celix_properties_t *metadata,
+            const struct iovec *request, const rsa_response_allocator_t *allocator, struct iovec *response) {
+        (void)handle;
+        (void)server;
+        (void)metadata;
+        response->iov_base = allocator != nullptr ? allocator->allocate(allocator->handle, request->iov_len) : nullptr;
+        if (response->iov_base == nullptr) {
+            response->iov_base = malloc(request->iov_len);
+        }
+        if (response->iov_base == nullptr) {
+            return CELIX_ENOMEM;
+        }
+        memcpy(response->iov_base, request->iov_base, request->iov_len);
+        response->iov_len = request->iov_len;
+        return CELIX_SUCCESS;
+    }
+
+    class RsaShmClientServerBenchmark {
+    public:
+        explicit RsaShmClientServerBenchmark(const char* transportMode) {
+            auto* props = celix_properties_create();
+            celix_properties_set(props, CELIX_FRAMEWORK_FRAMEWORK_STORAGE_CLEAN_NAME, "true");
+            celix_properties_set(props, OSGI_FRAMEWORK_FRAMEWORK_STORAGE, ".rsa_shm_client_server_benchmark_cache");
+            celix_properties_set(props, RSA_SHM_TRANSPORT_MODE_KEY, transportMode);
+            celix_properties_set(props, "CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "error");
+            fw = std::shared_ptr<celix_framework_t>{celix_frameworkFactory_createFramework(props),
+                                                    [](auto* f) {celix_frameworkFactory_destroyFramework(f);}};
+            auto* ctx = celix_framework_getFrameworkContext(fw.get());
+            logHelper = std::shared_ptr<celix_log_helper_t>{celix_logHelper_create(ctx, "RsaShm"),
+                                                            [](auto* l) {celix_logHelper_destroy(l);}};
+            rsa_shm_server_t* serverPtr = nullptr;
+            rsaShmServer_create(ctx, SERVER_NAME, logHelper.get(), echoCallback, nullptr, &serverPtr);
+            server = std::shared_ptr<rsa_shm_server_t>{serverPtr, [](auto* s) {rsaShmServer_destroy(s);}};
+            rsa_shm_client_manager_t* clientManagerPtr = nullptr;
+            rsaShmClientManager_create(ctx, logHelper.get(), &clientManagerPtr);
+            rsaShmClientManager_createOrAttachClient(clientManagerPtr, SERVER_NAME, SERVER_ID);
+            clientManager = std::shared_ptr<rsa_shm_client_manager_t>{clientManagerPtr, [](auto* m) {
+                rsaShmClientManager_destroyOrDetachClient(m, SERVER_NAME, SERVER_ID);
+                rsaShmClientManager_destroy(m);
+            }};
+        }
+
+        ~RsaShmClientServerBenchmark() {
+            //note client must be destroyed before the server
+            clientManager.reset();
+            server.reset();
+        }
+
+        RsaShmClientServerBenchmark(const RsaShmClientServerBenchmark&) = delete;
+        RsaShmClientServerBenchmark& operator=(const RsaShmClientServerBenchmark&) = delete;
+
+        celix_status_t call(const std::vector<char>& payload) {
+            struct iovec request = {.iov_base = (void*)payload.data(), .iov_len = payload.size()};
+            struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+            auto status = rsaShmClientManager_sendMsgTo(clientManager.get(), SERVER_NAME, SERVER_ID, nullptr,
+                                                        &request, &response);
+            free(response.iov_base);
+            return status;
+        }
+
+    private:
+        std::shared_ptr<celix_framework_t> fw{};
+        std::shared_ptr<celix_log_helper_t> logHelper{};
+        std::shared_ptr<rsa_shm_server_t> server{};
+        std::shared_ptr<rsa_shm_client_manager_t> clientManager{};
+    };
+
+    double percentile(std::vector<double>& sorted, double p) {
+        auto index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+        return sorted[index];
+    }
+
+    void roundTrip(benchmark::State& state, const char* transportMode) {
+        RsaShmClientServerBenchmark benchmark{transportMode};
+        std::vector<char> payload(static_cast<size_t>(state.range(0)), 'x');
+        //warm up, the first call attaches the ring channel if the ring transport is used
+        for (int i = 0; i < 10; ++i) {
+            benchmark.call(payload);
+        }
+
+        std::vector<double> latencies{};
+        for (auto _ : state) {
+            auto start = std::chrono::steady_clock::now();
+            auto status = benchmark.call(payload);
+            auto end = std::chrono::steady_clock::now();
+            if (status != CELIX_SUCCESS) {
+                state.SkipWithError("Failed to send message");
+                break;
+            }
+            latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+
+        if (!latencies.empty()) {
+            std::sort(latencies.begin(), latencies.end());
+            state.counters["p50_us"] = percentile(latencies, 0.50);
+            state.counters["p90_us"] = percentile(latencies, 0.90);
+            state.counters["p99_us"] = percentile(latencies, 0.99);
+            state.counters["p999_us"] = percentile(latencies, 0.999);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * 2);
+    }
+}
+
+BENCHMARK_CAPTURE(roundTrip, datagram, RSA_SHM_TRANSPORT_MODE_DATAGRAM)->UseRealTime()->Arg(64)->Arg(512)->Arg(4096)->Arg(65536);
+BENCHMARK_CAPTURE(roundTrip, ring, RSA_SHM_TRANSPORT_MODE_RING)->UseRealTime()->Arg(64)->Arg(512)->Arg(4096)->Arg(65536);
@@ -37,14 +37,22 @@
 #include "celix_errno.h"
 #include <errno.h>
 #include <unistd.h>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 
 class RsaShmClientServerUnitTestSuite : public ::testing::Test {
 public:
-    RsaShmClientServerUnitTestSuite() {
+    RsaShmClientServerUnitTestSuite() : RsaShmClientServerUnitTestSuite{RSA_SHM_TRANSPORT_MODE_DEFAULT} {}
+
+    explicit RsaShmClientServerUnitTestSuite(const char* transportMode) {
         auto* props = celix_properties_create();
         celix_properties_set(props, CELIX_FRAMEWORK_FRAMEWORK_STORAGE_CLEAN_NAME, "true");
         celix_properties_set(props, OSGI_FRAMEWORK_FRAMEWORK_STORAGE, ".rsa_shm_client_server_test_cache");
+        celix_properties_set(props, RSA_SHM_TRANSPORT_MODE_KEY, transportMode);
         auto* fwPtr = celix_frameworkFactory_createFramework(props);
         auto* ctxPtr = celix_framework_getFrameworkContext(fwPtr);
         fw = std::shared_ptr<celix_framework_t>{fwPtr, [](auto* f) {celix_frameworkFactory_destroyFramework(f);}};
@@ -85,11 +93,12 @@ public:
 };
 static celix_status_t expect_ReceiveMsgCallback_ret = CELIX_SUCCESS;
 static bool expect_ReceiveMsgCallback_blocked = false;
-static celix_status_t ReceiveMsgCallback(void *handle, rsa_shm_server_t *server, celix_properties_t *metadata, const struct iovec *request, struct iovec *response) {
+static celix_status_t ReceiveMsgCallback(void *handle, rsa_shm_server_t *server, celix_properties_t *metadata, const struct iovec *request, const rsa_response_allocator_t *allocator, struct iovec *response) {
     (void)handle;//unused
     (void)server;//unused
     (void)metadata;//unused
     (void)request;//unused
+    (void)allocator;//unused
     while (expect_ReceiveMsgCallback_blocked) {
             //block
             usleep(1000);
@@ -215,7 +224,7 @@ TEST_F(RsaShmClientServerUnitTestSuite, CreateRsaShmClientManagerWithENOMEM) {
 
 TEST_F(RsaShmClientServerUnitTestSuite, FailedToCreateShmPool) {
     rsa_shm_client_manager_t *clientManager = nullptr;
-    celix_ei_expect_malloc((void*)&shmPool_create, 0, nullptr);
+    celix_ei_expect_malloc((void*)&shmPool_createWithArenaCount, 0, nullptr);
     auto status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
@@ -468,7 +477,7 @@ TEST_F(RsaShmClientServerUnitTestSuite, FailedToOpenMemorystreamForMatadata) {
     status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
-    celix_ei_expect_open_memstream((void*)&rsaShmClientManager_sendMsgTo, 0, nullptr);
+    celix_ei_expect_open_memstream(CELIX_EI_UNKNOWN_CALLER, 0, nullptr);
     celix_properties_t *metadata = celix_properties_create();
     celix_properties_set(metadata, "CustomKey", "test");
     struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
@@ -569,11 +578,12 @@ TEST_F(RsaShmClientServerUnitTestSuite, SendMsgTimeout) {
     rsaShmServer_destroy(server);
 }
 
-static celix_status_t ReceiveMsgCallbackWithBigResponse(void *handle, rsa_shm_server_t *server, celix_properties_t *metadata, const struct iovec *request, struct iovec *response) {
+static celix_status_t ReceiveMsgCallbackWithBigResponse(void *handle, rsa_shm_server_t *server, celix_properties_t *metadata, const struct iovec *request, const rsa_response_allocator_t *allocator, struct iovec *response) {
     (void)handle;//unused
     (void)server;//unused
     (void)metadata;//unused
     (void)request;//unused
+    (void)allocator;//unused
 
     while (expect_ReceiveMsgCallback_blocked) {
         //block
@@ -735,4 +745,497 @@ TEST_F(RsaShmClientServerUnitTestSuite, ShmServerFailedToAddWorkToThpool) {
     rsaShmClientManager_destroy(clientManager);
 
     rsaShmServer_destroy(server);
-}
\ No newline at end of file
+}
+
+static size_t expect_ShmResponseSize = 8*ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT;
+static bool ShmResponseAllocated = false;
+static celix_status_t ReceiveMsgCallbackWithShmResponse(void *handle, rsa_shm_server_t *server, celix_properties_t *metadata, const struct iovec *request, const rsa_response_allocator_t *allocator, struct iovec *response) {
+    (void)handle;//unused
+    (void)server;//unused
+    (void)metadata;//unused
+    (void)request;//unused
+    EXPECT_NE(nullptr, allocator);
+    //A response that fits in the request buffer is not allocated from the reply pool
+    EXPECT_EQ(nullptr, allocator->allocate(allocator->handle, 1));
+
+    auto* data = (char*)allocator->allocate(allocator->handle, expect_ShmResponseSize);
+    ShmResponseAllocated = data != nullptr;
+    if (data == nullptr) {
+        data = (char*)malloc(expect_ShmResponseSize);
+    }
+    for (size_t i = 0; i < expect_ShmResponseSize; ++i) {
+        data[i] = (char)(i % 251);
+    }
+    if (expect_ReceiveMsgCallback_ret != CELIX_SUCCESS) {
+        if (ShmResponseAllocated) {
+            allocator->deallocate(allocator->handle, data);
+        } else {
+            free(data);
+        }
+        return expect_ReceiveMsgCallback_ret;
+    }
+    response->iov_base = data;
+    response->iov_len = expect_ShmResponseSize;
+    return CELIX_SUCCESS;
+}
+
+static void ExpectShmResponse(const struct iovec *response) {
+    ASSERT_EQ(expect_ShmResponseSize, response->iov_len);
+    for (size_t i = 0; i < expect_ShmResponseSize; ++i) {
+        ASSERT_EQ((char)(i % 251), ((char*)response->iov_base)[i]);
+    }
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgWithShmResponse) {
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallbackWithShmResponse, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    //The responses are released by the client and reused by the server, so more responses than fit in the reply pool can be sent
+    for (size_t i = 0; i < 2 * RSA_SHM_RESPONSE_POOL_SIZE_DEFAULT / expect_ShmResponseSize; ++i) {
+        struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+        struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+        status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        EXPECT_TRUE(ShmResponseAllocated);
+        ExpectShmResponse(&response);
+        free(response.iov_base);
+    }
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+    rsaShmClientManager_destroy(clientManager);
+    rsaShmServer_destroy(server);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgWithShmResponseAndServiceError) {
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallbackWithShmResponse, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    expect_ReceiveMsgCallback_ret = CELIX_SERVICE_EXCEPTION;
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, status);
+    expect_ReceiveMsgCallback_ret = CELIX_SUCCESS;
+
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_TRUE(ShmResponseAllocated);
+    ExpectShmResponse(&response);
+    free(response.iov_base);
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+    rsaShmClientManager_destroy(clientManager);
+    rsaShmServer_destroy(server);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgWithResponseBiggerThanReplyPool) {
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallbackWithShmResponse, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    //The response is copied in chunks instead
+    expect_ShmResponseSize = 2 * RSA_SHM_RESPONSE_POOL_SIZE_DEFAULT;
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_FALSE(ShmResponseAllocated);
+    ExpectShmResponse(&response);
+    free(response.iov_base);
+    expect_ShmResponseSize = 8*ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT;
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+    rsaShmClientManager_destroy(clientManager);
+    rsaShmServer_destroy(server);
+}
+
+static celix_properties_value_type_e ReceivedServiceIdType = CELIX_PROPERTIES_VALUE_TYPE_UNSET;
+static bool ReceivedMetadata = false;
+
+static celix_status_t ReceiveMsgCallbackCheckingMetadata(void *handle, rsa_shm_server_t *server, celix_properties_t *metadata, const struct iovec *request, const rsa_response_allocator_t *allocator, struct iovec *response) {
+    (void)handle;//unused
+    (void)server;//unused
+    (void)request;//unused
+    (void)allocator;//unused
+    ReceivedMetadata = metadata != nullptr;
+    ReceivedServiceIdType = CELIX_PROPERTIES_VALUE_TYPE_UNSET;
+    if (metadata != nullptr) {
+        EXPECT_STREQ("test", celix_properties_get(metadata, "CustomKey", nullptr));
+        EXPECT_EQ(42, celix_properties_getAsLong(metadata, "ServiceId", -1));
+        EXPECT_TRUE(celix_properties_getAsBool(metadata, "Flag", false));
+        ReceivedServiceIdType = celix_properties_getType(metadata, "ServiceId");
+    }
+    response->iov_base = strdup("reply");
+    response->iov_len = strlen("reply")+1;
+    return CELIX_SUCCESS;
+}
+
+static void SendMsgAndExpectMetadataType(rsa_shm_client_manager_t *clientManager, long serverId,
+        celix_properties_t *metadata, celix_properties_value_type_e expectedServiceIdType) {
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    auto status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, metadata, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_STREQ("reply", (char*)response.iov_base);
+    free(response.iov_base);
+    EXPECT_EQ(metadata != nullptr, ReceivedMetadata);
+    EXPECT_EQ(expectedServiceIdType, ReceivedServiceIdType);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgWithBinaryMetadata) {
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallbackCheckingMetadata, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    celix_properties_t *metadata = celix_properties_create();
+    celix_properties_set(metadata, "CustomKey", "test");
+    celix_properties_setLong(metadata, "ServiceId", 42);
+    celix_properties_setBool(metadata, "Flag", true);
+    //The first request uses text metadata, the types of the values are lost
+    SendMsgAndExpectMetadataType(clientManager, serverId, metadata, CELIX_PROPERTIES_VALUE_TYPE_STRING);
+    //The server announced binary metadata support, which keeps the types of the values
+    SendMsgAndExpectMetadataType(clientManager, serverId, metadata, CELIX_PROPERTIES_VALUE_TYPE_LONG);
+    //Empty metadata is not sent at all
+    SendMsgAndExpectMetadataType(clientManager, serverId, nullptr, CELIX_PROPERTIES_VALUE_TYPE_UNSET);
+    celix_properties_destroy(metadata);
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+    rsaShmClientManager_destroy(clientManager);
+    rsaShmServer_destroy(server);
+}
+
+class RsaShmRingClientServerUnitTestSuite : public RsaShmClientServerUnitTestSuite {
+public:
+    RsaShmRingClientServerUnitTestSuite() : RsaShmClientServerUnitTestSuite{RSA_SHM_TRANSPORT_MODE_RING} {}
+    RsaShmRingClientServerUnitTestSuite(const RsaShmRingClientServerUnitTestSuite&) = delete;
+    RsaShmRingClientServerUnitTestSuite& operator=(const RsaShmRingClientServerUnitTestSuite&) = delete;
+
+    void createClientAndServer(rsaShmServer_receiveMsgCB receiveCB) {
+        auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), receiveCB, nullptr, &server);
+        ASSERT_EQ(CELIX_SUCCESS, status);
+        status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+        ASSERT_EQ(CELIX_SUCCESS, status);
+        status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+        ASSERT_EQ(CELIX_SUCCESS, status);
+
+        //The first call uses the datagram transport and attaches a ring channel, which is used for the next calls
+        struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+        struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+        status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+        ASSERT_EQ(CELIX_SUCCESS, status);
+        free(response.iov_base);
+
+        //A request send with the datagram transport fails if thpool_add_work fails, a ring request does not
+        celix_ei_expect_thpool_add_work(CELIX_EI_UNKNOWN_CALLER, 0, -1);
+    }
+
+    void destroyClientAndServer() {
+        rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+        rsaShmClientManager_destroy(clientManager);
+        rsaShmServer_destroy(server);
+    }
+
+    const long serverId = 100;//dummy id
+    rsa_shm_server_t *server = nullptr;
+    rsa_shm_client_manager_t *clientManager = nullptr;
+};
+
+TEST_F(RsaShmRingClientServerUnitTestSuite, SendMsg) {
+    createClientAndServer(ReceiveMsgCallback);
+
+    celix_properties_t *metadata = celix_properties_create();
+    celix_properties_set(metadata, "CustomKey", "test");
+    for (int i = 0; i < 100; ++i) {
+        struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+        struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+        auto status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, metadata, &request, &response);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        EXPECT_STREQ("reply", (char*)response.iov_base);
+        free(response.iov_base);
+    }
+    celix_properties_destroy(metadata);
+
+    destroyClientAndServer();
+}
+
+TEST_F(RsaShmRingClientServerUnitTestSuite, SendMsgWithBinaryMetadata) {
+    createClientAndServer(ReceiveMsgCallbackCheckingMetadata);
+
+    celix_properties_t *metadata = celix_properties_create();
+    celix_properties_set(metadata, "CustomKey", "test");
+    celix_properties_setLong(metadata, "ServiceId", 42);
+    celix_properties_setBool(metadata, "Flag", true);
+    //The first call of createClientAndServer announced binary metadata support
+    SendMsgAndExpectMetadataType(clientManager, serverId, metadata, CELIX_PROPERTIES_VALUE_TYPE_LONG);
+    celix_properties_destroy(metadata);
+
+    destroyClientAndServer();
+}
+
+static celix_status_t ReceiveMsgCallbackWithHugeResponse(void *handle, rsa_shm_server_t *server, celix_properties_t *metadata, const struct iovec *request, const rsa_response_allocator_t *allocator, struct iovec *response) {
+    (void)handle;//unused
+    (void)server;//unused
+    (void)metadata;//unused
+    (void)request;//unused
+    (void)allocator;//unused
+    //Note larger than all slots of a ring
+    size_t size = 4 * RSA_SHM_RING_SLOT_COUNT * RSA_SHM_RING_SLOT_SIZE;
+    char* data = (char*)malloc(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = (char)(i % 251);
+    }
+    response->iov_base = data;
+    response->iov_len = size;
+    return CELIX_SUCCESS;
+}
+
+TEST_F(RsaShmRingClientServerUnitTestSuite, SendMsgWithHugeResponse) {
+    createClientAndServer(ReceiveMsgCallbackWithHugeResponse);
+
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    auto status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    ASSERT_EQ(4 * RSA_SHM_RING_SLOT_COUNT * RSA_SHM_RING_SLOT_SIZE, response.iov_len);
+    auto* data = (char*)response.iov_base;
+    for (size_t i = 0; i < response.iov_len; ++i) {
+        ASSERT_EQ((char)(i % 251), data[i]);
+    }
+    free(response.iov_base);
+
+    destroyClientAndServer();
+}
+
+TEST_F(RsaShmRingClientServerUnitTestSuite, SendMsgWithServerReturnError) {
+    createClientAndServer(ReceiveMsgCallback);
+
+    expect_ReceiveMsgCallback_ret = CELIX_SERVICE_EXCEPTION;
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    auto status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, status);
+    EXPECT_EQ(nullptr, response.iov_base);
+    expect_ReceiveMsgCallback_ret = CELIX_SUCCESS;//reset error injection
+
+    //the ring channel can still be used
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    free(response.iov_base);
+
+    destroyClientAndServer();
+}
+
+TEST_F(RsaShmRingClientServerUnitTestSuite, SendBigRequestUsesDatagram) {
+    createClientAndServer(ReceiveMsgCallback);
+
+    std::string bigRequest(RSA_SHM_RING_SLOT_SIZE, 'x');
+    struct iovec request = {.iov_base = (void*)bigRequest.c_str(), .iov_len = bigRequest.size()};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    auto status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, status);//note thpool_add_work error injection
+
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_STREQ("reply", (char*)response.iov_base);
+    free(response.iov_base);
+
+    destroyClientAndServer();
+}
+
+TEST_F(RsaShmRingClientServerUnitTestSuite, SendMsgTimeout) {
+    createClientAndServer(ReceiveMsgCallback);
+
+    expect_ReceiveMsgCallback_blocked = true;
+    //Note the first celix_gettime call is for the invocation diagnostics, the second for the ring deadline
+    struct timespec ts{};
+    ts.tv_sec = -100;
+    celix_ei_expect_celix_gettime((void*)&rsaShmClientManager_sendMsgTo, 1, ts, 2);
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    auto status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,ETIMEDOUT), status);
+    expect_ReceiveMsgCallback_blocked = false;//reset for next test
+
+    destroyClientAndServer();
+}
+
+namespace {
+    struct AsyncCompletions {
+        std::mutex mutex{};
+        std::condition_variable cond{};
+        std::vector<std::pair<celix_status_t, std::string>> results{};
+        std::vector<std::thread::id> threads{};
+
+        static void complete(void *data, celix_status_t status, struct iovec *response) {
+            auto* completions = static_cast<AsyncCompletions*>(data);
+            std::string reply{};
+            if (response != nullptr) {
+                reply.assign((char*)response->iov_base, response->iov_len);
+                free(response->iov_base);
+            }
+            std::lock_guard<std::mutex> lock{completions->mutex};
+            completions->results.emplace_back(status, reply);
+            completions->threads.emplace_back(std::this_thread::get_id());
+            completions->cond.notify_all();
+        }
+
+        bool waitFor(size_t count) {
+            std::unique_lock<std::mutex> lock{mutex};
+            return cond.wait_for(lock, std::chrono::seconds{30}, [&]{return results.size() >= count;});
+        }
+    };
+}
+
+static celix_status_t EchoMsgCallback(void *handle, rsa_shm_server_t *server, celix_properties_t *metadata, const struct iovec *request, const rsa_response_allocator_t *allocator, struct iovec *response) {
+    (void)handle;//unused
+    (void)server;//unused
+    (void)metadata;//unused
+    (void)allocator;//unused
+    response->iov_base = malloc(request->iov_len);
+    memcpy(response->iov_base, request->iov_base, request->iov_len);
+    response->iov_len = request->iov_len;
+    return CELIX_SUCCESS;
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgAsyncWithDatagram) {
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallback, nullptr, &server);
+    ASSERT_EQ(CELIX_SUCCESS, status);
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    ASSERT_EQ(CELIX_SUCCESS, status);
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    ASSERT_EQ(CELIX_SUCCESS, status);
+
+    //Without the ring transport, the message is sent synchronously and the completion is called before returning
+    AsyncCompletions completions{};
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    status = rsaShmClientManager_sendMsgToAsync(clientManager, "shm_test_server", serverId, nullptr, &request,
+                                                AsyncCompletions::complete, &completions);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    ASSERT_EQ(1, completions.results.size());
+    EXPECT_EQ(CELIX_SUCCESS, completions.results[0].first);
+    EXPECT_STREQ("reply", completions.results[0].second.c_str());
+    EXPECT_EQ(std::this_thread::get_id(), completions.threads[0]);
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+    rsaShmClientManager_destroy(clientManager);
+    rsaShmServer_destroy(server);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgAsyncWithInvalidParams) {
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    auto status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    ASSERT_EQ(CELIX_SUCCESS, status);
+    AsyncCompletions completions{};
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    status = rsaShmClientManager_sendMsgToAsync(nullptr, "shm_test_server", 100, nullptr, &request,
+                                                AsyncCompletions::complete, &completions);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    status = rsaShmClientManager_sendMsgToAsync(clientManager, nullptr, 100, nullptr, &request,
+                                                AsyncCompletions::complete, &completions);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    status = rsaShmClientManager_sendMsgToAsync(clientManager, "shm_test_server", 100, nullptr, nullptr,
+                                                AsyncCompletions::complete, &completions);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    status = rsaShmClientManager_sendMsgToAsync(clientManager, "shm_test_server", 100, nullptr, &request,
+                                                nullptr, &completions);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    EXPECT_TRUE(completions.results.empty());
+    rsaShmClientManager_destroy(clientManager);
+}
+
+TEST_F(RsaShmRingClientServerUnitTestSuite, SendMsgAsyncPipelined) {
+    createClientAndServer(EchoMsgCallback);
+
+    AsyncCompletions completions{};
+    //The first asynchronous call attaches the asynchronous ring channel, and is sent synchronously
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    auto status = rsaShmClientManager_sendMsgToAsync(clientManager, "shm_test_server", serverId, nullptr, &request,
+                                                     AsyncCompletions::complete, &completions);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    ASSERT_EQ(1, completions.results.size());
+    usleep(100000);//wait for the server to attach the asynchronous ring channel
+
+    celix_properties_t *metadata = celix_properties_create();
+    celix_properties_set(metadata, "CustomKey", "test");
+    const size_t callCount = 10 * RSA_SHM_RING_SLOT_COUNT;
+    std::vector<std::string> requests{};
+    for (size_t i = 0; i < callCount; ++i) {
+        requests.emplace_back("request-" + std::to_string(i));
+    }
+    for (auto& req : requests) {
+        struct iovec iov = {.iov_base = (void*)req.c_str(), .iov_len = req.size()};
+        status = rsaShmClientManager_sendMsgToAsync(clientManager, "shm_test_server", serverId, metadata, &iov,
+                                                    AsyncCompletions::complete, &completions);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+    }
+    celix_properties_destroy(metadata);
+    ASSERT_TRUE(completions.waitFor(callCount + 1));
+
+    //The responses are completed in request order by the completion thread
+    for (size_t i = 0; i < callCount; ++i) {
+        EXPECT_EQ(CELIX_SUCCESS, completions.results[i + 1].first);
+        EXPECT_EQ(requests[i], completions.results[i + 1].second);
+        EXPECT_NE(std::this_thread::get_id(), completions.threads[i + 1]);
+    }
+
+    destroyClientAndServer();
+}
+
+TEST_F(RsaShmRingClientServerUnitTestSuite, SendMsgAsyncWithServerReturnError) {
+    createClientAndServer(ReceiveMsgCallback);
+
+    AsyncCompletions completions{};
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    auto status = rsaShmClientManager_sendMsgToAsync(clientManager, "shm_test_server", serverId, nullptr, &request,
+                                                     AsyncCompletions::complete, &completions);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    usleep(100000);//wait for the server to attach the asynchronous ring channel
+
+    expect_ReceiveMsgCallback_ret = CELIX_SERVICE_EXCEPTION;
+    status = rsaShmClientManager_sendMsgToAsync(clientManager, "shm_test_server", serverId, nullptr, &request,
+                                                AsyncCompletions::complete, &completions);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    ASSERT_TRUE(completions.waitFor(2));
+    expect_ReceiveMsgCallback_ret = CELIX_SUCCESS;//reset error injection
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, completions.results[1].first);
+
+    //the asynchronous ring channel can still be used
+    status = rsaShmClientManager_sendMsgToAsync(clientManager, "shm_test_server", serverId, nullptr, &request,
+                                                AsyncCompletions::complete, &completions);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    ASSERT_TRUE(completions.waitFor(3));
+    EXPECT_EQ(CELIX_SUCCESS, completions.results[2].first);
+    EXPECT_STREQ("reply", completions.results[2].second.c_str());
+    EXPECT_NE(std::this_thread::get_id(), completions.threads[2]);
+
+    destroyClientAndServer();
+}
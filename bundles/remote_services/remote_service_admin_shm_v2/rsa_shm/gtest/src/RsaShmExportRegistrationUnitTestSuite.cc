@@ -52,6 +52,15 @@ static celix_status_t RpcFacCreateEndpoint(void *handle, const endpoint_descript
         (void) response; //unused
         return CELIX_SUCCESS;
     };
+    requestHandler.handleRequestWithAllocator = [](void *handle, celix_properties_t *metadata, const struct iovec *request,
+            const rsa_response_allocator_t *allocator, struct iovec *response) -> celix_status_t {
+        (void) handle; //unused
+        (void) request; //unused
+        (void) metadata; //unused
+        response->iov_base = allocator->allocate(allocator->handle, 1);
+        response->iov_len = 1;
+        return CELIX_SUCCESS;
+    };
     celix_service_registration_options_t opts{};
     opts.svc = &requestHandler;
     opts.serviceName = RSA_REQUEST_HANDLER_SERVICE_NAME;
@@ -393,8 +402,43 @@ TEST_F(RsaShmExportRegUnitTestSuite, ExportRegistrationCall) {
 
     struct iovec request = {.iov_base = (void*)"request", .iov_len = 7};
     struct iovec response{};
-    status = exportRegistration_call(exportRegistration, nullptr, &request, &response);
+    status = exportRegistration_call(exportRegistration, nullptr, &request, nullptr, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_EQ(nullptr, response.iov_base);
+
+    //Release export registration
+    exportRegistration_release(exportRegistration);
+}
+
+TEST_F(RsaShmExportRegUnitTestSuite, ExportRegistrationCallWithAllocator) {
+    //Create export registration
+    endpoint_description_t *endpoint = CreateEndpointDescription();
+    service_reference_pt reference = GetServiceReference();
+
+    export_registration_t *exportRegistration = nullptr;
+    auto status = exportRegistration_create(ctx.get(), logHelper.get(), reference, endpoint, &exportRegistration);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    bundleContext_ungetServiceReference(ctx.get(), reference);
+    endpointDescription_destroy(endpoint);
+
+    celix_bundleContext_waitForEvents(ctx.get());
+
+    static char buffer[1];
+    rsa_response_allocator_t allocator{};
+    allocator.handle = buffer;
+    allocator.allocate = [](void *handle, size_t size) -> void* {
+        (void) size; //unused
+        return handle;
+    };
+    allocator.deallocate = [](void *handle, void *ptr) {
+        (void) handle; //unused
+        (void) ptr; //unused
+    };
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = 7};
+    struct iovec response{};
+    status = exportRegistration_call(exportRegistration, nullptr, &request, &allocator, &response);
     EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_EQ(buffer, response.iov_base);
 
     //Release export registration
     exportRegistration_release(exportRegistration);
@@ -403,7 +447,7 @@ TEST_F(RsaShmExportRegUnitTestSuite, ExportRegistrationCall) {
 TEST_F(RsaShmExportRegUnitTestSuite, ExportRegistrationCallWithInvalidParams) {
     struct iovec request = {.iov_base = (void*)"request", .iov_len = 7};
     struct iovec response{};
-    auto status = exportRegistration_call(nullptr, nullptr, &request, &response);
+    auto status = exportRegistration_call(nullptr, nullptr, &request, nullptr, &response);
     EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
 }
 
@@ -426,7 +470,7 @@ TEST_F(RsaShmExportRegUnitTestSuite, ExportRegistrationCallWithNoRequestHandler)
 
     struct iovec request = {.iov_base = (void*)"request", .iov_len = 7};
     struct iovec response{};
-    status = exportRegistration_call(exportRegistration, nullptr, &request, &response);
+    status = exportRegistration_call(exportRegistration, nullptr, &request, nullptr, &response);
     EXPECT_EQ(CELIX_ILLEGAL_STATE, status);
 
     //Release export registration
@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "rsa_shm_metadata.h"
+#include "celix_properties.h"
+#include "celix_version.h"
+#include "celix_errno.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+class RsaShmMetadataUnitTestSuite : public ::testing::Test {
+public:
+    RsaShmMetadataUnitTestSuite() = default;
+    ~RsaShmMetadataUnitTestSuite() override = default;
+
+    static std::vector<char> Encode(const celix_properties_t *metadata) {
+        std::vector<char> buf(rsaShmMetadata_encodedSize(metadata));
+        rsaShmMetadata_encode(metadata, buf.data());
+        return buf;
+    }
+};
+
+TEST_F(RsaShmMetadataUnitTestSuite, EncodeDecodeMetadata) {
+    celix_properties_t *metadata = celix_properties_create();
+    celix_properties_set(metadata, "string", "value");
+    celix_properties_set(metadata, "empty", "");
+    celix_properties_setLong(metadata, "long", -1234567890123L);
+    celix_properties_setDouble(metadata, "double", 3.14);
+    celix_properties_setBool(metadata, "bool", true);
+    celix_version_t *version = celix_version_createVersion(1, 2, 3, "qualifier");
+    celix_properties_setVersion(metadata, "version", version);
+
+    auto buf = Encode(metadata);
+    celix_properties_t *decoded = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, rsaShmMetadata_decode(buf.data(), buf.size(), &decoded));
+    ASSERT_NE(nullptr, decoded);
+    EXPECT_EQ(6, celix_properties_size(decoded));
+    EXPECT_STREQ("value", celix_properties_get(decoded, "string", nullptr));
+    EXPECT_STREQ("", celix_properties_get(decoded, "empty", nullptr));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_LONG, celix_properties_getType(decoded, "long"));
+    EXPECT_EQ(-1234567890123L, celix_properties_getAsLong(decoded, "long", 0));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_DOUBLE, celix_properties_getType(decoded, "double"));
+    EXPECT_DOUBLE_EQ(3.14, celix_properties_getAsDouble(decoded, "double", 0.0));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_BOOL, celix_properties_getType(decoded, "bool"));
+    EXPECT_TRUE(celix_properties_getAsBool(decoded, "bool", false));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_VERSION, celix_properties_getType(decoded, "version"));
+    EXPECT_EQ(0, celix_version_compareTo(version, celix_properties_getVersion(decoded, "version", nullptr)));
+
+    celix_properties_destroy(decoded);
+    celix_version_destroy(version);
+    celix_properties_destroy(metadata);
+}
+
+TEST_F(RsaShmMetadataUnitTestSuite, EncodeEmptyMetadata) {
+    EXPECT_EQ(0, rsaShmMetadata_encodedSize(nullptr));
+    celix_properties_t *metadata = celix_properties_create();
+    EXPECT_EQ(0, rsaShmMetadata_encodedSize(metadata));
+    rsaShmMetadata_encode(metadata, nullptr);//nothing is written
+    celix_properties_destroy(metadata);
+}
+
+TEST_F(RsaShmMetadataUnitTestSuite, DecodeInvalidMetadata) {
+    celix_properties_t *metadata = celix_properties_create();
+    celix_properties_set(metadata, "key", "value");
+    celix_properties_setLong(metadata, "long", 1);
+    auto buf = Encode(metadata);
+    celix_properties_destroy(metadata);
+
+    celix_properties_t *decoded = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmMetadata_decode(nullptr, buf.size(), &decoded));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmMetadata_decode(buf.data(), 2, &decoded));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmMetadata_decode(buf.data(), buf.size(), nullptr));
+    //truncated
+    for (size_t size = sizeof(uint32_t); size < buf.size(); ++size) {
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmMetadata_decode(buf.data(), size, &decoded));
+    }
+    //trailing data
+    auto longer = buf;
+    longer.push_back(0);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmMetadata_decode(longer.data(), longer.size(), &decoded));
+
+    //unknown type
+    auto invalid = buf;
+    auto *entry = reinterpret_cast<rsa_shm_metadata_entry_t *>(invalid.data() + sizeof(uint32_t));
+    entry->type = 100;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmMetadata_decode(invalid.data(), invalid.size(), &decoded));
+
+    //key without terminating null byte
+    invalid = buf;
+    invalid[sizeof(uint32_t) + sizeof(rsa_shm_metadata_entry_t) + strlen("key")] = 'x';
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmMetadata_decode(invalid.data(), invalid.size(), &decoded));
+    EXPECT_EQ(nullptr, decoded);
+}
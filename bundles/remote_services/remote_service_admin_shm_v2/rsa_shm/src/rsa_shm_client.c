@@ -19,9 +19,12 @@
 
 #include "rsa_shm_client.h"
 #include "rsa_shm_msg.h"
+#include "rsa_shm_ring.h"
+#include "rsa_shm_metadata.h"
 #include "rsa_shm_constants.h"
 #include "celix_log_helper.h"
 #include "shm_pool.h"
+#include "shm_cache.h"
 #include "celix_api.h"
 #include "celix_long_hash_map.h"
 #include "celix_string_hash_map.h"
@@ -31,10 +34,28 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <sys/param.h>
+#include <sys/queue.h>
 #include <assert.h>
 #include <stdbool.h>
 #include <errno.h>
 
+#define RSA_SHM_RING_DETACH_TIMEOUT_IN_MS 100
+
+struct rsa_shm_client;
+
+typedef struct rsa_shm_async_call {
+    TAILQ_ENTRY(rsa_shm_async_call) entries;
+    struct rsa_shm_client *client;//The call holds a reference to the client until it is completed
+    long serviceId;
+    uint32_t requestId;
+    struct timespec deadline;
+    celix_status_t status;
+    struct iovec response;
+    rsa_shm_client_completion_fp completion;
+    void *completionData;
+}rsa_shm_async_call_t;
+
+TAILQ_HEAD(rsa_shm_async_call_list, rsa_shm_async_call);
 
 struct rsa_shm_client_manager {
     celix_bundle_context_t *ctx;
@@ -42,6 +63,7 @@ struct rsa_shm_client_manager {
     long msgTimeOutInSec;
     long maxConcurrentNum;
     shm_pool_t *shmPool;
+    shm_cache_t *replyShmCache;//The reply pools of the servers
     celix_thread_mutex_t clientsMutex;
     celix_string_hash_map_t *clients;// Key: peer server name; value: client instance
     celix_thread_mutex_t exceptionMsgListMutex;
@@ -49,6 +71,13 @@ struct rsa_shm_client_manager {
     celix_array_list_t *exceptionMsgList;
     celix_thread_t msgExceptionHandlerThread;
     bool threadActive;
+    bool ringTransport;
+    long maxRingChannels;// per client
+    celix_thread_mutex_t completionsMutex;//protects below
+    celix_thread_cond_t completionsNotEmpty;
+    struct rsa_shm_async_call_list completions;//The completed asynchronous calls of all clients
+    bool completionThreadActive;
+    celix_thread_t completionThread;
 };
 
 struct service_diagnostic_info {
@@ -58,6 +87,13 @@ struct service_diagnostic_info {
     struct timespec lastInvokedTime;
 };
 
+typedef struct rsa_shm_client_ring_channel {
+    rsa_shm_ring_channel_t *channel;
+    bool busy;//atomic, the channel is claimed by a caller
+    bool broken;//atomic, the rings are out of sync after a failed call, the channel is not used anymore
+    unsigned int spinBudget;
+}rsa_shm_client_ring_channel_t;
+
 typedef struct rsa_shm_client {
     rsa_shm_client_manager_t *manager;
     unsigned int refCnt;
@@ -66,6 +102,21 @@ typedef struct rsa_shm_client {
     char *peerServerName;
     int cfd;
     struct sockaddr_un serverAddr;
+    celix_thread_mutex_t ringChannelsMutex;//Protects adding ring channels
+    size_t ringChannelsCnt;//atomic
+    rsa_shm_client_ring_channel_t **ringChannels;//Array of manager->maxRingChannels, added channels are never removed
+    bool binaryMetadata;//atomic, the server announced RSA_SHM_SERVER_FEATURE_BINARY_METADATA
+    celix_thread_mutex_t asyncSendMutex;//Serializes the producers of the asynchronous ring channel, and protects the members below
+    size_t asyncRingChannelsCnt;
+    rsa_shm_client_ring_channel_t **asyncRingChannels;//Array of manager->maxRingChannels, the current and the broken asynchronous channels
+    bool asyncReceiverStarted;
+    celix_thread_t asyncReceiverThread;
+    celix_thread_mutex_t asyncMutex;//protects below
+    celix_thread_cond_t asyncCond;
+    bool asyncActive;
+    rsa_shm_client_ring_channel_t *asyncRingChannel;
+    uint32_t nextRequestId;
+    struct rsa_shm_async_call_list pendingCalls;//The calls in flight on asyncRingChannel, in request order
 }rsa_shm_client_t;
 
 typedef struct rsa_shm_exception_msg {
@@ -97,6 +148,15 @@ static celix_status_t rsaShmClientManager_receiveResponse(rsa_shm_client_manager
 static void rsaShmClient_destroyOrDetachSvcDiagInfo(rsa_shm_client_t *client, long serviceId);
 static void rsaShmClient_createOrAttachSvcDiagInfo(rsa_shm_client_t *client, long serviceId);
 static bool rsaShmClient_shouldBreakInvocation(rsa_shm_client_t *client, long serviceId);
+static rsa_shm_client_ring_channel_t *rsaShmClient_claimRingChannel(rsa_shm_client_t *client);
+static void rsaShmClient_unclaimRingChannel(rsa_shm_client_ring_channel_t *ringChannel);
+static rsa_shm_client_ring_channel_t *rsaShmClient_createRingChannel(rsa_shm_client_t *client);
+static celix_status_t rsaShmClient_sendMsgByRing(rsa_shm_client_t *client, rsa_shm_client_ring_channel_t *ringChannel,
+        const celix_properties_t *metadata, const char *metadataString, size_t metadataSize,
+        const struct iovec *request, struct iovec *response);
+static void rsaShmClient_destroyRingChannels(rsa_shm_client_t *client);
+static void *rsaShmClientManager_completionThread(void *data);
+static void *rsaShmClient_asyncReceiverThread(void *data);
 
 celix_status_t rsaShmClientManager_create(celix_bundle_context_t *ctx,
         celix_log_helper_t *loghelper, rsa_shm_client_manager_t **clientManagerOut) {
@@ -115,14 +175,30 @@ celix_status_t rsaShmClientManager_create(celix_bundle_context_t *ctx,
             RSA_SHM_MAX_CONCURRENT_INVOCATIONS_KEY, RSA_SHM_MAX_CONCURRENT_INVOCATIONS_DEFAULT);
     clientManager->msgTimeOutInSec = celix_bundleContext_getPropertyAsLong(ctx,
             RSA_SHM_MSG_TIMEOUT_KEY, RSA_SHM_MSG_TIMEOUT_DEFAULT_IN_S);
+    const char *transportMode = celix_bundleContext_getProperty(ctx, RSA_SHM_TRANSPORT_MODE_KEY,
+            RSA_SHM_TRANSPORT_MODE_DEFAULT);
+    clientManager->ringTransport = strcmp(transportMode, RSA_SHM_TRANSPORT_MODE_RING) == 0;
+    clientManager->maxRingChannels = celix_bundleContext_getPropertyAsLong(ctx,
+            RSA_SHM_RING_CHANNELS_KEY, RSA_SHM_RING_CHANNELS_DEFAULT);
+    if (clientManager->maxRingChannels <= 0) {
+        clientManager->ringTransport = false;
+    }
 
     long shmPoolSize = celix_bundleContext_getPropertyAsLong(ctx, RSA_SHM_MEMORY_POOL_SIZE_KEY,
             RSA_SHM_MEMORY_POOL_SIZE_DEFAULT);
-    status = shmPool_create(shmPoolSize, &clientManager->shmPool);
+    long shmPoolArenaCount = celix_bundleContext_getPropertyAsLong(ctx, RSA_SHM_MEMORY_POOL_ARENA_COUNT_KEY,
+            RSA_SHM_MEMORY_POOL_ARENA_COUNT_DEFAULT);
+    status = shmPool_createWithArenaCount(shmPoolSize, shmPoolArenaCount > 0 ? shmPoolArenaCount : 0, &clientManager->shmPool);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(loghelper,"RsaShmClient: Error Creating shared memory pool.");
         goto shm_pool_err;
     }
+    //Note not read-only, the client marks the responses in the reply pool of the server as released
+    status = shmCache_create(false, &clientManager->replyShmCache);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(loghelper,"RsaShmClient: Error Creating reply shared memory cache.");
+        goto reply_shm_cache_err;
+    }
 
     status = celixThreadMutex_create(&clientManager->clientsMutex, NULL);
     if (status != CELIX_SUCCESS) {
@@ -154,9 +230,39 @@ celix_status_t rsaShmClientManager_create(celix_bundle_context_t *ctx,
     }
     celixThread_setName(&clientManager->msgExceptionHandlerThread, "rsaShmMsgLifeManager");
 
+    status = celixThreadMutex_create(&clientManager->completionsMutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(loghelper, "RsaShmClient: Error creating completions mutex.");
+        goto completions_mutex_err;
+    }
+    status = celixThreadCondition_init(&clientManager->completionsNotEmpty, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(loghelper, "RsaShmClient: Error creating completions signal.");
+        goto completions_cond_err;
+    }
+    TAILQ_INIT(&clientManager->completions);
+    clientManager->completionThreadActive = true;
+    status = celixThread_create(&clientManager->completionThread, NULL,
+            rsaShmClientManager_completionThread, clientManager);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(loghelper, "RsaShmClient: Error creating completion thread.");
+        goto completion_thread_err;
+    }
+    celixThread_setName(&clientManager->completionThread, "rsaShmCompletion");
+
     *clientManagerOut = clientManager;
 
     return CELIX_SUCCESS;
+completion_thread_err:
+    (void)celixThreadCondition_destroy(&clientManager->completionsNotEmpty);
+completions_cond_err:
+    (void)celixThreadMutex_destroy(&clientManager->completionsMutex);
+completions_mutex_err:
+    celixThreadMutex_lock(&clientManager->exceptionMsgListMutex);
+    clientManager->threadActive = false;
+    celixThreadMutex_unlock(&clientManager->exceptionMsgListMutex);
+    (void)celixThreadCondition_signal(&clientManager->exceptionMsgListNotEmpty);
+    celixThread_join(clientManager->msgExceptionHandlerThread, NULL);
 msg_life_manage_thread_err:
     celix_arrayList_destroy(clientManager->exceptionMsgList);
     (void)celixThreadCondition_destroy(&clientManager->exceptionMsgListNotEmpty);
@@ -166,6 +272,8 @@ msg_list_lock_err:
     celix_stringHashMap_destroy(clientManager->clients);
     (void)celixThreadMutex_destroy(&clientManager->clientsMutex);
 client_list_lock_err:
+    shmCache_destroy(clientManager->replyShmCache);
+reply_shm_cache_err:
     shmPool_destroy(clientManager->shmPool);
 shm_pool_err:
     free(clientManager);
@@ -173,6 +281,15 @@ shm_pool_err:
 }
 
 void rsaShmClientManager_destroy(rsa_shm_client_manager_t *clientManager) {
+    celixThreadMutex_lock(&clientManager->completionsMutex);
+    clientManager->completionThreadActive = false;
+    celixThreadMutex_unlock(&clientManager->completionsMutex);
+    (void)celixThreadCondition_signal(&clientManager->completionsNotEmpty);
+    celixThread_join(clientManager->completionThread, NULL);
+    assert(TAILQ_EMPTY(&clientManager->completions));
+    (void)celixThreadCondition_destroy(&clientManager->completionsNotEmpty);
+    (void)celixThreadMutex_destroy(&clientManager->completionsMutex);
+
     celixThreadMutex_lock(&clientManager->exceptionMsgListMutex);
     clientManager->threadActive = false;
     celixThreadMutex_unlock(&clientManager->exceptionMsgListMutex);
@@ -192,6 +309,7 @@ void rsaShmClientManager_destroy(rsa_shm_client_manager_t *clientManager) {
     assert(celix_stringHashMap_size(clientManager->clients) == 0);
     celix_stringHashMap_destroy(clientManager->clients);
     (void)celixThreadMutex_destroy(&clientManager->clientsMutex);
+    shmCache_destroy(clientManager->replyShmCache);
     shmPool_destroy(clientManager->shmPool);
     free(clientManager);
     return;
@@ -246,6 +364,61 @@ void rsaShmClientManager_destroyOrDetachClient(rsa_shm_client_manager_t *clientM
     return;
 }
 
+static celix_status_t rsaShmClient_metadataToString(const celix_properties_t *metadata, char **metadataString,
+        size_t *metadataSize) {
+    const char *key = NULL;
+    size_t metadataStringSize = 0;
+    FILE *fp = open_memstream(metadataString, &metadataStringSize);
+    if (fp == NULL) {
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+    CELIX_PROPERTIES_FOR_EACH(metadata, key) {
+        const char * value = celix_properties_get(metadata, key,"");
+        fprintf(fp,"%s=%s\n", key, value);
+    }
+    fclose(fp);
+    // make the metadata include the terminating null byte ('\0')
+    *metadataSize = (metadataStringSize == 0) ? 0 : metadataStringSize +1;
+    return CELIX_SUCCESS;
+}
+
+static void rsaShmClient_writeMetadata(char *dest, const celix_properties_t *metadata, const char *metadataString,
+        size_t metadataSize) {
+    if (metadataSize == 0) {
+        return;
+    }
+    if (metadataString != NULL) {
+        memcpy(dest, metadataString, metadataSize);
+    } else {
+        rsaShmMetadata_encode(metadata, dest);
+    }
+}
+
+static celix_status_t rsaShmClient_prepareMetadata(rsa_shm_client_t *client, const celix_properties_t *metadata,
+        bool *binaryMetadata, char **metadataString, size_t *metadataSize) {
+    //Binary metadata is encoded directly in the message buffer, text metadata is only used for old servers
+    *binaryMetadata = __atomic_load_n(&client->binaryMetadata, __ATOMIC_ACQUIRE);
+    *metadataString = NULL;
+    *metadataSize = 0;
+    if (*binaryMetadata) {
+        *metadataSize = rsaShmMetadata_encodedSize(metadata);
+    } else if (metadata != NULL && celix_properties_size(metadata) != 0) {
+        return rsaShmClient_metadataToString(metadata, metadataString, metadataSize);
+    }
+    return CELIX_SUCCESS;
+}
+
+static void rsaShmClient_writeRingRequest(rsa_shm_ring_record_t *record, uint32_t requestId,
+        const celix_properties_t *metadata, const char *metadataString, size_t metadataSize, const struct iovec *request) {
+    rsaShmClient_writeMetadata(record->data, metadata, metadataString, metadataSize);
+    memcpy(record->data + metadataSize, request->iov_base, request->iov_len);
+    record->flags = RSA_SHM_RING_RECORD_FLAG_LAST
+            | ((metadataString == NULL && metadataSize != 0) ? RSA_SHM_RING_RECORD_FLAG_BINARY_METADATA : 0);
+    record->metadataSize = (uint32_t)metadataSize;
+    record->dataSize = (uint32_t)(metadataSize + request->iov_len);
+    record->requestId = requestId;
+}
+
 celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientManager,
         const char *peerServerName, long serviceId, celix_properties_t *metadata,
         const struct iovec *request, struct iovec *response) {
@@ -255,10 +428,8 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
             || response == NULL) {
         return CELIX_ILLEGAL_ARGUMENT;
     }
-    const char *key = NULL;
     char *metadataString = NULL;
-    size_t metadataStringSize = 0;
-    FILE *fp = NULL;
+    size_t metadataSize = 0;
     rsa_shm_msg_control_t *msgCtrl = NULL;
 
     rsa_shm_client_t *client = rsaShmClientManager_getClient(clientManager, peerServerName);
@@ -273,21 +444,31 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
         goto invocation_breaked;
     }
 
-    fp = open_memstream(&metadataString, &metadataStringSize);
-    if (fp == NULL) {
-        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error opening metadata memory. %d.", errno);
-        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    bool binaryMetadata = false;
+    status = rsaShmClient_prepareMetadata(client, metadata, &binaryMetadata, &metadataString, &metadataSize);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error opening metadata memory. %d.", status);
         goto err_opening_metadata_mem;
     }
-    if (metadata != NULL) {
-        CELIX_PROPERTIES_FOR_EACH(metadata, key) {
-            const char * value = celix_properties_get(metadata, key,"");
-            fprintf(fp,"%s=%s\n", key, value);
+
+    if (clientManager->ringTransport
+            && metadataSize + request->iov_len <= RSA_SHM_RING_SLOT_SIZE - sizeof(rsa_shm_ring_record_t)) {
+        rsa_shm_client_ring_channel_t *ringChannel = rsaShmClient_claimRingChannel(client);
+        if (ringChannel != NULL) {
+            status = rsaShmClient_sendMsgByRing(client, ringChannel, metadata, metadataString, metadataSize, request, response);
+            rsaShmClient_unclaimRingChannel(ringChannel);
+            if (status != CELIX_SUCCESS) {
+                celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error receiving response. %d.", status);
+                rsaShmClientManager_markSvcCallFailed(clientManager, peerServerName, serviceId);
+            }
+            rsaShmClientManager_markSvcCallFinished(clientManager, peerServerName, serviceId);
+            free(metadataString);
+            rsaShmClientManager_ungetClient(clientManager, client);
+            return status;
         }
+        //No usable ring channel(yet), use the datagram transport
     }
-    fclose(fp);
-    // make the metadata include the terminating null byte ('\0')
-    size_t metadataSize = (metadataStringSize == 0) ? 0 : metadataStringSize +1;
+
     size_t msgBodySize = MAX((metadataSize + request->iov_len), ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT);
 
     status = rsaShmClientManager_createMsgControl(clientManager, &msgCtrl);
@@ -301,9 +482,7 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
         celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error allocing msg buffer.");
         goto err_allocating_msg_buf;
     }
-    if (metadataSize != 0) {
-        memcpy(msgBody, metadataString, metadataSize);
-    }
+    rsaShmClient_writeMetadata(msgBody, metadata, metadataString, metadataSize);
     memcpy(msgBody + metadataSize, request->iov_base,request->iov_len);
 
     rsa_shm_msg_t msgInfo = {
@@ -315,6 +494,7 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
             .msgBodyTotalSize = msgBodySize,
             .metadataSize = metadataSize,
             .requestSize = request->iov_len,
+            .metadataFormat = binaryMetadata ? RSA_SHM_METADATA_FORMAT_BINARY : RSA_SHM_METADATA_FORMAT_TEXT,
     };
     if (msgInfo.shmId < 0 || msgInfo.ctrlDataOffset < 0 || msgInfo.msgBodyOffset < 0) {
         status = CELIX_ILLEGAL_ARGUMENT;
@@ -345,6 +525,9 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
     }
 
     if (replied) {
+        if (!binaryMetadata && (msgCtrl->serverFeatures & RSA_SHM_SERVER_FEATURE_BINARY_METADATA) != 0) {
+            __atomic_store_n(&client->binaryMetadata, true, __ATOMIC_RELEASE);
+        }
         rsaShmClientManager_markSvcCallFinished(clientManager, peerServerName, serviceId);
         shmPool_free(clientManager->shmPool, msgBody);
         rsaShmClientManager_destroyMsgControl(clientManager, msgCtrl);
@@ -383,6 +566,169 @@ err_getting_client:
     return status;
 }
 
+static void rsaShmClientManager_retainClient(rsa_shm_client_manager_t *clientManager, rsa_shm_client_t *client) {
+    celixThreadMutex_lock(&clientManager->clientsMutex);
+    client->refCnt ++;
+    celixThreadMutex_unlock(&clientManager->clientsMutex);
+}
+
+static rsa_shm_client_ring_channel_t *rsaShmClient_getAsyncRingChannel(rsa_shm_client_t *client) {
+    rsa_shm_client_manager_t *clientManager = client->manager;
+    rsa_shm_client_ring_channel_t *ringChannel = client->asyncRingChannel;
+    if (ringChannel != NULL && !__atomic_load_n(&ringChannel->broken, __ATOMIC_ACQUIRE)) {
+        uint32_t state = rsaShmRing_getState(ringChannel->channel);
+        if (state == RSA_SHM_RING_CHANNEL_ATTACHED) {
+            return ringChannel;
+        } else if (state != RSA_SHM_RING_CHANNEL_DETACHED) {
+            //Wait for the server to attach, or the server does not support (more) ring channels
+            return NULL;
+        }
+        //The server stopped serving the channel, a new channel is used after the calls in flight are failed by the receiver
+        celixThreadMutex_lock(&client->asyncMutex);
+        bool idle = TAILQ_EMPTY(&client->pendingCalls);
+        if (idle) {
+            __atomic_store_n(&ringChannel->broken, true, __ATOMIC_RELEASE);
+        }
+        celixThreadMutex_unlock(&client->asyncMutex);
+        if (!idle) {
+            return NULL;
+        }
+    }
+
+    if (client->asyncRingChannelsCnt >= clientManager->maxRingChannels) {
+        return NULL;
+    }
+    if (!client->asyncReceiverStarted) {
+        celix_status_t status = celixThread_create(&client->asyncReceiverThread, NULL,
+                rsaShmClient_asyncReceiverThread, client);
+        if (status != CELIX_SUCCESS) {
+            celix_logHelper_warning(clientManager->logHelper, "RsaShmClient: Error creating async receiver thread. %d.", status);
+            return NULL;
+        }
+        celixThread_setName(&client->asyncReceiverThread, "rsaShmAsyncRecv");
+        client->asyncReceiverStarted = true;
+    }
+    ringChannel = rsaShmClient_createRingChannel(client);
+    if (ringChannel != NULL) {
+        client->asyncRingChannels[client->asyncRingChannelsCnt++] = ringChannel;
+        celixThreadMutex_lock(&client->asyncMutex);
+        client->asyncRingChannel = ringChannel;
+        celixThreadMutex_unlock(&client->asyncMutex);
+    }
+    //Note the new channel is used by the next calls, after it is attached by the server
+    return NULL;
+}
+
+static celix_status_t rsaShmClientManager_sendMsgByAsyncRing(rsa_shm_client_manager_t *clientManager,
+        const char *peerServerName, long serviceId, celix_properties_t *metadata, const struct iovec *request,
+        rsa_shm_client_completion_fp completion, void *completionData, bool *queued) {
+    celix_status_t status = CELIX_SUCCESS;
+    char *metadataString = NULL;
+    size_t metadataSize = 0;
+    *queued = false;
+
+    rsa_shm_client_t *client = rsaShmClientManager_getClient(clientManager, peerServerName);
+    if (client == NULL) {
+        return CELIX_ILLEGAL_STATE;
+    }
+    bool binaryMetadata = false;
+    status = rsaShmClient_prepareMetadata(client, metadata, &binaryMetadata, &metadataString, &metadataSize);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error opening metadata memory. %d.", status);
+        goto err_opening_metadata_mem;
+    }
+    if (metadataSize + request->iov_len > RSA_SHM_RING_SLOT_SIZE - sizeof(rsa_shm_ring_record_t)) {
+        //The request does not fit in a slot, it is sent by the datagram transport
+        goto request_too_large;
+    }
+    if (rsaShmClient_shouldBreakInvocation(client, serviceId)) {
+        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Breaking current invocation for service id %ld.", serviceId);
+        status = CELIX_ILLEGAL_STATE;
+        goto invocation_breaked;
+    }
+    rsa_shm_async_call_t *call = (rsa_shm_async_call_t *)calloc(1, sizeof(*call));
+    if (call == NULL) {
+        status = CELIX_ENOMEM;
+        goto err_allocating_call;
+    }
+    call->client = client;
+    call->serviceId = serviceId;
+    call->completion = completion;
+    call->completionData = completionData;
+    call->deadline = celix_gettime(CLOCK_MONOTONIC);
+    call->deadline.tv_sec += clientManager->msgTimeOutInSec;
+    rsaShmClientManager_retainClient(clientManager, client);
+
+    celixThreadMutex_lock(&client->asyncSendMutex);
+    rsa_shm_client_ring_channel_t *ringChannel = rsaShmClient_getAsyncRingChannel(client);
+    if (ringChannel != NULL) {
+        rsa_shm_ring_channel_t *channel = ringChannel->channel;
+        rsa_shm_ring_record_t *record = NULL;
+        int ret = rsaShmRing_waitForSpace(channel, &channel->request, &ringChannel->spinBudget, &call->deadline, &record);
+        if (ret == 0) {
+            celixThreadMutex_lock(&client->asyncMutex);
+            //The receiver fails all calls in flight when it marks the channel as broken, so no call may be added after that
+            if (!__atomic_load_n(&ringChannel->broken, __ATOMIC_ACQUIRE)) {
+                call->requestId = client->nextRequestId++;
+                rsaShmClient_writeRingRequest(record, call->requestId, metadata, metadataString, metadataSize, request);
+                TAILQ_INSERT_TAIL(&client->pendingCalls, call, entries);
+                rsaShmRing_publish(&channel->request);
+                *queued = true;
+            }
+            celixThreadMutex_unlock(&client->asyncMutex);
+            if (*queued) {
+                celixThreadCondition_signal(&client->asyncCond);
+            }
+        } else {
+            celix_logHelper_warning(clientManager->logHelper, "RsaShmClient: Error sending async message to %s. %d",
+                    peerServerName, ret);
+        }
+    }
+    celixThreadMutex_unlock(&client->asyncSendMutex);
+
+    if (!*queued) {
+        free(call);
+        rsaShmClientManager_ungetClient(clientManager, client);//The reference of the call
+        rsaShmClientManager_markSvcCallFinished(clientManager, peerServerName, serviceId);
+    }
+    free(metadataString);
+    rsaShmClientManager_ungetClient(clientManager, client);
+    return CELIX_SUCCESS;
+
+err_allocating_call:
+    rsaShmClientManager_markSvcCallFinished(clientManager, peerServerName, serviceId);
+invocation_breaked:
+request_too_large:
+    free(metadataString);
+err_opening_metadata_mem:
+    rsaShmClientManager_ungetClient(clientManager, client);
+    return status;
+}
+
+celix_status_t rsaShmClientManager_sendMsgToAsync(rsa_shm_client_manager_t *clientManager,
+        const char *peerServerName, long serviceId, celix_properties_t *metadata,
+        const struct iovec *request, rsa_shm_client_completion_fp completion, void *completionData) {
+    celix_status_t status = CELIX_SUCCESS;
+    if (clientManager == NULL || peerServerName == NULL || strlen(peerServerName) >= MAX_RSA_SHM_SERVER_NAME_SIZE
+            || request == NULL || request->iov_base == NULL || request->iov_len == 0
+            || completion == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (clientManager->ringTransport) {
+        bool queued = false;
+        status = rsaShmClientManager_sendMsgByAsyncRing(clientManager, peerServerName, serviceId, metadata, request,
+                completion, completionData, &queued);
+        if (status != CELIX_SUCCESS || queued) {
+            return status;
+        }
+    }
+    //There is no usable asynchronous ring channel(yet), so the message is sent synchronously
+    struct iovec response = {NULL, 0};
+    status = rsaShmClientManager_sendMsgTo(clientManager, peerServerName, serviceId, metadata, request, &response);
+    completion(completionData, status, status == CELIX_SUCCESS ? &response : NULL);
+    return CELIX_SUCCESS;
+}
+
 static celix_status_t rsaShmClientManager_createClient(rsa_shm_client_manager_t *clientManager,
         const char *peerServerName, rsa_shm_client_t **clientOut) {
     celix_status_t status = CELIX_SUCCESS;
@@ -442,10 +788,63 @@ static celix_status_t rsaShmClientManager_createClient(rsa_shm_client_manager_t
     // Creating an abstract socket, serverAddr.sun_path[0] has already been set to 0 by memset()
     strncpy(&client->serverAddr.sun_path[1], peerServerName, sizeof(client->serverAddr.sun_path) - 2);
 
+    client->ringChannelsCnt = 0;
+    client->binaryMetadata = false;
+    client->ringChannels = NULL;
+    if (clientManager->ringTransport) {
+        client->ringChannels = calloc(clientManager->maxRingChannels, sizeof(*client->ringChannels));
+        if (client->ringChannels == NULL) {
+            status = CELIX_ENOMEM;
+            goto ring_channels_err;
+        }
+    }
+    status = celixThreadMutex_create(&client->ringChannelsMutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        goto ring_channels_mutex_err;
+    }
+
+    client->asyncRingChannelsCnt = 0;
+    client->asyncRingChannels = NULL;
+    client->asyncReceiverStarted = false;
+    client->asyncActive = true;
+    client->asyncRingChannel = NULL;
+    client->nextRequestId = 1;
+    TAILQ_INIT(&client->pendingCalls);
+    if (clientManager->ringTransport) {
+        client->asyncRingChannels = calloc(clientManager->maxRingChannels, sizeof(*client->asyncRingChannels));
+        if (client->asyncRingChannels == NULL) {
+            status = CELIX_ENOMEM;
+            goto async_ring_channels_err;
+        }
+    }
+    status = celixThreadMutex_create(&client->asyncSendMutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        goto async_send_mutex_err;
+    }
+    status = celixThreadMutex_create(&client->asyncMutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        goto async_mutex_err;
+    }
+    status = celixThreadCondition_init(&client->asyncCond, NULL);
+    if (status != CELIX_SUCCESS) {
+        goto async_cond_err;
+    }
+
     *clientOut = client;
 
     return CELIX_SUCCESS;
 
+async_cond_err:
+    (void)celixThreadMutex_destroy(&client->asyncMutex);
+async_mutex_err:
+    (void)celixThreadMutex_destroy(&client->asyncSendMutex);
+async_send_mutex_err:
+    free(client->asyncRingChannels);
+async_ring_channels_err:
+    (void)celixThreadMutex_destroy(&client->ringChannelsMutex);
+ring_channels_mutex_err:
+    free(client->ringChannels);
+ring_channels_err:
 bind_cfd_err:
 client_pathname_invalid:
     close(client->cfd);
@@ -461,6 +860,20 @@ diag_info_mutex_err:
 }
 
 static void rsaShmClientManager_destroyClient(rsa_shm_client_t *client) {
+    if (client->asyncReceiverStarted) {
+        celixThreadMutex_lock(&client->asyncMutex);
+        //The calls in flight hold a reference to the client, so there are no calls in flight here
+        assert(TAILQ_EMPTY(&client->pendingCalls));
+        client->asyncActive = false;
+        celixThreadMutex_unlock(&client->asyncMutex);
+        celixThreadCondition_broadcast(&client->asyncCond);
+        celixThread_join(client->asyncReceiverThread, NULL);
+    }
+    rsaShmClient_destroyRingChannels(client);
+    (void)celixThreadCondition_destroy(&client->asyncCond);
+    (void)celixThreadMutex_destroy(&client->asyncMutex);
+    (void)celixThreadMutex_destroy(&client->asyncSendMutex);
+    (void)celixThreadMutex_destroy(&client->ringChannelsMutex);
     close(client->cfd);
     free(client->peerServerName);
     /* Service diagnostics information have been destroyed by rsaShmClientManager_destroyOrDetachClient.
@@ -541,6 +954,9 @@ static celix_status_t rsaShmClientManager_createMsgControl(rsa_shm_client_manage
     msgCtrl->size = sizeof(rsa_shm_msg_control_t);
     msgCtrl->msgState = REQUESTING;
     msgCtrl->actualReplyedSize = 0;
+    msgCtrl->replyShmId = -1;
+    msgCtrl->replyOffset = -1;
+    msgCtrl->serverFeatures = 0;
     pthread_mutexattr_t mattr;
     if ((retVal = pthread_mutexattr_init(&mattr)) != 0) {
         goto mutex_attr_err;
@@ -595,6 +1011,16 @@ static void rsaShmClientManager_destroyMsgControl(rsa_shm_client_manager_t *clie
     return;
 }
 
+static void rsaShmClientManager_releaseShmReply(rsa_shm_client_manager_t *clientManager,
+        const rsa_shm_msg_control_t *msgCtrl) {
+    rsa_shm_reply_t *shmReply = shmCache_getMemoryPtr(clientManager->replyShmCache, msgCtrl->replyShmId,
+            msgCtrl->replyOffset);
+    if (shmReply != NULL) {
+        __atomic_store_n(&shmReply->released, 1, __ATOMIC_RELEASE);
+        shmCache_releaseMemoryPtr(clientManager->replyShmCache, shmReply);
+    }
+}
+
 static bool rsaShmClientManager_handleMsgState(rsa_shm_client_manager_t *clientManager,
         struct rsa_shm_exception_msg *msgEntry) {
     bool removed = false;
@@ -608,6 +1034,13 @@ static bool rsaShmClientManager_handleMsgState(rsa_shm_client_manager_t *clientM
             signal = true;
             break;
         case REPLIED:
+            if (ctrl->replyShmId != -1) {
+                //Nobody reads the response anymore, let the server free it
+                rsaShmClientManager_releaseShmReply(clientManager, ctrl);
+            }
+            removed = true;
+            rsaShmClientManager_markSvcCallFinished(clientManager, msgEntry->peerServerName, msgEntry->serviceId);
+            break;
         case ABEND:
             removed = true;
             rsaShmClientManager_markSvcCallFinished(clientManager, msgEntry->peerServerName, msgEntry->serviceId);
@@ -666,6 +1099,32 @@ static void *rsaShmClientManager_exceptionMsgHandlerThread(void *data) {
     return NULL;
 }
 
+static celix_status_t rsaShmClientManager_readShmReply(rsa_shm_client_manager_t *clientManager,
+        const rsa_shm_msg_control_t *msgCtrl, char **reply, size_t *replySize) {
+    rsa_shm_reply_t *shmReply = shmCache_getMemoryPtr(clientManager->replyShmCache, msgCtrl->replyShmId,
+            msgCtrl->replyOffset);
+    if (shmReply == NULL) {
+        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error getting response from shm %d.", msgCtrl->replyShmId);
+        return CELIX_ILLEGAL_STATE;
+    }
+    celix_status_t status = CELIX_SUCCESS;
+    if (shmReply->size >= offsetof(rsa_shm_reply_t, released) + sizeof(shmReply->released)
+            && msgCtrl->actualReplyedSize != 0 && msgCtrl->actualReplyedSize <= shmReply->dataSize) {
+        *reply = malloc(msgCtrl->actualReplyedSize);
+        assert(*reply != NULL);
+        memcpy(*reply, (char *)shmReply + shmReply->size, msgCtrl->actualReplyedSize);
+        *replySize = msgCtrl->actualReplyedSize;
+    } else {
+        status = CELIX_ILLEGAL_ARGUMENT;
+        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Response(%zu, %zu) is illegal.",
+                shmReply->size, msgCtrl->actualReplyedSize);
+    }
+    //Let the server free the response
+    __atomic_store_n(&shmReply->released, 1, __ATOMIC_RELEASE);
+    shmCache_releaseMemoryPtr(clientManager->replyShmCache, shmReply);
+    return status;
+}
+
 static celix_status_t rsaShmClientManager_receiveResponse(rsa_shm_client_manager_t *clientManager,
         rsa_shm_msg_control_t *msgCtrl, char *msgBuffer, size_t bufSize,
         struct iovec *response, bool *replied) {
@@ -685,7 +1144,10 @@ static celix_status_t rsaShmClientManager_receiveResponse(rsa_shm_client_manager
             waitRet = pthread_cond_timedwait(&msgCtrl->signal, &msgCtrl->lock, &timeout);
         }
 
-        if (waitRet == 0 && msgCtrl->msgState != ABEND) {// Message State is REPLYING or REPLIED
+        if (msgCtrl->msgState == REPLIED && msgCtrl->replyShmId != -1) {
+            //The whole response is in the reply pool of the server, it is read(and released) even if the wait timed out
+            status = rsaShmClientManager_readShmReply(clientManager, msgCtrl, &reply, &replySize);
+        } else if (waitRet == 0 && msgCtrl->msgState != ABEND) {// Message State is REPLYING or REPLIED
             if (msgCtrl->actualReplyedSize != 0 && msgCtrl->actualReplyedSize <= bufSize) {
                 reply = realloc(reply, replySize + msgCtrl->actualReplyedSize);
                 assert(reply != NULL);
@@ -792,3 +1254,294 @@ static bool rsaShmClient_shouldBreakInvocation(rsa_shm_client_t *client, long se
 
     return breaked;
 };
+
+static rsa_shm_client_ring_channel_t *rsaShmClient_createRingChannel(rsa_shm_client_t *client) {
+    rsa_shm_client_manager_t *clientManager = client->manager;
+    rsa_shm_client_ring_channel_t *ringChannel = (rsa_shm_client_ring_channel_t *)calloc(1, sizeof(*ringChannel));
+    if (ringChannel == NULL) {
+        return NULL;
+    }
+    size_t channelSize = rsaShmRing_channelSize(RSA_SHM_RING_SLOT_COUNT, RSA_SHM_RING_SLOT_SIZE);
+    ringChannel->channel = (rsa_shm_ring_channel_t *)shmPool_malloc(clientManager->shmPool, channelSize);
+    if (ringChannel->channel == NULL) {
+        celix_logHelper_warning(clientManager->logHelper, "RsaShmClient: Error allocing ring channel.");
+        free(ringChannel);
+        return NULL;
+    }
+    rsaShmRing_initChannel(ringChannel->channel, RSA_SHM_RING_SLOT_COUNT, RSA_SHM_RING_SLOT_SIZE);
+
+    rsa_shm_msg_t msgInfo = {
+            .size = sizeof(rsa_shm_msg_t),
+            .shmId = shmPool_getShmId(clientManager->shmPool),
+            .ctrlDataOffset = shmPool_getMemoryOffset(clientManager->shmPool, ringChannel->channel),
+            .ctrlDataSize = channelSize,
+            .msgType = RSA_SHM_MSG_TYPE_RING_ATTACH,
+    };
+    if (sendto(client->cfd, &msgInfo, sizeof(msgInfo), 0, (struct sockaddr *) &client->serverAddr,
+            sizeof(struct sockaddr_un)) != sizeof(msgInfo)) {
+        celix_logHelper_warning(clientManager->logHelper, "RsaShmClient: Error attaching ring channel to %s. %d",
+                client->peerServerName, errno);
+        //The server did not receive the channel, so it can be freed
+        shmPool_free(clientManager->shmPool, ringChannel->channel);
+        free(ringChannel);
+        return NULL;
+    }
+    return ringChannel;
+}
+
+static rsa_shm_client_ring_channel_t *rsaShmClient_claimRingChannel(rsa_shm_client_t *client) {
+    bool mayAddChannel = true;
+    size_t cnt = __atomic_load_n(&client->ringChannelsCnt, __ATOMIC_ACQUIRE);
+    for (size_t i = 0; i < cnt; ++i) {
+        rsa_shm_client_ring_channel_t *ringChannel = client->ringChannels[i];
+        uint32_t state = rsaShmRing_getState(ringChannel->channel);
+        if (state == RSA_SHM_RING_CHANNEL_PENDING || state == RSA_SHM_RING_CHANNEL_REJECTED) {
+            //Wait for the server to attach, or the server does not support (more) ring channels
+            mayAddChannel = false;
+            continue;
+        }
+        bool busy = false;
+        if (state == RSA_SHM_RING_CHANNEL_ATTACHED && !__atomic_load_n(&ringChannel->broken, __ATOMIC_ACQUIRE)
+                && __atomic_compare_exchange_n(&ringChannel->busy, &busy, true, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return ringChannel;
+        }
+    }
+
+    if (mayAddChannel && cnt < client->manager->maxRingChannels) {
+        celixThreadMutex_lock(&client->ringChannelsMutex);
+        //Note the new channel is used by the next calls, after it is attached by the server
+        if (__atomic_load_n(&client->ringChannelsCnt, __ATOMIC_RELAXED) == cnt) {
+            rsa_shm_client_ring_channel_t *ringChannel = rsaShmClient_createRingChannel(client);
+            if (ringChannel != NULL) {
+                client->ringChannels[cnt] = ringChannel;
+                __atomic_store_n(&client->ringChannelsCnt, cnt + 1, __ATOMIC_RELEASE);
+            }
+        }
+        celixThreadMutex_unlock(&client->ringChannelsMutex);
+    }
+    return NULL;
+}
+
+static void rsaShmClient_unclaimRingChannel(rsa_shm_client_ring_channel_t *ringChannel) {
+    __atomic_store_n(&ringChannel->busy, false, __ATOMIC_RELEASE);
+}
+
+/**
+ * Read the (possibly fragmented) response of the oldest request in flight on the ring channel.
+ * Returns 0, or the errno of the ring. The rings are out of sync if it fails.
+ */
+static int rsaShmClient_readRingResponse(rsa_shm_client_t *client, rsa_shm_client_ring_channel_t *ringChannel,
+        unsigned int *spinBudget, const struct timespec *deadline, uint32_t requestId,
+        char **replyOut, size_t *replySizeOut, uint32_t *flagsOut) {
+    rsa_shm_client_manager_t *clientManager = client->manager;
+    rsa_shm_ring_channel_t *channel = ringChannel->channel;
+    rsa_shm_ring_record_t *record = NULL;
+    char *reply = NULL;
+    size_t replySize = 0;
+    uint32_t flags = 0;
+    do {
+        int ret = rsaShmRing_waitForRecord(channel, &channel->response, spinBudget, deadline, &record);
+        if (ret != 0) {
+            celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Maybe timeout or service endpoint exception. %d.", ret);
+            free(reply);
+            return ret;
+        }
+        flags = record->flags;
+        uint32_t dataSize = record->dataSize;
+        if (dataSize > rsaShmRing_recordCapacity(channel)) {
+            celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Response size(%u) is illegal.", dataSize);
+            free(reply);
+            return EINVAL;
+        }
+        if ((flags & RSA_SHM_RING_RECORD_FLAG_REQUEST_ID) != 0 && record->requestId != requestId) {
+            celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Response id(%u) does not match request id(%u).",
+                    record->requestId, requestId);
+            free(reply);
+            return EINVAL;
+        }
+        if (dataSize != 0) {
+            char *newReply = realloc(reply, replySize + dataSize);
+            assert(newReply != NULL);
+            reply = newReply;
+            memcpy(reply + replySize, record->data, dataSize);
+            replySize += dataSize;
+        }
+        rsaShmRing_release(&channel->response);
+    } while ((flags & RSA_SHM_RING_RECORD_FLAG_LAST) == 0);
+    *replyOut = reply;
+    *replySizeOut = replySize;
+    *flagsOut = flags;
+    return 0;
+}
+
+static celix_status_t rsaShmClient_sendMsgByRing(rsa_shm_client_t *client, rsa_shm_client_ring_channel_t *ringChannel,
+        const celix_properties_t *metadata, const char *metadataString, size_t metadataSize,
+        const struct iovec *request, struct iovec *response) {
+    rsa_shm_client_manager_t *clientManager = client->manager;
+    rsa_shm_ring_channel_t *channel = ringChannel->channel;
+    celix_status_t status = CELIX_SUCCESS;
+    struct timespec deadline = celix_gettime(CLOCK_MONOTONIC);
+    deadline.tv_sec += clientManager->msgTimeOutInSec;
+
+    rsa_shm_ring_record_t *record = NULL;
+    int ret = rsaShmRing_waitForSpace(channel, &channel->request, &ringChannel->spinBudget, &deadline, &record);
+    if (ret != 0) {
+        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error sending message to %s. %d",
+                client->peerServerName, ret);
+        goto ring_err;
+    }
+    rsaShmClient_writeRingRequest(record, 0, metadata, metadataString, metadataSize, request);
+    rsaShmRing_publish(&channel->request);
+
+    char *reply = NULL;
+    size_t replySize = 0;
+    uint32_t flags = 0;
+    ret = rsaShmClient_readRingResponse(client, ringChannel, &ringChannel->spinBudget, &deadline, 0,
+            &reply, &replySize, &flags);
+    if (ret != 0) {
+        goto ring_err;
+    }
+    if ((flags & RSA_SHM_RING_RECORD_FLAG_ABEND) != 0 || replySize == 0) {
+        free(reply);
+        return CELIX_ILLEGAL_STATE;
+    }
+    response->iov_base = reply;
+    response->iov_len = replySize;
+    return status;
+
+ring_err:
+    //The server may still write the response of this call, so the channel can not be used anymore
+    __atomic_store_n(&ringChannel->broken, true, __ATOMIC_RELEASE);
+    rsaShmRing_close(channel);
+    return ret == ETIMEDOUT ? CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, ETIMEDOUT) : CELIX_ILLEGAL_STATE;
+}
+
+static void rsaShmClient_destroyRingChannelArray(rsa_shm_client_t *client,
+        rsa_shm_client_ring_channel_t **ringChannels, size_t ringChannelsCnt) {
+    rsa_shm_client_manager_t *clientManager = client->manager;
+    for (size_t i = 0; i < ringChannelsCnt; ++i) {
+        rsaShmRing_close(ringChannels[i]->channel);
+    }
+    struct timespec start = celix_gettime(CLOCK_MONOTONIC);
+    for (size_t i = 0; i < ringChannelsCnt; ++i) {
+        rsa_shm_client_ring_channel_t *ringChannel = ringChannels[i];
+        uint32_t state = rsaShmRing_getState(ringChannel->channel);
+        while (state == RSA_SHM_RING_CHANNEL_ATTACHED
+                && celix_elapsedtime(CLOCK_MONOTONIC, start) * 1000 < RSA_SHM_RING_DETACH_TIMEOUT_IN_MS) {
+            usleep(1000);
+            state = rsaShmRing_getState(ringChannel->channel);
+        }
+        if (state == RSA_SHM_RING_CHANNEL_DETACHED || state == RSA_SHM_RING_CHANNEL_REJECTED) {
+            shmPool_free(clientManager->shmPool, ringChannel->channel);
+        } else {
+            //Here, we should not free the channel by shmPool_free, because rsa_shm_server maybe using it.
+            //The shared memory of the channel will be freed automatically when nobody is using it.
+            celix_logHelper_warning(clientManager->logHelper, "RsaShmClient: Ring channel of %s is not detached.",
+                    client->peerServerName);
+        }
+        free(ringChannel);
+    }
+    free(ringChannels);
+}
+
+static void rsaShmClient_destroyRingChannels(rsa_shm_client_t *client) {
+    rsaShmClient_destroyRingChannelArray(client, client->ringChannels, client->ringChannelsCnt);
+    rsaShmClient_destroyRingChannelArray(client, client->asyncRingChannels, client->asyncRingChannelsCnt);
+}
+
+static void rsaShmClientManager_dispatchCompletions(rsa_shm_client_manager_t *clientManager,
+        struct rsa_shm_async_call_list *calls) {
+    if (TAILQ_EMPTY(calls)) {
+        return;
+    }
+    celixThreadMutex_lock(&clientManager->completionsMutex);
+    TAILQ_CONCAT(&clientManager->completions, calls, entries);
+    celixThreadMutex_unlock(&clientManager->completionsMutex);
+    celixThreadCondition_signal(&clientManager->completionsNotEmpty);
+}
+
+static void *rsaShmClient_asyncReceiverThread(void *data) {
+    rsa_shm_client_t *client = (rsa_shm_client_t *)data;
+    rsa_shm_client_manager_t *clientManager = client->manager;
+    unsigned int spinBudget = 0;
+    struct rsa_shm_async_call_list done = TAILQ_HEAD_INITIALIZER(done);
+    celixThreadMutex_lock(&client->asyncMutex);
+    while (client->asyncActive) {
+        rsa_shm_async_call_t *call = TAILQ_FIRST(&client->pendingCalls);
+        if (call == NULL) {
+            celixThreadCondition_wait(&client->asyncCond, &client->asyncMutex);
+            continue;
+        }
+        //Only the receiver removes calls, and the calls in flight are all on the current channel
+        rsa_shm_client_ring_channel_t *ringChannel = client->asyncRingChannel;
+        celixThreadMutex_unlock(&client->asyncMutex);
+
+        char *reply = NULL;
+        size_t replySize = 0;
+        uint32_t flags = 0;
+        int ret = rsaShmClient_readRingResponse(client, ringChannel, &spinBudget, &call->deadline, call->requestId,
+                &reply, &replySize, &flags);
+
+        celixThreadMutex_lock(&client->asyncMutex);
+        if (ret == 0) {
+            TAILQ_REMOVE(&client->pendingCalls, call, entries);
+            if ((flags & RSA_SHM_RING_RECORD_FLAG_ABEND) != 0 || replySize == 0) {
+                free(reply);
+                call->status = CELIX_ILLEGAL_STATE;
+            } else {
+                call->status = CELIX_SUCCESS;
+                call->response.iov_base = reply;
+                call->response.iov_len = replySize;
+            }
+            TAILQ_INSERT_TAIL(&done, call, entries);
+        } else {
+            //The server may still write the responses of the calls in flight, so the channel can not be used anymore
+            __atomic_store_n(&ringChannel->broken, true, __ATOMIC_RELEASE);
+            rsaShmRing_close(ringChannel->channel);
+            celix_status_t status = ret == ETIMEDOUT ? CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, ETIMEDOUT) : CELIX_ILLEGAL_STATE;
+            while ((call = TAILQ_FIRST(&client->pendingCalls)) != NULL) {
+                TAILQ_REMOVE(&client->pendingCalls, call, entries);
+                call->status = status;
+                TAILQ_INSERT_TAIL(&done, call, entries);
+            }
+        }
+        celixThreadMutex_unlock(&client->asyncMutex);
+        rsaShmClientManager_dispatchCompletions(clientManager, &done);
+        celixThreadMutex_lock(&client->asyncMutex);
+    }
+    celixThreadMutex_unlock(&client->asyncMutex);
+    return NULL;
+}
+
+static void *rsaShmClientManager_completionThread(void *data) {
+    rsa_shm_client_manager_t *clientManager = (rsa_shm_client_manager_t *)data;
+    celixThreadMutex_lock(&clientManager->completionsMutex);
+    bool active = clientManager->completionThreadActive;
+    celixThreadMutex_unlock(&clientManager->completionsMutex);
+    while (active) {
+        struct rsa_shm_async_call_list calls = TAILQ_HEAD_INITIALIZER(calls);
+        celixThreadMutex_lock(&clientManager->completionsMutex);
+        while (TAILQ_EMPTY(&clientManager->completions) && clientManager->completionThreadActive) {
+            celixThreadCondition_wait(&clientManager->completionsNotEmpty, &clientManager->completionsMutex);
+        }
+        TAILQ_CONCAT(&calls, &clientManager->completions, entries);
+        active = clientManager->completionThreadActive || !TAILQ_EMPTY(&calls);
+        celixThreadMutex_unlock(&clientManager->completionsMutex);
+
+        rsa_shm_async_call_t *call = NULL;
+        while ((call = TAILQ_FIRST(&calls)) != NULL) {
+            TAILQ_REMOVE(&calls, call, entries);
+            rsa_shm_client_t *client = call->client;
+            if (call->status != CELIX_SUCCESS) {
+                celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Async call to %s failed. %d.",
+                        client->peerServerName, call->status);
+                rsaShmClientManager_markSvcCallFailed(clientManager, client->peerServerName, call->serviceId);
+            }
+            rsaShmClientManager_markSvcCallFinished(clientManager, client->peerServerName, call->serviceId);
+            call->completion(call->completionData, call->status, call->status == CELIX_SUCCESS ? &call->response : NULL);
+            rsaShmClientManager_ungetClient(clientManager, client);
+            free(call);
+        }
+    }
+    return NULL;
+}
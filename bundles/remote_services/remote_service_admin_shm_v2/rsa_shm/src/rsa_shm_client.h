@@ -33,6 +33,12 @@ extern "C" {
 
 typedef struct rsa_shm_client_manager rsa_shm_client_manager_t;
 
+/**
+ * @brief Called when an asynchronous message is completed. The response is only set if status is CELIX_SUCCESS,
+ * and the callee should free it.
+ */
+typedef void (*rsa_shm_client_completion_fp)(void *data, celix_status_t status, struct iovec *response);
+
 celix_status_t rsaShmClientManager_create(celix_bundle_context_t *ctx,
         celix_log_helper_t *loghelper, rsa_shm_client_manager_t **clientManagerOut);
 
@@ -48,6 +54,17 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
         const char *peerServerName, long serviceId, celix_properties_t *metadata,
         const struct iovec *request, struct iovec *response);
 
+/**
+ * @brief Send a message without waiting for the response.
+ * @details In ring transport mode the messages are pipelined over a dedicated ring channel per peer server, and the
+ * completions are called from the completion thread of the client manager. If there is no usable ring channel (yet),
+ * the message is sent with rsaShmClientManager_sendMsgTo and the completion is called before returning.
+ * @param[in] completion Called exactly once if the function returns CELIX_SUCCESS.
+ */
+celix_status_t rsaShmClientManager_sendMsgToAsync(rsa_shm_client_manager_t *clientManager,
+        const char *peerServerName, long serviceId, celix_properties_t *metadata,
+        const struct iovec *request, rsa_shm_client_completion_fp completion, void *completionData);
+
 #ifdef __cplusplus
 }
 #endif
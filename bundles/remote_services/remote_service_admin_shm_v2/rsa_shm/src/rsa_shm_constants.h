@@ -39,7 +39,31 @@ extern "C" {
  * @brief Shared memory pool default size
  *
  */
-#define RSA_SHM_MEMORY_POOL_SIZE_DEFAULT (1024*256)
+#define RSA_SHM_MEMORY_POOL_SIZE_DEFAULT (1024*1024)
+
+/**
+ * @brief A property of RsaShm bundle that indicates the number of arenas of the shared memory pool.
+ * Concurrent calls allocate from different arenas, but a single request must fit in one arena.
+ * If it is 0, the number of arenas is derived from the number of CPUs and the pool size.
+ */
+#define RSA_SHM_MEMORY_POOL_ARENA_COUNT_KEY "rsaShmPoolArenaCount"
+/**
+ * @brief Shared memory pool default number of arenas
+ *
+ */
+#define RSA_SHM_MEMORY_POOL_ARENA_COUNT_DEFAULT 0
+
+/**
+ * @brief A property of RsaShm bundle that indicates the size of the shared memory pool of the server for responses.
+ * Responses that do not fit in the request buffer of the client are allocated from this pool and handed to the client at once,
+ * instead of being copied in chunks. If it is 0, this pool is not used.
+ */
+#define RSA_SHM_RESPONSE_POOL_SIZE_KEY "rsaShmResponsePoolSize"
+/**
+ * @brief Shared memory pool default size for responses
+ *
+ */
+#define RSA_SHM_RESPONSE_POOL_SIZE_DEFAULT (1024*256)
 
 /**
  * @brief A property of RsaShm bundle that indicates the timeout of remote service invocation.
@@ -83,6 +107,29 @@ extern "C" {
  */
 #define ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT 512
 
+/**
+ * The transport used by the shm client to send requests, "datagram" or "ring".
+ * "datagram": every request is announced to the server with a domain datagram and handled by the server thread pool.
+ * "ring": small requests are exchanged using lock-free request/response rings in shared memory,
+ * which are served by a dedicated server thread per ring channel. If the server does not support ring channels,
+ * or a request does not fit in a ring slot, the datagram transport is used.
+ */
+#define RSA_SHM_TRANSPORT_MODE_KEY "rsaShmTransportMode"
+#define RSA_SHM_TRANSPORT_MODE_DATAGRAM "datagram"
+#define RSA_SHM_TRANSPORT_MODE_RING "ring"
+#define RSA_SHM_TRANSPORT_MODE_DEFAULT RSA_SHM_TRANSPORT_MODE_DATAGRAM
+
+/**
+ * The max number of ring channels per peer server, it is the max number of concurrent requests using the ring transport.
+ */
+#define RSA_SHM_RING_CHANNELS_KEY "rsaShmRingChannels"
+#define RSA_SHM_RING_CHANNELS_DEFAULT 4
+
+#define RSA_SHM_RING_SLOT_COUNT 8
+#define RSA_SHM_RING_SLOT_SIZE 1024
+
+#define RSA_SHM_MAX_SERVER_RING_CHANNELS 64
+
 /**
  * @brief Default RPC type used by shared memory RSA
  *
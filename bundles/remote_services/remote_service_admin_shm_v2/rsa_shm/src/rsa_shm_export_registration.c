@@ -38,6 +38,7 @@ typedef struct export_request_handler_service_entry {
     struct celix_ref ref;
     celix_thread_rwlock_t lock; //projects below
     rsa_request_handler_service_t *reqHandlerSvc;
+    bool reqHandlerSvcWithAllocator;//The request handler service is version 1.1.0 or later, see handleRequestWithAllocator
 }export_request_handler_service_entry_t;
 
 struct export_registration {
@@ -55,7 +56,7 @@ struct export_registration {
 
 static void exportRegistration_addRpcFac(void *handle, void *svc);
 static void exportRegistration_removeRpcFac(void *handle, void *svc);
-static void exportRegistration_addRequestHandlerSvc(void *handle, void *svc);
+static void exportRegistration_addRequestHandlerSvc(void *handle, void *svc, const celix_properties_t *props);
 static void exportRegistration_removeRequestHandlerSvc(void *handle, void *svc);
 static void exportRegistration_destroy(export_registration_t *export);
 static export_request_handler_service_entry_t *exportRegistration_createReqHandlerSvcEntry(void);
@@ -215,6 +216,7 @@ static export_request_handler_service_entry_t *exportRegistration_createReqHandl
         goto mutex_err;
     }
     reqHandlerSvcEntry->reqHandlerSvc = NULL;
+    reqHandlerSvcEntry->reqHandlerSvcWithAllocator = false;
     return reqHandlerSvcEntry;
 mutex_err:
     free(reqHandlerSvcEntry);
@@ -266,7 +268,7 @@ static void exportRegistration_addRpcFac(void *handle, void *svc) {
     opts.callbackHandle = export->reqHandlerSvcEntry;
     // exportRegistration_removeRequestHandlerSvc maybe occur after exportRegistration_destroyCallback. Therefore,Using refrence count here.
     exportRegistration_retainReqHandlerSvcEntry(export->reqHandlerSvcEntry);
-    opts.add = exportRegistration_addRequestHandlerSvc;
+    opts.addWithProperties = exportRegistration_addRequestHandlerSvc;
     opts.remove = exportRegistration_removeRequestHandlerSvc;
     export->reqHandlerSvcTrkId = celix_bundleContext_trackServicesWithOptionsAsync(export->context, &opts);
     if (export->reqHandlerSvcTrkId < 0) {
@@ -307,13 +309,21 @@ static void exportRegistration_removeRpcFac(void *handle, void *svc) {
 }
 
 
-static void exportRegistration_addRequestHandlerSvc(void *handle, void *svc) {
+static void exportRegistration_addRequestHandlerSvc(void *handle, void *svc, const celix_properties_t *props) {
     assert(handle != NULL);
     assert(svc != NULL);
     struct export_request_handler_service_entry *reqHandlerSvcEntry =
             (struct export_request_handler_service_entry *)handle;
+    bool withAllocator = false;
+    const char *svcVersion = celix_properties_get(props, CELIX_FRAMEWORK_SERVICE_VERSION, NULL);
+    celix_version_t *version = svcVersion != NULL ? celix_version_createVersionFromString(svcVersion) : NULL;
+    if (version != NULL) {
+        withAllocator = celix_version_compareToMajorMinor(version, 1, 1) >= 0;
+        celix_version_destroy(version);
+    }
     celixThreadRwlock_writeLock(&reqHandlerSvcEntry->lock);
     reqHandlerSvcEntry->reqHandlerSvc = (rsa_request_handler_service_t *)svc;
+    reqHandlerSvcEntry->reqHandlerSvcWithAllocator = withAllocator;
     celixThreadRwlock_unlock(&reqHandlerSvcEntry->lock);
 
     return;
@@ -333,7 +343,7 @@ static void exportRegistration_removeRequestHandlerSvc(void *handle, void *svc)
 }
 
 celix_status_t exportRegistration_call(export_registration_t *export, celix_properties_t *metadata,
-        const struct iovec *request, struct iovec *response) {
+        const struct iovec *request, const rsa_response_allocator_t *allocator, struct iovec *response) {
     celix_status_t status = CELIX_SUCCESS;
     if (export == NULL) {
         return CELIX_ILLEGAL_ARGUMENT;
@@ -341,8 +351,12 @@ celix_status_t exportRegistration_call(export_registration_t *export, celix_prop
     struct export_request_handler_service_entry *reqHandlerSvcEntry = export->reqHandlerSvcEntry;
     assert(reqHandlerSvcEntry != NULL);
     celixThreadRwlock_readLock(&reqHandlerSvcEntry->lock);
-    if (reqHandlerSvcEntry->reqHandlerSvc != NULL) {
-        status =  reqHandlerSvcEntry->reqHandlerSvc->handleRequest(reqHandlerSvcEntry->reqHandlerSvc->handle, metadata, request, response);
+    rsa_request_handler_service_t *reqHandlerSvc = reqHandlerSvcEntry->reqHandlerSvc;
+    if (reqHandlerSvc != NULL && allocator != NULL && reqHandlerSvcEntry->reqHandlerSvcWithAllocator
+            && reqHandlerSvc->handleRequestWithAllocator != NULL) {
+        status = reqHandlerSvc->handleRequestWithAllocator(reqHandlerSvc->handle, metadata, request, allocator, response);
+    } else if (reqHandlerSvc != NULL) {
+        status =  reqHandlerSvc->handleRequest(reqHandlerSvc->handle, metadata, request, response);
     } else {
         status = CELIX_ILLEGAL_STATE;
         celix_logHelper_error(export->logHelper, "RSA export reg: Error Handling request. Please ensure rsa rpc servie is active.");
@@ -25,6 +25,7 @@ extern "C" {
 #endif
 #include "export_registration.h"
 #include "endpoint_description.h"
+#include "rsa_request_handler_service.h"
 #include "celix_log_helper.h"
 #include "celix_types.h"
 #include "celix_properties.h"
@@ -51,8 +52,12 @@ celix_status_t exportReference_getExportedEndpoint(export_reference_t *reference
 celix_status_t exportReference_getExportedService(export_reference_t *reference,
         service_reference_pt *ref);
 
+/**
+ * @brief Call the exported service.
+ * @param[in] allocator The allocator for the response, it can be NULL. It is only used if the request handler service supports it.
+ */
 celix_status_t exportRegistration_call(export_registration_t *exportReg, celix_properties_t *metadata,
-        const struct iovec *request, struct iovec *response);
+        const struct iovec *request, const rsa_response_allocator_t *allocator, struct iovec *response);
 
 #ifdef __cplusplus
 }
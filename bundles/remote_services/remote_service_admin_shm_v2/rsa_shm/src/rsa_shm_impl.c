@@ -54,7 +54,8 @@ struct rsa_shm {
 
 
 static celix_status_t rsaShm_receiveMsgCB(void *handle, rsa_shm_server_t *shmServer,
-        celix_properties_t *metadata, const struct iovec *request, struct iovec *response);
+        celix_properties_t *metadata, const struct iovec *request, const rsa_response_allocator_t *allocator,
+        struct iovec *response);
 
 static celix_status_t rsaShm_createEndpointDescription(rsa_shm_t *admin,
         celix_properties_t *exportedProperties, char *interface, endpoint_description_t **description);
@@ -98,6 +99,7 @@ celix_status_t rsaShm_create(celix_bundle_context_t *context, celix_log_helper_t
 
     (*admin)->reqSenderService.handle = *admin;
     (*admin)->reqSenderService.sendRequest = (void*)rsaShm_send;
+    (*admin)->reqSenderService.sendRequestAsync = (void*)rsaShm_sendAsync;
     celix_service_registration_options_t opts = CELIX_EMPTY_SERVICE_REGISTRATION_OPTIONS;
     opts.serviceName = RSA_REQUEST_SENDER_SERVICE_NAME;
     opts.serviceVersion = RSA_REQUEST_SENDER_SERVICE_VERSION;
@@ -177,7 +179,8 @@ void rsaShm_destroy(rsa_shm_t *admin) {
 }
 
 static celix_status_t rsaShm_receiveMsgCB(void *handle, rsa_shm_server_t *shmServer,
-        celix_properties_t *metadata, const struct iovec *request, struct iovec *response) {
+        celix_properties_t *metadata, const struct iovec *request, const rsa_response_allocator_t *allocator,
+        struct iovec *response) {
     celix_status_t status = CELIX_SUCCESS;
     if (handle == NULL || shmServer == NULL || metadata == NULL || request == NULL || response == NULL) {
         return CELIX_ILLEGAL_ARGUMENT;
@@ -211,7 +214,7 @@ static celix_status_t rsaShm_receiveMsgCB(void *handle, rsa_shm_server_t *shmSer
 
     celixThreadMutex_unlock(&admin->exportedServicesLock);
 
-    status = exportRegistration_call(export, metadata, request, response);
+    status = exportRegistration_call(export, metadata, request, allocator, response);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(admin->logHelper,"Export registration call service failed, error code is %d", status);
     }
@@ -248,6 +251,28 @@ celix_status_t rsaShm_send(rsa_shm_t *admin, endpoint_description_t *endpoint,
     return status;
 }
 
+celix_status_t rsaShm_sendAsync(rsa_shm_t *admin, endpoint_description_t *endpoint,
+        celix_properties_t *metadata, const struct iovec *request,
+        rsa_request_sender_completion_fp completion, void *completionData) {
+    celix_status_t status = CELIX_SUCCESS;
+    if (admin == NULL || endpoint == NULL || request == NULL || completion == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    const char *shmServerName = celix_properties_get(endpoint->properties, RSA_SHM_SERVER_NAME_KEY, NULL);
+    if (shmServerName == NULL) {
+        celix_logHelper_error(admin->logHelper,"RSA shm server name of %s is invalid.", endpoint->serviceName);
+        return CELIX_SERVICE_EXCEPTION;
+    }
+    celix_properties_t * newMetadata = celix_properties_copy(metadata);
+    celix_properties_setLong(newMetadata,OSGI_RSA_ENDPOINT_SERVICE_ID, endpoint->serviceId);
+    status = rsaShmClientManager_sendMsgToAsync(admin->shmClientManager, shmServerName,
+            (long)endpoint->serviceId, newMetadata, request, completion, completionData);
+    celix_properties_destroy(newMetadata);
+
+    return status;
+}
+
 static void rsaShm_overlayProperties(celix_properties_t *additionalProperties, celix_properties_t *serviceProperties) {
 
     /*The property keys of a service are case-insensitive,while the property keys of the specified additional properties map are case sensitive.
@@ -25,6 +25,7 @@ extern "C" {
 #endif
 #include "rsa_shm_export_registration.h"
 #include "rsa_shm_import_registration.h"
+#include "rsa_request_sender_service.h"
 #include "endpoint_description.h"
 #include "celix_types.h"
 #include "celix_properties.h"
@@ -41,6 +42,10 @@ void rsaShm_destroy(rsa_shm_t *admin);
 celix_status_t rsaShm_send(rsa_shm_t *admin, endpoint_description_t *endpoint,
         celix_properties_t *metadata, const struct iovec *request, struct iovec *response);
 
+celix_status_t rsaShm_sendAsync(rsa_shm_t *admin, endpoint_description_t *endpoint,
+        celix_properties_t *metadata, const struct iovec *request,
+        rsa_request_sender_completion_fp completion, void *completionData);
+
 celix_status_t rsaShm_exportService(rsa_shm_t *admin, char *serviceId,
         celix_properties_t *properties, celix_array_list_t **registrations);
 
@@ -0,0 +1,177 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "rsa_shm_metadata.h"
+#include "celix_version.h"
+#include <stdint.h>
+#include <string.h>
+
+static size_t rsaShmMetadata_valueSize(const celix_properties_t *metadata, const char *key,
+        celix_properties_value_type_e type) {
+    switch (type) {
+        case CELIX_PROPERTIES_VALUE_TYPE_LONG:
+            return sizeof(int64_t);
+        case CELIX_PROPERTIES_VALUE_TYPE_DOUBLE:
+            return sizeof(double);
+        case CELIX_PROPERTIES_VALUE_TYPE_BOOL:
+            return sizeof(uint8_t);
+        default:
+            return strlen(celix_properties_get(metadata, key, "")) + 1;
+    }
+}
+
+size_t rsaShmMetadata_encodedSize(const celix_properties_t *metadata) {
+    if (metadata == NULL || celix_properties_size(metadata) == 0) {
+        return 0;
+    }
+    size_t size = sizeof(uint32_t);
+    const char *key = NULL;
+    CELIX_PROPERTIES_FOR_EACH(metadata, key) {
+        celix_properties_value_type_e type = celix_properties_getType(metadata, key);
+        size += sizeof(rsa_shm_metadata_entry_t) + strlen(key) + 1 + rsaShmMetadata_valueSize(metadata, key, type);
+    }
+    return size;
+}
+
+void rsaShmMetadata_encode(const celix_properties_t *metadata, char *buf) {
+    if (metadata == NULL || celix_properties_size(metadata) == 0) {
+        return;
+    }
+    uint32_t count = (uint32_t)celix_properties_size(metadata);
+    memcpy(buf, &count, sizeof(count));
+    buf += sizeof(count);
+    const char *key = NULL;
+    CELIX_PROPERTIES_FOR_EACH(metadata, key) {
+        celix_properties_value_type_e type = celix_properties_getType(metadata, key);
+        if (type != CELIX_PROPERTIES_VALUE_TYPE_LONG && type != CELIX_PROPERTIES_VALUE_TYPE_DOUBLE
+                && type != CELIX_PROPERTIES_VALUE_TYPE_BOOL && type != CELIX_PROPERTIES_VALUE_TYPE_VERSION) {
+            type = CELIX_PROPERTIES_VALUE_TYPE_STRING;
+        }
+        rsa_shm_metadata_entry_t entry = {
+                .type = (uint8_t)type,
+                .keySize = (uint32_t)strlen(key) + 1,
+                .valueSize = (uint32_t)rsaShmMetadata_valueSize(metadata, key, type),
+        };
+        memcpy(buf, &entry, sizeof(entry));
+        buf += sizeof(entry);
+        memcpy(buf, key, entry.keySize);
+        buf += entry.keySize;
+        if (type == CELIX_PROPERTIES_VALUE_TYPE_LONG) {
+            int64_t val = celix_properties_getAsLong(metadata, key, 0);
+            memcpy(buf, &val, sizeof(val));
+        } else if (type == CELIX_PROPERTIES_VALUE_TYPE_DOUBLE) {
+            double val = celix_properties_getAsDouble(metadata, key, 0.0);
+            memcpy(buf, &val, sizeof(val));
+        } else if (type == CELIX_PROPERTIES_VALUE_TYPE_BOOL) {
+            *(uint8_t *)buf = celix_properties_getAsBool(metadata, key, false) ? 1 : 0;
+        } else {
+            memcpy(buf, celix_properties_get(metadata, key, ""), entry.valueSize);
+        }
+        buf += entry.valueSize;
+    }
+}
+
+static bool rsaShmMetadata_decodeEntry(celix_properties_t *metadata, const rsa_shm_metadata_entry_t *entry,
+        const char *key, const char *value) {
+    switch (entry->type) {
+        case CELIX_PROPERTIES_VALUE_TYPE_STRING:
+            celix_properties_set(metadata, key, value);
+            return true;
+        case CELIX_PROPERTIES_VALUE_TYPE_LONG: {
+            int64_t val;
+            memcpy(&val, value, sizeof(val));
+            celix_properties_setLong(metadata, key, (long)val);
+            return true;
+        }
+        case CELIX_PROPERTIES_VALUE_TYPE_DOUBLE: {
+            double val;
+            memcpy(&val, value, sizeof(val));
+            celix_properties_setDouble(metadata, key, val);
+            return true;
+        }
+        case CELIX_PROPERTIES_VALUE_TYPE_BOOL:
+            celix_properties_setBool(metadata, key, *(const uint8_t *)value != 0);
+            return true;
+        case CELIX_PROPERTIES_VALUE_TYPE_VERSION: {
+            celix_version_t *version = celix_version_createVersionFromString(value);
+            if (version == NULL) {
+                celix_properties_set(metadata, key, value);
+            } else {
+                celix_properties_setVersion(metadata, key, version);
+                celix_version_destroy(version);
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+static bool rsaShmMetadata_valueSizeIsValid(const rsa_shm_metadata_entry_t *entry, const char *value) {
+    switch (entry->type) {
+        case CELIX_PROPERTIES_VALUE_TYPE_LONG:
+            return entry->valueSize == sizeof(int64_t);
+        case CELIX_PROPERTIES_VALUE_TYPE_DOUBLE:
+            return entry->valueSize == sizeof(double);
+        case CELIX_PROPERTIES_VALUE_TYPE_BOOL:
+            return entry->valueSize == sizeof(uint8_t);
+        default:
+            return entry->valueSize > 0 && value[entry->valueSize - 1] == '\0';
+    }
+}
+
+celix_status_t rsaShmMetadata_decode(const char *buf, size_t size, celix_properties_t **metadata) {
+    if (buf == NULL || size < sizeof(uint32_t) || metadata == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    uint32_t count;
+    memcpy(&count, buf, sizeof(count));
+    const char *pos = buf + sizeof(count);
+    const char *end = buf + size;
+    celix_properties_t *props = celix_properties_create();
+    if (props == NULL) {
+        return CELIX_ENOMEM;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        rsa_shm_metadata_entry_t entry;
+        if ((size_t)(end - pos) < sizeof(entry)) {
+            goto invalid_metadata;
+        }
+        memcpy(&entry, pos, sizeof(entry));
+        pos += sizeof(entry);
+        if (entry.keySize == 0 || (size_t)(end - pos) < (size_t)entry.keySize + entry.valueSize
+                || pos[entry.keySize - 1] != '\0') {
+            goto invalid_metadata;
+        }
+        const char *key = pos;
+        const char *value = pos + entry.keySize;
+        if (!rsaShmMetadata_valueSizeIsValid(&entry, value) || !rsaShmMetadata_decodeEntry(props, &entry, key, value)) {
+            goto invalid_metadata;
+        }
+        pos = value + entry.valueSize;
+    }
+    if (pos != end) {
+        goto invalid_metadata;
+    }
+    *metadata = props;
+    return CELIX_SUCCESS;
+invalid_metadata:
+    celix_properties_destroy(props);
+    return CELIX_ILLEGAL_ARGUMENT;
+}
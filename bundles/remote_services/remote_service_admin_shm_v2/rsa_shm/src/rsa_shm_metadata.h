@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _RSA_SHM_METADATA_H_
+#define _RSA_SHM_METADATA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "celix_properties.h"
+#include "celix_errno.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * The binary metadata format is a uint32_t entry count followed by the entries. An entry is a rsa_shm_metadata_entry_t
+ * header, followed by the key(including the terminating null byte) and the value. The value of a string or version
+ * entry includes the terminating null byte, the value of a long or double entry is 8 bytes and of a bool entry 1 byte.
+ * All numbers are in the byte order of the host, the client and server run on the same host.
+ */
+
+typedef enum {
+    RSA_SHM_METADATA_FORMAT_TEXT = 0,//The metadata is a properties string, "key=value\n" entries with a terminating null byte
+    RSA_SHM_METADATA_FORMAT_BINARY = 1,
+}rsa_shm_metadata_format;
+
+typedef struct rsa_shm_metadata_entry {
+    uint8_t type;//celix_properties_value_type_e
+    uint8_t reserved[3];
+    uint32_t keySize;
+    uint32_t valueSize;
+}rsa_shm_metadata_entry_t;
+
+/**
+ * @brief The size of the binary encoded metadata, 0 if the metadata is NULL or empty.
+ */
+size_t rsaShmMetadata_encodedSize(const celix_properties_t *metadata);
+
+/**
+ * @brief Encode the metadata in binary format.
+ *
+ * @param[in] metadata The metadata
+ * @param[out] buf The buffer, its size should be rsaShmMetadata_encodedSize
+ */
+void rsaShmMetadata_encode(const celix_properties_t *metadata, char *buf);
+
+/**
+ * @brief Decode binary encoded metadata.
+ *
+ * @param[in] buf The binary encoded metadata
+ * @param[in] size The size of the binary encoded metadata
+ * @param[out] metadata The decoded metadata, the caller is the owner
+ * @return CELIX_SUCCESS, or CELIX_ILLEGAL_ARGUMENT if the encoded metadata is invalid
+ */
+celix_status_t rsaShmMetadata_decode(const char *buf, size_t size, celix_properties_t **metadata);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RSA_SHM_METADATA_H_ */
@@ -41,8 +41,28 @@ typedef struct rsa_shm_msg_control {
     pthread_mutex_t lock;
     pthread_cond_t signal;
     size_t actualReplyedSize;
+    int replyShmId;//If it is not -1 when msgState is REPLIED, the whole response is in the shared memory of the server, see rsa_shm_reply_t
+    ssize_t replyOffset;//The offset of the rsa_shm_reply_t in the shared memory of the server
+    unsigned int serverFeatures;//RSA_SHM_SERVER_FEATURE_* flags, set by the server when it handles the request
 }rsa_shm_msg_control_t;
 
+#define RSA_SHM_SERVER_FEATURE_BINARY_METADATA 0x1//The server accepts metadata in RSA_SHM_METADATA_FORMAT_BINARY
+
+/**
+ * A response that the server allocated in its own shared memory pool, so that it is handed to the client at once.
+ * The response data follows the structure, and the client sets 'released' after reading it.
+ */
+typedef struct rsa_shm_reply {
+    size_t size;//The size of 'struct rsa_shm_reply'. It is used to extend 'struct rsa_shm_reply' in the future.
+    size_t dataSize;
+    unsigned int released;//atomic, written by the client
+}rsa_shm_reply_t;
+
+typedef enum {
+    RSA_SHM_MSG_TYPE_REQUEST = 0,
+    RSA_SHM_MSG_TYPE_RING_ATTACH = 1,//Ask the server to serve a ring channel, see rsa_shm_ring.h
+}rsa_shm_msg_type;
+
 typedef struct rsa_shm_msg {
     size_t size;//The size of ‘struct rsa_shm_msg‘.It is used to extend 'struct rsa_shm_msg' in the future.
     int shmId;
@@ -52,6 +72,8 @@ typedef struct rsa_shm_msg {
     size_t msgBodyTotalSize;//equal metadataSize + requestSize + reserve space size
     size_t metadataSize;
     size_t requestSize;
+    int msgType;//rsa_shm_msg_type. For RSA_SHM_MSG_TYPE_RING_ATTACH, ctrlDataOffset and ctrlDataSize describe the ring channel.
+    int metadataFormat;//rsa_shm_metadata_format of the metadata in the message body. Only used if the server announced RSA_SHM_SERVER_FEATURE_BINARY_METADATA.
 }rsa_shm_msg_t;
 
 #ifdef __cplusplus
@@ -0,0 +1,213 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "rsa_shm_ring.h"
+#include "celix_utils.h"
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/param.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#define RSA_SHM_RING_MIN_SPIN 64
+#define RSA_SHM_RING_MAX_SPIN (16*1024)
+//Max time of a single sleep, so that a missed wake up(e.g. the peer process is gone) is noticed
+#define RSA_SHM_RING_MAX_SLEEP_IN_NS (100*1000*1000)
+#define RSA_SHM_RING_MAX_SLOT_COUNT 1024
+#define RSA_SHM_RING_MAX_SLOT_SIZE (1024*1024)
+
+static inline void rsaShmRing_cpuRelax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static void rsaShmRing_sleep(uint32_t *word, uint32_t value, const struct timespec *timeout) {
+#ifdef __linux__
+    //Note not FUTEX_PRIVATE_FLAG, the futex word is in memory shared between processes
+    (void)syscall(SYS_futex, word, FUTEX_WAIT, value, timeout, NULL, 0);
+#else
+    (void)word;
+    (void)value;
+    (void)timeout;
+    usleep(50);
+#endif
+}
+
+static void rsaShmRing_wake(uint32_t *word) {
+#ifdef __linux__
+    (void)syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#else
+    (void)word;
+#endif
+}
+
+size_t rsaShmRing_channelSize(uint32_t slotCount, uint32_t slotSize) {
+    return sizeof(rsa_shm_ring_channel_t) + 2 * (size_t)slotCount * slotSize;
+}
+
+void rsaShmRing_initChannel(rsa_shm_ring_channel_t *channel, uint32_t slotCount, uint32_t slotSize) {
+    memset(channel, 0, sizeof(*channel));
+    channel->size = sizeof(rsa_shm_ring_channel_t);
+    channel->slotCount = slotCount;
+    channel->slotSize = slotSize;
+    channel->slotsOffset = sizeof(rsa_shm_ring_channel_t);
+    channel->state = RSA_SHM_RING_CHANNEL_PENDING;
+}
+
+bool rsaShmRing_channelIsValid(const rsa_shm_ring_channel_t *channel, size_t channelSize) {
+    if (channel == NULL || channelSize < sizeof(rsa_shm_ring_channel_t)
+            || channel->size < offsetof(rsa_shm_ring_channel_t, response) + sizeof(channel->response)) {
+        return false;
+    }
+    uint32_t slotCount = channel->slotCount;
+    uint32_t slotSize = channel->slotSize;
+    if (slotCount == 0 || slotCount > RSA_SHM_RING_MAX_SLOT_COUNT || (slotCount & (slotCount - 1)) != 0
+            || slotSize <= sizeof(rsa_shm_ring_record_t) || slotSize > RSA_SHM_RING_MAX_SLOT_SIZE
+            || slotSize % sizeof(uint64_t) != 0) {
+        return false;
+    }
+    return channel->slotsOffset >= channel->size
+            && channel->slotsOffset + 2 * (size_t)slotCount * slotSize == channelSize;
+}
+
+size_t rsaShmRing_recordCapacity(const rsa_shm_ring_channel_t *channel) {
+    return channel->slotSize - sizeof(rsa_shm_ring_record_t);
+}
+
+uint32_t rsaShmRing_getState(const rsa_shm_ring_channel_t *channel) {
+    return __atomic_load_n(&channel->state, __ATOMIC_ACQUIRE);
+}
+
+void rsaShmRing_setState(rsa_shm_ring_channel_t *channel, rsa_shm_ring_channel_state state) {
+    __atomic_store_n(&channel->state, state, __ATOMIC_SEQ_CST);
+    rsaShmRing_wake(&channel->response.head);
+}
+
+bool rsaShmRing_isClosed(const rsa_shm_ring_channel_t *channel) {
+    return __atomic_load_n(&channel->closed, __ATOMIC_ACQUIRE) != 0;
+}
+
+void rsaShmRing_close(rsa_shm_ring_channel_t *channel) {
+    __atomic_store_n(&channel->closed, 1, __ATOMIC_SEQ_CST);
+    rsaShmRing_wake(&channel->request.head);
+    rsaShmRing_wake(&channel->request.tail);
+    rsaShmRing_wake(&channel->response.head);
+    rsaShmRing_wake(&channel->response.tail);
+}
+
+static rsa_shm_ring_record_t *rsaShmRing_slot(rsa_shm_ring_channel_t *channel, rsa_shm_ring_t *ring, uint32_t index) {
+    size_t offset = channel->slotsOffset;
+    if (ring == &channel->response) {
+        offset += (size_t)channel->slotCount * channel->slotSize;
+    }
+    offset += (size_t)(index & (channel->slotCount - 1)) * channel->slotSize;
+    return (rsa_shm_ring_record_t *)((char *)channel + offset);
+}
+
+static bool rsaShmRing_isCancelled(const rsa_shm_ring_channel_t *channel) {
+    return rsaShmRing_isClosed(channel) || rsaShmRing_getState(channel) == RSA_SHM_RING_CHANNEL_DETACHED;
+}
+
+/**
+ * Wait until the word is not equal to value anymore. Spins first, and then sleeps on the word as futex.
+ */
+static int rsaShmRing_waitWhileEqual(rsa_shm_ring_channel_t *channel, uint32_t *word, uint32_t *waiters,
+        uint32_t value, unsigned int *spinBudget, const struct timespec *deadline) {
+    unsigned int budget = MIN(MAX(*spinBudget, RSA_SHM_RING_MIN_SPIN), RSA_SHM_RING_MAX_SPIN);
+    for (unsigned int i = 0; i < budget; ++i) {
+        if (__atomic_load_n(word, __ATOMIC_ACQUIRE) != value) {
+            //spinning paid off, spin a bit longer next time
+            *spinBudget = MIN(budget * 2, RSA_SHM_RING_MAX_SPIN);
+            return 0;
+        }
+        rsaShmRing_cpuRelax();
+    }
+    *spinBudget = MAX(budget / 2, RSA_SHM_RING_MIN_SPIN);
+
+    while (__atomic_load_n(word, __ATOMIC_ACQUIRE) == value) {
+        if (rsaShmRing_isCancelled(channel)) {
+            return ECANCELED;
+        }
+        double remaining = -celix_elapsedtime(CLOCK_MONOTONIC, *deadline);
+        if (remaining <= 0) {
+            return ETIMEDOUT;
+        }
+        long sleepInNs = (remaining * 1e9) < RSA_SHM_RING_MAX_SLEEP_IN_NS ? (long)(remaining * 1e9) : RSA_SHM_RING_MAX_SLEEP_IN_NS;
+        struct timespec timeout = {.tv_sec = 0, .tv_nsec = sleepInNs};
+        //Note seq_cst, the waker stores the word and then loads the waiters
+        __atomic_add_fetch(waiters, 1, __ATOMIC_SEQ_CST);
+        rsaShmRing_sleep(word, value, &timeout);
+        __atomic_sub_fetch(waiters, 1, __ATOMIC_SEQ_CST);
+    }
+    return 0;
+}
+
+static void rsaShmRing_storeAndWake(uint32_t *word, uint32_t *waiters, uint32_t value) {
+    __atomic_store_n(word, value, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(waiters, __ATOMIC_SEQ_CST) > 0) {
+        rsaShmRing_wake(word);
+    }
+}
+
+int rsaShmRing_waitForSpace(rsa_shm_ring_channel_t *channel, rsa_shm_ring_t *ring, unsigned int *spinBudget,
+        const struct timespec *deadline, rsa_shm_ring_record_t **record) {
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);//Only written by the caller
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    while (head - tail >= channel->slotCount) {
+        int ret = rsaShmRing_waitWhileEqual(channel, &ring->tail, &ring->tailWaiters, tail, spinBudget, deadline);
+        if (ret != 0) {
+            return ret;
+        }
+        tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    }
+    *record = rsaShmRing_slot(channel, ring, head);
+    return 0;
+}
+
+void rsaShmRing_publish(rsa_shm_ring_t *ring) {
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    rsaShmRing_storeAndWake(&ring->head, &ring->headWaiters, head + 1);
+}
+
+int rsaShmRing_waitForRecord(rsa_shm_ring_channel_t *channel, rsa_shm_ring_t *ring, unsigned int *spinBudget,
+        const struct timespec *deadline, rsa_shm_ring_record_t **record) {
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);//Only written by the caller
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    while (head == tail) {
+        int ret = rsaShmRing_waitWhileEqual(channel, &ring->head, &ring->headWaiters, head, spinBudget, deadline);
+        if (ret != 0) {
+            return ret;
+        }
+        head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    }
+    *record = rsaShmRing_slot(channel, ring, tail);
+    return 0;
+}
+
+void rsaShmRing_release(rsa_shm_ring_t *ring) {
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    rsaShmRing_storeAndWake(&ring->tail, &ring->tailWaiters, tail + 1);
+}
@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _RSA_SHM_RING_H_
+#define _RSA_SHM_RING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include <time.h>
+
+/**
+ * A ring channel is allocated by the client in its shared memory pool and consists of a request ring and a response ring.
+ * Both rings are single producer/single consumer rings of fixed size slots: the request ring is written by the client and
+ * read by the server, the response ring is written by the server and read by the client.
+ *
+ * The head and tail of a ring are also used as futex words (doorbells). A waiting party first spins for a while
+ * (adaptive, based on how successful spinning was before) and then sleeps on the futex word, the other party only
+ * does a futex wake if somebody is sleeping. So if both parties are active no syscall is needed to exchange a message.
+ *
+ * The server handles the requests of a channel one by one in ring order, so a client can have several requests
+ * in flight on a channel and correlate the responses in the same order.
+ */
+
+typedef enum {
+    RSA_SHM_RING_CHANNEL_PENDING = 0,//Waiting for the server to attach
+    RSA_SHM_RING_CHANNEL_ATTACHED = 1,
+    RSA_SHM_RING_CHANNEL_REJECTED = 2,//The server does not serve the channel
+    RSA_SHM_RING_CHANNEL_DETACHED = 3,//The server stopped serving the channel, it will not touch the channel anymore
+}rsa_shm_ring_channel_state;
+
+#define RSA_SHM_RING_RECORD_FLAG_LAST 0x1//Last record of a message
+#define RSA_SHM_RING_RECORD_FLAG_ABEND 0x2//The server failed to handle the request
+#define RSA_SHM_RING_RECORD_FLAG_BINARY_METADATA 0x4//The metadata of the request is in RSA_SHM_METADATA_FORMAT_BINARY
+#define RSA_SHM_RING_RECORD_FLAG_REQUEST_ID 0x8//The response record carries the requestId of its request
+
+typedef struct rsa_shm_ring_record {
+    uint32_t flags;
+    uint32_t metadataSize;//Size of the metadata at the start of data, for text metadata including the terminating null byte
+    uint32_t dataSize;//Size of the metadata and the (part of the) request or response
+    uint32_t requestId;//Set by the client, and echoed by the server in the response records. Older servers do not echo it
+    char data[];
+}rsa_shm_ring_record_t;
+
+typedef struct rsa_shm_ring {
+    uint32_t head;//Written by the producer
+    uint32_t headWaiters;//Number of consumers sleeping on head
+    char headPadding[56];//Keep head and tail on different cache lines
+    uint32_t tail;//Written by the consumer
+    uint32_t tailWaiters;//Number of producers sleeping on tail
+    char tailPadding[56];
+}rsa_shm_ring_t;
+
+typedef struct rsa_shm_ring_channel {
+    size_t size;//The size of 'struct rsa_shm_ring_channel'. It is used to extend 'struct rsa_shm_ring_channel' in the future.
+    uint32_t slotCount;//Power of 2
+    uint32_t slotSize;//Including the record header
+    size_t slotsOffset;//Offset of the request slots from the start of the channel, the response slots follow
+    uint32_t state;//rsa_shm_ring_channel_state, written by the server
+    uint32_t closed;//If not 0 the channel is closing and the server should detach. Set by the client, or by the server when it stops or the client is gone
+    rsa_shm_ring_t request;
+    rsa_shm_ring_t response;
+}rsa_shm_ring_channel_t;
+
+/**
+ * @brief The total size of a ring channel, including the slots.
+ */
+size_t rsaShmRing_channelSize(uint32_t slotCount, uint32_t slotSize);
+
+/**
+ * @brief Initialize a ring channel with the size of rsaShmRing_channelSize.
+ */
+void rsaShmRing_initChannel(rsa_shm_ring_channel_t *channel, uint32_t slotCount, uint32_t slotSize);
+
+/**
+ * @brief Check whether a ring channel (received from a peer) is valid.
+ * @param[in] channel The ring channel
+ * @param[in] channelSize The size of the ring channel memory
+ */
+bool rsaShmRing_channelIsValid(const rsa_shm_ring_channel_t *channel, size_t channelSize);
+
+/**
+ * @brief The max size of the data of a single record.
+ */
+size_t rsaShmRing_recordCapacity(const rsa_shm_ring_channel_t *channel);
+
+uint32_t rsaShmRing_getState(const rsa_shm_ring_channel_t *channel);
+
+/**
+ * @brief Set the state of a ring channel and wake up the client if it is waiting for a response.
+ */
+void rsaShmRing_setState(rsa_shm_ring_channel_t *channel, rsa_shm_ring_channel_state state);
+
+bool rsaShmRing_isClosed(const rsa_shm_ring_channel_t *channel);
+
+/**
+ * @brief Mark the ring channel as closed and wake up all waiting parties.
+ */
+void rsaShmRing_close(rsa_shm_ring_channel_t *channel);
+
+/**
+ * @brief Wait until there is a free slot in the ring and return it.
+ *
+ * @param[in] channel The ring channel
+ * @param[in] ring The request or response ring of the channel
+ * @param[in,out] spinBudget The adaptive spin budget of the caller
+ * @param[in] deadline Absolute CLOCK_MONOTONIC deadline
+ * @param[out] record The free slot
+ * @return 0, ETIMEDOUT, or ECANCELED if the channel is closed or detached.
+ */
+int rsaShmRing_waitForSpace(rsa_shm_ring_channel_t *channel, rsa_shm_ring_t *ring, unsigned int *spinBudget,
+        const struct timespec *deadline, rsa_shm_ring_record_t **record);
+
+/**
+ * @brief Publish the slot returned by rsaShmRing_waitForSpace to the consumer.
+ */
+void rsaShmRing_publish(rsa_shm_ring_t *ring);
+
+/**
+ * @brief Wait until there is a record in the ring and return it.
+ * @return 0, ETIMEDOUT, or ECANCELED if the channel is closed or detached.
+ */
+int rsaShmRing_waitForRecord(rsa_shm_ring_channel_t *channel, rsa_shm_ring_t *ring, unsigned int *spinBudget,
+        const struct timespec *deadline, rsa_shm_ring_record_t **record);
+
+/**
+ * @brief Give the slot of the record returned by rsaShmRing_waitForRecord back to the producer.
+ */
+void rsaShmRing_release(rsa_shm_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RSA_SHM_RING_H_ */
@@ -18,11 +18,14 @@
  */
 #include "rsa_shm_server.h"
 #include "rsa_shm_msg.h"
+#include "rsa_shm_ring.h"
+#include "rsa_shm_metadata.h"
 #include "rsa_shm_constants.h"
 #include "shm_cache.h"
 #include "celix_log_helper.h"
 #include "celix_build_assert.h"
 #include "celix_api.h"
+#include "celix_array_list.h"
 #include <thpool.h>
 #include <sys/un.h>
 #include <sys/socket.h>
@@ -37,6 +40,7 @@
 #include <errno.h>
 
 #define MAX_RSA_SHM_SERVER_HANDLE_MSG_THREADS_NUM 5
+#define RSA_SHM_SERVER_RING_IDLE_TIMEOUT_IN_S 1
 
 struct rsa_shm_server {
     celix_bundle_context_t *ctx;
@@ -50,18 +54,54 @@ struct rsa_shm_server {
     rsaShmServer_receiveMsgCB revCB;
     void *revCBHandle;
     long msgTimeOutInSec;
+    celix_thread_mutex_t ringChannelsMutex;// projects below
+    celix_array_list_t *ringChannels;//Element: rsa_shm_server_ring_channel_t
+    shm_pool_t *replyPool;//Shared memory for responses that do not fit in the request buffer, it can be NULL
+    celix_thread_mutex_t shmRepliesMutex;// projects below
+    celix_array_list_t *shmReplies;//Element: rsa_shm_server_shm_reply_t, the responses in replyPool that are handed to clients
 };
 
+typedef struct rsa_shm_server_shm_reply {
+    rsa_shm_reply_t *reply;
+    int clientShmId;
+}rsa_shm_server_shm_reply_t;
+
+/**
+ * The response allocator of a request, it allocates the response from the reply pool
+ * if the response does not fit in the request buffer of the client.
+ */
+typedef struct rsa_shm_server_reply_allocator {
+    rsa_shm_server_t *server;
+    rsa_response_allocator_t allocator;
+    size_t msgBodyTotalSize;
+    rsa_shm_reply_t *reply;//The allocated response
+}rsa_shm_server_reply_allocator_t;
+
+typedef struct rsa_shm_server_ring_channel {
+    rsa_shm_server_t *server;
+    int shmId;
+    rsa_shm_ring_channel_t *channel;
+    celix_thread_t thread;
+    bool detached;//The server does not touch the channel anymore, the client may free it. Protected by ringChannelsMutex
+    bool finished;//atomic, set by the ring channel thread just before it returns
+    unsigned int spinBudget;
+}rsa_shm_server_ring_channel_t;
+
 struct rsa_shm_server_thpool_work_data {
     rsa_shm_server_t *server;
+    int clientShmId;
     rsa_shm_msg_control_t *msgCtrl;
     void *msgBody;
     size_t msgBodyTotalSize;
     size_t metadataSize;
     size_t requestSize;
+    int metadataFormat;
 };
 
 static void *rsaShmServer_receiveMsgThread(void *data);
+static void rsaShmServer_shmPeerClosed(void *handle, shm_cache_t *shmCache, int shmId);
+static void rsaShmServer_stopRingChannels(rsa_shm_server_t *server);
+static void rsaShmServer_freeShmReplies(rsa_shm_server_t *server, int clientShmId);
 
 celix_status_t rsaShmServer_create(celix_bundle_context_t *ctx, const char *name, celix_log_helper_t *loghelper,
         rsaShmServer_receiveMsgCB receiveCB, void *revHandle, rsa_shm_server_t **shmServerOut) {
@@ -110,6 +150,33 @@ celix_status_t rsaShmServer_create(celix_bundle_context_t *ctx, const char *name
     }
     server->shmCache = shmCache;
 
+    status = celixThreadMutex_create(&server->ringChannelsMutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(loghelper, "RsaShmServer: create ring channels mutex err.");
+        goto create_ring_channels_mutex_err;
+    }
+    server->ringChannels = celix_arrayList_create();
+    assert(server->ringChannels != NULL);
+    shmCache_setShmPeerClosedCB(shmCache, rsaShmServer_shmPeerClosed, server);
+
+    server->replyPool = NULL;
+    long replyPoolSize = celix_bundleContext_getPropertyAsLong(ctx, RSA_SHM_RESPONSE_POOL_SIZE_KEY,
+            RSA_SHM_RESPONSE_POOL_SIZE_DEFAULT);
+    if (replyPoolSize > 0) {
+        status = shmPool_create(replyPoolSize, &server->replyPool);
+        if (status != CELIX_SUCCESS) {
+            celix_logHelper_error(loghelper, "RsaShmServer: create reply shm pool err; error code is %d.", status);
+            goto create_reply_pool_err;
+        }
+    }
+    status = celixThreadMutex_create(&server->shmRepliesMutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(loghelper, "RsaShmServer: create shm replies mutex err.");
+        goto create_shm_replies_mutex_err;
+    }
+    server->shmReplies = celix_arrayList_create();
+    assert(server->shmReplies != NULL);
+
     server->threadPool = thpool_init(MAX_RSA_SHM_SERVER_HANDLE_MSG_THREADS_NUM);
     if (server->threadPool == NULL) {
         celix_logHelper_error(loghelper, "RsaShmServer: create thread pool err.");
@@ -129,6 +196,14 @@ celix_status_t rsaShmServer_create(celix_bundle_context_t *ctx, const char *name
 create_rev_msg_thread_err:
     thpool_destroy(server->threadPool);
 create_thpool_err:
+    celix_arrayList_destroy(server->shmReplies);
+    (void)celixThreadMutex_destroy(&server->shmRepliesMutex);
+create_shm_replies_mutex_err:
+    shmPool_destroy(server->replyPool);
+create_reply_pool_err:
+    celix_arrayList_destroy(server->ringChannels);
+    (void)celixThreadMutex_destroy(&server->ringChannelsMutex);
+create_ring_channels_mutex_err:
     shmCache_destroy(shmCache);
 create_shm_cache_err:
 sfd_bind_err:
@@ -145,9 +220,20 @@ void rsaShmServer_destroy(rsa_shm_server_t *server) {
         server->revMsgThreadActive = false;
         shutdown(server->sfd,SHUT_RD);
         celixThread_join(server->revMsgThread, NULL);
+        rsaShmServer_stopRingChannels(server);
         thpool_wait(server->threadPool);
         thpool_destroy(server->threadPool);
         shmCache_destroy(server->shmCache);
+        celix_arrayList_destroy(server->ringChannels);
+        (void)celixThreadMutex_destroy(&server->ringChannelsMutex);
+        //Note the responses are not freed, the clients keep the reply pool attached until they are done with them
+        int shmRepliesSize = celix_arrayList_size(server->shmReplies);
+        for (int i = 0; i < shmRepliesSize; ++i) {
+            free(celix_arrayList_get(server->shmReplies, i));
+        }
+        celix_arrayList_destroy(server->shmReplies);
+        (void)celixThreadMutex_destroy(&server->shmRepliesMutex);
+        shmPool_destroy(server->replyPool);
         close(server->sfd);
         free(server->name);
         free(server);
@@ -169,6 +255,115 @@ static void rsaShmServer_terminateMsgHandling(rsa_shm_msg_control_t *ctrl) {
     return;
 }
 
+static void *rsaShmServer_allocateReply(void *handle, size_t size) {
+    rsa_shm_server_reply_allocator_t *replyAllocator = handle;
+    assert(replyAllocator != NULL);
+    rsa_shm_server_t *server = replyAllocator->server;
+    if (replyAllocator->reply != NULL || size <= replyAllocator->msgBodyTotalSize) {
+        //Only one response per request, and a response that fits in the request buffer is copied at once anyway
+        return NULL;
+    }
+    //Free the responses that clients are done with, before allocating a new one
+    rsaShmServer_freeShmReplies(server, -1);
+    rsa_shm_reply_t *reply = shmPool_malloc(server->replyPool, sizeof(rsa_shm_reply_t) + size);
+    if (reply == NULL) {
+        celix_logHelper_debug(server->loghelper, "RsaShmServer: Reply pool is exhausted, copy the response in chunks.");
+        return NULL;
+    }
+    reply->size = sizeof(rsa_shm_reply_t);
+    reply->dataSize = size;
+    reply->released = 0;
+    replyAllocator->reply = reply;
+    return (char *)reply + sizeof(rsa_shm_reply_t);
+}
+
+static void rsaShmServer_deallocateReply(void *handle, void *ptr) {
+    rsa_shm_server_reply_allocator_t *replyAllocator = handle;
+    assert(replyAllocator != NULL);
+    if (ptr != NULL && replyAllocator->reply != NULL && ptr == (char *)replyAllocator->reply + sizeof(rsa_shm_reply_t)) {
+        shmPool_free(replyAllocator->server->replyPool, replyAllocator->reply);
+        replyAllocator->reply = NULL;
+    }
+}
+
+static bool rsaShmServer_isShmReply(rsa_shm_server_reply_allocator_t *replyAllocator, const void *ptr) {
+    return replyAllocator->reply != NULL && ptr == (char *)replyAllocator->reply + sizeof(rsa_shm_reply_t);
+}
+
+static void rsaShmServer_freeReply(rsa_shm_server_reply_allocator_t *replyAllocator, void *ptr) {
+    if (!rsaShmServer_isShmReply(replyAllocator, ptr)) {
+        free(ptr);
+    }
+    if (replyAllocator->reply != NULL) {
+        shmPool_free(replyAllocator->server->replyPool, replyAllocator->reply);
+        replyAllocator->reply = NULL;
+    }
+}
+
+/**
+ * Hand the response in the reply pool to the client, the client reads it at once and releases it.
+ */
+static bool rsaShmServer_replyByShm(rsa_shm_server_t *server, rsa_shm_msg_control_t *msgCtrl, int clientShmId,
+        rsa_shm_server_reply_allocator_t *replyAllocator, size_t replySize) {
+    rsa_shm_server_shm_reply_t *shmReply = malloc(sizeof(*shmReply));
+    if (shmReply == NULL) {
+        return false;
+    }
+    shmReply->reply = replyAllocator->reply;
+    shmReply->clientShmId = clientShmId;
+
+    pthread_mutex_lock(&msgCtrl->lock);
+    if (msgCtrl->msgState == REQ_CANCELLED) {
+        pthread_mutex_unlock(&msgCtrl->lock);
+        free(shmReply);
+        return false;
+    }
+    msgCtrl->replyShmId = shmPool_getShmId(server->replyPool);
+    msgCtrl->replyOffset = shmPool_getMemoryOffset(server->replyPool, replyAllocator->reply);
+    msgCtrl->actualReplyedSize = replySize;
+    msgCtrl->msgState = REPLIED;
+    //Signaling the condition variable first, and then unlocking the mutex, because client will free ctrl when msgState is REPLIED.
+    pthread_cond_signal(&msgCtrl->signal);
+    pthread_mutex_unlock(&msgCtrl->lock);
+
+    //The response is owned by the client now, it is freed after the client releases it
+    celixThreadMutex_lock(&server->shmRepliesMutex);
+    celix_arrayList_add(server->shmReplies, shmReply);
+    celixThreadMutex_unlock(&server->shmRepliesMutex);
+    replyAllocator->reply = NULL;
+    return true;
+}
+
+static void rsaShmServer_freeShmReplies(rsa_shm_server_t *server, int clientShmId) {
+    celixThreadMutex_lock(&server->shmRepliesMutex);
+    for (int i = celix_arrayList_size(server->shmReplies) - 1; i >= 0; --i) {
+        rsa_shm_server_shm_reply_t *shmReply = celix_arrayList_get(server->shmReplies, i);
+        if (shmReply->clientShmId == clientShmId || __atomic_load_n(&shmReply->reply->released, __ATOMIC_ACQUIRE) != 0) {
+            shmPool_free(server->replyPool, shmReply->reply);
+            celix_arrayList_removeAt(server->shmReplies, i);
+            free(shmReply);
+        }
+    }
+    celixThreadMutex_unlock(&server->shmRepliesMutex);
+}
+
+static celix_properties_t *rsaShmServer_parseMetadata(rsa_shm_server_t *server, int metadataFormat,
+        const char *metadata, size_t metadataSize) {
+    celix_properties_t *metadataProps = NULL;
+    if (metadataSize == 0) {
+        return NULL;
+    }
+    if (metadataFormat == RSA_SHM_METADATA_FORMAT_BINARY) {
+        (void)rsaShmMetadata_decode(metadata, metadataSize, &metadataProps);
+    } else {
+        metadataProps = celix_properties_loadFromString(metadata);
+    }
+    if (metadataProps == NULL) {
+        celix_logHelper_warning(server->loghelper, "RsaShmServer: Parse metadata failed.");
+    }
+    return metadataProps;
+}
+
 static void rsaShmServer_msgHandlingWork(void *data) {
     assert(data != NULL);
     int status =  CELIX_SUCCESS;
@@ -178,26 +373,48 @@ static void rsaShmServer_msgHandlingWork(void *data) {
 
     rsa_shm_msg_control_t *msgCtrl = (rsa_shm_msg_control_t *)workData->msgCtrl;
     char *msgBuffer = (char*)workData->msgBody;
-    const char *metaDataString = msgBuffer;
     char *requestData = msgBuffer + workData->metadataSize;
 
-    celix_properties_t *metadataProps = NULL;
-    if (workData->metadataSize != 0) {
-        metadataProps = celix_properties_loadFromString(metaDataString);
-        if (metadataProps == NULL) {
-            celix_logHelper_warning(server->loghelper, "RsaShmServer: Parse metadata failed.");
-        }
+    celix_properties_t *metadataProps = rsaShmServer_parseMetadata(server, workData->metadataFormat, msgBuffer,
+            workData->metadataSize);
+    if (msgCtrl->size >= offsetof(rsa_shm_msg_control_t, serverFeatures) + sizeof(msgCtrl->serverFeatures)) {
+        //Let the client use binary metadata for the next requests
+        msgCtrl->serverFeatures = RSA_SHM_SERVER_FEATURE_BINARY_METADATA;
     }
 
+    rsa_shm_server_reply_allocator_t replyAllocator = {
+            .server = server,
+            .allocator = {
+                    .handle = &replyAllocator,
+                    .allocate = rsaShmServer_allocateReply,
+                    .deallocate = rsaShmServer_deallocateReply,
+            },
+            .msgBodyTotalSize = workData->msgBodyTotalSize,
+            .reply = NULL,
+    };
+    //Old clients do not know the response in the reply pool
+    bool shmReplySupported = server->replyPool != NULL
+            && msgCtrl->size >= offsetof(rsa_shm_msg_control_t, replyOffset) + sizeof(msgCtrl->replyOffset);
+
     struct iovec reply = {NULL, 0};
     struct iovec request = {requestData, workData->requestSize};
-    status = server->revCB(server->revCBHandle, server, metadataProps, &request, &reply);
+    status = server->revCB(server->revCBHandle, server, metadataProps, &request,
+            shmReplySupported ? &replyAllocator.allocator : NULL, &reply);
     if (status != CELIX_SUCCESS || reply.iov_base == NULL || reply.iov_len == 0) {
         celix_logHelper_error(server->loghelper, "RsaShmServer: Call receive msg callback failed. Error data:%d, %p, %zu.",
                 status, reply.iov_base, reply.iov_len);
         goto call_receive_cb_failed;
     }
 
+    if (rsaShmServer_isShmReply(&replyAllocator, reply.iov_base)) {
+        if (reply.iov_len > replyAllocator.reply->dataSize
+                || !rsaShmServer_replyByShm(server, msgCtrl, workData->clientShmId, &replyAllocator, reply.iov_len)) {
+            celix_logHelper_error(server->loghelper, "RsaShmServer: Client cancelled the request, or the response is invalid.");
+            goto reply_err;
+        }
+        goto replied;
+    }
+
     char *src = reply.iov_base;
     size_t srcSize = reply.iov_len;
     int waitRet = 0;
@@ -236,7 +453,8 @@ static void rsaShmServer_msgHandlingWork(void *data) {
     pthread_mutex_unlock(&msgCtrl->lock);
 
 
-    free(reply.iov_base);
+    rsaShmServer_freeReply(&replyAllocator, reply.iov_base);
+replied:
     if (metadataProps != NULL) {
         celix_properties_destroy(metadataProps);
     }
@@ -246,8 +464,8 @@ static void rsaShmServer_msgHandlingWork(void *data) {
     return;
 
 reply_err:
-    free(reply.iov_base);
 call_receive_cb_failed:
+    rsaShmServer_freeReply(&replyAllocator, reply.iov_base);
     if (metadataProps != NULL) {
         celix_properties_destroy(metadataProps);
     }
@@ -264,7 +482,7 @@ static bool rsaShmServer_msgInvalid(rsa_shm_server_t *server, const rsa_shm_msg_
     CELIX_BUILD_ASSERT(offsetof(rsa_shm_msg_t, size) == 0);
     if (msgInfo->size < (offsetof(rsa_shm_msg_t, requestSize) + sizeof(msgInfo->requestSize))
             || msgInfo->shmId < 0 || msgInfo->ctrlDataOffset < 0 || msgInfo->msgBodyOffset < 0
-            || msgInfo->ctrlDataSize != sizeof(rsa_shm_msg_control_t)) {
+            || msgInfo->ctrlDataSize < offsetof(rsa_shm_msg_control_t, actualReplyedSize) + sizeof(size_t)) {
         celix_logHelper_error(server->loghelper, "RsaShmServer: Shm msg info invalid. Msg info:%d, %zd, %zd, %zu.",
                 msgInfo->shmId, msgInfo->ctrlDataOffset, msgInfo->msgBodyOffset, msgInfo->ctrlDataSize);
         return true;
@@ -286,6 +504,192 @@ static bool rsaShmServer_msgCtrlInvalid(rsa_shm_server_t *server, const rsa_shm_
     return false;
 }
 
+static bool rsaShmServer_writeRingResponse(rsa_shm_server_ring_channel_t *ringChannel, uint32_t requestId,
+        uint32_t flags, const char *data, size_t size) {
+    rsa_shm_server_t *server = ringChannel->server;
+    rsa_shm_ring_channel_t *channel = ringChannel->channel;
+    size_t capacity = rsaShmRing_recordCapacity(channel);
+    struct timespec deadline = celix_gettime(CLOCK_MONOTONIC);
+    deadline.tv_sec += server->msgTimeOutInSec;
+    do {
+        rsa_shm_ring_record_t *record = NULL;
+        int ret = rsaShmRing_waitForSpace(channel, &channel->response, &ringChannel->spinBudget, &deadline, &record);
+        if (ret != 0) {
+            celix_logHelper_error(server->loghelper, "RsaShmServer: Client cancelled the request, or timeout. %d.", ret);
+            return false;
+        }
+        size_t bytes = MIN(size, capacity);
+        memcpy(record->data, data, bytes);
+        record->metadataSize = 0;
+        record->dataSize = (uint32_t)bytes;
+        record->requestId = requestId;
+        data += bytes;
+        size -= bytes;
+        record->flags = flags | RSA_SHM_RING_RECORD_FLAG_REQUEST_ID | (size == 0 ? RSA_SHM_RING_RECORD_FLAG_LAST : 0);
+        rsaShmRing_publish(&channel->response);
+    } while (size > 0);
+    return true;
+}
+
+static bool rsaShmServer_handleRingRequest(rsa_shm_server_ring_channel_t *ringChannel, rsa_shm_ring_record_t *record) {
+    rsa_shm_server_t *server = ringChannel->server;
+    rsa_shm_ring_channel_t *channel = ringChannel->channel;
+    uint32_t metadataSize = record->metadataSize;
+    uint32_t dataSize = record->dataSize;
+    uint32_t requestId = record->requestId;
+    int metadataFormat = (record->flags & RSA_SHM_RING_RECORD_FLAG_BINARY_METADATA) != 0
+            ? RSA_SHM_METADATA_FORMAT_BINARY : RSA_SHM_METADATA_FORMAT_TEXT;
+    if (dataSize > rsaShmRing_recordCapacity(channel) || metadataSize > dataSize
+            || (metadataFormat == RSA_SHM_METADATA_FORMAT_TEXT && metadataSize != 0 && record->data[metadataSize - 1] != '\0')) {
+        celix_logHelper_error(server->loghelper, "RsaShmServer: Ring request record invalid. %u, %u.", metadataSize, dataSize);
+        rsaShmRing_release(&channel->request);
+        return rsaShmServer_writeRingResponse(ringChannel, requestId, RSA_SHM_RING_RECORD_FLAG_ABEND, NULL, 0);
+    }
+
+    celix_properties_t *metadataProps = rsaShmServer_parseMetadata(server, metadataFormat, record->data, metadataSize);
+    //Note the request is used in place, the client does not reuse the slot until it is released
+    struct iovec request = {record->data + metadataSize, dataSize - metadataSize};
+    struct iovec reply = {NULL, 0};
+    celix_status_t status = server->revCB(server->revCBHandle, server, metadataProps, &request, NULL, &reply);
+    rsaShmRing_release(&channel->request);
+    if (metadataProps != NULL) {
+        celix_properties_destroy(metadataProps);
+    }
+
+    bool written;
+    if (status != CELIX_SUCCESS || reply.iov_base == NULL || reply.iov_len == 0) {
+        celix_logHelper_error(server->loghelper, "RsaShmServer: Call receive msg callback failed. Error data:%d, %p, %zu.",
+                status, reply.iov_base, reply.iov_len);
+        written = rsaShmServer_writeRingResponse(ringChannel, requestId, RSA_SHM_RING_RECORD_FLAG_ABEND, NULL, 0);
+    } else {
+        written = rsaShmServer_writeRingResponse(ringChannel, requestId, 0, reply.iov_base, reply.iov_len);
+    }
+    free(reply.iov_base);
+    return written;
+}
+
+static void *rsaShmServer_ringChannelThread(void *data) {
+    rsa_shm_server_ring_channel_t *ringChannel = data;
+    assert(ringChannel != NULL);
+    rsa_shm_server_t *server = ringChannel->server;
+    rsa_shm_ring_channel_t *channel = ringChannel->channel;
+    while (true) {
+        rsa_shm_ring_record_t *record = NULL;
+        struct timespec deadline = celix_gettime(CLOCK_MONOTONIC);
+        deadline.tv_sec += RSA_SHM_SERVER_RING_IDLE_TIMEOUT_IN_S;
+        int ret = rsaShmRing_waitForRecord(channel, &channel->request, &ringChannel->spinBudget, &deadline, &record);
+        if (ret == ETIMEDOUT) {
+            continue;
+        } else if (ret != 0) {
+            break;//channel closed
+        }
+        if (!rsaShmServer_handleRingRequest(ringChannel, record)) {
+            //The client gave up the request, the rings are out of sync
+            break;
+        }
+    }
+    //After this the client can free the channel, so it is done with the lock held to prevent closing a detached channel
+    celixThreadMutex_lock(&server->ringChannelsMutex);
+    ringChannel->detached = true;
+    rsaShmRing_setState(channel, RSA_SHM_RING_CHANNEL_DETACHED);
+    celixThreadMutex_unlock(&server->ringChannelsMutex);
+    shmCache_releaseMemoryPtr(server->shmCache, channel);
+    __atomic_store_n(&ringChannel->finished, true, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void rsaShmServer_reapFinishedRingChannels(rsa_shm_server_t *server) {
+    celixThreadMutex_lock(&server->ringChannelsMutex);
+    for (int i = celix_arrayList_size(server->ringChannels) - 1; i >= 0; --i) {
+        rsa_shm_server_ring_channel_t *ringChannel = celix_arrayList_get(server->ringChannels, i);
+        if (__atomic_load_n(&ringChannel->finished, __ATOMIC_ACQUIRE)) {
+            celixThread_join(ringChannel->thread, NULL);
+            celix_arrayList_removeAt(server->ringChannels, i);
+            free(ringChannel);
+        }
+    }
+    celixThreadMutex_unlock(&server->ringChannelsMutex);
+}
+
+static void rsaShmServer_attachRingChannel(rsa_shm_server_t *server, const rsa_shm_msg_t *msgInfo) {
+    rsaShmServer_reapFinishedRingChannels(server);
+
+    if (msgInfo->shmId < 0 || msgInfo->ctrlDataOffset <= 0) {
+        celix_logHelper_error(server->loghelper, "RsaShmServer: Ring channel info invalid. %d, %zd.",
+                msgInfo->shmId, msgInfo->ctrlDataOffset);
+        return;
+    }
+    rsa_shm_ring_channel_t *channel = shmCache_getMemoryPtr(server->shmCache, msgInfo->shmId, msgInfo->ctrlDataOffset);
+    if (channel == NULL || !rsaShmRing_channelIsValid(channel, msgInfo->ctrlDataSize)) {
+        celix_logHelper_error(server->loghelper, "RsaShmServer: Ring channel invalid.");
+        shmCache_releaseMemoryPtr(server->shmCache, channel);
+        return;
+    }
+
+    celixThreadMutex_lock(&server->ringChannelsMutex);
+    rsa_shm_server_ring_channel_t *ringChannel = NULL;
+    if (celix_arrayList_size(server->ringChannels) < RSA_SHM_MAX_SERVER_RING_CHANNELS && !rsaShmRing_isClosed(channel)) {
+        ringChannel = calloc(1, sizeof(*ringChannel));
+    }
+    if (ringChannel != NULL) {
+        ringChannel->server = server;
+        ringChannel->shmId = msgInfo->shmId;
+        ringChannel->channel = channel;
+        ringChannel->detached = false;
+        ringChannel->finished = false;
+        rsaShmRing_setState(channel, RSA_SHM_RING_CHANNEL_ATTACHED);
+        if (celixThread_create(&ringChannel->thread, NULL, rsaShmServer_ringChannelThread, ringChannel) == CELIX_SUCCESS) {
+            celixThread_setName(&ringChannel->thread, "RsaShmRing");
+            celix_arrayList_add(server->ringChannels, ringChannel);
+            celixThreadMutex_unlock(&server->ringChannelsMutex);
+            return;
+        }
+        free(ringChannel);
+    }
+    celixThreadMutex_unlock(&server->ringChannelsMutex);
+    celix_logHelper_warning(server->loghelper, "RsaShmServer: Rejected ring channel, the client will use datagrams.");
+    rsaShmRing_setState(channel, RSA_SHM_RING_CHANNEL_REJECTED);
+    shmCache_releaseMemoryPtr(server->shmCache, channel);
+}
+
+static void rsaShmServer_shmPeerClosed(void *handle, shm_cache_t *shmCache, int shmId) {
+    (void)shmCache;//unused
+    rsa_shm_server_t *server = handle;
+    //The client process is gone, nobody reads its responses anymore
+    rsaShmServer_freeShmReplies(server, shmId);
+    celixThreadMutex_lock(&server->ringChannelsMutex);
+    int size = celix_arrayList_size(server->ringChannels);
+    for (int i = 0; i < size; ++i) {
+        rsa_shm_server_ring_channel_t *ringChannel = celix_arrayList_get(server->ringChannels, i);
+        if (ringChannel->shmId == shmId && !ringChannel->detached) {
+            //The client process is gone, let the ring channel thread detach
+            rsaShmRing_close(ringChannel->channel);
+        }
+    }
+    celixThreadMutex_unlock(&server->ringChannelsMutex);
+}
+
+static void rsaShmServer_stopRingChannels(rsa_shm_server_t *server) {
+    celixThreadMutex_lock(&server->ringChannelsMutex);
+    celix_array_list_t *ringChannels = server->ringChannels;
+    server->ringChannels = celix_arrayList_create();
+    int size = celix_arrayList_size(ringChannels);
+    for (int i = 0; i < size; ++i) {
+        rsa_shm_server_ring_channel_t *ringChannel = celix_arrayList_get(ringChannels, i);
+        if (!ringChannel->detached) {
+            rsaShmRing_close(ringChannel->channel);
+        }
+    }
+    celixThreadMutex_unlock(&server->ringChannelsMutex);
+    //Note the ring channel threads are joined without holding the lock, they need it to detach
+    for (int i = 0; i < size; ++i) {
+        rsa_shm_server_ring_channel_t *ringChannel = celix_arrayList_get(ringChannels, i);
+        celixThread_join(ringChannel->thread, NULL);
+        free(ringChannel);
+    }
+    celix_arrayList_destroy(ringChannels);
+}
+
 static void *rsaShmServer_receiveMsgThread(void *data) {
     rsa_shm_server_t *server = data;
     assert(server != NULL);
@@ -298,6 +702,12 @@ static void *rsaShmServer_receiveMsgThread(void *data) {
             celix_logHelper_error(server->loghelper, "RsaShmServer: recv msg err(%d) or recv zero-length datagrams.", errno);
             continue;
         }
+        if (revBytes >= offsetof(rsa_shm_msg_t, msgType) + sizeof(msgInfo.msgType)
+                && msgInfo.size >= offsetof(rsa_shm_msg_t, msgType) + sizeof(msgInfo.msgType)
+                && msgInfo.msgType == RSA_SHM_MSG_TYPE_RING_ATTACH) {
+            rsaShmServer_attachRingChannel(server, &msgInfo);
+            continue;
+        }
         if (revBytes <= sizeof(msgInfo.size) || rsaShmServer_msgInvalid(server, &msgInfo)) {
             celix_logHelper_error(server->loghelper,"RsaShmServer: Shm message info is invalid. It maybe cause memory leak!");
             continue;
@@ -319,11 +729,16 @@ static void *rsaShmServer_receiveMsgThread(void *data) {
         struct rsa_shm_server_thpool_work_data *workData = ( struct rsa_shm_server_thpool_work_data *)malloc(sizeof(*workData));
         assert(workData != NULL);
         workData->server = server;
+        workData->clientShmId = msgInfo.shmId;
         workData->msgCtrl = msgCtrl;
         workData->msgBody = msgBody;
         workData->msgBodyTotalSize = msgInfo.msgBodyTotalSize;
         workData->metadataSize = msgInfo.metadataSize;
         workData->requestSize = msgInfo.requestSize;
+        //Old clients do not send the metadata format, they always use text metadata
+        bool hasMetadataFormat = revBytes >= offsetof(rsa_shm_msg_t, metadataFormat) + sizeof(msgInfo.metadataFormat)
+                && msgInfo.size >= offsetof(rsa_shm_msg_t, metadataFormat) + sizeof(msgInfo.metadataFormat);
+        workData->metadataFormat = hasMetadataFormat ? msgInfo.metadataFormat : RSA_SHM_METADATA_FORMAT_TEXT;
         int retVal = thpool_add_work(server->threadPool, (void *)rsaShmServer_msgHandlingWork, (void*)workData);
         if (retVal != 0) {
             celix_logHelper_error(server->loghelper, "RsaShmServer: maybe pool thread is full, error code is %d.", retVal);
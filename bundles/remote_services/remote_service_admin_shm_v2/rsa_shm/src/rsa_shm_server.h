@@ -24,13 +24,19 @@
 extern "C" {
 #endif
 #include "shm_pool.h"
+#include "rsa_request_handler_service.h"
 #include "celix_log_helper.h"
 #include <sys/uio.h>
 
 typedef struct rsa_shm_server rsa_shm_server_t;
 
+/**
+ * @brief Callback for a received request.
+ * @param[in] allocator The allocator for the response, it can be NULL. If response->iov_base is not allocated by it, it is freed by free function.
+ */
 typedef celix_status_t (*rsaShmServer_receiveMsgCB)(void *handle, rsa_shm_server_t *server,
-        celix_properties_t *metadata, const struct iovec *request, struct iovec *response);
+        celix_properties_t *metadata, const struct iovec *request, const rsa_response_allocator_t *allocator,
+        struct iovec *response);
 
 
 celix_status_t rsaShmServer_create(celix_bundle_context_t *ctx, const char *name, celix_log_helper_t *loghelper,
@@ -256,3 +256,37 @@ TEST_F(ShmCacheTestSuite, PreEvictInactiveShmCacheBlock) {
 
 
 
+
+TEST_F(ShmCacheTestSuite, GetAndReleaseMemoryPtrOfMultipleShmBlocks) {
+    shm_cache_t *shmCache = nullptr;
+    celix_status_t status = shmCache_create(false, &shmCache);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    constexpr int poolCount = 5;
+    shm_pool_t *pools[poolCount] = {nullptr};
+    void *addrs[poolCount] = {nullptr};
+    for (int i = 0; i < poolCount; ++i) {
+        status = shmPool_create(8192, &pools[i]);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        void *mem = shmPool_malloc(pools[i], 128);
+        EXPECT_TRUE(mem != nullptr);
+        snprintf((char *)mem, 128, "pool%d", i);
+        addrs[i] = shmCache_getMemoryPtr(shmCache, shmPool_getShmId(pools[i]), shmPool_getMemoryOffset(pools[i], mem));
+        EXPECT_TRUE(addrs[i] != nullptr);
+    }
+    for (int i = 0; i < poolCount; ++i) {
+        char expected[16];
+        snprintf(expected, sizeof(expected), "pool%d", i);
+        EXPECT_STREQ(expected, (const char *)addrs[i]);
+        //release in a different order than the blocks are cached
+        shmCache_releaseMemoryPtr(shmCache, addrs[(i * 2) % poolCount]);
+    }
+    //release a pointer that is not in the cache
+    int notCached = 0;
+    shmCache_releaseMemoryPtr(shmCache, &notCached);
+
+    shmCache_destroy(shmCache);
+    for (auto pool : pools) {
+        shmPool_destroy(pool);
+    }
+}
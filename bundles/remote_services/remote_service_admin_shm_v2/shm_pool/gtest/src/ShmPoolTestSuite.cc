@@ -23,6 +23,10 @@
 #include "sys_shm_ei.h"
 #include "celix_errno.h"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
 
 class ShmPoolTestSuite : public ::testing::Test {
 public:
@@ -61,21 +65,21 @@ TEST_F(ShmPoolTestSuite, CreationFailedDueToInvalidArgument) {
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed1) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_malloc((void *)&shmPool_create, 0, nullptr);
+    celix_ei_expect_malloc((void *)&shmPool_createWithArenaCount, 0, nullptr);
     celix_status_t status = shmPool_create(10240, &shmPool);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed2) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_celixThreadMutex_create((void *)&shmPool_create, 0, CELIX_ENOMEM);
+    celix_ei_expect_celixThreadMutex_create((void *)&shmPool_createWithArenaCount, 0, CELIX_ENOMEM);
     celix_status_t status = shmPool_create(10240, &shmPool);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed3) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_shmget((void *)&shmPool_create, 0, -1);
+    celix_ei_expect_shmget((void *)&shmPool_createWithArenaCount, 0, -1);
     errno = EACCES;
     celix_status_t status = shmPool_create(10240, &shmPool);
     EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno), status);
@@ -84,7 +88,7 @@ TEST_F(ShmPoolTestSuite, CreateShmPoolFailed3) {
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed4) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_shmat((void *)&shmPool_create, 0, nullptr);
+    celix_ei_expect_shmat((void *)&shmPool_createWithArenaCount, 0, nullptr);
     errno = ENOMEM;
     celix_status_t status = shmPool_create(10240, &shmPool);
     EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno), status);
@@ -93,14 +97,14 @@ TEST_F(ShmPoolTestSuite, CreateShmPoolFailed4) {
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed5) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_celixThreadCondition_init((void *)&shmPool_create, 0, CELIX_ENOMEM);
+    celix_ei_expect_celixThreadCondition_init((void *)&shmPool_createWithArenaCount, 0, CELIX_ENOMEM);
     celix_status_t status = shmPool_create(10240, &shmPool);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed6) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_celixThread_create((void *)&shmPool_create, 0, CELIX_BUNDLE_EXCEPTION);
+    celix_ei_expect_celixThread_create((void *)&shmPool_createWithArenaCount, 0, CELIX_BUNDLE_EXCEPTION);
     celix_status_t status = shmPool_create(10240, &shmPool);
     EXPECT_EQ(CELIX_BUNDLE_EXCEPTION, status);
 }
@@ -160,3 +164,89 @@ TEST_F(ShmPoolTestSuite, FreeNullPtr) {
     shmPool_destroy(shmPool);
 }
 
+TEST_F(ShmPoolTestSuite, CreateShmPoolWithArenas) {
+    shm_pool_t *shmPool = nullptr;
+    celix_status_t status = shmPool_createWithArenaCount(4 * 8192, 4, &shmPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_LE(0, shmPool_getShmId(shmPool));
+    shmPool_destroy(shmPool);
+
+    //arenas too small
+    status = shmPool_createWithArenaCount(8192, 8, &shmPool);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+}
+
+TEST_F(ShmPoolTestSuite, CreateShmPoolWithArenasFailed) {
+    shm_pool_t *shmPool = nullptr;
+    //the mutex of the second arena
+    celix_ei_expect_celixThreadMutex_create(CELIX_EI_UNKNOWN_CALLER, 0, CELIX_ENOMEM, 3);
+    celix_status_t status = shmPool_createWithArenaCount(4 * 8192, 4, &shmPool);
+    EXPECT_EQ(CELIX_ENOMEM, status);
+}
+
+TEST_F(ShmPoolTestSuite, MallocMemoryFromOtherArenaIfArenaIsExhausted) {
+    shm_pool_t *shmPool = nullptr;
+    celix_status_t status = shmPool_createWithArenaCount(2 * 16384, 2, &shmPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    //the largest memory is limited by the arena size
+    EXPECT_TRUE(shmPool_malloc(shmPool, 16384) == nullptr);
+
+    void *addr1 = shmPool_malloc(shmPool, 6144);
+    EXPECT_TRUE(addr1 != nullptr);
+    void *addr2 = shmPool_malloc(shmPool, 6144);
+    EXPECT_TRUE(addr2 != nullptr);
+    EXPECT_TRUE(shmPool_malloc(shmPool, 6144) == nullptr);
+
+    shmPool_free(shmPool, addr1);
+    addr1 = shmPool_malloc(shmPool, 6144);
+    EXPECT_TRUE(addr1 != nullptr);
+
+    shmPool_free(shmPool, addr1);
+    shmPool_free(shmPool, addr2);
+    shmPool_destroy(shmPool);
+}
+
+TEST_F(ShmPoolTestSuite, ConcurrentlyMallocFreeMemory) {
+    shm_pool_t *shmPool = nullptr;
+    celix_status_t status = shmPool_createWithArenaCount(4 * 65536, 4, &shmPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    //Every thread frees the memory allocated by the next thread, so memory is freed to arenas used by other threads
+    constexpr int threadCount = 4;
+    constexpr int allocCount = 10000;
+    std::vector<std::unique_ptr<std::atomic<void*>[]>> allocated{};
+    for (int t = 0; t < threadCount; ++t) {
+        allocated.emplace_back(new std::atomic<void*>[allocCount]{});
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            auto& next = allocated[(t + 1) % threadCount];
+            for (int i = 0; i < allocCount; ++i) {
+                void *addr = shmPool_malloc(shmPool, 64 + i % 256);
+                EXPECT_TRUE(addr != nullptr);
+                allocated[t][i].store(addr);
+                void *nextAddr;
+                while ((nextAddr = next[i].load()) == nullptr) {
+                    std::this_thread::yield();
+                }
+                shmPool_free(shmPool, nextAddr);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    //All memory is given back, so a large memory can be allocated from each arena again
+    std::vector<void*> large{};
+    for (int i = 0; i < 4; ++i) {
+        void *addr = shmPool_malloc(shmPool, 32768);
+        EXPECT_TRUE(addr != nullptr);
+        large.push_back(addr);
+    }
+    for (auto addr : large) {
+        shmPool_free(shmPool, addr);
+    }
+    shmPool_destroy(shmPool);
+}
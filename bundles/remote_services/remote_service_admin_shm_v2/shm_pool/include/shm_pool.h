@@ -31,13 +31,28 @@ typedef struct shm_pool shm_pool_t;
 
 
 /**
- * @brief Create a shared memory pool
+ * @brief Create a shared memory pool, with a number of arenas derived from the number of CPUs and the size.
+ * @see shmPool_createWithArenaCount
  * @param[in] size Shared memory size, it should be greater than or equal to 8192
  * @param[out] pool The shared memory pool instance
  * @return @see celix_errno.h
  */
 celix_status_t shmPool_create(size_t size, shm_pool_t **pool);
 
+/**
+ * @brief Create a shared memory pool that is split in a number of arenas.
+ *
+ * Each arena has its own allocator and lock, and a thread allocates from the arena of the CPU it runs on.
+ * So concurrent allocations do not contend on a single lock. Note that the largest memory that can be allocated
+ * is limited by the size of an arena.
+ *
+ * @param[in] size Shared memory size, it should be greater than or equal to 8192 per arena
+ * @param[in] arenaCount The number of arenas. If 0, the number of arenas is derived from the number of CPUs and the size.
+ * @param[out] pool The shared memory pool instance
+ * @return @see celix_errno.h
+ */
+celix_status_t shmPool_createWithArenaCount(size_t size, unsigned int arenaCount, shm_pool_t **pool);
+
 /**
  * @brief Get the shared memory id of shared memory pool
  *
@@ -41,6 +41,7 @@ struct shm_cache{
     bool shmRdOnly;
     celix_thread_mutex_t mutex;// projects below
     celix_long_hash_map_t *shmCacheBlocks;
+    celix_array_list_t *sortedShmCacheBlocks;//The shmCacheBlocks sorted by start address, used to find the block of a memory pointer
     celix_thread_t shmWatcherThread;
     bool watcherActive;
     celix_thread_cond_t watcherStopped;
@@ -71,6 +72,8 @@ celix_status_t shmCache_create(bool shmRdOnly, shm_cache_t **shmCache) {
     }
     cache->shmCacheBlocks = celix_longHashMap_create();
     assert(cache->shmCacheBlocks != NULL);
+    cache->sortedShmCacheBlocks = celix_arrayList_create();
+    assert(cache->sortedShmCacheBlocks != NULL);
 
     status = celixThreadCondition_init(&cache->watcherStopped, NULL);
     if (status != CELIX_SUCCESS) {
@@ -91,6 +94,7 @@ celix_status_t shmCache_create(bool shmRdOnly, shm_cache_t **shmCache) {
 watcher_thread_err:
     (void)celixThreadCondition_destroy(&cache->watcherStopped);
 watcher_stopped_cond_err:
+    celix_arrayList_destroy(cache->sortedShmCacheBlocks);
     celix_longHashMap_destroy(cache->shmCacheBlocks);
     (void)celixThreadMutex_destroy(&cache->mutex);
 mutex_err:
@@ -138,6 +142,49 @@ static void shmCache_destroyBlock(shm_cache_t *shmCache, shm_cache_block_t *shmB
     return ;
 }
 
+static int shmCache_compareBlockAddr(celix_array_list_entry_t a, celix_array_list_entry_t b) {
+    const shm_cache_block_t *blockA = (const shm_cache_block_t *)a.voidPtrVal;
+    const shm_cache_block_t *blockB = (const shm_cache_block_t *)b.voidPtrVal;
+    if (blockA->shmStartAddr < blockB->shmStartAddr) {
+        return -1;
+    }
+    return blockA->shmStartAddr > blockB->shmStartAddr ? 1 : 0;
+}
+
+static void shmCache_addBlock(shm_cache_t *shmCache, shm_cache_block_t *shmBlock) {
+    celix_longHashMap_put(shmCache->shmCacheBlocks, shmBlock->shmId, shmBlock);
+    celix_arrayList_add(shmCache->sortedShmCacheBlocks, shmBlock);
+    celix_arrayList_sortEntries(shmCache->sortedShmCacheBlocks, shmCache_compareBlockAddr);
+}
+
+static void shmCache_removeBlock(shm_cache_t *shmCache, shm_cache_block_t *shmBlock) {
+    celix_longHashMap_remove(shmCache->shmCacheBlocks, shmBlock->shmId);
+    celix_arrayList_remove(shmCache->sortedShmCacheBlocks, shmBlock);
+}
+
+/**
+ * Binary search the block with the greatest start address that is not greater than ptr.
+ */
+static shm_cache_block_t *shmCache_findBlock(shm_cache_t *shmCache, void *ptr) {
+    shm_cache_block_t *found = NULL;
+    int low = 0;
+    int high = celix_arrayList_size(shmCache->sortedShmCacheBlocks) - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        shm_cache_block_t *shmBlock = celix_arrayList_get(shmCache->sortedShmCacheBlocks, mid);
+        if (shmBlock->shmStartAddr <= ptr) {
+            found = shmBlock;
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    if (found != NULL && ptr <= found->shmStartAddr + found->maxOffset) {
+        return found;
+    }
+    return NULL;
+}
+
 void * shmCache_getMemoryPtr(shm_cache_t *shmCache, int shmId, ssize_t memoryOffset) {
     void *ptr = NULL;
     if (shmCache != NULL && shmId > 0 && memoryOffset > 0) {
@@ -148,7 +195,7 @@ void * shmCache_getMemoryPtr(shm_cache_t *shmCache, int shmId, ssize_t memoryOff
         } else {
             shmBlock = shmCache_createBlock(shmCache, shmId);
             if (shmBlock != NULL) {
-                celix_longHashMap_put(shmCache->shmCacheBlocks, shmId, shmBlock);
+                shmCache_addBlock(shmCache, shmBlock);
             }
         }
 
@@ -166,15 +213,12 @@ void * shmCache_getMemoryPtr(shm_cache_t *shmCache, int shmId, ssize_t memoryOff
 void shmCache_releaseMemoryPtr(shm_cache_t *shmCache, void *ptr) {
     if (shmCache != NULL && ptr != NULL) {
         celixThreadMutex_lock(&shmCache->mutex);
-        CELIX_LONG_HASH_MAP_ITERATE(shmCache->shmCacheBlocks, iter) {
-            shm_cache_block_t *shmBlock = (shm_cache_block_t *)iter.value.ptrValue;
-            if (shmBlock->shmStartAddr <= ptr && ptr <= shmBlock->shmStartAddr + shmBlock->maxOffset ) {
-                if (shmBlock->refCnt != 0) {
-                    shmBlock->refCnt--;
-                } else {
-                    fprintf(stderr, "Shm cache: Shm block double free.\n");
-                }
-                break;
+        shm_cache_block_t *shmBlock = shmCache_findBlock(shmCache, ptr);
+        if (shmBlock != NULL) {
+            if (shmBlock->refCnt != 0) {
+                shmBlock->refCnt--;
+            } else {
+                fprintf(stderr, "Shm cache: Shm block double free.\n");
             }
         }
         celixThreadMutex_unlock(&shmCache->mutex);
@@ -197,6 +241,7 @@ void shmCache_destroy(shm_cache_t *shmCache) {
             }
             shmCache_destroyBlock(shmCache, shmBlock);
         }
+        celix_arrayList_destroy(shmCache->sortedShmCacheBlocks);
         celix_longHashMap_destroy(shmCache->shmCacheBlocks);
         celixThreadMutex_destroy(&shmCache->mutex);
         free(shmCache);
@@ -241,7 +286,7 @@ static void * shmCache_WatcherThread(void *data) {
         size_t size = celix_arrayList_size(evictedBlocks);
         for (int i = 0; i < size; ++i) {
             shm_cache_block_t *shmBlock = celix_arrayList_get(evictedBlocks, i);
-            celix_longHashMap_remove(shmCache->shmCacheBlocks, shmBlock->shmId);
+            shmCache_removeBlock(shmCache, shmBlock);
             shmCache_destroyBlock(shmCache, shmBlock);
         }
         celix_arrayList_clear(evictedBlocks);
@@ -24,11 +24,28 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
 #include <sys/ipc.h>
 #include <sys/shm.h>
+#include <sys/param.h>
 #include <errno.h>
 #include <assert.h>
 
+#define SHM_POOL_MAX_ARENA_COUNT 16
+#define SHM_POOL_MIN_ARENA_SIZE (256*1024)
+
+/**
+ * A part of the shared memory pool with its own tlsf allocator and lock.
+ * Memory that is freed while the arena is locked by another thread, is pushed on the lock-free remote free list,
+ * and it is given back to the tlsf allocator by the next thread that locks the arena.
+ */
+typedef struct shm_pool_arena {
+    celix_thread_mutex_t mutex;// projects allocator
+    tlsf_t allocator;
+    void *remoteFreeList;//Stack of freed memory, the first bytes of freed memory point to the next freed memory
+}shm_pool_arena_t;
 
 struct shm_pool{
     celix_thread_mutex_t mutex;// projects below
@@ -38,17 +55,76 @@ struct shm_pool{
     celix_thread_t shmHeartbeatThread;
     bool heartbeatThreadActive;
     celix_thread_cond_t heartbeatThreadStoped;
-    tlsf_t allocator;
+    void *arenasStartAddr;
+    size_t arenaSize;
+    unsigned int arenaCount;
+    shm_pool_arena_t *arenas;
 };
 
 static void *shmPool_heartbeatThread(void *data);
 
+static unsigned int shmPool_defaultArenaCount(size_t size) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t arenaCount = (cpus > 0) ? (size_t)cpus : 1;
+    arenaCount = MIN(arenaCount, SHM_POOL_MAX_ARENA_COUNT);
+    arenaCount = MIN(arenaCount, size / SHM_POOL_MIN_ARENA_SIZE);
+    return (unsigned int)MAX(arenaCount, 1);
+}
+
+static celix_status_t shmPool_createArenas(shm_pool_t *pool, void *mem, size_t size) {
+    celix_status_t status = CELIX_SUCCESS;
+    pool->arenas = (shm_pool_arena_t *)calloc(pool->arenaCount, sizeof(shm_pool_arena_t));
+    if (pool->arenas == NULL) {
+        return CELIX_ENOMEM;
+    }
+    pool->arenasStartAddr = mem;
+    pool->arenaSize = size / pool->arenaCount / tlsf_align_size() * tlsf_align_size();
+    unsigned int i = 0;
+    for (; i < pool->arenaCount; ++i) {
+        shm_pool_arena_t *arena = &pool->arenas[i];
+        status = celixThreadMutex_create(&arena->mutex, NULL);
+        if (status != CELIX_SUCCESS) {
+            break;
+        }
+        arena->allocator = tlsf_create_with_pool(mem + i * pool->arenaSize, pool->arenaSize);
+        if (arena->allocator == NULL) {
+            (void)celixThreadMutex_destroy(&arena->mutex);
+            status = CELIX_ILLEGAL_STATE;
+            break;
+        }
+        arena->remoteFreeList = NULL;
+    }
+    if (status != CELIX_SUCCESS) {
+        while (i-- > 0) {
+            tlsf_destroy(pool->arenas[i].allocator);
+            (void)celixThreadMutex_destroy(&pool->arenas[i].mutex);
+        }
+        free(pool->arenas);
+    }
+    return status;
+}
+
+static void shmPool_destroyArenas(shm_pool_t *pool) {
+    for (unsigned int i = 0; i < pool->arenaCount; ++i) {
+        tlsf_destroy(pool->arenas[i].allocator);
+        (void)celixThreadMutex_destroy(&pool->arenas[i].mutex);
+    }
+    free(pool->arenas);
+}
+
 celix_status_t shmPool_create(size_t size, shm_pool_t **pool) {
+    return shmPool_createWithArenaCount(size, 0, pool);
+}
+
+celix_status_t shmPool_createWithArenaCount(size_t size, unsigned int arenaCount, shm_pool_t **pool) {
     celix_status_t status = CELIX_SUCCESS;
     size_t normalizedSharedInfoSize = (sizeof(struct shm_pool_shared_info) % sizeof(void *) == 0) ?
             sizeof(struct shm_pool_shared_info) : (sizeof(struct shm_pool_shared_info)+sizeof(void *))/sizeof(void *) * sizeof(void *);
-    if (size <= tlsf_size() + normalizedSharedInfoSize || pool == NULL) {
-        fprintf(stderr,"Shm pool: Shm size should be greater than %zu.\n", tlsf_size());
+    if (arenaCount == 0) {
+        arenaCount = shmPool_defaultArenaCount(size);
+    }
+    if (size <= normalizedSharedInfoSize || (size - normalizedSharedInfoSize) / arenaCount <= tlsf_size() || pool == NULL) {
+        fprintf(stderr,"Shm pool: Shm size of each arena should be greater than %zu.\n", tlsf_size());
         status = CELIX_ILLEGAL_ARGUMENT;
         goto shm_size_invalid;
     }
@@ -85,10 +161,10 @@ celix_status_t shmPool_create(size_t size, shm_pool_t **pool) {
     shmPool->sharedInfo->size = sizeof(struct shm_pool_shared_info);
 
     void *poolMem = shmPool->shmStartAddr + normalizedSharedInfoSize;
-    shmPool->allocator = tlsf_create_with_pool(poolMem, size - normalizedSharedInfoSize);
-    if (shmPool->allocator == NULL) {
-        fprintf(stderr,"Shm pool: Error creating shm pool allocator.\n");
-        status = CELIX_ILLEGAL_STATE;
+    shmPool->arenaCount = arenaCount;
+    status = shmPool_createArenas(shmPool, poolMem, size - normalizedSharedInfoSize);
+    if (status != CELIX_SUCCESS) {
+        fprintf(stderr,"Shm pool: Error creating shm pool arenas. %d.\n", status);
         goto allocator_err;
     }
 
@@ -113,7 +189,7 @@ celix_status_t shmPool_create(size_t size, shm_pool_t **pool) {
 heartbeat_thread_err:
     (void)celixThreadCondition_destroy(&shmPool->heartbeatThreadStoped);
 stopped_cond_err:
-    tlsf_destroy(shmPool->allocator);
+    shmPool_destroyArenas(shmPool);
 allocator_err:
     (void)shmdt(shmPool->shmStartAddr);
 err_attaching_shm:
@@ -142,7 +218,7 @@ void shmPool_destroy(shm_pool_t *pool) {
         celixThreadCondition_signal(&pool->heartbeatThreadStoped);
         celixThread_join(pool->shmHeartbeatThread, NULL);
         (void)celixThreadCondition_destroy(&pool->heartbeatThreadStoped);
-        tlsf_destroy(pool->allocator);
+        shmPool_destroyArenas(pool);
         (void)shmdt(pool->shmStartAddr);
         celixThreadMutex_destroy(&pool->mutex);
         free(pool);
@@ -150,12 +226,43 @@ void shmPool_destroy(shm_pool_t *pool) {
     return ;
 }
 
+/**
+ * Give the memory of the remote free list back to the tlsf allocator. The arena should be locked.
+ */
+static void shmPool_drainRemoteFreeList(shm_pool_arena_t *arena) {
+    void *ptr = __atomic_exchange_n(&arena->remoteFreeList, NULL, __ATOMIC_ACQUIRE);
+    while (ptr != NULL) {
+        void *next = *(void **)ptr;
+        tlsf_free(arena->allocator, ptr);
+        ptr = next;
+    }
+}
+
+static unsigned int shmPool_currentArenaIndex(shm_pool_t *pool) {
+    if (pool->arenaCount == 1) {
+        return 0;
+    }
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return (unsigned int)cpu % pool->arenaCount;
+    }
+#endif
+    return (unsigned int)((uintptr_t)pthread_self() >> 8) % pool->arenaCount;
+}
+
 void *shmPool_malloc(shm_pool_t *pool, size_t size) {
     if (pool != NULL) {
         void *addr = NULL;
-        celixThreadMutex_lock(&pool->mutex);
-        addr = tlsf_malloc(pool->allocator, size);
-        celixThreadMutex_unlock(&pool->mutex);
+        unsigned int start = shmPool_currentArenaIndex(pool);
+        //Use the arena of the current CPU, and the other arenas if it is exhausted
+        for (unsigned int i = 0; i < pool->arenaCount && addr == NULL; ++i) {
+            shm_pool_arena_t *arena = &pool->arenas[(start + i) % pool->arenaCount];
+            celixThreadMutex_lock(&arena->mutex);
+            shmPool_drainRemoteFreeList(arena);
+            addr = tlsf_malloc(arena->allocator, size);
+            celixThreadMutex_unlock(&arena->mutex);
+        }
         return addr;
     }
     return NULL;
@@ -163,9 +270,20 @@ void *shmPool_malloc(shm_pool_t *pool, size_t size) {
 
 void shmPool_free(shm_pool_t *pool, void *ptr) {
     if (pool != NULL && ptr != NULL) {
-        celixThreadMutex_lock(&pool->mutex);
-        tlsf_free(pool->allocator, ptr);
-        celixThreadMutex_unlock(&pool->mutex);
+        size_t index = (size_t)(ptr - pool->arenasStartAddr) / pool->arenaSize;
+        assert(index < pool->arenaCount);
+        shm_pool_arena_t *arena = &pool->arenas[index];
+        if (pthread_mutex_trylock(&arena->mutex) == 0) {
+            shmPool_drainRemoteFreeList(arena);
+            tlsf_free(arena->allocator, ptr);
+            celixThreadMutex_unlock(&arena->mutex);
+        } else {
+            //The arena is in use, leave the memory to the thread using it
+            void *head = __atomic_load_n(&arena->remoteFreeList, __ATOMIC_RELAXED);
+            do {
+                *(void **)ptr = head;
+            } while (!__atomic_compare_exchange_n(&arena->remoteFreeList, &head, ptr, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+        }
     }
     return ;
 }
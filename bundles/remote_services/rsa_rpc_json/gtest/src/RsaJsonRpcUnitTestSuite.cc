@@ -23,6 +23,7 @@
 #include "rsa_json_rpc_endpoint_impl.h"
 #include "rsa_request_sender_service.h"
 #include "rsa_request_handler_service.h"
+#include "rsa_rpc_async_invoker_service.h"
 #include "RsaJsonRpcTestService.h"
 #include "remote_interceptor.h"
 #include "endpoint_description.h"
@@ -45,6 +46,9 @@
 #include "celix_long_hash_map_ei.h"
 #include <gtest/gtest.h>
 #include <cstdlib>
+#include <thread>
+#include <utility>
+#include <vector>
 extern "C" {
 #include "remote_interceptors_handler.h"
 }
@@ -70,6 +74,7 @@ public:
         celix_ei_expect_celix_bundle_getManifestValue(nullptr, 0, nullptr);
         celix_ei_expect_calloc(nullptr, 0, nullptr);
         celix_ei_expect_celixThreadMutex_create(nullptr, 0, 0);
+        celix_ei_expect_celixThreadCondition_init(nullptr, 0, 0);
         celix_ei_expect_celix_bundleContext_registerServiceFactoryAsync(nullptr, 0, 0);
         celix_ei_expect_celix_version_createVersionFromString(nullptr, 0, nullptr);
         celix_ei_expect_dynFunction_createClosure(nullptr, 0, 0);
@@ -272,6 +277,29 @@ TEST_F(RsaJsonRpcUnitTestSuite, CreateEndpoint) {
     rsaJsonRpc_destroy(jsonRpc);
 }
 
+TEST_F(RsaJsonRpcUnitTestSuite, CreateProxyAndEndpointWithUnsupportedSerialization) {
+    rsa_json_rpc_t *jsonRpc = nullptr;
+    celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaJsonRpc_create, 1, "1.0.0");
+    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    auto endpoint = CreateEndpointDescription();
+    celix_properties_set(endpoint->properties, CELIX_RSA_RPC_SERIALIZATION, "xml");
+    long proxySvcId = -1;
+    status = rsaJsonRpc_createProxy(jsonRpc, endpoint, 101/*set a dummy service id*/, &proxySvcId);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    EXPECT_EQ(-1, proxySvcId);
+
+    long requestHandlerSvcId = -1;
+    status = rsaJsonRpc_createEndpoint(jsonRpc, endpoint, &requestHandlerSvcId);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    EXPECT_EQ(-1, requestHandlerSvcId);
+
+    endpointDescription_destroy(endpoint);
+
+    rsaJsonRpc_destroy(jsonRpc);
+}
+
 TEST_F(RsaJsonRpcUnitTestSuite, CreateRpcEndpointWithInvalidParams) {
     rsa_json_rpc_t *jsonRpc = nullptr;
     celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaJsonRpc_create, 1, "1.0.0");
@@ -341,6 +369,7 @@ public:
             response->iov_len = 2;
             return CELIX_SUCCESS;
         };
+        reqSenderSvc.sendRequestAsync = nullptr;
         celix_service_registration_options_t opts{};
         opts.serviceName = RSA_REQUEST_SENDER_SERVICE_NAME;
         opts.serviceVersion = RSA_REQUEST_SENDER_SERVICE_VERSION;
@@ -446,6 +475,48 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToRegisterProxyService) {
     endpointDescription_destroy(endpoint);
 }
 
+TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToCreateProxyFactoryMutex) {
+    auto endpoint = CreateEndpointDescription();
+    long svcId = -1L;
+    celix_ei_expect_celixThreadMutex_create((void*)&rsaJsonRpcProxy_factoryCreate, 0, CELIX_ENOMEM);
+    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, reqSenderSvcId, &svcId);
+    EXPECT_EQ(CELIX_ENOMEM, status);
+
+    endpointDescription_destroy(endpoint);
+}
+
+TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToCreateProxyFactoryCondition) {
+    auto endpoint = CreateEndpointDescription();
+    long svcId = -1L;
+    celix_ei_expect_celixThreadCondition_init((void*)&rsaJsonRpcProxy_factoryCreate, 0, CELIX_ENOMEM);
+    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, reqSenderSvcId, &svcId);
+    EXPECT_EQ(CELIX_ENOMEM, status);
+
+    endpointDescription_destroy(endpoint);
+}
+
+TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToRegisterAsyncInvokerService) {
+    auto endpoint = CreateEndpointDescription();
+    long proxySvcId = -1L;
+    //The proxy service is still usable without the async invoker service
+    celix_ei_expect_celix_bundleContext_registerServiceFactoryAsync((void*)&rsaJsonRpcProxy_factoryCreate, 0, -1, 2);
+    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, reqSenderSvcId, &proxySvcId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    endpointDescription_destroy(endpoint);
+    celix_bundleContext_waitForEvents(ctx.get());
+
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_JSON_TEST_SERVICE, nullptr, [](void *handle, void *svc) {
+        (void)handle;//unused
+        auto proxySvc = static_cast<rsa_rpc_json_test_service_t*>(svc);
+        EXPECT_EQ(CELIX_SUCCESS, proxySvc->test(proxySvc->handle));
+    });
+    EXPECT_TRUE(found);
+    found = celix_bundleContext_findService(ctx.get(), RSA_RPC_ASYNC_INVOKER_SERVICE_NAME) >= 0;
+    EXPECT_FALSE(found);
+
+    rsaJsonRpc_destroyProxy(jsonRpc.get(), proxySvcId);
+}
+
 TEST_F(RsaJsonRpcProxyUnitTestSuite2, CallProxyService) {
     auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_JSON_TEST_SERVICE, nullptr, [](void *handle, void *svc) {
         (void)handle;//unused
@@ -609,6 +680,75 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite2, RemoteServiceReturnsError) {
     EXPECT_TRUE(found);
 }
 
+TEST_F(RsaJsonRpcProxyUnitTestSuite, CallProxyServiceWithBinarySerialization) {
+    auto endpoint = CreateEndpointDescription();
+    celix_properties_set(endpoint->properties, CELIX_RSA_RPC_SERIALIZATION, CELIX_RSA_RPC_SERIALIZATION_BINARY);
+    long proxySvcId = -1L;
+    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, reqSenderSvcId, &proxySvcId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    endpointDescription_destroy(endpoint);
+    celix_bundleContext_waitForEvents(ctx.get());//wait for proxy service registration
+
+    reqSenderSvc.sendRequest = [](void *handle, const endpoint_description_t *endpointDesc, celix_properties_t *metadata, const struct iovec *request, struct iovec *response) -> celix_status_t {
+        (void)handle;//unused
+        (void)endpointDesc;//unused
+        (void)metadata;//unused
+        //binary request: header followed by the method id
+        EXPECT_EQ(9, request->iov_len);
+        EXPECT_EQ(0, memcmp(request->iov_base, "CXB1test", 9));
+        static const char reply[] = {'C', 'X', 'B', '1', 0/*no result*/};
+        response->iov_base = malloc(sizeof(reply));
+        memcpy(response->iov_base, reply, sizeof(reply));
+        response->iov_len = sizeof(reply);
+        return CELIX_SUCCESS;
+    };
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_JSON_TEST_SERVICE, nullptr, [](void *handle, void *svc) {
+        (void)handle;//unused
+        auto proxySvc = static_cast<rsa_rpc_json_test_service_t*>(svc);
+        EXPECT_NE(nullptr, proxySvc);
+        EXPECT_EQ(CELIX_SUCCESS, proxySvc->test(proxySvc->handle));
+    });
+    EXPECT_TRUE(found);
+
+    //remote service returns an error
+    reqSenderSvc.sendRequest = [](void *handle, const endpoint_description_t *endpointDesc, celix_properties_t *metadata, const struct iovec *request, struct iovec *response) -> celix_status_t {
+        (void)handle;//unused
+        (void)endpointDesc;//unused
+        (void)metadata;//unused
+        (void)request;//unused
+        static const unsigned char reply[] = {'C', 'X', 'B', '1', 2/*error*/, 0x73, 0x11, 0x01, 0x00/*70003*/};
+        response->iov_base = malloc(sizeof(reply));
+        memcpy(response->iov_base, reply, sizeof(reply));
+        response->iov_len = sizeof(reply);
+        return CELIX_SUCCESS;
+    };
+    found = celix_bundleContext_useService(ctx.get(), RSA_RPC_JSON_TEST_SERVICE, nullptr, [](void *handle, void *svc) {
+        (void)handle;//unused
+        auto proxySvc = static_cast<rsa_rpc_json_test_service_t*>(svc);
+        EXPECT_EQ(70003, proxySvc->test(proxySvc->handle));
+    });
+    EXPECT_TRUE(found);
+
+    //json reply is rejected
+    reqSenderSvc.sendRequest = [](void *handle, const endpoint_description_t *endpointDesc, celix_properties_t *metadata, const struct iovec *request, struct iovec *response) -> celix_status_t {
+        (void)handle;//unused
+        (void)endpointDesc;//unused
+        (void)metadata;//unused
+        (void)request;//unused
+        response->iov_base = strdup("{}");
+        response->iov_len = 3;
+        return CELIX_SUCCESS;
+    };
+    found = celix_bundleContext_useService(ctx.get(), RSA_RPC_JSON_TEST_SERVICE, nullptr, [](void *handle, void *svc) {
+        (void)handle;//unused
+        auto proxySvc = static_cast<rsa_rpc_json_test_service_t*>(svc);
+        EXPECT_EQ(CELIX_SERVICE_EXCEPTION, proxySvc->test(proxySvc->handle));
+    });
+    EXPECT_TRUE(found);
+
+    rsaJsonRpc_destroyProxy(jsonRpc.get(), proxySvcId);
+}
+
 TEST_F(RsaJsonRpcProxyUnitTestSuite2, ServiceInvocationIsIntercepted) {
     static remote_interceptor_t interceptor{};
     interceptor.preProxyCall = [](void *handle, const celix_properties_t *svcProperties, const char *functionName, celix_properties_t *metadata) -> bool {
@@ -644,6 +784,127 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite2, ServiceInvocationIsIntercepted) {
     celix_bundleContext_unregisterServiceAsync(ctx.get(), interceptorSvcId, nullptr, nullptr);
 }
 
+struct rsa_json_rpc_async_test_call {
+    bool completed{false};
+    celix_status_t status{CELIX_SUCCESS};
+};
+
+static void asyncTestCallCompleted(void *data, celix_status_t status) {
+    auto call = static_cast<rsa_json_rpc_async_test_call*>(data);
+    EXPECT_FALSE(call->completed);
+    call->completed = true;
+    call->status = status;
+}
+
+TEST_F(RsaJsonRpcProxyUnitTestSuite2, InvokeAsyncWithSynchronousRequestSender) {
+    celix_service_use_options_t opts{};
+    opts.filter.serviceName = RSA_RPC_ASYNC_INVOKER_SERVICE_NAME;
+    opts.filter.filter = "(" RSA_RPC_ASYNC_INVOKER_REMOTE_SERVICE_NAME "=" RSA_RPC_JSON_TEST_SERVICE ")";
+    opts.use = [](void *handle, void *svc) {
+        (void)handle;//unused
+        auto invoker = static_cast<rsa_rpc_async_invoker_service_t*>(svc);
+        void *svcHandle = nullptr;
+        void *args[] = {&svcHandle};
+        rsa_json_rpc_async_test_call call{};
+        //The request sender has no sendRequestAsync, so the call is completed before invokeAsync returns
+        EXPECT_EQ(CELIX_SUCCESS, invoker->invokeAsync(invoker->handle, "test", args, asyncTestCallCompleted, &call));
+        EXPECT_TRUE(call.completed);
+        EXPECT_EQ(CELIX_SUCCESS, call.status);
+    };
+    auto found = celix_bundleContext_useServiceWithOptions(ctx.get(), &opts);
+    EXPECT_TRUE(found);
+}
+
+static std::vector<std::pair<rsa_request_sender_completion_fp, void*>> pendingRequests{};
+
+TEST_F(RsaJsonRpcProxyUnitTestSuite2, InvokeAsyncPipelined) {
+    reqSenderSvc.sendRequestAsync = [](void *handle, const endpoint_description_t *endpointDesc, celix_properties_t *metadata,
+            const struct iovec *request, rsa_request_sender_completion_fp completion, void *completionData) -> celix_status_t {
+        (void)handle;//unused
+        (void)endpointDesc;//unused
+        EXPECT_NE(nullptr, metadata);
+        EXPECT_NE(nullptr, request->iov_base);
+        pendingRequests.emplace_back(completion, completionData);
+        return CELIX_SUCCESS;
+    };
+
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_ASYNC_INVOKER_SERVICE_NAME, nullptr, [](void *handle, void *svc) {
+        (void)handle;//unused
+        auto invoker = static_cast<rsa_rpc_async_invoker_service_t*>(svc);
+        void *svcHandle = nullptr;
+        void *args[] = {&svcHandle};
+        rsa_json_rpc_async_test_call calls[8]{};
+        for (auto& call : calls) {
+            EXPECT_EQ(CELIX_SUCCESS, invoker->invokeAsync(invoker->handle, "test", args, asyncTestCallCompleted, &call));
+            EXPECT_FALSE(call.completed);
+        }
+        EXPECT_EQ(8, pendingRequests.size());
+
+        //complete the requests out of order from another thread
+        std::thread completer{[]{
+            for (auto it = pendingRequests.rbegin(); it != pendingRequests.rend(); ++it) {
+                struct iovec response{strdup("{}"), 3};
+                it->first(it->second, CELIX_SUCCESS, &response);
+            }
+            pendingRequests.clear();
+        }};
+        completer.join();
+        for (auto& call : calls) {
+            EXPECT_TRUE(call.completed);
+            EXPECT_EQ(CELIX_SUCCESS, call.status);
+        }
+
+        EXPECT_EQ(CELIX_SUCCESS, invoker->invokeAsync(invoker->handle, "test", args, asyncTestCallCompleted, &calls[0]));
+        EXPECT_EQ(1, pendingRequests.size());
+        calls[0].completed = false;
+        pendingRequests[0].first(pendingRequests[0].second, CELIX_ILLEGAL_STATE, nullptr);
+        pendingRequests.clear();
+        EXPECT_TRUE(calls[0].completed);
+        EXPECT_EQ(CELIX_ILLEGAL_STATE, calls[0].status);
+    });
+    EXPECT_TRUE(found);
+}
+
+TEST_F(RsaJsonRpcProxyUnitTestSuite2, FailedToSendAsyncRequest) {
+    reqSenderSvc.sendRequestAsync = [](void *handle, const endpoint_description_t *endpointDesc, celix_properties_t *metadata,
+            const struct iovec *request, rsa_request_sender_completion_fp completion, void *completionData) -> celix_status_t {
+        (void)handle;//unused
+        (void)endpointDesc;//unused
+        (void)metadata;//unused
+        (void)request;//unused
+        (void)completion;//unused
+        (void)completionData;//unused
+        return CELIX_ILLEGAL_STATE;
+    };
+
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_ASYNC_INVOKER_SERVICE_NAME, nullptr, [](void *handle, void *svc) {
+        (void)handle;//unused
+        auto invoker = static_cast<rsa_rpc_async_invoker_service_t*>(svc);
+        void *svcHandle = nullptr;
+        void *args[] = {&svcHandle};
+        rsa_json_rpc_async_test_call call{};
+        EXPECT_EQ(CELIX_ILLEGAL_STATE, invoker->invokeAsync(invoker->handle, "test", args, asyncTestCallCompleted, &call));
+        EXPECT_FALSE(call.completed);
+    });
+    EXPECT_TRUE(found);
+}
+
+TEST_F(RsaJsonRpcProxyUnitTestSuite2, InvokeAsyncWithInvalidParams) {
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_ASYNC_INVOKER_SERVICE_NAME, nullptr, [](void *handle, void *svc) {
+        (void)handle;//unused
+        auto invoker = static_cast<rsa_rpc_async_invoker_service_t*>(svc);
+        void *svcHandle = nullptr;
+        void *args[] = {&svcHandle};
+        rsa_json_rpc_async_test_call call{};
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, invoker->invokeAsync(invoker->handle, "test", args, nullptr, &call));
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, invoker->invokeAsync(invoker->handle, nullptr, args, asyncTestCallCompleted, &call));
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, invoker->invokeAsync(invoker->handle, "test", nullptr, asyncTestCallCompleted, &call));
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, invoker->invokeAsync(invoker->handle, "unknown", args, asyncTestCallCompleted, &call));
+        EXPECT_FALSE(call.completed);
+    });
+    EXPECT_TRUE(found);
+}
+
 class RsaJsonRpcEndPointUnitTestSuite : public RsaJsonRpcUnitTestSuite {
 public:
     RsaJsonRpcEndPointUnitTestSuite() {
@@ -757,6 +1018,104 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, UseRequestHandler) {
     endpointDescription_destroy(endpoint);
 }
 
+TEST_F(RsaJsonRpcEndPointUnitTestSuite, UseRequestHandlerWithBinarySerialization) {
+    auto endpoint = CreateEndpointDescription(rpcTestSvcId);
+    celix_properties_set(endpoint->properties, CELIX_RSA_RPC_SERIALIZATION, CELIX_RSA_RPC_SERIALIZATION_BINARY);
+    long svcId = -1L;
+    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &svcId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
+
+    //binary endpoints use their own serialization protocol id
+    unsigned int serialProtoId = GenerateSerialProtoId() + celix_utils_stringHash(CELIX_RSA_RPC_SERIALIZATION_BINARY);
+    celix_properties_t *metadata = celix_properties_create();
+    celix_properties_setLong(metadata, "SerialProtocolId", serialProtoId);
+
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_REQUEST_HANDLER_SERVICE_NAME, metadata, [](void *handle, void *svc) {
+        celix_properties_t *metadata = static_cast< celix_properties_t *>(handle);
+        auto reqHandler = static_cast<rsa_request_handler_service_t*>(svc);
+        EXPECT_NE(nullptr, reqHandler);
+        struct iovec request{};
+        request.iov_base =  (char *)"CXB1test";
+        request.iov_len = 9;
+        struct iovec reply{nullptr,0};
+        EXPECT_EQ(CELIX_SUCCESS, reqHandler->handleRequest(reqHandler->handle, metadata, &request, &reply));
+        EXPECT_EQ(5, reply.iov_len);
+        EXPECT_EQ(0, memcmp(reply.iov_base, "CXB1", 5));
+        free(reply.iov_base);
+
+        //json request is rejected
+        request.iov_base =  (char *)"{\n    \"m\": \"test\",\n    \"a\": []\n}";
+        request.iov_len = strlen((char*)request.iov_base);
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, reqHandler->handleRequest(reqHandler->handle, metadata, &request, &reply));
+
+        //json serialization protocol id is rejected
+        request.iov_base =  (char *)"CXB1test";
+        request.iov_len = 9;
+        celix_properties_setLong(metadata, "SerialProtocolId", celix_properties_getAsLong(metadata, "SerialProtocolId", 0) - celix_utils_stringHash(CELIX_RSA_RPC_SERIALIZATION_BINARY));
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, reqHandler->handleRequest(reqHandler->handle, metadata, &request, &reply));
+    });
+    EXPECT_TRUE(found);
+
+    celix_properties_destroy(metadata);
+
+    rsaJsonRpc_destroyEndpoint(jsonRpc.get(), svcId);
+    endpointDescription_destroy(endpoint);
+}
+
+TEST_F(RsaJsonRpcEndPointUnitTestSuite, UseRequestHandlerWithAllocator) {
+    auto endpoint = CreateEndpointDescription(rpcTestSvcId);
+    long svcId = -1L;
+    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &svcId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
+
+    unsigned int serialProtoId = GenerateSerialProtoId();
+    celix_properties_t *metadata = celix_properties_create();
+    celix_properties_setLong(metadata, "SerialProtocolId", serialProtoId);
+
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_REQUEST_HANDLER_SERVICE_NAME, metadata, [](void *handle, void *svc) {
+        celix_properties_t *metadata = static_cast< celix_properties_t *>(handle);
+        auto reqHandler = static_cast<rsa_request_handler_service_t*>(svc);
+        ASSERT_NE(nullptr, reqHandler);
+        ASSERT_NE(nullptr, reqHandler->handleRequestWithAllocator);
+        struct iovec request{};
+        request.iov_base =  (char *)"{\n    \"m\": \"test\",\n    \"a\": []\n}";
+        request.iov_len = strlen((char*)request.iov_base);
+
+        static char buffer[128];
+        rsa_response_allocator_t allocator{};
+        allocator.handle = buffer;
+        allocator.allocate = [](void *handle, size_t size) -> void* {
+            return size <= sizeof(buffer) ? handle : nullptr;
+        };
+        allocator.deallocate = [](void *, void *) {};
+        struct iovec reply{nullptr,0};
+        EXPECT_EQ(CELIX_SUCCESS, reqHandler->handleRequestWithAllocator(reqHandler->handle, metadata, &request, &allocator, &reply));
+        //The response is written in the memory of the allocator
+        EXPECT_EQ(buffer, reply.iov_base);
+        EXPECT_EQ(strlen(buffer) + 1, reply.iov_len);
+
+        //Fall back to malloc if the allocator can not provide the memory
+        allocator.allocate = [](void *, size_t) -> void* {
+            return nullptr;
+        };
+        reply = {nullptr, 0};
+        EXPECT_EQ(CELIX_SUCCESS, reqHandler->handleRequestWithAllocator(reqHandler->handle, metadata, &request, &allocator, &reply));
+        EXPECT_NE(nullptr, reply.iov_base);
+        EXPECT_NE(buffer, reply.iov_base);
+        free(reply.iov_base);
+    });
+    EXPECT_TRUE(found);
+
+    celix_properties_destroy(metadata);
+
+    rsaJsonRpc_destroyEndpoint(jsonRpc.get(), svcId);
+    endpointDescription_destroy(endpoint);
+}
+
 TEST_F(RsaJsonRpcEndPointUnitTestSuite, FailedToFindInterfaceDescriptor) {
     setenv("CELIX_FRAMEWORK_EXTENDER_PATH", RESOURCES_DIR"/non-exist", true);
     auto endpoint = CreateEndpointDescription(rpcTestSvcId);
@@ -145,3 +145,64 @@ TEST_F(RsaRequestSenderTrackerUnitTestSuite, UseNoExistService) {
 }
 
 
+
+TEST_F(RsaRequestSenderTrackerUnitTestSuite, UseServiceWithAsyncRequestSupport) {
+    static rsa_request_sender_service_t asyncReqSenderSvc{};
+    asyncReqSenderSvc.sendRequestAsync = [](void *handle, const endpoint_description_t *endpointDesc, celix_properties_t *metadata,
+            const struct iovec *request, rsa_request_sender_completion_fp completion, void *completionData) -> celix_status_t {
+        (void)handle;//unused
+        (void)endpointDesc;//unused
+        (void)metadata;//unused
+        (void)request;//unused
+        completion(completionData, CELIX_SUCCESS, nullptr);
+        return CELIX_SUCCESS;
+    };
+    celix_service_registration_options_t opts{};
+    opts.serviceName = RSA_REQUEST_SENDER_SERVICE_NAME;
+    opts.serviceVersion = RSA_REQUEST_SENDER_SERVICE_VERSION;
+    opts.svc = &asyncReqSenderSvc;
+    long svcId = celix_bundleContext_registerServiceWithOptions(ctx.get(), &opts);
+    EXPECT_NE(-1, svcId);
+
+    rsa_request_sender_tracker_t *tracker = nullptr;
+    auto status = rsaRequestSenderTracker_create(ctx.get(), logHelper.get(),&tracker);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    celix_bundleContext_waitForEvents(ctx.get());
+
+    status = rsaRequestSenderTracker_useService(tracker, svcId, nullptr, [](void *handle, rsa_request_sender_service_t *svc) -> celix_status_t {
+        (void)handle;//unused
+        EXPECT_EQ(asyncReqSenderSvc.sendRequestAsync, svc->sendRequestAsync);
+        return CELIX_SUCCESS;
+    });
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    rsaRequestSenderTracker_destroy(tracker);
+    celix_bundleContext_unregisterService(ctx.get(), svcId);
+}
+
+TEST_F(RsaRequestSenderTrackerUnitTestSuite, UseServiceOlderThanAsyncRequestSupport) {
+    //A service of version 1.0.0 has no sendRequestAsync, so the tracker must not read it
+    static rsa_request_sender_service_t legacyReqSenderSvc{};
+    legacyReqSenderSvc.sendRequestAsync = (decltype(legacyReqSenderSvc.sendRequestAsync))0x1234;//set a dummy pointer
+    celix_service_registration_options_t opts{};
+    opts.serviceName = RSA_REQUEST_SENDER_SERVICE_NAME;
+    opts.serviceVersion = "1.0.0";
+    opts.svc = &legacyReqSenderSvc;
+    long svcId = celix_bundleContext_registerServiceWithOptions(ctx.get(), &opts);
+    EXPECT_NE(-1, svcId);
+
+    rsa_request_sender_tracker_t *tracker = nullptr;
+    auto status = rsaRequestSenderTracker_create(ctx.get(), logHelper.get(),&tracker);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    celix_bundleContext_waitForEvents(ctx.get());
+
+    status = rsaRequestSenderTracker_useService(tracker, svcId, nullptr, [](void *handle, rsa_request_sender_service_t *svc) -> celix_status_t {
+        (void)handle;//unused
+        EXPECT_EQ(nullptr, svc->sendRequestAsync);
+        return CELIX_SUCCESS;
+    });
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    rsaRequestSenderTracker_destroy(tracker);
+    celix_bundleContext_unregisterService(ctx.get(), svcId);
+}
@@ -23,6 +23,7 @@
 #include "endpoint_description.h"
 #include "dfi_utils.h"
 #include "json_rpc.h"
+#include "binary_rpc.h"
 #include "celix_threads.h"
 #include "celix_constants.h"
 #include <sys/uio.h>
@@ -35,6 +36,7 @@ struct rsa_json_rpc_endpoint {
     FILE *callsLogFile;
     endpoint_description_t *endpointDesc;
     unsigned int serialProtoId;
+    bool binarySerialization;
     remote_interceptors_handler_t *interceptorsHandler;
     rsa_request_handler_service_t reqHandlerSvc;
     long reqHandlerSvcId;
@@ -51,10 +53,12 @@ static void rsaJsonRpcEndpoint_removeSvcWithOwner(void *handle, void *service,
         const celix_properties_t *props, const celix_bundle_t *svcOwner);
 static celix_status_t rsaJsonRpcEndpoint_handleRequest(void *handle, celix_properties_t *metadata,
         const struct iovec *request, struct iovec *responseOut);
+static celix_status_t rsaJsonRpcEndpoint_handleRequestWithAllocator(void *handle, celix_properties_t *metadata,
+        const struct iovec *request, const rsa_response_allocator_t *allocator, struct iovec *responseOut);
 
 celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
         FILE *logFile, remote_interceptors_handler_t *interceptorsHandler,
-        const endpoint_description_t *endpointDesc, unsigned int serialProtoId,
+        const endpoint_description_t *endpointDesc, unsigned int serialProtoId, bool binarySerialization,
         rsa_json_rpc_endpoint_t **endpointOut) {
     assert(ctx != NULL);
     assert(logHelper != NULL);
@@ -70,6 +74,7 @@ celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_
     endpoint->logHelper = logHelper;
     endpoint->callsLogFile = logFile;
     endpoint->serialProtoId = serialProtoId;
+    endpoint->binarySerialization = binarySerialization;
     endpoint->endpointDesc = endpointDescription_clone(endpointDesc);
     if (endpoint->endpointDesc == NULL) {
         celix_logHelper_error(logHelper, "RSA json rpc endpoint: Error cloning endpoint description for %s.",
@@ -104,6 +109,7 @@ celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_
 
     endpoint->reqHandlerSvc.handle = endpoint;
     endpoint->reqHandlerSvc.handleRequest = rsaJsonRpcEndpoint_handleRequest;
+    endpoint->reqHandlerSvc.handleRequestWithAllocator = rsaJsonRpcEndpoint_handleRequestWithAllocator;
     celix_service_registration_options_t opts1 = CELIX_EMPTY_SERVICE_REGISTRATION_OPTIONS;
     opts1.serviceName = RSA_REQUEST_HANDLER_SERVICE_NAME;
     opts1.serviceVersion = RSA_REQUEST_HANDLER_SERVICE_VERSION;
@@ -231,6 +237,11 @@ static void rsaJsonRpcEndpoint_removeSvcWithOwner(void *handle, void *service,
 
 static celix_status_t rsaJsonRpcEndpoint_handleRequest(void *handle, celix_properties_t *metadata,
         const struct iovec *request, struct iovec *responseOut) {
+    return rsaJsonRpcEndpoint_handleRequestWithAllocator(handle, metadata, request, NULL, responseOut);
+}
+
+static celix_status_t rsaJsonRpcEndpoint_handleRequestWithAllocator(void *handle, celix_properties_t *metadata,
+        const struct iovec *request, const rsa_response_allocator_t *allocator, struct iovec *responseOut) {
     celix_status_t status = CELIX_SUCCESS;
     if (handle == NULL || request == NULL || request->iov_base == NULL
             || request->iov_len == 0 || responseOut == NULL || metadata == NULL) {
@@ -246,28 +257,45 @@ static celix_status_t rsaJsonRpcEndpoint_handleRequest(void *handle, celix_prope
         return CELIX_ILLEGAL_ARGUMENT;
     }
 
-    json_error_t error;
-    json_t *jsRequest = json_loads((char *)request->iov_base, 0, &error);
-    if (jsRequest == NULL) {
-        status = CELIX_ILLEGAL_ARGUMENT;
-        celix_logHelper_error(endpoint->logHelper, "Parse request json string failed for %s.", (char *)request->iov_base);
-        goto request_err;
-    }
+    json_t *jsRequest = NULL;
     const char *sig;
-    int rc = json_unpack(jsRequest, "{s:s}", "m", &sig);
-    if (rc != 0) {
-        status = CELIX_ILLEGAL_ARGUMENT;
-        celix_logHelper_error(endpoint->logHelper, "Error requesting method for %s.", (char *)request->iov_base);
-        goto request_method_err;
+    if (endpoint->binarySerialization) {
+        if (binaryRpc_getMethodId(request->iov_base, request->iov_len, &sig) != 0) {
+            celix_logHelper_error(endpoint->logHelper, "Error requesting method from binary request for %s.",
+                                  endpoint->endpointDesc->serviceName);
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+    } else {
+        json_error_t error;
+        jsRequest = json_loads((char *)request->iov_base, 0, &error);
+        if (jsRequest == NULL) {
+            status = CELIX_ILLEGAL_ARGUMENT;
+            celix_logHelper_error(endpoint->logHelper, "Parse request json string failed for %s.", (char *)request->iov_base);
+            goto request_err;
+        }
+        int rc = json_unpack(jsRequest, "{s:s}", "m", &sig);
+        if (rc != 0) {
+            status = CELIX_ILLEGAL_ARGUMENT;
+            celix_logHelper_error(endpoint->logHelper, "Error requesting method for %s.", (char *)request->iov_base);
+            goto request_method_err;
+        }
     }
 
     char *szResponse = NULL;
+    size_t responseSize = 0;
     bool cont = remoteInterceptorHandler_invokePreExportCall(endpoint->interceptorsHandler,
             endpoint->endpointDesc->properties, sig, &metadata);
     if (cont) {
     	celixThreadRwlock_readLock(&endpoint->lock);
         if (endpoint->service != NULL) {
-            int rc1 = jsonRpc_call(endpoint->intfType, endpoint->service, (char *)request->iov_base, &szResponse);
+            int rc1;
+            if (endpoint->binarySerialization) {
+                rc1 = binaryRpc_call(endpoint->intfType, endpoint->service, request->iov_base, request->iov_len,
+                                     (void **)&szResponse, &responseSize);
+            } else {
+                rc1 = jsonRpc_call(endpoint->intfType, endpoint->service, (char *)request->iov_base, &szResponse);
+                responseSize = (szResponse != NULL) ? strlen(szResponse) + 1 : 0;// make it include '\0'
+            }
             status = (rc1 != 0) ? CELIX_SERVICE_EXCEPTION : CELIX_SUCCESS;
         } else {
             status = CELIX_ILLEGAL_STATE;
@@ -282,17 +310,29 @@ static celix_status_t rsaJsonRpcEndpoint_handleRequest(void *handle, celix_prope
         status = CELIX_INTERCEPTOR_EXCEPTION;
     }
 
-    if (szResponse != NULL) {
-        responseOut->iov_base = szResponse;
-        responseOut->iov_len = strlen(szResponse) + 1;// make it include '\0'
-    }
-
     if (endpoint->callsLogFile != NULL) {
-        fprintf(endpoint->callsLogFile, "ENDPOINT REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n",
-                endpoint->endpointDesc->serviceName, endpoint->endpointDesc->serviceId, (char *)request->iov_base, szResponse, status);
+        if (endpoint->binarySerialization) {
+            fprintf(endpoint->callsLogFile, "ENDPOINT REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\trequest_payload=<binary, %zu bytes>\n\trequest_response=<binary, %zu bytes>\n\tstatus=%i\n",
+                    endpoint->endpointDesc->serviceName, endpoint->endpointDesc->serviceId, request->iov_len, responseSize, status);
+        } else {
+            fprintf(endpoint->callsLogFile, "ENDPOINT REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n",
+                    endpoint->endpointDesc->serviceName, endpoint->endpointDesc->serviceId, (char *)request->iov_base, szResponse, status);
+        }
         fflush(endpoint->callsLogFile);
     }
 
+    if (szResponse != NULL) {
+        void *allocatedResponse = (allocator != NULL) ? allocator->allocate(allocator->handle, responseSize) : NULL;
+        if (allocatedResponse != NULL) {
+            memcpy(allocatedResponse, szResponse, responseSize);
+            free(szResponse);
+            responseOut->iov_base = allocatedResponse;
+        } else {
+            responseOut->iov_base = szResponse;
+        }
+        responseOut->iov_len = responseSize;
+    }
+
     json_decref(jsRequest);
 
     return status;
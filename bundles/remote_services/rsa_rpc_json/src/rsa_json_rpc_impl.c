@@ -23,6 +23,7 @@
 #include "rsa_json_rpc_proxy_impl.h"
 #include "remote_interceptors_handler.h"
 #include "endpoint_description.h"
+#include "remote_constants.h"
 #include "celix_long_hash_map.h"
 #include "celix_log_helper.h"
 #include "dyn_interface.h"
@@ -32,6 +33,7 @@
 #include "celix_utils.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -45,6 +47,7 @@ struct rsa_json_rpc {
     remote_interceptors_handler_t *interceptorsHandler;
     rsa_request_sender_tracker_t *reqSenderTracker;
     unsigned int serialProtoId; //Serialization protocol ID
+    unsigned int binarySerialProtoId; //Serialization protocol ID of the binary serialization
     FILE *callsLogFile;
 };
 
@@ -63,6 +66,22 @@ static unsigned int rsaJsonRpc_generateSerialProtoId(celix_bundle_t *bnd) {
     return celix_utils_stringHash(bundleSymName) + major;
 }
 
+static celix_status_t rsaJsonRpc_getSerialization(rsa_json_rpc_t *jsonRpc, const endpoint_description_t *endpointDesc,
+        bool *binarySerialization) {
+    const char *serialization = celix_properties_get(endpointDesc->properties, CELIX_RSA_RPC_SERIALIZATION,
+                                                     CELIX_RSA_RPC_SERIALIZATION_JSON);
+    if (strcmp(serialization, CELIX_RSA_RPC_SERIALIZATION_JSON) == 0) {
+        *binarySerialization = false;
+    } else if (strcmp(serialization, CELIX_RSA_RPC_SERIALIZATION_BINARY) == 0) {
+        *binarySerialization = true;
+    } else {
+        celix_logHelper_error(jsonRpc->logHelper, "Unsupported rpc serialization %s for %s.", serialization,
+                              endpointDesc->serviceName);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    return CELIX_SUCCESS;
+}
+
 celix_status_t rsaJsonRpc_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
         rsa_json_rpc_t **jsonRpcOut) {
     celix_status_t status = CELIX_SUCCESS;
@@ -83,6 +102,8 @@ celix_status_t rsaJsonRpc_create(celix_bundle_context_t* ctx, celix_log_helper_t
         status = CELIX_BUNDLE_EXCEPTION;
         goto protocol_id_err;
     }
+    //A proxy and an endpoint only talk to each other if they use the same serialization
+    rpc->binarySerialProtoId = rpc->serialProtoId + celix_utils_stringHash(CELIX_RSA_RPC_SERIALIZATION_BINARY);
     status = celixThreadMutex_create(&rpc->mutex, NULL);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(logHelper, "Error creating endpoint mutex. %d.", status);
@@ -158,10 +179,18 @@ celix_status_t rsaJsonRpc_createProxy(void *handle, const endpoint_description_t
 
     rsa_json_rpc_t *jsonRpc = (rsa_json_rpc_t *)handle;
 
+    bool binarySerialization = false;
+    status = rsaJsonRpc_getSerialization(jsonRpc, endpointDesc, &binarySerialization);
+    if (status != CELIX_SUCCESS) {
+        goto err_creating_proxy_fac;
+    }
+
     rsa_json_rpc_proxy_factory_t *proxyFactory = NULL;
     status = rsaJsonRpcProxy_factoryCreate(jsonRpc->ctx, jsonRpc->logHelper,
             jsonRpc->callsLogFile, jsonRpc->interceptorsHandler, endpointDesc,
-            jsonRpc->reqSenderTracker, requestSenderSvcId, jsonRpc->serialProtoId, &proxyFactory);
+            jsonRpc->reqSenderTracker, requestSenderSvcId,
+            binarySerialization ? jsonRpc->binarySerialProtoId : jsonRpc->serialProtoId, binarySerialization,
+            &proxyFactory);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(jsonRpc->logHelper, "Error creating proxy factory for %s.", endpointDesc->serviceName);
         goto err_creating_proxy_fac;
@@ -204,9 +233,17 @@ celix_status_t rsaJsonRpc_createEndpoint(void *handle, const endpoint_descriptio
 
     rsa_json_rpc_t *jsonRpc = (rsa_json_rpc_t *)handle;
 
+    bool binarySerialization = false;
+    status = rsaJsonRpc_getSerialization(jsonRpc, endpointDesc, &binarySerialization);
+    if (status != CELIX_SUCCESS) {
+        goto endpoint_err;
+    }
+
     rsa_json_rpc_endpoint_t *endpoint = NULL;
     status = rsaJsonRpcEndpoint_create(jsonRpc->ctx, jsonRpc->logHelper, jsonRpc->callsLogFile,
-            jsonRpc->interceptorsHandler, endpointDesc, jsonRpc->serialProtoId, &endpoint);
+            jsonRpc->interceptorsHandler, endpointDesc,
+            binarySerialization ? jsonRpc->binarySerialProtoId : jsonRpc->serialProtoId, binarySerialization,
+            &endpoint);
     if (status != CELIX_SUCCESS) {
         goto endpoint_err;
     }
@@ -19,7 +19,9 @@
 
 #include "rsa_json_rpc_proxy_impl.h"
 #include "rsa_request_sender_tracker.h"
+#include "rsa_rpc_async_invoker_service.h"
 #include "json_rpc.h"
+#include "binary_rpc.h"
 #include "endpoint_description.h"
 #include "celix_log_helper.h"
 #include "dfi_utils.h"
@@ -27,6 +29,7 @@
 #include "celix_constants.h"
 #include "celix_build_assert.h"
 #include "celix_long_hash_map.h"
+#include "celix_threads.h"
 #include <sys/queue.h>
 #include <stdbool.h>
 #include <assert.h>
@@ -36,19 +39,26 @@ struct rsa_json_rpc_proxy_factory {
     celix_log_helper_t *logHelper;
     FILE *callsLogFile;
     unsigned int serialProtoId;
+    bool binarySerialization;
     celix_service_factory_t factory;
     long factorySvcId;
+    celix_service_factory_t asyncInvokerFactory;
+    long asyncInvokerSvcId;
     endpoint_description_t *endpointDesc;
     celix_long_hash_map_t *proxies;//Key:requestingBundle, Value: rsa_json_rpc_proxy_t *. Work on the celix_event thread , so locks are not required
     remote_interceptors_handler_t *interceptorsHandler;
     rsa_request_sender_tracker_t *reqSenderTracker;
     long reqSenderSvcId;
+    celix_thread_mutex_t mutex;//projects below
+    celix_thread_cond_t asyncCallsDone;
+    unsigned int asyncCallCnt;//The number of asynchronous calls that are not completed yet
 };
 
 typedef struct rsa_json_rpc_proxy {
     rsa_json_rpc_proxy_factory_t *proxyFactory;
     dyn_interface_type *intfType;
     void *service;
+    rsa_rpc_async_invoker_service_t asyncInvoker;
     unsigned int useCnt;
 }rsa_json_rpc_proxy_t;
 
@@ -59,19 +69,35 @@ struct rsa_request_sender_callback_data {
     struct iovec *response;
 };
 
+struct rsa_json_rpc_async_call {
+    rsa_json_rpc_proxy_factory_t *proxyFactory;
+    struct method_entry *entry;
+    celix_properties_t *metadata;
+    struct iovec request;
+    rsa_rpc_async_completion_fp completion;
+    void *completionData;
+    void **args;//The arguments for the reply handler, the output arguments point to outValues
+    void *outValues[];//The output argument pointers of the caller, followed by the args array
+};
+
 static void* rsaJsonRpcProxy_getService(void *handle, const celix_bundle_t *requestingBundle,
         const celix_properties_t *svcProperties);
+static void* rsaJsonRpcProxy_getAsyncInvoker(void *handle, const celix_bundle_t *requestingBundle,
+        const celix_properties_t *svcProperties);
 static void rsaJsonRpcProxy_ungetService(void *handle, const celix_bundle_t *requestingBundle,
         const celix_properties_t *svcProperties);
 static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxyFactory,
         const celix_bundle_t *requestingBundle, rsa_json_rpc_proxy_t **proxyOut);
 static void rsaJsonRpcProxy_destroy(rsa_json_rpc_proxy_t *proxy);
 static void rsaJsonRpcProxy_unregisterFacSvcDone(void *data);
+static celix_status_t rsaJsonRpcProxy_invokeAsync(void *handle, const char *methodId, void *args[],
+        rsa_rpc_async_completion_fp completion, void *completionData);
 
 celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
         FILE *logFile, remote_interceptors_handler_t *interceptorsHandler,
         const endpoint_description_t *endpointDesc, rsa_request_sender_tracker_t *reqSenderTracker,
-        long requestSenderSvcId, unsigned int serialProtoId, rsa_json_rpc_proxy_factory_t **proxyFactoryOut) {
+        long requestSenderSvcId, unsigned int serialProtoId, bool binarySerialization,
+        rsa_json_rpc_proxy_factory_t **proxyFactoryOut) {
     assert(ctx != NULL);
     assert(logHelper != NULL);
     assert(interceptorsHandler != NULL);
@@ -91,6 +117,7 @@ celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx, celix_
     proxyFactory->reqSenderTracker = reqSenderTracker;
     proxyFactory->reqSenderSvcId = requestSenderSvcId;
     proxyFactory->serialProtoId = serialProtoId;
+    proxyFactory->binarySerialization = binarySerialization;
 
     CELIX_BUILD_ASSERT(sizeof(long) == sizeof(void*));//The hash_map uses the pointer as key, so this should be true
     proxyFactory->proxies = celix_longHashMap_create();
@@ -107,6 +134,18 @@ celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx, celix_
         goto failed_to_clone_endpoint_desc;
     }
 
+    status = celixThreadMutex_create(&proxyFactory->mutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Proxy: Error creating mutex. %d.", status);
+        goto mutex_err;
+    }
+    status = celixThreadCondition_init(&proxyFactory->asyncCallsDone, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Proxy: Error creating condition variable. %d.", status);
+        goto cond_err;
+    }
+    proxyFactory->asyncCallCnt = 0;
+
     proxyFactory->factory.handle = proxyFactory;
     proxyFactory->factory.getService = rsaJsonRpcProxy_getService;
     proxyFactory->factory.ungetService = rsaJsonRpcProxy_ungetService;
@@ -120,10 +159,29 @@ celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx, celix_
         goto proxy_svc_fac_err;
     }
 
+    //The async invoker is optional for the consumers, so the proxy is still usable if it cannot be registered.
+    proxyFactory->asyncInvokerFactory.handle = proxyFactory;
+    proxyFactory->asyncInvokerFactory.getService = rsaJsonRpcProxy_getAsyncInvoker;
+    proxyFactory->asyncInvokerFactory.ungetService = rsaJsonRpcProxy_ungetService;
+    celix_properties_t *invokerProps = celix_properties_copy(endpointDesc->properties);
+    assert(invokerProps != NULL);
+    celix_properties_unset(invokerProps, CELIX_FRAMEWORK_SERVICE_NAME);//The framework sets it to the async invoker service name
+    celix_properties_set(invokerProps, CELIX_FRAMEWORK_SERVICE_VERSION, RSA_RPC_ASYNC_INVOKER_SERVICE_VERSION);
+    celix_properties_set(invokerProps, RSA_RPC_ASYNC_INVOKER_REMOTE_SERVICE_NAME, endpointDesc->serviceName);
+    proxyFactory->asyncInvokerSvcId = celix_bundleContext_registerServiceFactoryAsync(
+            ctx, &proxyFactory->asyncInvokerFactory, RSA_RPC_ASYNC_INVOKER_SERVICE_NAME, invokerProps);
+    if (proxyFactory->asyncInvokerSvcId < 0) {
+        celix_logHelper_warning(logHelper, "Proxy: Error registering async invoker service for %s.", endpointDesc->serviceName);
+    }
+
     *proxyFactoryOut = proxyFactory;
     return CELIX_SUCCESS;
 proxy_svc_fac_err:
     // props has been freed by framework
+    celixThreadCondition_destroy(&proxyFactory->asyncCallsDone);
+cond_err:
+    celixThreadMutex_destroy(&proxyFactory->mutex);
+mutex_err:
     endpointDescription_destroy(proxyFactory->endpointDesc);
 failed_to_clone_endpoint_desc:
     celix_longHashMap_destroy(proxyFactory->proxies);
@@ -134,6 +192,9 @@ proxy_map_err:
 
 void rsaJsonRpcProxy_factoryDestroy(rsa_json_rpc_proxy_factory_t *proxyFactory) {
     assert(proxyFactory != NULL);
+    if (proxyFactory->asyncInvokerSvcId >= 0) {
+        celix_bundleContext_unregisterServiceAsync(proxyFactory->ctx, proxyFactory->asyncInvokerSvcId, NULL, NULL);
+    }
     celix_bundleContext_unregisterServiceAsync(proxyFactory->ctx, proxyFactory->factorySvcId,
             proxyFactory, rsaJsonRpcProxy_unregisterFacSvcDone);
 }
@@ -148,18 +209,16 @@ static void rsaJsonRpcProxy_unregisterFacSvcDone(void *data) {
     endpointDescription_destroy(proxyFactory->endpointDesc);
     assert(celix_longHashMap_size(proxyFactory->proxies) == 0);
     celix_longHashMap_destroy(proxyFactory->proxies);
+    assert(proxyFactory->asyncCallCnt == 0);
+    celixThreadCondition_destroy(&proxyFactory->asyncCallsDone);
+    celixThreadMutex_destroy(&proxyFactory->mutex);
     free(proxyFactory);
     return;
 }
 
-static void* rsaJsonRpcProxy_getService(void *handle, const celix_bundle_t *requestingBundle,
-        const celix_properties_t *svcProperties) {
-    assert(handle != NULL);
-    assert(requestingBundle != NULL);
-    assert(svcProperties != NULL);
+static rsa_json_rpc_proxy_t* rsaJsonRpcProxy_getProxy(rsa_json_rpc_proxy_factory_t *proxyFactory,
+        const celix_bundle_t *requestingBundle) {
     celix_status_t status = CELIX_SUCCESS;
-    rsa_json_rpc_proxy_factory_t *proxyFactory = (rsa_json_rpc_proxy_factory_t *)handle;
-
     rsa_json_rpc_proxy_t *proxy = celix_longHashMap_get(proxyFactory->proxies, (long)requestingBundle);
     if (proxy == NULL) {
         status = rsaJsonRpcProxy_create(proxyFactory, requestingBundle, &proxy);
@@ -172,12 +231,30 @@ static void* rsaJsonRpcProxy_getService(void *handle, const celix_bundle_t *requ
     }
     proxy->useCnt += 1;
 
-    return proxy->service;
+    return proxy;
 
 service_proxy_err:
     return NULL;
 }
 
+static void* rsaJsonRpcProxy_getService(void *handle, const celix_bundle_t *requestingBundle,
+        const celix_properties_t *svcProperties) {
+    assert(handle != NULL);
+    assert(requestingBundle != NULL);
+    assert(svcProperties != NULL);
+    rsa_json_rpc_proxy_t *proxy = rsaJsonRpcProxy_getProxy((rsa_json_rpc_proxy_factory_t *)handle, requestingBundle);
+    return proxy != NULL ? proxy->service : NULL;
+}
+
+static void* rsaJsonRpcProxy_getAsyncInvoker(void *handle, const celix_bundle_t *requestingBundle,
+        const celix_properties_t *svcProperties) {
+    assert(handle != NULL);
+    assert(requestingBundle != NULL);
+    assert(svcProperties != NULL);
+    rsa_json_rpc_proxy_t *proxy = rsaJsonRpcProxy_getProxy((rsa_json_rpc_proxy_factory_t *)handle, requestingBundle);
+    return proxy != NULL ? &proxy->asyncInvoker : NULL;
+}
+
 static void rsaJsonRpcProxy_ungetService(void *handle, const celix_bundle_t *requestingBundle,
         const celix_properties_t *svcProperties) {
     assert(handle != NULL);
@@ -203,6 +280,62 @@ static celix_status_t rsaJsonRpcProxy_useReqSenderSvcCallback(void *handle, rsa_
             data->request, data->response);
 }
 
+static int rsaJsonRpcProxy_prepareInvokeRequest(rsa_json_rpc_proxy_factory_t *proxyFactory,
+        struct method_entry *entry, void *args[], struct iovec *request) {
+    if (proxyFactory->binarySerialization) {
+        return binaryRpc_prepareInvokeRequest(entry->dynFunc, entry->id, args, &request->iov_base, &request->iov_len);
+    }
+    char *invokeRequest = NULL;
+    int rc = jsonRpc_prepareInvokeRequest(entry->dynFunc, entry->id, args, &invokeRequest);
+    if (rc == 0) {
+        request->iov_base = invokeRequest;
+        request->iov_len = strlen(invokeRequest) + 1;
+    }
+    return rc;
+}
+
+static int rsaJsonRpcProxy_handleReply(rsa_json_rpc_proxy_factory_t *proxyFactory, struct method_entry *entry,
+        const struct iovec *reply, void *args[], int *rsErrno) {
+    if (proxyFactory->binarySerialization) {
+        return binaryRpc_handleReply(entry->dynFunc, reply->iov_base, reply->iov_len, args, rsErrno);
+    }
+    return jsonRpc_handleReply(entry->dynFunc, (const char *)reply->iov_base, args, rsErrno);
+}
+
+static void rsaJsonRpcProxy_logCall(rsa_json_rpc_proxy_factory_t *proxyFactory, const struct iovec *request,
+        const struct iovec *reply, celix_status_t status) {
+    if (proxyFactory->binarySerialization) {
+        fprintf(proxyFactory->callsLogFile, "PROXY REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\trequest_payload=<binary, %zu bytes>\n\trequest_response=<binary, %zu bytes>\n\tstatus=%i\n",
+                proxyFactory->endpointDesc->serviceName, proxyFactory->endpointDesc->serviceId, request->iov_len, reply->iov_len, status);
+    } else {
+        fprintf(proxyFactory->callsLogFile, "PROXY REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n",
+                proxyFactory->endpointDesc->serviceName, proxyFactory->endpointDesc->serviceId, (char *)request->iov_base, (char *)reply->iov_base, status);
+    }
+    fflush(proxyFactory->callsLogFile);
+}
+
+static celix_status_t rsaJsonRpcProxy_processReply(rsa_json_rpc_proxy_factory_t *proxyFactory,
+        struct method_entry *entry, celix_status_t status, const struct iovec *replyIovec, void *args[]) {
+    if (status == CELIX_SUCCESS && dynFunction_hasReturn(entry->dynFunc)) {
+        if (replyIovec->iov_base != NULL) {
+            int rsErrno = CELIX_SUCCESS;
+            int retVal = rsaJsonRpcProxy_handleReply(proxyFactory, entry, replyIovec, args, &rsErrno);
+            if(retVal != 0) {
+                status = CELIX_SERVICE_EXCEPTION;
+            } else if (rsErrno != CELIX_SUCCESS) {
+                //return the invocation error of remote service function
+                status = rsErrno;
+            }
+        } else {
+            celix_logHelper_error(proxyFactory->logHelper,"Expect service proxy has return, but reply is empty.");
+            status = CELIX_ILLEGAL_ARGUMENT;
+        }
+    } else if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(proxyFactory->logHelper,"Service proxy send request failed. %d", status);
+    }
+    return status;
+}
+
 static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *returnVal) {
     celix_status_t  status = CELIX_SUCCESS;
     if (returnVal == NULL) {
@@ -218,8 +351,8 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
     rsa_json_rpc_proxy_factory_t *proxyFactory = proxy->proxyFactory;
     assert(proxyFactory != NULL);
 
-    char *invokeRequest = NULL;
-    int rc = jsonRpc_prepareInvokeRequest(entry->dynFunc, entry->id, args, &invokeRequest);
+    struct iovec requestIovec = {NULL,0};
+    int rc = rsaJsonRpcProxy_prepareInvokeRequest(proxyFactory, entry, args, &requestIovec);
     if (rc != 0) {
         celix_logHelper_error(proxyFactory->logHelper, "Error preparing invoke request for %s", entry->name);
         *(celix_status_t *)returnVal = CELIX_SERVICE_EXCEPTION;
@@ -230,7 +363,7 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
     celix_properties_t *metadata = celix_properties_create();
     if (metadata == NULL) {
         celix_logHelper_error(proxyFactory->logHelper,"Error creating metadata for %s", entry->name);
-        free(invokeRequest);
+        free(requestIovec.iov_base);
         *(celix_status_t *)returnVal = CELIX_ENOMEM;
         return;
     }
@@ -238,7 +371,6 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
     bool cont = remoteInterceptorHandler_invokePreProxyCall(proxyFactory->interceptorsHandler,
             proxyFactory->endpointDesc->properties, entry->name, &metadata);
     if (cont) {
-        struct iovec requestIovec = {invokeRequest,strlen(invokeRequest) + 1};
         struct rsa_request_sender_callback_data data= {
                 .endpointDesc = proxyFactory->endpointDesc,
                 .metadata = metadata,
@@ -247,24 +379,7 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
         };
         status = rsaRequestSenderTracker_useService(proxyFactory->reqSenderTracker, proxyFactory->reqSenderSvcId,
                 &data, rsaJsonRpcProxy_useReqSenderSvcCallback);
-        if (status == CELIX_SUCCESS && dynFunction_hasReturn(entry->dynFunc)) {
-            if (replyIovec.iov_base != NULL) {
-                int rsErrno = CELIX_SUCCESS;
-                int retVal = jsonRpc_handleReply(entry->dynFunc,
-                        (const char *)replyIovec.iov_base , args, &rsErrno);
-                if(retVal != 0) {
-                    status = CELIX_SERVICE_EXCEPTION;
-                } else if (rsErrno != CELIX_SUCCESS) {
-                    //return the invocation error of remote service function
-                    status = rsErrno;
-                }
-            } else {
-                celix_logHelper_error(proxyFactory->logHelper,"Expect service proxy has return, but reply is empty.");
-                status = CELIX_ILLEGAL_ARGUMENT;
-            }
-        } else if (status != CELIX_SUCCESS) {
-            celix_logHelper_error(proxyFactory->logHelper,"Service proxy send request failed. %d", status);
-        }
+        status = rsaJsonRpcProxy_processReply(proxyFactory, entry, status, &replyIovec, args);
         remoteInterceptorHandler_invokePostProxyCall(proxyFactory->interceptorsHandler,
                 proxyFactory->endpointDesc->properties, entry->name, metadata);
     } else {
@@ -278,13 +393,11 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
     }
 
     if (proxyFactory->callsLogFile != NULL) {
-        fprintf(proxyFactory->callsLogFile, "PROXY REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n",
-                proxyFactory->endpointDesc->serviceName, proxyFactory->endpointDesc->serviceId, invokeRequest, (char *)replyIovec.iov_base, status);
-        fflush(proxyFactory->callsLogFile);
+        rsaJsonRpcProxy_logCall(proxyFactory, &requestIovec, &replyIovec, status);
     }
 
 
-    free(invokeRequest); //Allocated by json_dumps in jsonRpc_prepareInvokeRequest
+    free(requestIovec.iov_base); //Allocated by json_dumps in jsonRpc_prepareInvokeRequest or by binaryRpc_prepareInvokeRequest
     if (replyIovec.iov_base) {
         free(replyIovec.iov_base); //Allocated by json_dumps
     }
@@ -294,6 +407,137 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
     return;
 }
 
+static void rsaJsonRpcProxy_asyncCallDone(rsa_json_rpc_proxy_factory_t *proxyFactory) {
+    celixThreadMutex_lock(&proxyFactory->mutex);
+    proxyFactory->asyncCallCnt -= 1;
+    if (proxyFactory->asyncCallCnt == 0) {
+        celixThreadCondition_broadcast(&proxyFactory->asyncCallsDone);
+    }
+    celixThreadMutex_unlock(&proxyFactory->mutex);
+}
+
+static void rsaJsonRpcProxy_asyncRequestCompleted(void *data, celix_status_t status, struct iovec *response) {
+    assert(data != NULL);
+    struct rsa_json_rpc_async_call *call = (struct rsa_json_rpc_async_call *)data;
+    rsa_json_rpc_proxy_factory_t *proxyFactory = call->proxyFactory;
+    struct iovec replyIovec = {NULL,0};
+    if (response != NULL) {
+        replyIovec = *response;
+    }
+    status = rsaJsonRpcProxy_processReply(proxyFactory, call->entry, status, &replyIovec, call->args);
+    remoteInterceptorHandler_invokePostProxyCall(proxyFactory->interceptorsHandler,
+            proxyFactory->endpointDesc->properties, call->entry->name, call->metadata);
+    celix_properties_destroy(call->metadata);
+
+    if (proxyFactory->callsLogFile != NULL) {
+        rsaJsonRpcProxy_logCall(proxyFactory, &call->request, &replyIovec, status);
+    }
+    free(call->request.iov_base);
+    free(replyIovec.iov_base);
+
+    call->completion(call->completionData, status);
+    free(call);
+    rsaJsonRpcProxy_asyncCallDone(proxyFactory);
+}
+
+static celix_status_t rsaJsonRpcProxy_useReqSenderSvcAsyncCallback(void *handle, rsa_request_sender_service_t *svc) {
+    assert(handle != NULL);
+    assert(svc != NULL);
+    struct rsa_json_rpc_async_call *call = (struct rsa_json_rpc_async_call *)handle;
+    rsa_json_rpc_proxy_factory_t *proxyFactory = call->proxyFactory;
+    if (svc->sendRequestAsync != NULL) {
+        return svc->sendRequestAsync(svc->handle, proxyFactory->endpointDesc, call->metadata, &call->request,
+                rsaJsonRpcProxy_asyncRequestCompleted, call);
+    }
+    //The request sender does not support asynchronous requests, so the call is completed before returning
+    struct iovec response = {NULL,0};
+    celix_status_t status = svc->sendRequest(svc->handle, proxyFactory->endpointDesc, call->metadata,
+            &call->request, &response);
+    rsaJsonRpcProxy_asyncRequestCompleted(call, status, &response);
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t rsaJsonRpcProxy_invokeAsync(void *handle, const char *methodId, void *args[],
+        rsa_rpc_async_completion_fp completion, void *completionData) {
+    if (handle == NULL || methodId == NULL || args == NULL || completion == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_status_t status = CELIX_SUCCESS;
+    rsa_json_rpc_proxy_t *proxy = (rsa_json_rpc_proxy_t *)handle;
+    rsa_json_rpc_proxy_factory_t *proxyFactory = proxy->proxyFactory;
+    struct method_entry *entry = NULL;
+    if (dynInterface_findMethod(proxy->intfType, methodId, &entry) != 0) {
+        celix_logHelper_error(proxyFactory->logHelper, "Proxy: Method %s not found in %s.", methodId,
+                proxyFactory->endpointDesc->serviceName);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    int nrOfArgs = dynFunction_nrOfArguments(entry->dynFunc);
+    struct rsa_json_rpc_async_call *call = calloc(1, sizeof(*call) + 2 * nrOfArgs * sizeof(void *));
+    if (call == NULL) {
+        celix_logHelper_error(proxyFactory->logHelper, "Proxy: Failed to allocate memory for async call of %s.", entry->name);
+        return CELIX_ENOMEM;
+    }
+    call->proxyFactory = proxyFactory;
+    call->entry = entry;
+    call->completion = completion;
+    call->completionData = completionData;
+    call->args = &call->outValues[nrOfArgs];
+    //The caller's output argument pointers can be stack variables, so the reply handler gets copies of them
+    for (int i = 0; i < nrOfArgs; ++i) {
+        enum dyn_function_argument_meta meta = dynFunction_argumentMetaForIndex(entry->dynFunc, i);
+        if (meta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT || meta == DYN_FUNCTION_ARGUMENT_META__OUTPUT) {
+            call->outValues[i] = *(void **)args[i];
+            call->args[i] = &call->outValues[i];
+        }
+    }
+
+    int rc = rsaJsonRpcProxy_prepareInvokeRequest(proxyFactory, entry, args, &call->request);
+    if (rc != 0) {
+        celix_logHelper_error(proxyFactory->logHelper, "Error preparing invoke request for %s", entry->name);
+        status = CELIX_SERVICE_EXCEPTION;
+        goto prepare_request_err;
+    }
+    call->metadata = celix_properties_create();
+    if (call->metadata == NULL) {
+        celix_logHelper_error(proxyFactory->logHelper,"Error creating metadata for %s", entry->name);
+        status = CELIX_ENOMEM;
+        goto metadata_err;
+    }
+    celix_properties_setLong(call->metadata, "SerialProtocolId", proxyFactory->serialProtoId);
+    bool cont = remoteInterceptorHandler_invokePreProxyCall(proxyFactory->interceptorsHandler,
+            proxyFactory->endpointDesc->properties, entry->name, &call->metadata);
+    if (!cont) {
+        celix_logHelper_error(proxyFactory->logHelper, "%s has been intercepted.", proxyFactory->endpointDesc->serviceName);
+        status = CELIX_INTERCEPTOR_EXCEPTION;
+        goto intercepted;
+    }
+
+    celixThreadMutex_lock(&proxyFactory->mutex);
+    proxyFactory->asyncCallCnt += 1;
+    celixThreadMutex_unlock(&proxyFactory->mutex);
+    status = rsaRequestSenderTracker_useService(proxyFactory->reqSenderTracker, proxyFactory->reqSenderSvcId,
+            call, rsaJsonRpcProxy_useReqSenderSvcAsyncCallback);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(proxyFactory->logHelper,"Service proxy send request failed. %d", status);
+        remoteInterceptorHandler_invokePostProxyCall(proxyFactory->interceptorsHandler,
+                proxyFactory->endpointDesc->properties, entry->name, call->metadata);
+        rsaJsonRpcProxy_asyncCallDone(proxyFactory);
+        goto send_request_err;
+    }
+    //The call is owned by the completion callback now
+    return CELIX_SUCCESS;
+
+send_request_err:
+intercepted:
+    celix_properties_destroy(call->metadata);
+metadata_err:
+    free(call->request.iov_base);
+prepare_request_err:
+    free(call);
+    return status;
+}
+
 static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxyFactory,
         const celix_bundle_t *requestingBundle, rsa_json_rpc_proxy_t **proxyOut) {
     celix_status_t status = CELIX_SUCCESS;
@@ -345,6 +589,8 @@ static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxy
     }
     void **service = (void **)proxy->service;
     service[0] = proxy;
+    proxy->asyncInvoker.handle = proxy;
+    proxy->asyncInvoker.invokeAsync = rsaJsonRpcProxy_invokeAsync;
     struct methods_head *list = NULL;
     dynInterface_methods(intfType, &list);
     struct method_entry *entry = NULL;
@@ -380,6 +626,13 @@ intf_descriptor_err:
 };
 
 static void rsaJsonRpcProxy_destroy(rsa_json_rpc_proxy_t *proxy) {
+    rsa_json_rpc_proxy_factory_t *proxyFactory = proxy->proxyFactory;
+    //The pending asynchronous calls use the method entries of the interface
+    celixThreadMutex_lock(&proxyFactory->mutex);
+    while (proxyFactory->asyncCallCnt > 0) {
+        celixThreadCondition_wait(&proxyFactory->asyncCallsDone, &proxyFactory->mutex);
+    }
+    celixThreadMutex_unlock(&proxyFactory->mutex);
     free(proxy->service);
     dynInterface_destroy(proxy->intfType);
     free(proxy);
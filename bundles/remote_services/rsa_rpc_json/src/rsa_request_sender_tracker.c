@@ -23,6 +23,8 @@
 #include "celix_long_hash_map.h"
 #include "celix_threads.h"
 #include "celix_constants.h"
+#include "celix_version.h"
+#include <stdbool.h>
 #include <stdlib.h>
 #include <assert.h>
 
@@ -31,9 +33,14 @@ struct rsa_request_sender_tracker {
     celix_log_helper_t *logHelper;
     long reqSenderTrkId;
     celix_thread_rwlock_t lock;//projects below
-    celix_long_hash_map_t *requestSenderSvcs;//Key:service id, Value:service
+    celix_long_hash_map_t *requestSenderSvcs;//Key:service id, Value:rsa_request_sender_entry_t *
 };
 
+typedef struct rsa_request_sender_entry {
+    rsa_request_sender_service_t *svc;
+    bool asyncSupported;//Only services since version 1.1.0 have the sendRequestAsync member
+}rsa_request_sender_entry_t;
+
 static void rsaRequestSenderTracker_addServiceWithProperties(void *handle, void *svc,
         const celix_properties_t *props);
 static void rsaRequestSenderTracker_removeServiceWithProperties(void *handle, void *svc,
@@ -55,7 +62,9 @@ celix_status_t rsaRequestSenderTracker_create(celix_bundle_context_t* ctx, celix
     if (status != CELIX_SUCCESS) {
         goto err_creating_lock;
     }
-    tracker->requestSenderSvcs = celix_longHashMap_create();
+    celix_long_hash_map_create_options_t mapOpts = CELIX_EMPTY_LONG_HASH_MAP_CREATE_OPTIONS;
+    mapOpts.simpleRemovedCallback = free;
+    tracker->requestSenderSvcs = celix_longHashMap_createWithOptions(&mapOpts);
     assert(tracker->requestSenderSvcs != NULL);
     celix_service_tracking_options_t opts = CELIX_EMPTY_SERVICE_TRACKING_OPTIONS;
     opts.filter.serviceName = RSA_REQUEST_SENDER_SERVICE_NAME;
@@ -91,8 +100,17 @@ static void rsaRequestSenderTracker_addServiceWithProperties(void *handle, void
         celix_logHelper_error(tracker->logHelper, "Error getting rsa request sender service id for %s.", serviceName);
         return;
     }
+    rsa_request_sender_entry_t *entry = calloc(1, sizeof(*entry));
+    if (entry == NULL) {
+        celix_logHelper_error(tracker->logHelper, "Error allocating memory for rsa request sender service %s.", serviceName);
+        return;
+    }
+    entry->svc = (rsa_request_sender_service_t *)svc;
+    celix_version_t *svcVersion = celix_properties_getAsVersion(props, CELIX_FRAMEWORK_SERVICE_VERSION, NULL);
+    entry->asyncSupported = svcVersion != NULL && celix_version_compareToMajorMinor(svcVersion, 1, 1) >= 0;
+    celix_version_destroy(svcVersion);
     celixThreadRwlock_writeLock(&tracker->lock);
-    (void)celix_longHashMap_put(tracker->requestSenderSvcs, svcId, svc);
+    (void)celix_longHashMap_put(tracker->requestSenderSvcs, svcId, entry);
     celixThreadRwlock_unlock(&tracker->lock);
     return;
 }
@@ -136,9 +154,15 @@ celix_status_t rsaRequestSenderTracker_useService(rsa_request_sender_tracker_t *
         long reqSenderSvcId, void *handle, celix_status_t (*use)(void *handle, rsa_request_sender_service_t *svc)) {
     celix_status_t status = CELIX_SUCCESS;
     celixThreadRwlock_readLock(&tracker->lock);
-    rsa_request_sender_service_t *svc = celix_longHashMap_get(tracker->requestSenderSvcs, reqSenderSvcId);
-    if (svc != NULL) {
-        status = use(handle, svc);
+    rsa_request_sender_entry_t *entry = celix_longHashMap_get(tracker->requestSenderSvcs, reqSenderSvcId);
+    if (entry != NULL) {
+        //The struct of a service older than version 1.1.0 ends before sendRequestAsync
+        rsa_request_sender_service_t svc = {
+                .handle = entry->svc->handle,
+                .sendRequest = entry->svc->sendRequest,
+                .sendRequestAsync = entry->asyncSupported ? entry->svc->sendRequestAsync : NULL
+        };
+        status = use(handle, &svc);
     } else {
         status = CELIX_ILLEGAL_STATE;
     }
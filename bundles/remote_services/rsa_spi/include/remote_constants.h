@@ -45,5 +45,15 @@ static const char * const OSGI_RSA_SERVICE_LOCATION = "service.location";
  */
 static const char * const CELIX_RSA_NETWORK_INTERFACES = "org.apache.celix.rsa.network.interfaces";
 
+/**
+ * Exported service property selecting the serialization of the remote calls of the dfi based remote service admins.
+ * The property value is "json" (default) or "binary". The "binary" serialization is a compact binary encoding
+ * of the arguments and results, which avoids the conversion from and to JSON text.
+ * The property is part of the endpoint description, so the proxy uses the same serialization as the endpoint.
+ */
+static const char * const CELIX_RSA_RPC_SERIALIZATION = "org.apache.celix.rsa.rpc.serialization";
+static const char * const CELIX_RSA_RPC_SERIALIZATION_JSON = "json";
+static const char * const CELIX_RSA_RPC_SERIALIZATION_BINARY = "binary";
+
 
 #endif /* REMOTE_CONSTANTS_H_ */
@@ -26,11 +26,29 @@ extern "C" {
 #include <celix_properties.h>
 #include <celix_errno.h>
 #include <sys/uio.h>
+#include <stddef.h>
 
 #define RSA_REQUEST_HANDLER_SERVICE_NAME "rsa_request_handler_service"
-#define RSA_REQUEST_HANDLER_SERVICE_VERSION "1.0.0"
+#define RSA_REQUEST_HANDLER_SERVICE_VERSION "1.1.0"
 #define RSA_REQUEST_HANDLER_SERVICE_USE_RANGE "[1.0.0,2)"
 
+/**
+ * @brief Allocator for the response of a request.
+ * @note It is provided by the RSA bundle, e.g. to let the response be written directly in the memory of the transport.
+ */
+typedef struct rsa_response_allocator {
+    void *handle;/// The allocator handle
+    /**
+     * @brief Allocate memory for a response.
+     * @return The memory, or NULL if the allocator can not provide the memory. In that case malloc can be used instead.
+     */
+    void *(*allocate)(void *handle, size_t size);
+    /**
+     * @brief Free memory returned by allocate, e.g. if the request handling failed after the allocation.
+     */
+    void (*deallocate)(void *handle, void *ptr);
+}rsa_response_allocator_t;
+
 /**
  * @brief The service handle RPC request
  * @note It can be implemented by RPC bundles, and called by RSA bundles.
@@ -49,6 +67,20 @@ typedef struct rsa_request_handler_service {
      * @return @see celix_errno.h
      */
     celix_status_t (*handleRequest)(void *handle, celix_properties_t *metadata, const struct iovec *request, struct iovec *response);
+
+    /**
+     * @brief Handle the request that from remote service proxy, and allocate the response with the given allocator.
+     * @note Since version 1.1.0, and it can be NULL.
+     *
+     * @param[in] handle Service handle
+     * @param[in, out] metadata The metadata, can be NULL.
+     * @param[in] request The request from remote service proxy
+     * @param[in] allocator The allocator for the response memory
+     * @param[out] response The response from remote service endpoint. If response->iov_base is not returned by the allocator, the caller should use free function to free response memory
+     * @return @see celix_errno.h
+     */
+    celix_status_t (*handleRequestWithAllocator)(void *handle, celix_properties_t *metadata, const struct iovec *request,
+            const rsa_response_allocator_t *allocator, struct iovec *response);
 }rsa_request_handler_service_t;
 
 
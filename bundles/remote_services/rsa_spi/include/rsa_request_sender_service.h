@@ -29,9 +29,18 @@ extern "C" {
 #include <sys/uio.h>
 
 #define RSA_REQUEST_SENDER_SERVICE_NAME "rsa_request_sender_service"
-#define RSA_REQUEST_SENDER_SERVICE_VERSION "1.0.0"
+#define RSA_REQUEST_SENDER_SERVICE_VERSION "1.1.0"
 #define RSA_REQUEST_SENDER_SERVICE_USE_RANGE "[1.0.0,2)"
 
+/**
+ * @brief Called when an asynchronous request is completed.
+ * @param[in] data The completion data given to sendRequestAsync
+ * @param[in] status The status of the request, @see celix_errno.h
+ * @param[in] response The response received from remote service endpoint. It is only set if status is CELIX_SUCCESS,
+ * and the callee should use free function to free response memory.
+ */
+typedef void (*rsa_request_sender_completion_fp)(void *data, celix_status_t status, struct iovec *response);
+
 /**
  * @brief The service send RPC request
  * @note It can be implemented by RSA bundles, and called by RPC bundles.
@@ -50,6 +59,21 @@ typedef struct rsa_request_sender_service {
      * @return @see celix_errno.h
      */
     celix_status_t (*sendRequest)(void *handle, const endpoint_description_t *endpointDesciption, celix_properties_t *metadata, const struct iovec *request, struct iovec *response);
+    /**
+     * @brief Send the request that from remote service proxy, without waiting for the response.
+     * @details Many requests can be in flight at the same time, the implementation correlates the responses with the requests.
+     * The request and metadata are not used anymore after this function returns.
+     * @note Since version 1.1.0. It can be NULL if the implementation does not support asynchronous requests.
+     * @param[in] handle Service handle
+     * @param[in] endpointDesciption The endpoint desciption of remote service
+     * @param[in] metadata The metadata, can be NULL.
+     * @param[in] request The request for the remote service endpoint
+     * @param[in] completion Called exactly once when the request is completed, if this function returns CELIX_SUCCESS.
+     * It can be called from another thread, or from the calling thread before this function returns.
+     * @param[in] completionData The data passed to completion
+     * @return @see celix_errno.h
+     */
+    celix_status_t (*sendRequestAsync)(void *handle, const endpoint_description_t *endpointDesciption, celix_properties_t *metadata, const struct iovec *request, rsa_request_sender_completion_fp completion, void *completionData);
 }rsa_request_sender_service_t;
 
 
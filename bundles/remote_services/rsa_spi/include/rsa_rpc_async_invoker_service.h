@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _RSA_RPC_ASYNC_INVOKER_SERVICE_H_
+#define _RSA_RPC_ASYNC_INVOKER_SERVICE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <celix_errno.h>
+
+#define RSA_RPC_ASYNC_INVOKER_SERVICE_NAME "rsa_rpc_async_invoker_service"
+#define RSA_RPC_ASYNC_INVOKER_SERVICE_VERSION "1.0.0"
+#define RSA_RPC_ASYNC_INVOKER_SERVICE_USE_RANGE "[1.0.0,2)"
+
+/**
+ * @brief The service property with the name of the remote service that is invoked by the async invoker service.
+ * The async invoker service also has the endpoint properties (e.g. endpoint.id) of the remote service.
+ */
+#define RSA_RPC_ASYNC_INVOKER_REMOTE_SERVICE_NAME "rsa.rpc.async.remote.service.name"
+
+/**
+ * @brief Called when an asynchronous remote call is completed.
+ * @param[in] data The completion data given to invokeAsync
+ * @param[in] status The status of the remote call, it is the same as the return value of the synchronous proxy function.
+ */
+typedef void (*rsa_rpc_async_completion_fp)(void *data, celix_status_t status);
+
+/**
+ * @brief The service invokes the methods of a remote service without blocking the caller,
+ * so that many remote calls can be in flight at the same time.
+ * @note It is registered by RPC bundles next to the remote service proxy, and is used by consumers that
+ * want to pipeline remote calls. The C++ remote services use promises for this instead.
+ */
+typedef struct rsa_rpc_async_invoker_service {
+    void *handle;/// The Service handle
+    /**
+     * @brief Invoke a method of the remote service.
+     *
+     * @param[in] handle Service handle
+     * @param[in] methodId The method id in the interface descriptor of the remote service, e.g. "add(DD)D"
+     * @param[in] args The arguments as used by the proxy function, one pointer per argument of the descriptor method.
+     * args[0] (the service handle) is ignored. The input arguments are serialized before this function returns,
+     * and the memory that the output arguments point to must be valid until completion is called.
+     * @param[in] completion Called exactly once when the remote call is completed, if this function returns CELIX_SUCCESS.
+     * It can be called from another thread, or from the calling thread before this function returns.
+     * @param[in] completionData The data passed to completion
+     * @return @see celix_errno.h
+     */
+    celix_status_t (*invokeAsync)(void *handle, const char *methodId, void *args[], rsa_rpc_async_completion_fp completion, void *completionData);
+}rsa_rpc_async_invoker_service_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RSA_RPC_ASYNC_INVOKER_SERVICE_H_ */
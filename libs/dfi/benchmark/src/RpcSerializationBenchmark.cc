@@ -0,0 +1,235 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "dyn_interface.h"
+#include "json_rpc.h"
+#include "binary_rpc.h"
+
+namespace {
+    struct double_seq {
+        uint32_t cap;
+        uint32_t len;
+        double *buf;
+    };
+
+    struct sample {
+        double value;
+        int32_t weight;
+    };
+
+    struct sample_seq {
+        uint32_t cap;
+        uint32_t len;
+        struct sample *buf;
+    };
+
+    struct rpc_service {
+        void *handle;
+        int (*calc)(void *, double, double, int32_t, int32_t, int64_t, int64_t, bool, double *);
+        int (*sum)(void *, struct double_seq, double *);
+        int (*weightedSum)(void *, struct sample_seq, double *);
+    };
+
+    int calc(void*, double a, double b, int32_t c, int32_t d, int64_t e, int64_t f, bool negate, double *result) {
+        *result = a + b + c + d + (double)e + (double)f;
+        if (negate) {
+            *result = -*result;
+        }
+        return 0;
+    }
+
+    int sum(void*, struct double_seq input, double *result) {
+        *result = 0.0;
+        for (uint32_t i = 0; i < input.len; ++i) {
+            *result += input.buf[i];
+        }
+        return 0;
+    }
+
+    int weightedSum(void*, struct sample_seq input, double *result) {
+        *result = 0.0;
+        for (uint32_t i = 0; i < input.len; ++i) {
+            *result += input.buf[i].value * input.buf[i].weight;
+        }
+        return 0;
+    }
+
+    const char* DESCRIPTOR = ":header\ntype=interface\nname=rpc\nversion=1.0.0\n"
+                             ":types\nSample={DI value weight}\n"
+                             ":methods\n"
+                             "calc(DDIIJJZ)D=calc(#am=handle;PDDIIJJZ#am=pre;*D)N\n"
+                             "sum([D)D=sum(#am=handle;P[D#am=pre;*D)N\n"
+                             "weightedSum([LSample;)D=weightedSum(#am=handle;P[lSample;#am=pre;*D)N\n";
+}
+
+/**
+ * Round trip of a remote call through the json or binary rpc serialization:
+ * serialize the request, handle it for the service and deserialize the reply.
+ */
+class RpcSerializationBenchmark {
+public:
+    RpcSerializationBenchmark() {
+        FILE *desc = fmemopen((void *)DESCRIPTOR, strlen(DESCRIPTOR), "r");
+        int rc = dynInterface_parse(desc, &intf);
+        fclose(desc);
+        assert(rc == 0);
+        (void)rc;
+    }
+
+    ~RpcSerializationBenchmark() {
+        dynInterface_destroy(intf);
+    }
+
+    RpcSerializationBenchmark(RpcSerializationBenchmark&&) = delete;
+    RpcSerializationBenchmark& operator=(RpcSerializationBenchmark&&) = delete;
+    RpcSerializationBenchmark(const RpcSerializationBenchmark&) = delete;
+    RpcSerializationBenchmark& operator=(const RpcSerializationBenchmark&) = delete;
+
+    dyn_function_type* function(const char *id) {
+        struct methods_head *head = nullptr;
+        dynInterface_methods(intf, &head);
+        struct method_entry *entry = nullptr;
+        TAILQ_FOREACH(entry, head, entries) {
+            if (strcmp(entry->id, id) == 0) {
+                return entry->dynFunc;
+            }
+        }
+        return nullptr;
+    }
+
+    size_t jsonCall(dyn_function_type *func, const char *id, void *args[]) {
+        char *request = nullptr;
+        char *reply = nullptr;
+        int rsErrno = 0;
+        int rc = jsonRpc_prepareInvokeRequest(func, id, args, &request);
+        rc = rc != 0 ? rc : jsonRpc_call(intf, &svc, request, &reply);
+        rc = rc != 0 ? rc : jsonRpc_handleReply(func, reply, args, &rsErrno);
+        assert(rc == 0 && rsErrno == 0);
+        (void)rc;
+        size_t size = strlen(request) + strlen(reply);
+        free(request);
+        free(reply);
+        return size;
+    }
+
+    size_t binaryCall(dyn_function_type *func, const char *id, void *args[]) {
+        void *request = nullptr;
+        size_t requestLen = 0;
+        void *reply = nullptr;
+        size_t replyLen = 0;
+        int rsErrno = 0;
+        int rc = binaryRpc_prepareInvokeRequest(func, id, args, &request, &requestLen);
+        rc = rc != 0 ? rc : binaryRpc_call(intf, &svc, request, requestLen, &reply, &replyLen);
+        rc = rc != 0 ? rc : binaryRpc_handleReply(func, reply, replyLen, args, &rsErrno);
+        assert(rc == 0 && rsErrno == 0);
+        (void)rc;
+        free(request);
+        free(reply);
+        return requestLen + replyLen;
+    }
+
+    dyn_interface_type *intf{nullptr};
+    rpc_service svc{nullptr, calc, sum, weightedSum};
+};
+
+template<bool binary>
+static void RpcSerializationBenchmark_callScalars(benchmark::State& state) {
+    RpcSerializationBenchmark benchmark{};
+    const char *id = "calc(DDIIJJZ)D";
+    auto func = benchmark.function(id);
+    void *handle = nullptr;
+    double a = 1.25;
+    double b = -3.5;
+    int32_t c = 42;
+    int32_t d = -7;
+    int64_t e = 1234567890123;
+    int64_t f = -987654321;
+    bool negate = true;
+    double result = 0.0;
+    double *out = &result;
+    void *args[] = {&handle, &a, &b, &c, &d, &e, &f, &negate, &out};
+
+    size_t size = 0;
+    for (auto _ : state) {
+        size = binary ? benchmark.binaryCall(func, id, args) : benchmark.jsonCall(func, id, args);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["bytes"] = (double)size;
+}
+
+template<bool binary>
+static void RpcSerializationBenchmark_callDoubleSequence(benchmark::State& state) {
+    RpcSerializationBenchmark benchmark{};
+    const char *id = "sum([D)D";
+    auto func = benchmark.function(id);
+    std::vector<double> values((size_t)state.range(0));
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = (double)i * 0.5;
+    }
+    double_seq input{(uint32_t)values.size(), (uint32_t)values.size(), values.data()};
+    void *handle = nullptr;
+    double result = 0.0;
+    double *out = &result;
+    void *args[] = {&handle, &input, &out};
+
+    size_t size = 0;
+    for (auto _ : state) {
+        size = binary ? benchmark.binaryCall(func, id, args) : benchmark.jsonCall(func, id, args);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes"] = (double)size;
+}
+
+template<bool binary>
+static void RpcSerializationBenchmark_callStructSequence(benchmark::State& state) {
+    RpcSerializationBenchmark benchmark{};
+    const char *id = "weightedSum([LSample;)D";
+    auto func = benchmark.function(id);
+    std::vector<sample> samples((size_t)state.range(0));
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = sample{(double)i * 0.5, (int32_t)(i % 10)};
+    }
+    sample_seq input{(uint32_t)samples.size(), (uint32_t)samples.size(), samples.data()};
+    void *handle = nullptr;
+    double result = 0.0;
+    double *out = &result;
+    void *args[] = {&handle, &input, &out};
+
+    size_t size = 0;
+    for (auto _ : state) {
+        size = binary ? benchmark.binaryCall(func, id, args) : benchmark.jsonCall(func, id, args);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes"] = (double)size;
+}
+
+BENCHMARK_TEMPLATE(RpcSerializationBenchmark_callScalars, false)->Name("RpcSerializationBenchmark_callScalars/json");
+BENCHMARK_TEMPLATE(RpcSerializationBenchmark_callScalars, true)->Name("RpcSerializationBenchmark_callScalars/binary");
+BENCHMARK_TEMPLATE(RpcSerializationBenchmark_callDoubleSequence, false)->Name("RpcSerializationBenchmark_callDoubleSequence/json")->RangeMultiplier(16)->Range(16, 16384);
+BENCHMARK_TEMPLATE(RpcSerializationBenchmark_callDoubleSequence, true)->Name("RpcSerializationBenchmark_callDoubleSequence/binary")->RangeMultiplier(16)->Range(16, 16384);
+BENCHMARK_TEMPLATE(RpcSerializationBenchmark_callStructSequence, false)->Name("RpcSerializationBenchmark_callStructSequence/json")->RangeMultiplier(16)->Range(16, 16384);
+BENCHMARK_TEMPLATE(RpcSerializationBenchmark_callStructSequence, true)->Name("RpcSerializationBenchmark_callStructSequence/binary")->RangeMultiplier(16)->Range(16, 16384);
@@ -0,0 +1,330 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "dyn_common.h"
+#include "dyn_type.h"
+#include "dyn_function.h"
+#include "dyn_interface.h"
+#include "binary_rpc.h"
+#include "celix_errno.h"
+
+namespace {
+    struct tst_double_seq {
+        uint32_t cap;
+        uint32_t len;
+        double *buf;
+    };
+
+    struct tst_item {
+        double a;
+        const char *b;
+        int32_t c;
+    };
+
+    struct tst_item_seq {
+        uint32_t cap;
+        uint32_t len;
+        struct tst_item **buf;
+    };
+
+    //StatsResult={DDD[D average min max input}
+    struct tst_stats_result {
+        double average;
+        double min;
+        double max;
+        struct tst_double_seq input;
+    };
+
+    struct tst_serv {
+        void *handle;
+        int (*sumItems)(void *, struct tst_item_seq, bool, const char *, double *);
+        int (*stats)(void *, struct tst_double_seq, struct tst_stats_result **);
+        int (*getName)(void *, const char *, char **);
+    };
+
+    int sumItems(void*, struct tst_item_seq items, bool negate, const char *name, double *result) {
+        *result = 0.0;
+        for (uint32_t i = 0; i < items.len; ++i) {
+            *result += items.buf[i]->a + items.buf[i]->c;
+        }
+        if (negate) {
+            *result = -*result;
+        }
+        return strcmp(name, "sum") == 0 ? 0 : CELIX_CUSTOMER_ERROR_MAKE(0, 1);
+    }
+
+    int stats(void*, struct tst_double_seq input, struct tst_stats_result **out) {
+        auto result = static_cast<tst_stats_result *>(calloc(1, sizeof(tst_stats_result)));
+        double total = 0.0;
+        result->min = input.len > 0 ? input.buf[0] : 0.0;
+        result->max = result->min;
+        for (uint32_t i = 0; i < input.len; ++i) {
+            total += input.buf[i];
+            result->min = input.buf[i] < result->min ? input.buf[i] : result->min;
+            result->max = input.buf[i] > result->max ? input.buf[i] : result->max;
+        }
+        result->average = input.len > 0 ? total / input.len : 0.0;
+        result->input.buf = static_cast<double *>(calloc(input.len, sizeof(double)));
+        memcpy(result->input.buf, input.buf, input.len * sizeof(double));
+        result->input.len = input.len;
+        result->input.cap = input.len;
+        *out = result;
+        return 0;
+    }
+
+    int getName(void*, const char *prefix, char **name) {
+        if (asprintf(name, "%s-name", prefix == nullptr ? "null" : prefix) < 0) {
+            return CELIX_ENOMEM;
+        }
+        return 0;
+    }
+
+    const char* DESCRIPTOR = ":header\ntype=interface\nname=binary\nversion=1.0.0\n"
+                             ":types\nItem={D#const=true;tI a b c}\nStatsResult={DDD[D average min max input}\n"
+                             ":methods\n"
+                             "sumItems([LItem;Zt)D=sumItems(#am=handle;P[LItem;Z#const=true;t#am=pre;*D)N\n"
+                             "stats([D)LStatsResult;=stats(#am=handle;P[D#am=out;*LStatsResult;)N\n"
+                             "getName(t)t=getName(#am=handle;P#const=true;t#am=out;*t)N\n";
+}
+
+class BinaryRpcTests : public ::testing::Test {
+public:
+    BinaryRpcTests() {
+        int lvl = 1;
+        dynCommon_logSetup(nullptr, nullptr, lvl);
+        dynType_logSetup(nullptr, nullptr, lvl);
+        dynFunction_logSetup(nullptr, nullptr, lvl);
+        dynInterface_logSetup(nullptr, nullptr, lvl);
+        binaryRpc_logSetup(nullptr, nullptr, lvl);
+
+        FILE *desc = fmemopen((void *)DESCRIPTOR, strlen(DESCRIPTOR), "r");
+        EXPECT_TRUE(desc != nullptr);
+        EXPECT_EQ(0, dynInterface_parse(desc, &intf));
+        fclose(desc);
+    }
+
+    ~BinaryRpcTests() override {
+        dynInterface_destroy(intf);
+    }
+
+    BinaryRpcTests(const BinaryRpcTests&) = delete;
+    BinaryRpcTests& operator=(const BinaryRpcTests&) = delete;
+
+    dyn_function_type* function(const char *name) {
+        struct methods_head *head = nullptr;
+        dynInterface_methods(intf, &head);
+        struct method_entry *entry = nullptr;
+        TAILQ_FOREACH(entry, head, entries) {
+            if (strcmp(entry->name, name) == 0) {
+                return entry->dynFunc;
+            }
+        }
+        return nullptr;
+    }
+
+    dyn_interface_type *intf{nullptr};
+    tst_serv serv{nullptr, sumItems, stats, getName};
+};
+
+TEST_F(BinaryRpcTests, callWithPreAllocatedOutput) {
+    auto func = function("sumItems");
+    ASSERT_TRUE(func != nullptr);
+
+    tst_item item1{1.5, "x", 2};
+    tst_item item2{0.5, nullptr, -1};
+    tst_item *items[] = {&item1, &item2};
+    tst_item_seq seq{2, 2, items};
+    bool negate = true;
+    const char *name = "sum";
+    void *handle = nullptr;
+    double result = 0.0;
+    double *out = &result;
+    void *args[5] = {&handle, &seq, &negate, &name, &out};
+
+    void *request = nullptr;
+    size_t requestLen = 0;
+    ASSERT_EQ(0, binaryRpc_prepareInvokeRequest(func, "sumItems([LItem;Zt)D", args, &request, &requestLen));
+    const char *id = nullptr;
+    ASSERT_EQ(0, binaryRpc_getMethodId(request, requestLen, &id));
+    EXPECT_STREQ("sumItems([LItem;Zt)D", id);
+
+    void *reply = nullptr;
+    size_t replyLen = 0;
+    ASSERT_EQ(0, binaryRpc_call(intf, &serv, request, requestLen, &reply, &replyLen));
+    int rsErrno = -1;
+    ASSERT_EQ(0, binaryRpc_handleReply(func, reply, replyLen, args, &rsErrno));
+    EXPECT_EQ(0, rsErrno);
+    EXPECT_EQ(-3.0, result);
+    free(reply);
+    free(request);
+
+    //a call that fails returns the error of the remote function
+    name = "other";
+    ASSERT_EQ(0, binaryRpc_prepareInvokeRequest(func, "sumItems([LItem;Zt)D", args, &request, &requestLen));
+    ASSERT_EQ(0, binaryRpc_call(intf, &serv, request, requestLen, &reply, &replyLen));
+    ASSERT_EQ(0, binaryRpc_handleReply(func, reply, replyLen, args, &rsErrno));
+    EXPECT_EQ(CELIX_CUSTOMER_ERROR_MAKE(0, 1), rsErrno);
+    free(reply);
+    free(request);
+}
+
+TEST_F(BinaryRpcTests, callWithOutput) {
+    auto func = function("stats");
+    ASSERT_TRUE(func != nullptr);
+
+    double values[] = {1.0, 2.0, -3.5, 8.25};
+    tst_double_seq seq{4, 4, values};
+    void *handle = nullptr;
+    tst_stats_result *result = nullptr;
+    void *out = &result;
+    void *args[3] = {&handle, &seq, &out};
+
+    void *request = nullptr;
+    size_t requestLen = 0;
+    ASSERT_EQ(0, binaryRpc_prepareInvokeRequest(func, "stats([D)LStatsResult;", args, &request, &requestLen));
+    //header, method id, sequence length and the items
+    EXPECT_EQ(4 + strlen("stats([D)LStatsResult;") + 1 + 4 + sizeof(values), requestLen);
+    void *reply = nullptr;
+    size_t replyLen = 0;
+    ASSERT_EQ(0, binaryRpc_call(intf, &serv, request, requestLen, &reply, &replyLen));
+    int rsErrno = -1;
+    ASSERT_EQ(0, binaryRpc_handleReply(func, reply, replyLen, args, &rsErrno));
+    EXPECT_EQ(0, rsErrno);
+    ASSERT_TRUE(result != nullptr);
+    EXPECT_EQ(1.9375, result->average);
+    EXPECT_EQ(-3.5, result->min);
+    EXPECT_EQ(8.25, result->max);
+    ASSERT_EQ(4u, result->input.len);
+    EXPECT_EQ(0, memcmp(values, result->input.buf, sizeof(values)));
+
+    free(result->input.buf);
+    free(result);
+    free(reply);
+    free(request);
+}
+
+TEST_F(BinaryRpcTests, callWithStringOutput) {
+    auto func = function("getName");
+    ASSERT_TRUE(func != nullptr);
+
+    void *handle = nullptr;
+    const char *prefix = "prefix\xc3\xa9";
+    char *result = nullptr;
+    void *out = &result;
+    void *args[3] = {&handle, &prefix, &out};
+
+    void *request = nullptr;
+    size_t requestLen = 0;
+    ASSERT_EQ(0, binaryRpc_prepareInvokeRequest(func, "getName(t)t", args, &request, &requestLen));
+    void *reply = nullptr;
+    size_t replyLen = 0;
+    ASSERT_EQ(0, binaryRpc_call(intf, &serv, request, requestLen, &reply, &replyLen));
+    int rsErrno = -1;
+    ASSERT_EQ(0, binaryRpc_handleReply(func, reply, replyLen, args, &rsErrno));
+    EXPECT_STREQ("prefix\xc3\xa9-name", result);
+    free(result);
+    free(reply);
+    free(request);
+
+    //a NULL string
+    prefix = nullptr;
+    ASSERT_EQ(0, binaryRpc_prepareInvokeRequest(func, "getName(t)t", args, &request, &requestLen));
+    ASSERT_EQ(0, binaryRpc_call(intf, &serv, request, requestLen, &reply, &replyLen));
+    ASSERT_EQ(0, binaryRpc_handleReply(func, reply, replyLen, args, &rsErrno));
+    EXPECT_STREQ("null-name", result);
+    free(result);
+    free(reply);
+    free(request);
+}
+
+TEST_F(BinaryRpcTests, invalidRequests) {
+    auto func = function("stats");
+    ASSERT_TRUE(func != nullptr);
+    double values[] = {1.0, 2.0};
+    tst_double_seq seq{2, 2, values};
+    void *handle = nullptr;
+    void *out = nullptr;
+    void *args[3] = {&handle, &seq, &out};
+    void *request = nullptr;
+    size_t requestLen = 0;
+    ASSERT_EQ(0, binaryRpc_prepareInvokeRequest(func, "stats([D)LStatsResult;", args, &request, &requestLen));
+    auto bytes = static_cast<uint8_t *>(request);
+
+    void *reply = nullptr;
+    size_t replyLen = 0;
+    //truncated
+    for (size_t len = 0; len < requestLen; ++len) {
+        EXPECT_NE(0, binaryRpc_call(intf, &serv, request, len, &reply, &replyLen)) << len;
+    }
+
+    //trailing data
+    auto *longer = static_cast<uint8_t *>(malloc(requestLen + 1));
+    memcpy(longer, request, requestLen);
+    longer[requestLen] = 0;
+    EXPECT_NE(0, binaryRpc_call(intf, &serv, longer, requestLen + 1, &reply, &replyLen));
+    free(longer);
+
+    //sequence length larger than the request
+    size_t seqOffset = 4 + strlen("stats([D)LStatsResult;") + 1;
+    uint32_t hugeLen = UINT32_MAX - 1;
+    memcpy(bytes + seqOffset, &hugeLen, sizeof(hugeLen));
+    EXPECT_NE(0, binaryRpc_call(intf, &serv, request, requestLen, &reply, &replyLen));
+
+    //unknown method
+    bytes[4] = 'x';
+    EXPECT_NE(0, binaryRpc_call(intf, &serv, request, requestLen, &reply, &replyLen));
+
+    //not a binary request
+    const char *id = nullptr;
+    const char *json = R"({"m": "stats([D)LStatsResult;", "a": [[1.0]]})";
+    EXPECT_NE(0, binaryRpc_getMethodId(json, strlen(json) + 1, &id));
+    EXPECT_NE(0, binaryRpc_call(intf, &serv, json, strlen(json) + 1, &reply, &replyLen));
+
+    free(request);
+}
+
+TEST_F(BinaryRpcTests, invalidReplies) {
+    auto func = function("getName");
+    ASSERT_TRUE(func != nullptr);
+    char *result = nullptr;
+    void *out = &result;
+    void *args[3] = {nullptr, nullptr, &out};
+    int rsErrno = 0;
+
+    const uint8_t emptyReply[] = {'C', 'X', 'B', '1', 0};
+    EXPECT_EQ(0, binaryRpc_handleReply(func, emptyReply, sizeof(emptyReply), args, &rsErrno));
+    EXPECT_EQ(nullptr, result);
+
+    const uint8_t unknownKind[] = {'C', 'X', 'B', '1', 3};
+    EXPECT_NE(0, binaryRpc_handleReply(func, unknownKind, sizeof(unknownKind), args, &rsErrno));
+
+    const uint8_t truncatedString[] = {'C', 'X', 'B', '1', 1, 4, 0, 0, 0, 'a', 'b'};
+    EXPECT_NE(0, binaryRpc_handleReply(func, truncatedString, sizeof(truncatedString), args, &rsErrno));
+    EXPECT_EQ(nullptr, result);
+
+    const uint8_t wrongMagic[] = {'C', 'X', 'B', '2', 0};
+    EXPECT_NE(0, binaryRpc_handleReply(func, wrongMagic, sizeof(wrongMagic), args, &rsErrno));
+}
@@ -186,6 +186,71 @@ extern "C" {
         fclose(desc); desc=NULL;
 
     }
+
+    static void testFindMethod(void) {
+        int status = 0;
+        dyn_interface_type *dynIntf = NULL;
+        FILE *desc = fopen("descriptors/example1.descriptor", "r");
+        assert(desc != NULL);
+        status = dynInterface_parse(desc, &dynIntf);
+        ASSERT_EQ(0, status);
+        fclose(desc);
+
+        struct methods_head *list = NULL;
+        dynInterface_methods(dynIntf, &list);
+        struct method_entry *entry = NULL;
+        TAILQ_FOREACH(entry, list, entries) {
+            struct method_entry *found = NULL;
+            status = dynInterface_findMethod(dynIntf, entry->id, &found);
+            ASSERT_EQ(0, status);
+            ASSERT_EQ(entry, found);
+        }
+
+        struct method_entry *found = NULL;
+        status = dynInterface_findMethod(dynIntf, "mul(DD)D", &found);
+        ASSERT_EQ(1, status);
+        ASSERT_TRUE(found == NULL);
+        status = dynInterface_findMethod(dynIntf, "", &found);
+        ASSERT_EQ(1, status);
+
+        dynInterface_destroy(dynIntf);
+    }
+
+    static void testFindMethodOfLargeInterface(void) {
+        const int nrOfMethods = 500;
+        char *descriptor = NULL;
+        size_t descriptorSize = 0;
+        FILE *stream = open_memstream(&descriptor, &descriptorSize);
+        assert(stream != NULL);
+        fprintf(stream, ":header\ntype=interface\nname=large\nversion=1.0.0\n:methods\n");
+        for (int i = 0; i < nrOfMethods; ++i) {
+            fprintf(stream, "method%i(D)D=method%i(#am=handle;PD#am=pre;*D)N\n", i, i);
+        }
+        fclose(stream);
+
+        dyn_interface_type *dynIntf = NULL;
+        FILE *desc = fmemopen(descriptor, strlen(descriptor), "r");
+        int status = dynInterface_parse(desc, &dynIntf);
+        ASSERT_EQ(0, status);
+        fclose(desc);
+        free(descriptor);
+        ASSERT_EQ(nrOfMethods, dynInterface_nrOfMethods(dynIntf));
+
+        for (int i = 0; i < nrOfMethods; ++i) {
+            char id[32];
+            snprintf(id, sizeof(id), "method%i(D)D", i);
+            struct method_entry *found = NULL;
+            status = dynInterface_findMethod(dynIntf, id, &found);
+            ASSERT_EQ(0, status);
+            ASSERT_STREQ(id, found->id);
+            ASSERT_EQ(i, found->index);
+        }
+        struct method_entry *found = NULL;
+        status = dynInterface_findMethod(dynIntf, "method500(D)D", &found);
+        ASSERT_EQ(1, status);
+
+        dynInterface_destroy(dynIntf);
+    }
 }
 
 class DynInterfaceTests : public ::testing::Test {
@@ -214,3 +279,11 @@ TEST_F(DynInterfaceTests, testInvalid) {
     testInvalid();
 }
 
+
+TEST_F(DynInterfaceTests, testFindMethod) {
+    testFindMethod();
+}
+
+TEST_F(DynInterfaceTests, testFindMethodOfLargeInterface) {
+    testFindMethodOfLargeInterface();
+}
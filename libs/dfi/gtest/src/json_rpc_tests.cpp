@@ -445,6 +445,65 @@ static void stdLog(void*, int level, const char *file, int line, const char *msg
     }
 }
 
+namespace {
+    //The invoke request as created with jansson, before streaming was introduced
+    char* prepareInvokeRequestWithJansson(dyn_function_type *func, const char *id, void *args[]) {
+        json_t *invoke = json_object();
+        json_object_set_new_nocheck(invoke, "m", json_string(id));
+        json_t *arguments = json_array();
+        json_object_set_new_nocheck(invoke, "a", arguments);
+        int nrOfArgs = dynFunction_nrOfArguments(func);
+        for (int i = 0; i < nrOfArgs; i += 1) {
+            if (dynFunction_argumentMetaForIndex(func, i) == DYN_FUNCTION_ARGUMENT_META__STD) {
+                json_t *val = nullptr;
+                EXPECT_EQ(0, jsonSerializer_serializeJson(dynFunction_argumentTypeForIndex(func, i), args[i], &val));
+                json_array_append_new(arguments, val);
+            }
+        }
+        char *result = json_dumps(invoke, JSON_DECODE_ANY);
+        json_decref(invoke);
+        return result;
+    }
+
+    struct tst_item {
+        double a;
+        const char *b;
+        int32_t c;
+    };
+
+    struct tst_item_seq {
+        uint32_t cap;
+        uint32_t len;
+        struct tst_item **buf;
+    };
+
+    struct tst_double_seq {
+        uint32_t cap;
+        uint32_t len;
+        double *buf;
+    };
+
+    int sumItems(void*, struct tst_item_seq items, bool negate, const char *name, double *result) {
+        *result = 0.0;
+        for (uint32_t i = 0; i < items.len; ++i) {
+            *result += items.buf[i]->a + items.buf[i]->c;
+        }
+        if (negate) {
+            *result = -*result;
+        }
+        return strcmp(name, "sumé\n\"") == 0 ? 0 : 1;
+    }
+
+    struct tst_serv_items {
+        void *handle;
+        int (*sumItems)(void *, struct tst_item_seq, bool, const char *, double *);
+    };
+
+    const char* ITEMS_DESCRIPTOR = ":header\ntype=interface\nname=items\nversion=1.0.0\n"
+                                   ":types\nItem={D#const=true;tI a b c}\n"
+                                   ":methods\nsumItems([LItem;Zt)D=sumItems(#am=handle;P[LItem;Z#const=true;t#am=pre;*D)N\n";
+}
+
 class JsonRpcTests : public ::testing::Test {
 public:
     JsonRpcTests() {
@@ -500,3 +559,112 @@ TEST_F(JsonRpcTests, handleOutChar) {
 TEST_F(JsonRpcTests, handleReplyError) {
     handleTestReplyError();
 }
+
+
+TEST_F(JsonRpcTests, prepareRequestIsSameAsWithJansson) {
+    dyn_function_type *dynFunc = nullptr;
+    int rc = dynFunction_parseWithStr("example(#am=handle;PDJZ#const=true;t[D{DI a b}F#am=pre;*D)N", nullptr, &dynFunc);
+    ASSERT_EQ(0, rc);
+
+    void *handle = nullptr;
+    double d = 1.0/3.0;
+    int64_t j = -1234567890123LL;
+    bool z = true;
+    const char *str = "quote\" backslash\\ newline\n tab\t control\x01 slash/ unicodeé\U0001F600";
+    double values[] = {0.0, -1.5, 1e300, 2.5e-5, 100.0};
+    tst_double_seq seq {5, 5, values};
+    struct { double a; int32_t b; } complex {-0.1, 42};
+    float f = 0.25f;
+
+    void *args[9] = {&handle, &d, &j, &z, &str, &seq, &complex, &f, nullptr};
+    char *result = nullptr;
+    rc = jsonRpc_prepareInvokeRequest(dynFunc, "example", args, &result);
+    ASSERT_EQ(0, rc);
+    char *expected = prepareInvokeRequestWithJansson(dynFunc, "example", args);
+    ASSERT_STREQ(expected, result);
+
+    free(expected);
+    free(result);
+    dynFunction_destroy(dynFunc);
+}
+
+TEST_F(JsonRpcTests, prepareRequestWithoutArguments) {
+    dyn_function_type *dynFunc = nullptr;
+    int rc = dynFunction_parseWithStr("get(#am=handle;P#am=pre;*D)N", nullptr, &dynFunc);
+    ASSERT_EQ(0, rc);
+
+    void *handle = nullptr;
+    void *args[2] = {&handle, nullptr};
+    char *result = nullptr;
+    rc = jsonRpc_prepareInvokeRequest(dynFunc, "get", args, &result);
+    ASSERT_EQ(0, rc);
+    ASSERT_STREQ("{\n    \"m\": \"get\",\n    \"a\": []\n}", result);
+
+    free(result);
+    dynFunction_destroy(dynFunc);
+}
+
+TEST_F(JsonRpcTests, prepareRequestWithNullStringFallsBackToJansson) {
+    dyn_function_type *dynFunc = nullptr;
+    int rc = dynFunction_parseWithStr("setName(#am=handle;P#const=true;tD#am=pre;*D)N", nullptr, &dynFunc);
+    ASSERT_EQ(0, rc);
+
+    void *handle = nullptr;
+    const char *str = nullptr;
+    double d = 2.0;
+    void *args[4] = {&handle, &str, &d, nullptr};
+    char *result = nullptr;
+    rc = jsonRpc_prepareInvokeRequest(dynFunc, "setName", args, &result);
+    ASSERT_EQ(0, rc);
+    char *expected = prepareInvokeRequestWithJansson(dynFunc, "setName", args);
+    ASSERT_STREQ(expected, result);
+
+    free(expected);
+    free(result);
+    dynFunction_destroy(dynFunc);
+}
+
+TEST_F(JsonRpcTests, callWithStreamedArguments) {
+    dyn_interface_type *intf = nullptr;
+    FILE *desc = fmemopen((void *)ITEMS_DESCRIPTOR, strlen(ITEMS_DESCRIPTOR), "r");
+    ASSERT_TRUE(desc != nullptr);
+    int rc = dynInterface_parse(desc, &intf);
+    ASSERT_EQ(0, rc);
+    fclose(desc);
+
+    tst_serv_items serv {nullptr, sumItems};
+    char *result = nullptr;
+    //note the arguments before the method and an unknown member, which is ignored
+    rc = jsonRpc_call(intf, &serv, R"({"a": [[{"a": 1.5, "b": "x", "c": 2}, {"c": -1, "a": 0.5, "b": null}], true, "sumé\n\""],)"
+                                   R"( "x": {"y": [1, 2.0e1, "z", false, null]}, "m": "sumItems([LItem;Zt)D"})", &result);
+    ASSERT_EQ(0, rc);
+    ASSERT_STREQ("{\n    \"r\": -3.0\n}", result);
+    free(result);
+
+    //a wrong JSON type for an argument (integer for a double), which is left to json_serializer
+    result = nullptr;
+    rc = jsonRpc_call(intf, &serv, R"({"m": "sumItems([LItem;Zt)D", "a": [[{"a": 1, "c": 2}], false, "sumé\n\""]})", &result);
+    ASSERT_EQ(0, rc);
+    ASSERT_STREQ("{\n    \"r\": 2.0\n}", result);
+    free(result);
+
+    //a call that fails
+    result = nullptr;
+    rc = jsonRpc_call(intf, &serv, R"({"m": "sumItems([LItem;Zt)D", "a": [[], false, "other"]})", &result);
+    ASSERT_EQ(0, rc);
+    ASSERT_STREQ("{\n    \"e\": 1\n}", result);
+    free(result);
+
+    //unknown method
+    result = nullptr;
+    rc = jsonRpc_call(intf, &serv, R"({"m": "unknown()V", "a": []})", &result);
+    ASSERT_NE(0, rc);
+    ASSERT_TRUE(result == nullptr);
+
+    //unknown member of a complex type, which is an error for json_serializer
+    rc = jsonRpc_call(intf, &serv, R"({"m": "sumItems([LItem;Zt)D", "a": [[{"d": 1.0}], false, "other"]})", &result);
+    ASSERT_NE(0, rc);
+    ASSERT_TRUE(result == nullptr);
+
+    dynInterface_destroy(intf);
+}
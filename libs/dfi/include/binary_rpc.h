@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __BINARY_RPC_H_
+#define __BINARY_RPC_H_
+
+#include <stddef.h>
+#include "dfi_log_util.h"
+#include "dyn_type.h"
+#include "dyn_function.h"
+#include "dyn_interface.h"
+#include "celix_dfi_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Compact binary alternative for json_rpc, with the same call semantics as jsonRpc_call,
+ * jsonRpc_prepareInvokeRequest and jsonRpc_handleReply.
+ *
+ * Values are encoded without text conversion: booleans and 8 bit integers as a single byte, other integers,
+ * enums and floating point values as fixed size little endian values, strings and sequences as a 32 bit
+ * length followed by the bytes or items, typed pointers as a presence byte followed by the value and complex
+ * types as their members in declaration order. Sequences of numeric items are copied as a whole on little endian hosts.
+ *
+ * A request consists of a header, the null-terminated method id and the (input) arguments. A reply consists of
+ * a header and either nothing, the result or the error code of the remote function.
+ */
+
+//logging
+DFI_SETUP_LOG_HEADER(binaryRpc);
+
+/**
+ * @brief Handle a binary request for service and create the binary reply.
+ * @param[in] intf The interface of the service.
+ * @param[in] service The service.
+ * @param[in] request The request, as created by binaryRpc_prepareInvokeRequest.
+ * @param[in] requestLen The size of the request.
+ * @param[out] out The reply, allocated with malloc.
+ * @param[out] outLen The size of the reply.
+ * @return 0 on success, 1 if the request is invalid or the reply cannot be created.
+ */
+CELIX_DFI_EXPORT int binaryRpc_call(dyn_interface_type *intf, void *service, const void *request, size_t requestLen,
+                                    void **out, size_t *outLen);
+
+/**
+ * @brief Get the method id of a binary request.
+ * @param[out] id The method id, which points in the request.
+ * @return 0 on success, 1 if the request is not a binary request.
+ */
+CELIX_DFI_EXPORT int binaryRpc_getMethodId(const void *request, size_t requestLen, const char **id);
+
+/**
+ * @brief Create a binary request for a call of func with args. As with jsonRpc_prepareInvokeRequest,
+ * non-const string arguments are owned (and freed) by this function.
+ * @param[out] out The request, allocated with malloc.
+ * @param[out] outLen The size of the request.
+ */
+CELIX_DFI_EXPORT int binaryRpc_prepareInvokeRequest(dyn_function_type *func, const char *id, void *args[],
+                                                    void **out, size_t *outLen);
+
+/**
+ * @brief Handle a binary reply of a call of func and set the output arguments in args.
+ * @param[out] rsErrno The error code of the remote function, 0 if the remote function succeeded.
+ */
+CELIX_DFI_EXPORT int binaryRpc_handleReply(dyn_function_type *func, const void *reply, size_t replyLen, void *args[],
+                                           int *rsErrno);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
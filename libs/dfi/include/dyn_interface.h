@@ -67,6 +67,14 @@ CELIX_DFI_EXPORT int dynInterface_getHeaderEntry(dyn_interface_type *intf, const
 CELIX_DFI_EXPORT int dynInterface_getAnnotationEntry(dyn_interface_type *intf, const char *name, char **value);
 CELIX_DFI_EXPORT int dynInterface_methods(dyn_interface_type *intf, struct methods_head **list);
 CELIX_DFI_EXPORT int dynInterface_nrOfMethods(dyn_interface_type *intf);
+/**
+ * @brief Find the method with the given id (e.g. "add(DD)D").
+ *
+ * A perfect hash table of the method ids is created when the interface is parsed, so the lookup costs a single
+ * hash and string compare, independent of the number of methods.
+ * @return 0 if the method is found, 1 otherwise.
+ */
+CELIX_DFI_EXPORT int dynInterface_findMethod(dyn_interface_type *intf, const char *id, struct method_entry **method);
 
 // Avpr parsing
 CELIX_DFI_DEPRECATED_EXPORT dyn_interface_type * dynInterface_parseAvprWithStr(const char * avpr);
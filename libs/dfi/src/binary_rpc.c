@@ -0,0 +1,823 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "binary_rpc.h"
+#include "dyn_type_common.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ffi.h>
+
+static const int OK = 0;
+static const int ERROR = 1;
+
+DFI_SETUP_LOG(binaryRpc);
+
+#define BINARY_RPC_MAGIC 0x31425843u //"CXB1" as little endian
+#define BINARY_RPC_NULL_LENGTH UINT32_MAX
+#define BINARY_RPC_MIN_CAPACITY 64
+#define BINARY_RPC_MAX_DEPTH 2048
+
+#define BINARY_RPC_REPLY_EMPTY 0
+#define BINARY_RPC_REPLY_RESULT 1
+#define BINARY_RPC_REPLY_ERROR 2
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define BINARY_RPC_LITTLE_ENDIAN 0
+#define BINARY_RPC_LE16(x) __builtin_bswap16(x)
+#define BINARY_RPC_LE32(x) __builtin_bswap32(x)
+#define BINARY_RPC_LE64(x) __builtin_bswap64(x)
+#else
+#define BINARY_RPC_LITTLE_ENDIAN 1
+#define BINARY_RPC_LE16(x) (x)
+#define BINARY_RPC_LE32(x) (x)
+#define BINARY_RPC_LE64(x) (x)
+#endif
+
+_Static_assert(sizeof(int) == sizeof(int32_t), "'N' is encoded as a 32 bit integer");
+_Static_assert(sizeof(float) == sizeof(uint32_t) && sizeof(double) == sizeof(uint64_t), "IEEE 754 floating point expected");
+
+typedef void (*gen_func_type)(void);
+
+struct generic_service_layout {
+    void *handle;
+    gen_func_type methods[];
+};
+
+//The layout of a sequence, see dyn_type.h
+struct binary_rpc_sequence {
+    uint32_t cap;
+    uint32_t len;
+    void *buf;
+};
+
+typedef struct binary_rpc_writer {
+    uint8_t *buf;
+    size_t len;
+    size_t cap;
+    bool allocFailed;
+} binary_rpc_writer_t;
+
+typedef struct binary_rpc_reader {
+    const uint8_t *pos;
+    const uint8_t *end;
+    int depth;
+} binary_rpc_reader_t;
+
+/**
+ * Per thread size of the last written request and response, used as initial capacity of the next one.
+ */
+static __thread size_t g_requestSizeHint = 0;
+static __thread size_t g_responseSizeHint = 0;
+
+static int binaryRpc_readAny(binary_rpc_reader_t *reader, dyn_type *type, void *loc);
+
+static void binaryRpc_writerInit(binary_rpc_writer_t *writer, size_t capacity) {
+    writer->cap = capacity < BINARY_RPC_MIN_CAPACITY ? BINARY_RPC_MIN_CAPACITY : capacity;
+    writer->buf = malloc(writer->cap);
+    writer->len = 0;
+    writer->allocFailed = writer->buf == NULL;
+}
+
+static bool binaryRpc_reserve(binary_rpc_writer_t *writer, size_t extra) {
+    if (writer->allocFailed) {
+        return false;
+    }
+    if (writer->len + extra > writer->cap) {
+        size_t cap = writer->cap * 2;
+        while (writer->len + extra > cap) {
+            cap *= 2;
+        }
+        uint8_t *buf = realloc(writer->buf, cap);
+        if (buf == NULL) {
+            writer->allocFailed = true;
+            return false;
+        }
+        writer->buf = buf;
+        writer->cap = cap;
+    }
+    return true;
+}
+
+static void binaryRpc_writeBytes(binary_rpc_writer_t *writer, const void *data, size_t len) {
+    if (len > 0 && binaryRpc_reserve(writer, len)) {
+        memcpy(writer->buf + writer->len, data, len);
+        writer->len += len;
+    }
+}
+
+static void binaryRpc_writeU8(binary_rpc_writer_t *writer, uint8_t value) {
+    binaryRpc_writeBytes(writer, &value, sizeof(value));
+}
+
+static void binaryRpc_writeU16(binary_rpc_writer_t *writer, uint16_t value) {
+    value = BINARY_RPC_LE16(value);
+    binaryRpc_writeBytes(writer, &value, sizeof(value));
+}
+
+static void binaryRpc_writeU32(binary_rpc_writer_t *writer, uint32_t value) {
+    value = BINARY_RPC_LE32(value);
+    binaryRpc_writeBytes(writer, &value, sizeof(value));
+}
+
+static void binaryRpc_writeU64(binary_rpc_writer_t *writer, uint64_t value) {
+    value = BINARY_RPC_LE64(value);
+    binaryRpc_writeBytes(writer, &value, sizeof(value));
+}
+
+static int binaryRpc_writeString(binary_rpc_writer_t *writer, const char *str) {
+    if (str == NULL) {
+        binaryRpc_writeU32(writer, BINARY_RPC_NULL_LENGTH);
+        return OK;
+    }
+    size_t len = strlen(str);
+    if (len >= BINARY_RPC_NULL_LENGTH) {
+        return ERROR;
+    }
+    binaryRpc_writeU32(writer, (uint32_t)len);
+    binaryRpc_writeBytes(writer, str, len);
+    return OK;
+}
+
+/**
+ * Returns the encoded size of the item type if sequences of it can be copied as a whole, otherwise 0.
+ */
+static size_t binaryRpc_bulkItemSize(dyn_type *itemType) {
+    switch (dynType_descriptorType(itemType)) {
+        case 'B' :
+        case 'b' :
+            return 1;
+        case 'S' :
+        case 's' :
+            return 2;
+        case 'I' :
+        case 'i' :
+        case 'N' :
+        case 'F' :
+            return 4;
+        case 'J' :
+        case 'j' :
+        case 'D' :
+            return 8;
+        default :
+            return 0;
+    }
+}
+
+static int binaryRpc_writeAny(binary_rpc_writer_t *writer, dyn_type *type, const void *input);
+
+static int binaryRpc_writeComplex(binary_rpc_writer_t *writer, dyn_type *type, const void *input) {
+    int status = OK;
+    size_t nrOfEntries = dynType_complex_nrOfEntries(type);
+    for (size_t i = 0; status == OK && i < nrOfEntries; ++i) {
+        void *valLoc = NULL;
+        dyn_type *subType = NULL;
+        status = dynType_complex_valLocAt(type, (int)i, (void *)input, &valLoc);
+        if (status == OK) {
+            status = dynType_complex_dynTypeAt(type, (int)i, &subType);
+        }
+        if (status == OK) {
+            status = binaryRpc_writeAny(writer, subType, valLoc);
+        }
+    }
+    return status;
+}
+
+static int binaryRpc_writeSequence(binary_rpc_writer_t *writer, dyn_type *type, const void *input) {
+    const struct binary_rpc_sequence *seq = input;
+    dyn_type *itemType = dynType_sequence_itemType(type);
+    size_t itemSize = dynType_size(itemType);
+    binaryRpc_writeU32(writer, seq->len);
+    if (seq->len > 0 && seq->buf == NULL) {
+        return ERROR;
+    }
+    if (BINARY_RPC_LITTLE_ENDIAN && binaryRpc_bulkItemSize(itemType) == itemSize) {
+        binaryRpc_writeBytes(writer, seq->buf, (size_t)seq->len * itemSize);
+        return OK;
+    }
+    int status = OK;
+    for (uint32_t i = 0; status == OK && i < seq->len; ++i) {
+        status = binaryRpc_writeAny(writer, itemType, (const uint8_t *)seq->buf + i * itemSize);
+    }
+    return status;
+}
+
+static int binaryRpc_writeAny(binary_rpc_writer_t *writer, dyn_type *type, const void *input) {
+    int status = OK;
+    dyn_type *subType = NULL;
+    uint32_t u32 = 0;
+    uint64_t u64 = 0;
+    switch (dynType_descriptorType(type)) {
+        case 'Z' :
+            binaryRpc_writeU8(writer, *(const bool *)input ? 1 : 0);
+            break;
+        case 'B' :
+        case 'b' :
+            binaryRpc_writeU8(writer, *(const uint8_t *)input);
+            break;
+        case 'S' :
+        case 's' :
+            binaryRpc_writeU16(writer, *(const uint16_t *)input);
+            break;
+        case 'I' :
+        case 'i' :
+        case 'E' :
+        case 'N' :
+            binaryRpc_writeU32(writer, *(const uint32_t *)input);
+            break;
+        case 'J' :
+        case 'j' :
+            binaryRpc_writeU64(writer, *(const uint64_t *)input);
+            break;
+        case 'F' :
+            memcpy(&u32, input, sizeof(u32));
+            binaryRpc_writeU32(writer, u32);
+            break;
+        case 'D' :
+            memcpy(&u64, input, sizeof(u64));
+            binaryRpc_writeU64(writer, u64);
+            break;
+        case 't' :
+            status = binaryRpc_writeString(writer, *(const char **)input);
+            break;
+        case '*' :
+            status = dynType_typedPointer_getTypedType(type, &subType);
+            if (status == OK) {
+                binaryRpc_writeU8(writer, *(void **)input != NULL ? 1 : 0);
+                if (*(void **)input != NULL) {
+                    status = binaryRpc_writeAny(writer, subType, *(void **)input);
+                }
+            }
+            break;
+        case '{' :
+            status = binaryRpc_writeComplex(writer, type, input);
+            break;
+        case '[' :
+            status = binaryRpc_writeSequence(writer, type, input);
+            break;
+        case 'l' :
+            status = binaryRpc_writeAny(writer, type->ref.ref, input);
+            break;
+        default :
+            LOG_ERROR("Cannot serialize type '%c'", dynType_descriptorType(type));
+            status = ERROR;
+            break;
+    }
+    if (status == OK && writer->allocFailed) {
+        LOG_ERROR("Error allocating memory for binary rpc data");
+        status = ERROR;
+    }
+    return status;
+}
+
+static void binaryRpc_readerInit(binary_rpc_reader_t *reader, const void *input, size_t len) {
+    reader->pos = input;
+    reader->end = reader->pos + len;
+    reader->depth = 0;
+}
+
+static size_t binaryRpc_remaining(const binary_rpc_reader_t *reader) {
+    return (size_t)(reader->end - reader->pos);
+}
+
+static int binaryRpc_readBytes(binary_rpc_reader_t *reader, void *out, size_t len) {
+    if (binaryRpc_remaining(reader) < len) {
+        return ERROR;
+    }
+    if (len > 0) {
+        memcpy(out, reader->pos, len);
+        reader->pos += len;
+    }
+    return OK;
+}
+
+static int binaryRpc_readU8(binary_rpc_reader_t *reader, uint8_t *value) {
+    return binaryRpc_readBytes(reader, value, sizeof(*value));
+}
+
+static int binaryRpc_readU16(binary_rpc_reader_t *reader, uint16_t *value) {
+    int status = binaryRpc_readBytes(reader, value, sizeof(*value));
+    *value = BINARY_RPC_LE16(*value);
+    return status;
+}
+
+static int binaryRpc_readU32(binary_rpc_reader_t *reader, uint32_t *value) {
+    int status = binaryRpc_readBytes(reader, value, sizeof(*value));
+    *value = BINARY_RPC_LE32(*value);
+    return status;
+}
+
+static int binaryRpc_readU64(binary_rpc_reader_t *reader, uint64_t *value) {
+    int status = binaryRpc_readBytes(reader, value, sizeof(*value));
+    *value = BINARY_RPC_LE64(*value);
+    return status;
+}
+
+static int binaryRpc_readString(binary_rpc_reader_t *reader, char **out) {
+    uint32_t len = 0;
+    int status = binaryRpc_readU32(reader, &len);
+    if (status != OK) {
+        return status;
+    }
+    if (len == BINARY_RPC_NULL_LENGTH) {
+        *out = NULL;
+        return OK;
+    }
+    if (binaryRpc_remaining(reader) < len || memchr(reader->pos, '\0', len) != NULL) {
+        return ERROR;
+    }
+    char *str = malloc((size_t)len + 1);
+    if (str == NULL) {
+        LOG_ERROR("Error allocating memory for string");
+        return ERROR;
+    }
+    memcpy(str, reader->pos, len);
+    str[len] = '\0';
+    reader->pos += len;
+    *out = str;
+    return OK;
+}
+
+static int binaryRpc_createType(binary_rpc_reader_t *reader, dyn_type *type, void **result);
+
+static int binaryRpc_readComplex(binary_rpc_reader_t *reader, dyn_type *type, void *inst) {
+    int status = OK;
+    size_t nrOfEntries = dynType_complex_nrOfEntries(type);
+    for (size_t i = 0; status == OK && i < nrOfEntries; ++i) {
+        void *valLoc = NULL;
+        dyn_type *subType = NULL;
+        status = dynType_complex_valLocAt(type, (int)i, inst, &valLoc);
+        if (status == OK) {
+            status = dynType_complex_dynTypeAt(type, (int)i, &subType);
+        }
+        if (status == OK) {
+            status = binaryRpc_readAny(reader, subType, valLoc);
+        }
+    }
+    return status;
+}
+
+static int binaryRpc_readSequence(binary_rpc_reader_t *reader, dyn_type *type, void *seqLoc) {
+    struct binary_rpc_sequence *seq = seqLoc;
+    uint32_t count = 0;
+    int status = binaryRpc_readU32(reader, &count);
+    if (status != OK || count == 0) {
+        return status;
+    }
+
+    dyn_type *itemType = dynType_sequence_itemType(type);
+    size_t itemSize = dynType_size(itemType);
+    size_t bulkItemSize = binaryRpc_bulkItemSize(itemType);
+    //every encoded item is at least one byte, except for empty complex types which are not supported in sequences
+    size_t minEncodedSize = bulkItemSize > 0 ? bulkItemSize : 1;
+    if (count > binaryRpc_remaining(reader) / minEncodedSize) {
+        return ERROR;
+    }
+    status = dynType_sequence_alloc(type, seqLoc, count);
+    if (status != OK) {
+        return status;
+    }
+    if (BINARY_RPC_LITTLE_ENDIAN && bulkItemSize == itemSize) {
+        status = binaryRpc_readBytes(reader, seq->buf, (size_t)count * itemSize);
+        seq->len = count;
+        return status;
+    }
+    memset(seq->buf, 0, (size_t)count * itemSize);
+    for (uint32_t i = 0; status == OK && i < count; ++i) {
+        //the length is increased first, so that the read items are also freed on error
+        seq->len = i + 1;
+        status = binaryRpc_readAny(reader, itemType, (uint8_t *)seq->buf + i * itemSize);
+    }
+    return status;
+}
+
+static int binaryRpc_readAny(binary_rpc_reader_t *reader, dyn_type *type, void *loc) {
+    int status = OK;
+    dyn_type *subType = NULL;
+    uint8_t u8 = 0;
+    uint16_t u16 = 0;
+    uint32_t u32 = 0;
+    uint64_t u64 = 0;
+
+    if (++reader->depth > BINARY_RPC_MAX_DEPTH) {
+        return ERROR;
+    }
+    switch (dynType_descriptorType(type)) {
+        case 'Z' :
+            status = binaryRpc_readU8(reader, &u8);
+            if (status == OK && u8 > 1) {
+                status = ERROR;
+            }
+            *(bool *)loc = u8 == 1;
+            break;
+        case 'B' :
+        case 'b' :
+            status = binaryRpc_readU8(reader, &u8);
+            *(uint8_t *)loc = u8;
+            break;
+        case 'S' :
+        case 's' :
+            status = binaryRpc_readU16(reader, &u16);
+            *(uint16_t *)loc = u16;
+            break;
+        case 'I' :
+        case 'i' :
+        case 'E' :
+        case 'N' :
+            status = binaryRpc_readU32(reader, &u32);
+            *(uint32_t *)loc = u32;
+            break;
+        case 'F' :
+            status = binaryRpc_readU32(reader, &u32);
+            memcpy(loc, &u32, sizeof(u32));
+            break;
+        case 'J' :
+        case 'j' :
+            status = binaryRpc_readU64(reader, &u64);
+            *(uint64_t *)loc = u64;
+            break;
+        case 'D' :
+            status = binaryRpc_readU64(reader, &u64);
+            memcpy(loc, &u64, sizeof(u64));
+            break;
+        case 't' :
+            status = binaryRpc_readString(reader, (char **)loc);
+            break;
+        case '*' :
+            status = dynType_typedPointer_getTypedType(type, &subType);
+            if (status == OK) {
+                status = binaryRpc_readU8(reader, &u8);
+            }
+            if (status == OK && u8 == 1) {
+                status = binaryRpc_createType(reader, subType, (void **)loc);
+            } else if (status == OK && u8 != 0) {
+                status = ERROR;
+            }
+            break;
+        case '{' :
+            status = binaryRpc_readComplex(reader, type, loc);
+            break;
+        case '[' :
+            status = binaryRpc_readSequence(reader, type, loc);
+            break;
+        case 'l' :
+            status = binaryRpc_readAny(reader, type->ref.ref, loc);
+            break;
+        default :
+            LOG_ERROR("Cannot deserialize type '%c'", dynType_descriptorType(type));
+            status = ERROR;
+            break;
+    }
+    reader->depth -= 1;
+    return status;
+}
+
+/**
+ * Read a value into a newly allocated instance of type (same layout as jsonSerializer_deserializeJson).
+ */
+static int binaryRpc_createType(binary_rpc_reader_t *reader, dyn_type *type, void **result) {
+    void *inst = NULL;
+    int status = OK;
+    if (dynType_descriptorType(type) == 't') {
+        //note as with json_serializer, a deserialized C string is a pointer to the string, which also resides on the heap
+        inst = calloc(1, sizeof(char *));
+        status = inst != NULL ? binaryRpc_readString(reader, (char **)inst) : ERROR;
+    } else {
+        status = dynType_alloc(type, &inst);
+        if (status == OK) {
+            status = binaryRpc_readAny(reader, type, inst);
+        }
+    }
+
+    if (status == OK) {
+        *result = inst;
+    } else {
+        *result = NULL;
+        dynType_free(type, inst);
+    }
+    return status;
+}
+
+static int binaryRpc_readHeader(binary_rpc_reader_t *reader) {
+    uint32_t magic = 0;
+    int status = binaryRpc_readU32(reader, &magic);
+    return status == OK && magic == BINARY_RPC_MAGIC ? OK : ERROR;
+}
+
+static int binaryRpc_readMethodId(binary_rpc_reader_t *reader, const char **id) {
+    size_t remaining = binaryRpc_remaining(reader);
+    const uint8_t *terminator = remaining > 0 ? memchr(reader->pos, '\0', remaining) : NULL;
+    if (terminator == NULL) {
+        return ERROR;
+    }
+    *id = (const char *)reader->pos;
+    reader->pos = terminator + 1;
+    return OK;
+}
+
+int binaryRpc_getMethodId(const void *request, size_t requestLen, const char **id) {
+    binary_rpc_reader_t reader;
+    binaryRpc_readerInit(&reader, request, requestLen);
+    int status = binaryRpc_readHeader(&reader);
+    if (status == OK) {
+        status = binaryRpc_readMethodId(&reader, id);
+    }
+    return status;
+}
+
+static void binaryRpc_writeResult(binary_rpc_writer_t *writer, size_t prefixLen, dyn_type *type, void *input, int *status) {
+    writer->len = prefixLen;
+    binaryRpc_writeU8(writer, BINARY_RPC_REPLY_RESULT);
+    *status = binaryRpc_writeAny(writer, type, input);
+}
+
+int binaryRpc_call(dyn_interface_type *intf, void *service, const void *request, size_t requestLen,
+                   void **out, size_t *outLen) {
+    int status = OK;
+    binary_rpc_reader_t reader;
+    binaryRpc_readerInit(&reader, request, requestLen);
+
+    const char *sig = NULL;
+    status = binaryRpc_readHeader(&reader);
+    if (status == OK) {
+        status = binaryRpc_readMethodId(&reader, &sig);
+    }
+    if (status != OK) {
+        LOG_ERROR("Invalid binary request");
+        return ERROR;
+    }
+
+    LOG_DEBUG("Looking for method %s\n", sig);
+    struct method_entry *method = NULL;
+    if (dynInterface_findMethod(intf, sig, &method) != OK) {
+        LOG_ERROR("Cannot find method with sig '%s'", sig);
+        return ERROR;
+    }
+    LOG_DEBUG("RSA: found method '%s'\n", method->id);
+    dyn_type *returnType = dynFunction_returnType(method->dynFunc);
+    if (dynType_descriptorType(returnType) != 'N') {
+        //NOTE To be able to handle exception only N as returnType is supported
+        LOG_ERROR("Only interface methods with a native int are supported. Found type '%c'", (char)dynType_descriptorType(returnType));
+        return ERROR;
+    }
+
+    struct generic_service_layout *serv = service;
+    void *handle = serv->handle;
+    void (*fp)(void) = serv->methods[method->index];
+    dyn_function_type *func = method->dynFunc;
+    int nrOfArgs = dynFunction_nrOfArguments(func);
+
+    void *args[nrOfArgs];
+    //arguments after a failed argument are not set up
+    memset(args, 0, sizeof(void *) * nrOfArgs);
+
+    void *ptr = NULL;
+    void *ptrToPtr = &ptr;
+
+    //setup and deserialize input
+    for (int i = 0; status == OK && i < nrOfArgs; ++i) {
+        dyn_type *argType = dynFunction_argumentTypeForIndex(func, i);
+        enum dyn_function_argument_meta  meta = dynFunction_argumentMetaForIndex(func, i);
+        if (meta == DYN_FUNCTION_ARGUMENT_META__STD) {
+            status = binaryRpc_createType(&reader, argType, &args[i]);
+        } else if (meta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
+            void **instPtr = calloc(1, sizeof(void*));
+            dyn_type *subType = NULL;
+            dynType_typedPointer_getTypedType(argType, &subType);
+            if (instPtr != NULL) {
+                status = dynType_alloc(subType, instPtr);
+            } else {
+                status = ERROR;
+            }
+            args[i] = instPtr;
+        } else if (meta == DYN_FUNCTION_ARGUMENT_META__OUTPUT) {
+            args[i] = &ptrToPtr;
+        } else if (meta == DYN_FUNCTION_ARGUMENT_META__HANDLE) {
+            args[i] = &handle;
+        }
+    }
+    if (status == OK && binaryRpc_remaining(&reader) != 0) {
+        status = ERROR;
+    }
+    if (status != OK) {
+        LOG_ERROR("Error deserializing the arguments of '%s'", sig);
+    }
+
+    ffi_sarg returnVal = 1;
+    if (status == OK) {
+        status = dynFunction_call(func, fp, (void *) &returnVal, args);
+    }
+
+    int funcCallStatus = (int)returnVal;
+    if (funcCallStatus != 0) {
+        LOG_WARNING("Error calling remote endpoint function, got error code %i", funcCallStatus);
+    }
+
+    //free input args
+    for (int i = 0; i < nrOfArgs; ++i) {
+        dyn_type *argType = dynFunction_argumentTypeForIndex(func, i);
+        enum dyn_function_argument_meta meta = dynFunction_argumentMetaForIndex(func, i);
+        if (meta == DYN_FUNCTION_ARGUMENT_META__STD && args[i] != NULL) {
+            const char* isConst = dynType_getMetaInfo(argType, "const");
+            if (status == OK && dynType_descriptorType(argType) == 't' && (isConst == NULL || strncmp("true", isConst, 5) != 0)) {
+                //char* -> callee is now owner, no free for char seq needed
+                //will free the actual pointer
+                free(args[i]);
+            } else {
+                dynType_free(argType, args[i]);
+            }
+        }
+    }
+
+    //serialize and free output
+    binary_rpc_writer_t writer;
+    binaryRpc_writerInit(&writer, g_responseSizeHint);
+    binaryRpc_writeU32(&writer, BINARY_RPC_MAGIC);
+    size_t prefixLen = writer.len;
+    binaryRpc_writeU8(&writer, BINARY_RPC_REPLY_EMPTY);
+    for (int i = 0; i < nrOfArgs; i += 1) {
+        dyn_type *argType = dynFunction_argumentTypeForIndex(func, i);
+        enum dyn_function_argument_meta  meta = dynFunction_argumentMetaForIndex(func, i);
+        if (meta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
+            dyn_type *subType = NULL;
+            dynType_typedPointer_getTypedType(argType, &subType);
+            void **ptrToInst = (void**)args[i];
+            if (funcCallStatus == 0 && status == OK) {
+                binaryRpc_writeResult(&writer, prefixLen, subType, *ptrToInst, &status);
+            }
+            if (ptrToInst != NULL) {
+                dynType_free(subType, *ptrToInst);
+                free(ptrToInst);
+            }
+        } else if (meta == DYN_FUNCTION_ARGUMENT_META__OUTPUT && funcCallStatus == 0 && ptr != NULL) {
+            dyn_type *typedType = NULL;
+            dynType_typedPointer_getTypedType(argType, &typedType);
+            if (dynType_descriptorType(typedType) == 't') {
+                if (status == OK) {
+                    binaryRpc_writeResult(&writer, prefixLen, typedType, (void *) &ptr, &status);
+                }
+                free(ptr);
+            } else {
+                dyn_type *typedTypedType = NULL;
+                dynType_typedPointer_getTypedType(typedType, &typedTypedType);
+                if (status == OK) {
+                    binaryRpc_writeResult(&writer, prefixLen, typedTypedType, ptr, &status);
+                }
+                dynType_free(typedTypedType, ptr);
+            }
+            ptr = NULL;
+        }
+    }
+
+    if (status == OK && funcCallStatus != 0) {
+        writer.len = prefixLen;
+        binaryRpc_writeU8(&writer, BINARY_RPC_REPLY_ERROR);
+        binaryRpc_writeU32(&writer, (uint32_t)funcCallStatus);
+    }
+    if (status == OK && writer.allocFailed) {
+        LOG_ERROR("Error allocating memory for binary reply");
+        status = ERROR;
+    }
+
+    if (status == OK) {
+        g_responseSizeHint = writer.len;
+        *out = writer.buf;
+        *outLen = writer.len;
+    } else {
+        free(writer.buf);
+    }
+    return status;
+}
+
+static void binaryRpc_freeInputStrings(dyn_function_type *func, void *args[]) {
+    int nrOfArgs = dynFunction_nrOfArguments(func);
+    for (int i = 0; i < nrOfArgs; i += 1) {
+        dyn_type *type = dynFunction_argumentTypeForIndex(func, i);
+        enum dyn_function_argument_meta  meta = dynFunction_argumentMetaForIndex(func, i);
+        if (meta == DYN_FUNCTION_ARGUMENT_META__STD && dynType_descriptorType(type) == 't') {
+            const char *metaArgument = dynType_getMetaInfo(type, "const");
+            if (metaArgument == NULL || strncmp("true", metaArgument, 5) != 0) {
+                char **str = args[i];
+                free(*str); //char * as input -> got ownership -> free it.
+            }
+        }
+    }
+}
+
+int binaryRpc_prepareInvokeRequest(dyn_function_type *func, const char *id, void *args[], void **out, size_t *outLen) {
+    LOG_DEBUG("Calling remote function '%s'\n", id);
+    binary_rpc_writer_t writer;
+    binaryRpc_writerInit(&writer, g_requestSizeHint);
+    binaryRpc_writeU32(&writer, BINARY_RPC_MAGIC);
+    binaryRpc_writeBytes(&writer, id, strlen(id) + 1);
+
+    int status = OK;
+    int nrOfArgs = dynFunction_nrOfArguments(func);
+    for (int i = 0; status == OK && i < nrOfArgs; i += 1) {
+        dyn_type *type = dynFunction_argumentTypeForIndex(func, i);
+        enum dyn_function_argument_meta  meta = dynFunction_argumentMetaForIndex(func, i);
+        if (meta == DYN_FUNCTION_ARGUMENT_META__STD) {
+            status = binaryRpc_writeAny(&writer, type, args[i]);
+        }
+    }
+    binaryRpc_freeInputStrings(func, args);
+    if (status == OK && writer.allocFailed) {
+        LOG_ERROR("Error allocating memory for binary request");
+        status = ERROR;
+    }
+
+    if (status == OK) {
+        g_requestSizeHint = writer.len;
+        *out = writer.buf;
+        *outLen = writer.len;
+    } else {
+        free(writer.buf);
+    }
+    return status;
+}
+
+int binaryRpc_handleReply(dyn_function_type *func, const void *reply, size_t replyLen, void *args[], int *rsErrno) {
+    binary_rpc_reader_t reader;
+    binaryRpc_readerInit(&reader, reply, replyLen);
+    uint8_t kind = BINARY_RPC_REPLY_EMPTY;
+    int status = binaryRpc_readHeader(&reader);
+    if (status == OK) {
+        status = binaryRpc_readU8(&reader, &kind);
+    }
+    if (status != OK || kind > BINARY_RPC_REPLY_ERROR) {
+        LOG_ERROR("Invalid binary reply");
+        return ERROR;
+    }
+
+    *rsErrno = 0;
+    if (kind == BINARY_RPC_REPLY_ERROR) {
+        uint32_t error = 0;
+        status = binaryRpc_readU32(&reader, &error);
+        //get the invocation error of remote service function
+        *rsErrno = (int)error;
+    }
+
+    bool replyHandled = false;
+    int nrOfArgs = dynFunction_nrOfArguments(func);
+    for (int i = 0; status == OK && i < nrOfArgs; i += 1) {
+        dyn_type *argType = dynFunction_argumentTypeForIndex(func, i);
+        enum dyn_function_argument_meta meta = dynFunction_argumentMetaForIndex(func, i);
+        if (meta != DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT && meta != DYN_FUNCTION_ARGUMENT_META__OUTPUT) {
+            continue;
+        }
+        if (kind != BINARY_RPC_REPLY_RESULT) {
+            if (kind == BINARY_RPC_REPLY_EMPTY) {
+                LOG_WARNING("Expected result in reply.");
+            }
+            continue;
+        }
+        dyn_type *subType = NULL;
+        dynType_typedPointer_getTypedType(argType, &subType);
+        if (meta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
+            void **outPtr = (void **) args[i];
+            void *tmp = NULL;
+            //the pre-allocated output is owned by the caller, the result is read in a new instance and copied into it
+            status = binaryRpc_createType(&reader, subType, &tmp);
+            if (status == OK) {
+                memcpy(*outPtr, tmp, dynType_size(subType));
+                free(tmp);
+            }
+        } else if (dynType_descriptorType(subType) == 't') {
+            char ***outPtr = (char ***) args[i];
+            status = binaryRpc_readString(&reader, *outPtr);
+        } else {
+            dyn_type *subSubType = NULL;
+            dynType_typedPointer_getTypedType(subType, &subSubType);
+            void ***outPtr = (void ***) args[i];
+            status = binaryRpc_createType(&reader, subSubType, *outPtr);
+        }
+        replyHandled = true;
+    }
+
+    if (status == OK && kind == BINARY_RPC_REPLY_RESULT && !replyHandled) {
+        LOG_WARNING("Reply has a result output, but this is not handled by the remote function!");
+    } else if (status == OK && binaryRpc_remaining(&reader) != 0) {
+        status = ERROR;
+    }
+    if (status != OK) {
+        LOG_ERROR("Error deserializing binary reply");
+    }
+    return status;
+}
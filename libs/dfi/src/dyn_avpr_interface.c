@@ -49,6 +49,7 @@ ffi_type * dynType_ffiType(dyn_type *type);
 dyn_type * dynAvprType_parseFromJson(json_t * const root, const char * fqn);
 dyn_function_type * dynAvprFunction_parseFromJson(json_t * const root, const char * fqn);
 int dynInterface_checkInterface(dyn_interface_type *intf);
+int dynInterface_buildMethodTable(dyn_interface_type *intf);
 void dynAvprType_constructFqn(char *destination, size_t size, const char *possibleFqn, const char *ns);
 
 // Function definitions
@@ -103,6 +104,7 @@ dyn_interface_type * dynInterface_parseAvpr(FILE * avprStream) {
     valid = valid && dynAvprInterface_createMethods(intf, root, parent_ns);
 
     valid = valid && 0 == dynInterface_checkInterface(intf);
+    valid = valid && 0 == dynInterface_buildMethodTable(intf);
 
     json_decref(root);
     if (valid) {
@@ -31,8 +31,12 @@ DFI_SETUP_LOG(dynInterface);
 static const int OK = 0;
 static const int ERROR = 1;
 
+#define DYN_INTERFACE_MAX_METHOD_TABLE_SIZE (64*1024)
+#define DYN_INTERFACE_MAX_METHOD_TABLE_SEEDS 64
+
 // Also export for dyn_avpr_interface
 int dynInterface_checkInterface(dyn_interface_type *intf);
+int dynInterface_buildMethodTable(dyn_interface_type *intf);
 
 static int dynInterface_parseSection(dyn_interface_type *intf, FILE *stream);
 static int dynInterface_parseAnnotations(dyn_interface_type *intf, FILE *stream);
@@ -82,6 +86,10 @@ int dynInterface_parse(FILE *descriptor, dyn_interface_type **out) {
             	LOG_ERROR("Invalid version (%s) in parsed descriptor\n",version);
             }
         }
+
+        if (status == OK) {
+            status = dynInterface_buildMethodTable(intf);
+        }
     } else {
         status = ERROR;
         LOG_ERROR("Error allocating memory for dynamic interface\n");
@@ -134,6 +142,62 @@ int dynInterface_checkInterface(dyn_interface_type *intf) {
     return status;
 }
 
+static uint32_t dynInterface_methodIdHash(const char *id, uint32_t seed) {
+    //FNV-1a with the seed mixed in the offset basis, followed by a murmur3 finalizer to spread the low bits
+    uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+    for (const unsigned char *c = (const unsigned char *)id; *c != '\0'; ++c) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+static bool dynInterface_fillMethodTable(dyn_interface_type *intf, struct method_entry **table, uint32_t mask, uint32_t seed) {
+    struct method_entry *entry = NULL;
+    TAILQ_FOREACH(entry, &intf->methods, entries) {
+        struct method_entry **slot = &table[dynInterface_methodIdHash(entry->id, seed) & mask];
+        if (*slot == NULL) {
+            *slot = entry;
+        } else if (strcmp((*slot)->id, entry->id) != 0) {
+            return false;
+        } //else duplicate id, the first method with the id is used (as with a linear search)
+    }
+    return true;
+}
+
+int dynInterface_buildMethodTable(dyn_interface_type *intf) {
+    uint32_t nrOfMethods = (uint32_t)dynInterface_nrOfMethods(intf);
+    uint32_t size = 1;
+    while (size < 2 * nrOfMethods) {
+        size <<= 1;
+    }
+    for (; size <= DYN_INTERFACE_MAX_METHOD_TABLE_SIZE; size <<= 1) {
+        struct method_entry **table = calloc(size, sizeof(*table));
+        if (table == NULL) {
+            LOG_ERROR("Error allocating memory for method table\n");
+            return ERROR;
+        }
+        for (uint32_t seed = 0; seed < DYN_INTERFACE_MAX_METHOD_TABLE_SEEDS; ++seed) {
+            if (dynInterface_fillMethodTable(intf, table, size - 1, seed)) {
+                free(intf->methodTable);
+                intf->methodTable = table;
+                intf->methodTableMask = size - 1;
+                intf->methodTableSeed = seed;
+                return OK;
+            }
+            memset(table, 0, size * sizeof(*table));
+        }
+        free(table);
+    }
+    LOG_WARNING("Cannot create a method table for %u methods, falling back to a linear method lookup\n", nrOfMethods);
+    return OK;
+}
+
 static int dynInterface_parseSection(dyn_interface_type *intf, FILE *stream) {
     int status = OK;
     char *sectionName = NULL;
@@ -377,6 +441,8 @@ void dynInterface_destroy(dyn_interface_type *intf) {
         	celix_version_destroy(intf->version);
         }
 
+        free(intf->methodTable);
+
         free(intf);
     } 
 }
@@ -430,6 +496,29 @@ int dynInterface_methods(dyn_interface_type *intf, struct methods_head **list) {
     return status;
 }
 
+int dynInterface_findMethod(dyn_interface_type *intf, const char *id, struct method_entry **method) {
+    struct method_entry *found = NULL;
+    if (intf->methodTable != NULL) {
+        struct method_entry *entry = intf->methodTable[dynInterface_methodIdHash(id, intf->methodTableSeed) & intf->methodTableMask];
+        if (entry != NULL && strcmp(entry->id, id) == 0) {
+            found = entry;
+        }
+    } else {
+        struct method_entry *entry = NULL;
+        TAILQ_FOREACH(entry, &intf->methods, entries) {
+            if (strcmp(entry->id, id) == 0) {
+                found = entry;
+                break;
+            }
+        }
+    }
+    if (found == NULL) {
+        return ERROR;
+    }
+    *method = found;
+    return OK;
+}
+
 int dynInterface_nrOfMethods(dyn_interface_type *intf) {
     int count = 0;
     struct method_entry *entry = NULL;
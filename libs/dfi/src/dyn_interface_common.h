@@ -23,6 +23,7 @@
 #include "dyn_interface.h"
 
 #include <strings.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <ffi.h>
 
@@ -38,8 +39,13 @@ struct _dyn_interface_type {
     struct types_head types;
     struct methods_head methods;
     celix_version_t* version;
+    //perfect hash table of the methods on id, see dynInterface_buildMethodTable
+    struct method_entry **methodTable;
+    uint32_t methodTableMask;
+    uint32_t methodTableSeed;
 };
 
+
 #ifdef __cplusplus
 }
 #endif
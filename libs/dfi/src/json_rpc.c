@@ -27,6 +27,7 @@
 #include <string.h>
 #include <ffi.h>
 #include "dyn_type_common.h"
+#include "json_stream.h"
 
 static int OK = 0;
 static int ERROR = 1;
@@ -40,6 +41,86 @@ struct generic_service_layout {
 	gen_func_type methods[];
 };
 
+/**
+ * Per thread size of the last written request and response. The output text is handed over to the caller, so
+ * it cannot be reused, but it is allocated with the expected size so that it is written in place in one go.
+ */
+static __thread size_t g_requestSizeHint = 0;
+static __thread size_t g_responseSizeHint = 0;
+
+/**
+ * Read the method id of a request and validate the request, without building a DOM.
+ * The arguments reader is positioned at the value of the arguments ("a") member, if present.
+ */
+static int jsonRpc_readRequest(const char *request, char **sig, json_stream_reader_t *arguments, bool *hasArguments) {
+	int status = OK;
+	char *method = NULL;
+	json_stream_reader_t reader;
+	jsonStream_readerInit(&reader, request, strlen(request));
+	*hasArguments = false;
+
+	if (!jsonStream_consume(&reader, '{')) {
+		return ERROR;
+	}
+	reader.depth = 1;
+	if (!jsonStream_consume(&reader, '}')) {
+		do {
+			const char *key = NULL;
+			size_t keyLen = 0;
+			status = jsonStream_readKey(&reader, &key, &keyLen);
+			if (status == OK && !jsonStream_consume(&reader, ':')) {
+				status = ERROR;
+			}
+			if (status != OK) {
+				break;
+			}
+			//note duplicate members are left to jansson
+			if (keyLen == 1 && key[0] == 'm') {
+				status = method == NULL ? jsonStream_readString(&reader, &method) : ERROR;
+			} else if (keyLen == 1 && key[0] == 'a') {
+				status = *hasArguments ? ERROR : OK;
+				*hasArguments = true;
+				*arguments = reader;
+			}
+			if (status == OK && !(keyLen == 1 && key[0] == 'm')) {
+				status = jsonStream_skipValue(&reader);
+			}
+		} while (status == OK && jsonStream_consume(&reader, ','));
+		if (status == OK && !jsonStream_consume(&reader, '}')) {
+			status = ERROR;
+		}
+	}
+
+	if (status == OK && (method == NULL || !jsonStream_atEnd(&reader))) {
+		status = ERROR;
+	}
+	if (status == OK) {
+		*sig = method;
+	} else {
+		free(method);
+	}
+	return status;
+}
+
+/**
+ * Write the value of an output argument as result of the reply.
+ * If the value cannot be streamed, it is serialized with json_serializer to jsonResult.
+ */
+static int jsonRpc_writeResult(json_stream_writer_t *writer, size_t prefixLen, dyn_type *type, void *input,
+		bool *resultStreamed, json_t **jsonResult) {
+	writer->len = prefixLen;
+	if (jsonStream_writeAny(writer, type, input, 1) == OK) {
+		*resultStreamed = true;
+		return OK;
+	}
+	*resultStreamed = false;
+	if (*jsonResult != NULL) {
+		json_decref(*jsonResult);
+		*jsonResult = NULL;
+	}
+	return jsonSerializer_serializeJson(type, input, jsonResult);
+}
+
 int jsonRpc_call(dyn_interface_type *intf, void *service, const char *request, char **out) {
 	int status = OK;
 
@@ -47,38 +128,38 @@ int jsonRpc_call(dyn_interface_type *intf, void *service, const char *request, c
 
 	LOG_DEBUG("Parsing data: %s\n", request);
 	json_error_t error;
-	json_t *js_request = json_loads(request, 0, &error);
+	json_t *js_request = NULL;
 	json_t *arguments = NULL;
-	const char *sig;
-	if (js_request) {
-		if (json_unpack(js_request, "{s:s}", "m", &sig) != 0) {
-			LOG_ERROR("Got json error '%s'\n", error.text);
+	const char *sig = NULL;
+	char *streamedSig = NULL;
+	json_stream_reader_t argumentsReader;
+	bool hasArguments = false;
+	bool argumentsStreamed = false;
+	if (jsonRpc_readRequest(request, &streamedSig, &argumentsReader, &hasArguments) == OK) {
+		sig = streamedSig;
+		argumentsStreamed = hasArguments && jsonStream_consume(&argumentsReader, '[');
+	} else {
+		js_request = json_loads(request, 0, &error);
+		if (js_request) {
+			if (json_unpack(js_request, "{s:s}", "m", &sig) != 0) {
+				LOG_ERROR("Got json error '%s'\n", error.text);
+			} else {
+				arguments = json_object_get(js_request, "a");
+			}
 		} else {
-			arguments = json_object_get(js_request, "a");
+			LOG_ERROR("Got json error '%s' for '%s'\n", error.text, request);
+			return 0;
 		}
-	} else {
-		LOG_ERROR("Got json error '%s' for '%s'\n", error.text, request);
-		return 0;
 	}
 
 	LOG_DEBUG("Looking for method %s\n", sig);
-	struct methods_head *methods = NULL;
-	dynInterface_methods(intf, &methods);
-	struct method_entry *entry = NULL;
 	struct method_entry *method = NULL;
-	TAILQ_FOREACH(entry, methods, entries) {
-		if (strcmp(sig, entry->id) == 0) {
-			method = entry;
-			break;
-		}
-	}
-
-	if (method == NULL) {
+	if (sig == NULL || dynInterface_findMethod(intf, sig, &method) != OK) {
 		status = ERROR;
 		LOG_ERROR("Cannot find method with sig '%s'", sig);
 	}
 	else if (status == OK) {
-		LOG_DEBUG("RSA: found method '%s'\n", entry->id);
+		LOG_DEBUG("RSA: found method '%s'\n", method->id);
 		returnType = dynFunction_returnType(method->dynFunc);
 	}
 
@@ -93,11 +174,13 @@ int jsonRpc_call(dyn_interface_type *intf, void *service, const char *request, c
 	dyn_function_type *func = NULL;
 	int nrOfArgs = 0;
 	if (status == OK) {
-		nrOfArgs = dynFunction_nrOfArguments(entry->dynFunc);
-		func = entry->dynFunc;
+		nrOfArgs = dynFunction_nrOfArguments(method->dynFunc);
+		func = method->dynFunc;
 	}
 
 	void *args[nrOfArgs];
+	//arguments after a failed argument are not set up
+	memset(args, 0, sizeof(void *) * nrOfArgs);
 
 	json_t *value = NULL;
 
@@ -112,10 +195,31 @@ int jsonRpc_call(dyn_interface_type *intf, void *service, const char *request, c
 		dyn_type *argType = dynFunction_argumentTypeForIndex(func, i);
 		enum dyn_function_argument_meta  meta = dynFunction_argumentMetaForIndex(func, i);
 		if (meta == DYN_FUNCTION_ARGUMENT_META__STD) {
-			value = json_array_get(arguments, index++);
 			void *outPtr = NULL;
-            status = jsonSerializer_deserializeJson(argType, value, &outPtr);
-            args[i] = outPtr;
+			if (argumentsStreamed) {
+				if ((index == 0 || jsonStream_consume(&argumentsReader, ',')) &&
+						jsonStream_createType(&argumentsReader, argType, &outPtr) == OK) {
+					args[i] = outPtr;
+					index++;
+					continue;
+				}
+				//cannot stream the argument, deserialize this and the remaining arguments using jansson
+				LOG_DEBUG("Falling back to json_serializer for argument %i\n", i);
+				argumentsStreamed = false;
+				js_request = json_loads(request, 0, &error);
+				if (js_request == NULL) {
+					LOG_ERROR("Got json error '%s' for '%s'\n", error.text, request);
+					status = ERROR;
+					break;
+				}
+				arguments = json_object_get(js_request, "a");
+			} else if (arguments == NULL && js_request == NULL) {
+				js_request = json_loads(request, 0, &error);
+				arguments = json_object_get(js_request, "a");
+			}
+			value = json_array_get(arguments, index++);
+			status = jsonSerializer_deserializeJson(argType, value, &outPtr);
+			args[i] = outPtr;
 		} else if (meta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
 		    void **instPtr = calloc(1, sizeof(void*));
 		    void *inst = NULL;
@@ -135,6 +239,7 @@ int jsonRpc_call(dyn_interface_type *intf, void *service, const char *request, c
 		}
 	}
 	json_decref(js_request);
+	free(streamedSig);
 
 	if (status == OK) {
 		if (dynType_descriptorType(returnType) != 'N') {
@@ -156,7 +261,6 @@ int jsonRpc_call(dyn_interface_type *intf, void *service, const char *request, c
 	}
 
     //free input args
-	json_t *jsonResult = NULL;
 	for(i = 0; i < nrOfArgs; ++i) {
 		dyn_type *argType = dynFunction_argumentTypeForIndex(func, i);
 		enum dyn_function_argument_meta meta = dynFunction_argumentMetaForIndex(func, i);
@@ -177,18 +281,27 @@ int jsonRpc_call(dyn_interface_type *intf, void *service, const char *request, c
 	}
 
 	//serialize and free output
+	json_stream_writer_t writer;
+	jsonStream_writerInit(&writer, g_responseSizeHint);
+	const char *resultPrefix = "{\n    \"r\": ";
+	size_t resultPrefixLen = strlen(resultPrefix);
+	jsonStream_writeRaw(&writer, resultPrefix, resultPrefixLen);
+	bool resultStreamed = false;
+	json_t *jsonResult = NULL;
 	for (i = 0; i < nrOfArgs; i += 1) {
 		dyn_type *argType = dynFunction_argumentTypeForIndex(func, i);
 		enum dyn_function_argument_meta  meta = dynFunction_argumentMetaForIndex(func, i);
 		if (meta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
 			if (funcCallStatus == 0 && status == OK) {
-				status = jsonSerializer_serializeJson(argType, args[i], &jsonResult);
+				status = jsonRpc_writeResult(&writer, resultPrefixLen, argType, args[i], &resultStreamed, &jsonResult);
 			}
 			dyn_type *subType = NULL;
 			dynType_typedPointer_getTypedType(argType, &subType);
 			void **ptrToInst = (void**)args[i];
-			dynType_free(subType, *ptrToInst);
-			free(ptrToInst);
+			if (ptrToInst != NULL) {
+				dynType_free(subType, *ptrToInst);
+				free(ptrToInst);
+			}
 		} else if (meta == DYN_FUNCTION_ARGUMENT_META__OUTPUT) {
 			if (funcCallStatus == 0 && ptr != NULL) {
 				dyn_type *typedType = NULL;
@@ -196,7 +309,7 @@ int jsonRpc_call(dyn_interface_type *intf, void *service, const char *request, c
 					status = dynType_typedPointer_getTypedType(argType, &typedType);
 				}
 				if (status == OK && dynType_descriptorType(typedType) == 't') {
-					status = jsonSerializer_serializeJson(typedType, (void*) &ptr, &jsonResult);
+					status = jsonRpc_writeResult(&writer, resultPrefixLen, typedType, (void*) &ptr, &resultStreamed, &jsonResult);
 					free(ptr);
 				} else {
 					dyn_type *typedTypedType = NULL;
@@ -205,7 +318,7 @@ int jsonRpc_call(dyn_interface_type *intf, void *service, const char *request, c
 					}
 
 					if(status == OK){
-						status = jsonSerializer_serializeJson(typedTypedType, ptr, &jsonResult);
+						status = jsonRpc_writeResult(&writer, resultPrefixLen, typedTypedType, ptr, &resultStreamed, &jsonResult);
 					}
 
 					if (status == OK) {
@@ -226,22 +339,44 @@ int jsonRpc_call(dyn_interface_type *intf, void *service, const char *request, c
 	char *response = NULL;
 	if (status == OK) {
 		LOG_DEBUG("creating payload\n");
-		json_t *payload = json_object();
-		if (funcCallStatus == 0) {
-			if (jsonResult == NULL) {
-				//ignore -> no result
-			} else {
+		if (funcCallStatus == 0 && !resultStreamed && jsonResult != NULL) {
+			LOG_DEBUG("Setting result payload");
+			json_t *payload = json_object();
+			json_object_set_new_nocheck(payload, "r", jsonResult);
+			jsonResult = NULL;
+			response = json_dumps(payload, JSON_DECODE_ANY);
+			json_decref(payload);
+		} else {
+			if (funcCallStatus != 0) {
+				LOG_DEBUG("Setting error payload");
+				writer.len = 0;
+				jsonStream_writeRaw(&writer, "{", 1);
+				jsonStream_writeNewline(&writer, 1);
+				jsonStream_writeRaw(&writer, "\"e\": ", 5);
+				jsonStream_writeInteger(&writer, funcCallStatus);
+				jsonStream_writeNewline(&writer, 0);
+				jsonStream_writeRaw(&writer, "}", 1);
+			} else if (resultStreamed) {
 				LOG_DEBUG("Setting result payload");
-                json_object_set_new_nocheck(payload, "r", jsonResult);
+				jsonStream_writeNewline(&writer, 0);
+				jsonStream_writeRaw(&writer, "}", 1);
+			} else {
+				//no result
+				writer.len = 0;
+				jsonStream_writeRaw(&writer, "{}", 2);
+			}
+			size_t len = writer.len;
+			response = jsonStream_writerStealText(&writer);
+			if (response != NULL) {
+				g_responseSizeHint = len + 1;
+			} else {
+				status = ERROR;
 			}
-		} else {
-			LOG_DEBUG("Setting error payload");
-            json_object_set_new_nocheck(payload, "e", json_integer(funcCallStatus));
 		}
-		response = json_dumps(payload, JSON_DECODE_ANY);
-		json_decref(payload);
 		LOG_DEBUG("status ptr is %p. response is '%s'\n", status, response);
 	}
+	json_decref(jsonResult);
+	jsonStream_writerDestroy(&writer);
 
 	if (status == OK) {
 		*out = response;
@@ -252,11 +387,83 @@ int jsonRpc_call(dyn_interface_type *intf, void *service, const char *request, c
 	return status;
 }
 
+static void jsonRpc_freeInputStrings(dyn_function_type *func, void *args[]) {
+	int nrOfArgs = dynFunction_nrOfArguments(func);
+	for (int i = 0; i < nrOfArgs; i += 1) {
+		dyn_type *type = dynFunction_argumentTypeForIndex(func, i);
+		enum dyn_function_argument_meta  meta = dynFunction_argumentMetaForIndex(func, i);
+		if (meta == DYN_FUNCTION_ARGUMENT_META__STD && dynType_descriptorType(type) == 't') {
+			const char *metaArgument = dynType_getMetaInfo(type, "const");
+			if (metaArgument == NULL || strncmp("true", metaArgument, 5) != 0) {
+				char **str = args[i];
+				free(*str); //char * as input -> got ownership -> free it.
+			}
+		}
+	}
+}
+
+/**
+ * Write the invoke request without building a DOM. The text is the same as the text created with jansson.
+ */
+static int jsonRpc_writeInvokeRequest(dyn_function_type *func, const char *id, void *args[], char **out) {
+	json_stream_writer_t writer;
+	jsonStream_writerInit(&writer, g_requestSizeHint);
+	jsonStream_writeRaw(&writer, "{", 1);
+	jsonStream_writeNewline(&writer, 1);
+	jsonStream_writeRaw(&writer, "\"m\": ", 5);
+	int status = jsonStream_writeString(&writer, id);
+	jsonStream_writeRaw(&writer, ",", 1);
+	jsonStream_writeNewline(&writer, 1);
+	jsonStream_writeRaw(&writer, "\"a\": [", 6);
+
+	int nrOfArgs = dynFunction_nrOfArguments(func);
+	int nrOfWrittenArgs = 0;
+	for (int i = 0; i < nrOfArgs && status == OK; i +=1) {
+		dyn_type *type = dynFunction_argumentTypeForIndex(func, i);
+		enum dyn_function_argument_meta  meta = dynFunction_argumentMetaForIndex(func, i);
+		if (meta == DYN_FUNCTION_ARGUMENT_META__STD) {
+			if (nrOfWrittenArgs > 0) {
+				jsonStream_writeRaw(&writer, ",", 1);
+			}
+			jsonStream_writeNewline(&writer, 2);
+			status = jsonStream_writeAny(&writer, type, args[i], 2);
+			nrOfWrittenArgs += 1;
+		}
+	}
+	if (nrOfWrittenArgs > 0) {
+		jsonStream_writeNewline(&writer, 1);
+	}
+	jsonStream_writeRaw(&writer, "]", 1);
+	jsonStream_writeNewline(&writer, 0);
+	jsonStream_writeRaw(&writer, "}", 1);
+
+	if (status == OK) {
+		size_t len = writer.len;
+		*out = jsonStream_writerStealText(&writer);
+		if (*out != NULL) {
+			g_requestSizeHint = len + 1;
+		} else {
+			status = ERROR;
+		}
+	}
+	jsonStream_writerDestroy(&writer);
+	return status;
+}
+
 int jsonRpc_prepareInvokeRequest(dyn_function_type *func, const char *id, void *args[], char **out) {
 	int status = OK;
 
 
 	LOG_DEBUG("Calling remote function '%s'\n", id);
+	char *invokeStr = NULL;
+	if (jsonRpc_writeInvokeRequest(func, id, args, &invokeStr) == OK) {
+		jsonRpc_freeInputStrings(func, args);
+		*out = invokeStr;
+		return OK;
+	}
+	//the request contains values that cannot be streamed, create it using jansson
+	LOG_DEBUG("Falling back to json_serializer for request '%s'\n", id);
+
 	json_t *invoke = json_object();
     json_object_set_new_nocheck(invoke, "m", json_string(id));
 
@@ -294,7 +501,7 @@ int jsonRpc_prepareInvokeRequest(dyn_function_type *func, const char *id, void *
 		}
 	}
 
-	char *invokeStr = json_dumps(invoke, JSON_DECODE_ANY);
+	invokeStr = json_dumps(invoke, JSON_DECODE_ANY);
 	json_decref(invoke);
 
 	if (status == OK) {
@@ -0,0 +1,981 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "json_stream.h"
+#include "dyn_type_common.h"
+
+#include <errno.h>
+#include <locale.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JSON_STREAM_INDENT 4
+#define JSON_STREAM_MIN_CAPACITY 64
+//Same as JSON_PARSER_MAX_DEPTH of jansson
+#define JSON_STREAM_MAX_DEPTH 2048
+#define JSON_STREAM_MAX_NUMBER_LENGTH 64
+
+static const int OK = 0;
+static const int ERROR = 1;
+
+static int jsonStream_readAny(json_stream_reader_t *reader, dyn_type *type, void *loc);
+
+/**
+ * Returns the length of the UTF-8 sequence at s, or 0 if it is not a valid sequence (same rules as jansson).
+ */
+static size_t jsonStream_utf8SequenceLength(const unsigned char *s, const unsigned char *end) {
+    unsigned char c = s[0];
+    size_t len;
+    uint32_t value;
+    if (c < 0x80) {
+        return 1;
+    } else if (c < 0xC2) {
+        return 0;
+    } else if (c < 0xE0) {
+        len = 2;
+        value = c & 0x1F;
+    } else if (c < 0xF0) {
+        len = 3;
+        value = c & 0x0F;
+    } else if (c < 0xF5) {
+        len = 4;
+        value = c & 0x07;
+    } else {
+        return 0;
+    }
+    if ((size_t)(end - s) < len) {
+        return 0;
+    }
+    for (size_t i = 1; i < len; ++i) {
+        if ((s[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        value = (value << 6) | (s[i] & 0x3F);
+    }
+    if (value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF) || (len == 3 && value < 0x800) || (len == 4 && value < 0x10000)) {
+        return 0;
+    }
+    return len;
+}
+
+void jsonStream_writerInit(json_stream_writer_t *writer, size_t capacity) {
+    writer->cap = capacity < JSON_STREAM_MIN_CAPACITY ? JSON_STREAM_MIN_CAPACITY : capacity;
+    writer->buf = malloc(writer->cap);
+    writer->len = 0;
+    writer->allocFailed = writer->buf == NULL;
+}
+
+void jsonStream_writerDestroy(json_stream_writer_t *writer) {
+    free(writer->buf);
+    writer->buf = NULL;
+    writer->len = 0;
+    writer->cap = 0;
+}
+
+static bool jsonStream_reserve(json_stream_writer_t *writer, size_t extra) {
+    if (writer->allocFailed) {
+        return false;
+    }
+    //+1 for the terminating null byte
+    if (writer->len + extra + 1 > writer->cap) {
+        size_t cap = writer->cap * 2;
+        while (writer->len + extra + 1 > cap) {
+            cap *= 2;
+        }
+        char *buf = realloc(writer->buf, cap);
+        if (buf == NULL) {
+            writer->allocFailed = true;
+            return false;
+        }
+        writer->buf = buf;
+        writer->cap = cap;
+    }
+    return true;
+}
+
+char* jsonStream_writerStealText(json_stream_writer_t *writer) {
+    if (!jsonStream_reserve(writer, 0)) {
+        return NULL;
+    }
+    char *text = writer->buf;
+    text[writer->len] = '\0';
+    writer->buf = NULL;
+    writer->len = 0;
+    writer->cap = 0;
+    return text;
+}
+
+void jsonStream_writeRaw(json_stream_writer_t *writer, const char *data, size_t len) {
+    if (jsonStream_reserve(writer, len)) {
+        memcpy(writer->buf + writer->len, data, len);
+        writer->len += len;
+    }
+}
+
+void jsonStream_writeNewline(json_stream_writer_t *writer, int depth) {
+    size_t len = 1 + (size_t)depth * JSON_STREAM_INDENT;
+    if (jsonStream_reserve(writer, len)) {
+        writer->buf[writer->len] = '\n';
+        memset(writer->buf + writer->len + 1, ' ', len - 1);
+        writer->len += len;
+    }
+}
+
+void jsonStream_writeInteger(json_stream_writer_t *writer, long long value) {
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), "%lld", value);
+    jsonStream_writeRaw(writer, buf, (size_t)len);
+}
+
+static int jsonStream_writeReal(json_stream_writer_t *writer, double value) {
+    if (!isfinite(value)) {
+        return ERROR; //not supported by json_real
+    }
+    //Same format as jansson: %.17g with a decimal point and without '+' or leading zeros in the exponent
+    char buf[40];
+    int ret = snprintf(buf, sizeof(buf), "%.17g", value);
+    if (ret < 0 || (size_t)ret + 3 >= sizeof(buf)) {
+        return ERROR;
+    }
+    size_t len = (size_t)ret;
+    char *decimalPoint = strchr(buf, ',');//locale dependent decimal point
+    if (decimalPoint != NULL) {
+        *decimalPoint = '.';
+    }
+    if (strchr(buf, '.') == NULL && strchr(buf, 'e') == NULL) {
+        buf[len++] = '.';
+        buf[len++] = '0';
+        buf[len] = '\0';
+    }
+    char *start = strchr(buf, 'e');
+    if (start != NULL) {
+        start++;
+        char *end = start + 1;
+        if (*start == '-') {
+            start++;
+        }
+        while (*end == '0') {
+            end++;
+        }
+        if (end != start) {
+            memmove(start, end, len - (size_t)(end - buf));
+            len -= (size_t)(end - start);
+        }
+    }
+    jsonStream_writeRaw(writer, buf, len);
+    return OK;
+}
+
+int jsonStream_writeString(json_stream_writer_t *writer, const char *str) {
+    if (str == NULL) {
+        return ERROR;
+    }
+    const unsigned char *s = (const unsigned char *)str;
+    const unsigned char *end = s + strlen(str);
+    const unsigned char *run = s;
+    jsonStream_writeRaw(writer, "\"", 1);
+    while (s < end) {
+        const char *escaped = NULL;
+        char seq[8];
+        switch (*s) {
+            case '\\': escaped = "\\\\"; break;
+            case '"': escaped = "\\\""; break;
+            case '\b': escaped = "\\b"; break;
+            case '\f': escaped = "\\f"; break;
+            case '\n': escaped = "\\n"; break;
+            case '\r': escaped = "\\r"; break;
+            case '\t': escaped = "\\t"; break;
+            default:
+                if (*s < 0x20) {
+                    snprintf(seq, sizeof(seq), "\\u%04X", (unsigned int)*s);
+                    escaped = seq;
+                }
+                break;
+        }
+        if (escaped != NULL) {
+            jsonStream_writeRaw(writer, (const char *)run, (size_t)(s - run));
+            jsonStream_writeRaw(writer, escaped, strlen(escaped));
+            s++;
+            run = s;
+        } else {
+            size_t len = jsonStream_utf8SequenceLength(s, end);
+            if (len == 0) {
+                return ERROR;
+            }
+            s += len;
+        }
+    }
+    jsonStream_writeRaw(writer, (const char *)run, (size_t)(s - run));
+    jsonStream_writeRaw(writer, "\"", 1);
+    return OK;
+}
+
+static int jsonStream_writeEnum(json_stream_writer_t *writer, dyn_type *type, int32_t value) {
+    char valueStr[32];
+    snprintf(valueStr, sizeof(valueStr), "%d", value);
+    struct meta_entry *entry = NULL;
+    TAILQ_FOREACH(entry, &type->metaProperties, entries) {
+        if (strcmp(valueStr, entry->value) == 0) {
+            return jsonStream_writeString(writer, entry->name);
+        }
+    }
+    return ERROR;
+}
+
+static int jsonStream_writeComplex(json_stream_writer_t *writer, dyn_type *type, const void *input, int depth) {
+    struct complex_type_entries_head *entries = NULL;
+    int status = dynType_complex_entries(type, &entries);
+    if (status != OK) {
+        return status;
+    }
+    if (TAILQ_EMPTY(entries)) {
+        jsonStream_writeRaw(writer, "{}", 2);
+        return OK;
+    }
+    jsonStream_writeRaw(writer, "{", 1);
+    int index = 0;
+    struct complex_type_entry *entry = NULL;
+    TAILQ_FOREACH(entry, entries, entries) {
+        void *valLoc = NULL;
+        dyn_type *subType = NULL;
+        if (index > 0) {
+            jsonStream_writeRaw(writer, ",", 1);
+        }
+        jsonStream_writeNewline(writer, depth + 1);
+        status = jsonStream_writeString(writer, entry->name);
+        if (status == OK) {
+            jsonStream_writeRaw(writer, ": ", 2);
+            status = dynType_complex_valLocAt(type, index, (void *)input, &valLoc);
+        }
+        if (status == OK) {
+            status = dynType_complex_dynTypeAt(type, index, &subType);
+        }
+        if (status == OK) {
+            status = jsonStream_writeAny(writer, subType, valLoc, depth + 1);
+        }
+        if (status != OK) {
+            return status;
+        }
+        index += 1;
+    }
+    jsonStream_writeNewline(writer, depth);
+    jsonStream_writeRaw(writer, "}", 1);
+    return OK;
+}
+
+static int jsonStream_writeSequence(json_stream_writer_t *writer, dyn_type *type, const void *input, int depth) {
+    dyn_type *itemType = dynType_sequence_itemType(type);
+    uint32_t len = dynType_sequence_length((void *)input);
+    if (len == 0) {
+        jsonStream_writeRaw(writer, "[]", 2);
+        return OK;
+    }
+    jsonStream_writeRaw(writer, "[", 1);
+    for (uint32_t i = 0; i < len; ++i) {
+        void *itemLoc = NULL;
+        if (i > 0) {
+            jsonStream_writeRaw(writer, ",", 1);
+        }
+        jsonStream_writeNewline(writer, depth + 1);
+        int status = dynType_sequence_locForIndex(type, (void *)input, (int)i, &itemLoc);
+        if (status == OK) {
+            status = jsonStream_writeAny(writer, itemType, itemLoc, depth + 1);
+        }
+        if (status != OK) {
+            return status;
+        }
+    }
+    jsonStream_writeNewline(writer, depth);
+    jsonStream_writeRaw(writer, "]", 1);
+    return OK;
+}
+
+int jsonStream_writeAny(json_stream_writer_t *writer, dyn_type *type, const void *input, int depth) {
+    int status = OK;
+    dyn_type *subType = NULL;
+    switch (dynType_descriptorType(type)) {
+        case 'Z' :
+            if (*(const bool *)input) {
+                jsonStream_writeRaw(writer, "true", 4);
+            } else {
+                jsonStream_writeRaw(writer, "false", 5);
+            }
+            break;
+        case 'B' :
+            jsonStream_writeInteger(writer, (long long)*(const char *)input);
+            break;
+        case 'S' :
+            jsonStream_writeInteger(writer, (long long)*(const int16_t *)input);
+            break;
+        case 'I' :
+            jsonStream_writeInteger(writer, (long long)*(const int32_t *)input);
+            break;
+        case 'J' :
+            jsonStream_writeInteger(writer, (long long)*(const int64_t *)input);
+            break;
+        case 'b' :
+            jsonStream_writeInteger(writer, (long long)*(const uint8_t *)input);
+            break;
+        case 's' :
+            jsonStream_writeInteger(writer, (long long)*(const uint16_t *)input);
+            break;
+        case 'i' :
+            jsonStream_writeInteger(writer, (long long)*(const uint32_t *)input);
+            break;
+        case 'j' :
+            jsonStream_writeInteger(writer, (long long)*(const uint64_t *)input);
+            break;
+        case 'N' :
+            jsonStream_writeInteger(writer, (long long)*(const int *)input);
+            break;
+        case 'F' :
+            status = jsonStream_writeReal(writer, (double)*(const float *)input);
+            break;
+        case 'D' :
+            status = jsonStream_writeReal(writer, *(const double *)input);
+            break;
+        case 't' :
+            status = jsonStream_writeString(writer, *(const char **)input);
+            break;
+        case 'E' :
+            status = jsonStream_writeEnum(writer, type, *(const int32_t *)input);
+            break;
+        case '*' :
+            status = dynType_typedPointer_getTypedType(type, &subType);
+            if (status == OK && *(void **)input == NULL) {
+                status = ERROR;
+            }
+            if (status == OK) {
+                status = jsonStream_writeAny(writer, subType, *(void **)input, depth);
+            }
+            break;
+        case '{' :
+            status = jsonStream_writeComplex(writer, type, input, depth);
+            break;
+        case '[' :
+            status = jsonStream_writeSequence(writer, type, input, depth);
+            break;
+        case 'l' :
+            status = jsonStream_writeAny(writer, type->ref.ref, input, depth);
+            break;
+        default :
+            status = ERROR;
+            break;
+    }
+    if (status == OK && writer->allocFailed) {
+        status = ERROR;
+    }
+    return status;
+}
+
+void jsonStream_readerInit(json_stream_reader_t *reader, const char *input, size_t len) {
+    reader->pos = input;
+    reader->end = input + len;
+    reader->depth = 0;
+}
+
+static void jsonStream_skipWhitespace(json_stream_reader_t *reader) {
+    while (reader->pos < reader->end &&
+           (*reader->pos == ' ' || *reader->pos == '\t' || *reader->pos == '\n' || *reader->pos == '\r')) {
+        reader->pos++;
+    }
+}
+
+bool jsonStream_consume(json_stream_reader_t *reader, char c) {
+    jsonStream_skipWhitespace(reader);
+    if (reader->pos < reader->end && *reader->pos == c) {
+        reader->pos++;
+        return true;
+    }
+    return false;
+}
+
+bool jsonStream_atEnd(json_stream_reader_t *reader) {
+    jsonStream_skipWhitespace(reader);
+    return reader->pos == reader->end;
+}
+
+static bool jsonStream_consumeLiteral(json_stream_reader_t *reader, const char *literal) {
+    size_t len = strlen(literal);
+    jsonStream_skipWhitespace(reader);
+    if ((size_t)(reader->end - reader->pos) >= len && memcmp(reader->pos, literal, len) == 0) {
+        reader->pos += len;
+        return true;
+    }
+    return false;
+}
+
+static bool jsonStream_enter(json_stream_reader_t *reader, char c) {
+    if (reader->depth >= JSON_STREAM_MAX_DEPTH || !jsonStream_consume(reader, c)) {
+        return false;
+    }
+    reader->depth += 1;
+    return true;
+}
+
+static bool jsonStream_leave(json_stream_reader_t *reader, char c) {
+    if (!jsonStream_consume(reader, c)) {
+        return false;
+    }
+    reader->depth -= 1;
+    return true;
+}
+
+static int jsonStream_hexValue(const char *s, uint32_t *value) {
+    *value = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = s[i];
+        uint32_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = (uint32_t)(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            digit = (uint32_t)(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            digit = (uint32_t)(c - 'A' + 10);
+        } else {
+            return ERROR;
+        }
+        *value = (*value << 4) | digit;
+    }
+    return OK;
+}
+
+/**
+ * Parse the \uXXXX escape sequence(s) at s (after the backslash) and return the number of consumed chars, or 0 if invalid.
+ */
+static size_t jsonStream_parseUnicodeEscape(const char *s, const char *end, uint32_t *codepoint) {
+    if (end - s < 5 || jsonStream_hexValue(s + 1, codepoint) != OK || *codepoint == 0) {
+        return 0; //note \u0000 is not allowed by jansson without JSON_ALLOW_NUL
+    }
+    if (*codepoint >= 0xDC00 && *codepoint <= 0xDFFF) {
+        return 0;
+    }
+    if (*codepoint >= 0xD800 && *codepoint <= 0xDBFF) {
+        uint32_t low;
+        if (end - s < 11 || s[5] != '\\' || s[6] != 'u' || jsonStream_hexValue(s + 7, &low) != OK
+                || low < 0xDC00 || low > 0xDFFF) {
+            return 0;
+        }
+        *codepoint = 0x10000 + ((*codepoint - 0xD800) << 10) + (low - 0xDC00);
+        return 11;
+    }
+    return 5;
+}
+
+/**
+ * Validate the JSON string at the reader, and return the (raw) content of the string.
+ */
+static int jsonStream_scanString(json_stream_reader_t *reader, const char **start, size_t *len, bool *escaped) {
+    if (!jsonStream_consume(reader, '"')) {
+        return ERROR;
+    }
+    const char *s = reader->pos;
+    *escaped = false;
+    while (s < reader->end) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"') {
+            *start = reader->pos;
+            *len = (size_t)(s - reader->pos);
+            reader->pos = s + 1;
+            return OK;
+        } else if (c < 0x20) {
+            return ERROR;
+        } else if (c == '\\') {
+            uint32_t codepoint;
+            size_t seqLen = 0;
+            *escaped = true;
+            if (s + 1 < reader->end) {
+                if (strchr("\"\\/bfnrt", s[1]) != NULL && s[1] != '\0') {
+                    seqLen = 1;
+                } else if (s[1] == 'u') {
+                    seqLen = jsonStream_parseUnicodeEscape(s + 1, reader->end, &codepoint);
+                }
+            }
+            if (seqLen == 0) {
+                return ERROR;
+            }
+            s += 1 + seqLen;
+        } else {
+            size_t seqLen = jsonStream_utf8SequenceLength((const unsigned char *)s, (const unsigned char *)reader->end);
+            if (seqLen == 0) {
+                return ERROR;
+            }
+            s += seqLen;
+        }
+    }
+    return ERROR;
+}
+
+static char* jsonStream_encodeUtf8(uint32_t codepoint, char *out) {
+    if (codepoint < 0x80) {
+        *out++ = (char)codepoint;
+    } else if (codepoint < 0x800) {
+        *out++ = (char)(0xC0 | (codepoint >> 6));
+        *out++ = (char)(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+        *out++ = (char)(0xE0 | (codepoint >> 12));
+        *out++ = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (codepoint & 0x3F));
+    } else {
+        *out++ = (char)(0xF0 | (codepoint >> 18));
+        *out++ = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+        *out++ = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (codepoint & 0x3F));
+    }
+    return out;
+}
+
+/**
+ * Decode the validated raw content of a JSON string. An escape sequence is never shorter than its UTF-8
+ * encoding, so out needs at most len + 1 bytes.
+ */
+static void jsonStream_decodeString(const char *s, size_t len, char *out) {
+    const char *end = s + len;
+    while (s < end) {
+        if (*s != '\\') {
+            *out++ = *s++;
+            continue;
+        }
+        switch (s[1]) {
+            case 'b': *out++ = '\b'; break;
+            case 'f': *out++ = '\f'; break;
+            case 'n': *out++ = '\n'; break;
+            case 'r': *out++ = '\r'; break;
+            case 't': *out++ = '\t'; break;
+            case 'u': {
+                uint32_t codepoint = 0;
+                size_t seqLen = jsonStream_parseUnicodeEscape(s + 1, end, &codepoint);
+                out = jsonStream_encodeUtf8(codepoint, out);
+                s += 1 + seqLen;
+                continue;
+            }
+            default: *out++ = s[1]; break;
+        }
+        s += 2;
+    }
+    *out = '\0';
+}
+
+int jsonStream_readKey(json_stream_reader_t *reader, const char **key, size_t *keyLen) {
+    bool escaped = false;
+    int status = jsonStream_scanString(reader, key, keyLen, &escaped);
+    return status == OK && !escaped ? OK : ERROR;
+}
+
+int jsonStream_readString(json_stream_reader_t *reader, char **out) {
+    const char *raw = NULL;
+    size_t len = 0;
+    bool escaped = false;
+    int status = jsonStream_scanString(reader, &raw, &len, &escaped);
+    if (status != OK) {
+        return status;
+    }
+    char *str = malloc(len + 1);
+    if (str == NULL) {
+        return ERROR;
+    }
+    if (escaped) {
+        jsonStream_decodeString(raw, len, str);
+    } else {
+        memcpy(str, raw, len);
+        str[len] = '\0';
+    }
+    *out = str;
+    return OK;
+}
+
+static int jsonStream_readNumber(json_stream_reader_t *reader, bool *isReal, long long *integer, double *real) {
+    jsonStream_skipWhitespace(reader);
+    const char *start = reader->pos;
+    const char *s = start;
+    const char *end = reader->end;
+    *isReal = false;
+    if (s < end && *s == '-') {
+        s++;
+    }
+    if (s < end && *s == '0') {
+        s++;
+    } else if (s < end && *s >= '1' && *s <= '9') {
+        while (s < end && *s >= '0' && *s <= '9') {
+            s++;
+        }
+    } else {
+        return ERROR;
+    }
+    if (s < end && *s == '.') {
+        s++;
+        if (s >= end || *s < '0' || *s > '9') {
+            return ERROR;
+        }
+        while (s < end && *s >= '0' && *s <= '9') {
+            s++;
+        }
+        *isReal = true;
+    }
+    if (s < end && (*s == 'e' || *s == 'E')) {
+        s++;
+        if (s < end && (*s == '+' || *s == '-')) {
+            s++;
+        }
+        if (s >= end || *s < '0' || *s > '9') {
+            return ERROR;
+        }
+        while (s < end && *s >= '0' && *s <= '9') {
+            s++;
+        }
+        *isReal = true;
+    }
+
+    size_t len = (size_t)(s - start);
+    char buf[JSON_STREAM_MAX_NUMBER_LENGTH];
+    if (len >= sizeof(buf)) {
+        return ERROR;
+    }
+    memcpy(buf, start, len);
+    buf[len] = '\0';
+    char *parseEnd = NULL;
+    errno = 0;
+    if (*isReal) {
+        //strtod uses the decimal point of the current locale
+        char *decimalPoint = strchr(buf, '.');
+        const char *localeDecimalPoint = localeconv()->decimal_point;
+        if (decimalPoint != NULL && localeDecimalPoint != NULL && localeDecimalPoint[0] != '.' && localeDecimalPoint[1] == '\0') {
+            *decimalPoint = localeDecimalPoint[0];
+        }
+        *real = strtod(buf, &parseEnd);
+        if (errno == ERANGE && (*real == HUGE_VAL || *real == -HUGE_VAL)) {
+            return ERROR;
+        }
+    } else {
+        *integer = strtoll(buf, &parseEnd, 10);
+        if (errno == ERANGE) {
+            return ERROR;
+        }
+    }
+    if (parseEnd != buf + len) {
+        return ERROR;
+    }
+    reader->pos = s;
+    return OK;
+}
+
+int jsonStream_skipValue(json_stream_reader_t *reader) {
+    jsonStream_skipWhitespace(reader);
+    if (reader->pos >= reader->end) {
+        return ERROR;
+    }
+    const char *str;
+    size_t len;
+    bool escaped;
+    bool isReal;
+    long long integer;
+    double real;
+    int status = OK;
+    switch (*reader->pos) {
+        case '{':
+            if (!jsonStream_enter(reader, '{')) {
+                return ERROR;
+            }
+            if (jsonStream_leave(reader, '}')) {
+                return OK;
+            }
+            do {
+                status = jsonStream_scanString(reader, &str, &len, &escaped);
+                if (status == OK && !jsonStream_consume(reader, ':')) {
+                    status = ERROR;
+                }
+                if (status == OK) {
+                    status = jsonStream_skipValue(reader);
+                }
+            } while (status == OK && jsonStream_consume(reader, ','));
+            return status == OK && jsonStream_leave(reader, '}') ? OK : ERROR;
+        case '[':
+            if (!jsonStream_enter(reader, '[')) {
+                return ERROR;
+            }
+            if (jsonStream_leave(reader, ']')) {
+                return OK;
+            }
+            do {
+                status = jsonStream_skipValue(reader);
+            } while (status == OK && jsonStream_consume(reader, ','));
+            return status == OK && jsonStream_leave(reader, ']') ? OK : ERROR;
+        case '"':
+            return jsonStream_scanString(reader, &str, &len, &escaped);
+        case 't':
+            return jsonStream_consumeLiteral(reader, "true") ? OK : ERROR;
+        case 'f':
+            return jsonStream_consumeLiteral(reader, "false") ? OK : ERROR;
+        case 'n':
+            return jsonStream_consumeLiteral(reader, "null") ? OK : ERROR;
+        default:
+            return jsonStream_readNumber(reader, &isReal, &integer, &real);
+    }
+}
+
+static int jsonStream_readInteger(json_stream_reader_t *reader, long long *value) {
+    bool isReal = false;
+    double real;
+    int status = jsonStream_readNumber(reader, &isReal, value, &real);
+    return status == OK && !isReal ? OK : ERROR;
+}
+
+static int jsonStream_readReal(json_stream_reader_t *reader, double *value) {
+    bool isReal = false;
+    long long integer;
+    int status = jsonStream_readNumber(reader, &isReal, &integer, value);
+    return status == OK && isReal ? OK : ERROR;
+}
+
+static int jsonStream_readEnum(json_stream_reader_t *reader, dyn_type *type, int32_t *out) {
+    if (jsonStream_consumeLiteral(reader, "null")) {
+        return OK;
+    }
+    const char *name = NULL;
+    size_t len = 0;
+    int status = jsonStream_readKey(reader, &name, &len);
+    if (status == OK) {
+        status = ERROR;
+        struct meta_entry *entry = NULL;
+        TAILQ_FOREACH(entry, &type->metaProperties, entries) {
+            if (strlen(entry->name) == len && memcmp(entry->name, name, len) == 0) {
+                *out = atoi(entry->value);
+                status = OK;
+                break;
+            }
+        }
+    }
+    return status;
+}
+
+static int jsonStream_readText(json_stream_reader_t *reader, char **loc) {
+    if (jsonStream_consumeLiteral(reader, "null")) {
+        return OK;
+    }
+    return jsonStream_readString(reader, loc);
+}
+
+static int jsonStream_readComplex(json_stream_reader_t *reader, dyn_type *type, void *inst) {
+    if (!jsonStream_enter(reader, '{')) {
+        return ERROR;
+    }
+    if (jsonStream_leave(reader, '}')) {
+        return OK;
+    }
+    struct complex_type_entries_head *entries = NULL;
+    int status = dynType_complex_entries(type, &entries);
+    size_t nrOfEntries = dynType_complex_nrOfEntries(type);
+    bool parsed[nrOfEntries > 0 ? nrOfEntries : 1];
+    memset(parsed, 0, sizeof(parsed));
+    while (status == OK) {
+        const char *name = NULL;
+        size_t len = 0;
+        status = jsonStream_readKey(reader, &name, &len);
+        if (status == OK && !jsonStream_consume(reader, ':')) {
+            status = ERROR;
+        }
+
+        int index = -1;
+        if (status == OK) {
+            int i = 0;
+            struct complex_type_entry *entry = NULL;
+            TAILQ_FOREACH(entry, entries, entries) {
+                if (strlen(entry->name) == len && memcmp(entry->name, name, len) == 0) {
+                    index = i;
+                    break;
+                }
+                i += 1;
+            }
+            //note a duplicated member is left to jansson, it uses the last value
+            if (index < 0 || parsed[index]) {
+                status = ERROR;
+            }
+        }
+
+        void *valLoc = NULL;
+        dyn_type *valType = NULL;
+        if (status == OK) {
+            parsed[index] = true;
+            status = dynType_complex_valLocAt(type, index, inst, &valLoc);
+        }
+        if (status == OK) {
+            status = dynType_complex_dynTypeAt(type, index, &valType);
+        }
+        if (status == OK) {
+            status = jsonStream_readAny(reader, valType, valLoc);
+        }
+        if (status == OK && !jsonStream_consume(reader, ',')) {
+            break;
+        }
+    }
+    return status == OK && jsonStream_leave(reader, '}') ? OK : ERROR;
+}
+
+static int jsonStream_readSequence(json_stream_reader_t *reader, dyn_type *type, void *seqLoc) {
+    if (!jsonStream_enter(reader, '[')) {
+        return ERROR;
+    }
+
+    //count the items, so that the sequence is allocated once
+    uint32_t count = 0;
+    json_stream_reader_t counter = *reader;
+    if (!jsonStream_leave(&counter, ']')) {
+        int status = OK;
+        do {
+            status = jsonStream_skipValue(&counter);
+            count += 1;
+        } while (status == OK && jsonStream_consume(&counter, ','));
+        if (status != OK || !jsonStream_leave(&counter, ']')) {
+            return ERROR;
+        }
+    }
+
+    int status = dynType_sequence_alloc(type, seqLoc, count);
+    dyn_type *itemType = dynType_sequence_itemType(type);
+    size_t itemSize = dynType_size(itemType);
+    for (uint32_t i = 0; status == OK && i < count; ++i) {
+        void *valLoc = NULL;
+        if (i > 0 && !jsonStream_consume(reader, ',')) {
+            status = ERROR;
+        }
+        if (status == OK) {
+            status = dynType_sequence_increaseLengthAndReturnLastLoc(type, seqLoc, &valLoc);
+        }
+        if (status == OK) {
+            memset(valLoc, 0, itemSize);
+            status = jsonStream_readAny(reader, itemType, valLoc);
+        }
+    }
+    return status == OK && jsonStream_leave(reader, ']') ? OK : ERROR;
+}
+
+static int jsonStream_readAny(json_stream_reader_t *reader, dyn_type *type, void *loc) {
+    int status = OK;
+    long long integer = 0;
+    double real = 0.0;
+    dyn_type *subType = NULL;
+
+    switch (dynType_descriptorType(type)) {
+        case 'Z' :
+            if (jsonStream_consumeLiteral(reader, "true")) {
+                *(bool *)loc = true;
+            } else if (jsonStream_consumeLiteral(reader, "false")) {
+                *(bool *)loc = false;
+            } else {
+                status = ERROR;
+            }
+            break;
+        case 'F' :
+            status = jsonStream_readReal(reader, &real);
+            *(float *)loc = (float)real;
+            break;
+        case 'D' :
+            status = jsonStream_readReal(reader, &real);
+            *(double *)loc = real;
+            break;
+        case 'N' :
+            status = jsonStream_readInteger(reader, &integer);
+            *(int *)loc = (int)integer;
+            break;
+        case 'B' :
+            status = jsonStream_readInteger(reader, &integer);
+            *(char *)loc = (char)integer;
+            break;
+        case 'S' :
+            status = jsonStream_readInteger(reader, &integer);
+            *(int16_t *)loc = (int16_t)integer;
+            break;
+        case 'I' :
+            status = jsonStream_readInteger(reader, &integer);
+            *(int32_t *)loc = (int32_t)integer;
+            break;
+        case 'J' :
+            status = jsonStream_readInteger(reader, &integer);
+            *(int64_t *)loc = (int64_t)integer;
+            break;
+        case 'b' :
+            status = jsonStream_readInteger(reader, &integer);
+            *(uint8_t *)loc = (uint8_t)integer;
+            break;
+        case 's' :
+            status = jsonStream_readInteger(reader, &integer);
+            *(uint16_t *)loc = (uint16_t)integer;
+            break;
+        case 'i' :
+            status = jsonStream_readInteger(reader, &integer);
+            *(uint32_t *)loc = (uint32_t)integer;
+            break;
+        case 'j' :
+            status = jsonStream_readInteger(reader, &integer);
+            *(uint64_t *)loc = (uint64_t)integer;
+            break;
+        case 'E' :
+            status = jsonStream_readEnum(reader, type, (int32_t *)loc);
+            break;
+        case 't' :
+            status = jsonStream_readText(reader, (char **)loc);
+            break;
+        case '[' :
+            status = jsonStream_readSequence(reader, type, loc);
+            break;
+        case '{' :
+            status = jsonStream_readComplex(reader, type, loc);
+            break;
+        case '*' :
+            status = dynType_typedPointer_getTypedType(type, &subType);
+            if (status == OK) {
+                status = jsonStream_createType(reader, subType, (void **)loc);
+            }
+            break;
+        case 'l' :
+            status = jsonStream_readAny(reader, type->ref.ref, loc);
+            break;
+        default :
+            status = ERROR;
+            break;
+    }
+    return status;
+}
+
+int jsonStream_createType(json_stream_reader_t *reader, dyn_type *type, void **result) {
+    int status = OK;
+    void *inst = NULL;
+
+    if (dynType_descriptorType(type) == 't') {
+        //note as with json_serializer, a deserialized C string is a pointer to the string, which also resides on the heap
+        inst = calloc(1, sizeof(char *));
+        status = inst != NULL ? jsonStream_readString(reader, (char **)inst) : ERROR;
+    } else {
+        status = dynType_alloc(type, &inst);
+        if (status == OK) {
+            status = jsonStream_readAny(reader, type, inst);
+        }
+    }
+
+    if (status == OK) {
+        *result = inst;
+    } else {
+        *result = NULL;
+        dynType_free(type, inst);
+    }
+    return status;
+}
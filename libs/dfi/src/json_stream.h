@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _JSON_STREAM_H_
+#define _JSON_STREAM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "dyn_type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * DOM-free JSON writer and reader, which convert directly between JSON text and the memory layout of a dyn_type.
+ *
+ * The writer produces the same text as json_dumps with JSON_INDENT(4) and the reader accepts the same JSON as
+ * json_loads. Both only handle the well-formed and well-typed cases (as produced by jsonRpc). If a value cannot
+ * be handled (e.g. a NULL string, an untyped pointer or a JSON type that does not match the dyn_type), 1 is
+ * returned without logging and the caller is expected to fall back to json_serializer, which provides the
+ * (error) behaviour for those cases.
+ */
+
+typedef struct json_stream_writer {
+    char *buf;
+    size_t len;
+    size_t cap;
+    bool allocFailed;
+} json_stream_writer_t;
+
+typedef struct json_stream_reader {
+    const char *pos;
+    const char *end;
+    int depth;
+} json_stream_reader_t;
+
+/**
+ * @brief Initialize a writer with an output buffer of (at least) the given capacity.
+ */
+void jsonStream_writerInit(json_stream_writer_t *writer, size_t capacity);
+
+void jsonStream_writerDestroy(json_stream_writer_t *writer);
+
+/**
+ * @brief Take the null-terminated text of the writer. The caller is the owner of the returned text.
+ * @return The text or NULL if the writer failed to allocate memory.
+ */
+char* jsonStream_writerStealText(json_stream_writer_t *writer);
+
+void jsonStream_writeRaw(json_stream_writer_t *writer, const char *data, size_t len);
+
+/**
+ * @brief Write a newline followed by the indentation of the given depth.
+ */
+void jsonStream_writeNewline(json_stream_writer_t *writer, int depth);
+
+void jsonStream_writeInteger(json_stream_writer_t *writer, long long value);
+
+/**
+ * @brief Write a JSON string.
+ * @return 0 on success, 1 if the string is NULL or not valid UTF-8.
+ */
+int jsonStream_writeString(json_stream_writer_t *writer, const char *str);
+
+/**
+ * @brief Write the value of type at input (same layout as jsonSerializer_serializeJson) as JSON.
+ * @param[in] depth The depth of the value, used for the indentation of nested values.
+ */
+int jsonStream_writeAny(json_stream_writer_t *writer, dyn_type *type, const void *input, int depth);
+
+void jsonStream_readerInit(json_stream_reader_t *reader, const char *input, size_t len);
+
+/**
+ * @brief Skip whitespace and consume the given character if it is next.
+ */
+bool jsonStream_consume(json_stream_reader_t *reader, char c);
+
+/**
+ * @brief Whether there is only whitespace left.
+ */
+bool jsonStream_atEnd(json_stream_reader_t *reader);
+
+/**
+ * @brief Read an object key without escape sequences.
+ * @param[out] key The key, which points in the input and is not null-terminated.
+ */
+int jsonStream_readKey(json_stream_reader_t *reader, const char **key, size_t *keyLen);
+
+/**
+ * @brief Read a JSON string as a newly allocated null-terminated string.
+ */
+int jsonStream_readString(json_stream_reader_t *reader, char **out);
+
+/**
+ * @brief Validate and skip a JSON value.
+ */
+int jsonStream_skipValue(json_stream_reader_t *reader);
+
+/**
+ * @brief Read a JSON value into a newly allocated instance of type (same layout as jsonSerializer_deserializeJson).
+ */
+int jsonStream_createType(json_stream_reader_t *reader, dyn_type *type, void **result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include "celix/FrameworkFactory.h"
+
+/**
+ * Benchmark to measure the throughput of the Celix framework event queue, by async registering and unregistering
+ * services from multiple producer threads.
+ */
+class EventQueueBenchmark {
+public:
+    static std::shared_ptr<celix::Framework> createFw() {
+        celix::Properties config{};
+        config.set("CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "error");
+        return celix::createFramework(config);
+    }
+
+    static std::shared_ptr<celix::Framework> fw;
+};
+
+std::shared_ptr<celix::Framework> EventQueueBenchmark::fw{};
+
+static void EventQueueBenchmark_cAsyncRegistrationAndUnregistration(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        EventQueueBenchmark::fw = EventQueueBenchmark::createFw();
+    }
+    celix_bundle_context_t* cCtx = nullptr;
+    int dummySvc = 0;
+
+    for (auto _ : state) {
+        // This code gets timed
+        if (cCtx == nullptr) {
+            //note google benchmark syncs all threads before the first iteration, so the framework is created
+            cCtx = celix_framework_getFrameworkContext(EventQueueBenchmark::fw->getCFramework());
+        }
+        long svcId = celix_bundleContext_registerServiceAsync(cCtx, &dummySvc, "IService", nullptr);
+        celix_bundleContext_unregisterServiceAsync(cCtx, svcId, nullptr, nullptr);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2); //note 2 events per iteration
+    if (state.thread_index() == 0) {
+        celix_bundleContext_waitForEvents(cCtx);
+        EventQueueBenchmark::fw.reset();
+    }
+}
+
+static void EventQueueBenchmark_cGenericEvents(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        EventQueueBenchmark::fw = EventQueueBenchmark::createFw();
+    }
+    celix_framework_t* cFw = nullptr;
+
+    for (auto _ : state) {
+        // This code gets timed
+        if (cFw == nullptr) {
+            //note google benchmark syncs all threads before the first iteration, so the framework is created
+            cFw = EventQueueBenchmark::fw->getCFramework();
+        }
+        celix_framework_fireGenericEvent(cFw, -1, -1, "benchmark event", nullptr, nullptr, nullptr, nullptr);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        celix_framework_waitForEmptyEventQueue(cFw);
+        EventQueueBenchmark::fw.reset();
+    }
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMicrosecond)
+
+CELIX_BENCHMARK(EventQueueBenchmark_cAsyncRegistrationAndUnregistration)->ThreadRange(1, 16);
+CELIX_BENCHMARK(EventQueueBenchmark_cGenericEvents)->ThreadRange(1, 16);
@@ -52,6 +52,7 @@ public:
     static std::shared_ptr<celix::Framework> createFw() {
         celix::Properties config{};
         config.set(celix::FRAMEWORK_STATIC_EVENT_QUEUE_SIZE, 1024*10);
+        config.set(celix::FRAMEWORK_SERVICE_REGISTRY_INDEXED_ATTRIBUTES, "key");
         config.set("CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "error");
         return celix::createFramework(config);
     }
@@ -38,7 +38,7 @@ public:
  */
 class RegisterServicesBenchmark {
 public:
-    explicit RegisterServicesBenchmark(int64_t _nrOfServiceRegistrations, int nrOfServiceTrackers = 0) : nrOfServiceRegistrations{_nrOfServiceRegistrations}, fw{createFw()} {
+    explicit RegisterServicesBenchmark(int64_t _nrOfServiceRegistrations, int nrOfServiceTrackers = 0, bool trackOtherServices = false) : nrOfServiceRegistrations{_nrOfServiceRegistrations}, fw{createFw()} {
         auto ctx = fw->getFrameworkBundleContext();
         registrations.reserve(nrOfServiceRegistrations);
         for (int64_t i = 0; i < nrOfServiceRegistrations; ++i) {
@@ -46,8 +46,9 @@ public:
                     ctx->registerService<IService>(std::make_shared<ServiceImpl>(), IService::NAME).build());
         }
         for (int i = 0; i < nrOfServiceTrackers; ++i) {
+            auto name = trackOtherServices ? std::string{"IOtherService"} + std::to_string(i) : std::string{IService::NAME};
             trackers.emplace_back(
-                    ctx->trackServices<IService>(IService::NAME).build()
+                    ctx->trackServices<IService>(name).build()
             );
         }
         ctx->waitForEvents();
@@ -67,8 +68,8 @@ public:
     std::vector<std::shared_ptr<celix::GenericServiceTracker>> trackers{};
 };
 
-static void registrationAndUnregistrationTest(benchmark::State& state, bool cTest, int nrOfTrackers) {
-    RegisterServicesBenchmark benchmark{state.range(0), nrOfTrackers};
+static void registrationAndUnregistrationTest(benchmark::State& state, bool cTest, int nrOfTrackers, bool trackOtherServices = false) {
+    RegisterServicesBenchmark benchmark{state.range(0), nrOfTrackers, trackOtherServices};
     auto ctx = benchmark.fw->getFrameworkBundleContext();
     auto* cCtx = ctx->getCBundleContext();
     auto svc = std::make_shared<ServiceImpl>();
@@ -140,6 +141,65 @@ static void RegisterServicesBenchmark_cxxRegistrationAndUnregistrationWith100Tra
     registrationAndUnregistrationTest(state, false, 100);
 }
 
+/**
+ * Registration and unregistration with a number of (state.range(0)) open trackers for other services, which
+ * should not need to be filter matched for the registration events.
+ */
+static void RegisterServicesBenchmark_cRegistrationAndUnregistrationWithOtherTrackers(benchmark::State& state) {
+    auto nrOfTrackers = (int)state.range(0);
+    state.SetLabel(std::to_string(nrOfTrackers) + " trackers");
+    //note one registered service, the range is used for the number of trackers
+    RegisterServicesBenchmark benchmark{1, nrOfTrackers, true};
+    auto* cCtx = benchmark.fw->getFrameworkBundleContext()->getCBundleContext();
+    auto svc = std::make_shared<ServiceImpl>();
+    for (auto _ : state) {
+        // This code gets timed
+        long svcId = celix_bundleContext_registerService(cCtx, svc.get(), IService::NAME, nullptr);
+        celix_bundleContext_unregisterService(cCtx, svcId);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Registration and unregistration of a number of (state.range(0)) services with 100 open trackers, one by one or
+ * as a single batch.
+ */
+static void registrationAndUnregistrationOfServicesTest(benchmark::State& state, bool batch) {
+    RegisterServicesBenchmark benchmark{1, 100};
+    auto* cCtx = benchmark.fw->getFrameworkBundleContext()->getCBundleContext();
+    auto svc = std::make_shared<ServiceImpl>();
+    std::vector<celix_service_registration_options_t> opts((size_t)state.range(0));
+    for (auto& opt : opts) {
+        opt.svc = svc.get();
+        opt.serviceName = IService::NAME;
+    }
+    std::vector<long> svcIds(opts.size());
+
+    for (auto _ : state) {
+        // This code gets timed
+        if (batch) {
+            celix_bundleContext_registerServicesBatch(cCtx, opts.data(), opts.size(), svcIds.data());
+            celix_bundleContext_unregisterServicesBatch(cCtx, svcIds.data(), svcIds.size());
+        } else {
+            for (size_t i = 0; i < opts.size(); ++i) {
+                svcIds[i] = celix_bundleContext_registerServiceWithOptions(cCtx, &opts[i]);
+            }
+            for (long svcId : svcIds) {
+                celix_bundleContext_unregisterService(cCtx, svcId);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void RegisterServicesBenchmark_cRegistrationAndUnregistrationOfServices(benchmark::State& state) {
+    registrationAndUnregistrationOfServicesTest(state, false);
+}
+
+static void RegisterServicesBenchmark_cRegistrationAndUnregistrationOfServicesBatch(benchmark::State& state) {
+    registrationAndUnregistrationOfServicesTest(state, true);
+}
+
 static void RegisterServicesBenchmark_cRegistration(benchmark::State& state) {
     registrationTest(state, true);
 }
@@ -157,5 +217,10 @@ CELIX_BENCHMARK(RegisterServicesBenchmark_cxxRegistrationAndUnregistration)->Ran
 CELIX_BENCHMARK(RegisterServicesBenchmark_cRegistrationAndUnregistrationWith100Trackers)->RangeMultiplier(10)->Range(1, 1000);
 CELIX_BENCHMARK(RegisterServicesBenchmark_cxxRegistrationAndUnregistrationWith100Trackers)->RangeMultiplier(10)->Range(1, 1000);
 
+CELIX_BENCHMARK(RegisterServicesBenchmark_cRegistrationAndUnregistrationWithOtherTrackers)->RangeMultiplier(10)->Range(10, 1000);
+
+CELIX_BENCHMARK(RegisterServicesBenchmark_cRegistrationAndUnregistrationOfServices)->RangeMultiplier(10)->Range(1, 1000);
+CELIX_BENCHMARK(RegisterServicesBenchmark_cRegistrationAndUnregistrationOfServicesBatch)->RangeMultiplier(10)->Range(1, 1000);
+
 CELIX_BENCHMARK(RegisterServicesBenchmark_cRegistration)->RangeMultiplier(10)->Range(1, 1000);
 CELIX_BENCHMARK(RegisterServicesBenchmark_cxxRegistration)->RangeMultiplier(10)->Range(1, 1000);
\ No newline at end of file
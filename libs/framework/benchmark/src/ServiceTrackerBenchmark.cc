@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include "celix/FrameworkFactory.h"
+#include "service_tracker.h"
+
+/**
+ * Benchmark to measure the contention of using the services of a single service tracker from multiple threads.
+ */
+class ServiceTrackerBenchmark {
+public:
+    static constexpr const char * const SERVICE_NAME = "IService";
+
+    explicit ServiceTrackerBenchmark(int64_t nrOfServices) : fw{createFw()} {
+        auto* cCtx = fw->getFrameworkBundleContext()->getCBundleContext();
+        for (int64_t i = 0; i < nrOfServices; ++i) {
+            celix_service_registration_options_t opts{};
+            opts.svc = &dummySvc;
+            opts.serviceName = SERVICE_NAME;
+            opts.properties = celix_properties_create();
+            celix_properties_setLong(opts.properties, CELIX_FRAMEWORK_SERVICE_RANKING, i);
+            svcIds.push_back(celix_bundleContext_registerServiceWithOptions(cCtx, &opts));
+        }
+        tracker = celix_serviceTracker_create(cCtx, SERVICE_NAME, nullptr, nullptr);
+    }
+
+    ~ServiceTrackerBenchmark() {
+        auto* cCtx = fw->getFrameworkBundleContext()->getCBundleContext();
+        celix_serviceTracker_destroy(tracker);
+        for (auto svcId : svcIds) {
+            celix_bundleContext_unregisterService(cCtx, svcId);
+        }
+    }
+
+    ServiceTrackerBenchmark(ServiceTrackerBenchmark&&) = delete;
+    ServiceTrackerBenchmark& operator=(ServiceTrackerBenchmark&&) = delete;
+    ServiceTrackerBenchmark(const ServiceTrackerBenchmark&) = delete;
+    ServiceTrackerBenchmark& operator=(const ServiceTrackerBenchmark&) = delete;
+
+    static std::shared_ptr<celix::Framework> createFw() {
+        celix::Properties config{};
+        config.set("CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "error");
+        return celix::createFramework(config);
+    }
+
+    int dummySvc{0};
+    const std::shared_ptr<celix::Framework> fw;
+    std::vector<long> svcIds{};
+    celix_service_tracker_t* tracker{nullptr};
+
+    static std::unique_ptr<ServiceTrackerBenchmark> benchmark;
+};
+
+std::unique_ptr<ServiceTrackerBenchmark> ServiceTrackerBenchmark::benchmark{};
+
+static void useService(void* handle, void* svc) {
+    auto* count = static_cast<int64_t*>(handle);
+    benchmark::DoNotOptimize(svc);
+    *count += 1;
+}
+
+static void ServiceTrackerBenchmark_cUseHighestRankingService(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        ServiceTrackerBenchmark::benchmark = std::make_unique<ServiceTrackerBenchmark>(state.range(0));
+    }
+    celix_service_tracker_t* tracker = nullptr;
+    int64_t count = 0;
+
+    for (auto _ : state) {
+        // This code gets timed
+        if (tracker == nullptr) {
+            //note google benchmark syncs all threads before the first iteration, so the tracker is created
+            tracker = ServiceTrackerBenchmark::benchmark->tracker;
+        }
+        celix_serviceTracker_useHighestRankingService(tracker, nullptr, 0, &count, useService, nullptr, nullptr);
+    }
+
+    if (count != state.iterations()) {
+        state.SkipWithError("service not used");
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        ServiceTrackerBenchmark::benchmark.reset();
+    }
+}
+
+static void ServiceTrackerBenchmark_cUseServices(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        ServiceTrackerBenchmark::benchmark = std::make_unique<ServiceTrackerBenchmark>(state.range(0));
+    }
+    celix_service_tracker_t* tracker = nullptr;
+    int64_t count = 0;
+
+    for (auto _ : state) {
+        // This code gets timed
+        if (tracker == nullptr) {
+            //note google benchmark syncs all threads before the first iteration, so the tracker is created
+            tracker = ServiceTrackerBenchmark::benchmark->tracker;
+        }
+        celix_serviceTracker_useServices(tracker, nullptr, &count, useService, nullptr, nullptr);
+    }
+
+    state.SetItemsProcessed(count);
+    if (state.thread_index() == 0) {
+        ServiceTrackerBenchmark::benchmark.reset();
+    }
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond)
+
+CELIX_BENCHMARK(ServiceTrackerBenchmark_cUseHighestRankingService)->Arg(1)->Arg(16)->ThreadRange(1, 16);
+CELIX_BENCHMARK(ServiceTrackerBenchmark_cUseServices)->Arg(1)->Arg(16)->ThreadRange(1, 16);
@@ -103,6 +103,46 @@ TEST_F(CxxBundleArchiveTestSuite, BundleArchiveReusedTest) {
     lock.unlock();
 }
 
+TEST_F(CxxBundleArchiveTestSuite, BundleArchiveReusedFromBundleStoreTest) {
+    auto fw = celix::createFramework({
+         {"CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "trace"},
+         {CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true"},
+         {CELIX_FRAMEWORK_CACHE_USE_BUNDLE_STORE, "true"}
+    });
+    auto ctx = fw->getFrameworkBundleContext();
+
+    std::mutex m; //protects installTime
+    timespec installTime{};
+
+    auto tracker = ctx->trackBundles()
+        .addOnInstallCallback([&](const celix::Bundle& b) {
+            std::lock_guard<std::mutex> lock{m};
+            auto *archive = celix_bundle_getArchive(b.getCBundle());
+            EXPECT_EQ(CELIX_SUCCESS, celix_bundleArchive_getLastModified(archive, &installTime));
+        }).build();
+
+    long bndId1 = ctx->installBundle(SIMPLE_TEST_BUNDLE1_LOCATION);
+    EXPECT_GT(bndId1, -1);
+
+    std::unique_lock<std::mutex> lock{m};
+    EXPECT_GT(installTime.tv_sec, 0);
+    auto firstBundleRevisionTime = installTime;
+    lock.unlock();
+
+    ctx->uninstallBundle(bndId1);
+    std::this_thread::sleep_for(std::chrono::milliseconds{100}); //wait so that the zip <-> archive dir modification time is different
+    celix_utils_touch(SIMPLE_TEST_BUNDLE1_LOCATION); //touch the bundle zip file, the content is unchanged
+    long bndId2 = ctx->installBundle(SIMPLE_TEST_BUNDLE1_LOCATION);
+    EXPECT_GT(bndId2, -1);
+    EXPECT_EQ(bndId1, bndId2); //bundle id should be reused.
+
+    lock.lock();
+    EXPECT_GT(installTime.tv_sec, 0);
+    //bundle archive should not be updated, because the content of the zip file is unchanged
+    EXPECT_EQ(installTime, firstBundleRevisionTime);
+    lock.unlock();
+}
+
 TEST_F(CxxBundleArchiveTestSuite, BundleArchiveUpdatedAfterCleanOnCreateTest) {
     auto fw = celix::createFramework({
         {"CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "trace"},
@@ -25,10 +25,24 @@
 #include "celix_properties.h"
 #include "framework_private.h"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <fstream>
 #include <string>
+#include <sys/stat.h>
+#include <vector>
 
 class CelixBundleCacheTestSuite : public ::testing::Test {
 public:
+    static std::vector<std::string> readLines(const std::string& path) {
+        std::vector<std::string> lines{};
+        std::ifstream file{path};
+        std::string line;
+        while (std::getline(file, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
     CelixBundleCacheTestSuite() {
         celix_bundle_cache_t* bundleCache = nullptr;
         fw.configurationMap = celix_properties_create();
@@ -84,4 +98,174 @@ TEST_F(CelixBundleCacheTestSuite, CreateBundleArchivesCacheTest) {
     EXPECT_TRUE(celix_bundleCache_isBundleIdAlreadyUsed(fw.cache, 1));
     EXPECT_EQ(2, celix_bundleCache_findBundleIdForLocation(fw.cache, SIMPLE_TEST_BUNDLE2_LOCATION));
     EXPECT_TRUE(celix_bundleCache_isBundleIdAlreadyUsed(fw.cache, 2));
-}
\ No newline at end of file
+}
+
+TEST_F(CelixBundleCacheTestSuite, CreateBundleArchivesCacheInParallelTest) {
+    celix_properties_set(fw.configurationMap, CELIX_FRAMEWORK_AUTO_START_THREADS, "2");
+    auto start = std::string{} + SIMPLE_TEST_BUNDLE1_LOCATION + " " + SIMPLE_TEST_BUNDLE2_LOCATION + " " +
+                 SIMPLE_TEST_BUNDLE3_LOCATION;
+    celix_properties_set(fw.configurationMap, CELIX_AUTO_START_1, start.c_str());
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_createBundleArchivesCache(&fw, true));
+    EXPECT_EQ(1, celix_bundleCache_findBundleIdForLocation(fw.cache, SIMPLE_TEST_BUNDLE1_LOCATION));
+    EXPECT_EQ(2, celix_bundleCache_findBundleIdForLocation(fw.cache, SIMPLE_TEST_BUNDLE2_LOCATION));
+    EXPECT_EQ(3, celix_bundleCache_findBundleIdForLocation(fw.cache, SIMPLE_TEST_BUNDLE3_LOCATION));
+}
+
+TEST_F(CelixBundleCacheTestSuite, CreateArchivesWithBundleStoreTest) {
+    //Given a bundle cache using the bundle store
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_destroy(fw.cache));
+    celix_properties_setBool(fw.configurationMap, CELIX_FRAMEWORK_CACHE_USE_BUNDLE_STORE, true);
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_create(&fw, &fw.cache));
+    EXPECT_TRUE(celix_bundleCache_isBundleStoreEnabled(fw.cache));
+
+    //When 2 archives are created for the same bundle zip
+    bundle_archive_t* archive1 = nullptr;
+    bundle_archive_t* archive2 = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_createArchive(fw.cache, 1, SIMPLE_TEST_BUNDLE1_LOCATION, &archive1));
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_createArchive(fw.cache, 2, SIMPLE_TEST_BUNDLE1_LOCATION, &archive2));
+
+    //Then the resource files of both archives are hardlinks to the same bundle store entry
+    std::string manifest1 = std::string{celix_bundleArchive_getCurrentRevisionRoot(archive1)} + "/" + CELIX_BUNDLE_MANIFEST_REL_PATH;
+    std::string manifest2 = std::string{celix_bundleArchive_getCurrentRevisionRoot(archive2)} + "/" + CELIX_BUNDLE_MANIFEST_REL_PATH;
+    struct stat st1{};
+    struct stat st2{};
+    ASSERT_EQ(0, stat(manifest1.c_str(), &st1));
+    ASSERT_EQ(0, stat(manifest2.c_str(), &st2));
+    EXPECT_EQ(st1.st_ino, st2.st_ino);
+    EXPECT_EQ(3, st1.st_nlink);
+
+    //And the bundle store entry is named after the SHA-256 content hash of the bundle zip
+    const char* archiveRoot = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, bundleArchive_getArchiveRoot(archive1, &archiveRoot));
+    std::string cacheDir = archiveRoot;
+    cacheDir = cacheDir.substr(0, cacheDir.rfind('/'));
+    std::string storeDir = cacheDir + "/bundle_store";
+    auto* stateProps = celix_properties_load((std::string{archiveRoot} + "/" + CELIX_BUNDLE_ARCHIVE_STATE_PROPERTIES_FILE_NAME).c_str());
+    std::string hash = celix_properties_get(stateProps, CELIX_BUNDLE_ARCHIVE_CONTENT_HASH_PROPERTY_NAME, "");
+    celix_properties_destroy(stateProps);
+    EXPECT_EQ(64, hash.size());
+    std::string entryDir = storeDir + "/" + hash;
+    EXPECT_TRUE(celix_utils_directoryExists(entryDir.c_str()));
+
+    //And the files of the bundle store entry are read-only, including the hardlinked resources in the bundle caches
+    EXPECT_EQ(0, st1.st_mode & (S_IWUSR | S_IWGRP | S_IWOTH));
+
+    //And the bundle store index has a single line, keyed by the hash of the zip path and ending with the content hash
+    auto lines = readLines(storeDir + "/index");
+    ASSERT_EQ(1, lines.size());
+    std::string pathHash = lines[0].substr(0, lines[0].find(' '));
+    EXPECT_EQ(64, pathHash.size());
+    EXPECT_EQ(std::string::npos, pathHash.find('/'));
+    EXPECT_EQ(hash, lines[0].substr(lines[0].rfind(' ') + 1));
+
+    //When the first archive is destroyed
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_destroyArchive(fw.cache, archive1));
+
+    //Then the bundle store entry is kept, because it is still used by the second archive
+    EXPECT_TRUE(celix_utils_directoryExists(entryDir.c_str()));
+
+    //When the cache dir is deleted
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_deleteCacheDir(fw.cache));
+
+    //Then the bundle store and its index are kept
+    EXPECT_TRUE(celix_utils_directoryExists(storeDir.c_str()));
+    EXPECT_TRUE(celix_utils_fileExists((storeDir + "/index").c_str()));
+
+    //And a newly created archive reuses the bundle store entry
+    bundle_archive_t* archive3 = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_createArchive(fw.cache, 1, SIMPLE_TEST_BUNDLE1_LOCATION, &archive3));
+    std::string manifest3 = std::string{celix_bundleArchive_getCurrentRevisionRoot(archive3)} + "/" + CELIX_BUNDLE_MANIFEST_REL_PATH;
+    struct stat st3{};
+    ASSERT_EQ(0, stat(manifest3.c_str(), &st3));
+    EXPECT_EQ(st1.st_ino, st3.st_ino);
+
+    //When the remaining archives are destroyed
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_destroyArchive(fw.cache, archive2));
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_destroyArchive(fw.cache, archive3));
+
+    //Then the unused bundle store entry is removed and the bundle store index is compacted
+    EXPECT_FALSE(celix_utils_directoryExists(entryDir.c_str()));
+    EXPECT_TRUE(readLines(storeDir + "/index").empty());
+}
+
+TEST_F(CelixBundleCacheTestSuite, BundleStoreIndexIsAppendOnlyTest) {
+    //Given a bundle cache using the bundle store in a cache dir which is kept when the bundle cache is destroyed
+    char cacheDirTemplate[] = "/tmp/celix-bundle-store-index-test-XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(cacheDirTemplate));
+    std::string cacheDir = cacheDirTemplate;
+    std::string indexPath = cacheDir + "/bundle_store/index";
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_destroy(fw.cache));
+    celix_properties_setBool(fw.configurationMap, CELIX_FRAMEWORK_CACHE_USE_TMP_DIR, false);
+    celix_properties_set(fw.configurationMap, CELIX_FRAMEWORK_FRAMEWORK_CACHE_DIR, cacheDir.c_str());
+    celix_properties_setBool(fw.configurationMap, CELIX_FRAMEWORK_CACHE_USE_BUNDLE_STORE, true);
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_create(&fw, &fw.cache));
+
+    //When archives for 2 different bundle zips are created
+    bundle_archive_t* archive1 = nullptr;
+    bundle_archive_t* archive2 = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_createArchive(fw.cache, 1, SIMPLE_TEST_BUNDLE1_LOCATION, &archive1));
+    auto linesAfterFirstArchive = readLines(indexPath);
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_createArchive(fw.cache, 2, SIMPLE_TEST_BUNDLE2_LOCATION, &archive2));
+
+    //Then the index line of the second bundle zip is appended and the existing index line is not rewritten
+    auto lines = readLines(indexPath);
+    ASSERT_EQ(1, linesAfterFirstArchive.size());
+    ASSERT_EQ(2, lines.size());
+    EXPECT_EQ(linesAfterFirstArchive[0], lines[0]);
+
+    //When the bundle cache is recreated with an index containing an overridden line and an incomplete line
+    //(e.g. after a crash during a write)
+    bundleArchive_destroy(archive1);
+    bundleArchive_destroy(archive2);
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_destroy(fw.cache));
+    {
+        std::ofstream file{indexPath, std::ios::app};
+        file << lines[0] << "\n" << lines[1].substr(0, 70);
+    }
+    ASSERT_EQ(4, readLines(indexPath).size());
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_create(&fw, &fw.cache));
+
+    //And the bundle store garbage is collected
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_collectBundleStoreGarbage(fw.cache));
+
+    //Then the index is compacted to a single line per index entry
+    auto compactedLines = readLines(indexPath);
+    std::sort(lines.begin(), lines.end());
+    std::sort(compactedLines.begin(), compactedLines.end());
+    EXPECT_EQ(lines, compactedLines);
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_utils_deleteDirectory(cacheDir.c_str(), nullptr));
+}
+
+TEST_F(CelixBundleCacheTestSuite, CreateArchiveWithLibrariesWithBundleStoreTest) {
+    //Given a bundle cache using the bundle store
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_destroy(fw.cache));
+    celix_properties_setBool(fw.configurationMap, CELIX_FRAMEWORK_CACHE_USE_BUNDLE_STORE, true);
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_create(&fw, &fw.cache));
+
+    //When 2 archives are created for the same bundle zip with shared libraries
+    bundle_archive_t* archive1 = nullptr;
+    bundle_archive_t* archive2 = nullptr;
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_createArchive(fw.cache, 1, SIMPLE_CXX_BUNDLE_LOC, &archive1));
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_createArchive(fw.cache, 2, SIMPLE_CXX_BUNDLE_LOC, &archive2));
+
+    //Then the shared libraries are not hardlinked, so that each archive can load its own library instance
+    std::string lib1 = std::string{celix_bundleArchive_getCurrentRevisionRoot(archive1)} + "/libcelix_frameworkd.so.2";
+    std::string lib2 = std::string{celix_bundleArchive_getCurrentRevisionRoot(archive2)} + "/libcelix_frameworkd.so.2";
+    struct stat st1{};
+    struct stat st2{};
+    ASSERT_EQ(0, stat(lib1.c_str(), &st1));
+    ASSERT_EQ(0, stat(lib2.c_str(), &st2));
+    EXPECT_NE(st1.st_ino, st2.st_ino);
+    EXPECT_EQ(1, st1.st_nlink);
+
+    //And the other resources are hardlinked
+    std::string manifest1 = std::string{celix_bundleArchive_getCurrentRevisionRoot(archive1)} + "/" + CELIX_BUNDLE_MANIFEST_REL_PATH;
+    std::string manifest2 = std::string{celix_bundleArchive_getCurrentRevisionRoot(archive2)} + "/" + CELIX_BUNDLE_MANIFEST_REL_PATH;
+    ASSERT_EQ(0, stat(manifest1.c_str(), &st1));
+    ASSERT_EQ(0, stat(manifest2.c_str(), &st2));
+    EXPECT_EQ(st1.st_ino, st2.st_ino);
+
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_destroyArchive(fw.cache, archive1));
+    EXPECT_EQ(CELIX_SUCCESS, celix_bundleCache_destroyArchive(fw.cache, archive2));
+}
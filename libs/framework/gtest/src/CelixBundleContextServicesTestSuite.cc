@@ -18,6 +18,9 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
 
 
 #include <thread>
@@ -32,6 +35,9 @@
 #include "celix_framework_factory.h"
 #include "celix_service_factory.h"
 #include "service_tracker_private.h"
+#include "bundle_context_private.h"
+#include "framework_private.h"
+#include "bundle.h"
 
 class CelixBundleContextServicesTestSuite : public ::testing::Test {
 public:
@@ -48,6 +54,7 @@ public:
         celix_properties_set(properties, "org.osgi.framework.storage", ".cacheBundleContextTestFramework");
         celix_properties_set(properties, "CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "trace");
         celix_properties_setLong(properties, CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE,  256); //ensure that the floodEventLoopTest overflows the static event queue size
+        celix_properties_set(properties, CELIX_FRAMEWORK_SERVICE_REGISTRY_INDEXED_ATTRIBUTES, " key, ,service.id,key");
 
         fw = celix_frameworkFactory_createFramework(properties);
         ctx = framework_getContext(fw);
@@ -1308,6 +1315,143 @@ TEST_F(CelixBundleContextServicesTestSuite, FindServicesTest) {
     celix_bundleContext_unregisterService(ctx, svcId2);
 }
 
+TEST_F(CelixBundleContextServicesTestSuite, FindServicesWithIndexedAttributesTest) {
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "key", "value1");
+    long svcId1 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", props);
+    props = celix_properties_create();
+    celix_properties_set(props, "key", "value2");
+    long svcId2 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", props);
+    props = celix_properties_create();
+    celix_properties_set(props, "key", "1");
+    long svcId3 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", props);
+    props = celix_properties_create();
+    celix_properties_set(props, "key", "value1");
+    long svcId4 = celix_bundleContext_registerService(ctx, (void*)0x100, "other", props);
+    props = celix_properties_create();
+    celix_properties_set(props, CELIX_FRAMEWORK_SERVICE_NAME, "overridden");
+    long svcId5 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", props);
+
+    celix_service_filter_options_t opts{};
+    opts.serviceName = "example";
+    opts.filter = "(key=value1)";
+    celix_array_list_t* list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    ASSERT_EQ(1, celix_arrayList_size(list));
+    EXPECT_EQ(svcId1, celix_arrayList_getLong(list, 0));
+    celix_arrayList_destroy(list);
+
+    opts.serviceName = nullptr;
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    EXPECT_EQ(2, celix_arrayList_size(list)); //svcId1 and svcId4
+    celix_arrayList_destroy(list);
+
+    opts.filter = "(&(key=value1)(|(objectClass=other)(objectClass=non-existing)))";
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    ASSERT_EQ(1, celix_arrayList_size(list));
+    EXPECT_EQ(svcId4, celix_arrayList_getLong(list, 0));
+    celix_arrayList_destroy(list);
+
+    //typed compare, "(key=01)" should match the "1" property value
+    opts.filter = "(key=01)";
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    ASSERT_EQ(1, celix_arrayList_size(list));
+    EXPECT_EQ(svcId3, celix_arrayList_getLong(list, 0));
+    celix_arrayList_destroy(list);
+
+    opts.filter = "(key=non-existing)";
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    EXPECT_EQ(0, celix_arrayList_size(list));
+    celix_arrayList_destroy(list);
+
+    //service id lookup
+    opts.serviceName = "example";
+    auto filter = std::string{"(service.id="} + std::to_string(svcId2) + ")";
+    opts.filter = filter.c_str();
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    ASSERT_EQ(1, celix_arrayList_size(list));
+    EXPECT_EQ(svcId2, celix_arrayList_getLong(list, 0));
+    celix_arrayList_destroy(list);
+
+    opts.serviceName = "other";
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    EXPECT_EQ(0, celix_arrayList_size(list));
+    celix_arrayList_destroy(list);
+
+    //objectClass property differs from the registered service name
+    opts.serviceName = nullptr;
+    opts.filter = "(objectClass=overridden)";
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    ASSERT_EQ(1, celix_arrayList_size(list));
+    EXPECT_EQ(svcId5, celix_arrayList_getLong(list, 0));
+    celix_arrayList_destroy(list);
+
+    //tracker for already registered services should also use the indexes
+    int count = 0;
+    celix_service_tracking_options_t trkOpts{};
+    trkOpts.filter.serviceName = "example";
+    trkOpts.filter.filter = "(key=value2)";
+    trkOpts.callbackHandle = &count;
+    trkOpts.add = [](void* handle, void*) {
+        auto* c = static_cast<int*>(handle);
+        *c += 1;
+    };
+    long trkId = celix_bundleContext_trackServicesWithOptions(ctx, &trkOpts);
+    EXPECT_EQ(1, count);
+    celix_bundleContext_stopTracker(ctx, trkId);
+
+    celix_bundleContext_unregisterService(ctx, svcId1);
+    opts.serviceName = "example";
+    opts.filter = "(key=value1)";
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    EXPECT_EQ(0, celix_arrayList_size(list));
+    celix_arrayList_destroy(list);
+
+    celix_bundleContext_unregisterService(ctx, svcId2);
+    celix_bundleContext_unregisterService(ctx, svcId3);
+    celix_bundleContext_unregisterService(ctx, svcId4);
+    celix_bundleContext_unregisterService(ctx, svcId5);
+}
+
+TEST_F(CelixBundleContextServicesTestSuite, UnregisterServicesInAnyOrderTest) {
+    std::vector<long> svcIds{};
+    for (int i = 0; i < 10; ++i) {
+        svcIds.push_back(celix_bundleContext_registerService(ctx, (void*)0x100, "example", nullptr));
+    }
+
+    //unregister the services in an order that moves registrations around in the registry index lists
+    std::vector<long> remaining = svcIds;
+    for (size_t pos : {0, 4, 7, 1, 5, 0}) {
+        celix_bundleContext_unregisterService(ctx, remaining[pos]);
+        remaining.erase(remaining.begin() + (long)pos);
+
+        celix_array_list_t* list = celix_bundleContext_findServices(ctx, "example");
+        std::vector<long> found{};
+        for (int i = 0; i < celix_arrayList_size(list); ++i) {
+            found.push_back(celix_arrayList_getLong(list, i));
+        }
+        celix_arrayList_destroy(list);
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(remaining, found);
+
+        //note a filter on the objectClass uses the objectClass buckets of the attribute index
+        celix_service_filter_options_t opts{};
+        opts.filter = "(objectClass=example)";
+        list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+        found.clear();
+        for (int i = 0; i < celix_arrayList_size(list); ++i) {
+            found.push_back(celix_arrayList_getLong(list, i));
+        }
+        celix_arrayList_destroy(list);
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(remaining, found);
+    }
+
+    for (long svcId : remaining) {
+        celix_bundleContext_unregisterService(ctx, svcId);
+    }
+    EXPECT_EQ(-1L, celix_bundleContext_findService(ctx, "example"));
+}
+
 TEST_F(CelixBundleContextServicesTestSuite, TrackServiceTrackerTest) {
 
     int count = 0;
@@ -1466,6 +1610,140 @@ TEST_F(CelixBundleContextServicesTestSuite, UseServiceOnDemandDirectlyWithAsyncR
     celix_bundleContext_stopTracker(ctx, trkId);
 }
 
+TEST_F(CelixBundleContextServicesTestSuite, UseCachedServiceTest) {
+    celix_service_use_options_t opts{};
+    opts.filter.serviceName = "test";
+    opts.filter.filter = "(key=value)";
+    opts.flags = CELIX_SERVICE_USE_CACHED;
+    opts.use = [](void* handle, void* svc) {
+        auto* used = static_cast<void**>(handle);
+        *used = svc;
+    };
+    void* used = nullptr;
+    opts.callbackHandle = &used;
+
+    bool called = celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    EXPECT_FALSE(called); //service not available
+    EXPECT_EQ(1, celix_stringHashMap_size(ctx->useServiceCache));
+
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+    long svcId1 = celix_bundleContext_registerService(ctx, (void*)0x100, "test", props);
+    called = celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    EXPECT_TRUE(called);
+    EXPECT_EQ((void*)0x100, used);
+
+    props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+    celix_properties_setLong(props, CELIX_FRAMEWORK_SERVICE_RANKING, 10);
+    long svcId2 = celix_bundleContext_registerService(ctx, (void*)0x200, "test", props);
+    called = celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    EXPECT_TRUE(called);
+    EXPECT_EQ((void*)0x200, used); //highest ranking
+    EXPECT_EQ(2, celix_bundleContext_useServicesWithOptions(ctx, &opts));
+    EXPECT_EQ(1, celix_stringHashMap_size(ctx->useServiceCache)); //cached tracker reused
+
+    celix_bundleContext_unregisterService(ctx, svcId2);
+    called = celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    EXPECT_TRUE(called);
+    EXPECT_EQ((void*)0x100, used);
+
+    celix_bundleContext_unregisterService(ctx, svcId1);
+    called = celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    EXPECT_FALSE(called);
+
+    opts.filter.filter = nullptr;
+    called = celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    EXPECT_FALSE(called);
+    EXPECT_EQ(2, celix_stringHashMap_size(ctx->useServiceCache)); //new cached tracker for different filter options
+
+    opts.filter.serviceName = nullptr;
+    called = celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    EXPECT_FALSE(called); //a service name is required
+    EXPECT_EQ(0, celix_bundleContext_useServicesWithOptions(ctx, &opts));
+    EXPECT_EQ(2, celix_stringHashMap_size(ctx->useServiceCache)); //no cached tracker for a NULL service name
+}
+
+TEST_F(CelixBundleContextServicesTestSuite, UseCachedServiceWithFullCacheTest) {
+    long svcId = celix_bundleContext_registerService(ctx, (void*)0x100, "test", nullptr);
+
+    celix_service_use_options_t opts{};
+    opts.filter.serviceName = "test";
+    opts.flags = CELIX_SERVICE_USE_CACHED;
+    opts.use = [](void* handle, void* svc) {
+        auto* used = static_cast<void**>(handle);
+        *used = svc;
+    };
+    void* used = nullptr;
+    opts.callbackHandle = &used;
+
+    std::vector<std::string> filters{};
+    for (int i = 0; i < CELIX_BUNDLE_CONTEXT_MAX_USE_SERVICE_CACHE_SIZE + 2; ++i) {
+        filters.emplace_back(std::string{"(!(key="} + std::to_string(i) + "))");
+    }
+    for (auto& filter : filters) {
+        opts.filter.filter = filter.c_str();
+        used = nullptr;
+        EXPECT_TRUE(celix_bundleContext_useServiceWithOptions(ctx, &opts));
+        EXPECT_EQ((void*)0x100, used);
+        EXPECT_EQ(1, celix_bundleContext_useServicesWithOptions(ctx, &opts));
+    }
+    //note use service calls beyond the cache limit use a temporary service tracker
+    EXPECT_EQ(CELIX_BUNDLE_CONTEXT_MAX_USE_SERVICE_CACHE_SIZE, celix_stringHashMap_size(ctx->useServiceCache));
+
+    celix_bundleContext_unregisterService(ctx, svcId);
+}
+
+TEST_F(CelixBundleContextServicesTestSuite, CleanupUseServiceCacheWaitsForCachedUseServiceTest) {
+    long svcId = celix_bundleContext_registerService(ctx, (void*)0x100, "test", nullptr);
+    EXPECT_GE(svcId, 0);
+
+    //note using the bundle context of another bundle, so that the cleanup does not affect the test bundle context
+    long bndId = celix_bundleContext_installBundle(ctx, SIMPLE_TEST_BUNDLE1_LOCATION, true);
+    ASSERT_GT(bndId, 0);
+    celix_bundle_context_t* bndCtx = nullptr;
+    celix_framework_useBundle(fw, true, bndId, &bndCtx, [](void* handle, const celix_bundle_t* bnd) {
+        bundle_getContext(bnd, static_cast<celix_bundle_context_t**>(handle));
+    });
+    ASSERT_NE(nullptr, bndCtx);
+
+    std::promise<void> usingPromise{};
+    std::promise<void> releasePromise{};
+    std::shared_future<void> releaseFuture = releasePromise.get_future().share();
+    struct UseData {
+        std::promise<void>* usingPromise;
+        std::shared_future<void>* releaseFuture;
+    };
+    UseData useData{&usingPromise, &releaseFuture};
+    auto useResult = std::async(std::launch::async, [bndCtx, &useData] {
+        celix_service_use_options_t opts{};
+        opts.filter.serviceName = "test";
+        opts.flags = CELIX_SERVICE_USE_CACHED;
+        opts.callbackHandle = &useData;
+        opts.use = [](void* handle, void*) {
+            auto* data = static_cast<UseData*>(handle);
+            data->usingPromise->set_value();
+            data->releaseFuture->wait();
+        };
+        return celix_bundleContext_useServiceWithOptions(bndCtx, &opts);
+    });
+    usingPromise.get_future().wait();
+
+    //cleanup of the use service cache should wait until the cached service tracker is no longer in use
+    auto cleanupResult = std::async(std::launch::async, [bndCtx] {
+        celix_bundleContext_cleanup(bndCtx);
+    });
+    EXPECT_EQ(std::future_status::timeout, cleanupResult.wait_for(std::chrono::milliseconds{100}));
+
+    releasePromise.set_value();
+    EXPECT_TRUE(useResult.get());
+    cleanupResult.wait();
+    EXPECT_EQ(0, celix_stringHashMap_size(bndCtx->useServiceCache));
+
+    celix_bundleContext_uninstallBundle(ctx, bndId);
+    celix_bundleContext_unregisterService(ctx, svcId);
+}
+
 TEST_F(CelixBundleContextServicesTestSuite, UseServicesOnDemandDirectlyWithAsyncRegisterTest) {
     //NOTE that even though service are registered async, they should be found by a useService call.
 
@@ -1605,6 +1883,34 @@ TEST_F(CelixBundleContextServicesTestSuite, UnregisterSvcBeforeAsyncRegistration
     EXPECT_EQ(0, cbData.count.load()); //note create tracker canceled -> no callback
 }
 
+TEST_F(CelixBundleContextServicesTestSuite, UnregisterUnknownSvcDuringAsyncRegistrationTest) {
+    celix_framework_fireGenericEvent(
+            fw,
+            -1,
+            celix_bundle_getId(celix_framework_getFrameworkBundle(fw)),
+            "registerAsync",
+            (void*)ctx,
+            [](void *data) {
+                auto c = static_cast<celix_bundle_context_t*>(data);
+
+                //note register async, so the registration is still queued while the unknown svc id is unregistered
+                long svcId = celix_bundleContext_registerServiceAsync(c, (void*)0x42, "test-service", nullptr);
+                EXPECT_GE(svcId, 0);
+
+                celix_bundleContext_unregisterService(c, svcId + 100); //unknown svc id -> should not be seen as pending
+            },
+            nullptr,
+            nullptr);
+
+    celix_bundleContext_waitForEvents(ctx);
+    long svcId = celix_bundleContext_findService(ctx, "test-service");
+    EXPECT_GE(svcId, 0);
+
+    EXPECT_EQ(0, __atomic_load_n(&fw->dispatcher.stats.nbRegister, __ATOMIC_ACQUIRE));
+
+    celix_bundleContext_unregisterService(ctx, svcId);
+}
+
 TEST_F(CelixBundleContextServicesTestSuite, StopSvcTrackerBeforeAsyncTrackerIsCreatedTest) {
     struct callback_data {
         std::atomic<int> count{};
@@ -1740,3 +2046,193 @@ TEST_F(CelixBundleContextServicesTestSuite, SetServicesWithTrackerWhenMultipleRe
     celix_bundleContext_unregisterService(ctx, svcId2);
     celix_bundleContext_unregisterService(ctx, svcId3);
 }
+
+TEST_F(CelixBundleContextServicesTestSuite, UseTrackedServicesWhileRegisteringAndUnregisteringTest) {
+    struct test_svc {
+        std::atomic<bool> valid;
+    };
+    auto* tracker = celix_serviceTracker_create(ctx, "TestService", nullptr, nullptr);
+    ASSERT_NE(tracker, nullptr);
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> invalidUseCount{0};
+    std::vector<std::thread> readers{};
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                auto use = [](void* handle, void* svc) {
+                    auto* invalid = static_cast<std::atomic<int>*>(handle);
+                    if (!static_cast<test_svc*>(svc)->valid.load()) {
+                        (*invalid)++;
+                    }
+                };
+                celix_serviceTracker_useHighestRankingService(tracker, nullptr, 0, &invalidUseCount, use, nullptr, nullptr);
+                celix_serviceTracker_useServices(tracker, nullptr, &invalidUseCount, use, nullptr, nullptr);
+            }
+        });
+    }
+
+    //note the tracker untrack waits till a service is no longer used, so a used service is always still valid
+    for (int i = 0; i < 200; ++i) {
+        test_svc svc{};
+        svc.valid = true;
+        auto* props = celix_properties_create();
+        celix_properties_setLong(props, CELIX_FRAMEWORK_SERVICE_RANKING, i % 5);
+        long svcId = celix_bundleContext_registerService(ctx, &svc, "TestService", props);
+        ASSERT_GE(svcId, 0);
+        EXPECT_EQ(1, celix_serviceTracker_useServices(tracker, nullptr, nullptr, nullptr, nullptr, nullptr));
+        celix_bundleContext_unregisterService(ctx, svcId);
+        svc.valid = false;
+    }
+
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(0, invalidUseCount.load());
+    celix_serviceTracker_destroy(tracker);
+}
+
+TEST_F(CelixBundleContextServicesTestSuite, ServiceListenersAreCalledInAddOrderTest) {
+    struct callback_data {
+        std::mutex mutex{};
+        std::vector<int> calls{};
+    };
+    callback_data data{};
+    struct listener_data {
+        callback_data* data;
+        int id;
+    };
+    listener_data l1{&data, 1};
+    listener_data l2{&data, 2};
+    listener_data l3{&data, 3};
+    listener_data l4{&data, 4};
+
+    auto track = [this](listener_data* l, const char* serviceName, const char* filter) {
+        celix_service_tracking_options_t opts{};
+        opts.filter.serviceName = serviceName;
+        opts.filter.filter = filter;
+        opts.callbackHandle = l;
+        opts.add = [](void* handle, void* /*svc*/) {
+            auto* ld = static_cast<listener_data*>(handle);
+            std::lock_guard<std::mutex> lck{ld->data->mutex};
+            ld->data->calls.push_back(ld->id);
+        };
+        return celix_bundleContext_trackServicesWithOptions(ctx, &opts);
+    };
+    //note the listeners for TestService, the listeners without a mandatory objectClass and the listeners for other
+    //services are indexed separately.
+    long trkId1 = track(&l1, "TestService", nullptr);
+    long trkId2 = track(&l2, nullptr, nullptr);
+    long trkId3 = track(&l3, "OtherService", nullptr);
+    long trkId4 = track(&l4, nullptr, "(|(objectClass=TestService)(objectClass=OtherService))");
+    ASSERT_GE(trkId1, 0);
+    ASSERT_GE(trkId2, 0);
+    ASSERT_GE(trkId3, 0);
+    ASSERT_GE(trkId4, 0);
+
+    void* dummySvc = (void*)0x42;
+    long svcId1 = celix_bundleContext_registerService(ctx, &dummySvc, "TestService", nullptr);
+    ASSERT_GE(svcId1, 0);
+    {
+        std::lock_guard<std::mutex> lck{data.mutex};
+        EXPECT_EQ(data.calls, (std::vector<int>{1, 2, 4}));
+        data.calls.clear();
+    }
+
+    long svcId2 = celix_bundleContext_registerService(ctx, &dummySvc, "OtherService", nullptr);
+    ASSERT_GE(svcId2, 0);
+    {
+        std::lock_guard<std::mutex> lck{data.mutex};
+        EXPECT_EQ(data.calls, (std::vector<int>{2, 3, 4}));
+    }
+
+    celix_bundleContext_unregisterService(ctx, svcId1);
+    celix_bundleContext_unregisterService(ctx, svcId2);
+
+    celix_bundleContext_stopTracker(ctx, trkId1);
+    celix_bundleContext_stopTracker(ctx, trkId2);
+    celix_bundleContext_stopTracker(ctx, trkId3);
+    celix_bundleContext_stopTracker(ctx, trkId4);
+}
+
+TEST_F(CelixBundleContextServicesTestSuite, RegisterAndUnregisterServicesBatchTest) {
+    struct callback_data {
+        std::mutex mutex{};
+        std::vector<std::pair<int, long>> added{}; //tracker id, service id
+        std::vector<std::pair<int, long>> removed{};
+    };
+    callback_data data{};
+    struct tracker_data {
+        callback_data* data;
+        int id;
+    };
+    tracker_data t1{&data, 1};
+    tracker_data t2{&data, 2};
+
+    auto track = [this](tracker_data* t, const char* serviceName) {
+        celix_service_tracking_options_t opts{};
+        opts.filter.serviceName = serviceName;
+        opts.callbackHandle = t;
+        opts.addWithProperties = [](void* handle, void* /*svc*/, const celix_properties_t* props) {
+            auto* td = static_cast<tracker_data*>(handle);
+            std::lock_guard<std::mutex> lck{td->data->mutex};
+            td->data->added.emplace_back(td->id, celix_properties_getAsLong(props, CELIX_FRAMEWORK_SERVICE_ID, -1));
+        };
+        opts.removeWithProperties = [](void* handle, void* /*svc*/, const celix_properties_t* props) {
+            auto* td = static_cast<tracker_data*>(handle);
+            std::lock_guard<std::mutex> lck{td->data->mutex};
+            td->data->removed.emplace_back(td->id, celix_properties_getAsLong(props, CELIX_FRAMEWORK_SERVICE_ID, -1));
+        };
+        return celix_bundleContext_trackServicesWithOptions(ctx, &opts);
+    };
+    long trkId1 = track(&t1, "TestService");
+    long trkId2 = track(&t2, nullptr);
+    ASSERT_GE(trkId1, 0);
+    ASSERT_GE(trkId2, 0);
+
+    void* dummySvc = (void*)0x42;
+    celix_service_registration_options_t opts[4]{};
+    opts[0].svc = &dummySvc;
+    opts[0].serviceName = "TestService";
+    opts[1].svc = &dummySvc;
+    opts[1].serviceName = "OtherService";
+    opts[2].svc = nullptr; //invalid
+    opts[2].serviceName = "TestService";
+    opts[3].svc = &dummySvc;
+    opts[3].serviceName = "TestService";
+    opts[3].serviceVersion = "1.0.0";
+    long svcIds[4];
+    EXPECT_EQ(3, celix_bundleContext_registerServicesBatch(ctx, opts, 4, svcIds));
+    EXPECT_GE(svcIds[0], 0);
+    EXPECT_GE(svcIds[1], 0);
+    EXPECT_EQ(svcIds[2], -1);
+    EXPECT_GE(svcIds[3], 0);
+    for (long svcId : {svcIds[0], svcIds[1], svcIds[3]}) {
+        EXPECT_TRUE(celix_bundleContext_isServiceRegistered(ctx, svcId));
+    }
+    celix_service_filter_options_t filterOpts{};
+    filterOpts.serviceName = "TestService";
+    filterOpts.versionRange = "[1,2)";
+    EXPECT_EQ(svcIds[3], celix_bundleContext_findServiceWithOptions(ctx, &filterOpts));
+
+    {
+        //note the events of the batch are coalesced per tracker
+        std::lock_guard<std::mutex> lck{data.mutex};
+        std::vector<std::pair<int, long>> expected{{1, svcIds[0]}, {1, svcIds[3]}, {2, svcIds[0]}, {2, svcIds[1]}, {2, svcIds[3]}};
+        EXPECT_EQ(data.added, expected);
+    }
+
+    celix_bundleContext_unregisterServicesBatch(ctx, svcIds, 4);
+    for (long svcId : {svcIds[0], svcIds[1], svcIds[3]}) {
+        EXPECT_FALSE(celix_bundleContext_isServiceRegistered(ctx, svcId));
+    }
+    {
+        std::lock_guard<std::mutex> lck{data.mutex};
+        std::vector<std::pair<int, long>> expected{{1, svcIds[0]}, {1, svcIds[3]}, {2, svcIds[0]}, {2, svcIds[1]}, {2, svcIds[3]}};
+        EXPECT_EQ(data.removed, expected);
+    }
+
+    celix_bundleContext_stopTracker(ctx, trkId1);
+    celix_bundleContext_stopTracker(ctx, trkId2);
+}
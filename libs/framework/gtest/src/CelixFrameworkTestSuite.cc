@@ -22,10 +22,15 @@
 #include <chrono>
 #include <thread>
 #include <future>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "celix_launcher.h"
 #include "celix_framework_factory.h"
 #include "celix_framework.h"
+#include "celix_bundle_context.h"
 #include "framework.h"
 #include "celix_constants.h"
 #include "celix_utils.h"
@@ -311,3 +316,237 @@ TEST_F(FrameworkFactoryTestSuite, LaunchFrameworkWithConfigTest) {
     framework_waitForStop(fw);
     framework_destroy(fw);
 }
+
+TEST_F(FrameworkFactoryTestSuite, LaunchFrameworkWithConfigAndParallelAutoStartTest) {
+    /* Rule: When a Celix framework is configured with multiple auto start threads, the specified bundles will be
+     * installed and - if needed - started in parallel, but the bundle ids are still assigned in the configured order.
+     */
+    auto* config = celix_properties_load(INSTALL_AND_START_BUNDLES_CONFIG_PROPERTIES_FILE);
+    ASSERT_TRUE(config != nullptr);
+    celix_properties_set(config, CELIX_FRAMEWORK_AUTO_START_THREADS, "4");
+
+    framework_t* fw = celix_frameworkFactory_createFramework(config);
+    ASSERT_TRUE(fw != nullptr);
+
+    auto* startedBundleIds = celix_framework_listBundles(fw);
+    auto* installedBundleIds = celix_framework_listInstalledBundles(fw);
+    EXPECT_EQ(celix_arrayList_size(startedBundleIds), 3);
+    EXPECT_EQ(celix_arrayList_size(installedBundleIds), 5);
+
+    std::vector<std::string> expectedLocations{SIMPLE_TEST_BUNDLE1_LOCATION, SIMPLE_TEST_BUNDLE2_LOCATION,
+                                               SIMPLE_TEST_BUNDLE3_LOCATION};
+    for (long bndId = 1; bndId <= (long)expectedLocations.size(); ++bndId) {
+        std::string location{};
+        bool called = celix_framework_useBundle(fw, true, bndId, &location, [](void* handle, const celix_bundle_t* bnd) {
+            char* loc = celix_bundle_getLocation(bnd);
+            *static_cast<std::string*>(handle) = loc;
+            free(loc);
+        });
+        EXPECT_TRUE(called);
+        EXPECT_EQ(expectedLocations[bndId - 1], location);
+    }
+
+    celix_arrayList_destroy(startedBundleIds);
+    celix_arrayList_destroy(installedBundleIds);
+
+    framework_stop(fw);
+    framework_waitForStop(fw);
+    framework_destroy(fw);
+}
+
+TEST_F(FrameworkFactoryTestSuite, BundleActivatorsAreStartedInParallelTest) {
+    /* Rule: When a Celix framework is configured with multiple auto start threads, the bundle activators of an auto
+     * start level are really started in parallel.
+     * The parallel start test bundles block in their activator start until the other parallel start test bundle is
+     * starting, so both bundles can only become active if they are started in parallel.
+     */
+    auto* config = celix_properties_create();
+    celix_properties_set(config, CELIX_FRAMEWORK_AUTO_START_THREADS, "2");
+    celix_properties_setBool(config, CELIX_FRAMEWORK_CACHE_USE_TMP_DIR, true);
+    auto start = std::string{} + PARALLEL_START_BUNDLE1_LOC + " " + PARALLEL_START_BUNDLE2_LOC;
+    celix_properties_set(config, CELIX_AUTO_START_1, start.c_str());
+
+    framework_t* fw = celix_frameworkFactory_createFramework(config);
+    ASSERT_TRUE(fw != nullptr);
+    EXPECT_TRUE(celix_framework_isBundleActive(fw, 1));
+    EXPECT_TRUE(celix_framework_isBundleActive(fw, 2));
+
+    framework_stop(fw);
+    framework_waitForStop(fw);
+    framework_destroy(fw);
+}
+
+TEST_F(FrameworkFactoryTestSuite, MultipleEventDispatcherThreadsTest) {
+    /* Rule: When a Celix framework is configured with multiple event dispatcher threads, parallel generic events for
+     * unrelated bundles are handled in parallel, but parallel generic events for a single bundle are still handled
+     * in order.
+     */
+    auto* config = celix_properties_create();
+    celix_properties_set(config, CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS, "2");
+    framework_t* fw = celix_frameworkFactory_createFramework(config);
+    ASSERT_TRUE(fw != nullptr);
+
+    long bndId = celix_framework_installBundle(fw, SIMPLE_TEST_BUNDLE1_LOCATION, false);
+    ASSERT_EQ(1, bndId); //note bundle id 1 -> parallel generic events handled by the second event loop thread
+    celix_framework_waitForEmptyEventQueue(fw);
+
+    //block the ordered event loop thread
+    std::promise<void> blockPromise{};
+    std::shared_future<void> blockFuture = blockPromise.get_future().share();
+    long blockingEventId = celix_framework_fireGenericEvent(fw, -1L, CELIX_FRAMEWORK_BUNDLE_ID, "blocking event",
+        static_cast<void*>(&blockFuture), [](void* data) {
+            auto* future = static_cast<std::shared_future<void>*>(data);
+            future->wait();
+        }, nullptr, nullptr);
+    EXPECT_GE(blockingEventId, 0);
+
+    //parallel events for bundle 1 should still be handled and in order
+    struct EventData {
+        std::atomic<int> count{0};
+        std::atomic<bool> inOrder{true};
+    };
+    EventData data{};
+    std::vector<std::pair<EventData*, int>> eventArgs{};
+    for (int i = 0; i < 100; ++i) {
+        eventArgs.emplace_back(&data, i);
+    }
+    for (auto& args : eventArgs) {
+        celix_framework_fireParallelGenericEvent(fw, -1L, bndId, "ordered event", static_cast<void*>(&args), [](void* d) {
+            auto* args = static_cast<std::pair<EventData*, int>*>(d);
+            int previous = args->first->count.fetch_add(1);
+            if (previous != args->second) {
+                args->first->inOrder = false;
+            }
+        }, nullptr, nullptr);
+    }
+    celix_framework_waitUntilNoEventsForBnd(fw, bndId);
+    EXPECT_EQ(100, data.count.load());
+    EXPECT_TRUE(data.inOrder.load());
+
+    blockPromise.set_value();
+    celix_framework_waitForGenericEvent(fw, blockingEventId);
+    celix_framework_waitForEmptyEventQueue(fw);
+
+    celix_frameworkFactory_destroyFramework(fw);
+}
+
+TEST_F(FrameworkFactoryTestSuite, ServiceTrackerCallbacksAreOrderedWithMultipleEventDispatcherThreadsTest) {
+    /* Rule: When a Celix framework is configured with multiple event dispatcher threads, service tracker callbacks
+     * are still called in order and never concurrently, also if the services are (un)registered from parallel
+     * generic events handled by different event loop threads.
+     */
+    auto* config = celix_properties_create();
+    celix_properties_set(config, CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS, "4");
+    framework_t* fw = celix_frameworkFactory_createFramework(config);
+    ASSERT_TRUE(fw != nullptr);
+    auto* ctx = celix_framework_getFrameworkContext(fw);
+
+    std::vector<long> bndIds{};
+    bndIds.push_back(celix_framework_installBundle(fw, SIMPLE_TEST_BUNDLE1_LOCATION, false));
+    bndIds.push_back(celix_framework_installBundle(fw, SIMPLE_TEST_BUNDLE2_LOCATION, false));
+    bndIds.push_back(celix_framework_installBundle(fw, SIMPLE_TEST_BUNDLE3_LOCATION, false));
+    for (auto bndId : bndIds) {
+        ASSERT_GT(bndId, 0); //note bundle id 1, 2 and 3 -> parallel generic events handled by different event loops
+    }
+
+    struct TrackerData {
+        std::atomic<int> inCallback{0};
+        std::atomic<bool> concurrentCallbacks{false};
+        std::atomic<bool> removedBeforeAdded{false};
+        std::atomic<int> addCount{0};
+        std::atomic<int> removeCount{0};
+        std::mutex mutex{};
+        std::set<long> added{};
+    };
+    TrackerData trackerData{};
+    celix_service_tracking_options_t opts{};
+    opts.filter.serviceName = "ordering_test_service";
+    opts.callbackHandle = &trackerData;
+    opts.addWithProperties = [](void* handle, void*, const celix_properties_t* props) {
+        auto* data = static_cast<TrackerData*>(handle);
+        if (data->inCallback.fetch_add(1) != 0) {
+            data->concurrentCallbacks = true;
+        }
+        std::this_thread::yield();
+        {
+            std::lock_guard<std::mutex> lck{data->mutex};
+            data->added.insert(celix_properties_getAsLong(props, CELIX_FRAMEWORK_SERVICE_ID, -1L));
+        }
+        data->addCount.fetch_add(1);
+        data->inCallback.fetch_sub(1);
+    };
+    opts.removeWithProperties = [](void* handle, void*, const celix_properties_t* props) {
+        auto* data = static_cast<TrackerData*>(handle);
+        if (data->inCallback.fetch_add(1) != 0) {
+            data->concurrentCallbacks = true;
+        }
+        std::this_thread::yield();
+        {
+            std::lock_guard<std::mutex> lck{data->mutex};
+            if (data->added.erase(celix_properties_getAsLong(props, CELIX_FRAMEWORK_SERVICE_ID, -1L)) == 0) {
+                data->removedBeforeAdded = true;
+            }
+        }
+        data->removeCount.fetch_add(1);
+        data->inCallback.fetch_sub(1);
+    };
+    long trackerId = celix_bundleContext_trackServicesWithOptions(ctx, &opts);
+    ASSERT_GE(trackerId, 0);
+    celix_framework_waitForEmptyEventQueue(fw);
+
+    //(un)register services from parallel generic events, handled by different event loop threads
+    static int dummySvc = 0;
+    for (int i = 0; i < 50; ++i) {
+        for (auto bndId : bndIds) {
+            celix_framework_fireParallelGenericEvent(fw, -1L, bndId, "register event", ctx, [](void* data) {
+                auto* ctx = static_cast<celix_bundle_context_t*>(data);
+                long svcId = celix_bundleContext_registerServiceAsync(ctx, &dummySvc, "ordering_test_service", nullptr);
+                celix_bundleContext_unregisterServiceAsync(ctx, svcId, nullptr, nullptr);
+            }, nullptr, nullptr);
+        }
+    }
+    celix_framework_waitForEmptyEventQueue(fw);
+
+    EXPECT_EQ(150, trackerData.addCount.load());
+    EXPECT_EQ(150, trackerData.removeCount.load());
+    EXPECT_FALSE(trackerData.concurrentCallbacks.load());
+    EXPECT_FALSE(trackerData.removedBeforeAdded.load());
+
+    celix_bundleContext_stopTracker(ctx, trackerId);
+    celix_frameworkFactory_destroyFramework(fw);
+}
+
+TEST_F(FrameworkFactoryTestSuite, WaitForGenericEventOnlyWaitsForThatEventTest) {
+    /* Rule: Waiting for a generic event only waits until that event is handled, not until unrelated events - e.g.
+     * events blocking another event loop thread - are handled.
+     */
+    auto* config = celix_properties_create();
+    celix_properties_set(config, CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS, "2");
+    framework_t* fw = celix_frameworkFactory_createFramework(config);
+    ASSERT_TRUE(fw != nullptr);
+
+    long bndId = celix_framework_installBundle(fw, SIMPLE_TEST_BUNDLE1_LOCATION, false);
+    ASSERT_EQ(1, bndId); //note bundle id 1 -> parallel generic events handled by the second event loop thread
+
+    //block the event loop thread of bundle 1
+    std::promise<void> blockPromise{};
+    std::shared_future<void> blockFuture = blockPromise.get_future().share();
+    long blockingEventId = celix_framework_fireParallelGenericEvent(fw, -1L, bndId, "blocking event",
+        static_cast<void*>(&blockFuture), [](void* data) {
+            auto* future = static_cast<std::shared_future<void>*>(data);
+            future->wait();
+        }, nullptr, nullptr);
+    EXPECT_GE(blockingEventId, 0);
+
+    //waiting for an event on the ordered event loop should not wait for the blocked event loop thread
+    long eventId = celix_framework_fireGenericEvent(fw, -1L, CELIX_FRAMEWORK_BUNDLE_ID, "event", nullptr, nullptr, nullptr, nullptr);
+    auto waitResult = std::async(std::launch::async, [fw, eventId] {
+        celix_framework_waitForGenericEvent(fw, eventId);
+    });
+    EXPECT_EQ(std::future_status::ready, waitResult.wait_for(std::chrono::seconds{5}));
+
+    blockPromise.set_value();
+    celix_framework_waitForGenericEvent(fw, blockingEventId);
+    waitResult.wait();
+    celix_frameworkFactory_destroyFramework(fw);
+}
@@ -156,6 +156,31 @@ TEST_F(CxxBundleContextTestSuite, UseServicesTest) {
     EXPECT_EQ(countFromFunction.load(), 4);
 }
 
+TEST_F(CxxBundleContextTestSuite, UseCachedServicesTest) {
+    auto count = ctx->useService<CInterface>().setCached().build();
+    EXPECT_EQ(count, 0);
+
+    auto svc = std::make_shared<CInterface>(CInterface{nullptr, nullptr});
+    auto svcReg1 = ctx->registerService<CInterface>(svc).build();
+    auto svcReg2 = ctx->registerService<CInterface>(svc).build();
+    ctx->waitForEvents();
+
+    std::atomic<int> countFromFunction{0};
+    for (int i = 0; i < 10; ++i) {
+        count = ctx->useService<CInterface>().setCached().addUseCallback([&countFromFunction](CInterface&){countFromFunction += 1;}).build();
+        EXPECT_EQ(count, 1);
+    }
+    EXPECT_EQ(countFromFunction.load(), 10);
+
+    count = ctx->useServices<CInterface>().setCached().build();
+    EXPECT_EQ(count, 2);
+
+    svcReg2->unregister();
+    svcReg2->wait();
+    count = ctx->useServices<CInterface>().setCached().build();
+    EXPECT_EQ(count, 1);
+}
+
 TEST_F(CxxBundleContextTestSuite, UseServicesWithFilterTest) {
     auto svc = std::make_shared<CInterface>(CInterface{nullptr, nullptr});
     auto svcReg1 = ctx->registerService<CInterface>(svc).build();
@@ -536,6 +561,45 @@ TEST_F(CxxBundleContextTestSuite, SyncServiceRegistration) {
     EXPECT_EQ(svcId, -1L);
 }
 
+TEST_F(CxxBundleContextTestSuite, RegisterServiceGroup) {
+    std::atomic<int> count{};
+    auto impl = std::make_shared<TestImplementation>();
+    auto svcRegs = ctx->registerServiceGroup()
+            .add(ctx->registerService<TestInterface>(impl)
+                    .setVersion("1.0.0")
+                    .addProperty("key", "value1")
+                    .addOnRegistered([&count](celix::ServiceRegistration& reg) {
+                        EXPECT_EQ(celix::ServiceRegistrationState::REGISTERED, reg.getState());
+                        count++;
+                    }))
+            .add(ctx->registerService<TestInterface>(impl, "foo"))
+            .add(ctx->registerUnmanagedService<TestInterface>(impl.get())
+                    .addProperty("key", "value2")
+                    .addOnUnregistered([&count](celix::ServiceRegistration& reg) {
+                        EXPECT_EQ(celix::ServiceRegistrationState::UNREGISTERED, reg.getState());
+                        count--;
+                    }))
+            .build();
+    ASSERT_EQ(svcRegs.size(), 3);
+    EXPECT_EQ(count.load(), 1);
+    for (const auto& reg : svcRegs) {
+        //note a group is registered sync
+        EXPECT_EQ(reg->getState(), celix::ServiceRegistrationState::REGISTERED);
+        EXPECT_GE(reg->getServiceId(), 0L);
+    }
+    EXPECT_EQ(svcRegs[0]->getServiceVersion(), "1.0.0");
+    EXPECT_EQ(svcRegs[1]->getServiceName(), "foo");
+    EXPECT_EQ(ctx->findServices<TestInterface>().size(), 2);
+    EXPECT_EQ(ctx->findServices<TestInterface>("(key=value2)"), (std::vector<long>{svcRegs[2]->getServiceId()}));
+    EXPECT_EQ(ctx->findService<TestInterface>("", "[1,2)"), svcRegs[0]->getServiceId());
+
+    svcRegs[2]->unregister(); //note unmanaged service, so unregistered sync
+    EXPECT_EQ(count.load(), 0);
+    svcRegs.clear();
+    ctx->waitForEvents();
+    EXPECT_EQ(ctx->findServices<TestInterface>().size(), 0);
+}
+
 TEST_F(CxxBundleContextTestSuite, UnregisterServiceWhileRegistering) {
     auto context = ctx;
     ctx->getFramework()->fireGenericEvent(
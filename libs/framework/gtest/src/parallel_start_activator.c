@@ -0,0 +1,63 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+
+#include "celix_bundle_activator.h"
+
+#define PARALLEL_START_MARKER_SERVICE_NAME "parallel_start_marker"
+#define PARALLEL_START_BUNDLE_PROPERTY_NAME "parallel.start.bundle"
+#define PARALLEL_START_WAIT_TIMEOUT_IN_SECONDS 5
+
+/**
+ * Test bundle activator which blocks in its start until another parallel start test bundle is starting.
+ * As result the parallel start test bundles can only be started if their activators are started in parallel.
+ */
+struct bundle_act {
+    int dummySvc;
+    long svcId;
+};
+
+static celix_status_t act_start(struct bundle_act *act, celix_bundle_context_t *ctx) {
+    const char* symbolicName = celix_bundle_getSymbolicName(celix_bundleContext_getBundle(ctx));
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_set(props, PARALLEL_START_BUNDLE_PROPERTY_NAME, symbolicName);
+    act->svcId = celix_bundleContext_registerService(ctx, &act->dummySvc, PARALLEL_START_MARKER_SERVICE_NAME, props);
+
+    char filter[256];
+    snprintf(filter, sizeof(filter), "(!(%s=%s))", PARALLEL_START_BUNDLE_PROPERTY_NAME, symbolicName);
+    celix_service_use_options_t opts = CELIX_EMPTY_SERVICE_USE_OPTIONS;
+    opts.filter.serviceName = PARALLEL_START_MARKER_SERVICE_NAME;
+    opts.filter.filter = filter;
+    opts.waitTimeoutInSeconds = PARALLEL_START_WAIT_TIMEOUT_IN_SECONDS;
+    bool found = celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    if (!found) {
+        printf("Parallel start test bundle %s: other parallel start test bundle is not starting\n", symbolicName);
+        celix_bundleContext_unregisterService(ctx, act->svcId);
+        return CELIX_BUNDLE_EXCEPTION;
+    }
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t act_stop(struct bundle_act *act, celix_bundle_context_t *ctx) {
+    celix_bundleContext_unregisterService(ctx, act->svcId);
+    return CELIX_SUCCESS;
+}
+
+CELIX_GEN_BUNDLE_ACTIVATOR(struct bundle_act, act_start, act_stop);
@@ -116,6 +116,23 @@ namespace celix {
         }
 #endif
 
+        /**
+         * @brief Register a group of services in the Celix framework in a single batch.
+         *
+         * The services of the group are added using ServiceRegistrationBuilder objects:
+         *
+         *      std::shared_ptr<celix::BundleContext> ctx = ...
+         *      auto svcRegs = ctx->registerServiceGroup()
+         *          .add(ctx->registerService<IExample>(std::make_shared<ExampleImpl>()).setVersion("1.0.0"))
+         *          .add(ctx->registerService<IOther>(std::make_shared<OtherImpl>()))
+         *          .build();
+         *
+         * @return A ServiceRegistrationGroupBuilder object.
+         */
+        ServiceRegistrationGroupBuilder registerServiceGroup() {
+            return ServiceRegistrationGroupBuilder{cCtx};
+        }
+
         //TODO registerServiceFactory<I>()
 
         /**
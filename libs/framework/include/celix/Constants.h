@@ -141,6 +141,30 @@ namespace celix {
      */
     constexpr const char * const FRAMEWORK_STATIC_EVENT_QUEUE_SIZE = CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE;
 
+    /**
+     * @brief Celix framework environment property (named "CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS") which configures
+     * the number of event loop threads used by the Celix framework.
+     *
+     * All events which can trigger listener or service tracker callbacks are handled in order by the first event loop
+     * thread. The additional event loop threads only handle parallel generic events
+     * (see celix::Framework::fireParallelGenericEvent) of unrelated bundles in parallel.
+     *
+     * Default is CELIX_FRAMEWORK_DEFAULT_EVENT_DISPATCHER_THREADS which is 1, but can be override with a compiler
+     * define (same name).
+     */
+    constexpr const char * const FRAMEWORK_EVENT_DISPATCHER_THREADS = CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS;
+
+    /**
+     * @brief Celix framework environment property (named "CELIX_FRAMEWORK_SERVICE_REGISTRY_INDEXED_ATTRIBUTES") which
+     * configures a comma separated list of service property names the service registry should index.
+     *
+     * Service lookups and service trackers with a filter containing a mandatory equals value for one of these
+     * attributes only need to filter match the services with that attribute value.
+     *
+     * Default is empty (only service name and service id are indexed).
+     */
+    constexpr const char * const FRAMEWORK_SERVICE_REGISTRY_INDEXED_ATTRIBUTES = CELIX_FRAMEWORK_SERVICE_REGISTRY_INDEXED_ATTRIBUTES;
+
     /**
      * @brief Celix framework environment property (named "CELIX_AUTO_START_0") which specified a (ordered) space
      * separated set of bundles to load and auto start when the Celix framework is started.
@@ -85,6 +85,34 @@ namespace celix {
                     nullptr);
         }
 
+        /**
+         * @brief Fire a generic Celix framework event which can be handled in parallel with the events of other bundles.
+         *
+         * Same as Framework::fireGenericEvent, but the event is handled by the event loop of the bundle identified by
+         * bndId instead of the ordered event loop. If more than 1 event dispatcher thread is configured
+         * (celix::FRAMEWORK_EVENT_DISPATCHER_THREADS), the event can be handled concurrently with other events,
+         * including listener and service tracker callbacks.
+         *
+         * @return the event id (can be used in Framework::waitForEvent).
+         */
+        long fireParallelGenericEvent(long bndId, const char* eventName, std::function<void()> processEventCallback, long eventId = -1) {
+            auto* callbackOnHeap = new std::function<void()>{};
+            *callbackOnHeap = std::move(processEventCallback);
+            return celix_framework_fireParallelGenericEvent(
+                    cFw.get(),
+                    eventId,
+                    bndId,
+                    eventName,
+                    static_cast<void*>(callbackOnHeap),
+                    [](void *data) {
+                        auto* callback = static_cast<std::function<void()>*>(data);
+                        (*callback)();
+                        delete callback;
+                    },
+                    nullptr,
+                    nullptr);
+        }
+
         /**
          * @brief Block until the framework is stopped.
          */
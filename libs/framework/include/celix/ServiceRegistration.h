@@ -97,6 +97,79 @@ namespace celix {
         }
 #endif
 
+        /**
+         * @brief A service to register with ServiceRegistration::createGroup.
+         */
+        struct GroupEntry {
+            std::shared_ptr<void> svc;
+            std::string name;
+            std::string version;
+            celix::Properties properties;
+            bool unregisterAsync;
+            std::vector<std::function<void(ServiceRegistration&)>> onRegisteredCallbacks;
+            std::vector<std::function<void(ServiceRegistration&)>> onUnregisteredCallbacks;
+        };
+
+        /**
+         * @brief Register a group of services in a single batch.
+         *
+         * The services are registered synchronized using celix_bundleContext_registerServicesBatch, so the
+         * service registry is updated once and service trackers are informed in a single pass.
+         *
+         * @param cCtx The C bundle context.
+         * @param entries The services to register.
+         * @return The new ServiceRegistration objects as shared ptr, in the order of the provided entries.
+         * @throws celix::Exception if not all services can be registered. The services of the group that are
+         * registered will then be unregistered again.
+         */
+        static std::vector<std::shared_ptr<ServiceRegistration>> createGroup(
+                const std::shared_ptr<celix_bundle_context_t>& cCtx,
+                std::vector<GroupEntry> entries) {
+            std::vector<std::shared_ptr<ServiceRegistration>> regs{};
+            regs.reserve(entries.size());
+            for (auto& entry : entries) {
+                auto reg = createShared(new ServiceRegistration{
+                        cCtx,
+                        std::move(entry.svc),
+                        entry.name.c_str(),
+                        entry.version.c_str(),
+                        std::move(entry.properties),
+                        false,
+                        entry.unregisterAsync,
+                        std::move(entry.onRegisteredCallbacks),
+                        std::move(entry.onUnregisteredCallbacks)});
+                reg->setSelf(reg);
+                regs.emplace_back(std::move(reg));
+            }
+
+            std::vector<celix_service_registration_options_t> opts(regs.size());
+            for (std::size_t i = 0; i < regs.size(); ++i) {
+                opts[i].svc = regs[i]->svc.get();
+                opts[i].serviceName = regs[i]->name.c_str();
+                opts[i].properties = celix_properties_copy(regs[i]->properties.getCProperties());
+                if (!regs[i]->version.empty()) {
+                    opts[i].serviceVersion = regs[i]->version.c_str();
+                }
+            }
+            std::vector<long> svcIds(regs.size(), -1L);
+            std::size_t registered = celix_bundleContext_registerServicesBatch(cCtx.get(), opts.data(), opts.size(), svcIds.data());
+            for (std::size_t i = 0; i < regs.size(); ++i) {
+                std::lock_guard<std::mutex> lck{regs[i]->mutex};
+                regs[i]->svcId = svcIds[i];
+                regs[i]->state = svcIds[i] >= 0 ? ServiceRegistrationState::REGISTERED : ServiceRegistrationState::UNREGISTERED;
+            }
+            if (registered != regs.size()) {
+                throw celix::Exception{"Cannot register service group"};
+            }
+
+            for (const auto& reg : regs) {
+                for (const auto& cb : reg->onRegisteredCallbacks) {
+                    cb(*reg);
+                }
+            }
+            return regs;
+        }
+
         /**
          * @brief The service name for this service registration.
          */
@@ -255,6 +328,26 @@ namespace celix {
                 bool unregisterAsync,
                 std::vector<std::function<void(ServiceRegistration&)>> onRegisteredCallbacks,
         std::vector<std::function<void(ServiceRegistration&)>> onUnregisteredCallbacks) {
+            auto reg = createShared(new ServiceRegistration{
+                    std::move(cCtx),
+                    std::move(svc),
+                    name,
+                    version,
+                    std::move(properties),
+                    registerAsync,
+                    unregisterAsync,
+                    std::move(onRegisteredCallbacks),
+                    std::move(onUnregisteredCallbacks)});
+            reg->setSelf(reg);
+            reg->registerService();
+            return reg;
+        }
+
+        /**
+         * @brief Create a shared ptr for a new ServiceRegistration, which unregisters the service when the last
+         * shared ptr goes out of scope.
+         */
+        static std::shared_ptr<ServiceRegistration> createShared(ServiceRegistration* reg) {
             auto delCallback = [](ServiceRegistration* reg) {
                 if (reg->getState() == ServiceRegistrationState::UNREGISTERED) {
                     delete reg;
@@ -285,23 +378,7 @@ namespace celix {
                             nullptr);
                 }
             };
-
-            auto reg = std::shared_ptr<ServiceRegistration>{
-                    new ServiceRegistration{
-                            std::move(cCtx),
-                            std::move(svc),
-                            name,
-                            version,
-                            std::move(properties),
-                            registerAsync,
-                            unregisterAsync,
-                            std::move(onRegisteredCallbacks),
-                            std::move(onUnregisteredCallbacks)},
-                    delCallback
-            };
-            reg->setSelf(reg);
-            reg->registerService();
-            return reg;
+            return std::shared_ptr<ServiceRegistration>{reg, delCallback};
         }
 
         /**
@@ -27,6 +27,8 @@
 #include "celix/ServiceRegistration.h"
 
 namespace celix {
+
+    class ServiceRegistrationGroupBuilder;
     /**
      * @brief Fluent builder API to build a new service registration for a service.
      *
@@ -38,6 +40,7 @@ namespace celix {
     class ServiceRegistrationBuilder {
     private:
         friend class BundleContext;
+        friend class ServiceRegistrationGroupBuilder;
 
         //NOTE private to prevent move so that a build() call cannot be forgotten
         ServiceRegistrationBuilder(ServiceRegistrationBuilder&&) noexcept = default;
@@ -196,4 +199,74 @@ namespace celix {
         std::vector<std::function<void(ServiceRegistration&)>> onRegisteredCallbacks{};
         std::vector<std::function<void(ServiceRegistration&)>> onUnregisteredCallbacks{};
     };
-}
\ No newline at end of file
+
+    /**
+     * @brief Fluent builder API to register a group of services in a single batch.
+     *
+     * The services are configured with the ServiceRegistrationBuilder API and registered together in the
+     * build() call, using celix_bundleContext_registerServicesBatch: the services are added to the service registry
+     * under a single registry lock and the service trackers are informed in a single pass.
+     *
+     *      std::shared_ptr<celix::BundleContext> ctx = ...
+     *      auto svcRegs = ctx->registerServiceGroup()
+     *          .add(ctx->registerService<IExample>(std::make_shared<ExampleImpl>()).addProperty("key1", "value1"))
+     *          .add(ctx->registerService<IOther>(std::make_shared<OtherImpl>()))
+     *          .build();
+     *
+     * The group is always registered synchronized, the register async configuration of the added builders is
+     * ignored. The returned service registrations are unregistered individually.
+     *
+     * @note Not thread safe.
+     */
+    class ServiceRegistrationGroupBuilder {
+    private:
+        friend class BundleContext;
+        //NOTE private to prevent move so that a build() call cannot be forgotten
+        ServiceRegistrationGroupBuilder(ServiceRegistrationGroupBuilder&&) noexcept = default;
+
+        explicit ServiceRegistrationGroupBuilder(std::shared_ptr<celix_bundle_context_t> _cCtx) : cCtx{std::move(_cCtx)} {}
+    public:
+        ServiceRegistrationGroupBuilder& operator=(ServiceRegistrationGroupBuilder&&) = delete;
+        ServiceRegistrationGroupBuilder(const ServiceRegistrationGroupBuilder&) = delete;
+        ServiceRegistrationGroupBuilder operator=(const ServiceRegistrationGroupBuilder&) = delete;
+
+        /**
+         * @brief Add the service configured by the provided ServiceRegistrationBuilder to the group.
+         *
+         * The configuration is moved out of the builder, so the builder should not be used afterwards.
+         */
+        template<typename I>
+        ServiceRegistrationGroupBuilder& add(ServiceRegistrationBuilder<I>& builder) {
+            entries.emplace_back(ServiceRegistration::GroupEntry{
+                    std::move(builder.svc),
+                    std::move(builder.name),
+                    std::move(builder.version),
+                    std::move(builder.properties),
+                    builder.unregisterAsync,
+                    std::move(builder.onRegisteredCallbacks),
+                    std::move(builder.onUnregisteredCallbacks)});
+            return *this;
+        }
+
+        /**
+         * @brief Add the service configured by the provided ServiceRegistrationBuilder to the group.
+         */
+        template<typename I>
+        ServiceRegistrationGroupBuilder& add(ServiceRegistrationBuilder<I>&& builder) {
+            return add(builder);
+        }
+
+        /**
+         * @brief "Builds" the service registrations and registers the group of services.
+         *
+         * @return The ServiceRegistrations, in the order the services are added.
+         * @throws celix::Exception if not all services can be registered.
+         */
+        std::vector<std::shared_ptr<ServiceRegistration>> build() {
+            return ServiceRegistration::createGroup(cCtx, std::move(entries));
+        }
+    private:
+        const std::shared_ptr<celix_bundle_context_t> cCtx;
+        std::vector<ServiceRegistration::GroupEntry> entries{};
+    };
+}
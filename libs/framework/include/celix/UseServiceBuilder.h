@@ -97,6 +97,17 @@ namespace celix {
             return *this;
         }
 
+        /**
+         * @brief Sets whether a service tracker cached in the bundle context should be used.
+         *
+         * If set, repeated use service calls with the same service name, version range and filter reuse a service
+         * tracker which is kept up to date by service events, instead of creating and destroying a service tracker
+         * for every "build". The use callbacks are called from the caller thread.
+         *
+         * @see CELIX_SERVICE_USE_CACHED
+         */
+        UseServiceBuilder& setCached(bool c = true) { cached = c; return *this; }
+
         /**
          * @brief Adds a use callback function which will be called when the UseServiceBuilder is
          * "build".
@@ -154,6 +165,7 @@ namespace celix {
             opts.filter.filter = filter.empty() ? nullptr : filter.getFilterCString();
             opts.filter.versionRange = versionRange.empty() ? nullptr : versionRange.c_str();
             opts.waitTimeoutInSeconds = timeoutInSeconds;
+            opts.flags = cached ? CELIX_SERVICE_USE_CACHED : 0;
             opts.callbackHandle = this;
             opts.useWithOwner = [](void* data, void *voidSvc, const celix_properties_t* cProps, const celix_bundle_t* cBnd) {
                 auto* builder = static_cast<UseServiceBuilder<I>*>(data);
@@ -183,6 +195,7 @@ namespace celix {
         const std::string name;
         const bool useSingleService;
         double timeoutInSeconds{0};
+        bool cached{false};
         celix::Filter filter{};
         std::string versionRange{};
         std::vector<std::function<void(I&)>> callbacks{};
@@ -44,6 +44,20 @@ extern "C" {
 #define CELIX_OPTS_INIT
 #endif
 
+/**
+ * @brief Threading contract of the Celix event loop.
+ *
+ * Async service (un)registrations, the creation and destruction of service/bundle/service tracker trackers and
+ * the resulting service tracker, bundle tracker and listener callbacks are handled by a single ordered Celix event
+ * loop thread, also if more than 1 event dispatcher thread is configured (CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS).
+ * As result, the tracker and listener callbacks of a bundle are never called concurrently from the Celix event loop
+ * and are called in the order of the events, e.g. a service tracker add callback for a service is always called
+ * before the remove callback for that service.
+ *
+ * The additional event dispatcher threads only handle generic events fired with
+ * celix_framework_fireParallelGenericEvent.
+ */
+
 /**
  * @brief Register a service to the Celix framework.
  *
@@ -242,6 +256,26 @@ CELIX_FRAMEWORK_EXPORT long celix_bundleContext_registerServiceWithOptionsAsync(
  */
 CELIX_FRAMEWORK_EXPORT long celix_bundleContext_registerServiceWithOptions(celix_bundle_context_t *ctx, const celix_service_registration_options_t *opts);
 
+/**
+ * @brief Register multiple services to the Celix framework in a single batch.
+ *
+ * The services are added to the service registry under a single registry lock and the service listeners and
+ * trackers are informed in a single pass: a tracker gets the events for all its matching services of the batch in a
+ * row, instead of the listeners being iterated once per service. This is more efficient for bundles that
+ * register many services at once.
+ *
+ * The batch is registered synchronized, the asyncData and asyncCallback options are ignored.
+ * Invalid registration options are logged and skipped.
+ *
+ * @param ctx The bundle context
+ * @param opts The array of registration options. The options are only used during the registration call.
+ * @param nrOfServices The number of registration options.
+ * @param serviceIds Optional output array (size nrOfServices) for the service ids. A service id is -1 if the
+ *                   corresponding service is not registered.
+ * @return The number of registered services.
+ */
+CELIX_FRAMEWORK_EXPORT size_t celix_bundleContext_registerServicesBatch(celix_bundle_context_t *ctx, const celix_service_registration_options_t *opts, size_t nrOfServices, long *serviceIds);
+
 /**
  * @brief Waits til the async service registration for the provided serviceId is done.
  *
@@ -290,6 +324,21 @@ CELIX_FRAMEWORK_EXPORT void celix_bundleContext_unregisterService(celix_bundle_c
  */
 CELIX_FRAMEWORK_EXPORT void celix_bundleContext_unregisterServiceAsync(celix_bundle_context_t *ctx, long serviceId, void* doneData, void (*doneCallback)(void* doneData));
 
+/**
+ * @brief Unregister multiple services or service factories in a single batch.
+ *
+ * The services are removed from the service registry under a single registry lock and the service listeners and
+ * trackers are informed in a single pass. The unregistration is done synchronized.
+ *
+ * Only the services of which the bundle of the bundle context is the owner will be unregistered.
+ * Will log an error for unknown service ids. Will silently ignore services ids < 0.
+ *
+ * @param ctx The bundle context
+ * @param serviceIds The array of service ids.
+ * @param nrOfServices The number of service ids.
+ */
+CELIX_FRAMEWORK_EXPORT void celix_bundleContext_unregisterServicesBatch(celix_bundle_context_t *ctx, const long *serviceIds, size_t nrOfServices);
+
 /**
  * @brief Waits til the async service unregistration for the provided serviceId is done.
  *
@@ -778,6 +827,21 @@ typedef struct celix_service_use_options {
      * Note that it has no effect in indirect mode, in which case "service on demand" is supported.
      */
 #define CELIX_SERVICE_USE_SOD                 (2)
+    /**
+     * @brief Use a service tracker cached in the bundle context instead of creating and destroying a service tracker
+     * for every use service call.
+     *
+     * The cached service tracker is created on the first use service call with the same service name, version range
+     * and filter and is kept up to date by service events until the bundle is stopped. The use callbacks are called
+     * from the caller thread directly, as with CELIX_SERVICE_USE_DIRECT.
+     * This is intended for frequently repeated use service calls with a fixed set of service filter options; every
+     * distinct combination of service filter options results in a cached service tracker.
+     * The number of cached service trackers per bundle is limited (64 by default, configurable with the compiler
+     * define CELIX_BUNDLE_CONTEXT_MAX_USE_SERVICE_CACHE_SIZE). If the limit is reached, use service calls for new
+     * service filter options use a temporary service tracker and call the use callbacks from the caller thread
+     * directly, as with CELIX_SERVICE_USE_DIRECT.
+     */
+#define CELIX_SERVICE_USE_CACHED              (4)
     int flags CELIX_OPTS_INIT;
 } celix_service_use_options_t;
 
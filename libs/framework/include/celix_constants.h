@@ -184,6 +184,24 @@ extern "C" {
 //@deprecated use CELIX_FRAMEWORK_CACHE_USE_TMP_DIR
 #define CELIX_FRAMEWORK_STORAGE_USE_TMP_DIR "org.osgi.framework.storage.use.tmp.dir"
 
+/**
+ * @brief Celix framework environment property (named "CELIX_FRAMEWORK_CACHE_USE_BUNDLE_STORE") specifying whether
+ * to use a content-addressed bundle store for the bundle caches.
+ *
+ * If set to "true", bundle zip files are extracted once to a "bundle_store" directory in the cache dir, keyed by the
+ * hash of the zip content, and the bundle caches are populated with hardlinks to the extracted files (or copies if
+ * hardlinks are not supported). The content hash of a bundle zip file is kept in a persistent index, so that an
+ * unchanged bundle zip file is not read again. The bundle store is kept when the cache dir is cleaned.
+ *
+ * Only used for file bundle urls, embedded bundles are always extracted.
+ *
+ * Note that the resource files of bundles with the same zip content share the same inode and are therefore
+ * read-only. Shared libraries are copied and are not shared.
+ *
+ * The default value is false.
+ */
+#define CELIX_FRAMEWORK_CACHE_USE_BUNDLE_STORE "CELIX_FRAMEWORK_CACHE_USE_BUNDLE_STORE"
+
 /**
  * @brief Celix framework environment property (named "CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE") specifying
  * whether to delete the cache dir on framework creation.
@@ -265,6 +283,37 @@ extern "C" {
  */
 #define CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE "CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE"
 
+/**
+ * @brief Celix framework environment property (named "CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS") which configures
+ * the number of event loop threads used by the Celix framework.
+ *
+ * The Celix framework handles bundle events, framework events, async service (un)registrations and generic events
+ * in event loop threads. Every event loop thread has its own event queue.
+ * All events which can trigger listener or service tracker callbacks - bundle, framework and service events and
+ * generic events fired with celix_framework_fireGenericEvent - are handled in order by the first (ordered) event
+ * loop thread, so these callbacks are never called concurrently.
+ * The additional event loop threads only handle generic events fired with celix_framework_fireParallelGenericEvent,
+ * based on the bundle id of the event. Parallel generic events of a single bundle are handled in order, parallel
+ * generic events of unrelated bundles can be handled in parallel.
+ *
+ * Default is CELIX_FRAMEWORK_DEFAULT_EVENT_DISPATCHER_THREADS which is 1, but can be override with a compiler
+ * define (same name).
+ */
+#define CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS "CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS"
+
+/**
+ * @brief Celix framework environment property (named "CELIX_FRAMEWORK_SERVICE_REGISTRY_INDEXED_ATTRIBUTES") which
+ * configures a comma separated list of service property names the service registry should index.
+ *
+ * The service registry always indexes services on their service name (objectClass) and service id. For the
+ * configured attributes an additional equality index is maintained, so that service lookups and service trackers
+ * with a filter containing a mandatory equals value for one of these attributes (e.g. "(&(objectClass=foo)(key=value))")
+ * only need to filter match the services with that attribute value.
+ *
+ * Default is empty (no additional attribute indexes).
+ */
+#define CELIX_FRAMEWORK_SERVICE_REGISTRY_INDEXED_ATTRIBUTES "CELIX_FRAMEWORK_SERVICE_REGISTRY_INDEXED_ATTRIBUTES"
+
 /**
  * @brief Celix framework environment property (named "CELIX_AUTO_START_0") which specified a (ordered) space
  * separated set of bundles to load and auto start when the Celix framework is started.
@@ -322,6 +371,24 @@ extern "C" {
  */
 #define CELIX_AUTO_INSTALL "CELIX_AUTO_INSTALL"
 
+/**
+ * @brief Celix framework environment property (named "CELIX_FRAMEWORK_AUTO_START_THREADS") which configures the
+ * number of threads used to install and start the bundles configured with CELIX_AUTO_START_0 till CELIX_AUTO_START_6
+ * and CELIX_AUTO_INSTALL.
+ *
+ * If more than 1 thread is configured, the bundles of a single auto start level (e.g. CELIX_AUTO_START_1) are
+ * installed - i.e. their bundle archives are extracted - in parallel and their bundle activators are started in
+ * parallel. Levels are still handled in order: the bundles of the next level are only started after all bundles of
+ * the previous level are started. The bundle ids are assigned in the configured order.
+ *
+ * Note that when bundles are started in parallel, the start order of bundles within a level is not defined and
+ * bundles within a level are stopped in their configured reverse order.
+ *
+ * Default is CELIX_FRAMEWORK_DEFAULT_AUTO_START_THREADS which is 1, but can be override with a compiler define
+ * (same name).
+ */
+#define CELIX_FRAMEWORK_AUTO_START_THREADS "CELIX_FRAMEWORK_AUTO_START_THREADS"
+
 #ifdef __cplusplus
 }
 #endif
@@ -301,6 +301,10 @@ CELIX_FRAMEWORK_EXPORT bool celix_framework_isCurrentThreadTheEventLoop(celix_fr
 /**
  * @brief Fire a generic event. The event will be added to the event loop and handled on the event loop thread.
  *
+ * The event is handled by the ordered event loop, the same event loop which handles the bundle, framework and
+ * service events. As result the event is handled in order with these events and never concurrently with
+ * listener or service tracker callbacks.
+ *
  * if bndId >=0 the bundle usage count will be increased while the event is not yet processed or finished processing.
  * The eventName is expected to be const char* valid during til the event is finished processing.
  *
@@ -309,6 +313,21 @@ CELIX_FRAMEWORK_EXPORT bool celix_framework_isCurrentThreadTheEventLoop(celix_fr
  */
 CELIX_FRAMEWORK_EXPORT long celix_framework_fireGenericEvent(celix_framework_t* fw, long eventId, long bndId, const char *eventName, void* processData, void (*processCallback)(void *data), void* doneData, void (*doneCallback)(void* doneData));
 
+/**
+ * @brief Fire a generic event which can be handled in parallel with the events of other bundles.
+ *
+ * Same as celix_framework_fireGenericEvent, but the event is handled by the event loop of the bundle identified
+ * by bndId (bundle id % CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS) instead of the ordered event loop.
+ * The parallel generic events of a single bundle are handled in order, but - if more than 1 event dispatcher thread
+ * is configured - they can be handled concurrently with other events, including listener and service tracker
+ * callbacks. So the process and done callbacks must be thread-safe and must not rely on the order of other events.
+ *
+ * If bndId < 0, the event is handled by the ordered event loop.
+ *
+ * return eventId
+ */
+CELIX_FRAMEWORK_EXPORT long celix_framework_fireParallelGenericEvent(celix_framework_t* fw, long eventId, long bndId, const char *eventName, void* processData, void (*processCallback)(void *data), void* doneData, void (*doneCallback)(void* doneData));
+
 /**
  * @brief Get the next event id.
  *
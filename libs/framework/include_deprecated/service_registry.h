@@ -99,6 +99,30 @@ celix_serviceRegistry_registerServiceFactory(
         long reserveId,
         service_registration_t **registration);
 
+/**
+ * A service for celix_serviceRegistry_registerServices.
+ */
+typedef struct celix_service_registry_batch_entry {
+    const char* serviceName;
+    void* service; //used if factory is NULL
+    celix_service_factory_t* factory;
+    celix_properties_t* properties; //the registry takes ownership of the properties
+    long reservedId;
+    service_registration_t* registration; //output
+} celix_service_registry_batch_entry_t;
+
+/**
+ * Register the provided services in a single batch.
+ *
+ * The services are added to the registry under a single registry lock and the service listeners are informed in a
+ * single pass: every matching listener gets the REGISTERED events of all its matching services of the batch in a row.
+ */
+CELIX_FRAMEWORK_EXPORT celix_status_t celix_serviceRegistry_registerServices(
+        celix_service_registry_t* reg,
+        const celix_bundle_t* bnd,
+        celix_service_registry_batch_entry_t* entries,
+        size_t nrOfEntries);
+
 /**
  * List the registered service for the provided bundle.
  * @return A list of service ids. Caller is owner of the array list.
@@ -134,6 +158,14 @@ CELIX_FRAMEWORK_EXPORT long celix_serviceRegistry_nextSvcId(celix_service_regist
  */
 CELIX_FRAMEWORK_EXPORT void celix_serviceRegistry_unregisterService(celix_service_registry_t* registry, celix_bundle_t* bnd, long serviceId);
 
+/**
+ * Unregister the services for the provided service ids (owned by bnd) in a single batch.
+ *
+ * The services are removed from the registry under a single registry lock and the service listeners are informed in
+ * a single pass. Will print an error for invalid service ids.
+ */
+CELIX_FRAMEWORK_EXPORT void celix_serviceRegistry_unregisterServices(celix_service_registry_t* registry, celix_bundle_t* bnd, const long* serviceIds, size_t nrOfServiceIds);
+
 
 /**
  * Create a LDAP filter for the provided filter parts.
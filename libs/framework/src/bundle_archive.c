@@ -57,6 +57,7 @@ struct bundleArchive {
     celix_thread_mutex_t lock;   // protects below and saving of bundle state properties
     bundle_revision_t* revision; // the current revision
     char* location;
+    char* contentHash; // the content hash of the current revision, if populated from the bundle store
 };
 
 static celix_status_t celix_bundleArchive_storeBundleStateProperties(bundle_archive_pt archive) {
@@ -86,6 +87,14 @@ static celix_status_t celix_bundleArchive_storeBundleStateProperties(bundle_arch
         celix_properties_set(bundleStateProperties, CELIX_BUNDLE_ARCHIVE_VERSION_PROPERTY_NAME, archive->bundleVersion);
         needUpdate = true;
     }
+    const char* contentHash = celix_properties_get(bundleStateProperties, CELIX_BUNDLE_ARCHIVE_CONTENT_HASH_PROPERTY_NAME, NULL);
+    if (archive->contentHash != NULL && (contentHash == NULL || strcmp(contentHash, archive->contentHash) != 0)) {
+        celix_properties_set(bundleStateProperties, CELIX_BUNDLE_ARCHIVE_CONTENT_HASH_PROPERTY_NAME, archive->contentHash);
+        needUpdate = true;
+    } else if (archive->contentHash == NULL && contentHash != NULL) {
+        celix_properties_unset(bundleStateProperties, CELIX_BUNDLE_ARCHIVE_CONTENT_HASH_PROPERTY_NAME);
+        needUpdate = true;
+    }
 
     //save bundle cache state properties
     if (needUpdate) {
@@ -96,11 +105,26 @@ static celix_status_t celix_bundleArchive_storeBundleStateProperties(bundle_arch
     return CELIX_SUCCESS;
 }
 
+/**
+ * Reads the content hash of the current revision from the stored bundle state properties, if not already known.
+ */
+static void celix_bundleArchive_readContentHash(bundle_archive_t* archive) {
+    if (archive->contentHash != NULL || !celix_utils_fileExists(archive->savedBundleStatePropertiesPath)) {
+        return;
+    }
+    celix_properties_t* bundleStateProperties = celix_properties_load(archive->savedBundleStatePropertiesPath);
+    const char* contentHash = celix_properties_get(bundleStateProperties, CELIX_BUNDLE_ARCHIVE_CONTENT_HASH_PROPERTY_NAME, NULL);
+    archive->contentHash = celix_utils_strdup(contentHash);
+    celix_properties_destroy(bundleStateProperties);
+}
+
 static celix_status_t
 celix_bundleArchive_extractBundle(bundle_archive_t* archive, const char* bundleUrl) {
     celix_status_t status = CELIX_SUCCESS;
     bool extractBundle = true;
 
+    celix_bundleArchive_readContentHash(archive);
+
     //get revision mod time;
     struct timespec revisionMod;
     status = celix_bundleArchive_getLastModifiedInternal(archive, &revisionMod);
@@ -119,6 +143,25 @@ celix_bundleArchive_extractBundle(bundle_archive_t* archive, const char* bundleU
         return status;
     }
 
+    if (celix_bundleCache_isBundleStoreEnabled(archive->fw->cache)) {
+        char* contentHash = NULL;
+        bool populated = false;
+        status = celix_bundleCache_populateRevisionFromStore(archive->fw->cache, bundleUrl, archive->resourceCacheRoot,
+                                                             archive->contentHash, &contentHash, &populated);
+        if (status == CELIX_SUCCESS) {
+            if (!populated) {
+                fw_log(archive->fw->logger, CELIX_LOG_LEVEL_TRACE, "Bundle archive %s content is unchanged, no need to extract bundle.", bundleUrl);
+            }
+            free(archive->contentHash);
+            archive->contentHash = contentHash;
+            return status;
+        } else if (status != CELIX_ILLEGAL_ARGUMENT) {
+            fw_log(archive->fw->logger, CELIX_LOG_LEVEL_ERROR, "Failed to initialize archive. Failed to populate revision directory from bundle store.");
+            return status;
+        }
+        //note not a file bundle url (e.g. an embedded bundle), extracting the bundle zip
+    }
+
     /*
      * Note always remove the current revision dir. This is needed to remove files that are not present
      * in the new bundle zip, but it seems this is also needed to ensure that the lib files get a new inode.
@@ -132,6 +175,9 @@ celix_bundleArchive_extractBundle(bundle_archive_t* archive, const char* bundleU
         return status;
     }
 
+    free(archive->contentHash);
+    archive->contentHash = NULL;
+
     status = celix_framework_utils_extractBundle(archive->fw, bundleUrl, archive->resourceCacheRoot);
     if (status != CELIX_SUCCESS) {
         fw_log(archive->fw->logger, CELIX_LOG_LEVEL_ERROR, "Failed to initialize archive. Failed to extract bundle zip to revision directory.");
@@ -310,6 +356,7 @@ celix_status_t bundleArchive_destroy(bundle_archive_pt archive) {
         free(archive->storeRoot);
         free(archive->bundleSymbolicName);
         free(archive->bundleVersion);
+        free(archive->contentHash);
         bundleRevision_destroy(archive->revision);
         celixThreadMutex_destroy(&archive->lock);
         free(archive);
@@ -445,6 +492,8 @@ celix_status_t bundleArchive_revise(bundle_archive_pt archive, const char * loca
     }
 
     const char* reason = NULL;
+    char* previousContentHash = celix_utils_strdup(archive->contentHash);
+    bool contentHashChanged = false;
     celix_status_t status = celix_bundleArchive_extractBundle(archive, updateUrl);
     if (status == CELIX_SUCCESS) {
         bundle_revision_t* current = archive->revision;
@@ -466,9 +515,19 @@ celix_status_t bundleArchive_revise(bundle_archive_pt archive, const char * loca
         free(archive->location);
         archive->location = celix_utils_strdup(updateUrl);
     }
+    //note the content hash of the revision can be changed, so the bundle state properties need to be updated
+    status = celix_bundleArchive_storeBundleStateProperties(archive);
+    reason = status != CELIX_SUCCESS ? "storing bundle state properties" : NULL;
+    //note a revise to a different bundle zip can leave the previous bundle store entry unused
+    contentHashChanged = previousContentHash != NULL &&
+                         (archive->contentHash == NULL || strcmp(previousContentHash, archive->contentHash) != 0);
 revise_finished:
     celixThreadMutex_unlock(&archive->lock);
     framework_logIfError(archive->fw->logger, status, reason, "Cannot update bundle archive %s", updateUrl);
+    if (status == CELIX_SUCCESS && contentHashChanged) {
+        celix_bundleCache_collectBundleStoreGarbage(archive->fw->cache);
+    }
+    free(previousContentHash);
     return status;
 }
 
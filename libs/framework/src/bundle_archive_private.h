@@ -35,6 +35,7 @@ extern "C" {
 #define CELIX_BUNDLE_ARCHIVE_VERSION_PROPERTY_NAME "bundle.version"
 #define CELIX_BUNDLE_ARCHIVE_BUNDLE_ID_PROPERTY_NAME "bundle.id"
 #define CELIX_BUNDLE_ARCHIVE_LOCATION_PROPERTY_NAME "bundle.location"
+#define CELIX_BUNDLE_ARCHIVE_CONTENT_HASH_PROPERTY_NAME "bundle.content_hash"
 
 #define CELIX_BUNDLE_ARCHIVE_RESOURCE_CACHE_NAME "resources"
 #define CELIX_BUNDLE_ARCHIVE_STORE_DIRECTORY_NAME "storage"
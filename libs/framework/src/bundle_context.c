@@ -48,6 +48,7 @@ static void bundleContext_cleanupBundleTrackers(bundle_context_t *ct);
 static void bundleContext_cleanupServiceTrackers(bundle_context_t *ctx);
 static void bundleContext_cleanupServiceTrackerTrackers(bundle_context_t *ctx);
 static void bundleContext_cleanupServiceRegistration(bundle_context_t* ctx);
+static void bundleContext_cleanupUseServiceCache(bundle_context_t* ctx);
 static long celix_bundleContext_trackServicesWithOptionsInternal(celix_bundle_context_t *ctx, const celix_service_tracking_options_t *opts, bool async);
 
 celix_status_t bundleContext_create(framework_pt framework, celix_framework_logger_t*  logger, bundle_pt bundle, bundle_context_pt *bundle_context) {
@@ -72,6 +73,9 @@ celix_status_t bundleContext_create(framework_pt framework, celix_framework_logg
             context->serviceTrackers = hashMap_create(NULL,NULL,NULL,NULL);
             context->metaTrackers =  hashMap_create(NULL,NULL,NULL,NULL);
             context->stoppingTrackerEventIds = hashMap_create(NULL,NULL,NULL,NULL);
+            celixThreadRwlock_create(&context->useServiceCacheLock, NULL);
+            context->useServiceCache = celix_stringHashMap_create();
+            celixThreadCondition_init(&context->useServiceCacheCond, NULL);
             context->nextTrackerId = 1L;
 
             *bundle_context = context;
@@ -98,6 +102,10 @@ celix_status_t bundleContext_destroy(bundle_context_pt context) {
     assert(celix_arrayList_size(context->svcRegistrations) == 0);
     celix_arrayList_destroy(context->svcRegistrations);
     hashMap_destroy(context->stoppingTrackerEventIds, false, false);
+    assert(celix_stringHashMap_size(context->useServiceCache) == 0);
+    celix_stringHashMap_destroy(context->useServiceCache);
+    celixThreadRwlock_destroy(&context->useServiceCacheLock);
+    celixThreadCondition_destroy(&context->useServiceCacheCond);
 
     celixThreadMutex_destroy(&context->mutex);
 
@@ -114,6 +122,7 @@ celix_status_t bundleContext_destroy(bundle_context_pt context) {
 void celix_bundleContext_cleanup(celix_bundle_context_t *ctx) {
     //NOTE not perfect, because stopping of registrations/tracker when the activator is destroyed can lead to segfault.
     //but at least we can try to warn the bundle implementer that some cleanup is missing.
+    bundleContext_cleanupUseServiceCache(ctx);
     bundleContext_cleanupBundleTrackers(ctx);
     bundleContext_cleanupServiceTrackers(ctx);
     bundleContext_cleanupServiceTrackerTrackers(ctx);
@@ -363,19 +372,21 @@ long celix_bundleContext_registerServiceFactory(celix_bundle_context_t *ctx, cel
     return celix_bundleContext_registerServiceWithOptions(ctx, &opts);
 }
 
-static long celix_bundleContext_registerServiceWithOptionsInternal(bundle_context_t *ctx, const celix_service_registration_options_t *opts, bool async) {
+static bool celix_bundleContext_checkServiceRegistrationOptions(celix_bundle_context_t *ctx, const celix_service_registration_options_t *opts) {
     bool valid = opts->serviceName != NULL && strncmp("", opts->serviceName, 1) != 0;
     if (!valid) {
         fw_log(ctx->framework->logger, CELIX_LOG_LEVEL_ERROR, "Required serviceName argument is NULL or empty");
-        return -1;
+        return false;
     }
     valid = opts->svc != NULL || opts->factory != NULL;
     if (!valid) {
         fw_log(ctx->framework->logger, CELIX_LOG_LEVEL_ERROR, "Required svc or factory argument is NULL");
-        return -1;
+        return false;
     }
+    return true;
+}
 
-    //set properties
+static celix_properties_t* celix_bundleContext_createServiceProperties(const celix_service_registration_options_t *opts) {
     celix_properties_t *props = opts->properties;
     if (props == NULL) {
         props = celix_properties_create();
@@ -383,6 +394,16 @@ static long celix_bundleContext_registerServiceWithOptionsInternal(bundle_contex
     if (opts->serviceVersion != NULL && strncmp("", opts->serviceVersion, 1) != 0) {
         celix_properties_set(props, CELIX_FRAMEWORK_SERVICE_VERSION, opts->serviceVersion);
     }
+    return props;
+}
+
+static long celix_bundleContext_registerServiceWithOptionsInternal(bundle_context_t *ctx, const celix_service_registration_options_t *opts, bool async) {
+    if (!celix_bundleContext_checkServiceRegistrationOptions(ctx, opts)) {
+        return -1;
+    }
+
+    //set properties
+    celix_properties_t *props = celix_bundleContext_createServiceProperties(opts);
 
     long svcId = -1;
     if (!async && celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
@@ -423,6 +444,66 @@ long celix_bundleContext_registerServiceWithOptionsAsync(celix_bundle_context_t
     return celix_bundleContext_registerServiceWithOptionsInternal(ctx, opts, true);
 }
 
+typedef struct celix_bundle_context_register_batch_data {
+    celix_bundle_context_t* ctx;
+    celix_service_registry_batch_entry_t* entries;
+    size_t nrOfEntries;
+} celix_bundle_context_register_batch_data_t;
+
+static void celix_bundleContext_registerServicesBatchOnEventLoop(void* data) {
+    celix_bundle_context_register_batch_data_t* batch = data;
+    celix_framework_registerServices(batch->ctx->framework, batch->ctx->bundle, batch->entries, batch->nrOfEntries);
+}
+
+size_t celix_bundleContext_registerServicesBatch(celix_bundle_context_t *ctx, const celix_service_registration_options_t *opts, size_t nrOfServices, long *serviceIds) {
+    celix_bundle_context_register_batch_data_t batch = {ctx, NULL, 0};
+    batch.entries = calloc(nrOfServices, sizeof(*batch.entries));
+    size_t* optsIndices = calloc(nrOfServices, sizeof(*optsIndices));
+    for (size_t i = 0; i < nrOfServices; ++i) {
+        if (serviceIds != NULL) {
+            serviceIds[i] = -1;
+        }
+        if (celix_bundleContext_checkServiceRegistrationOptions(ctx, &opts[i])) {
+            celix_service_registry_batch_entry_t* entry = &batch.entries[batch.nrOfEntries];
+            entry->serviceName = opts[i].serviceName;
+            entry->service = opts[i].svc;
+            entry->factory = opts[i].factory;
+            entry->properties = celix_bundleContext_createServiceProperties(&opts[i]);
+            optsIndices[batch.nrOfEntries] = i;
+            batch.nrOfEntries += 1;
+        }
+    }
+
+    if (batch.nrOfEntries > 0) {
+        if (celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
+            celix_bundleContext_registerServicesBatchOnEventLoop(&batch);
+        } else {
+            //note registering on the event loop, so that the batch is ordered with the (async) registrations already queued
+            long eventId = celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "register services batch", &batch, celix_bundleContext_registerServicesBatchOnEventLoop, NULL, NULL);
+            celix_framework_waitForGenericEvent(ctx->framework, eventId);
+        }
+    }
+
+    size_t registered = 0;
+    celixThreadMutex_lock(&ctx->mutex);
+    for (size_t i = 0; i < batch.nrOfEntries; ++i) {
+        if (batch.entries[i].registration != NULL) {
+            long svcId = serviceRegistration_getServiceId(batch.entries[i].registration);
+            celix_arrayList_addLong(ctx->svcRegistrations, svcId);
+            if (serviceIds != NULL) {
+                serviceIds[optsIndices[i]] = svcId;
+            }
+            registered += 1;
+        } else {
+            celix_properties_destroy(batch.entries[i].properties);
+        }
+    }
+    celixThreadMutex_unlock(&ctx->mutex);
+    free(optsIndices);
+    free(batch.entries);
+    return registered;
+}
+
 void celix_bundleContext_waitForAsyncRegistration(celix_bundle_context_t* ctx, long serviceId) {
     if (serviceId >= 0) {
         celix_framework_waitForAsyncRegistration(ctx->framework, serviceId);
@@ -484,6 +565,56 @@ void celix_bundleContext_unregisterService(bundle_context_t *ctx, long serviceId
     return celix_bundleContext_unregisterServiceInternal(ctx, serviceId, false, NULL, NULL);
 }
 
+typedef struct celix_bundle_context_unregister_batch_data {
+    celix_bundle_context_t* ctx;
+    long* serviceIds;
+    size_t nrOfServiceIds;
+} celix_bundle_context_unregister_batch_data_t;
+
+static void celix_bundleContext_unregisterServicesBatchOnEventLoop(void* data) {
+    celix_bundle_context_unregister_batch_data_t* batch = data;
+    celix_framework_unregisterServices(batch->ctx->framework, batch->ctx->bundle, batch->serviceIds, batch->nrOfServiceIds);
+}
+
+void celix_bundleContext_unregisterServicesBatch(celix_bundle_context_t *ctx, const long *serviceIds, size_t nrOfServices) {
+    celix_bundle_context_unregister_batch_data_t batch = {ctx, NULL, 0};
+    batch.serviceIds = malloc(nrOfServices * sizeof(*batch.serviceIds));
+    celixThreadMutex_lock(&ctx->mutex);
+    for (size_t i = 0; i < nrOfServices; ++i) {
+        long serviceId = serviceIds[i];
+        if (serviceId < 0) {
+            continue;
+        }
+        bool found = false;
+        int size = celix_arrayList_size(ctx->svcRegistrations);
+        for (int j = 0; j < size; ++j) {
+            if (celix_arrayList_getLong(ctx->svcRegistrations, j) == serviceId) {
+                celix_arrayList_removeAt(ctx->svcRegistrations, j);
+                found = true;
+                break;
+            }
+        }
+        if (found) {
+            batch.serviceIds[batch.nrOfServiceIds++] = serviceId;
+        } else {
+            framework_logIfError(ctx->framework->logger, CELIX_ILLEGAL_ARGUMENT, NULL,
+                                 "No service registered with svc id %li for bundle %s (bundle id: %li)!", serviceId,
+                                 celix_bundle_getSymbolicName(ctx->bundle), celix_bundle_getId(ctx->bundle));
+        }
+    }
+    celixThreadMutex_unlock(&ctx->mutex);
+
+    if (batch.nrOfServiceIds > 0) {
+        if (celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
+            celix_bundleContext_unregisterServicesBatchOnEventLoop(&batch);
+        } else {
+            long eventId = celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "unregister services batch", &batch, celix_bundleContext_unregisterServicesBatchOnEventLoop, NULL, NULL);
+            celix_framework_waitForGenericEvent(ctx->framework, eventId);
+        }
+    }
+    free(batch.serviceIds);
+}
+
 void celix_bundleContext_waitForAsyncUnregistration(celix_bundle_context_t* ctx, long serviceId) {
     if (serviceId >= 0) {
         celix_framework_waitForAsyncUnregistration(ctx->framework, serviceId);
@@ -704,6 +835,41 @@ static void bundleContext_cleanupServiceTrackers(bundle_context_t *ctx) {
     }
 }
 
+static void celix_bundleContext_destroyUseServiceTracker(celix_bundle_context_t* ctx, celix_service_tracker_t* tracker) {
+    if (celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
+        celix_serviceTracker_destroy(tracker);
+    } else {
+        long eventId = celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "close cached service tracker for use service", tracker, (void *)celix_serviceTracker_destroy, NULL, NULL);
+        celix_framework_waitForGenericEvent(ctx->framework, eventId);
+    }
+}
+
+static void bundleContext_cleanupUseServiceCache(bundle_context_t* ctx) {
+    //note cached use service trackers are owned by the bundle context, so no dangling warning is needed.
+    celix_array_list_t* entries = celix_arrayList_create();
+    celixThreadRwlock_writeLock(&ctx->useServiceCacheLock);
+    CELIX_STRING_HASH_MAP_ITERATE(ctx->useServiceCache, iter) {
+        celix_bundle_context_use_service_cache_entry_t* entry = iter.value.ptrValue;
+        __atomic_store_n(&entry->removed, true, __ATOMIC_SEQ_CST);
+        celix_arrayList_add(entries, entry);
+    }
+    celix_stringHashMap_clear(ctx->useServiceCache);
+    celixThreadRwlock_unlock(&ctx->useServiceCacheLock);
+
+    for (int i = 0; i < celix_arrayList_size(entries); ++i) {
+        celix_bundle_context_use_service_cache_entry_t* entry = celix_arrayList_get(entries, i);
+        //wait until concurrent cached use service calls are done with the tracker
+        celixThreadMutex_lock(&ctx->mutex);
+        while (__atomic_load_n(&entry->useCount, __ATOMIC_SEQ_CST) > 0) {
+            celixThreadCondition_timedwaitRelative(&ctx->useServiceCacheCond, &ctx->mutex, 1, 0);
+        }
+        celixThreadMutex_unlock(&ctx->mutex);
+        celix_bundleContext_destroyUseServiceTracker(ctx, entry->tracker);
+        free(entry);
+    }
+    celix_arrayList_destroy(entries);
+}
+
 static void bundleContext_cleanupServiceTrackerTrackers(bundle_context_t *ctx) {
     module_pt module;
     const char *symbolicName;
@@ -1060,6 +1226,96 @@ static void celix_bundleContext_useServiceWithOptions_2_UseServiceTracker(void *
     d->called = celix_serviceTracker_useHighestRankingService(d->svcTracker, d->opts->filter.serviceName, 0, d->opts->callbackHandle, d->opts->use, d->opts->useWithProperties, d->opts->useWithOwner);
 }
 
+/**
+ * @brief Returns the in use cached use service tracker entry for the filter options of the provided use service
+ * options. Creates and caches the service tracker if not already present.
+ *
+ * The cache key is created in a stack buffer (only allocated for very long filters) and looked up under a read lock,
+ * so that cached use service calls of different threads do not serialize. The use count of the returned entry is
+ * increased, so that the tracker is not destroyed while in use; release it with
+ * celix_bundleContext_releaseCachedUseServiceTracker.
+ * @return The cached use service tracker entry or NULL if the use service cache is full or the service tracker cannot
+ * be created.
+ */
+static celix_bundle_context_use_service_cache_entry_t* celix_bundleContext_getCachedUseServiceTracker(celix_bundle_context_t* ctx, const celix_service_use_options_t* opts) {
+    //note the service name and version range are length prefixed, so that different filter options cannot result
+    //in the same key.
+    const char* versionRange = opts->filter.versionRange == NULL ? "" : opts->filter.versionRange;
+    char keyBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    char* key = celix_utils_writeOrCreateString(keyBuffer, sizeof(keyBuffer), "%zu;%s;%zu;%s;%s",
+                                                strlen(opts->filter.serviceName),
+                                                opts->filter.serviceName,
+                                                strlen(versionRange),
+                                                versionRange,
+                                                opts->filter.filter == NULL ? "" : opts->filter.filter);
+    if (key == NULL) {
+        fw_log(ctx->framework->logger, CELIX_LOG_LEVEL_ERROR, "Cannot create use service cache key");
+        return NULL;
+    }
+
+    celixThreadRwlock_readLock(&ctx->useServiceCacheLock);
+    celix_bundle_context_use_service_cache_entry_t* entry = celix_stringHashMap_get(ctx->useServiceCache, key);
+    if (entry != NULL) {
+        __atomic_add_fetch(&entry->useCount, 1, __ATOMIC_SEQ_CST);
+    }
+    bool full = celix_stringHashMap_size(ctx->useServiceCache) >= CELIX_BUNDLE_CONTEXT_MAX_USE_SERVICE_CACHE_SIZE;
+    celixThreadRwlock_unlock(&ctx->useServiceCacheLock);
+
+    if (entry == NULL && !full) {
+        celix_bundle_context_use_service_data_t data = {0};
+        data.ctx = ctx;
+        data.opts = opts;
+        if (celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
+            celix_bundleContext_useServiceWithOptions_1_CreateServiceTracker(&data);
+        } else {
+            long eventId = celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "create cached service tracker for use service", &data, celix_bundleContext_useServiceWithOptions_1_CreateServiceTracker, NULL, NULL);
+            celix_framework_waitForGenericEvent(ctx->framework, eventId);
+        }
+
+        celix_service_tracker_t* unused = data.svcTracker;
+        celixThreadRwlock_writeLock(&ctx->useServiceCacheLock);
+        entry = celix_stringHashMap_get(ctx->useServiceCache, key);
+        if (entry == NULL && data.svcTracker != NULL &&
+            celix_stringHashMap_size(ctx->useServiceCache) < CELIX_BUNDLE_CONTEXT_MAX_USE_SERVICE_CACHE_SIZE) {
+            entry = calloc(1, sizeof(*entry));
+            entry->tracker = data.svcTracker;
+            celix_stringHashMap_put(ctx->useServiceCache, key, entry);
+            unused = NULL;
+        }
+        //note if entry is still NULL, the cache is concurrently filled or the service tracker cannot be created
+        if (entry != NULL) {
+            __atomic_add_fetch(&entry->useCount, 1, __ATOMIC_SEQ_CST);
+        }
+        celixThreadRwlock_unlock(&ctx->useServiceCacheLock);
+
+        if (unused != NULL) {
+            //concurrently created by another use service call or the cache is full
+            celix_bundleContext_destroyUseServiceTracker(ctx, unused);
+        }
+    }
+
+    if (entry == NULL && full) {
+        fw_log(ctx->framework->logger, CELIX_LOG_LEVEL_DEBUG,
+               "Use service cache is full (max %i cached service trackers), using a temporary service tracker for service '%s'",
+               CELIX_BUNDLE_CONTEXT_MAX_USE_SERVICE_CACHE_SIZE, opts->filter.serviceName);
+    }
+
+    celix_utils_freeStringIfNotEqual(keyBuffer, key);
+    return entry;
+}
+
+/**
+ * @brief Releases a cached use service tracker entry returned by celix_bundleContext_getCachedUseServiceTracker.
+ */
+static void celix_bundleContext_releaseCachedUseServiceTracker(celix_bundle_context_t* ctx, celix_bundle_context_use_service_cache_entry_t* entry) {
+    size_t useCount = __atomic_sub_fetch(&entry->useCount, 1, __ATOMIC_SEQ_CST);
+    if (useCount == 0 && __atomic_load_n(&entry->removed, __ATOMIC_SEQ_CST)) {
+        celixThreadMutex_lock(&ctx->mutex);
+        celixThreadCondition_broadcast(&ctx->useServiceCacheCond);
+        celixThreadMutex_unlock(&ctx->mutex);
+    }
+}
+
 bool celix_bundleContext_useServiceWithOptions(
         celix_bundle_context_t *ctx,
         const celix_service_use_options_t *opts) {
@@ -1067,6 +1323,22 @@ bool celix_bundleContext_useServiceWithOptions(
         return false;
     }
 
+    celix_bundle_context_use_service_cache_entry_t* cacheEntry = NULL;
+    if (opts->flags & CELIX_SERVICE_USE_CACHED) {
+        cacheEntry = celix_bundleContext_getCachedUseServiceTracker(ctx, opts);
+    }
+    if (cacheEntry != NULL) {
+        bool onEventLoop = celix_framework_isCurrentThreadTheEventLoop(ctx->framework);
+        if (!onEventLoop && (opts->flags & CELIX_SERVICE_USE_SOD)) {
+            celix_framework_waitUntilNoPendingRegistration(ctx->framework);
+        }
+        // Ignore timeout on the event loop: blocking the event loop prevents any progress to be made
+        double timeout = onEventLoop ? 0 : opts->waitTimeoutInSeconds;
+        bool called = celix_serviceTracker_useHighestRankingService(cacheEntry->tracker, NULL, timeout, opts->callbackHandle, opts->use, opts->useWithProperties, opts->useWithOwner);
+        celix_bundleContext_releaseCachedUseServiceTracker(ctx, cacheEntry);
+        return called;
+    }
+
     celix_bundle_context_use_service_data_t data = {0};
     data.ctx = ctx;
     data.opts = opts;
@@ -1084,7 +1356,8 @@ bool celix_bundleContext_useServiceWithOptions(
     celix_framework_waitForGenericEvent(ctx->framework, eventId);
 
 
-    if(opts->flags & CELIX_SERVICE_USE_DIRECT) {
+    //note a cached use service call for which no cached service tracker is available (cache full) is handled directly
+    if(opts->flags & (CELIX_SERVICE_USE_DIRECT | CELIX_SERVICE_USE_CACHED)) {
         if(opts->flags & CELIX_SERVICE_USE_SOD) {
             // check CelixBundleContextServicesTestSuite.UseServiceOnDemandDirectlyWithAsyncRegisterTest to see what is "service on demand".
             celix_framework_waitUntilNoPendingRegistration(ctx->framework);
@@ -1127,6 +1400,19 @@ size_t celix_bundleContext_useServicesWithOptions(
         return 0;
     }
 
+    celix_bundle_context_use_service_cache_entry_t* cacheEntry = NULL;
+    if (opts->flags & CELIX_SERVICE_USE_CACHED) {
+        cacheEntry = celix_bundleContext_getCachedUseServiceTracker(ctx, opts);
+    }
+    if (cacheEntry != NULL) {
+        if (!celix_framework_isCurrentThreadTheEventLoop(ctx->framework) && (opts->flags & CELIX_SERVICE_USE_SOD)) {
+            celix_framework_waitUntilNoPendingRegistration(ctx->framework);
+        }
+        size_t count = celix_serviceTracker_useServices(cacheEntry->tracker, NULL, opts->callbackHandle, opts->use, opts->useWithProperties, opts->useWithOwner);
+        celix_bundleContext_releaseCachedUseServiceTracker(ctx, cacheEntry);
+        return count;
+    }
+
     celix_bundle_context_use_service_data_t data = {0};
     data.ctx = ctx;
     data.opts = opts;
@@ -1141,7 +1427,8 @@ size_t celix_bundleContext_useServicesWithOptions(
     long eventId = celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "create service tracker for celix_bundleContext_useServicesWithOptions", &data, celix_bundleContext_useServiceWithOptions_1_CreateServiceTracker, NULL, NULL);
     celix_framework_waitForGenericEvent(ctx->framework, eventId);
 
-    if (opts->flags & CELIX_SERVICE_USE_DIRECT) {
+    //note a cached use services call for which no cached service tracker is available (cache full) is handled directly
+    if (opts->flags & (CELIX_SERVICE_USE_DIRECT | CELIX_SERVICE_USE_CACHED)) {
         if(opts->flags & CELIX_SERVICE_USE_SOD) {
             // check CelixBundleContextServicesTestSuite.UseServicesOnDemandDirectlyWithAsyncRegisterTest to see what is "service on demand".
             celix_framework_waitUntilNoPendingRegistration(ctx->framework);
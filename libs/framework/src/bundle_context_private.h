@@ -26,6 +26,11 @@
 #include "celix_bundle_context.h"
 #include "listener_hook_service.h"
 #include "service_tracker.h"
+#include "celix_string_hash_map.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 typedef struct celix_bundle_context_bundle_tracker_entry {
 	celix_bundle_context_t *ctx;
@@ -70,6 +75,23 @@ typedef struct celix_bundle_context_service_tracker_tracker_entry {
     long createEventId;
 } celix_bundle_context_service_tracker_tracker_entry_t;
 
+/**
+ * @brief The max number of cached use service trackers per bundle context.
+ *
+ * Every distinct combination of use service filter options results in a cached service tracker. If the cache is full,
+ * use service calls with the CELIX_SERVICE_USE_CACHED flag for new filter options fall back to a temporary service
+ * tracker.
+ */
+#ifndef CELIX_BUNDLE_CONTEXT_MAX_USE_SERVICE_CACHE_SIZE
+#define CELIX_BUNDLE_CONTEXT_MAX_USE_SERVICE_CACHE_SIZE 64
+#endif
+
+typedef struct celix_bundle_context_use_service_cache_entry {
+    celix_service_tracker_t* tracker;
+    size_t useCount; //atomic, number of use service calls using the tracker. Only increased under the useServiceCacheLock
+    bool removed; //atomic, true if the entry is removed from the cache and waiting to be destroyed
+} celix_bundle_context_use_service_cache_entry_t;
+
 struct celix_bundle_context {
 	celix_framework_t *framework;
 	celix_bundle_t *bundle;
@@ -82,10 +104,17 @@ struct celix_bundle_context {
 	hash_map_t *serviceTrackers; //key = trackerId, value = celix_bundle_context_service_tracker_entry_t*
 	hash_map_t *metaTrackers; //key = trackerId, value = celix_bundle_context_service_tracker_tracker_entry_t*
     hash_map_t *stoppingTrackerEventIds; //key = trackerId, value = eventId for stopping the tracker. Note id are only present if the stop tracking is queued.
+
+    celix_thread_rwlock_t useServiceCacheLock; //protects useServiceCache. Cached use service calls only need a read lock.
+    celix_string_hash_map_t *useServiceCache; //key = use service cache key (service name, version range and filter), value = celix_bundle_context_use_service_cache_entry_t*
+    celix_thread_cond_t useServiceCacheCond; //used with mutex to wait until removed cached use service trackers are no longer in use
 };
 
 
 void celix_bundleContext_cleanup(celix_bundle_context_t *ctx);
 
+#ifdef __cplusplus
+}
+#endif
 
 #endif /* BUNDLE_CONTEXT_PRIVATE_H_ */
@@ -22,8 +22,18 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
 
 #include "celix_constants.h"
 #include "celix_log.h"
@@ -34,13 +44,19 @@
 #include "framework_private.h"
 #include "bundle_archive_private.h"
 #include "celix_string_hash_map.h"
+#include "celix_sha256.h"
+#include "celix_array_list.h"
 #include "celix_build_assert.h"
+#include "celix_framework_utils_private.h"
 
 //for Celix 3.0 update to a different bundle root scheme
 //#define CELIX_BUNDLE_ARCHIVE_ROOT_FORMAT "%s/bundle_%li"
 
 #define CELIX_BUNDLE_ARCHIVE_ROOT_FORMAT "%s/bundle%li"
 
+#define CELIX_BUNDLE_CACHE_STORE_DIR_NAME "bundle_store"
+#define CELIX_BUNDLE_CACHE_STORE_INDEX_FILE_NAME "index"
+
 #define FW_LOG(level, ...) \
     celix_framework_log(cache->fw->logger, (level), __FUNCTION__ , __FILE__, __LINE__, __VA_ARGS__)
 
@@ -49,9 +65,19 @@ struct celix_bundle_cache {
     char* cacheDir;
     bool deleteOnDestroy;
     bool deleteOnCreate;
+    bool useBundleStore;
+    char* bundleStoreDir; //<cacheDir>/bundle_store, NULL if the bundle store is not used
 
-    celix_thread_mutex_t mutex; //protects below and access to the cache dir
+    celix_thread_rwlock_t dirLock; //protects access to the cache dir. Archives are created/deleted under a read lock, so
+                                   //that bundles can be extracted in parallel. Scanning/deleting the cache dir needs a write lock
+    celix_thread_rwlock_t storeLock; //protects the bundle store entries. Entries are added and linked under a read lock,
+                                     //garbage collecting bundle store entries needs a write lock
+    celix_thread_mutex_t mutex; //protects below
     celix_string_hash_map_t* locationToBundleIdLookupMap; //key = location, value = bundle id.
+    celix_string_hash_map_t* bundleStoreIndex; //key = SHA-256 of the bundle zip path,
+                                               //value = "<size> <mtime sec> <mtime nsec> <content hash>".
+                                               //Lazy loaded from the bundle store index file.
+    size_t bundleStoreIndexNrOfLines; //nr of lines in the bundle store index file, including overridden lines
 };
 
 static const char* bundleCache_progamName() {
@@ -112,6 +138,13 @@ static bool celix_bundleCache_cleanOnCreate(celix_framework_t* fw) {
     return cleanOnCreate;
 }
 
+static bool celix_bundleCache_useBundleStore(celix_framework_t* fw) {
+    return celix_framework_getConfigPropertyAsBool(fw,
+                                                   CELIX_FRAMEWORK_CACHE_USE_BUNDLE_STORE,
+                                                   CELIX_FRAMEWORK_CACHE_USE_BUNDLE_STORE_DEFAULT,
+                                                   NULL);
+}
+
 celix_status_t celix_bundleCache_create(celix_framework_t* fw, celix_bundle_cache_t** out) {
     celix_status_t status = CELIX_SUCCESS;
 
@@ -125,12 +158,15 @@ celix_status_t celix_bundleCache_create(celix_framework_t* fw, celix_bundle_cach
     bool useTmpDir = celix_bundleCache_useTmpDir(fw);
     cache->deleteOnCreate = celix_bundleCache_cleanOnCreate(fw);
     cache->deleteOnDestroy = useTmpDir; //if tmp dir is used, delete on destroy
+    cache->useBundleStore = celix_bundleCache_useBundleStore(fw);
     cache->locationToBundleIdLookupMap = celix_stringHashMap_create();
     if (NULL == cache->locationToBundleIdLookupMap) {
         status = CELIX_ENOMEM;
         goto cache_map_failure;
     }
     celixThreadMutex_create(&cache->mutex, NULL);
+    celixThreadRwlock_create(&cache->dirLock, NULL);
+    celixThreadRwlock_create(&cache->storeLock, NULL);
 
     if (useTmpDir) {
         //Using /tmp dir for cache, so that multiple frameworks can be launched
@@ -148,6 +184,11 @@ celix_status_t celix_bundleCache_create(celix_framework_t* fw, celix_bundle_cach
         status = CELIX_ENOMEM;
         goto cache_dir_failure;
     }
+    if (cache->useBundleStore &&
+        asprintf(&cache->bundleStoreDir, "%s/%s", cache->cacheDir, CELIX_BUNDLE_CACHE_STORE_DIR_NAME) < 0) {
+        status = CELIX_ENOMEM;
+        goto store_dir_failure;
+    }
 
     if (cache->deleteOnCreate) {
         CELIX_GOTO_IF_ERR(status = celix_bundleCache_deleteCacheDir(cache), manipulate_dir_failure);
@@ -162,8 +203,12 @@ celix_status_t celix_bundleCache_create(celix_framework_t* fw, celix_bundle_cach
     *out = cache;
     return CELIX_SUCCESS;
     manipulate_dir_failure:
+    free(cache->bundleStoreDir);
+    store_dir_failure:
     free(cache->cacheDir);
     cache_dir_failure:
+    celixThreadRwlock_destroy(&cache->storeLock);
+    celixThreadRwlock_destroy(&cache->dirLock);
     celixThreadMutex_destroy(&cache->mutex);
     celix_stringHashMap_destroy(cache->locationToBundleIdLookupMap);
     cache_map_failure:
@@ -176,22 +221,72 @@ celix_status_t celix_bundleCache_destroy(celix_bundle_cache_t* cache) {
     celix_status_t status = CELIX_SUCCESS;
     if (cache->deleteOnDestroy) {
         status = celix_bundleCache_deleteCacheDir(cache);
+        if (status == CELIX_SUCCESS && cache->useBundleStore) {
+            //note the cache dir is a tmp dir, so the bundle store is also deleted
+            status = celix_utils_deleteDirectory(cache->cacheDir, NULL);
+        }
     }
     free(cache->cacheDir);
+    free(cache->bundleStoreDir);
+    celix_stringHashMap_destroy(cache->bundleStoreIndex);
     celix_stringHashMap_destroy(cache->locationToBundleIdLookupMap);
+    celixThreadRwlock_destroy(&cache->storeLock);
+    celixThreadRwlock_destroy(&cache->dirLock);
     celixThreadMutex_destroy(&cache->mutex);
     free(cache);
     return status;
 }
 
+/**
+ * Deletes the content of the cache dir, except the bundle store.
+ */
+static celix_status_t celix_bundleCache_deleteCacheDirExceptBundleStore(celix_bundle_cache_t* cache, const char** err) {
+    DIR* dir = opendir(cache->cacheDir);
+    if (dir == NULL) {
+        if (errno == ENOENT) {
+            return CELIX_SUCCESS;
+        }
+        *err = strerror(errno);
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+    celix_status_t status = CELIX_SUCCESS;
+    char pathBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    struct dirent* dent = NULL;
+    while (status == CELIX_SUCCESS && (dent = readdir(dir)) != NULL) {
+        if (strcmp(dent->d_name, ".") == 0 || strcmp(dent->d_name, "..") == 0 ||
+            strcmp(dent->d_name, CELIX_BUNDLE_CACHE_STORE_DIR_NAME) == 0) {
+            continue;
+        }
+        char* path = celix_utils_writeOrCreateString(pathBuffer, sizeof(pathBuffer), "%s/%s", cache->cacheDir, dent->d_name);
+        if (path == NULL) {
+            status = CELIX_ENOMEM;
+        } else if (celix_utils_directoryExists(path)) {
+            status = celix_utils_deleteDirectory(path, err);
+        } else if (remove(path) != 0) {
+            *err = strerror(errno);
+            status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        }
+        celix_utils_freeStringIfNotEqual(pathBuffer, path);
+    }
+    closedir(dir);
+    return status;
+}
+
 celix_status_t celix_bundleCache_deleteCacheDir(celix_bundle_cache_t* cache) {
     const char* err = NULL;
+    celix_status_t status;
+    celixThreadRwlock_writeLock(&cache->dirLock);
     celixThreadMutex_lock(&cache->mutex);
-    celix_status_t status = celix_utils_deleteDirectory(cache->cacheDir, &err);
+    if (cache->useBundleStore) {
+        status = celix_bundleCache_deleteCacheDirExceptBundleStore(cache, &err);
+    } else {
+        status = celix_utils_deleteDirectory(cache->cacheDir, &err);
+    }
     if (status == CELIX_SUCCESS) {
         celix_stringHashMap_clear(cache->locationToBundleIdLookupMap);
     }
     celixThreadMutex_unlock(&cache->mutex);
+    celixThreadRwlock_unlock(&cache->dirLock);
     if (status != CELIX_SUCCESS) {
         fw_logCode(cache->fw->logger, CELIX_LOG_LEVEL_ERROR, status, "Cannot delete bundle cache directory %s: %s",
                    cache->cacheDir, err);
@@ -208,12 +303,14 @@ celix_bundleCache_createArchive(celix_bundle_cache_t* cache, long id, const char
     char* archiveRoot = celix_utils_writeOrCreateString(archiveRootBuffer, sizeof(archiveRootBuffer),
                                                         CELIX_BUNDLE_ARCHIVE_ROOT_FORMAT, cache->cacheDir, id);
     if (archiveRoot) {
-        celixThreadMutex_lock(&cache->mutex);
+        celixThreadRwlock_readLock(&cache->dirLock);
         status = celix_bundleArchive_create(cache->fw, archiveRoot, id, location, &archive);
+        celixThreadRwlock_unlock(&cache->dirLock);
         if (status == CELIX_SUCCESS) {
+            celixThreadMutex_lock(&cache->mutex);
             celix_stringHashMap_put(cache->locationToBundleIdLookupMap, location, (void*) id);
+            celixThreadMutex_unlock(&cache->mutex);
         }
-        celixThreadMutex_unlock(&cache->mutex);
         celix_utils_freeStringIfNotEqual(archiveRootBuffer, archiveRoot);
     } else {
         status = CELIX_ENOMEM;
@@ -236,9 +333,14 @@ celix_status_t celix_bundleCache_destroyArchive(celix_bundle_cache_t* cache, bun
     celixThreadMutex_lock(&cache->mutex);
     (void) bundleArchive_getLocation(archive, &loc);
     (void) celix_stringHashMap_remove(cache->locationToBundleIdLookupMap, loc);
-    status = bundleArchive_closeAndDelete(archive);
     celixThreadMutex_unlock(&cache->mutex);
+    celixThreadRwlock_readLock(&cache->dirLock);
+    status = bundleArchive_closeAndDelete(archive);
+    celixThreadRwlock_unlock(&cache->dirLock);
     (void) bundleArchive_destroy(archive);
+    if (status == CELIX_SUCCESS && cache->useBundleStore) {
+        celix_bundleCache_collectBundleStoreGarbage(cache);
+    }
     return status;
 }
 
@@ -246,12 +348,14 @@ celix_status_t celix_bundleCache_destroyArchive(celix_bundle_cache_t* cache, bun
  * Update location->bundle id lookup map.
  */
 static void celix_bundleCache_updateIdForLocationLookupMap(celix_bundle_cache_t* cache) {
+    celixThreadRwlock_writeLock(&cache->dirLock);
     celixThreadMutex_lock(&cache->mutex);
     DIR* dir = opendir(cache->cacheDir);
     if (dir == NULL) {
         fw_logCode(cache->fw->logger, CELIX_LOG_LEVEL_ERROR, CELIX_BUNDLE_EXCEPTION,
                    "Cannot open bundle cache directory %s", cache->cacheDir);
         celixThreadMutex_unlock(&cache->mutex);
+        celixThreadRwlock_unlock(&cache->dirLock);
         return;
     }
     char archiveRootBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
@@ -277,6 +381,7 @@ static void celix_bundleCache_updateIdForLocationLookupMap(celix_bundle_cache_t*
     }
     closedir(dir);
     celixThreadMutex_unlock(&cache->mutex);
+    celixThreadRwlock_unlock(&cache->dirLock);
 }
 
 long celix_bundleCache_findBundleIdForLocation(celix_bundle_cache_t* cache, const char* location) {
@@ -308,6 +413,591 @@ bool celix_bundleCache_isBundleIdAlreadyUsed(celix_bundle_cache_t* cache, long b
     return found;
 }
 
+bool celix_bundleCache_isBundleStoreEnabled(celix_bundle_cache_t* cache) {
+    return cache->useBundleStore;
+}
+
+/**
+ * Lazy loads the bundle store index.
+ *
+ * The bundle store index file is append-only. Every line is "<zip path hash> <size> <mtime sec> <mtime nsec>
+ * <content hash>" and a later line for a zip path hash overrides the earlier lines. Incomplete lines (e.g. a
+ * partially written line after a crash) are ignored.
+ * precondition: cache->mutex is locked.
+ */
+static celix_string_hash_map_t* celix_bundleCache_getBundleStoreIndex(celix_bundle_cache_t* cache) {
+    if (cache->bundleStoreIndex != NULL) {
+        return cache->bundleStoreIndex;
+    }
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.simpleRemovedCallback = free;
+    cache->bundleStoreIndex = celix_stringHashMap_createWithOptions(&opts);
+    cache->bundleStoreIndexNrOfLines = 0;
+    char pathBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    char* path = celix_utils_writeOrCreateString(pathBuffer, sizeof(pathBuffer), "%s/%s", cache->bundleStoreDir,
+                                                 CELIX_BUNDLE_CACHE_STORE_INDEX_FILE_NAME);
+    FILE* file = path != NULL && cache->bundleStoreIndex != NULL ? fopen(path, "r") : NULL;
+    if (file != NULL) {
+        char* line = NULL;
+        size_t lineSize = 0;
+        while (getline(&line, &lineSize, file) >= 0) {
+            cache->bundleStoreIndexNrOfLines += 1;
+            char pathHash[CELIX_SHA256_HEX_STRING_SIZE];
+            char contentHash[CELIX_SHA256_HEX_STRING_SIZE];
+            long long size;
+            long long sec;
+            long nsec;
+            int len = 0;
+            if (sscanf(line, "%64s %lld %lld %ld %64s%n", pathHash, &size, &sec, &nsec, contentHash, &len) != 5 ||
+                line[len] != '\n' || strlen(contentHash) != CELIX_SHA256_HEX_STRING_SIZE - 1) {
+                continue;
+            }
+            char* value = NULL;
+            if (asprintf(&value, "%lld %lld %ld %s", size, sec, nsec, contentHash) >= 0) {
+                free(celix_stringHashMap_put(cache->bundleStoreIndex, pathHash, value));
+            }
+        }
+        free(line);
+        fclose(file);
+    }
+    celix_utils_freeStringIfNotEqual(pathBuffer, path);
+    return cache->bundleStoreIndex;
+}
+
+/**
+ * Adds an entry to the bundle store index and appends it as line to the bundle store index file.
+ * The line is written with a single write on a O_APPEND file descriptor, so the existing lines are never rewritten.
+ * precondition: cache->mutex is locked.
+ */
+static void celix_bundleCache_addBundleStoreIndexEntry(celix_bundle_cache_t* cache, const char* pathHash, char* value) {
+    celix_string_hash_map_t* index = celix_bundleCache_getBundleStoreIndex(cache);
+    if (index == NULL) {
+        free(value);
+        return;
+    }
+    free(celix_stringHashMap_put(index, pathHash, value));
+
+    char pathBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    char lineBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    char* path = celix_utils_writeOrCreateString(pathBuffer, sizeof(pathBuffer), "%s/%s", cache->bundleStoreDir,
+                                                 CELIX_BUNDLE_CACHE_STORE_INDEX_FILE_NAME);
+    char* line = celix_utils_writeOrCreateString(lineBuffer, sizeof(lineBuffer), "%s %s\n", pathHash, value);
+    if (path != NULL && line != NULL) {
+        size_t len = strlen(line);
+        int fd = open(path, O_WRONLY | O_APPEND | O_CREAT, 0644);
+        if (fd < 0 || write(fd, line, len) != (ssize_t)len) {
+            fw_log(cache->fw->logger, CELIX_LOG_LEVEL_WARNING, "Cannot append to bundle store index %s: %s", path,
+                   strerror(errno));
+        } else {
+            cache->bundleStoreIndexNrOfLines += 1;
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    celix_utils_freeStringIfNotEqual(lineBuffer, line);
+    celix_utils_freeStringIfNotEqual(pathBuffer, path);
+}
+
+/**
+ * Compacts the bundle store index file to a single line per index entry, if the index file contains overridden or
+ * removed lines. The index file is rewritten to a tmp file and atomically renamed.
+ * precondition: cache->mutex is locked.
+ */
+static void celix_bundleCache_compactBundleStoreIndex(celix_bundle_cache_t* cache) {
+    celix_string_hash_map_t* index = celix_bundleCache_getBundleStoreIndex(cache);
+    if (index == NULL || cache->bundleStoreIndexNrOfLines == celix_stringHashMap_size(index)) {
+        return;
+    }
+    char* path = NULL;
+    char* tmpPath = NULL;
+    if (asprintf(&path, "%s/%s", cache->bundleStoreDir, CELIX_BUNDLE_CACHE_STORE_INDEX_FILE_NAME) < 0 ||
+        asprintf(&tmpPath, "%s.tmp", path) < 0) {
+        free(path);
+        return;
+    }
+    FILE* file = fopen(tmpPath, "w");
+    bool written = file != NULL;
+    if (file != NULL) {
+        CELIX_STRING_HASH_MAP_ITERATE(index, iter) {
+            written = written && fprintf(file, "%s %s\n", iter.key, (const char*)iter.value.ptrValue) >= 0;
+        }
+        written = fclose(file) == 0 && written;
+    }
+    if (written && rename(tmpPath, path) == 0) {
+        cache->bundleStoreIndexNrOfLines = celix_stringHashMap_size(index);
+    } else {
+        fw_log(cache->fw->logger, CELIX_LOG_LEVEL_WARNING, "Cannot compact bundle store index %s: %s", path,
+               strerror(errno));
+        (void)unlink(tmpPath);
+    }
+    free(tmpPath);
+    free(path);
+}
+
+/**
+ * Returns the content hash of the bundle zip file. The content hash is the SHA-256 digest of the (mmapped) zip
+ * content, so that bundle zips with a different content cannot share a bundle store entry.
+ *
+ * If the path, size and last modified time of the bundle zip file matches an entry in the bundle store index, the
+ * content hash of the index entry is used and the bundle zip file is not read.
+ */
+static celix_status_t celix_bundleCache_getContentHash(celix_bundle_cache_t* cache, const char* zipPath, char** hashOut) {
+    *hashOut = NULL;
+    int fd = open(zipPath, O_RDONLY);
+    if (fd < 0) {
+        celix_status_t status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        fw_logCode(cache->fw->logger, CELIX_LOG_LEVEL_ERROR, status, "Cannot open bundle zip %s", zipPath);
+        return status;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        celix_status_t status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        fw_logCode(cache->fw->logger, CELIX_LOG_LEVEL_ERROR, status, "Cannot stat bundle zip %s", zipPath);
+        close(fd);
+        return status;
+    }
+#ifdef __APPLE__
+    struct timespec mtime = st.st_mtimespec;
+#else
+    struct timespec mtime = st.st_mtim;
+#endif
+
+    char pathHash[CELIX_SHA256_HEX_STRING_SIZE];
+    celix_sha256_hexDigest(zipPath, strlen(zipPath), pathHash);
+
+    celixThreadMutex_lock(&cache->mutex);
+    celix_string_hash_map_t* index = celix_bundleCache_getBundleStoreIndex(cache);
+    const char* entry = index != NULL ? celix_stringHashMap_get(index, pathHash) : NULL;
+    if (entry != NULL) {
+        long long size;
+        long long sec;
+        long nsec;
+        char hash[128];
+        if (sscanf(entry, "%lld %lld %ld %127s", &size, &sec, &nsec, hash) == 4 && size == (long long)st.st_size &&
+            sec == (long long)mtime.tv_sec && nsec == mtime.tv_nsec) {
+            *hashOut = celix_utils_strdup(hash);
+        }
+    }
+    celixThreadMutex_unlock(&cache->mutex);
+    if (*hashOut != NULL) {
+        close(fd);
+        return CELIX_SUCCESS;
+    }
+
+    char hash[CELIX_SHA256_HEX_STRING_SIZE];
+    if (st.st_size > 0) {
+        const unsigned char* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            celix_status_t status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+            fw_logCode(cache->fw->logger, CELIX_LOG_LEVEL_ERROR, status, "Cannot mmap bundle zip %s", zipPath);
+            close(fd);
+            return status;
+        }
+        celix_sha256_hexDigest(data, (size_t)st.st_size, hash);
+        munmap((void*)data, (size_t)st.st_size);
+    } else {
+        celix_sha256_hexDigest(NULL, 0, hash);
+    }
+    close(fd);
+    *hashOut = celix_utils_strdup(hash);
+    if (*hashOut == NULL) {
+        return CELIX_ENOMEM;
+    }
+
+    char* value = NULL;
+    if (asprintf(&value, "%lld %lld %ld %s", (long long)st.st_size, (long long)mtime.tv_sec, (long)mtime.tv_nsec,
+                 *hashOut) >= 0) {
+        celixThreadMutex_lock(&cache->mutex);
+        celix_bundleCache_addBundleStoreIndexEntry(cache, pathHash, value);
+        celixThreadMutex_unlock(&cache->mutex);
+    }
+    return CELIX_SUCCESS;
+}
+
+/**
+ * Removes the write permissions of the files in the directory tree of path.
+ * The directories are kept writable, so that an unused bundle store entry can still be deleted.
+ */
+static celix_status_t celix_bundleCache_makeFilesReadOnly(const char* path, const char** err) {
+    DIR* dir = opendir(path);
+    if (dir == NULL) {
+        *err = strerror(errno);
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+    celix_status_t status = CELIX_SUCCESS;
+    char pathBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    struct dirent* dent = NULL;
+    while (status == CELIX_SUCCESS && (dent = readdir(dir)) != NULL) {
+        if (strcmp(dent->d_name, ".") == 0 || strcmp(dent->d_name, "..") == 0) {
+            continue;
+        }
+        struct stat st;
+        char* entryPath = celix_utils_writeOrCreateString(pathBuffer, sizeof(pathBuffer), "%s/%s", path, dent->d_name);
+        if (entryPath == NULL) {
+            status = CELIX_ENOMEM;
+        } else if (lstat(entryPath, &st) != 0) {
+            *err = strerror(errno);
+            status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        } else if (S_ISDIR(st.st_mode)) {
+            status = celix_bundleCache_makeFilesReadOnly(entryPath, err);
+        } else if (S_ISREG(st.st_mode) && chmod(entryPath, st.st_mode & ~(mode_t)(S_IWUSR | S_IWGRP | S_IWOTH)) != 0) {
+            *err = strerror(errno);
+            status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        }
+        celix_utils_freeStringIfNotEqual(pathBuffer, entryPath);
+    }
+    closedir(dir);
+    return status;
+}
+
+/**
+ * Extracts the bundle zip file to the bundle store entry path, if not already present.
+ * The bundle zip is extracted to a tmp dir and atomically renamed, so that a bundle store entry is always complete.
+ * The files of a bundle store entry are read-only, because they are hardlinked in the bundle caches.
+ */
+static celix_status_t celix_bundleCache_addToBundleStore(celix_bundle_cache_t* cache, const char* zipPath,
+                                                         const char* entryPath, const char** err) {
+    if (celix_utils_directoryExists(entryPath)) {
+        fw_log(cache->fw->logger, CELIX_LOG_LEVEL_TRACE, "Bundle zip %s already in bundle store %s.", zipPath, entryPath);
+        return CELIX_SUCCESS;
+    }
+    char* tmpDir = NULL;
+    if (asprintf(&tmpDir, "%s/.tmp-XXXXXX", cache->bundleStoreDir) < 0) {
+        return CELIX_ENOMEM;
+    }
+    if (mkdtemp(tmpDir) == NULL) {
+        *err = strerror(errno);
+        celix_status_t status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        free(tmpDir);
+        return status;
+    }
+    celix_status_t status = celix_utils_extractZipFile(zipPath, tmpDir, err);
+    status = CELIX_DO_IF(status, celix_bundleCache_makeFilesReadOnly(tmpDir, err));
+    if (status == CELIX_SUCCESS && rename(tmpDir, entryPath) != 0) {
+        if (errno == EEXIST || errno == ENOTEMPTY) {
+            //note bundle zip with the same content concurrently added to the bundle store
+        } else {
+            *err = strerror(errno);
+            status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        }
+    }
+    (void)celix_utils_deleteDirectory(tmpDir, NULL);
+    free(tmpDir);
+    return status;
+}
+
+/**
+ * Copies src to dst, preserving the file mode of src. The copy is always writable for the owner, because the copy is
+ * not shared.
+ * If supported by the file system, the copy is a reflink (copy-on-write clone) of src.
+ */
+static celix_status_t celix_bundleCache_copyFile(const char* src, const char* dst, const char** err) {
+    int in = open(src, O_RDONLY);
+    if (in < 0) {
+        *err = strerror(errno);
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+    struct stat st;
+    if (fstat(in, &st) != 0) {
+        *err = strerror(errno);
+        celix_status_t status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        close(in);
+        return status;
+    }
+    int out = open(dst, O_WRONLY | O_CREAT | O_TRUNC, (st.st_mode | S_IWUSR) & 0777);
+    if (out < 0) {
+        *err = strerror(errno);
+        celix_status_t status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        close(in);
+        return status;
+    }
+    celix_status_t status = CELIX_SUCCESS;
+#ifdef FICLONE
+    bool cloned = ioctl(out, FICLONE, in) == 0;
+#else
+    bool cloned = false;
+#endif
+    char buf[4096];
+    ssize_t nrRead;
+    while (!cloned && status == CELIX_SUCCESS && (nrRead = read(in, buf, sizeof(buf))) != 0) {
+        if (nrRead < 0 || write(out, buf, (size_t)nrRead) != nrRead) {
+            *err = strerror(errno);
+            status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        }
+    }
+    if (close(out) != 0 && status == CELIX_SUCCESS) {
+        *err = strerror(errno);
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+    close(in);
+    return status;
+}
+
+/**
+ * Returns whether the file is a shared library, based on the file name (.so, .so.<version> or .dylib)
+ * or on the ELF/Mach-O magic of the file content.
+ */
+static bool celix_bundleCache_isSharedLibrary(const char* path, const char* name) {
+    size_t len = strlen(name);
+    if ((len > 3 && strcmp(name + len - 3, ".so") == 0) || strstr(name, ".so.") != NULL ||
+        (len > 6 && strcmp(name + len - 6, ".dylib") == 0)) {
+        return true;
+    }
+    unsigned char magic[4] = {0};
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    ssize_t nrRead = read(fd, magic, sizeof(magic));
+    close(fd);
+    if (nrRead != sizeof(magic)) {
+        return false;
+    }
+    bool isElf = magic[0] == 0x7f && magic[1] == 'E' && magic[2] == 'L' && magic[3] == 'F';
+    bool isMachO = (magic[0] == 0xfe && magic[1] == 0xed && magic[2] == 0xfa && (magic[3] == 0xce || magic[3] == 0xcf)) ||
+                   ((magic[0] == 0xce || magic[0] == 0xcf) && magic[1] == 0xfa && magic[2] == 0xed && magic[3] == 0xfe);
+    return isElf || isMachO;
+}
+
+/**
+ * Recreates the directory tree of src at dst with hardlinks to the files of src.
+ *
+ * Shared libraries are always copied (reflinked if supported), because the dynamic loader identifies a loaded
+ * library by its device and inode. Hardlinked libraries would make a dlopen of the same library from different
+ * bundle revisions return the same handle, breaking the per-bundle library isolation.
+ * The hardlinked files are read-only, so that a bundle cannot modify the shared bundle store entry.
+ * Falls back to copying a file if the file cannot be hardlinked (e.g. if src and dst are on a different file system).
+ */
+static celix_status_t celix_bundleCache_linkTree(const char* src, const char* dst, const char** err) {
+    celix_status_t status = celix_utils_createDirectory(dst, false, err);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    DIR* dir = opendir(src);
+    if (dir == NULL) {
+        *err = strerror(errno);
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+    char srcBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    char dstBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    struct dirent* dent = NULL;
+    while (status == CELIX_SUCCESS && (dent = readdir(dir)) != NULL) {
+        if (strcmp(dent->d_name, ".") == 0 || strcmp(dent->d_name, "..") == 0) {
+            continue;
+        }
+        char* srcPath = celix_utils_writeOrCreateString(srcBuffer, sizeof(srcBuffer), "%s/%s", src, dent->d_name);
+        char* dstPath = celix_utils_writeOrCreateString(dstBuffer, sizeof(dstBuffer), "%s/%s", dst, dent->d_name);
+        if (srcPath == NULL || dstPath == NULL) {
+            status = CELIX_ENOMEM;
+        } else if (celix_utils_directoryExists(srcPath)) {
+            status = celix_bundleCache_linkTree(srcPath, dstPath, err);
+        } else if (celix_bundleCache_isSharedLibrary(srcPath, dent->d_name) || link(srcPath, dstPath) != 0) {
+            status = celix_bundleCache_copyFile(srcPath, dstPath, err);
+        }
+        celix_utils_freeStringIfNotEqual(srcBuffer, srcPath);
+        celix_utils_freeStringIfNotEqual(dstBuffer, dstPath);
+    }
+    closedir(dir);
+    return status;
+}
+
+celix_status_t celix_bundleCache_populateRevisionFromStore(celix_bundle_cache_t* cache,
+                                                           const char* bundleUrl,
+                                                           const char* revisionDir,
+                                                           const char* currentContentHash,
+                                                           char** contentHashOut,
+                                                           bool* populatedOut) {
+    *contentHashOut = NULL;
+    *populatedOut = false;
+    if (!cache->useBundleStore) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    char* zipPath = celix_framework_utils_resolveBundleUrlFilePath(cache->fw, bundleUrl);
+    if (zipPath == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    const char* err = NULL;
+    char* hash = NULL;
+    char* entryPath = NULL;
+    char* manifestPath = NULL;
+    celix_status_t status = celix_utils_createDirectory(cache->bundleStoreDir, false, &err);
+    status = CELIX_DO_IF(status, celix_bundleCache_getContentHash(cache, zipPath, &hash));
+    if (status == CELIX_SUCCESS && asprintf(&entryPath, "%s/%s", cache->bundleStoreDir, hash) < 0) {
+        entryPath = NULL;
+        status = CELIX_ENOMEM;
+    }
+    if (status == CELIX_SUCCESS && asprintf(&manifestPath, "%s/%s", revisionDir, CELIX_BUNDLE_MANIFEST_REL_PATH) < 0) {
+        manifestPath = NULL;
+        status = CELIX_ENOMEM;
+    }
+    if (status != CELIX_SUCCESS) {
+        goto populate_done;
+    }
+
+    if (currentContentHash != NULL && strcmp(currentContentHash, hash) == 0 && celix_utils_fileExists(manifestPath)) {
+        fw_log(cache->fw->logger, CELIX_LOG_LEVEL_TRACE, "Bundle zip %s content is unchanged, no need to populate %s.",
+               zipPath, revisionDir);
+        goto populate_done;
+    }
+
+    celixThreadRwlock_readLock(&cache->storeLock);
+    status = celix_bundleCache_addToBundleStore(cache, zipPath, entryPath, &err);
+    //note always recreate the revision dir, to remove files not present in the new bundle zip
+    status = CELIX_DO_IF(status, celix_utils_deleteDirectory(revisionDir, &err));
+    status = CELIX_DO_IF(status, celix_bundleCache_linkTree(entryPath, revisionDir, &err));
+    celixThreadRwlock_unlock(&cache->storeLock);
+    if (status == CELIX_SUCCESS) {
+        fw_log(cache->fw->logger, CELIX_LOG_LEVEL_TRACE, "Populated %s from bundle store entry %s.", revisionDir,
+               entryPath);
+        *populatedOut = true;
+    }
+
+populate_done:
+    if (status == CELIX_SUCCESS) {
+        *contentHashOut = hash;
+    } else {
+        fw_logCode(cache->fw->logger, CELIX_LOG_LEVEL_ERROR, status, "Cannot populate %s from bundle store for %s: %s",
+                   revisionDir, zipPath, err != NULL ? err : "");
+        free(hash);
+    }
+    free(manifestPath);
+    free(entryPath);
+    free(zipPath);
+    return status;
+}
+
+/**
+ * Collects the content hashes of the bundle archives in the cache dir.
+ */
+static celix_status_t celix_bundleCache_collectUsedContentHashes(celix_bundle_cache_t* cache,
+                                                                 celix_string_hash_map_t* usedHashes) {
+    DIR* dir = opendir(cache->cacheDir);
+    if (dir == NULL) {
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+    celix_status_t status = CELIX_SUCCESS;
+    char pathBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    struct dirent* dent = NULL;
+    while (status == CELIX_SUCCESS && (dent = readdir(dir)) != NULL) {
+        if (strncmp(dent->d_name, "bundle", 6) != 0) {
+            continue;
+        }
+        char* path = celix_utils_writeOrCreateString(pathBuffer, sizeof(pathBuffer), "%s/%s/%s", cache->cacheDir,
+                                                     dent->d_name, CELIX_BUNDLE_ARCHIVE_STATE_PROPERTIES_FILE_NAME);
+        if (path == NULL) {
+            status = CELIX_ENOMEM;
+        } else if (celix_utils_fileExists(path)) {
+            celix_properties_t* props = celix_properties_load(path);
+            const char* hash = celix_properties_get(props, CELIX_BUNDLE_ARCHIVE_CONTENT_HASH_PROPERTY_NAME, NULL);
+            if (hash != NULL) {
+                celix_stringHashMap_putBool(usedHashes, hash, true);
+            }
+            celix_properties_destroy(props);
+        }
+        celix_utils_freeStringIfNotEqual(pathBuffer, path);
+    }
+    closedir(dir);
+    return status;
+}
+
+celix_status_t celix_bundleCache_collectBundleStoreGarbage(celix_bundle_cache_t* cache) {
+    if (!cache->useBundleStore) {
+        return CELIX_SUCCESS;
+    }
+    celix_string_hash_map_t* usedHashes = celix_stringHashMap_create();
+    if (usedHashes == NULL) {
+        return CELIX_ENOMEM;
+    }
+    const char* err = NULL;
+    celix_status_t status = CELIX_SUCCESS;
+    celixThreadRwlock_writeLock(&cache->storeLock);
+    DIR* dir = opendir(cache->bundleStoreDir);
+    if (dir == NULL) {
+        //note no bundle store dir, nothing to collect
+        status = errno == ENOENT ? CELIX_SUCCESS : CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        err = strerror(errno);
+        goto gc_done;
+    }
+    status = celix_bundleCache_collectUsedContentHashes(cache, usedHashes);
+
+    char pathBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    struct dirent* dent = NULL;
+    while (status == CELIX_SUCCESS && (dent = readdir(dir)) != NULL) {
+        if (strcmp(dent->d_name, ".") == 0 || strcmp(dent->d_name, "..") == 0 ||
+            strncmp(dent->d_name, CELIX_BUNDLE_CACHE_STORE_INDEX_FILE_NAME,
+                    strlen(CELIX_BUNDLE_CACHE_STORE_INDEX_FILE_NAME)) == 0 ||
+            celix_stringHashMap_hasKey(usedHashes, dent->d_name)) {
+            continue;
+        }
+        char* path = celix_utils_writeOrCreateString(pathBuffer, sizeof(pathBuffer), "%s/%s", cache->bundleStoreDir,
+                                                     dent->d_name);
+        if (path == NULL) {
+            status = CELIX_ENOMEM;
+        } else if (celix_utils_directoryExists(path)) {
+            fw_log(cache->fw->logger, CELIX_LOG_LEVEL_TRACE, "Removing unused bundle store entry %s.", path);
+            status = celix_utils_deleteDirectory(path, &err);
+        }
+        celix_utils_freeStringIfNotEqual(pathBuffer, path);
+    }
+    closedir(dir);
+
+    if (status == CELIX_SUCCESS) {
+        celixThreadMutex_lock(&cache->mutex);
+        celix_string_hash_map_t* index = celix_bundleCache_getBundleStoreIndex(cache);
+        if (index != NULL) {
+            celix_string_hash_map_iterator_t iter = celix_stringHashMap_begin(index);
+            while (!celix_stringHashMapIterator_isEnd(&iter)) {
+                const char* hash = strrchr(iter.value.ptrValue, ' ');
+                if (hash == NULL || !celix_stringHashMap_hasKey(usedHashes, hash + 1)) {
+                    celix_stringHashMapIterator_remove(&iter);
+                } else {
+                    celix_stringHashMapIterator_next(&iter);
+                }
+            }
+            celix_bundleCache_compactBundleStoreIndex(cache);
+        }
+        celixThreadMutex_unlock(&cache->mutex);
+    }
+
+gc_done:
+    celixThreadRwlock_unlock(&cache->storeLock);
+    celix_stringHashMap_destroy(usedHashes);
+    if (status != CELIX_SUCCESS) {
+        fw_logCode(cache->fw->logger, CELIX_LOG_LEVEL_ERROR, status, "Cannot collect bundle store garbage in %s: %s",
+                   cache->bundleStoreDir, err != NULL ? err : "");
+    }
+    return status;
+}
+
+
+typedef struct celix_bundle_cache_archive_task {
+    const char* location;
+    long bndId;
+    bool skipped;
+    celix_status_t status;
+    bundle_archive_t* archive;
+} celix_bundle_cache_archive_task_t;
+
+typedef struct celix_bundle_cache_archive_tasks {
+    celix_framework_t* fw;
+    celix_array_list_t* tasks; //entry = celix_bundle_cache_archive_task_t*
+    bool failed; //atomic
+} celix_bundle_cache_archive_tasks_t;
+
+static void celix_bundleCache_createArchiveTask(void* data, size_t taskIndex) {
+    celix_bundle_cache_archive_tasks_t* tasks = data;
+    celix_bundle_cache_archive_task_t* task = celix_arrayList_get(tasks->tasks, (int)taskIndex);
+    if (__atomic_load_n(&tasks->failed, __ATOMIC_RELAXED)) {
+        task->skipped = true; //note an archive creation already failed
+        return;
+    }
+    task->status = celix_bundleCache_createArchive(tasks->fw->cache, task->bndId, task->location, &task->archive);
+    if (task->status != CELIX_SUCCESS) {
+        __atomic_store_n(&tasks->failed, true, __ATOMIC_RELAXED);
+    }
+}
 
 static celix_status_t
 celix_bundleCache_createBundleArchivesForSpaceSeparatedList(celix_framework_t* fw, long* bndId, const char* list,
@@ -317,28 +1007,46 @@ celix_bundleCache_createBundleArchivesForSpaceSeparatedList(celix_framework_t* f
     char* savePtr = NULL;
     char zipFileListBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
     char* zipFileList = celix_utils_writeOrCreateString(zipFileListBuffer, sizeof(zipFileListBuffer), "%s", list);
-    if (zipFileList) {
+    celix_bundle_cache_archive_tasks_t tasks = {fw, celix_arrayList_create(), false};
+    if (zipFileList && tasks.tasks) {
         char* location = strtok_r(zipFileList, delims, &savePtr);
         while (location != NULL) {
-            bundle_archive_t* archive = NULL;
-            status = celix_bundleCache_createArchive(fw->cache, (*bndId)++, location, &archive);
-            if (status != CELIX_SUCCESS) {
-                fw_logCode(fw->logger, CELIX_LOG_LEVEL_ERROR, status,
-                           "Cannot create bundle archive for %s", location);
-                break;
+            celix_bundle_cache_archive_task_t* task = calloc(1, sizeof(*task));
+            task->location = location;
+            task->bndId = (*bndId)++;
+            celix_arrayList_add(tasks.tasks, task);
+            location = strtok_r(NULL, delims, &savePtr);
+        }
+
+        //note the bundle ids are assigned in the configured order, only the archive creation (bundle zip extraction)
+        //is done in parallel if configured.
+        celix_framework_runTasksInParallel(fw, celix_framework_getNrOfAutoStartThreads(fw),
+                                           celix_arrayList_size(tasks.tasks), &tasks, celix_bundleCache_createArchiveTask);
+
+        for (int i = 0; i < celix_arrayList_size(tasks.tasks); ++i) {
+            celix_bundle_cache_archive_task_t* task = celix_arrayList_get(tasks.tasks, i);
+            if (task->skipped) {
+                fw_log(fw->logger, CELIX_LOG_LEVEL_WARNING,
+                       "Skipped creating bundle archive for %s (bndId=%li), because creating another bundle archive failed",
+                       task->location, task->bndId);
+            } else if (task->status != CELIX_SUCCESS) {
+                fw_logCode(fw->logger, CELIX_LOG_LEVEL_ERROR, task->status,
+                           "Cannot create bundle archive for %s", task->location);
+                status = status == CELIX_SUCCESS ? task->status : status;
             } else {
                 celix_log_level_e lvl = logProgress ? CELIX_LOG_LEVEL_INFO : CELIX_LOG_LEVEL_DEBUG;
                 fw_log(fw->logger, lvl, "Created bundle cache '%s' for bundle archive %s (bndId=%li).",
-                       celix_bundleArchive_getCurrentRevisionRoot(archive),
-                       celix_bundleArchive_getSymbolicName(archive), celix_bundleArchive_getId(archive));
-                bundleArchive_destroy(archive);
+                       celix_bundleArchive_getCurrentRevisionRoot(task->archive),
+                       celix_bundleArchive_getSymbolicName(task->archive), celix_bundleArchive_getId(task->archive));
+                bundleArchive_destroy(task->archive);
             }
-            location = strtok_r(NULL, delims, &savePtr);
+            free(task);
         }
     } else {
         status = CELIX_ENOMEM;
         fw_logCode(fw->logger, CELIX_LOG_LEVEL_ERROR, status, "Failed to create zip file list.");
     }
+    celix_arrayList_destroy(tasks.tasks);
     celix_utils_freeStringIfNotEqual(zipFileListBuffer, zipFileList);
     return status;
 }
@@ -355,7 +1063,11 @@ celix_status_t celix_bundleCache_createBundleArchivesCache(celix_framework_t* fw
     long bndId = CELIX_FRAMEWORK_BUNDLE_ID + 1; //note cleaning cache, so starting bundle id at 1
 
     const char* errorStr = NULL;
-    status = celix_utils_deleteDirectory(fw->cache->cacheDir, &errorStr);
+    if (fw->cache->useBundleStore) {
+        status = celix_bundleCache_deleteCacheDirExceptBundleStore(fw->cache, &errorStr);
+    } else {
+        status = celix_utils_deleteDirectory(fw->cache->cacheDir, &errorStr);
+    }
     if (status != CELIX_SUCCESS) {
         fw_logCode(fw->logger, CELIX_LOG_LEVEL_ERROR, status, "Failed to delete bundle cache directory %s: %s",
                    fw->cache->cacheDir, errorStr);
@@ -143,6 +143,56 @@ bool celix_bundleCache_isBundleIdAlreadyUsed(celix_bundle_cache_t* cache, long b
  */
 celix_status_t celix_bundleCache_createBundleArchivesCache(celix_framework_t* fw, bool printProgress);
 
+/**
+ * @brief Returns whether the content-addressed bundle store is used (CELIX_FRAMEWORK_CACHE_USE_BUNDLE_STORE).
+ */
+bool celix_bundleCache_isBundleStoreEnabled(celix_bundle_cache_t* cache);
+
+/**
+ * @brief Populates a bundle revision directory with the content of the bundle zip of the provided bundle url, using
+ * the content-addressed bundle store.
+ *
+ * The bundle zip is extracted once to the bundle store, keyed by the SHA-256 content hash of the bundle zip, and the
+ * revision directory is populated with hardlinks to the extracted files. Shared libraries are copied instead of
+ * hardlinked, so that every bundle revision loads its own instance of a library. The content hash of a bundle zip is
+ * kept in a persistent index (together with the size and last modified time of the bundle zip), so that an unchanged
+ * bundle zip is not read again.
+ *
+ * @param[in] cache The bundle cache.
+ * @param[in] bundleUrl The bundle url. Only file bundle urls are supported.
+ * @param[in] revisionDir The revision directory to populate.
+ * @param[in] currentContentHash The content hash of the current content of the revision directory or NULL.
+ * @param[out] contentHash The content hash of the bundle zip. The caller is owner.
+ * @param[out] populated Whether the revision directory is (re)populated. False if the revision directory already
+ *                       contains the content of the bundle zip.
+ * @return Status code indication failure or success:
+ *      - CELIX_SUCCESS when no errors are encountered.
+ *      - CELIX_ILLEGAL_ARGUMENT if the bundle store is not used or the bundle url is not a file bundle url.
+ *      - CELIX_ENOMEM If allocating memory failed.
+ *      - errno when the bundle zip cannot be read or the bundle store/revision directory cannot be written.
+ */
+celix_status_t celix_bundleCache_populateRevisionFromStore(celix_bundle_cache_t* cache,
+                                                           const char* bundleUrl,
+                                                           const char* revisionDir,
+                                                           const char* currentContentHash,
+                                                           char** contentHash,
+                                                           bool* populated);
+
+/**
+ * @brief Removes the bundle store entries which are no longer used by a bundle archive in the cache dir.
+ *
+ * A bundle store entry is in use if its content hash is the content hash of a bundle archive in the cache dir.
+ * Unused bundle store entries, leftover tmp dirs and bundle store index entries with an unused content hash are removed.
+ * Called when a bundle archive is deleted or when a bundle archive is revised with a different bundle zip.
+ *
+ * @param[in] cache The bundle cache.
+ * @return Status code indication failure or success:
+ *      - CELIX_SUCCESS when no errors are encountered or if the bundle store is not used.
+ *      - CELIX_ENOMEM If allocating memory failed.
+ *      - errno when the bundle store directory cannot be read or a bundle store entry cannot be deleted.
+ */
+celix_status_t celix_bundleCache_collectBundleStoreGarbage(celix_bundle_cache_t* cache);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,403 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_framework_event_queue.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "celix_threads.h"
+
+/**
+ * @brief The processing state of a queued event.
+ */
+typedef enum celix_framework_event_queue_state {
+    CELIX_FRAMEWORK_EVENT_QUEUE_STATE_QUEUED = 0,
+    CELIX_FRAMEWORK_EVENT_QUEUE_STATE_PROCESSING = 1,
+    CELIX_FRAMEWORK_EVENT_QUEUE_STATE_CANCELLED = 2
+} celix_framework_event_queue_state_e;
+
+#define CELIX_FRAMEWORK_EVENT_QUEUE_STATE_BITS 2
+#define CELIX_FRAMEWORK_EVENT_QUEUE_STATE_MASK 0x3
+
+/**
+ * @brief A ring buffer cell. The sequence is used to synchronize producers and the consumer (see Dmitry Vyukov's
+ * bounded MPMC queue):
+ *  - sequence == position: the cell is free for the producer claiming position.
+ *  - sequence == position + 1: the cell contains a published event for the consumer.
+ *
+ * The type, bndId and id fields are atomic copies of the event fields, so that other threads can scan the ring
+ * buffer while a cell is reused by a producer. The state is (position << 2) | state, so that a state update of a
+ * thread which scanned an already reused cell fails.
+ */
+typedef struct celix_framework_event_queue_cell {
+    uint64_t sequence; //atomic
+    uint64_t state; //atomic
+    int type; //atomic
+    long bndId; //atomic
+    long id; //atomic
+    celix_framework_event_t event;
+} celix_framework_event_queue_cell_t;
+
+typedef struct celix_framework_event_queue_entry {
+    uint64_t state; //atomic, only updated under the overflow mutex or by the consumer
+    celix_framework_event_t event;
+} celix_framework_event_queue_entry_t;
+
+typedef struct celix_framework_event_queue_segment {
+    struct celix_framework_event_queue_segment* next;
+    celix_framework_event_queue_entry_t entries[];
+} celix_framework_event_queue_segment_t;
+
+struct celix_framework_event_queue {
+    celix_framework_logger_t* logger;
+    size_t mask; //ring capacity - 1
+    celix_framework_event_queue_cell_t* ring;
+    uint64_t enqueuePosition; //atomic, updated by producers
+    uint64_t dequeuePosition; //atomic, only updated by the consumer
+    bool peekedFromRing; //only used by the consumer
+    celix_framework_event_queue_entry_t* peekedEntry; //only used by the consumer, the peeked overflow entry
+
+    struct {
+        celix_thread_mutex_t mutex; //protects below
+        size_t segmentSize;
+        size_t nrOfSegments;
+        celix_framework_event_queue_segment_t* head;
+        size_t headIndex;
+        celix_framework_event_queue_segment_t* tail;
+        size_t tailIndex;
+        celix_framework_event_queue_segment_t* spare; //kept to prevent malloc/free cycles on a segment boundary
+        size_t size; //atomic, can be read without lock
+        uint64_t popped; //atomic, can be read without lock
+    } overflow;
+};
+
+static long celix_frameworkEventQueue_eventBundleId(const celix_framework_event_t* event) {
+    return event->bndEntry != NULL ? event->bndEntry->bndId : -1L;
+}
+
+static long celix_frameworkEventQueue_eventId(const celix_framework_event_t* event) {
+    switch (event->type) {
+        case CELIX_REGISTER_SERVICE_EVENT:
+            return event->registerServiceId;
+        case CELIX_UNREGISTER_SERVICE_EVENT:
+            return event->unregisterServiceId;
+        case CELIX_GENERIC_EVENT:
+            return event->genericEventId;
+        default:
+            return -1L;
+    }
+}
+
+static size_t celix_frameworkEventQueue_roundUpToPowerOf2(size_t n) {
+    size_t result = 1;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+celix_framework_event_queue_t* celix_frameworkEventQueue_create(celix_framework_logger_t* logger, size_t capacity) {
+    celix_framework_event_queue_t* queue = calloc(1, sizeof(*queue));
+    size_t cap = celix_frameworkEventQueue_roundUpToPowerOf2(capacity < 2 ? 2 : capacity);
+    queue->logger = logger;
+    queue->mask = cap - 1;
+    queue->ring = calloc(cap, sizeof(*queue->ring));
+    for (size_t i = 0; i < cap; ++i) {
+        queue->ring[i].sequence = i;
+    }
+    celixThreadMutex_create(&queue->overflow.mutex, NULL);
+    queue->overflow.segmentSize = cap;
+    return queue;
+}
+
+void celix_frameworkEventQueue_destroy(celix_framework_event_queue_t* queue) {
+    if (queue != NULL) {
+        assert(celix_frameworkEventQueue_size(queue) == 0);
+        celix_framework_event_queue_segment_t* segment = queue->overflow.head;
+        while (segment != NULL) {
+            celix_framework_event_queue_segment_t* next = segment->next;
+            free(segment);
+            segment = next;
+        }
+        free(queue->overflow.spare);
+        celixThreadMutex_destroy(&queue->overflow.mutex);
+        free(queue->ring);
+        free(queue);
+    }
+}
+
+static bool celix_frameworkEventQueue_tryPushToRing(celix_framework_event_queue_t* queue, const celix_framework_event_t* event) {
+    uint64_t pos = __atomic_load_n(&queue->enqueuePosition, __ATOMIC_RELAXED);
+    for (;;) {
+        celix_framework_event_queue_cell_t* cell = &queue->ring[pos & queue->mask];
+        uint64_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)seq - (int64_t)pos;
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&queue->enqueuePosition, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->event = *event; //shallow copy
+                __atomic_store_n(&cell->type, (int)event->type, __ATOMIC_RELAXED);
+                __atomic_store_n(&cell->bndId, celix_frameworkEventQueue_eventBundleId(event), __ATOMIC_RELAXED);
+                __atomic_store_n(&cell->id, celix_frameworkEventQueue_eventId(event), __ATOMIC_RELAXED);
+                __atomic_store_n(&cell->state, (pos << CELIX_FRAMEWORK_EVENT_QUEUE_STATE_BITS) | CELIX_FRAMEWORK_EVENT_QUEUE_STATE_QUEUED, __ATOMIC_RELAXED);
+                __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+            //note on failure pos is updated with the current enqueue position
+        } else if (diff < 0) {
+            return false; //ring is full
+        } else {
+            pos = __atomic_load_n(&queue->enqueuePosition, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static celix_framework_event_queue_segment_t* celix_frameworkEventQueue_createSegment(celix_framework_event_queue_t* queue) {
+    celix_framework_event_queue_segment_t* segment = queue->overflow.spare;
+    if (segment != NULL) {
+        queue->overflow.spare = NULL;
+    } else {
+        segment = malloc(sizeof(*segment) + queue->overflow.segmentSize * sizeof(celix_framework_event_queue_entry_t));
+    }
+    segment->next = NULL;
+    queue->overflow.nrOfSegments += 1;
+    return segment;
+}
+
+static void celix_frameworkEventQueue_releaseSegment(celix_framework_event_queue_t* queue, celix_framework_event_queue_segment_t* segment) {
+    queue->overflow.nrOfSegments -= 1;
+    if (queue->overflow.spare == NULL) {
+        queue->overflow.spare = segment;
+    } else {
+        free(segment);
+    }
+}
+
+static void celix_frameworkEventQueue_pushToOverflow(celix_framework_event_queue_t* queue, const celix_framework_event_t* event) {
+    celixThreadMutex_lock(&queue->overflow.mutex);
+    if (queue->overflow.tail == NULL) {
+        fw_log(queue->logger, CELIX_LOG_LEVEL_WARNING,
+               "Static event queue for celix framework is full, falling back to dynamic allocated events. Increase static event queue size, current size is %zu", queue->mask + 1);
+        queue->overflow.head = celix_frameworkEventQueue_createSegment(queue);
+        queue->overflow.tail = queue->overflow.head;
+        queue->overflow.headIndex = 0;
+        queue->overflow.tailIndex = 0;
+    } else if (queue->overflow.tailIndex == queue->overflow.segmentSize) {
+        celix_framework_event_queue_segment_t* segment = celix_frameworkEventQueue_createSegment(queue);
+        queue->overflow.tail->next = segment;
+        queue->overflow.tail = segment;
+        queue->overflow.tailIndex = 0;
+        fw_log(queue->logger, CELIX_LOG_LEVEL_WARNING, "dynamic event queue size is %zu. Is there a bundle blocking on the event loop thread?", queue->overflow.size + 1);
+    }
+    celix_framework_event_queue_entry_t* entry = &queue->overflow.tail->entries[queue->overflow.tailIndex++];
+    entry->event = *event; //shallow copy
+    __atomic_store_n(&entry->state, CELIX_FRAMEWORK_EVENT_QUEUE_STATE_QUEUED, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&queue->overflow.size, 1, __ATOMIC_RELEASE);
+    celixThreadMutex_unlock(&queue->overflow.mutex);
+}
+
+void celix_frameworkEventQueue_push(celix_framework_event_queue_t* queue, const celix_framework_event_t* event) {
+    //note if the overflow queue is not empty, always push to the overflow queue (to ensure order)
+    if (__atomic_load_n(&queue->overflow.size, __ATOMIC_ACQUIRE) == 0 && celix_frameworkEventQueue_tryPushToRing(queue, event)) {
+        return;
+    }
+    celix_frameworkEventQueue_pushToOverflow(queue, event);
+}
+
+celix_framework_event_t* celix_frameworkEventQueue_peek(celix_framework_event_queue_t* queue) {
+    uint64_t pos = __atomic_load_n(&queue->dequeuePosition, __ATOMIC_RELAXED);
+    celix_framework_event_queue_cell_t* cell = &queue->ring[pos & queue->mask];
+    if (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) == pos + 1) {
+        queue->peekedFromRing = true;
+        return &cell->event;
+    }
+
+    celix_framework_event_t* event = NULL;
+    if (__atomic_load_n(&queue->overflow.size, __ATOMIC_ACQUIRE) > 0) {
+        celixThreadMutex_lock(&queue->overflow.mutex);
+        //note segments are not moved or released while not popped, so the event pointer stays valid
+        queue->peekedEntry = &queue->overflow.head->entries[queue->overflow.headIndex];
+        event = &queue->peekedEntry->event;
+        celixThreadMutex_unlock(&queue->overflow.mutex);
+        queue->peekedFromRing = false;
+    }
+    return event;
+}
+
+bool celix_frameworkEventQueue_startProcessing(celix_framework_event_queue_t* queue) {
+    uint64_t* state;
+    uint64_t expected;
+    if (queue->peekedFromRing) {
+        uint64_t pos = __atomic_load_n(&queue->dequeuePosition, __ATOMIC_RELAXED);
+        state = &queue->ring[pos & queue->mask].state;
+        expected = (pos << CELIX_FRAMEWORK_EVENT_QUEUE_STATE_BITS) | CELIX_FRAMEWORK_EVENT_QUEUE_STATE_QUEUED;
+    } else {
+        state = &queue->peekedEntry->state;
+        expected = CELIX_FRAMEWORK_EVENT_QUEUE_STATE_QUEUED;
+    }
+    uint64_t processing = (expected & ~(uint64_t)CELIX_FRAMEWORK_EVENT_QUEUE_STATE_MASK) | CELIX_FRAMEWORK_EVENT_QUEUE_STATE_PROCESSING;
+    return __atomic_compare_exchange_n(state, &expected, processing, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+void celix_frameworkEventQueue_pop(celix_framework_event_queue_t* queue) {
+    if (queue->peekedFromRing) {
+        uint64_t pos = __atomic_load_n(&queue->dequeuePosition, __ATOMIC_RELAXED);
+        celix_framework_event_queue_cell_t* cell = &queue->ring[pos & queue->mask];
+        __atomic_store_n(&cell->sequence, pos + queue->mask + 1, __ATOMIC_RELEASE);
+        __atomic_store_n(&queue->dequeuePosition, pos + 1, __ATOMIC_RELEASE);
+        queue->peekedFromRing = false;
+        return;
+    }
+
+    celixThreadMutex_lock(&queue->overflow.mutex);
+    assert(queue->overflow.size > 0);
+    queue->overflow.headIndex += 1;
+    if (queue->overflow.head == queue->overflow.tail && queue->overflow.headIndex == queue->overflow.tailIndex) {
+        //overflow queue is empty, reuse the segment from the start
+        queue->overflow.headIndex = 0;
+        queue->overflow.tailIndex = 0;
+    } else if (queue->overflow.headIndex == queue->overflow.segmentSize) {
+        celix_framework_event_queue_segment_t* segment = queue->overflow.head;
+        queue->overflow.head = segment->next;
+        queue->overflow.headIndex = 0;
+        celix_frameworkEventQueue_releaseSegment(queue, segment);
+    }
+    __atomic_sub_fetch(&queue->overflow.size, 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&queue->overflow.popped, 1, __ATOMIC_RELEASE);
+    celixThreadMutex_unlock(&queue->overflow.mutex);
+}
+
+size_t celix_frameworkEventQueue_size(celix_framework_event_queue_t* queue) {
+    uint64_t dequeuePos = __atomic_load_n(&queue->dequeuePosition, __ATOMIC_ACQUIRE);
+    uint64_t enqueuePos = __atomic_load_n(&queue->enqueuePosition, __ATOMIC_ACQUIRE);
+    size_t ringSize = enqueuePos > dequeuePos ? (size_t)(enqueuePos - dequeuePos) : 0;
+    return ringSize + __atomic_load_n(&queue->overflow.size, __ATOMIC_ACQUIRE);
+}
+
+uint64_t celix_frameworkEventQueue_nrOfPopped(celix_framework_event_queue_t* queue) {
+    return __atomic_load_n(&queue->dequeuePosition, __ATOMIC_ACQUIRE) +
+           __atomic_load_n(&queue->overflow.popped, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Scans the queued events and calls the visitor for every queued event.
+ *
+ * Ring buffer cells are read lock-free; the visitor is only called for a cell which was not reused while reading the
+ * cell (seqlock-like validation using the cell sequence). Overflow entries are visited under the overflow mutex.
+ * The visitor gets the state of the event and a pointer to update the state, together with the state value belonging
+ * to the visited event. Scanning stops if the visitor returns true.
+ */
+static bool celix_frameworkEventQueue_scan(celix_framework_event_queue_t* queue,
+                                           bool (*visit)(void* data, celix_framework_event_type_e type, long bndId, long id, uint64_t* state, uint64_t stateValue),
+                                           void* data) {
+    uint64_t pos = __atomic_load_n(&queue->dequeuePosition, __ATOMIC_ACQUIRE);
+    uint64_t end = __atomic_load_n(&queue->enqueuePosition, __ATOMIC_ACQUIRE);
+    for (; pos < end; ++pos) {
+        celix_framework_event_queue_cell_t* cell = &queue->ring[pos & queue->mask];
+        uint64_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        if (seq != pos + 1) {
+            continue; //not yet published or already popped
+        }
+        int type = __atomic_load_n(&cell->type, __ATOMIC_RELAXED);
+        long bndId = __atomic_load_n(&cell->bndId, __ATOMIC_RELAXED);
+        long id = __atomic_load_n(&cell->id, __ATOMIC_RELAXED);
+        uint64_t stateValue = __atomic_load_n(&cell->state, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&cell->sequence, __ATOMIC_RELAXED) != seq ||
+            (stateValue >> CELIX_FRAMEWORK_EVENT_QUEUE_STATE_BITS) != pos) {
+            continue; //popped and reused while reading
+        }
+        if (visit(data, (celix_framework_event_type_e)type, bndId, id, &cell->state, stateValue)) {
+            return true;
+        }
+    }
+
+    bool stopped = false;
+    if (__atomic_load_n(&queue->overflow.size, __ATOMIC_ACQUIRE) > 0) {
+        celixThreadMutex_lock(&queue->overflow.mutex);
+        celix_framework_event_queue_segment_t* segment = queue->overflow.head;
+        size_t index = queue->overflow.headIndex;
+        while (!stopped && segment != NULL && (segment != queue->overflow.tail || index < queue->overflow.tailIndex)) {
+            if (index == queue->overflow.segmentSize) {
+                segment = segment->next;
+                index = 0;
+                continue;
+            }
+            celix_framework_event_queue_entry_t* entry = &segment->entries[index++];
+            stopped = visit(data, entry->event.type, celix_frameworkEventQueue_eventBundleId(&entry->event),
+                            celix_frameworkEventQueue_eventId(&entry->event), &entry->state,
+                            __atomic_load_n(&entry->state, __ATOMIC_ACQUIRE));
+        }
+        celixThreadMutex_unlock(&queue->overflow.mutex);
+    }
+    return stopped;
+}
+
+typedef struct celix_framework_event_queue_contains_data {
+    celix_framework_event_queue_match_fp match;
+    void* matchData;
+} celix_framework_event_queue_contains_data_t;
+
+static bool celix_frameworkEventQueue_visitForContains(void* data, celix_framework_event_type_e type, long bndId, long id,
+                                                       uint64_t* state __attribute__((unused)),
+                                                       uint64_t stateValue __attribute__((unused))) {
+    celix_framework_event_queue_contains_data_t* containsData = data;
+    return containsData->match(containsData->matchData, type, bndId, id);
+}
+
+bool celix_frameworkEventQueue_contains(celix_framework_event_queue_t* queue, celix_framework_event_queue_match_fp match, void* matchData) {
+    celix_framework_event_queue_contains_data_t data = {match, matchData};
+    return celix_frameworkEventQueue_scan(queue, celix_frameworkEventQueue_visitForContains, &data);
+}
+
+typedef struct celix_framework_event_queue_cancel_data {
+    celix_framework_event_type_e type;
+    long id;
+    celix_framework_event_queue_cancel_result_e result;
+} celix_framework_event_queue_cancel_data_t;
+
+static bool celix_frameworkEventQueue_visitForCancel(void* data, celix_framework_event_type_e type, long bndId __attribute__((unused)), long id,
+                                                     uint64_t* state, uint64_t stateValue) {
+    celix_framework_event_queue_cancel_data_t* cancelData = data;
+    if (type != cancelData->type || id != cancelData->id) {
+        return false;
+    }
+    uint64_t expected = (stateValue & ~(uint64_t)CELIX_FRAMEWORK_EVENT_QUEUE_STATE_MASK) | CELIX_FRAMEWORK_EVENT_QUEUE_STATE_QUEUED;
+    uint64_t cancelled = (stateValue & ~(uint64_t)CELIX_FRAMEWORK_EVENT_QUEUE_STATE_MASK) | CELIX_FRAMEWORK_EVENT_QUEUE_STATE_CANCELLED;
+    if (__atomic_compare_exchange_n(state, &expected, cancelled, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        cancelData->result = CELIX_FRAMEWORK_EVENT_QUEUE_CANCELLED;
+        return true;
+    }
+    //note expected is updated with the actual state
+    if ((expected & ~(uint64_t)CELIX_FRAMEWORK_EVENT_QUEUE_STATE_MASK) != (stateValue & ~(uint64_t)CELIX_FRAMEWORK_EVENT_QUEUE_STATE_MASK)) {
+        return false; //cell reused, so the event is already popped
+    }
+    uint64_t actualState = expected & CELIX_FRAMEWORK_EVENT_QUEUE_STATE_MASK;
+    if (actualState == CELIX_FRAMEWORK_EVENT_QUEUE_STATE_PROCESSING) {
+        cancelData->result = CELIX_FRAMEWORK_EVENT_QUEUE_PROCESSING;
+        return true;
+    }
+    return false; //already cancelled
+}
+
+celix_framework_event_queue_cancel_result_e celix_frameworkEventQueue_cancel(celix_framework_event_queue_t* queue, celix_framework_event_type_e type, long id) {
+    celix_framework_event_queue_cancel_data_t data = {type, id, CELIX_FRAMEWORK_EVENT_QUEUE_NOT_FOUND};
+    celix_frameworkEventQueue_scan(queue, celix_frameworkEventQueue_visitForCancel, &data);
+    return data.result;
+}
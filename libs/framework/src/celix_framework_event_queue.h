@@ -0,0 +1,125 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_FRAMEWORK_EVENT_QUEUE_H_
+#define CELIX_FRAMEWORK_EVENT_QUEUE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "framework_private.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The multi-producer/single-consumer event queue of the Celix framework event loop.
+ *
+ * Events are pushed into a bounded lock-free ring buffer. If the ring buffer is full, events are pushed
+ * into a (mutex protected) overflow queue, which grows in segments. As long as the overflow queue is not empty,
+ * new events are also pushed into the overflow queue, so that the events of a single producer are kept in order.
+ *
+ * Every queued event has a processing state (queued, processing or cancelled), which is updated lock-free. Other
+ * threads can scan the queued events - e.g. to wait for a specific event - without blocking producers or the consumer.
+ *
+ * The queue does not provide any blocking/waking functionality, this is left to the user of the queue.
+ */
+typedef struct celix_framework_event_queue celix_framework_event_queue_t;
+
+/**
+ * @brief Matches a queued event on its type, bundle id (-1 if the event has no bundle) and id (the service id for a
+ * (un)register service event, the event id for a generic event and -1 for other events).
+ */
+typedef bool (*celix_framework_event_queue_match_fp)(void* data, celix_framework_event_type_e type, long bndId, long id);
+
+typedef enum celix_framework_event_queue_cancel_result {
+    CELIX_FRAMEWORK_EVENT_QUEUE_NOT_FOUND,  //no queued event found
+    CELIX_FRAMEWORK_EVENT_QUEUE_CANCELLED,  //queued event found and cancelled
+    CELIX_FRAMEWORK_EVENT_QUEUE_PROCESSING  //event found, but already being processed by the consumer
+} celix_framework_event_queue_cancel_result_e;
+
+/**
+ * @brief Create a new event queue.
+ * @param logger The framework logger, used to warn about an overflowing event queue.
+ * @param capacity The capacity of the lock-free ring buffer. Will be rounded up to a power of 2.
+ *                 Also used as segment size for the overflow queue.
+ */
+celix_framework_event_queue_t* celix_frameworkEventQueue_create(celix_framework_logger_t* logger, size_t capacity);
+
+/**
+ * @brief Destroy the event queue. The queue should be empty.
+ */
+void celix_frameworkEventQueue_destroy(celix_framework_event_queue_t* queue);
+
+/**
+ * @brief Push a (shallow) copy of the provided event in the queue.
+ * Can be called concurrently from multiple threads.
+ */
+void celix_frameworkEventQueue_push(celix_framework_event_queue_t* queue, const celix_framework_event_t* event);
+
+/**
+ * @brief Returns the oldest event in the queue or NULL if the queue is empty.
+ *
+ * The returned event stays valid (and in the queue) until celix_frameworkEventQueue_pop is called.
+ * Should only be called from the consumer thread.
+ */
+celix_framework_event_t* celix_frameworkEventQueue_peek(celix_framework_event_queue_t* queue);
+
+/**
+ * @brief Marks the oldest event - as returned by celix_frameworkEventQueue_peek - as being processed.
+ * Should only be called from the consumer thread.
+ * @return false if the event is cancelled and should be skipped.
+ */
+bool celix_frameworkEventQueue_startProcessing(celix_framework_event_queue_t* queue);
+
+/**
+ * @brief Removes the oldest event - as returned by celix_frameworkEventQueue_peek - from the queue.
+ * Should only be called from the consumer thread.
+ */
+void celix_frameworkEventQueue_pop(celix_framework_event_queue_t* queue);
+
+/**
+ * @brief Returns the number of events in the queue, including events which are pushed, but not yet popped.
+ */
+size_t celix_frameworkEventQueue_size(celix_framework_event_queue_t* queue);
+
+/**
+ * @brief Returns the total number of popped events. Can be used to detect consumer progress.
+ */
+uint64_t celix_frameworkEventQueue_nrOfPopped(celix_framework_event_queue_t* queue);
+
+/**
+ * @brief Returns whether the queue contains an event - queued or being processed - matching the provided match function.
+ * Can be called concurrently from multiple threads.
+ */
+bool celix_frameworkEventQueue_contains(celix_framework_event_queue_t* queue, celix_framework_event_queue_match_fp match, void* matchData);
+
+/**
+ * @brief Cancels the queued event with the provided type and id, if the consumer did not yet start processing it.
+ * Can be called concurrently from multiple threads.
+ */
+celix_framework_event_queue_cancel_result_e celix_frameworkEventQueue_cancel(celix_framework_event_queue_t* queue, celix_framework_event_type_e type, long id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_FRAMEWORK_EVENT_QUEUE_H_ */
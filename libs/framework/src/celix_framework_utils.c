@@ -238,6 +238,32 @@ celix_status_t celix_framework_utils_extractBundle(celix_framework_t *fw, const
     return status;
 }
 
+char* celix_framework_utils_resolveBundleUrlFilePath(celix_framework_t* fw, const char* bundleURL) {
+    char* trimmedUrl = celix_utils_trim(bundleURL);
+    if (trimmedUrl == NULL) {
+        return NULL;
+    }
+
+    char* result = NULL;
+    char buffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
+    size_t fileSchemeLen = sizeof(FILE_URL_SCHEME)-1;
+    const char* path = NULL;
+    if (strncasecmp(FILE_URL_SCHEME, trimmedUrl, fileSchemeLen) == 0) {
+        path = trimmedUrl + fileSchemeLen;
+    } else if (strcasestr(trimmedUrl, "://") == NULL) {
+        path = trimmedUrl;
+    }
+    if (path != NULL) {
+        char* resolvedPath = celix_framework_utils_resolveFileBundleUrl(buffer, sizeof(buffer), fw, path, true);
+        if (resolvedPath != NULL) {
+            result = realpath(resolvedPath, NULL);
+        }
+        celix_utils_freeStringIfNotEqual(buffer, resolvedPath);
+    }
+    free(trimmedUrl);
+    return result;
+}
+
 bool celix_framework_utils_isBundleUrlValid(celix_framework_t *fw, const char *bundleURL, bool silent) {
     char* trimmedUrl = celix_utils_trim(bundleURL);
 
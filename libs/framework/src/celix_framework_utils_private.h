@@ -76,6 +76,16 @@ celix_status_t celix_framework_utils_extractBundle(celix_framework_t *fw, const
  */
 bool celix_framework_utils_isBundleUrlValid(celix_framework_t *fw, const char *bundleURL, bool silent);
 
+/**
+ * @brief Resolves the absolute path of the bundle zip file for the provided bundle url.
+ *
+ * @param fw Optional Celix framework (used for logging and the bundle path config).
+ * @param bundleURL The bundle url.
+ * @return The absolute path of the bundle zip file or NULL if the bundle url is not a file bundle url (e.g. an
+ *         embedded:// url) or cannot be resolved. The caller is owner of the returned string.
+ */
+char* celix_framework_utils_resolveBundleUrlFilePath(celix_framework_t* fw, const char* bundleURL);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1064,9 +1064,8 @@ static void celix_dmComponent_printFullInfo(FILE *out, bool colors, celix_dm_com
         dm_interface_info_pt intfInfo = celix_arrayList_get(compInfo->interfaces, interfCnt);
         fprintf(out, "   |- %sInterface %i: %s%s\n", startColors, (interfCnt+1), intfInfo->name, endColors);
 
-        hash_map_iterator_t iter = hashMapIterator_construct((hash_map_pt) intfInfo->properties);
-        char *key = NULL;
-        while ((key = hashMapIterator_nextKey(&iter)) != NULL) {
+        const char* key = NULL;
+        CELIX_PROPERTIES_FOR_EACH(intfInfo->properties, key) {
             fprintf(out, "      | %15s = %s\n", key, celix_properties_get(intfInfo->properties, key, "!ERROR!"));
         }
     }
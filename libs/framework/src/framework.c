@@ -28,6 +28,7 @@
 
 #include "celix_dependency_manager.h"
 #include "framework_private.h"
+#include "celix_framework_event_queue.h"
 #include "celix_constants.h"
 #include "resolver.h"
 #include "utils.h"
@@ -175,7 +176,11 @@ static celix_status_t frameworkActivator_destroy(void * userData, bundle_context
 static void framework_autoStartConfiguredBundles(celix_framework_t *fw);
 static void framework_autoInstallConfiguredBundles(celix_framework_t *fw);
 static void framework_autoInstallConfiguredBundlesForList(celix_framework_t *fw, const char *autoStart, celix_array_list_t *installedBundles);
-static void framework_autoStartConfiguredBundlesForList(celix_framework_t* fw, const celix_array_list_t *installedBundles);
+static void framework_autoStartConfiguredBundlesForList(celix_framework_t* fw, const celix_array_list_t *installedBundles, int begin, int end);
+static celix_status_t celix_framework_checkBundleInstallAllowed(celix_framework_t* framework);
+static long celix_framework_bundleIdForInstall(celix_framework_t* framework, const char* bndLoc);
+static celix_status_t celix_framework_createBundle(celix_framework_t* framework, const char* bndLoc, long id, celix_bundle_t** bundleOut);
+static void celix_framework_addInstalledBundle(celix_framework_t* framework, celix_bundle_t* bundle);
 static void celix_framework_addToEventQueue(celix_framework_t *fw, const celix_framework_event_t* event);
 
 struct fw_bundleListener {
@@ -237,6 +242,7 @@ celix_status_t framework_create(framework_pt *out, celix_properties_t* config) {
     celixThreadMutex_create(&framework->dispatcher.mutex, NULL);
     celixThreadMutex_create(&framework->frameworkListenersLock, NULL);
     celixThreadMutex_create(&framework->bundleListenerLock, NULL);
+    celixThreadMutex_create(&framework->resolveLock, NULL);
     celixThreadMutex_create(&framework->installedBundles.mutex, NULL);
     celixThreadCondition_init(&framework->dispatcher.cond, NULL);
     framework->dispatcher.active = true;
@@ -246,9 +252,6 @@ celix_status_t framework_create(framework_pt *out, celix_properties_t* config) {
     framework->configurationMap = config; //note form now on celix_framework_getConfigProperty* can be used
     framework->bundleListeners = celix_arrayList_create();
     framework->frameworkListeners = celix_arrayList_create();
-    framework->dispatcher.eventQueueCap = (int)celix_framework_getConfigPropertyAsLong(framework, CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE, CELIX_FRAMEWORK_DEFAULT_STATIC_EVENT_QUEUE_SIZE, NULL);
-    framework->dispatcher.eventQueue = malloc(sizeof(celix_framework_event_t) * framework->dispatcher.eventQueueCap);
-    framework->dispatcher.dynamicEventQueue = celix_arrayList_create();
 
     //create and store framework uuid
     char uuid[37];
@@ -261,6 +264,22 @@ celix_status_t framework_create(framework_pt *out, celix_properties_t* config) {
     const char* logStr = celix_framework_getConfigProperty(framework, CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL_CONFIG_NAME, CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL_DEFAULT_VALUE, NULL);
     framework->logger = celix_frameworkLogger_create(celix_logUtils_logLevelFromString(logStr, CELIX_LOG_LEVEL_INFO));
 
+    //setup framework event loops
+    long eventQueueCap = celix_framework_getConfigPropertyAsLong(framework, CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE, CELIX_FRAMEWORK_DEFAULT_STATIC_EVENT_QUEUE_SIZE, NULL);
+    long nrOfEventLoops = celix_framework_getConfigPropertyAsLong(framework, CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS, CELIX_FRAMEWORK_DEFAULT_EVENT_DISPATCHER_THREADS, NULL);
+    if (nrOfEventLoops < 1) {
+        fw_log(framework->logger, CELIX_LOG_LEVEL_WARNING, "Invalid %s value %li, using 1 event dispatcher thread.", CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS, nrOfEventLoops);
+        nrOfEventLoops = 1;
+    }
+    framework->dispatcher.nrOfEventLoops = (size_t)nrOfEventLoops;
+    framework->dispatcher.eventLoops = calloc(framework->dispatcher.nrOfEventLoops, sizeof(*framework->dispatcher.eventLoops));
+    for (size_t i = 0; i < framework->dispatcher.nrOfEventLoops; ++i) {
+        celix_framework_event_loop_t* loop = &framework->dispatcher.eventLoops[i];
+        loop->framework = framework;
+        celixThreadCondition_init(&loop->cond, NULL);
+        loop->eventQueue = celix_frameworkEventQueue_create(framework->logger, eventQueueCap > 0 ? (size_t)eventQueueCap : CELIX_FRAMEWORK_DEFAULT_STATIC_EVENT_QUEUE_SIZE);
+    }
+
     celix_status_t status = celix_bundleCache_create(framework, &framework->cache);
     bundle_archive_t* systemArchive = NULL;
     status = CELIX_DO_IF(status, celix_bundleCache_createSystemArchive(framework, &systemArchive));
@@ -325,10 +344,11 @@ celix_status_t framework_destroy(framework_pt framework) {
         if (count > 0) {
             const char *bndName = celix_bundle_getSymbolicName(bnd);
             fw_log(framework->logger, CELIX_LOG_LEVEL_FATAL, "Cannot destroy framework. The use count of bundle %s (bnd id %li) is not 0, but %zu.", bndName, entry->bndId, count);
-            celixThreadMutex_lock(&framework->dispatcher.mutex);
-            int nrOfRequests = framework->dispatcher.eventQueueSize + celix_arrayList_size(framework->dispatcher.dynamicEventQueue);
-            celixThreadMutex_unlock(&framework->dispatcher.mutex);
-            fw_log(framework->logger, CELIX_LOG_LEVEL_WARNING, "nr of request left: %i (should be 0).", nrOfRequests);
+            size_t nrOfRequests = 0;
+            for (size_t j = 0; j < framework->dispatcher.nrOfEventLoops; ++j) {
+                nrOfRequests += celix_frameworkEventQueue_size(framework->dispatcher.eventLoops[j].eventQueue);
+            }
+            fw_log(framework->logger, CELIX_LOG_LEVEL_WARNING, "nr of request left: %zu (should be 0).", nrOfRequests);
         }
         fw_bundleEntry_destroy(entry, true);
 
@@ -373,14 +393,19 @@ celix_status_t framework_destroy(framework_pt framework) {
         arrayList_destroy(framework->frameworkListeners);
     }
 
-    assert(celix_arrayList_size(framework->dispatcher.dynamicEventQueue) == 0);
-    celix_arrayList_destroy(framework->dispatcher.dynamicEventQueue);
+    for (size_t i = 0; i < framework->dispatcher.nrOfEventLoops; ++i) {
+        celix_framework_event_loop_t* loop = &framework->dispatcher.eventLoops[i];
+        celix_frameworkEventQueue_destroy(loop->eventQueue);
+        celixThreadCondition_destroy(&loop->cond);
+    }
+    free(framework->dispatcher.eventLoops);
 
     celix_bundleCache_destroy(framework->cache);
 
 	celixThreadCondition_destroy(&framework->dispatcher.cond);
     celixThreadMutex_destroy(&framework->frameworkListenersLock);
 	celixThreadMutex_destroy(&framework->bundleListenerLock);
+	celixThreadMutex_destroy(&framework->resolveLock);
 	celixThreadMutex_destroy(&framework->dispatcher.mutex);
 	celixThreadMutex_destroy(&framework->shutdown.mutex);
 	celixThreadCondition_destroy(&framework->shutdown.cond);
@@ -389,7 +414,6 @@ celix_status_t framework_destroy(framework_pt framework) {
 
     properties_destroy(framework->configurationMap);
 
-    free(framework->dispatcher.eventQueue);
     free(framework);
 
 	return status;
@@ -407,8 +431,17 @@ celix_status_t fw_init(framework_pt framework) {
     celixThreadMutex_unlock(&framework->shutdown.mutex);
 
 
-	celixThread_create(&framework->dispatcher.thread, NULL, fw_eventDispatcher, framework);
-	celixThread_setName(&framework->dispatcher.thread, "CelixEvent");
+    for (size_t i = 0; i < framework->dispatcher.nrOfEventLoops; ++i) {
+        celix_framework_event_loop_t* loop = &framework->dispatcher.eventLoops[i];
+        celixThread_create(&loop->thread, NULL, fw_eventDispatcher, loop);
+        if (i == 0) {
+            celixThread_setName(&loop->thread, "CelixEvent");
+        } else {
+            char name[16];
+            snprintf(name, sizeof(name), "CelixEvent%zu", i);
+            celixThread_setName(&loop->thread, name);
+        }
+    }
 
 
 
@@ -494,6 +527,7 @@ static void framework_autoStartConfiguredBundles(celix_framework_t* fw) {
     const char* const cosgiKeys[] = {"cosgi.auto.start.0","cosgi.auto.start.1","cosgi.auto.start.2","cosgi.auto.start.3","cosgi.auto.start.4","cosgi.auto.start.5","cosgi.auto.start.6", NULL};
     const char* const celixKeys[] = {CELIX_AUTO_START_0, CELIX_AUTO_START_1, CELIX_AUTO_START_2, CELIX_AUTO_START_3, CELIX_AUTO_START_4, CELIX_AUTO_START_5, CELIX_AUTO_START_6, NULL};
     CELIX_BUILD_ASSERT(sizeof(*cosgiKeys) == sizeof(*celixKeys));
+    int levelEnds[sizeof(celixKeys) / sizeof(*celixKeys)] = {0}; //index in installedBundles after the bundles of a level
     celix_array_list_t *installedBundles = celix_arrayList_create();
     for (int i = 0; celixKeys[i] != NULL; ++i) {
         const char *autoStart = celix_framework_getConfigProperty(fw, celixKeys[i], NULL, NULL);
@@ -503,8 +537,13 @@ static void framework_autoStartConfiguredBundles(celix_framework_t* fw) {
         if (autoStart != NULL) {
             framework_autoInstallConfiguredBundlesForList(fw, autoStart, installedBundles);
         }
+        levelEnds[i] = celix_arrayList_size(installedBundles);
+    }
+    int levelBegin = 0;
+    for (int i = 0; celixKeys[i] != NULL; ++i) {
+        framework_autoStartConfiguredBundlesForList(fw, installedBundles, levelBegin, levelEnds[i]);
+        levelBegin = levelEnds[i];
     }
-    framework_autoStartConfiguredBundlesForList(fw, installedBundles);
     celix_arrayList_destroy(installedBundles);
 }
 
@@ -515,13 +554,88 @@ static void framework_autoInstallConfiguredBundles(celix_framework_t* fw) {
     }
 }
 
+typedef struct celix_framework_auto_install_task {
+    celix_framework_t* fw;
+    const char* location;
+    long bndId;
+    bool create; //false if the bundle is already installed
+    celix_status_t status;
+    celix_bundle_t* bnd;
+} celix_framework_auto_install_task_t;
+
+static void framework_autoInstallBundleTask(void* data, size_t taskIndex) {
+    celix_framework_auto_install_task_t* task = celix_arrayList_get(data, (int)taskIndex);
+    if (task->create) {
+        task->status = celix_framework_createBundle(task->fw, task->location, task->bndId, &task->bnd);
+    }
+}
+
+/**
+ * Install the bundles of a auto start/install list using nrOfThreads threads.
+ *
+ * The bundle ids are assigned and the bundles are added to the installed bundles in the configured order, only the
+ * creation of the bundle archives (extraction of the bundle zips) and bundles is done in parallel.
+ */
+static void framework_autoInstallConfiguredBundlesInParallel(celix_framework_t* fw, char* autoStart, celix_array_list_t *installedBundles, size_t nrOfThreads) {
+    //increase use count of framework bundle to prevent a stop.
+    celix_framework_bundle_entry_t *fwBundleEntry = celix_framework_bundleEntry_getBundleEntryAndIncreaseUseCount(fw, fw->bundleId);
+    celix_status_t status = celix_framework_checkBundleInstallAllowed(fw);
+
+    celix_array_list_t* tasks = celix_arrayList_create();
+    char delims[] = " ";
+    char *savePtr = NULL;
+    char *location = strtok_r(autoStart, delims, &savePtr);
+    while (status == CELIX_SUCCESS && location != NULL) {
+        bool duplicate = false;
+        for (int i = 0; i < celix_arrayList_size(tasks) && !duplicate; ++i) {
+            celix_framework_auto_install_task_t* other = celix_arrayList_get(tasks, i);
+            duplicate = celix_utils_stringEquals(other->location, location);
+        }
+        if (!duplicate) {
+            celix_framework_auto_install_task_t* task = calloc(1, sizeof(*task));
+            task->fw = fw;
+            task->location = location;
+            if (!celix_framework_utils_isBundleUrlValid(fw, location, false)) {
+                task->status = CELIX_FILE_IO_EXCEPTION;
+            } else {
+                task->bnd = framework_getBundle(fw, location);
+                task->create = task->bnd == NULL;
+                task->bndId = task->create ? celix_framework_bundleIdForInstall(fw, location) : celix_bundle_getId(task->bnd);
+            }
+            celix_arrayList_add(tasks, task);
+        }
+        location = strtok_r(NULL, delims, &savePtr);
+    }
+
+    celix_framework_runTasksInParallel(fw, nrOfThreads, celix_arrayList_size(tasks), tasks, framework_autoInstallBundleTask);
+
+    for (int i = 0; i < celix_arrayList_size(tasks); ++i) {
+        celix_framework_auto_install_task_t* task = celix_arrayList_get(tasks, i);
+        if (task->status == CELIX_SUCCESS) {
+            if (task->create) {
+                celix_framework_addInstalledBundle(fw, task->bnd);
+            }
+            if (installedBundles) {
+                celix_arrayList_add(installedBundles, task->bnd);
+            }
+        } else {
+            fw_logCode(fw->logger, CELIX_LOG_LEVEL_ERROR, task->status, "Could not install bundle from location '%s'.", task->location);
+        }
+        free(task);
+    }
+    celix_arrayList_destroy(tasks);
+    celix_framework_bundleEntry_decreaseUseCount(fwBundleEntry);
+}
 
 static void framework_autoInstallConfiguredBundlesForList(celix_framework_t* fw, const char *autoStartIn, celix_array_list_t *installedBundles) {
     char delims[] = " ";
     char *save_ptr = NULL;
     char autoStartBuffer[CELIX_DEFAULT_STRING_CREATE_BUFFER_SIZE];
     char* autoStart = celix_utils_writeOrCreateString(autoStartBuffer, sizeof(autoStartBuffer), "%s", autoStartIn);
-    if (autoStart != NULL) {
+    size_t nrOfThreads = celix_framework_getNrOfAutoStartThreads(fw);
+    if (autoStart != NULL && nrOfThreads > 1) {
+        framework_autoInstallConfiguredBundlesInParallel(fw, autoStart, installedBundles, nrOfThreads);
+    } else if (autoStart != NULL) {
         char *location = strtok_r(autoStart, delims, &save_ptr);
         while (location != NULL) {
             //first install
@@ -541,20 +655,82 @@ static void framework_autoInstallConfiguredBundlesForList(celix_framework_t* fw,
     celix_utils_freeStringIfNotEqual(autoStartBuffer, autoStart);
 }
 
-static void framework_autoStartConfiguredBundlesForList(celix_framework_t* fw, const celix_array_list_t *installedBundles) {
+typedef struct celix_framework_auto_start_bundles {
+    celix_framework_t* fw;
+    const celix_array_list_t* bundles;
+    int begin;
+} celix_framework_auto_start_bundles_t;
+
+static void framework_autoStartBundleTask(void* data, size_t taskIndex) {
+    celix_framework_auto_start_bundles_t* bundles = data;
+    celix_framework_t* fw = bundles->fw;
+    bundle_t *bnd = celix_arrayList_get(bundles->bundles, bundles->begin + (int)taskIndex);
+    long bndId = celix_bundle_getId(bnd);
+    if (celix_bundle_getState(bnd) != OSGI_FRAMEWORK_BUNDLE_ACTIVE) {
+        bool started = celix_framework_startBundle(fw, bndId);
+        if (!started) {
+            fw_log(fw->logger, CELIX_LOG_LEVEL_ERROR, "Could not start bundle %s (bnd id = %li)\n", bnd->symbolicName, bndId);
+        }
+    } else {
+        fw_log(fw->logger, CELIX_LOG_LEVEL_TRACE, "Cannot start bundle %s (bnd id = %li), because it is already started\n", bnd->symbolicName, bndId);
+    }
+}
+
+/**
+ * Start the installed bundles in the range [begin, end), i.e. the bundles of a single auto start level.
+ * If configured (CELIX_FRAMEWORK_AUTO_START_THREADS), the bundles are started in parallel. The function returns
+ * after all bundles are started, so that a next level is only started after the previous level.
+ */
+static void framework_autoStartConfiguredBundlesForList(celix_framework_t* fw, const celix_array_list_t *installedBundles, int begin, int end) {
     assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
-    for (int i = 0; i < celix_arrayList_size(installedBundles); ++i) {
-        bundle_t *bnd = celix_arrayList_get(installedBundles, i);
-        long bndId = celix_bundle_getId(bnd);
-        if (celix_bundle_getState(bnd) != OSGI_FRAMEWORK_BUNDLE_ACTIVE) {
-            bool started = celix_framework_startBundle(fw, bndId);
-            if (!started) {
-                fw_log(fw->logger, CELIX_LOG_LEVEL_ERROR, "Could not start bundle %s (bnd id = %li)\n", bnd->symbolicName, bndId);
-            }
-        } else {
-            fw_log(fw->logger, CELIX_LOG_LEVEL_TRACE, "Cannot start bundle %s (bnd id = %li), because it is already started\n", bnd->symbolicName, bndId);
+    celix_framework_auto_start_bundles_t bundles = {fw, installedBundles, begin};
+    celix_framework_runTasksInParallel(fw, celix_framework_getNrOfAutoStartThreads(fw), end - begin, &bundles, framework_autoStartBundleTask);
+}
+
+size_t celix_framework_getNrOfAutoStartThreads(celix_framework_t* fw) {
+    long nrOfThreads = celix_framework_getConfigPropertyAsLong(fw, CELIX_FRAMEWORK_AUTO_START_THREADS, CELIX_FRAMEWORK_DEFAULT_AUTO_START_THREADS, NULL);
+    if (nrOfThreads < 1) {
+        fw_log(fw->logger, CELIX_LOG_LEVEL_WARNING, "Invalid %s value %li, using 1 auto start thread.", CELIX_FRAMEWORK_AUTO_START_THREADS, nrOfThreads);
+        nrOfThreads = 1;
+    }
+    return (size_t)nrOfThreads;
+}
+
+typedef struct celix_framework_parallel_tasks {
+    size_t nrOfTasks;
+    size_t nextTask; //atomic
+    void* data;
+    void (*task)(void* data, size_t taskIndex);
+} celix_framework_parallel_tasks_t;
+
+static void* celix_framework_parallelTasksWorker(void* data) {
+    celix_framework_parallel_tasks_t* tasks = data;
+    size_t index = __atomic_fetch_add(&tasks->nextTask, 1, __ATOMIC_RELAXED);
+    while (index < tasks->nrOfTasks) {
+        tasks->task(tasks->data, index);
+        index = __atomic_fetch_add(&tasks->nextTask, 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+void celix_framework_runTasksInParallel(celix_framework_t* fw, size_t nrOfThreads, size_t nrOfTasks, void* data, void (*task)(void* data, size_t taskIndex)) {
+    celix_framework_parallel_tasks_t tasks = {nrOfTasks, 0, data, task};
+    size_t nrOfWorkers = nrOfThreads < nrOfTasks ? nrOfThreads : nrOfTasks;
+    size_t nrOfStartedWorkers = 0;
+    celix_thread_t* workers = nrOfWorkers > 1 ? calloc(nrOfWorkers - 1, sizeof(*workers)) : NULL;
+    for (size_t i = 0; workers != NULL && i < nrOfWorkers - 1; ++i) {
+        if (celixThread_create(&workers[i], NULL, celix_framework_parallelTasksWorker, &tasks) != CELIX_SUCCESS) {
+            fw_log(fw->logger, CELIX_LOG_LEVEL_WARNING, "Cannot create worker thread, running tasks with %zu threads.", nrOfStartedWorkers + 1);
+            break;
         }
+        celixThread_setName(&workers[i], "CelixTask");
+        nrOfStartedWorkers += 1;
     }
+    celix_framework_parallelTasksWorker(&tasks); //note the calling thread also runs tasks
+    for (size_t i = 0; i < nrOfStartedWorkers; ++i) {
+        celixThread_join(workers[i], NULL);
+    }
+    free(workers);
 }
 
 celix_status_t framework_stop(framework_pt framework) {
@@ -620,12 +796,58 @@ bool celix_framework_getConfigPropertyAsBool(celix_framework_t* framework, const
     return result;
 }
 
+/**
+ * Check whether bundles can be installed, i.e. the framework is not being shutdown.
+ */
+static celix_status_t celix_framework_checkBundleInstallAllowed(celix_framework_t* framework) {
+    bundle_state_e state = CELIX_BUNDLE_STATE_UNKNOWN;
+    celix_status_t status = bundle_getState(framework->bundle, &state);
+    if (status == CELIX_SUCCESS) {
+        if (state == CELIX_BUNDLE_STATE_STOPPING || state == CELIX_BUNDLE_STATE_UNINSTALLED) {
+            fw_log(framework->logger, CELIX_LOG_LEVEL_INFO,  "The framework is being shutdown");
+            status = CELIX_FRAMEWORK_SHUTDOWN;
+        }
+    }
+    return status;
+}
+
+/**
+ * Returns the bundle id for a new bundle installed from the provided location.
+ * If there is already a bundle cache entry for the location, the bundle id of that entry is reused.
+ */
+static long celix_framework_bundleIdForInstall(celix_framework_t* framework, const char* bndLoc) {
+    long alreadyExistingBndId = celix_bundleCache_findBundleIdForLocation(framework->cache, bndLoc);
+    return alreadyExistingBndId == -1 ? framework_getNextBundleId(framework) : alreadyExistingBndId;
+}
+
+/**
+ * Create the bundle archive (i.e. extract the bundle zip) and the bundle for the provided location and bundle id.
+ * Can be called in parallel for different bundle ids.
+ */
+static celix_status_t celix_framework_createBundle(celix_framework_t* framework, const char* bndLoc, long id, celix_bundle_t** bundleOut) {
+    bundle_archive_t* archive = NULL;
+    celix_status_t status = celix_bundleCache_createArchive(framework->cache, id, bndLoc, &archive);
+    status = CELIX_DO_IF(status, celix_bundle_createFromArchive(framework, archive, bundleOut));
+    return status;
+}
+
+/**
+ * Add a created bundle to the installed bundles and fire the INSTALLED bundle event.
+ */
+static void celix_framework_addInstalledBundle(celix_framework_t* framework, celix_bundle_t* bundle) {
+    celix_framework_bundle_entry_t *bEntry = fw_bundleEntry_create(bundle);
+    celix_framework_bundleEntry_increaseUseCount(bEntry);
+    celixThreadMutex_lock(&framework->installedBundles.mutex);
+    celix_arrayList_add(framework->installedBundles.entries, bEntry);
+    celixThreadMutex_unlock(&framework->installedBundles.mutex);
+    fw_fireBundleEvent(framework, OSGI_FRAMEWORK_BUNDLE_EVENT_INSTALLED, bEntry);
+    celix_framework_bundleEntry_decreaseUseCount(bEntry);
+}
+
 celix_status_t celix_framework_installBundleInternal(celix_framework_t *framework, const char *bndLoc, celix_bundle_t **bundleOut) {
     celix_status_t status = CELIX_SUCCESS;
     celix_bundle_t* bundle = NULL;
 
-    bundle_state_e state = CELIX_BUNDLE_STATE_UNKNOWN;
-
     bool valid = celix_framework_utils_isBundleUrlValid(framework, bndLoc, false);
     if (!valid) {
         return CELIX_FILE_IO_EXCEPTION;
@@ -634,13 +856,7 @@ celix_status_t celix_framework_installBundleInternal(celix_framework_t *framewor
     //increase use count of framework bundle to prevent a stop.
     celix_framework_bundle_entry_t *fwBundleEntry = celix_framework_bundleEntry_getBundleEntryAndIncreaseUseCount(framework,
                                                                                                           framework->bundleId);
-  	status = CELIX_DO_IF(status, bundle_getState(framework->bundle, &state));
-  	if (status == CELIX_SUCCESS) {
-        if (state == CELIX_BUNDLE_STATE_STOPPING || state == CELIX_BUNDLE_STATE_UNINSTALLED) {
-            fw_log(framework->logger, CELIX_LOG_LEVEL_INFO,  "The framework is being shutdown");
-            status = CELIX_FRAMEWORK_SHUTDOWN;
-        }
-  	}
+    status = celix_framework_checkBundleInstallAllowed(framework);
 
     if (status == CELIX_SUCCESS) {
         bundle = framework_getBundle(framework, bndLoc);
@@ -650,19 +866,10 @@ celix_status_t celix_framework_installBundleInternal(celix_framework_t *framewor
             return CELIX_SUCCESS;
         }
 
-        long alreadyExistingBndId = celix_bundleCache_findBundleIdForLocation(framework->cache, bndLoc);
-        long id = alreadyExistingBndId == -1 ? framework_getNextBundleId(framework) : alreadyExistingBndId;
-        bundle_archive_t* archive = NULL;
-        status = CELIX_DO_IF(status, celix_bundleCache_createArchive(framework->cache, id, bndLoc, &archive));
-        status = CELIX_DO_IF(status, celix_bundle_createFromArchive(framework, archive, &bundle));
+        long id = celix_framework_bundleIdForInstall(framework, bndLoc);
+        status = celix_framework_createBundle(framework, bndLoc, id, &bundle);
         if (status == CELIX_SUCCESS) {
-            celix_framework_bundle_entry_t *bEntry = fw_bundleEntry_create(bundle);
-            celix_framework_bundleEntry_increaseUseCount(bEntry);
-            celixThreadMutex_lock(&framework->installedBundles.mutex);
-            celix_arrayList_add(framework->installedBundles.entries, bEntry);
-            celixThreadMutex_unlock(&framework->installedBundles.mutex);
-            fw_fireBundleEvent(framework, OSGI_FRAMEWORK_BUNDLE_EVENT_INSTALLED, bEntry);
-            celix_framework_bundleEntry_decreaseUseCount(bEntry);
+            celix_framework_addInstalledBundle(framework, bundle);
         }
     }
 
@@ -1191,13 +1398,17 @@ static void* framework_shutdown(void *framework) {
         celix_framework_bundleEntry_decreaseUseCount(fwEntry);
     }
 
-    //join dispatcher thread
+    //join dispatcher threads
     celixThreadMutex_lock(&fw->dispatcher.mutex);
     fw->dispatcher.active = false;
-    celixThreadCondition_broadcast(&fw->dispatcher.cond);
+    for (size_t i = 0; i < fw->dispatcher.nrOfEventLoops; ++i) {
+        celixThreadCondition_broadcast(&fw->dispatcher.eventLoops[i].cond);
+    }
     celixThreadMutex_unlock(&fw->dispatcher.mutex);
-    celixThread_join(fw->dispatcher.thread, NULL);
-    fw_log(fw->logger, CELIX_LOG_LEVEL_TRACE, "Joined event loop thread for framework %s", celix_framework_getUUID(framework));
+    for (size_t i = 0; i < fw->dispatcher.nrOfEventLoops; ++i) {
+        celixThread_join(fw->dispatcher.eventLoops[i].thread, NULL);
+    }
+    fw_log(fw->logger, CELIX_LOG_LEVEL_TRACE, "Joined event loop threads for framework %s", celix_framework_getUUID(framework));
 
 
     celixThreadMutex_lock(&fw->shutdown.mutex);
@@ -1263,33 +1474,133 @@ void fw_fireFrameworkEvent(framework_pt framework, framework_event_type_e eventT
     celix_framework_addToEventQueue(framework, &event);
 }
 
+/**
+ * @brief Returns the ordered event loop; the event loop handling all events except parallel generic events.
+ */
+static celix_framework_event_loop_t* celix_framework_getOrderedEventLoop(celix_framework_t* fw) {
+    return &fw->dispatcher.eventLoops[0];
+}
+
+/**
+ * @brief Returns the event loop handling the provided event.
+ *
+ * Framework, bundle and service (un)registration events and - by default - generic events can trigger listener and
+ * service tracker callbacks of every bundle. These events are all handled by the first (ordered) event loop, so
+ * these callbacks are called in order and never concurrently.
+ * Only parallel generic events (see celix_framework_fireParallelGenericEvent) are handled by the event loop
+ * of their bundle (bundle id % nrOfEventLoops).
+ */
+static celix_framework_event_loop_t* celix_framework_getEventLoopForEvent(celix_framework_t* fw, const celix_framework_event_t* event) {
+    if (event->type == CELIX_GENERIC_EVENT && event->genericParallel && event->bndEntry != NULL) {
+        return &fw->dispatcher.eventLoops[(size_t)event->bndEntry->bndId % fw->dispatcher.nrOfEventLoops];
+    }
+    return celix_framework_getOrderedEventLoop(fw);
+}
+
 static void celix_framework_addToEventQueue(celix_framework_t *fw, const celix_framework_event_t* event) {
+    celix_framework_event_loop_t* loop = celix_framework_getEventLoopForEvent(fw, event);
+    celix_frameworkEventQueue_push(loop->eventQueue, event);
+
+    //note only wake up the event loop thread if it is idle.
+    //The fence ensures that either the event loop thread sees the pushed event or this thread sees the idle flag.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&loop->idle, __ATOMIC_RELAXED)) {
+        celixThreadMutex_lock(&fw->dispatcher.mutex);
+        celixThreadCondition_broadcast(&loop->cond);
+        celixThreadMutex_unlock(&fw->dispatcher.mutex);
+    }
+}
+
+/**
+ * @brief Notifies the threads waiting for event loop progress, if any.
+ * The fence ensures that either a waiting thread sees the progress or this thread sees the waiting thread.
+ */
+static void celix_framework_notifyEventLoopProgress(celix_framework_t* fw) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&fw->dispatcher.nbWaiting, __ATOMIC_RELAXED) > 0) {
+        celixThreadMutex_lock(&fw->dispatcher.mutex);
+        celixThreadCondition_broadcast(&fw->dispatcher.cond);
+        celixThreadMutex_unlock(&fw->dispatcher.mutex);
+    }
+}
+
+/**
+ * @brief Returns whether an event matching the provided match function is queued or being processed by one of the
+ * event loops.
+ */
+static bool celix_framework_hasMatchingEvent(celix_framework_t* fw, celix_framework_event_queue_match_fp match, void* matchData) {
+    for (size_t i = 0; i < fw->dispatcher.nrOfEventLoops; ++i) {
+        if (celix_frameworkEventQueue_contains(fw->dispatcher.eventLoops[i].eventQueue, match, matchData)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Waits until no event matching the provided match function is queued or being processed.
+ *
+ * Only the matching events (and the events queued before them on the same event loop) are waited for, so a waiter
+ * does not wait for events queued after its own event(s).
+ */
+static void celix_framework_waitForMatchingEvents(celix_framework_t* fw, celix_framework_event_queue_match_fp match, void* matchData) {
     celixThreadMutex_lock(&fw->dispatcher.mutex);
-    //try to add to static queue
-    if (celix_arrayList_size(fw->dispatcher.dynamicEventQueue) > 0) { //always to dynamic queue if not empty (to ensure order)
-        celix_framework_event_t *e = malloc(sizeof(*e));
-        *e = *event; //shallow copy
-        celix_arrayList_add(fw->dispatcher.dynamicEventQueue, e);
-        if (celix_arrayList_size(fw->dispatcher.dynamicEventQueue) % 100 == 0) {
-            fw_log(fw->logger, CELIX_LOG_LEVEL_WARNING, "dynamic event queue size is %i. Is there a bundle blocking on the event loop thread?", celix_arrayList_size(fw->dispatcher.dynamicEventQueue));
-        }
-    } else if (fw->dispatcher.eventQueueSize < fw->dispatcher.eventQueueCap) {
-        size_t index = (fw->dispatcher.eventQueueFirstEntry + fw->dispatcher.eventQueueSize) %
-                       fw->dispatcher.eventQueueCap;
-        fw->dispatcher.eventQueue[index] = *event; //shallow copy
-        fw->dispatcher.eventQueueSize += 1;
-    } else {
-        //static queue is full, dynamics queue is empty. Add first entry to dynamic queue
-        fw_log(fw->logger, CELIX_LOG_LEVEL_WARNING,
-               "Static event queue for celix framework is full, falling back to dynamic allocated events. Increase static event queue size, current size is %i", fw->dispatcher.eventQueueCap);
-        celix_framework_event_t *e = malloc(sizeof(*e));
-        *e = *event; //shallow copy
-        celix_arrayList_add(fw->dispatcher.dynamicEventQueue, e);
-    }
-    celixThreadCondition_broadcast(&fw->dispatcher.cond);
+    __atomic_add_fetch(&fw->dispatcher.nbWaiting, 1, __ATOMIC_SEQ_CST);
+    while (celix_framework_hasMatchingEvent(fw, match, matchData)) {
+        celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
+    }
+    __atomic_sub_fetch(&fw->dispatcher.nbWaiting, 1, __ATOMIC_SEQ_CST);
     celixThreadMutex_unlock(&fw->dispatcher.mutex);
 }
 
+static bool celix_framework_matchRegisterEvent(void* data, celix_framework_event_type_e type, long bndId __attribute__((unused)), long id) {
+    return type == CELIX_REGISTER_SERVICE_EVENT && id == *(long*)data;
+}
+
+static bool celix_framework_matchUnregisterEvent(void* data, celix_framework_event_type_e type, long bndId __attribute__((unused)), long id) {
+    return type == CELIX_UNREGISTER_SERVICE_EVENT && id == *(long*)data;
+}
+
+static bool celix_framework_matchGenericEvent(void* data, celix_framework_event_type_e type, long bndId __attribute__((unused)), long id) {
+    return type == CELIX_GENERIC_EVENT && id == *(long*)data;
+}
+
+static bool celix_framework_matchRegistrationEventForBundle(void* data, celix_framework_event_type_e type, long bndId, long id __attribute__((unused))) {
+    return (type == CELIX_REGISTER_SERVICE_EVENT || type == CELIX_UNREGISTER_SERVICE_EVENT) && bndId == *(long*)data;
+}
+
+static bool celix_framework_matchEventForBundle(void* data, celix_framework_event_type_e type __attribute__((unused)), long bndId, long id __attribute__((unused))) {
+    return bndId == *(long*)data;
+}
+
+/**
+ * @brief Returns the total number of events popped from the event queues of all event loops.
+ */
+static uint64_t celix_framework_nrOfPoppedEvents(celix_framework_t* fw) {
+    uint64_t count = 0;
+    for (size_t i = 0; i < fw->dispatcher.nrOfEventLoops; ++i) {
+        count += celix_frameworkEventQueue_nrOfPopped(fw->dispatcher.eventLoops[i].eventQueue);
+    }
+    return count;
+}
+
+/**
+ * @brief Returns whether the event queues of all event loops are empty (including the event being processed).
+ *
+ * The event queues are checked one by one, so an event loop can push an event to an already checked event queue.
+ * To get a consistent view, the number of popped events is compared before and after checking the event queues:
+ * an event loop can only push an event while processing (and afterwards popping) an event.
+ */
+static bool celix_framework_areAllEventQueuesEmpty(celix_framework_t* fw) {
+    uint64_t poppedBefore = celix_framework_nrOfPoppedEvents(fw);
+    for (size_t i = 0; i < fw->dispatcher.nrOfEventLoops; ++i) {
+        if (celix_frameworkEventQueue_size(fw->dispatcher.eventLoops[i].eventQueue) > 0) {
+            return false;
+        }
+    }
+    return poppedBefore == celix_framework_nrOfPoppedEvents(fw);
+}
+
 static void fw_handleEventRequest(celix_framework_t *framework, celix_framework_event_t* event) {
     if (event->type == CELIX_BUNDLE_EVENT_TYPE) {
         celix_array_list_t *localListeners = celix_arrayList_create();
@@ -1359,82 +1670,51 @@ static void fw_handleEventRequest(celix_framework_t *framework, celix_framework_
     }
 }
 
-static inline celix_framework_event_t* fw_topEventFromQueue(celix_framework_t* fw) {
-    celix_framework_event_t* e = NULL;
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    if (fw->dispatcher.eventQueueSize > 0) {
-        e = &fw->dispatcher.eventQueue[fw->dispatcher.eventQueueFirstEntry];
-    } else if (celix_arrayList_size(fw->dispatcher.dynamicEventQueue) > 0) {
-        e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, 0);
-    }
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
-    return e;
-}
-
-static inline bool fw_removeTopEventFromQueue(celix_framework_t* fw) {
-    bool dynamicallyAllocated = false;
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    if (fw->dispatcher.eventQueueSize > 0) {
-        fw->dispatcher.eventQueueFirstEntry = (fw->dispatcher.eventQueueFirstEntry+1) % fw->dispatcher.eventQueueCap;
-        fw->dispatcher.eventQueueSize -= 1;
-    } else if (celix_arrayList_size(fw->dispatcher.dynamicEventQueue) > 0) {
-        celix_arrayList_removeAt(fw->dispatcher.dynamicEventQueue, 0);
-        dynamicallyAllocated = true;
-    }
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
-    return dynamicallyAllocated;
-}
-
-
-static inline void fw_handleEvents(celix_framework_t* framework) {
-    celixThreadMutex_lock(&framework->dispatcher.mutex);
-    int size = framework->dispatcher.eventQueueSize + celix_arrayList_size(framework->dispatcher.dynamicEventQueue);
-    if (size == 0 && framework->dispatcher.active) {
-        celixThreadCondition_timedwaitRelative(&framework->dispatcher.cond, &framework->dispatcher.mutex, 1, 0);
+static inline void fw_handleEvents(celix_framework_event_loop_t* loop) {
+    celix_framework_t* framework = loop->framework;
+    if (celix_frameworkEventQueue_size(loop->eventQueue) == 0) {
+        celixThreadMutex_lock(&framework->dispatcher.mutex);
+        __atomic_store_n(&loop->idle, true, __ATOMIC_SEQ_CST);
+        if (celix_frameworkEventQueue_size(loop->eventQueue) == 0 && framework->dispatcher.active) {
+            celixThreadCondition_timedwaitRelative(&loop->cond, &framework->dispatcher.mutex, 1, 0);
+        }
+        __atomic_store_n(&loop->idle, false, __ATOMIC_RELAXED);
+        celixThreadMutex_unlock(&framework->dispatcher.mutex);
     }
-    size = framework->dispatcher.eventQueueSize + celix_arrayList_size(framework->dispatcher.dynamicEventQueue);
-    celixThreadMutex_unlock(&framework->dispatcher.mutex);
 
-    while (size > 0) {
-        celix_framework_event_t* topEvent = fw_topEventFromQueue(framework);
+    celix_framework_event_t* topEvent = celix_frameworkEventQueue_peek(loop->eventQueue);
+    while (topEvent != NULL) {
+        //note only a queued register service event can be cancelled
+        topEvent->cancelled = !celix_frameworkEventQueue_startProcessing(loop->eventQueue);
         fw_handleEventRequest(framework, topEvent);
-        bool dynamiclyAllocatedEvent = fw_removeTopEventFromQueue(framework);
-
         if (topEvent->bndEntry != NULL) {
             celix_framework_bundleEntry_decreaseUseCount(topEvent->bndEntry);
         }
         free(topEvent->serviceName);
-        if (dynamiclyAllocatedEvent) {
-            free(topEvent);
-        }
-
-        celixThreadMutex_lock(&framework->dispatcher.mutex);
-        size = framework->dispatcher.eventQueueSize + celix_arrayList_size(framework->dispatcher.dynamicEventQueue);
-        celixThreadCondition_broadcast(&framework->dispatcher.cond);
-        celixThreadMutex_unlock(&framework->dispatcher.mutex);
+        celix_frameworkEventQueue_pop(loop->eventQueue);
+        celix_framework_notifyEventLoopProgress(framework);
+        topEvent = celix_frameworkEventQueue_peek(loop->eventQueue);
     }
 }
 
-static void *fw_eventDispatcher(void *fw) {
-    framework_pt framework = (framework_pt) fw;
+static void *fw_eventDispatcher(void *data) {
+    celix_framework_event_loop_t* loop = data;
+    framework_pt framework = loop->framework;
 
     celixThreadMutex_lock(&framework->dispatcher.mutex);
     bool active = framework->dispatcher.active;
     celixThreadMutex_unlock(&framework->dispatcher.mutex);
 
     while (active) {
-        fw_handleEvents(framework);
+        fw_handleEvents(loop);
         celixThreadMutex_lock(&framework->dispatcher.mutex);
         active = framework->dispatcher.active;
         celixThreadMutex_unlock(&framework->dispatcher.mutex);
     }
 
     //not active any more, last run for possible request leftovers
-    celixThreadMutex_lock(&framework->dispatcher.mutex);
-    bool needLastRun = framework->dispatcher.eventQueueSize > 0 || celix_arrayList_size(framework->dispatcher.dynamicEventQueue) > 0;
-    celixThreadMutex_unlock(&framework->dispatcher.mutex);
-    if (needLastRun) {
-        fw_handleEvents(framework);
+    while (celix_frameworkEventQueue_size(loop->eventQueue) > 0) {
+        fw_handleEvents(loop);
     }
 
     celixThread_exit(NULL);
@@ -1586,6 +1866,15 @@ long celix_framework_registerService(framework_t *fw, celix_bundle_t *bnd, const
     return serviceRegistration_getServiceId(reg);
 }
 
+celix_status_t celix_framework_registerServices(framework_t *fw, celix_bundle_t *bnd, celix_service_registry_batch_entry_t* entries, size_t nrOfEntries) {
+    long bndId = celix_bundle_getId(bnd);
+    celix_framework_bundle_entry_t *entry = celix_framework_bundleEntry_getBundleEntryAndIncreaseUseCount(fw, bndId);
+    celix_status_t status = celix_serviceRegistry_registerServices(fw->registry, bnd, entries, nrOfEntries);
+    celix_framework_bundleEntry_decreaseUseCount(entry);
+    framework_logIfError(fw->logger, status, NULL, "Cannot register batch of %zu services", nrOfEntries);
+    return status;
+}
+
 long celix_framework_registerServiceAsync(
         framework_t *fw,
         celix_bundle_t *bnd,
@@ -1642,30 +1931,34 @@ void celix_framework_unregisterAsync(celix_framework_t* fw, celix_bundle_t* bnd,
  *
  * This can be needed when a service is regsitered async and still on the event queue when an sync unregistration
  * is made.
+ * Only a register event which is still queued can be cancelled; the cancel state is set on the queued event itself.
+ * If the registration is already being processed by an event loop, this waits until the registration is done, so
+ * that the service can be unregistered the normal way.
  * @returns true if a service registration is cancelled.
  */
-static bool celix_framework_cancelServiceRegistrationIfPending(celix_framework_t* fw, celix_bundle_t* bnd, long serviceId) {
-    bool cancelled = false;
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    for (int i = 0; i < celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-        celix_framework_event_t *event = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-        if (event->type == CELIX_REGISTER_SERVICE_EVENT && event->registerServiceId == serviceId) {
-            event->cancelled = true;
-            cancelled = true;
-            break;
-        }
+static bool celix_framework_cancelServiceRegistrationIfPending(celix_framework_t* fw, celix_bundle_t* bnd __attribute__((unused)), long serviceId) {
+    if (__atomic_load_n(&fw->dispatcher.stats.nbRegister, __ATOMIC_ACQUIRE) == 0) {
+        return false;
     }
-    for (size_t i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-        size_t index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-        celix_framework_event_t *event = &fw->dispatcher.eventQueue[index];
-        if (event->type == CELIX_REGISTER_SERVICE_EVENT && event->registerServiceId == serviceId) {
-            event->cancelled = true;
-            cancelled = true;
-            break;
+
+    //note register events are always handled by the ordered event loop
+    celix_framework_event_loop_t* loop = celix_framework_getOrderedEventLoop(fw);
+    celix_framework_event_queue_cancel_result_e result = celix_frameworkEventQueue_cancel(loop->eventQueue, CELIX_REGISTER_SERVICE_EVENT, serviceId);
+    if (result == CELIX_FRAMEWORK_EVENT_QUEUE_CANCELLED) {
+        return true;
+    }
+
+    if (result == CELIX_FRAMEWORK_EVENT_QUEUE_PROCESSING && !celixThread_equals(celixThread_self(), loop->thread)) {
+        //registration in progress, wait till done and unregister the normal way.
+        celixThreadMutex_lock(&fw->dispatcher.mutex);
+        __atomic_add_fetch(&fw->dispatcher.nbWaiting, 1, __ATOMIC_SEQ_CST);
+        while (celix_frameworkEventQueue_contains(loop->eventQueue, celix_framework_matchRegisterEvent, &serviceId)) {
+            celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 1, 0);
         }
+        __atomic_sub_fetch(&fw->dispatcher.nbWaiting, 1, __ATOMIC_SEQ_CST);
+        celixThreadMutex_unlock(&fw->dispatcher.mutex);
     }
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
-    return cancelled;
+    return false;
 }
 
 void celix_framework_unregister(celix_framework_t* fw, celix_bundle_t* bnd, long serviceId) {
@@ -1674,98 +1967,43 @@ void celix_framework_unregister(celix_framework_t* fw, celix_bundle_t* bnd, long
     }
 }
 
-void celix_framework_waitForAsyncRegistration(framework_t *fw, long svcId) {
-    assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
-
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    bool registrationsInProgress = true;
-    while (registrationsInProgress) {
-        registrationsInProgress = false;
-        for (int i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-            int index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-            celix_framework_event_t* e = &fw->dispatcher.eventQueue[index];
-            if (e->type == CELIX_REGISTER_SERVICE_EVENT && e->registerServiceId == svcId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        for (int i = 0; !registrationsInProgress && i < celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-            celix_framework_event_t* e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-            if (e->type == CELIX_REGISTER_SERVICE_EVENT && e->registerServiceId == svcId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        if (registrationsInProgress) {
-            celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
+void celix_framework_unregisterServices(celix_framework_t* fw, celix_bundle_t* bnd, const long* serviceIds, size_t nrOfServiceIds) {
+    long* registeredIds = malloc(nrOfServiceIds * sizeof(*registeredIds));
+    size_t nrOfRegisteredIds = 0;
+    for (size_t i = 0; i < nrOfServiceIds; ++i) {
+        if (!celix_framework_cancelServiceRegistrationIfPending(fw, bnd, serviceIds[i])) {
+            registeredIds[nrOfRegisteredIds++] = serviceIds[i];
         }
     }
+    if (nrOfRegisteredIds > 0) {
+        celix_serviceRegistry_unregisterServices(fw->registry, bnd, registeredIds, nrOfRegisteredIds);
+    }
+    free(registeredIds);
+}
 
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+void celix_framework_waitForAsyncRegistration(framework_t *fw, long svcId) {
+    assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
+    celix_framework_waitForMatchingEvents(fw, celix_framework_matchRegisterEvent, &svcId);
 }
 
 void celix_framework_waitForAsyncUnregistration(framework_t *fw, long svcId) {
     assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
-
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    bool registrationsInProgress = true;
-    while (registrationsInProgress) {
-        registrationsInProgress = false;
-        for (int i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-            int index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-            celix_framework_event_t* e = &fw->dispatcher.eventQueue[index];
-            if (e->type == CELIX_UNREGISTER_SERVICE_EVENT && e->unregisterServiceId == svcId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        for (int i = 0; !registrationsInProgress && i < celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-            celix_framework_event_t* e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-            if (e->type == CELIX_UNREGISTER_SERVICE_EVENT && e->unregisterServiceId == svcId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        if (registrationsInProgress) {
-            celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
-        }
-    }
-
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+    celix_framework_waitForMatchingEvents(fw, celix_framework_matchUnregisterEvent, &svcId);
 }
 
 void celix_framework_waitForAsyncRegistrations(framework_t *fw, long bndId) {
     assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
-
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    bool registrationsInProgress = true;
-    while (registrationsInProgress) {
-        registrationsInProgress = false;
-        for (int i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-            int index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-            celix_framework_event_t* e = &fw->dispatcher.eventQueue[index];
-            if ((e->type == CELIX_REGISTER_SERVICE_EVENT || e->type == CELIX_UNREGISTER_SERVICE_EVENT) && e->bndEntry->bndId == bndId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        for (int i = 0; i < !registrationsInProgress && celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-            celix_framework_event_t* e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-            if ((e->type == CELIX_REGISTER_SERVICE_EVENT || e->type == CELIX_UNREGISTER_SERVICE_EVENT) && e->bndEntry->bndId == bndId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        if (registrationsInProgress) {
-            celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
-        }
-    }
-
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+    celix_framework_waitForMatchingEvents(fw, celix_framework_matchRegistrationEventForBundle, &bndId);
 }
 
 bool celix_framework_isCurrentThreadTheEventLoop(framework_t* fw) {
-    return celixThread_equals(celixThread_self(), fw->dispatcher.thread);
+    celix_thread_t self = celixThread_self();
+    for (size_t i = 0; i < fw->dispatcher.nrOfEventLoops; ++i) {
+        if (celixThread_equals(self, fw->dispatcher.eventLoops[i].thread)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 const char* celix_framework_getUUID(const celix_framework_t *fw) {
@@ -2130,16 +2368,19 @@ celix_status_t celix_framework_startBundleEntry(celix_framework_t* framework, ce
         case CELIX_BUNDLE_STATE_INSTALLED:
             bundle_getCurrentModule(bndEntry->bnd, &module);
             module_getSymbolicName(module, &name);
+            celixThreadMutex_lock(&framework->resolveLock);
             if (!module_isResolved(module)) {
                 wires = resolver_resolve(module);
                 if (wires == NULL) {
+                    celixThreadMutex_unlock(&framework->resolveLock);
                     celix_framework_bundleEntry_decreaseUseCount(bndEntry);
                     return CELIX_BUNDLE_EXCEPTION;
                 }
                 status = framework_markResolvedModules(framework, wires);
-                if (status != CELIX_SUCCESS) {
-                    break;
-                }
+            }
+            celixThreadMutex_unlock(&framework->resolveLock);
+            if (status != CELIX_SUCCESS) {
+                break;
             }
             /* no break */
         case CELIX_BUNDLE_STATE_RESOLVED:
@@ -2350,48 +2591,28 @@ void celix_framework_waitForEmptyEventQueue(celix_framework_t *fw) {
     assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
 
     celixThreadMutex_lock(&fw->dispatcher.mutex);
-    while (fw->dispatcher.eventQueueSize > 0 || celix_arrayList_size(fw->dispatcher.dynamicEventQueue) > 0) {
-        celixThreadCondition_wait(&fw->dispatcher.cond, &fw->dispatcher.mutex);
+    __atomic_add_fetch(&fw->dispatcher.nbWaiting, 1, __ATOMIC_SEQ_CST);
+    while (!celix_framework_areAllEventQueuesEmpty(fw)) {
+        celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
     }
+    __atomic_sub_fetch(&fw->dispatcher.nbWaiting, 1, __ATOMIC_SEQ_CST);
     celixThreadMutex_unlock(&fw->dispatcher.mutex);
 }
 
 void celix_framework_waitUntilNoEventsForBnd(celix_framework_t* fw, long bndId) {
     assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
-
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    bool eventInProgress = true;
-    while (eventInProgress) {
-        eventInProgress = false;
-        for (int i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-            int index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-            celix_framework_event_t* e = &fw->dispatcher.eventQueue[index];
-            if (e->bndEntry != NULL && e->bndEntry->bndId == bndId) {
-                eventInProgress = true;
-                break;
-            }
-        }
-        for (int i = 0; !eventInProgress && i < celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-            celix_framework_event_t* e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-            if (e->bndEntry != NULL && e->bndEntry->bndId == bndId) {
-                eventInProgress = true;
-                break;
-            }
-        }
-        if (eventInProgress) {
-            celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
-        }
-    }
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+    celix_framework_waitForMatchingEvents(fw, celix_framework_matchEventForBundle, &bndId);
 }
 
 void celix_framework_waitUntilNoPendingRegistration(celix_framework_t* fw)
 {
     assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
     celixThreadMutex_lock(&fw->dispatcher.mutex);
+    __atomic_add_fetch(&fw->dispatcher.nbWaiting, 1, __ATOMIC_SEQ_CST);
     while (__atomic_load_n(&fw->dispatcher.stats.nbRegister, __ATOMIC_RELAXED) > 0) {
-        celixThreadCondition_wait(&fw->dispatcher.cond, &fw->dispatcher.mutex);
+        celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
     }
+    __atomic_sub_fetch(&fw->dispatcher.nbWaiting, 1, __ATOMIC_SEQ_CST);
     celixThreadMutex_unlock(&fw->dispatcher.mutex);
 }
 
@@ -2399,7 +2620,7 @@ void celix_framework_setLogCallback(celix_framework_t* fw, void* logHandle, void
     celix_frameworkLogger_setLogCallback(fw->logger, logHandle, logFunction);
 }
 
-long celix_framework_fireGenericEvent(framework_t* fw, long eventId, long bndId, const char *eventName, void* processData, void (*processCallback)(void *data), void* doneData, void (*doneCallback)(void* doneData)) {
+static long celix_framework_fireGenericEventInternal(framework_t* fw, bool parallel, long eventId, long bndId, const char *eventName, void* processData, void (*processCallback)(void *data), void* doneData, void (*doneCallback)(void* doneData)) {
     celix_framework_bundle_entry_t* bndEntry = NULL;
     if (bndId >=0) {
         bndEntry = celix_framework_bundleEntry_getBundleEntryAndIncreaseUseCount(fw, bndId);
@@ -2419,6 +2640,7 @@ long celix_framework_fireGenericEvent(framework_t* fw, long eventId, long bndId,
     event.bndEntry = bndEntry;
     event.genericEventId = eventId;
     event.genericEventName = eventName;
+    event.genericParallel = parallel;
     event.genericProcessData = processData;
     event.genericProcess = processCallback;
     event.doneData = doneData;
@@ -2429,37 +2651,21 @@ long celix_framework_fireGenericEvent(framework_t* fw, long eventId, long bndId,
     return eventId;
 }
 
+long celix_framework_fireGenericEvent(framework_t* fw, long eventId, long bndId, const char *eventName, void* processData, void (*processCallback)(void *data), void* doneData, void (*doneCallback)(void* doneData)) {
+    return celix_framework_fireGenericEventInternal(fw, false, eventId, bndId, eventName, processData, processCallback, doneData, doneCallback);
+}
+
+long celix_framework_fireParallelGenericEvent(framework_t* fw, long eventId, long bndId, const char *eventName, void* processData, void (*processCallback)(void *data), void* doneData, void (*doneCallback)(void* doneData)) {
+    return celix_framework_fireGenericEventInternal(fw, true, eventId, bndId, eventName, processData, processCallback, doneData, doneCallback);
+}
+
 long celix_framework_nextEventId(framework_t *fw) {
     return __atomic_fetch_add(&fw->nextGenericEventId, 1, __ATOMIC_RELAXED);
 }
 
 void celix_framework_waitForGenericEvent(framework_t *fw, long eventId) {
     assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
-
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    bool eventInProgress = true;
-    while (eventInProgress) {
-        eventInProgress = false;
-        for (int i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-            int index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-            celix_framework_event_t* e = &fw->dispatcher.eventQueue[index];
-            if (e->type == CELIX_GENERIC_EVENT && e->genericEventId == eventId) {
-                eventInProgress = true;
-                break;
-            }
-        }
-        for (int i = 0; !eventInProgress && i < celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-            celix_framework_event_t* e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-            if (e->type == CELIX_GENERIC_EVENT && e->genericEventId == eventId) {
-                eventInProgress = true;
-                break;
-            }
-        }
-        if (eventInProgress) {
-            celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
-        }
-    }
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+    celix_framework_waitForMatchingEvents(fw, celix_framework_matchGenericEvent, &eventId);
 }
 
 void celix_framework_waitForStop(celix_framework_t *framework) {
@@ -45,8 +45,17 @@
 #define CELIX_FRAMEWORK_DEFAULT_STATIC_EVENT_QUEUE_SIZE 1024
 #endif
 
+#ifndef CELIX_FRAMEWORK_DEFAULT_EVENT_DISPATCHER_THREADS
+#define CELIX_FRAMEWORK_DEFAULT_EVENT_DISPATCHER_THREADS 1
+#endif
+
+#ifndef CELIX_FRAMEWORK_DEFAULT_AUTO_START_THREADS
+#define CELIX_FRAMEWORK_DEFAULT_AUTO_START_THREADS 1
+#endif
+
 #define CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE_DEFAULT false
 #define CELIX_FRAMEWORK_CACHE_USE_TMP_DIR_DEFAULT false
+#define CELIX_FRAMEWORK_CACHE_USE_BUNDLE_STORE_DEFAULT false
 #define CELIX_FRAMEWORK_FRAMEWORK_CACHE_DIR_DEFAULT ".cache"
 
 typedef struct celix_framework_bundle_entry {
@@ -99,6 +108,7 @@ struct celix_framework_event {
     //for the generic event
     long genericEventId;
     const char* genericEventName;
+    bool genericParallel; //true if the generic event is handled by the event loop of its bundle
     void *genericProcessData;
     void (*genericProcess)(void*);
 
@@ -122,6 +132,20 @@ typedef struct celix_framework_bundle_lifecycle_handler {
     enum celix_bundle_lifecycle_command command;
 } celix_framework_bundle_lifecycle_handler_t;
 
+/**
+ * @brief A framework event loop; a thread which handles the events of its own event queue.
+ *
+ * All events, except parallel generic events, are handled by the first event loop. Parallel generic events are
+ * handled by the event loop of their bundle, so the parallel generic events of a single bundle are handled in order.
+ */
+typedef struct celix_framework_event_loop {
+    celix_framework_t* framework;
+    celix_thread_t thread;
+    celix_thread_cond_t cond; //used to wake up the (idle) event loop thread, protected by the dispatcher mutex
+    struct celix_framework_event_queue* eventQueue; //lock-free multi-producer/single-consumer event queue
+    bool idle; //atomic, true if the event loop thread is (about to start) waiting for new events
+} celix_framework_event_loop_t;
+
 struct celix_framework {
     celix_bundle_t *bundle;
     long bundleId; //the bundle id of the framework (normally 0)
@@ -134,6 +158,7 @@ struct celix_framework {
     celix_thread_mutex_t bundleListenerLock;
 
     long currentBundleId; //atomic
+    celix_thread_mutex_t resolveLock; //serializes resolving bundles, so that bundles started in parallel do not resolve the same module twice
     celix_service_registry_t *registry;
     celix_bundle_cache_t* cache;
 
@@ -157,15 +182,12 @@ struct celix_framework {
 
 
     struct {
-        celix_thread_cond_t cond;
-        celix_thread_t thread;
-        celix_thread_mutex_t mutex; //protects below
+        celix_thread_cond_t cond; //used to notify threads waiting for event loop progress
+        celix_thread_mutex_t mutex; //protects active
         bool active;
-        celix_framework_event_t* eventQueue; //ring buffer
-        int eventQueueCap;
-        int eventQueueSize;
-        int eventQueueFirstEntry;
-        celix_array_list_t *dynamicEventQueue; //entry = celix_framework_event_t*. Used when the eventQueue is full
+        size_t nrOfEventLoops; //configured with CELIX_FRAMEWORK_EVENT_DISPATCHER_THREADS
+        celix_framework_event_loop_t* eventLoops; //first event loop handles all events except parallel generic events (bundle id % nrOfEventLoops)
+        int nbWaiting; //atomic, number of threads waiting on the dispatcher cond for event loop progress
         struct {
             int nbFramework; // number of pending framework events
             int nbBundle; // number of pending bundle events
@@ -293,6 +315,12 @@ bundle_pt framework_getBundleById(framework_pt framework, long id);
  */
 long celix_framework_registerService(framework_t *fw, celix_bundle_t *bnd, const char* serviceName, void* svc, celix_service_factory_t *factory, celix_properties_t *properties);
 
+/**
+ * register services and/or service factories in a single batch.
+ * The service ids are set in the registration field of the provided entries.
+ */
+celix_status_t celix_framework_registerServices(framework_t *fw, celix_bundle_t *bnd, celix_service_registry_batch_entry_t* entries, size_t nrOfEntries);
+
 /**
  * register service or service factory async. Will return a svc id directly and return a service registration in a callback.
  * callback is called on the fw event loop thread
@@ -319,6 +347,11 @@ void celix_framework_unregisterAsync(celix_framework_t* fw, celix_bundle_t* bnd,
  */
 void celix_framework_unregister(celix_framework_t* fw, celix_bundle_t* bnd, long serviceId);
 
+/**
+ * Unregister services in a single batch
+ */
+void celix_framework_unregisterServices(celix_framework_t* fw, celix_bundle_t* bnd, const long* serviceIds, size_t nrOfServiceIds);
+
 /**
  * Wait til all service registration or unregistration events for a specific bundle are no longer present in the event queue.
  */
@@ -433,4 +466,18 @@ celix_status_t celix_framework_uninstallBundleEntry(celix_framework_t* fw, celix
  */
 celix_status_t celix_framework_updateBundleEntry(celix_framework_t* fw, celix_framework_bundle_entry_t* bndEntry, const char* updatedBundleUrl);
 
+/**
+ * @brief Returns the number of threads to use for installing and starting the bundles of a auto start level.
+ * Configured with CELIX_FRAMEWORK_AUTO_START_THREADS.
+ */
+size_t celix_framework_getNrOfAutoStartThreads(celix_framework_t* fw);
+
+/**
+ * @brief Run nrOfTasks tasks on at most nrOfThreads worker threads and wait till all tasks are done.
+ *
+ * The task function is called once for every task index. If nrOfThreads or nrOfTasks is <= 1, the tasks are
+ * run on the calling thread.
+ */
+void celix_framework_runTasksInParallel(celix_framework_t* fw, size_t nrOfThreads, size_t nrOfTasks, void* data, void (*task)(void* data, size_t taskIndex));
+
 #endif /* FRAMEWORK_PRIVATE_H_ */
@@ -32,6 +32,7 @@
 #include "linked_list_iterator.h"
 #include "bundle.h"
 #include "celix_log.h"
+#include "celix_threads.h"
 
 struct capabilityList {
     char * serviceName;
@@ -54,13 +55,16 @@ linked_list_pt m_modules = NULL;
 linked_list_pt m_unresolvedServices = NULL;
 // List containing capability_t_LISTs
 linked_list_pt m_resolvedServices = NULL;
+//note the module lists are shared by all frameworks in the process, bundles can be installed/resolved in parallel
+static celix_thread_once_t resolverMutexOnce = CELIX_THREAD_ONCE_INIT;
+static celix_thread_mutex_t resolverMutex;
 
 int resolver_populateCandidatesMap(hash_map_pt candidatesMap, module_pt targetModule);
 capability_list_pt resolver_getCapabilityList(linked_list_pt list, const char* name);
 void resolver_removeInvalidCandidate(module_pt module, hash_map_pt candidates, linked_list_pt invalid);
 linked_list_pt resolver_populateWireMap(hash_map_pt candidates, module_pt importer, linked_list_pt wireMap);
 
-linked_list_pt resolver_resolve(module_pt root) {
+static linked_list_pt resolver_resolveInternal(module_pt root) {
     hash_map_pt candidatesMap = NULL;
     linked_list_pt wireMap = NULL;
     linked_list_pt resolved = NULL;
@@ -245,7 +249,7 @@ void resolver_removeInvalidCandidate(module_pt invalidModule, hash_map_pt candid
     }
 }
 
-void resolver_addModule(module_pt module) {
+static void resolver_addModuleInternal(module_pt module) {
 
     if (m_modules == NULL) {
         linkedList_create(&m_modules);
@@ -287,7 +291,7 @@ void resolver_addModule(module_pt module) {
     }
 }
 
-void resolver_removeModule(module_pt module) {
+static void resolver_removeModuleInternal(module_pt module) {
     if (m_modules == NULL) {
         return;
     }
@@ -344,7 +348,7 @@ void resolver_removeModule(module_pt module) {
     }
 }
 
-void resolver_moduleResolved(module_pt module) {
+static void resolver_moduleResolvedInternal(module_pt module) {
 
     if (module_isResolved(module)) {
         linked_list_pt capsCopy = NULL;
@@ -497,3 +501,37 @@ linked_list_pt resolver_populateWireMap(hash_map_pt candidates, module_pt import
 
     return wireMap;
 }
+
+static void resolver_createMutex(void) {
+    celixThreadMutex_create(&resolverMutex, NULL);
+}
+
+static void resolver_lock(void) {
+    celixThread_once(&resolverMutexOnce, resolver_createMutex);
+    celixThreadMutex_lock(&resolverMutex);
+}
+
+linked_list_pt resolver_resolve(module_pt root) {
+    resolver_lock();
+    linked_list_pt resolved = resolver_resolveInternal(root);
+    celixThreadMutex_unlock(&resolverMutex);
+    return resolved;
+}
+
+void resolver_addModule(module_pt module) {
+    resolver_lock();
+    resolver_addModuleInternal(module);
+    celixThreadMutex_unlock(&resolverMutex);
+}
+
+void resolver_removeModule(module_pt module) {
+    resolver_lock();
+    resolver_removeModuleInternal(module);
+    celixThreadMutex_unlock(&resolverMutex);
+}
+
+void resolver_moduleResolved(module_pt module) {
+    resolver_lock();
+    resolver_moduleResolvedInternal(module);
+    celixThreadMutex_unlock(&resolverMutex);
+}
@@ -131,14 +131,10 @@ bool serviceRegistration_isValid(service_registration_pt registration) {
 
 celix_status_t serviceRegistration_unregister(service_registration_pt registration) {
 	celix_status_t status = CELIX_SUCCESS;
-    bool unregistering = false;
     registry_callback_t callback;
     callback.unregister = NULL;
 
-    // Without any further need of synchronization between callers, __ATOMIC_RELAXED should be sufficient to guarantee that only one caller has a chance to run.
-    // Strong form of compare-and-swap is used to avoid spurious failure.
-    if(!__atomic_compare_exchange_n(&registration->isUnregistering, &unregistering /* expected*/ , true /* desired */,
-                                    false /* weak */, __ATOMIC_RELAXED/*success memorder*/, __ATOMIC_RELAXED/*failure memorder*/)) {
+    if (!serviceRegistration_markUnregistering(registration)) {
         status = CELIX_ILLEGAL_STATE;
     } else {
         callback = registration->callback;
@@ -151,6 +147,14 @@ celix_status_t serviceRegistration_unregister(service_registration_pt registrati
 	return status;
 }
 
+bool serviceRegistration_markUnregistering(service_registration_pt registration) {
+    bool unregistering = false;
+    // Without any further need of synchronization between callers, __ATOMIC_RELAXED should be sufficient to guarantee that only one caller has a chance to run.
+    // Strong form of compare-and-swap is used to avoid spurious failure.
+    return __atomic_compare_exchange_n(&registration->isUnregistering, &unregistering /* expected*/ , true /* desired */,
+                                       false /* weak */, __ATOMIC_RELAXED/*success memorder*/, __ATOMIC_RELAXED/*failure memorder*/);
+}
+
 celix_status_t serviceRegistration_getService(service_registration_pt registration, bundle_pt bundle, const void** service) {
     celix_status_t status = CELIX_SUCCESS;
     celixThreadRwlock_readLock(&registration->lock);
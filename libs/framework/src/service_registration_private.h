@@ -31,6 +31,17 @@ enum celix_service_type {
 	CELIX_DEPRECATED_FACTORY_SERVICE
 };
 
+/**
+ * @brief The service registry index lists in which a service registration keeps its position.
+ */
+enum celix_service_registration_index_slot {
+    CELIX_SERVICE_REGISTRATION_NO_INDEX_SLOT = -1, //for index lists without stored positions
+    CELIX_SERVICE_REGISTRATION_INDEX_SLOT_ALL = 0, //index.all
+    CELIX_SERVICE_REGISTRATION_INDEX_SLOT_NAME = 1, //index.byName bucket
+    CELIX_SERVICE_REGISTRATION_INDEX_SLOT_OBJECT_CLASS = 2, //objectClass bucket of index.byAttribute
+    CELIX_SERVICE_REGISTRATION_NR_OF_INDEX_SLOTS = 3
+};
+
 struct serviceRegistration {
     struct celix_ref refCount;
     registry_callback_t callback; // read-only
@@ -42,6 +53,11 @@ struct serviceRegistration {
 
     bool isUnregistering;
 
+    //positions in the service registry index lists, indexed by enum celix_service_registration_index_slot, so that a
+    //registration can be removed from these lists in O(1). Only used by the service registry, protected by the
+    //registry lock.
+    int indexPos[CELIX_SERVICE_REGISTRATION_NR_OF_INDEX_SLOTS];
+
     enum celix_service_type svcType; // read-only
     union {
         const void * svcObj;
@@ -59,6 +75,11 @@ void serviceRegistration_retain(service_registration_pt registration);
 void serviceRegistration_release(service_registration_pt registration);
 
 bool serviceRegistration_isValid(service_registration_pt registration);
+/**
+ * @brief Marks the registration as unregistering.
+ * @return true if the registration is marked by this call, false if it was already marked as unregistering.
+ */
+bool serviceRegistration_markUnregistering(service_registration_pt registration);
 void serviceRegistration_invalidate(service_registration_pt registration);
 
 celix_status_t serviceRegistration_getService(service_registration_pt registration, bundle_pt bundle, const void **service);
@@ -29,6 +29,7 @@
 #include "celix_constants.h"
 #include "service_reference_private.h"
 #include "framework_private.h"
+#include "celix_convert_utils.h"
 
 static celix_status_t serviceRegistry_registerServiceInternal(service_registry_pt registry, bundle_pt bundle, const char* serviceName, const void * serviceObject, properties_pt dictionary, long reservedId, enum celix_service_type svcType, service_registration_pt *registration);
 static celix_status_t serviceRegistry_unregisterService(service_registry_pt registry, bundle_pt bundle, service_registration_pt registration);
@@ -39,6 +40,7 @@ static void serviceRegistry_logWarningServiceReferenceUsageCount(service_registr
 static celix_status_t serviceRegistry_getUsingBundles(service_registry_pt registry, service_registration_pt reg, array_list_pt *bundles);
 static celix_status_t serviceRegistry_getServiceReference_internal(service_registry_pt registry, bundle_pt owner, service_registration_pt registration, service_reference_pt *out);
 static void celix_serviceRegistry_serviceChanged(celix_service_registry_t *registry, celix_service_event_type_t eventType, service_registration_pt registration);
+static void celix_serviceRegistry_servicesChanged(celix_service_registry_t *registry, celix_service_event_type_t eventType, const celix_array_list_t* registrations);
 static void serviceRegistry_callHooksForListenerFilter(service_registry_pt registry, celix_bundle_t *owner, const celix_filter_t *filter, bool removed);
 
     static celix_service_registry_listener_hook_entry_t* celix_createHookEntry(long svcId, celix_listener_hook_service_t*);
@@ -54,6 +56,28 @@ static void celix_increasePendingRegisteredEvent(celix_service_registry_t *regis
 static void celix_decreasePendingRegisteredEvent(celix_service_registry_t *registry, long svcId);
 static void celix_waitForPendingRegisteredEvents(celix_service_registry_t *registry, long svcId);
 
+/**
+ * @brief The candidate registrations for a service lookup, as found using the service registry indexes.
+ *
+ * The candidates are either a (borrowed) list of registrations or - for a service id lookup - a single registration.
+ * Only valid as long as the registry lock is held.
+ */
+typedef struct celix_service_registry_candidates {
+    const celix_array_list_t* registrations;
+    service_registration_t* registration;
+    int size;
+} celix_service_registry_candidates_t;
+
+static void celix_serviceRegistry_createIndexes(celix_service_registry_t* registry);
+static void celix_serviceRegistry_destroyIndexes(celix_service_registry_t* registry);
+static void celix_serviceRegistry_addToIndexes(celix_service_registry_t* registry, service_registration_t* registration);
+static void celix_serviceRegistry_removeFromIndexes(celix_service_registry_t* registry, service_registration_t* registration);
+static void celix_serviceRegistry_addToListenerIndex(celix_service_registry_t* registry, celix_service_registry_service_listener_entry_t* entry);
+static void celix_serviceRegistry_removeFromListenerIndex(celix_service_registry_t* registry, celix_service_registry_service_listener_entry_t* entry);
+static const char* celix_serviceRegistry_findMandatoryEqualsValue(const celix_filter_t* filter, const char* attribute, bool plainStringOnly);
+static celix_service_registry_candidates_t celix_serviceRegistry_findCandidates(celix_service_registry_t* registry, const char* serviceName, const celix_filter_t* filter);
+static service_registration_t* celix_serviceRegistry_getCandidate(const celix_service_registry_candidates_t* candidates, int index);
+
 celix_service_registry_t* celix_serviceRegistry_create(framework_pt framework) {
     celix_service_registry_t* reg = calloc(1, sizeof(*reg));
 
@@ -65,6 +89,7 @@ celix_service_registry_t* celix_serviceRegistry_create(framework_pt framework) {
     reg->serviceRegistrations = hashMap_create(NULL, NULL, NULL, NULL);
     reg->framework = framework;
     reg->nextServiceId = 1L;
+    reg->nextBatchId = 0L;
     reg->serviceReferences = hashMap_create(NULL, NULL, NULL, NULL);
 
     reg->listenerHooks = celix_arrayList_create();
@@ -75,6 +100,7 @@ celix_service_registry_t* celix_serviceRegistry_create(framework_pt framework) {
     celixThreadRwlock_create(&reg->lock, NULL);
     reg->pendingRegisterEvents.map = hashMap_create(NULL, NULL, NULL, NULL);
 
+    celix_serviceRegistry_createIndexes(reg);
 
 	return reg;
 }
@@ -114,6 +140,7 @@ void celix_serviceRegistry_destroy(celix_service_registry_t* registry) {
 
     assert(size == 0);
     hashMap_destroy(registry->serviceRegistrations, false, false);
+    celix_serviceRegistry_destroyIndexes(registry);
 
     //destroy service references (double) map);
     size = hashMap_size(registry->serviceReferences);
@@ -175,40 +202,81 @@ celix_status_t serviceRegistry_registerServiceFactory(service_registry_pt regist
     return serviceRegistry_registerServiceInternal(registry, bundle, serviceName, (const void *) factory, dictionary, 0 /*TODO*/, CELIX_DEPRECATED_FACTORY_SERVICE, registration);
 }
 
-static celix_status_t serviceRegistry_registerServiceInternal(service_registry_pt registry, bundle_pt bundle, const char* serviceName, const void * serviceObject, properties_pt dictionary, long reservedId, enum celix_service_type svcType, service_registration_pt *registration) {
-    array_list_pt regs;
+static service_registration_t* serviceRegistry_createRegistration(service_registry_pt registry, bundle_pt bundle, const char* serviceName, const void * serviceObject, properties_pt dictionary, long reservedId, enum celix_service_type svcType) {
+    service_registration_t* registration;
     long svcId = reservedId > 0 ? reservedId : celix_serviceRegistry_nextSvcId(registry);
 
     celix_properties_setLong(dictionary, CELIX_FRAMEWORK_SERVICE_BUNDLE_ID, celix_bundle_getId(bundle));
 
     if (svcType == CELIX_DEPRECATED_FACTORY_SERVICE) {
         celix_properties_set(dictionary, CELIX_FRAMEWORK_SERVICE_SCOPE, CELIX_FRAMEWORK_SERVICE_SCOPE_BUNDLE);
-        *registration = serviceRegistration_createServiceFactory(registry->callback, bundle, serviceName,
+        registration = serviceRegistration_createServiceFactory(registry->callback, bundle, serviceName,
                                                                  svcId, serviceObject,
                                                                  dictionary);
     } else if (svcType == CELIX_FACTORY_SERVICE) {
         celix_properties_set(dictionary, CELIX_FRAMEWORK_SERVICE_SCOPE, CELIX_FRAMEWORK_SERVICE_SCOPE_BUNDLE);
-        *registration = celix_serviceRegistration_createServiceFactory(registry->callback, bundle, serviceName, svcId, (celix_service_factory_t*)serviceObject, dictionary);
+        registration = celix_serviceRegistration_createServiceFactory(registry->callback, bundle, serviceName, svcId, (celix_service_factory_t*)serviceObject, dictionary);
     } else { //plain
         celix_properties_set(dictionary, CELIX_FRAMEWORK_SERVICE_SCOPE, CELIX_FRAMEWORK_SERVICE_SCOPE_SINGLETON);
-        *registration = serviceRegistration_create(registry->callback, bundle, serviceName, svcId, serviceObject, dictionary);
+        registration = serviceRegistration_create(registry->callback, bundle, serviceName, svcId, serviceObject, dictionary);
     }
     //printf("Registering service %li with name %s\n", svcId, serviceName);
     if (strcmp(OSGI_FRAMEWORK_LISTENER_HOOK_SERVICE_NAME, serviceName) == 0) {
-        serviceRegistry_addHooks(registry, serviceName, serviceObject, *registration);
+        serviceRegistry_addHooks(registry, serviceName, serviceObject, registration);
     }
+    return registration;
+}
 
-	celixThreadRwlock_writeLock(&registry->lock);
-	regs = (array_list_pt) hashMap_get(registry->serviceRegistrations, bundle);
-	if (regs == NULL) {
-		regs = NULL;
-		arrayList_create(&regs);
+//only call after locked registry RWlock
+static void serviceRegistry_addRegistration(service_registry_pt registry, bundle_pt bundle, service_registration_t* registration) {
+    array_list_pt regs = (array_list_pt) hashMap_get(registry->serviceRegistrations, bundle);
+    if (regs == NULL) {
+        arrayList_create(&regs);
         hashMap_put(registry->serviceRegistrations, bundle, regs);
     }
-	arrayList_add(regs, *registration);
+    arrayList_add(regs, registration);
+    celix_serviceRegistry_addToIndexes(registry, registration);
 
     //update pending register event
-    celix_increasePendingRegisteredEvent(registry, svcId);
+    celix_increasePendingRegisteredEvent(registry, registration->serviceId);
+}
+
+//only call after locked registry RWlock
+static void serviceRegistry_removeRegistration(service_registry_pt registry, bundle_pt bundle, service_registration_t* registration) {
+    celix_array_list_t* regs = (celix_array_list_t*) hashMap_get(registry->serviceRegistrations, bundle);
+    if (regs != NULL) {
+        arrayList_removeElement(regs, registration);
+        int size = arrayList_size(regs);
+        if (size == 0) {
+            celix_arrayList_destroy(regs);
+            hashMap_remove(registry->serviceRegistrations, bundle);
+        }
+    }
+    celix_serviceRegistry_removeFromIndexes(registry, registration);
+}
+
+//only call after locked registry RWlock
+static void serviceRegistry_invalidateRegistration(service_registry_pt registry, service_registration_t* registration) {
+    //invalidate service references
+    hash_map_iterator_pt iter = hashMapIterator_create(registry->serviceReferences);
+    while (hashMapIterator_hasNext(iter)) {
+        hash_map_pt refsMap = hashMapIterator_nextValue(iter);
+        service_reference_pt ref = refsMap != NULL ?
+                                   hashMap_get(refsMap, (void*)registration->serviceId) : NULL;
+        if (ref != NULL) {
+            serviceReference_invalidateCache(ref);
+        }
+    }
+    hashMapIterator_destroy(iter);
+    serviceRegistration_invalidate(registration);
+}
+
+static celix_status_t serviceRegistry_registerServiceInternal(service_registry_pt registry, bundle_pt bundle, const char* serviceName, const void * serviceObject, properties_pt dictionary, long reservedId, enum celix_service_type svcType, service_registration_pt *registration) {
+    *registration = serviceRegistry_createRegistration(registry, bundle, serviceName, serviceObject, dictionary, reservedId, svcType);
+    long svcId = (*registration)->serviceId;
+
+    celixThreadRwlock_writeLock(&registry->lock);
+    serviceRegistry_addRegistration(registry, bundle, *registration);
     celixThreadRwlock_unlock(&registry->lock);
 
 
@@ -225,9 +293,6 @@ static celix_status_t serviceRegistry_registerServiceInternal(service_registry_p
 }
 
 static celix_status_t serviceRegistry_unregisterService(service_registry_pt registry, bundle_pt bundle, service_registration_pt registration) {
-	// array_list_t clients;
-	celix_array_list_t *regs;
-
     //fprintf(stderr, "REG: Unregistering service registration with pointer %p\n", registration);
 
     long svcId = serviceRegistration_getServiceId(registration);
@@ -240,15 +305,7 @@ static celix_status_t serviceRegistry_unregisterService(service_registry_pt regi
     }
 
 	celixThreadRwlock_writeLock(&registry->lock);
-	regs = (celix_array_list_t*) hashMap_get(registry->serviceRegistrations, bundle);
-	if (regs != NULL) {
-		arrayList_removeElement(regs, registration);
-        int size = arrayList_size(regs);
-        if (size == 0) {
-            celix_arrayList_destroy(regs);
-            hashMap_remove(registry->serviceRegistrations, bundle);
-        }
-	}
+    serviceRegistry_removeRegistration(registry, bundle, registration);
 	celixThreadRwlock_unlock(&registry->lock);
 
 
@@ -258,18 +315,7 @@ static celix_status_t serviceRegistry_unregisterService(service_registry_pt regi
     celix_serviceRegistry_serviceChanged(registry, OSGI_FRAMEWORK_SERVICE_EVENT_UNREGISTERING, registration);
 
     celixThreadRwlock_readLock(&registry->lock);
-    //invalidate service references
-    hash_map_iterator_pt iter = hashMapIterator_create(registry->serviceReferences);
-    while (hashMapIterator_hasNext(iter)) {
-        hash_map_pt refsMap = hashMapIterator_nextValue(iter);
-        service_reference_pt ref = refsMap != NULL ?
-                                   hashMap_get(refsMap, (void*)registration->serviceId) : NULL;
-        if (ref != NULL) {
-            serviceReference_invalidateCache(ref);
-        }
-    }
-    hashMapIterator_destroy(iter);
-    serviceRegistration_invalidate(registration);
+    serviceRegistry_invalidateRegistration(registry, registration);
 	celixThreadRwlock_unlock(&registry->lock);
     serviceRegistration_release(registration);
 
@@ -324,7 +370,6 @@ static celix_status_t serviceRegistry_getServiceReference_internal(service_regis
 
 celix_status_t serviceRegistry_getServiceReferences(service_registry_pt registry, bundle_pt owner, const char *serviceName, filter_pt filter, array_list_pt *out) {
 	celix_status_t status;
-	hash_map_iterator_pt iterator;
     array_list_pt references = NULL;
 	array_list_pt matchingRegistrations = NULL;
     bool matchResult;
@@ -333,44 +378,39 @@ celix_status_t serviceRegistry_getServiceReferences(service_registry_pt registry
     status = CELIX_DO_IF(status, arrayList_create(&matchingRegistrations));
 
     celixThreadRwlock_readLock(&registry->lock);
-	iterator = hashMapIterator_create(registry->serviceRegistrations);
-	while (status == CELIX_SUCCESS && hashMapIterator_hasNext(iterator)) {
-		array_list_pt regs = (array_list_pt) hashMapIterator_nextValue(iterator);
-		unsigned int regIdx;
-		for (regIdx = 0; (regs != NULL) && regIdx < arrayList_size(regs); regIdx++) {
-			service_registration_pt registration = (service_registration_pt) arrayList_get(regs, regIdx);
-			properties_pt props = NULL;
-
-			status = serviceRegistration_getProperties(registration, &props);
-			if (status == CELIX_SUCCESS) {
-				bool matched = false;
+    celix_service_registry_candidates_t candidates = celix_serviceRegistry_findCandidates(registry, serviceName, filter);
+    for (int candidateIdx = 0; status == CELIX_SUCCESS && candidateIdx < candidates.size; ++candidateIdx) {
+		service_registration_pt registration = celix_serviceRegistry_getCandidate(&candidates, candidateIdx);
+		properties_pt props = NULL;
+
+		status = serviceRegistration_getProperties(registration, &props);
+		if (status == CELIX_SUCCESS) {
+			bool matched = false;
+			matchResult = false;
+			if (filter != NULL) {
+				filter_match(filter, props, &matchResult);
+			}
+			if ((serviceName == NULL) && ((filter == NULL) || matchResult)) {
+				matched = true;
+			} else if (serviceName != NULL) {
+				const char *className = NULL;
 				matchResult = false;
+				serviceRegistration_getServiceName(registration, &className);
 				if (filter != NULL) {
 					filter_match(filter, props, &matchResult);
 				}
-				if ((serviceName == NULL) && ((filter == NULL) || matchResult)) {
+				if ((strcmp(className, serviceName) == 0) && ((filter == NULL) || matchResult)) {
 					matched = true;
-				} else if (serviceName != NULL) {
-					const char *className = NULL;
-					matchResult = false;
-					serviceRegistration_getServiceName(registration, &className);
-					if (filter != NULL) {
-						filter_match(filter, props, &matchResult);
-					}
-					if ((strcmp(className, serviceName) == 0) && ((filter == NULL) || matchResult)) {
-						matched = true;
-					}
-				}
-				if (matched) {
-                    // assert(serviceRegistration_isValid(registration));
-                    serviceRegistration_retain(registration);
-                    arrayList_add(matchingRegistrations, registration);
 				}
 			}
+			if (matched) {
+                // assert(serviceRegistration_isValid(registration));
+                serviceRegistration_retain(registration);
+                arrayList_add(matchingRegistrations, registration);
+			}
 		}
 	}
     celixThreadRwlock_unlock(&registry->lock);
-	hashMapIterator_destroy(iterator);
 
     if (status == CELIX_SUCCESS) {
         unsigned int i;
@@ -734,6 +774,41 @@ celix_serviceRegistry_registerService(
     return serviceRegistry_registerServiceInternal(reg, (celix_bundle_t*)bnd, serviceName, (const void *) service, props, reserveId, CELIX_PLAIN_SERVICE, registration);
 }
 
+celix_status_t celix_serviceRegistry_registerServices(
+        celix_service_registry_t* registry,
+        const celix_bundle_t* bnd,
+        celix_service_registry_batch_entry_t* entries,
+        size_t nrOfEntries) {
+    celix_bundle_t* bundle = (celix_bundle_t*)bnd;
+    celix_array_list_t* registrations = celix_arrayList_create();
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        celix_service_registry_batch_entry_t* entry = &entries[i];
+        entry->registration = serviceRegistry_createRegistration(
+                registry,
+                bundle,
+                entry->serviceName,
+                entry->factory != NULL ? (const void*)entry->factory : (const void*)entry->service,
+                entry->properties,
+                entry->reservedId,
+                entry->factory != NULL ? CELIX_FACTORY_SERVICE : CELIX_PLAIN_SERVICE);
+        celix_arrayList_add(registrations, entry->registration);
+    }
+
+    celixThreadRwlock_writeLock(&registry->lock);
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        serviceRegistry_addRegistration(registry, bundle, entries[i].registration);
+    }
+    celixThreadRwlock_unlock(&registry->lock);
+
+    //note see serviceRegistry_registerServiceInternal for the handling of the pending registered events
+    celix_serviceRegistry_servicesChanged(registry, OSGI_FRAMEWORK_SERVICE_EVENT_REGISTERED, registrations);
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        celix_decreasePendingRegisteredEvent(registry, entries[i].registration->serviceId);
+    }
+    celix_arrayList_destroy(registrations);
+    return CELIX_SUCCESS;
+}
+
 static celix_service_registry_listener_hook_entry_t* celix_createHookEntry(long svcId, celix_listener_hook_service_t *hook) {
     celix_service_registry_listener_hook_entry_t* entry = calloc(1, sizeof(*entry));
     entry->svcId = svcId;
@@ -782,17 +857,14 @@ static void celix_decreaseCountHook(celix_service_registry_listener_hook_entry_t
 
 static void celix_increaseCountServiceListener(celix_service_registry_service_listener_entry_t *entry) {
     if (entry != NULL) {
-        celixThreadMutex_lock(&entry->mutex);
-        entry->useCount += 1;
-        celixThreadCondition_broadcast(&entry->cond);
-        celixThreadMutex_unlock(&entry->mutex);
+        __atomic_add_fetch(&entry->useCount, 1, __ATOMIC_RELAXED);
     }
 }
 
 static void celix_decreaseCountServiceListener(celix_service_registry_service_listener_entry_t *entry) {
-    if (entry != NULL) {
+    if (entry != NULL && __atomic_sub_fetch(&entry->useCount, 1, __ATOMIC_ACQ_REL) == 0) {
+        //note locking the mutex ensures the broadcast is not lost for a waiter which just checked the use count
         celixThreadMutex_lock(&entry->mutex);
-        entry->useCount -= 1;
         celixThreadCondition_broadcast(&entry->cond);
         celixThreadMutex_unlock(&entry->mutex);
     }
@@ -800,7 +872,7 @@ static void celix_decreaseCountServiceListener(celix_service_registry_service_li
 
 static inline void celix_waitAndDestroyServiceListener(celix_service_registry_service_listener_entry_t *entry) {
     celixThreadMutex_lock(&entry->mutex);
-    while (entry->useCount != 0) {
+    while (__atomic_load_n(&entry->useCount, __ATOMIC_ACQUIRE) != 0) {
         celixThreadCondition_wait(&entry->cond, &entry->mutex);
     }
     celixThreadMutex_unlock(&entry->mutex);
@@ -890,16 +962,13 @@ celix_array_list_t* celix_serviceRegisrty_findServices(
 
     celixThreadRwlock_readLock(&registry->lock);
 
-    hash_map_iterator_t iter = hashMapIterator_construct(registry->serviceRegistrations);
-    while (hashMapIterator_hasNext(&iter)) {
-        celix_array_list_t *regs = hashMapIterator_nextValue(&iter);
-        for (int i = 0; i < celix_arrayList_size(regs); ++i) {
-            service_registration_t *reg = celix_arrayList_get(regs, i);
-            celix_properties_t* svcProps = NULL;
-            serviceRegistration_getProperties(reg, &svcProps);
-            if (svcProps != NULL && celix_filter_match(filter, svcProps)) {
-                celix_arrayList_add(matchedRegistrations, reg);
-            }
+    celix_service_registry_candidates_t candidates = celix_serviceRegistry_findCandidates(registry, NULL, filter);
+    for (int i = 0; i < candidates.size; ++i) {
+        service_registration_t *reg = celix_serviceRegistry_getCandidate(&candidates, i);
+        celix_properties_t* svcProps = NULL;
+        serviceRegistration_getProperties(reg, &svcProps);
+        if (svcProps != NULL && celix_filter_match(filter, svcProps)) {
+            celix_arrayList_add(matchedRegistrations, reg);
         }
     }
 
@@ -945,28 +1014,21 @@ bool celix_serviceRegistry_getServiceInfo(
     bool found = false;
 
     celixThreadRwlock_readLock(&registry->lock);
-    celix_bundle_t *bundle = framework_getBundleById(registry->framework, bndId);
-    celix_array_list_t *registrations = bundle != NULL ? hashMap_get(registry->serviceRegistrations, bundle) : NULL;
-    if (registrations != NULL) {
-        for (int i = 0; i < celix_arrayList_size(registrations); ++i) {
-            service_registration_t *reg = celix_arrayList_get(registrations, i);
-            if (svcId == serviceRegistration_getServiceId(reg)) {
-                found = true;
-                if (outServiceName != NULL) {
-                    const char *s = NULL;
-                    serviceRegistration_getServiceName(reg, &s);
-                    *outServiceName = celix_utils_strdup(s);
-                }
-                if (outServiceProperties != NULL) {
-                    celix_properties_t *p = NULL;
-                    serviceRegistration_getProperties(reg, &p);
-                    *outServiceProperties = celix_properties_copy(p);
-                }
-                if (outIsFactory != NULL) {
-                    *outIsFactory = serviceRegistration_isFactoryService(reg);
-                }
-                break;
-            }
+    service_registration_t *reg = celix_longHashMap_get(registry->index.byId, svcId);
+    if (reg != NULL && celix_bundle_getId(reg->bundle) == bndId) {
+        found = true;
+        if (outServiceName != NULL) {
+            const char *s = NULL;
+            serviceRegistration_getServiceName(reg, &s);
+            *outServiceName = celix_utils_strdup(s);
+        }
+        if (outServiceProperties != NULL) {
+            celix_properties_t *p = NULL;
+            serviceRegistration_getProperties(reg, &p);
+            *outServiceProperties = celix_properties_copy(p);
+        }
+        if (outIsFactory != NULL) {
+            *outIsFactory = serviceRegistration_isFactoryService(reg);
         }
     }
     celixThreadRwlock_unlock(&registry->lock);
@@ -989,6 +1051,7 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
     entry->bundle = bundle;
     entry->filter = filter;
     entry->listener = listener;
+    entry->serviceName = celix_serviceRegistry_findMandatoryEqualsValue(filter, CELIX_FRAMEWORK_SERVICE_NAME, true);
     entry->useCount = 1; //new entry -> count on 1
     celixThreadMutex_create(&entry->mutex, NULL);
     celixThreadCondition_init(&entry->cond, NULL);
@@ -997,23 +1060,21 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
 
     celixThreadRwlock_writeLock(&registry->lock);
     celix_arrayList_add(registry->serviceListeners, entry); //use count 1
+    celix_serviceRegistry_addToListenerIndex(registry, entry);
 
     //find already registered services
-    hash_map_iterator_t iter = hashMapIterator_construct(registry->serviceRegistrations);
-    while (hashMapIterator_hasNext(&iter)) {
-        celix_array_list_t *regs = (array_list_pt) hashMapIterator_nextValue(&iter);
-        for (int regIdx = 0; (regs != NULL) && regIdx < celix_arrayList_size(regs); ++regIdx) {
-            service_registration_pt registration = celix_arrayList_get(regs, regIdx);
-            properties_pt props = NULL;
-            serviceRegistration_getProperties(registration, &props);
-            if (celix_filter_match(filter, props)) {
-                long svcId = serviceRegistration_getServiceId(registration);
-                service_reference_pt ref = NULL;
-                serviceRegistry_getServiceReference_internal(registry, bundle, registration, &ref);
-                celix_arrayList_add(references, ref);
-                //update pending register event count
-                celix_increasePendingRegisteredEvent(registry, svcId);
-            }
+    celix_service_registry_candidates_t candidates = celix_serviceRegistry_findCandidates(registry, NULL, filter);
+    for (int i = 0; i < candidates.size; ++i) {
+        service_registration_pt registration = celix_serviceRegistry_getCandidate(&candidates, i);
+        properties_pt props = NULL;
+        serviceRegistration_getProperties(registration, &props);
+        if (celix_filter_match(filter, props)) {
+            long svcId = serviceRegistration_getServiceId(registration);
+            service_reference_pt ref = NULL;
+            serviceRegistry_getServiceReference_internal(registry, bundle, registration, &ref);
+            celix_arrayList_add(references, ref);
+            //update pending register event count
+            celix_increasePendingRegisteredEvent(registry, svcId);
         }
     }
     celixThreadRwlock_unlock(&registry->lock);
@@ -1023,13 +1084,21 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
     //The handling of pending registered events is to ensure that the UNREGISTERING event is always
     //after the 1 or 2 REGISTERED events.
 
+    long batchId = __atomic_fetch_add(&registry->nextBatchId, 1, __ATOMIC_RELAXED);
+    for (int i = 0; i < celix_arrayList_size(references); ++i) {
+        service_reference_pt ref = celix_arrayList_get(references, i);
+        celix_service_batch_event_t event;
+        event.event.reference = ref;
+        event.event.type = OSGI_FRAMEWORK_SERVICE_EVENT_REGISTERED;
+        event.batchId = batchId;
+        event.moreInBatch = i < celix_arrayList_size(references) - 1;
+        listener->serviceChanged(listener->handle, &event.event);
+    }
+    //note the pending register events are decreased after the complete batch of events, so that an unregistration
+    //cannot overtake a REGISTERED event which is still pending in the listener.
     for (int i = 0; i < celix_arrayList_size(references); ++i) {
         service_reference_pt ref = celix_arrayList_get(references, i);
         long svcId = serviceReference_getServiceId(ref);
-        celix_service_event_t event;
-        event.reference = ref;
-        event.type = OSGI_FRAMEWORK_SERVICE_EVENT_REGISTERED;
-        listener->serviceChanged(listener->handle, &event);
         serviceReference_release(ref, NULL);
         //update pending register event count
         celix_decreasePendingRegisteredEvent(registry, svcId);
@@ -1051,6 +1120,7 @@ celix_status_t celix_serviceRegistry_removeServiceListener(celix_service_registr
         if (visit->listener == listener) {
             entry = visit;
             celix_arrayList_removeAt(registry->serviceListeners, i);
+            celix_serviceRegistry_removeFromListenerIndex(registry, entry);
             break;
         }
     }
@@ -1073,8 +1143,23 @@ static void celix_serviceRegistry_serviceChanged(celix_service_registry_t *regis
     celix_array_list_t* matchedEntries = celix_arrayList_create();
 
     celixThreadRwlock_readLock(&registry->lock);
-    for (int i = 0; i < celix_arrayList_size(registry->serviceListeners); ++i) {
-        entry = celix_arrayList_get(registry->serviceListeners, i);
+    //note only the listeners for the objectClass of the service and the listeners without a mandatory objectClass
+    //can match. Both buckets are merged on seq, so that the listeners are called in the order they are added.
+    const char* objectClass = celix_properties_get(registration->properties, CELIX_FRAMEWORK_SERVICE_NAME, NULL);
+    const celix_array_list_t* named = objectClass != NULL ? celix_stringHashMap_get(registry->listenerIndex.byName, objectClass) : NULL;
+    const celix_array_list_t* other = registry->listenerIndex.other;
+    int namedSize = named != NULL ? celix_arrayList_size(named) : 0;
+    int otherSize = celix_arrayList_size(other);
+    for (int i = 0, j = 0; i < namedSize || j < otherSize;) {
+        celix_service_registry_service_listener_entry_t* namedEntry = i < namedSize ? celix_arrayList_get(named, i) : NULL;
+        celix_service_registry_service_listener_entry_t* otherEntry = j < otherSize ? celix_arrayList_get(other, j) : NULL;
+        if (otherEntry == NULL || (namedEntry != NULL && namedEntry->seq < otherEntry->seq)) {
+            entry = namedEntry;
+            ++i;
+        } else {
+            entry = otherEntry;
+            ++j;
+        }
         celix_arrayList_add(retainedEntries, entry);
         celix_increaseCountServiceListener(entry); //ensure that use count > 0, so that the listener cannot be destroyed until all pending event are handled.
     }
@@ -1110,11 +1195,13 @@ static void celix_serviceRegistry_serviceChanged(celix_service_registry_t *regis
     for (int i = 0; i < celix_arrayList_size(matchedEntries); ++i) {
         entry = celix_arrayList_get(matchedEntries, i);
         service_reference_pt reference = NULL;
-        celix_service_event_t event;
+        celix_service_batch_event_t event;
         serviceRegistry_getServiceReference(registry, entry->bundle, registration, &reference);
-        event.type = eventType;
-        event.reference = reference;
-        entry->listener->serviceChanged(entry->listener->handle, &event);
+        event.event.type = eventType;
+        event.event.reference = reference;
+        event.batchId = -1L;
+        event.moreInBatch = false;
+        entry->listener->serviceChanged(entry->listener->handle, &event.event);
         serviceReference_release(reference, NULL);
         celix_decreaseCountServiceListener(entry); //decrease usage, so that the listener can be destroyed (if use count is now 0)
     }
@@ -1122,6 +1209,88 @@ static void celix_serviceRegistry_serviceChanged(celix_service_registry_t *regis
 }
 
 
+static int celix_serviceRegistry_compareServiceListenerSeq(celix_array_list_entry_t a, celix_array_list_entry_t b) {
+    const celix_service_registry_service_listener_entry_t* entryA = a.voidPtrVal;
+    const celix_service_registry_service_listener_entry_t* entryB = b.voidPtrVal;
+    return entryA->seq < entryB->seq ? -1 : (entryA->seq > entryB->seq ? 1 : 0);
+}
+
+/**
+ * Informs the service listeners about an event for multiple services. Every listener is retained once and gets the
+ * events for all its matching services in a row, the listeners are called in the order they are added.
+ */
+static void celix_serviceRegistry_servicesChanged(celix_service_registry_t *registry, celix_service_event_type_t eventType, const celix_array_list_t* registrations) {
+    int nrOfRegistrations = celix_arrayList_size(registrations);
+    if (nrOfRegistrations <= 1) {
+        if (nrOfRegistrations == 1) {
+            celix_serviceRegistry_serviceChanged(registry, eventType, celix_arrayList_get(registrations, 0));
+        }
+        return;
+    }
+
+    celix_array_list_t* retainedEntries = celix_arrayList_create();
+    celix_string_hash_map_t* addedBuckets = celix_stringHashMap_create();
+
+    celixThreadRwlock_readLock(&registry->lock);
+    //note every listener is in a single bucket, so adding the bucket of every distinct objectClass once and the
+    //bucket of listeners without a mandatory objectClass results in every plausible listener being retained once.
+    for (int i = 0; i < nrOfRegistrations; ++i) {
+        service_registration_t* registration = celix_arrayList_get(registrations, i);
+        const char* objectClass = celix_properties_get(registration->properties, CELIX_FRAMEWORK_SERVICE_NAME, NULL);
+        if (objectClass == NULL || celix_stringHashMap_hasKey(addedBuckets, objectClass)) {
+            continue;
+        }
+        celix_stringHashMap_put(addedBuckets, objectClass, NULL);
+        const celix_array_list_t* named = celix_stringHashMap_get(registry->listenerIndex.byName, objectClass);
+        for (int j = 0; named != NULL && j < celix_arrayList_size(named); ++j) {
+            celix_arrayList_add(retainedEntries, celix_arrayList_get(named, j));
+        }
+    }
+    for (int j = 0; j < celix_arrayList_size(registry->listenerIndex.other); ++j) {
+        celix_arrayList_add(retainedEntries, celix_arrayList_get(registry->listenerIndex.other, j));
+    }
+    for (int j = 0; j < celix_arrayList_size(retainedEntries); ++j) {
+        celix_increaseCountServiceListener(celix_arrayList_get(retainedEntries, j));
+    }
+    celixThreadRwlock_unlock(&registry->lock);
+    celix_stringHashMap_destroy(addedBuckets);
+
+    celix_arrayList_sortEntries(retainedEntries, celix_serviceRegistry_compareServiceListenerSeq);
+
+    celix_array_list_t* matchedRegistrations = celix_arrayList_create();
+    for (int j = 0; j < celix_arrayList_size(retainedEntries); ++j) {
+        celix_service_registry_service_listener_entry_t* entry = celix_arrayList_get(retainedEntries, j);
+        celix_arrayList_clear(matchedRegistrations);
+        for (int i = 0; i < nrOfRegistrations; ++i) {
+            service_registration_t* registration = celix_arrayList_get(registrations, i);
+            bool matchResult = false;
+            if (entry->filter != NULL) {
+                filter_match(entry->filter, registration->properties, &matchResult);
+            }
+            if (entry->filter == NULL || matchResult) {
+                celix_arrayList_add(matchedRegistrations, registration);
+            }
+        }
+        int nrOfMatched = celix_arrayList_size(matchedRegistrations);
+        long batchId = __atomic_fetch_add(&registry->nextBatchId, 1, __ATOMIC_RELAXED);
+        for (int i = 0; i < nrOfMatched; ++i) {
+            service_reference_pt reference = NULL;
+            celix_service_batch_event_t event;
+            serviceRegistry_getServiceReference(registry, entry->bundle, celix_arrayList_get(matchedRegistrations, i), &reference);
+            event.event.type = eventType;
+            event.event.reference = reference;
+            event.batchId = batchId;
+            event.moreInBatch = i < nrOfMatched - 1; //note lets a service tracker handle the events as a single update
+            entry->listener->serviceChanged(entry->listener->handle, &event.event);
+            serviceReference_release(reference, NULL);
+        }
+        celix_decreaseCountServiceListener(entry); //decrease usage, so that the listener can be destroyed (if use count is now 0)
+    }
+    celix_arrayList_destroy(matchedRegistrations);
+    celix_arrayList_destroy(retainedEntries);
+}
+
+
 static void celix_increasePendingRegisteredEvent(celix_service_registry_t *registry, long svcId) {
     celixThreadMutex_lock(&registry->pendingRegisterEvents.mutex);
     long count = (long)hashMap_get(registry->pendingRegisterEvents.map, (void*)svcId);
@@ -1163,17 +1332,7 @@ bool celix_serviceRegistry_isServiceRegistered(celix_service_registry_t* reg, lo
     bool isRegistered = false;
     if (serviceId >= 0) {
         celixThreadRwlock_readLock(&reg->lock);
-        hash_map_iterator_t iter = hashMapIterator_construct(reg->serviceRegistrations);
-        while (!isRegistered && hashMapIterator_hasNext(&iter)) {
-            celix_array_list_t *regs = hashMapIterator_nextValue(&iter);
-            for (int i = 0; i < celix_arrayList_size(regs); ++i) {
-                service_registration_t* r = celix_arrayList_get(regs, i);
-                if (serviceId == serviceRegistration_getServiceId(r)) {
-                    isRegistered = true;
-                    break;
-                }
-            }
-        }
+        isRegistered = celix_longHashMap_hasKey(reg->index.byId, serviceId);
         celixThreadRwlock_unlock(&reg->lock);
     }
     return isRegistered;
@@ -1182,16 +1341,10 @@ bool celix_serviceRegistry_isServiceRegistered(celix_service_registry_t* reg, lo
 void celix_serviceRegistry_unregisterService(celix_service_registry_t* registry, celix_bundle_t* bnd, long serviceId) {
     service_registration_t *reg = NULL;
     celixThreadRwlock_readLock(&registry->lock);
-    celix_array_list_t* registrations = hashMap_get(registry->serviceRegistrations, (void*)bnd);
-    if (registrations != NULL) {
-        for (int i = 0; i < celix_arrayList_size(registrations); ++i) {
-            service_registration_t *entry = celix_arrayList_get(registrations, i);
-            if (serviceRegistration_getServiceId(entry) == serviceId) {
-                reg = entry;
-                serviceRegistration_retain(reg); // protect against concurrently unregistering the same serviceId multiple times
-                break;
-            }
-        }
+    service_registration_t *entry = celix_longHashMap_get(registry->index.byId, serviceId);
+    if (entry != NULL && entry->bundle == bnd) {
+        reg = entry;
+        serviceRegistration_retain(reg); // protect against concurrently unregistering the same serviceId multiple times
     }
     celixThreadRwlock_unlock(&registry->lock);
 
@@ -1202,3 +1355,336 @@ void celix_serviceRegistry_unregisterService(celix_service_registry_t* registry,
         fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "Cannot unregister service for service id %li. This id is not present or owned by the provided bundle (bnd id %li)", serviceId, celix_bundle_getId(bnd));
     }
 }
+
+void celix_serviceRegistry_unregisterServices(celix_service_registry_t* registry, celix_bundle_t* bnd, const long* serviceIds, size_t nrOfServiceIds) {
+    celix_array_list_t* registrations = celix_arrayList_create();
+    celixThreadRwlock_readLock(&registry->lock);
+    for (size_t i = 0; i < nrOfServiceIds; ++i) {
+        service_registration_t *entry = celix_longHashMap_get(registry->index.byId, serviceIds[i]);
+        if (entry != NULL && entry->bundle == bnd) {
+            serviceRegistration_retain(entry); // protect against concurrently unregistering the same serviceId multiple times
+            celix_arrayList_add(registrations, entry);
+        } else {
+            fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "Cannot unregister service for service id %li. This id is not present or owned by the provided bundle (bnd id %li)", serviceIds[i], celix_bundle_getId(bnd));
+        }
+    }
+    celixThreadRwlock_unlock(&registry->lock);
+
+    for (int i = 0; i < celix_arrayList_size(registrations);) {
+        service_registration_t* registration = celix_arrayList_get(registrations, i);
+        if (!serviceRegistration_markUnregistering(registration)) {
+            //already being unregistered (e.g. listed twice or a concurrent unregister)
+            fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "Cannot unregister service registration");
+            celix_arrayList_removeAt(registrations, i);
+            serviceRegistration_release(registration);
+            continue;
+        }
+        const char *svcName = NULL;
+        serviceRegistration_getServiceName(registration, &svcName);
+        if (strcmp(OSGI_FRAMEWORK_LISTENER_HOOK_SERVICE_NAME, svcName) == 0) {
+            serviceRegistry_removeHook(registry, registration);
+        }
+        ++i;
+    }
+
+    int size = celix_arrayList_size(registrations);
+    celixThreadRwlock_writeLock(&registry->lock);
+    for (int i = 0; i < size; ++i) {
+        serviceRegistry_removeRegistration(registry, bnd, celix_arrayList_get(registrations, i));
+    }
+    celixThreadRwlock_unlock(&registry->lock);
+
+    for (int i = 0; i < size; ++i) {
+        service_registration_t* registration = celix_arrayList_get(registrations, i);
+        celix_waitForPendingRegisteredEvents(registry, registration->serviceId);
+    }
+
+    celix_serviceRegistry_servicesChanged(registry, OSGI_FRAMEWORK_SERVICE_EVENT_UNREGISTERING, registrations);
+
+    celixThreadRwlock_readLock(&registry->lock);
+    for (int i = 0; i < size; ++i) {
+        serviceRegistry_invalidateRegistration(registry, celix_arrayList_get(registrations, i));
+    }
+    celixThreadRwlock_unlock(&registry->lock);
+
+    for (int i = 0; i < size; ++i) {
+        service_registration_t* registration = celix_arrayList_get(registrations, i);
+        serviceRegistration_release(registration); //the registry reference
+        serviceRegistration_release(registration); //the reference retained above
+    }
+    celix_arrayList_destroy(registrations);
+}
+
+static void celix_serviceRegistry_createIndexes(celix_service_registry_t* registry) {
+    registry->index.all = celix_arrayList_create();
+    registry->index.byId = celix_longHashMap_create();
+
+    celix_string_hash_map_create_options_t bucketsOpts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    bucketsOpts.simpleRemovedCallback = (void*)celix_arrayList_destroy;
+    registry->index.byName = celix_stringHashMap_createWithOptions(&bucketsOpts);
+
+    celix_string_hash_map_create_options_t attributesOpts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    attributesOpts.simpleRemovedCallback = (void*)celix_stringHashMap_destroy;
+    registry->index.byAttribute = celix_stringHashMap_createWithOptions(&attributesOpts);
+
+    registry->listenerIndex.byName = celix_stringHashMap_createWithOptions(&bucketsOpts);
+    registry->listenerIndex.other = celix_arrayList_create();
+    registry->listenerIndex.nextSeq = 0;
+
+    //note the objectClass property can differ from the registration service name, so always index it as attribute.
+    celix_stringHashMap_put(registry->index.byAttribute, CELIX_FRAMEWORK_SERVICE_NAME, celix_stringHashMap_createWithOptions(&bucketsOpts));
+
+    const char* attributes = celix_framework_getConfigProperty(registry->framework, CELIX_FRAMEWORK_SERVICE_REGISTRY_INDEXED_ATTRIBUTES, NULL, NULL);
+    if (attributes != NULL) {
+        char* attributesCopy = celix_utils_strdup(attributes);
+        char* savePtr = NULL;
+        for (char* attr = strtok_r(attributesCopy, ",", &savePtr); attr != NULL; attr = strtok_r(NULL, ",", &savePtr)) {
+            attr = celix_utils_trimInPlace(attr);
+            if (celix_utils_isStringNullOrEmpty(attr) || celix_utils_stringEquals(attr, CELIX_FRAMEWORK_SERVICE_ID)) {
+                continue; //note service ids are always indexed
+            }
+            if (!celix_stringHashMap_hasKey(registry->index.byAttribute, attr)) {
+                celix_stringHashMap_put(registry->index.byAttribute, attr, celix_stringHashMap_createWithOptions(&bucketsOpts));
+            }
+        }
+        free(attributesCopy);
+    }
+}
+
+static void celix_serviceRegistry_destroyIndexes(celix_service_registry_t* registry) {
+    celix_arrayList_destroy(registry->listenerIndex.other);
+    celix_stringHashMap_destroy(registry->listenerIndex.byName);
+    celix_stringHashMap_destroy(registry->index.byAttribute);
+    celix_stringHashMap_destroy(registry->index.byName);
+    celix_longHashMap_destroy(registry->index.byId);
+    celix_arrayList_destroy(registry->index.all);
+}
+
+/**
+ * @brief Returns the position slot of the registration for the index slot, or NULL for CELIX_SERVICE_REGISTRATION_NO_INDEX_SLOT.
+ */
+static int* celix_serviceRegistry_indexPos(service_registration_t* registration, enum celix_service_registration_index_slot slot) {
+    return slot == CELIX_SERVICE_REGISTRATION_NO_INDEX_SLOT ? NULL : &registration->indexPos[slot];
+}
+
+/**
+ * @brief Adds a registration to an index list.
+ * If slot is not CELIX_SERVICE_REGISTRATION_NO_INDEX_SLOT, the position in the list is stored in the index position
+ * slot of the registration.
+ */
+static void celix_serviceRegistry_addToIndexList(celix_array_list_t* list, service_registration_t* registration, enum celix_service_registration_index_slot slot) {
+    int* pos = celix_serviceRegistry_indexPos(registration, slot);
+    if (pos != NULL) {
+        *pos = celix_arrayList_size(list);
+    }
+    celix_arrayList_add(list, registration);
+}
+
+/**
+ * @brief Removes a registration from an index list.
+ * If slot is not CELIX_SERVICE_REGISTRATION_NO_INDEX_SLOT, the registration is removed in O(1) using the stored
+ * position, by moving the last registration of the list to the position of the removed registration.
+ * Note that this changes the order of the index list, the index lists have no defined order.
+ */
+static void celix_serviceRegistry_removeFromIndexList(celix_array_list_t* list, service_registration_t* registration, enum celix_service_registration_index_slot slot) {
+    int* pos = celix_serviceRegistry_indexPos(registration, slot);
+    if (pos == NULL) {
+        celix_arrayList_remove(list, registration);
+        return;
+    }
+    int last = celix_arrayList_size(list) - 1;
+    assert(*pos >= 0 && *pos <= last && celix_arrayList_get(list, *pos) == registration);
+    if (*pos != last) {
+        service_registration_t* moved = celix_arrayList_get(list, last);
+        arrayList_set(list, (unsigned int)*pos, moved);
+        *celix_serviceRegistry_indexPos(moved, slot) = *pos;
+    }
+    celix_arrayList_removeAt(list, last);
+}
+
+static void celix_serviceRegistry_addToIndexBucket(celix_string_hash_map_t* index, const char* key, service_registration_t* registration, enum celix_service_registration_index_slot slot) {
+    celix_array_list_t* bucket = celix_stringHashMap_get(index, key);
+    if (bucket == NULL) {
+        bucket = celix_arrayList_create();
+        celix_stringHashMap_put(index, key, bucket);
+    }
+    celix_serviceRegistry_addToIndexList(bucket, registration, slot);
+}
+
+static void celix_serviceRegistry_removeFromIndexBucket(celix_string_hash_map_t* index, const char* key, service_registration_t* registration, enum celix_service_registration_index_slot slot) {
+    celix_array_list_t* bucket = celix_stringHashMap_get(index, key);
+    if (bucket != NULL) {
+        celix_serviceRegistry_removeFromIndexList(bucket, registration, slot);
+        if (celix_arrayList_size(bucket) == 0) {
+            celix_stringHashMap_remove(index, key); //note also destroys the bucket
+        }
+    }
+}
+
+/**
+ * @brief Returns the index slot for the buckets of an indexed attribute.
+ * A registration is part of a single objectClass bucket, so these buckets use a stored position. A registration can
+ * be part of buckets of multiple configured attributes, these are (small) lists without stored positions.
+ */
+static enum celix_service_registration_index_slot celix_serviceRegistry_attributeIndexSlot(const char* attribute) {
+    return celix_utils_stringEquals(attribute, CELIX_FRAMEWORK_SERVICE_NAME) ? CELIX_SERVICE_REGISTRATION_INDEX_SLOT_OBJECT_CLASS
+                                                                            : CELIX_SERVICE_REGISTRATION_NO_INDEX_SLOT;
+}
+
+static void celix_serviceRegistry_addToIndexes(celix_service_registry_t* registry, service_registration_t* registration) {
+    //only call after locked registry RWlock
+    celix_serviceRegistry_addToIndexList(registry->index.all, registration, CELIX_SERVICE_REGISTRATION_INDEX_SLOT_ALL);
+    celix_longHashMap_put(registry->index.byId, (long)registration->serviceId, registration);
+    celix_serviceRegistry_addToIndexBucket(registry->index.byName, registration->className, registration, CELIX_SERVICE_REGISTRATION_INDEX_SLOT_NAME);
+    CELIX_STRING_HASH_MAP_ITERATE(registry->index.byAttribute, iter) {
+        const char* value = celix_properties_get(registration->properties, iter.key, NULL);
+        if (value != NULL) {
+            celix_serviceRegistry_addToIndexBucket(iter.value.ptrValue, value, registration, celix_serviceRegistry_attributeIndexSlot(iter.key));
+        }
+    }
+}
+
+static void celix_serviceRegistry_removeFromIndexes(celix_service_registry_t* registry, service_registration_t* registration) {
+    //only call after locked registry RWlock
+    if (celix_longHashMap_get(registry->index.byId, (long)registration->serviceId) != registration) {
+        return; //not (or no longer) indexed
+    }
+    celix_serviceRegistry_removeFromIndexList(registry->index.all, registration, CELIX_SERVICE_REGISTRATION_INDEX_SLOT_ALL);
+    celix_longHashMap_remove(registry->index.byId, (long)registration->serviceId);
+    celix_serviceRegistry_removeFromIndexBucket(registry->index.byName, registration->className, registration, CELIX_SERVICE_REGISTRATION_INDEX_SLOT_NAME);
+    CELIX_STRING_HASH_MAP_ITERATE(registry->index.byAttribute, iter) {
+        const char* value = celix_properties_get(registration->properties, iter.key, NULL);
+        if (value != NULL) {
+            celix_serviceRegistry_removeFromIndexBucket(iter.value.ptrValue, value, registration, celix_serviceRegistry_attributeIndexSlot(iter.key));
+        }
+    }
+}
+
+static void celix_serviceRegistry_addToListenerIndex(celix_service_registry_t* registry, celix_service_registry_service_listener_entry_t* entry) {
+    //only call after locked registry RWlock
+    entry->seq = registry->listenerIndex.nextSeq++;
+    if (entry->serviceName == NULL) {
+        celix_arrayList_add(registry->listenerIndex.other, entry);
+        return;
+    }
+    celix_array_list_t* bucket = celix_stringHashMap_get(registry->listenerIndex.byName, entry->serviceName);
+    if (bucket == NULL) {
+        bucket = celix_arrayList_create();
+        celix_stringHashMap_put(registry->listenerIndex.byName, entry->serviceName, bucket);
+    }
+    celix_arrayList_add(bucket, entry);
+}
+
+static void celix_serviceRegistry_removeFromListenerIndex(celix_service_registry_t* registry, celix_service_registry_service_listener_entry_t* entry) {
+    //only call after locked registry RWlock
+    if (entry->serviceName == NULL) {
+        celix_arrayList_remove(registry->listenerIndex.other, entry);
+        return;
+    }
+    celix_array_list_t* bucket = celix_stringHashMap_get(registry->listenerIndex.byName, entry->serviceName);
+    if (bucket != NULL) {
+        celix_arrayList_remove(bucket, entry);
+        if (celix_arrayList_size(bucket) == 0) {
+            celix_stringHashMap_remove(registry->listenerIndex.byName, entry->serviceName); //note also destroys the bucket
+        }
+    }
+}
+
+/**
+ * @brief Returns whether a filter equals compare for the provided filter value is a plain string compare.
+ *
+ * Filter values which can be converted to a long, double or version are compared typed (e.g. "(a=1)" also matches
+ * a property value "01") and can therefore not be looked up in a string index.
+ */
+static bool celix_serviceRegistry_isPlainStringFilterValue(const char* value) {
+    bool converted = false;
+    celix_utils_convertStringToLong(value, 0, &converted);
+    if (!converted) {
+        celix_utils_convertStringToDouble(value, 0.0, &converted);
+    }
+    if (!converted) {
+        celix_version_destroy(celix_utils_convertStringToVersion(value, NULL, &converted));
+    }
+    return !converted;
+}
+
+/**
+ * @brief Find the value of a "(attribute=value)" filter part, which must match for the complete filter to match.
+ *
+ * Only filter parts nested in AND operands are mandatory.
+ * If plainStringOnly is true, filter parts which are not compared as plain string are ignored.
+ * @return The value or NULL if no such filter part exists.
+ */
+static const char* celix_serviceRegistry_findMandatoryEqualsValue(const celix_filter_t* filter, const char* attribute, bool plainStringOnly) {
+    if (filter == NULL) {
+        return NULL;
+    }
+    if (filter->operand == CELIX_FILTER_OPERAND_AND) {
+        for (int i = 0; i < celix_arrayList_size(filter->children); ++i) {
+            const celix_filter_t* child = celix_arrayList_get(filter->children, i);
+            const char* value = celix_serviceRegistry_findMandatoryEqualsValue(child, attribute, plainStringOnly);
+            if (value != NULL) {
+                return value;
+            }
+        }
+    } else if (filter->operand == CELIX_FILTER_OPERAND_EQUAL && celix_utils_stringEquals(filter->attribute, attribute)) {
+        if (!plainStringOnly || celix_serviceRegistry_isPlainStringFilterValue(filter->value)) {
+            return filter->value;
+        }
+    }
+    return NULL;
+}
+
+static void celix_serviceRegistry_narrowCandidates(celix_service_registry_candidates_t* candidates, const celix_array_list_t* bucket) {
+    if (bucket == NULL) {
+        candidates->registrations = NULL;
+        candidates->size = 0;
+    } else if (celix_arrayList_size(bucket) < candidates->size) {
+        candidates->registrations = bucket;
+        candidates->size = celix_arrayList_size(bucket);
+    }
+}
+
+static celix_service_registry_candidates_t celix_serviceRegistry_findCandidates(celix_service_registry_t* registry, const char* serviceName, const celix_filter_t* filter) {
+    //only call after locked registry RWlock
+    celix_service_registry_candidates_t candidates;
+    candidates.registrations = registry->index.all;
+    candidates.registration = NULL;
+    candidates.size = celix_arrayList_size(registry->index.all);
+
+    //note service.id property values are always canonical longs, so a long filter value can be looked up directly
+    const char* svcIdStr = celix_serviceRegistry_findMandatoryEqualsValue(filter, CELIX_FRAMEWORK_SERVICE_ID, false);
+    if (svcIdStr != NULL) {
+        bool converted = false;
+        long svcId = celix_utils_convertStringToLong(svcIdStr, -1, &converted);
+        if (converted) {
+            candidates.registrations = NULL;
+            candidates.registration = celix_longHashMap_get(registry->index.byId, svcId);
+            candidates.size = candidates.registration != NULL ? 1 : 0;
+            return candidates;
+        }
+    }
+
+    if (serviceName != NULL) {
+        celix_serviceRegistry_narrowCandidates(&candidates, celix_stringHashMap_get(registry->index.byName, serviceName));
+    }
+
+    CELIX_STRING_HASH_MAP_ITERATE(registry->index.byAttribute, iter) {
+        if (candidates.size == 0) {
+            break;
+        }
+        const char* value = celix_serviceRegistry_findMandatoryEqualsValue(filter, iter.key, true);
+        if (value != NULL) {
+            celix_serviceRegistry_narrowCandidates(&candidates, celix_stringHashMap_get(iter.value.ptrValue, value));
+        }
+    }
+
+    return candidates;
+}
+
+static service_registration_t* celix_serviceRegistry_getCandidate(const celix_service_registry_candidates_t* candidates, int index) {
+    if (candidates->registrations != NULL) {
+        return celix_arrayList_get(candidates->registrations, index);
+    }
+    return candidates->registration;
+}
@@ -31,9 +31,25 @@
 #include "service_registry.h"
 #include "listener_hook_service.h"
 #include "service_reference.h"
+#include "celix_long_hash_map.h"
+#include "celix_string_hash_map.h"
 
 #define CELIX_SERVICE_REGISTRY_STATIC_EVENT_QUEUE_SIZE  64
 
+/**
+ * @brief A service event with batch information.
+ *
+ * The service registry always calls the service listeners with a celix_service_batch_event_t. The public
+ * celix_service_event_t is the first member, so for service listeners this is a normal service event, but framework
+ * internal listeners (i.e. service trackers) can use the batch information to handle the events of a batch
+ * (e.g. a batch service registration) as a single update.
+ */
+typedef struct celix_service_batch_event {
+    celix_service_event_t event; //note must be the first member
+    long batchId; //identifies the batch, the events of a batch are delivered in a row to a listener. -1 if not part of a batch
+    bool moreInBatch; //true if more events of the same batch follow for the listener
+} celix_service_batch_event_t;
+
 typedef struct celix_service_registry_event {
     //TODO call from framework to ensure bundle entries usage count is increased
     bool isRegistrationEvent;
@@ -62,11 +78,35 @@ struct celix_serviceRegistry {
 	hash_map_t *serviceRegistrations; //key = bundle (reg owner), value = list ( registration )
 	hash_map_t *serviceReferences; //key = bundle, value = map (key = serviceId, value = reference)
 
+	/**
+	 * Secondary indexes on the service registrations, used to limit the registrations which need to be
+	 * filter matched when looking up services or when adding service listeners.
+	 * The index lists have no defined order, users which need an order (e.g. on service ranking) sort the matches.
+	 */
+	struct {
+	    celix_array_list_t* all; //all registrations, no defined order (removal moves the last registration to the freed position)
+	    celix_long_hash_map_t* byId; //key = service id, value = service_registration_t*
+	    celix_string_hash_map_t* byName; //key = service name, value = celix_array_list_t* (service_registration_t*)
+	    celix_string_hash_map_t* byAttribute; //key = indexed attribute name, value = celix_string_hash_map_t* (key = attribute value, value = celix_array_list_t* (service_registration_t*))
+	} index;
+
 	long nextServiceId;
+	long nextBatchId; //atomic, used to create unique service event batch ids
 
 	celix_array_list_t *listenerHooks; //celix_service_registry_listener_hook_entry_t*
 	celix_array_list_t *serviceListeners; //celix_service_registry_service_listener_entry_t*
 
+	/**
+	 * Index of the service listeners on the mandatory objectClass of their filter, used to limit the service listeners
+	 * which need to be filter matched for a service event. Listeners without a mandatory objectClass are in other.
+	 * The buckets are ordered on the listener seq.
+	 */
+	struct {
+	    celix_string_hash_map_t* byName; //key = service name, value = celix_array_list_t* (celix_service_registry_service_listener_entry_t*)
+	    celix_array_list_t* other; //celix_service_registry_service_listener_entry_t*
+	    long nextSeq;
+	} listenerIndex;
+
 	/**
 	 * The pending register events are introduced to ensure UNREGISTERING events are always
 	 * after REGISTERED events in service listeners.
@@ -95,9 +135,11 @@ typedef struct celix_service_registry_service_listener_entry {
     celix_bundle_t *bundle;
     celix_filter_t *filter;
     celix_service_listener_t *listener;
-    celix_thread_mutex_t mutex; //protects below
+    const char *serviceName; //the mandatory objectClass of the filter (owned by filter), NULL if there is none
+    long seq; //the order in which the listener is added
+    celix_thread_mutex_t mutex; //used to wait for a useCount of 0
     celix_thread_cond_t cond;
-    unsigned int useCount;
+    unsigned int useCount; //atomic
 } celix_service_registry_service_listener_entry_t;
 
 struct usageCount {
@@ -26,8 +26,11 @@
 #include <unistd.h>
 #include <celix_api.h>
 #include <limits.h>
+#include <sched.h>
+#include <stdint.h>
 
 #include "service_tracker_private.h"
+#include "service_registry_private.h"
 #include "bundle_context.h"
 #include "celix_constants.h"
 #include "service_reference.h"
@@ -35,8 +38,9 @@
 #include "bundle_context_private.h"
 #include "celix_array_list.h"
 
-static celix_status_t serviceTracker_track(service_tracker_t *tracker, service_reference_pt reference, celix_service_event_t *event);
-static celix_status_t serviceTracker_untrack(service_tracker_t *tracker, service_reference_pt reference);
+static celix_status_t serviceTracker_track(service_tracker_t *tracker, service_reference_pt reference, celix_service_tracker_pending_t *pending);
+static void serviceTracker_untrack(service_tracker_t *tracker, service_reference_pt reference, celix_service_tracker_pending_t *pending);
+static void serviceTracker_announcePending(service_tracker_t *tracker, celix_service_tracker_pending_t *pending);
 static void serviceTracker_untrackTracked(service_tracker_t *tracker, celix_tracked_entry_t *tracked, int trackedSize, bool set);
 static celix_status_t serviceTracker_invokeAddingService(service_tracker_t *tracker, service_reference_pt ref, void **svcOut);
 static celix_status_t serviceTracker_invokeAddService(service_tracker_t *tracker, celix_tracked_entry_t *tracked);
@@ -63,22 +67,23 @@ static inline celix_tracked_entry_t* tracked_create(service_reference_pt ref, vo
 }
 
 static inline void tracked_retain(celix_tracked_entry_t *tracked) {
-    celixThreadMutex_lock(&tracked->mutex);
-    tracked->useCount += 1;
-    celixThreadMutex_unlock(&tracked->mutex);
+    __atomic_add_fetch(&tracked->useCount, 1, __ATOMIC_RELAXED);
 }
 
 static inline void tracked_release(celix_tracked_entry_t *tracked) {
-    celixThreadMutex_lock(&tracked->mutex);
-    assert(tracked->useCount > 0);
-    tracked->useCount -= 1;
-    celixThreadCondition_signal(&tracked->useCond);
-    celixThreadMutex_unlock(&tracked->mutex);
+    size_t count = __atomic_sub_fetch(&tracked->useCount, 1, __ATOMIC_ACQ_REL);
+    assert(count != (size_t)-1);
+    if (count == 0) {
+        //note locking the mutex ensures the signal is not lost for a waiter which just checked the use count
+        celixThreadMutex_lock(&tracked->mutex);
+        celixThreadCondition_signal(&tracked->useCond);
+        celixThreadMutex_unlock(&tracked->mutex);
+    }
 }
 
 static inline void tracked_waitAndDestroy(celix_tracked_entry_t *tracked) {
     celixThreadMutex_lock(&tracked->mutex);
-    while (tracked->useCount != 0) {
+    while (__atomic_load_n(&tracked->useCount, __ATOMIC_ACQUIRE) != 0) {
         celixThreadCondition_wait(&tracked->useCond, &tracked->mutex);
     }
     celixThreadMutex_unlock(&tracked->mutex);
@@ -89,6 +94,82 @@ static inline void tracked_waitAndDestroy(celix_tracked_entry_t *tracked) {
     free(tracked);
 }
 
+static celix_tracked_snapshot_t* tracked_createSnapshot(const celix_array_list_t *trackedServices) {
+    int size = celix_arrayList_size(trackedServices);
+    celix_tracked_snapshot_t *snapshot = malloc(sizeof(*snapshot) + size * sizeof(celix_tracked_entry_t*));
+    snapshot->highest = NULL;
+    snapshot->size = size;
+    for (int i = 0; i < size; ++i) {
+        celix_tracked_entry_t *tracked = celix_arrayList_get(trackedServices, i);
+        snapshot->entries[i] = tracked;
+        if (snapshot->highest == NULL || celix_utils_compareServiceIdsAndRanking(
+                tracked->serviceId, tracked->serviceRanking,
+                snapshot->highest->serviceId, snapshot->highest->serviceRanking) < 0) {
+            snapshot->highest = tracked;
+        }
+    }
+    return snapshot;
+}
+
+/**
+ * @brief Returns the reader counter stripe of the calling thread.
+ */
+static size_t serviceTracker_readerStripe(void) {
+    static size_t nextStripe = 0;
+    static __thread size_t stripe = SIZE_MAX;
+    if (stripe == SIZE_MAX) {
+        stripe = __atomic_fetch_add(&nextStripe, 1, __ATOMIC_RELAXED) % CELIX_SERVICE_TRACKER_READER_STRIPES;
+    }
+    return stripe;
+}
+
+/**
+ * @brief Enter the read section of the tracked services snapshot and return the current snapshot.
+ *
+ * The entries of the snapshot are valid until serviceTracker_exitSnapshot is called, to use a tracked entry after that
+ * it must be retained in the read section.
+ */
+static celix_tracked_snapshot_t* serviceTracker_enterSnapshot(service_tracker_t *tracker, size_t **readerCount) {
+    size_t epoch = __atomic_load_n(&tracker->snapshot.epoch, __ATOMIC_SEQ_CST);
+    *readerCount = &tracker->snapshot.readers[serviceTracker_readerStripe()].count[epoch];
+    __atomic_add_fetch(*readerCount, 1, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&tracker->snapshot.current, __ATOMIC_SEQ_CST);
+}
+
+static void serviceTracker_exitSnapshot(size_t *readerCount) {
+    __atomic_sub_fetch(readerCount, 1, __ATOMIC_RELEASE);
+}
+
+static void serviceTracker_waitForReaders(service_tracker_t *tracker, size_t epoch) {
+    for (int i = 0; i < CELIX_SERVICE_TRACKER_READER_STRIPES; ++i) {
+        while (__atomic_load_n(&tracker->snapshot.readers[i].count[epoch], __ATOMIC_ACQUIRE) != 0) {
+            sched_yield();
+        }
+    }
+}
+
+/**
+ * @brief Replace the snapshot with a snapshot of the current tracked services and wait till the replaced snapshot is
+ * no longer used.
+ *
+ * Should be called with the tracker mutex locked, after trackedServices is updated. When this function returns, no
+ * reader can retain a tracked entry which is removed from trackedServices.
+ */
+static void serviceTracker_publishSnapshot(service_tracker_t *tracker) {
+    celix_tracked_snapshot_t *snapshot = tracked_createSnapshot(tracker->trackedServices);
+    celix_tracked_snapshot_t *replaced = __atomic_exchange_n(&tracker->snapshot.current, snapshot, __ATOMIC_SEQ_CST);
+
+    //note first wait for the readers of the next epoch (which entered before the previous epoch switch), then switch
+    //the epoch and wait for the readers of the previous epoch.
+    size_t previous = __atomic_load_n(&tracker->snapshot.epoch, __ATOMIC_SEQ_CST);
+    size_t next = previous ^ 1;
+    serviceTracker_waitForReaders(tracker, next);
+    __atomic_store_n(&tracker->snapshot.epoch, next, __ATOMIC_SEQ_CST);
+    serviceTracker_waitForReaders(tracker, previous);
+
+    free(replaced);
+}
+
 celix_status_t serviceTracker_create(bundle_context_pt context, const char * service, service_tracker_customizer_pt customizer, service_tracker_pt *tracker) {
 	celix_status_t status = CELIX_SUCCESS;
 
@@ -122,6 +203,9 @@ celix_status_t serviceTracker_createWithFilter(bundle_context_pt context, const
     celixThreadCondition_init(&tracker->condTracked, NULL);
     celixThreadCondition_init(&tracker->condUntracking, NULL);
     tracker->trackedServices = celix_arrayList_create();
+    tracker->trackedServiceIds = celix_longHashMap_create();
+    tracker->pendingBatches = celix_longHashMap_create();
+    tracker->snapshot.current = tracked_createSnapshot(tracker->trackedServices);
     tracker->untrackedServiceCount = 0;
 
     tracker->currentHighestServiceId = -1;
@@ -141,6 +225,10 @@ celix_status_t serviceTracker_destroy(service_tracker_pt tracker) {
     celixThreadCondition_destroy(&tracker->condTracked);
     celixThreadCondition_destroy(&tracker->condUntracking);
     celix_arrayList_destroy(tracker->trackedServices);
+    celix_longHashMap_destroy(tracker->trackedServiceIds);
+    assert(celix_longHashMap_size(tracker->pendingBatches) == 0);
+    celix_longHashMap_destroy(tracker->pendingBatches);
+    free(tracker->snapshot.current);
     free(tracker);
 	return CELIX_SUCCESS;
 }
@@ -214,6 +302,31 @@ celix_status_t serviceTracker_close(service_tracker_t* tracker) {
         }
         celixThreadMutex_unlock(&tracker->closeSync.mutex);
 
+        //note batches of service events can still be in progress, announce their pending (un)tracked services.
+        celix_service_tracker_pending_t inProgress = {NULL, NULL};
+        celixThreadMutex_lock(&tracker->mutex);
+        CELIX_LONG_HASH_MAP_ITERATE(tracker->pendingBatches, iter) {
+            celix_service_tracker_pending_t* pending = iter.value.ptrValue;
+            for (int i = 0; pending->tracked != NULL && i < celix_arrayList_size(pending->tracked); ++i) {
+                if (inProgress.tracked == NULL) {
+                    inProgress.tracked = celix_arrayList_create();
+                }
+                celix_arrayList_add(inProgress.tracked, celix_arrayList_get(pending->tracked, i));
+            }
+            for (int i = 0; pending->untracked != NULL && i < celix_arrayList_size(pending->untracked); ++i) {
+                if (inProgress.untracked == NULL) {
+                    inProgress.untracked = celix_arrayList_create();
+                }
+                celix_arrayList_add(inProgress.untracked, celix_arrayList_get(pending->untracked, i));
+            }
+            celix_arrayList_destroy(pending->tracked);
+            celix_arrayList_destroy(pending->untracked);
+            pending->tracked = NULL;
+            pending->untracked = NULL;
+        }
+        celixThreadMutex_unlock(&tracker->mutex);
+        serviceTracker_announcePending(tracker, &inProgress);
+
         int nrOfTrackedEntries;
         do {
             celixThreadMutex_lock(&tracker->mutex);
@@ -222,6 +335,8 @@ celix_status_t serviceTracker_close(service_tracker_t* tracker) {
             if (nrOfTrackedEntries > 0) {
                 tracked = celix_arrayList_get(tracker->trackedServices, 0);
                 celix_arrayList_removeAt(tracker->trackedServices, 0);
+                celix_longHashMap_remove(tracker->trackedServiceIds, serviceReference_getServiceId(tracked->reference));
+                serviceTracker_publishSnapshot(tracker);
                 tracker->untrackedServiceCount++;
             }
             celixThreadMutex_unlock(&tracker->mutex);
@@ -330,8 +445,38 @@ void *serviceTracker_getServiceByReference(service_tracker_pt tracker, service_r
 	return service;
 }
 
+/**
+ * @brief Returns the pending entries for the batch of the provided service event.
+ *
+ * The pending entries of a batch are kept in the tracker till the last event of the batch. Events which are not
+ * part of a batch, or are the only event of a batch, use the provided local pending entries.
+ */
+static celix_service_tracker_pending_t* serviceTracker_getPendingForBatch(service_tracker_t *tracker, const celix_service_batch_event_t *event, celix_service_tracker_pending_t *localPending) {
+    if (event->batchId < 0) {
+        return localPending;
+    }
+    celix_service_tracker_pending_t* pending = localPending;
+    celixThreadMutex_lock(&tracker->mutex);
+    celix_service_tracker_pending_t* batchPending = celix_longHashMap_get(tracker->pendingBatches, event->batchId);
+    if (batchPending != NULL) {
+        pending = batchPending;
+        if (!event->moreInBatch) {
+            celix_longHashMap_remove(tracker->pendingBatches, event->batchId);
+        }
+    } else if (event->moreInBatch) {
+        pending = calloc(1, sizeof(*pending));
+        celix_longHashMap_put(tracker->pendingBatches, event->batchId, pending);
+    }
+    celixThreadMutex_unlock(&tracker->mutex);
+    return pending;
+}
+
 static void serviceTracker_serviceChanged(void *handle, celix_service_event_t *event) {
     service_tracker_t *tracker = handle;
+    //note the service registry always calls service listeners with a celix_service_batch_event_t
+    const celix_service_batch_event_t *batchEvent = (const celix_service_batch_event_t*)event;
+    celix_service_tracker_pending_t localPending = {NULL, NULL};
+    celix_service_tracker_pending_t* pending = serviceTracker_getPendingForBatch(tracker, batchEvent, &localPending);
 
     celixThreadMutex_lock(&tracker->closeSync.mutex);
     bool closing = tracker->closeSync.closing;
@@ -344,19 +489,35 @@ static void serviceTracker_serviceChanged(void *handle, celix_service_event_t *e
         case OSGI_FRAMEWORK_SERVICE_EVENT_REGISTERED:
         case OSGI_FRAMEWORK_SERVICE_EVENT_MODIFIED:
             if(!closing) {
-                serviceTracker_track(tracker, event->reference, event);
+                serviceTracker_track(tracker, event->reference, pending);
             }
             break;
         case OSGI_FRAMEWORK_SERVICE_EVENT_UNREGISTERING:
             //after this call the registration can be gone, to prevent that happens before the tracker finishing its cleanup job with the corresponding service,
             //untrack the reference even when the tracker is closing.
-            serviceTracker_untrack(tracker, event->reference);
+            serviceTracker_untrack(tracker, event->reference, pending);
             break;
         default:
             //nop
             break;
     }
 
+    if (!batchEvent->moreInBatch) {
+        //note the (un)tracked services of a batch are published and announced once, at the last event of the batch.
+        serviceTracker_announcePending(tracker, pending);
+        if (pending != &localPending) {
+            free(pending);
+        }
+        if (event->type == OSGI_FRAMEWORK_SERVICE_EVENT_UNREGISTERING) {
+            //ensure no untrack is still happening (to ensure it safe to unregister service)
+            celixThreadMutex_lock(&tracker->mutex);
+            while (tracker->untrackedServiceCount > 0) {
+                celixThreadCondition_wait(&tracker->condUntracking, &tracker->mutex);
+            }
+            celixThreadMutex_unlock(&tracker->mutex);
+        }
+    }
+
     if (!closing) {
         celixThreadMutex_lock(&tracker->closeSync.mutex);
         tracker->closeSync.activeCalls -= 1;
@@ -372,24 +533,16 @@ size_t serviceTracker_nrOfTrackedServices(service_tracker_t *tracker) {
     return result;
 }
 
-static celix_status_t serviceTracker_track(service_tracker_t* tracker, service_reference_pt reference, celix_service_event_t *event) {
+static celix_status_t serviceTracker_track(service_tracker_t* tracker, service_reference_pt reference, celix_service_tracker_pending_t *pending) {
 	celix_status_t status = CELIX_SUCCESS;
 
-    celix_tracked_entry_t *found = NULL;
+    long svcId = serviceReference_getServiceId(reference);
 
     bundleContext_retainServiceReference(tracker->context, reference);
 
     celixThreadMutex_lock(&tracker->mutex);
-    for (int i = 0; i < celix_arrayList_size(tracker->trackedServices); i++) {
-        bool equals = false;
-        celix_tracked_entry_t *visit = (celix_tracked_entry_t*) arrayList_get(tracker->trackedServices, i);
-        serviceReference_equals(reference, visit->reference, &equals);
-        if (equals) {
-            //NOTE it is possible to get two REGISTERED events, second one can be ignored.
-            found = visit;
-            break;
-        }
-    }
+    //NOTE it is possible to get two REGISTERED events, second one can be ignored.
+    celix_tracked_entry_t *found = celix_longHashMap_get(tracker->trackedServiceIds, svcId);
     celixThreadMutex_unlock(&tracker->mutex);
 
     if (found == NULL) {
@@ -413,14 +566,12 @@ static celix_status_t serviceTracker_track(service_tracker_t* tracker, service_r
 
             celixThreadMutex_lock(&tracker->mutex);
             arrayList_add(tracker->trackedServices, tracked);
-            celixThreadCondition_broadcast(&tracker->condTracked);
-            celixThreadMutex_unlock(&tracker->mutex);
-
-            if (tracker->set != NULL || tracker->setWithProperties != NULL || tracker->setWithOwner != NULL) {
-                celix_serviceTracker_useHighestRankingService(tracker, NULL, 0, tracker, NULL, NULL,
-                                                              serviceTracker_checkAndInvokeSetService);
+            celix_longHashMap_put(tracker->trackedServiceIds, svcId, tracked);
+            if (pending->tracked == NULL) {
+                pending->tracked = celix_arrayList_create();
             }
-            serviceTracker_invokeAddService(tracker, tracked);
+            celix_arrayList_add(pending->tracked, tracked); //note announced by serviceTracker_announcePending
+            celixThreadMutex_unlock(&tracker->mutex);
         } else {
             bundleContext_ungetServiceReference(tracker->context, reference);
         }
@@ -514,45 +665,83 @@ static celix_status_t serviceTracker_invokeAddingService(service_tracker_t *trac
     return status;
 }
 
-static celix_status_t serviceTracker_untrack(service_tracker_t* tracker, service_reference_pt reference) {
-    celix_status_t status = CELIX_SUCCESS;
-    celix_tracked_entry_t *remove = NULL;
-
+static void serviceTracker_untrack(service_tracker_t* tracker, service_reference_pt reference, celix_service_tracker_pending_t *pending) {
     celixThreadMutex_lock(&tracker->mutex);
-    for (int i = 0; i < celix_arrayList_size(tracker->trackedServices); i++) {
-        bool equals;
-        celix_tracked_entry_t *tracked = (celix_tracked_entry_t*) arrayList_get(tracker->trackedServices, i);
-        serviceReference_equals(reference, tracked->reference, &equals);
-        if (equals) {
-            remove = tracked;
-            //remove from trackedServices to prevent getting this service, but don't destroy yet, can be in use
-            celix_arrayList_removeAt(tracker->trackedServices, i);
-            tracker->untrackedServiceCount++;
-            break;
+    long svcId = serviceReference_getServiceId(reference);
+    celix_tracked_entry_t *remove = celix_longHashMap_get(tracker->trackedServiceIds, svcId);
+    if (remove != NULL) {
+        //remove from trackedServices to prevent getting this service, but don't destroy yet, can be in use
+        celix_arrayList_remove(tracker->trackedServices, remove);
+        celix_longHashMap_remove(tracker->trackedServiceIds, svcId);
+        if (pending->untracked == NULL) {
+            pending->untracked = celix_arrayList_create();
         }
+        celix_arrayList_add(pending->untracked, remove); //note announced by serviceTracker_announcePending
+        tracker->untrackedServiceCount++;
+    }
+    celixThreadMutex_unlock(&tracker->mutex);
+}
+
+/**
+ * @brief Publishes a snapshot for and invokes the callbacks of the pending tracked and untracked services of a batch.
+ *
+ * For a batch of service events, the tracked and untracked services are pending till the last event of the batch, so
+ * that the snapshot is published and the set callback is invoked once per batch.
+ * The pending tracked and untracked lists are destroyed.
+ */
+static void serviceTracker_announcePending(service_tracker_t *tracker, celix_service_tracker_pending_t *pending) {
+    celixThreadMutex_lock(&tracker->mutex);
+    //note taken under the tracker mutex, because a closing tracker can announce the pending entries of a batch
+    celix_array_list_t *tracked = pending->tracked;
+    celix_array_list_t *untracked = pending->untracked;
+    pending->tracked = NULL;
+    pending->untracked = NULL;
+    if (tracked != NULL || untracked != NULL) {
+        serviceTracker_publishSnapshot(tracker);
+    }
+    if (tracked != NULL) {
+        celixThreadCondition_broadcast(&tracker->condTracked);
     }
     int size = celix_arrayList_size(tracker->trackedServices); //updated size
     celixThreadMutex_unlock(&tracker->mutex);
 
-    //note also syncing on untracking entries, to ensure no untrack is parallel in progress
-    if (remove != NULL) {
-        serviceTracker_untrackTracked(tracker, remove, size, true);
+    if (tracked == NULL && untracked == NULL) {
+        return;
+    }
+
+    for (int i = 0; untracked != NULL && i < celix_arrayList_size(untracked); ++i) {
+        serviceTracker_invokeRemovingService(tracker, celix_arrayList_get(untracked, i));
+    }
+    if (tracker->set != NULL || tracker->setWithProperties != NULL || tracker->setWithOwner != NULL) {
+        if (size == 0) {
+            serviceTracker_checkAndInvokeSetService(tracker, NULL, NULL, NULL);
+        } else {
+            celix_serviceTracker_useHighestRankingService(tracker, NULL, 0, tracker, NULL, NULL,
+                                                          serviceTracker_checkAndInvokeSetService);
+        }
+    }
+    for (int i = 0; tracked != NULL && i < celix_arrayList_size(tracked); ++i) {
+        serviceTracker_invokeAddService(tracker, celix_arrayList_get(tracked, i));
+    }
+
+    if (untracked != NULL) {
+        int nrOfUntracked = celix_arrayList_size(untracked);
+        for (int i = 0; i < nrOfUntracked; ++i) {
+            celix_tracked_entry_t *remove = celix_arrayList_get(untracked, i);
+            bundleContext_ungetServiceReference(tracker->context, remove->reference);
+            tracked_release(remove);
+            //Wait till the useCount is 0, because the untrack should only return if the service is not used anymore.
+            tracked_waitAndDestroy(remove);
+        }
         celixThreadMutex_lock(&tracker->mutex);
-        tracker->untrackedServiceCount--;
+        tracker->untrackedServiceCount -= nrOfUntracked;
         celixThreadCondition_broadcast(&tracker->condUntracking);
         celixThreadMutex_unlock(&tracker->mutex);
-    } else {
-        //ensure no untrack is still happening (to ensure it safe to unregister service)
-        celixThreadMutex_lock(&tracker->mutex);
-        while (tracker->untrackedServiceCount > 0) {
-            celixThreadCondition_wait(&tracker->condUntracking, &tracker->mutex);
-        }
-        celixThreadMutex_unlock(&tracker->mutex);
+        celix_arrayList_destroy(untracked);
+    }
+    if (tracked != NULL) {
+        celix_arrayList_destroy(tracked);
     }
-
-    framework_logIfError(tracker->context->framework->logger, status, NULL, "Cannot untrack reference");
-
-    return status;
 }
 
 static void serviceTracker_untrackTracked(service_tracker_t *tracker, celix_tracked_entry_t *tracked, int trackedSize, bool set) {
@@ -680,8 +869,11 @@ celix_service_tracker_t* celix_serviceTracker_createWithOptions(
     celixThreadCondition_init(&tracker->condTracked, NULL);
     celixThreadCondition_init(&tracker->condUntracking, NULL);
     tracker->trackedServices = celix_arrayList_create();
+    tracker->trackedServiceIds = celix_longHashMap_create();
+    tracker->snapshot.current = tracked_createSnapshot(tracker->trackedServices);
     tracker->untrackedServiceCount = 0;
     tracker->currentHighestServiceId = -1;
+    tracker->pendingBatches = celix_longHashMap_create();
 
     tracker->listener.handle = tracker;
     tracker->listener.serviceChanged = (void *) serviceTracker_serviceChanged;
@@ -708,52 +900,77 @@ bool celix_serviceTracker_useHighestRankingService(service_tracker_t *tracker,
     celix_tracked_entry_t *tracked = NULL;
     celix_tracked_entry_t *highest = NULL;
     unsigned int i;
-    struct timespec begin = celix_gettime(CLOCK_MONOTONIC);
+
+    //first try to get and retain the highest tracked entry from the snapshot, without locking the tracker
+    size_t *readerCount = NULL;
+    celix_tracked_snapshot_t *snapshot = serviceTracker_enterSnapshot(tracker, &readerCount);
+    highest = snapshot->highest;
+    if (highest != NULL && serviceName != NULL && (highest->serviceName == NULL || !celix_utils_stringEquals(highest->serviceName, serviceName))) {
+        //note the highest entry has another service name, search the highest entry for the service name
+        highest = NULL;
+        for (int k = 0; k < snapshot->size; ++k) {
+            tracked = snapshot->entries[k];
+            if (tracked->serviceName != NULL && celix_utils_stringEquals(tracked->serviceName, serviceName) &&
+                (highest == NULL || celix_utils_compareServiceIdsAndRanking(
+                    tracked->serviceId, tracked->serviceRanking,
+                    highest->serviceId, highest->serviceRanking) < 0)) {
+                highest = tracked;
+            }
+        }
+    }
+    if (highest != NULL) {
+        tracked_retain(highest);
+    }
+    serviceTracker_exitSnapshot(readerCount);
+
     double remaining = waitTimeoutInSeconds > INT_MAX ? INT_MAX : waitTimeoutInSeconds;
     remaining = remaining < 0 ? 0 : remaining;
     double elapsed = 0;
     long seconds = remaining;
     long nanoseconds = (remaining - seconds) * CELIX_NS_IN_SEC;
 
-    //first lock tracker and get highest tracked entry
-    celixThreadMutex_lock(&tracker->mutex);
-    while (highest == NULL) {
-        unsigned int size = arrayList_size(tracker->trackedServices);
-
-        for (i = 0; i < size; i++) {
-            tracked = (celix_tracked_entry_t *) arrayList_get(tracker->trackedServices, i);
-            if (serviceName == NULL || (serviceName != NULL && tracked->serviceName != NULL &&
-                                        celix_utils_stringEquals(tracked->serviceName, serviceName))) {
-                if (highest == NULL) {
-                    highest = tracked;
-                } else {
-                    int compare = celix_utils_compareServiceIdsAndRanking(
-                            tracked->serviceId, tracked->serviceRanking,
-                            highest->serviceId, highest->serviceRanking
-                    );
-                    if (compare < 0) {
+    if (highest == NULL && (seconds > 0 || nanoseconds > 0)) {
+        //no service yet, lock tracker and wait for the highest tracked entry
+        struct timespec begin = celix_gettime(CLOCK_MONOTONIC);
+        celixThreadMutex_lock(&tracker->mutex);
+        while (highest == NULL) {
+            unsigned int size = arrayList_size(tracker->trackedServices);
+
+            for (i = 0; i < size; i++) {
+                tracked = (celix_tracked_entry_t *) arrayList_get(tracker->trackedServices, i);
+                if (serviceName == NULL || (serviceName != NULL && tracked->serviceName != NULL &&
+                                            celix_utils_stringEquals(tracked->serviceName, serviceName))) {
+                    if (highest == NULL) {
                         highest = tracked;
+                    } else {
+                        int compare = celix_utils_compareServiceIdsAndRanking(
+                                tracked->serviceId, tracked->serviceRanking,
+                                highest->serviceId, highest->serviceRanking
+                        );
+                        if (compare < 0) {
+                            highest = tracked;
+                        }
                     }
                 }
             }
+            if(highest == NULL && (seconds > 0 || nanoseconds > 0)) {
+                celixThreadCondition_timedwaitRelative(&tracker->condTracked, &tracker->mutex, seconds, nanoseconds);
+                elapsed  = celix_elapsedtime(CLOCK_MONOTONIC, begin);
+                remaining = remaining > elapsed ? (remaining - elapsed) : 0;
+                seconds = remaining;
+                nanoseconds = (remaining - seconds) * CELIX_NS_IN_SEC;
+            } else {
+                // highest found or timeout
+                break;
+            }
         }
-        if(highest == NULL && (seconds > 0 || nanoseconds > 0)) {
-            celixThreadCondition_timedwaitRelative(&tracker->condTracked, &tracker->mutex, seconds, nanoseconds);
-            elapsed  = celix_elapsedtime(CLOCK_MONOTONIC, begin);
-            remaining = remaining > elapsed ? (remaining - elapsed) : 0;
-            seconds = remaining;
-            nanoseconds = (remaining - seconds) * CELIX_NS_IN_SEC;
-        } else {
-            // highest found or timeout
-            break;
+        if (highest != NULL) {
+            //highest found, increase use count
+            tracked_retain(highest);
         }
+        //unlock tracker so that the tracked entry can be removed from the trackedServices list if unregistered.
+        celixThreadMutex_unlock(&tracker->mutex);
     }
-    if (highest != NULL) {
-        //highest found lock tracked entry and increase use count
-        tracked_retain(highest);
-    }
-    //unlock tracker so that the tracked entry can be removed from the trackedServices list if unregistered.
-    celixThreadMutex_unlock(&tracker->mutex);
 
     if (highest != NULL) {
         //got service, call, decrease use count an signal useCond after.
@@ -781,18 +998,19 @@ size_t celix_serviceTracker_useServices(
         void (*useWithProperties)(void *handle, void *svc, const celix_properties_t *props),
         void (*useWithOwner)(void *handle, void *svc, const celix_properties_t *props, const celix_bundle_t *owner)) {
     size_t count = 0;
-    //first lock tracker, get tracked entries and increase use count
-    celixThreadMutex_lock(&tracker->mutex);
-    int size = celix_arrayList_size(tracker->trackedServices);
+    //first get the tracked entries from the snapshot and increase use count
+    size_t *readerCount = NULL;
+    celix_tracked_snapshot_t *snapshot = serviceTracker_enterSnapshot(tracker, &readerCount);
+    int size = snapshot->size;
     count = (size_t)size;
     celix_tracked_entry_t *entries[size];
     for (int i = 0; i < size; i++) {
-        celix_tracked_entry_t *tracked = (celix_tracked_entry_t *) arrayList_get(tracker->trackedServices, i);
+        celix_tracked_entry_t *tracked = snapshot->entries[i];
         tracked_retain(tracked);
         entries[i] = tracked;
     }
-    //unlock tracker so that the tracked entry can be removed from the trackedServices list if unregistered.
-    celixThreadMutex_unlock(&tracker->mutex);
+    //leave the snapshot so that the tracked entry can be removed from the trackedServices list if unregistered.
+    serviceTracker_exitSnapshot(readerCount);
 
     //then use entries and decrease use count
     for (int i = 0; i < size; i++) {
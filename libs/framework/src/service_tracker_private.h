@@ -22,6 +22,38 @@
 
 #include "service_tracker.h"
 #include "celix_types.h"
+#include "celix_long_hash_map.h"
+
+/**
+ * @brief The number of reader counters (per epoch) of the tracked services snapshot.
+ * Readers are spread over the counters, so that concurrent readers do not contend on a single cache line.
+ */
+#define CELIX_SERVICE_TRACKER_READER_STRIPES 16
+
+typedef struct celix_tracked_entry celix_tracked_entry_t;
+
+/**
+ * @brief The tracked and untracked entries of a service event batch, for which the snapshot and callbacks are deferred
+ * till the end of the batch.
+ */
+typedef struct celix_service_tracker_pending {
+    celix_array_list_t *tracked; //NULL if there are no pending tracked entries
+    celix_array_list_t *untracked; //NULL if there are no pending untracked entries
+} celix_service_tracker_pending_t;
+
+/**
+ * @brief Immutable snapshot of the tracked services, replaced when a service is tracked or untracked.
+ */
+typedef struct celix_tracked_snapshot {
+    celix_tracked_entry_t *highest; //the highest ranking entry, NULL if there are no tracked services
+    int size;
+    celix_tracked_entry_t *entries[]; //in tracking order
+} celix_tracked_snapshot_t;
+
+typedef struct celix_tracked_readers {
+    size_t count[2]; //the nr of readers per epoch
+    char padding[64 - 2 * sizeof(size_t)]; //note keep stripes on separate cache lines
+} celix_tracked_readers_t;
 
 enum celix_service_tracker_state {
     CELIX_SERVICE_TRACKER_OPENING,
@@ -68,11 +100,24 @@ struct celix_serviceTracker {
     celix_thread_cond_t  condUntracking;
     celix_array_list_t *trackedServices;
     size_t untrackedServiceCount;
+    celix_long_hash_map_t *trackedServiceIds; //key = service id, value = tracked entry in trackedServices
     enum celix_service_tracker_state state;
     long currentHighestServiceId;
+    celix_long_hash_map_t *pendingBatches; //key = service event batch id, value = celix_service_tracker_pending_t* of an in progress batch (freed by the last event of the batch)
+
+    /**
+     * RCU-style snapshot of trackedServices, so that the use calls do not need to lock the tracker mutex.
+     * The snapshot is replaced with the tracker mutex locked, the replaced snapshot is freed when all readers which
+     * entered before the replacement have left (all reader counts of the previous epochs are 0).
+     */
+    struct {
+        celix_tracked_snapshot_t *current; //atomic
+        size_t epoch; //atomic, the reader count index (0 or 1) used by new readers
+        celix_tracked_readers_t readers[CELIX_SERVICE_TRACKER_READER_STRIPES];
+    } snapshot;
 };
 
-typedef struct celix_tracked_entry {
+struct celix_tracked_entry {
 	service_reference_pt reference;
 	void *service;
     long serviceId; //cached service.id of the service
@@ -81,10 +126,10 @@ typedef struct celix_tracked_entry {
 	properties_t *properties;
 	bundle_t *serviceOwner;
 
-    celix_thread_mutex_t mutex; //protects useCount
+    celix_thread_mutex_t mutex; //used to wait for a useCount of 0
 	celix_thread_cond_t useCond;
-    size_t useCount;
-} celix_tracked_entry_t;
+    size_t useCount; //atomic
+};
 
 
 #endif /* SERVICE_TRACKER_PRIVATE_H_ */
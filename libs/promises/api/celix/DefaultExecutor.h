@@ -19,7 +19,9 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <future>
+#include <mutex>
 #include <random>
 
 #include "celix/IExecutor.h"
@@ -29,6 +31,9 @@ namespace celix {
     /**
      * Simple default executor which uses std::async to run tasks.
      * Does not support priority argument.
+     *
+     * @note Every task runs on its own thread. For many short tasks (e.g. long promise chains) the
+     * celix::ThreadPoolExecutor is more efficient.
      */
     class DefaultExecutor : public celix::IExecutor {
     public:
@@ -36,22 +41,33 @@ namespace celix {
 
         void execute(int /*priority*/, std::function<void()> task) override {
             std::lock_guard lck{mutex};
-            futures.emplace_back(std::async(policy, [task = std::move(task)]() mutable {
-                task();
+            futures.emplace_back(std::async(policy, [this, task = std::move(task)]() mutable {
+                try {
+                    task();
+                } catch (...) {
+                    task = nullptr;
+                    taskDone();
+                    throw;
+                }
                 task = nullptr; //to ensure captures of task go out of scope
+                taskDone();
             }));
+            running += 1;
             removeCompletedFutures();
         }
 
         void wait() override {
-            bool done = false;
-            while (!done) {
-                std::lock_guard lck{mutex};
-                removeCompletedFutures();
-                done = futures.empty();
-            }
+            std::unique_lock lck{mutex};
+            cond.wait(lck, [this]{ return running == 0; });
+            removeCompletedFutures();
         }
     private:
+        void taskDone() {
+            std::lock_guard lck{mutex};
+            running -= 1;
+            cond.notify_all();
+        }
+
         void removeCompletedFutures() {
             //note should be called while mutex is lock.
             auto it = futures.begin();
@@ -67,7 +83,9 @@ namespace celix {
         }
 
         const std::launch policy;
-        std::mutex mutex{}; //protect futures.
+        std::mutex mutex{}; //protect futures and running.
+        std::condition_variable cond{};
         std::vector<std::future<void>> futures{};
+        std::size_t running{0};
     };
 }
\ No newline at end of file
@@ -19,15 +19,25 @@
 
 #pragma once
 
-#include <memory>
-#include <future>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
-#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "celix/IScheduledExecutor.h"
 
 namespace celix {
 
+    namespace impl {
+        class TimerWheel;
+    }
+
     class DefaultDelayedScheduledFuture : public celix::IScheduledFuture {
     public:
         explicit DefaultDelayedScheduledFuture(std::chrono::duration<double, std::milli> _delayInMs) : delayInMs{_delayInMs} {}
@@ -50,14 +60,7 @@ namespace celix {
             cond.notify_all();
         }
 
-        void cancel() override {
-            std::lock_guard lock{mutex};
-            if (!done) {
-                cancelled = true;
-                done = true;
-            }
-            cond.notify_all();
-        }
+        void cancel() override;
 
         std::chrono::duration<double, std::milli> getDelayInMs() const {
             return delayInMs;
@@ -68,74 +71,218 @@ namespace celix {
             cond.wait_for(lock, time);
         }
     private:
+        friend class celix::impl::TimerWheel;
+
         const std::chrono::duration<double, std::milli> delayInMs;
         mutable std::mutex mutex{}; //protects below
         std::condition_variable cond{};
         bool cancelled{false};
         bool done{false};
+        std::weak_ptr<celix::impl::TimerWheel> wheel{};
+
+        //note protected by the mutex of the timer wheel
+        std::uint64_t deadlineTick{0};
+        std::function<void()> task{};
     };
 
+    namespace impl {
+        /**
+         * @brief Hashed timer wheel with a tick of 1ms, run by a single timer thread.
+         *
+         * A timer is stored in the slot of its deadline tick, a slot can contain timers of later rounds of the wheel.
+         * The timer thread sleeps until the tick of the next non-empty slot, instead of polling.
+         */
+        class TimerWheel : public std::enable_shared_from_this<TimerWheel> {
+        public:
+            static constexpr std::size_t SLOT_COUNT = 512;
+
+            TimerWheel() = default;
+
+            void schedule(const std::shared_ptr<DefaultDelayedScheduledFuture>& future, std::function<void()> task) {
+                //note rounded up, so that a task never runs before its delay
+                auto delayInTicks = (std::int64_t)std::ceil(std::max(0.0, future->getDelayInMs().count()));
+                std::lock_guard lck{mutex};
+                if (!thread.joinable()) {
+                    thread = std::thread{&TimerWheel::run, this};
+                }
+                auto deadline = ticksSinceStart() + delayInTicks;
+                future->deadlineTick = std::max<std::uint64_t>(deadline, processedTick + 1);
+                future->task = std::move(task);
+                future->wheel = weak_from_this();
+                slots[future->deadlineTick % SLOT_COUNT].emplace_back(future);
+                pending += 1;
+                if (future->deadlineTick < wakeupTick) {
+                    cond.notify_all();
+                }
+            }
+
+            void cancel(DefaultDelayedScheduledFuture* future) {
+                std::function<void()> task{};
+                {
+                    std::lock_guard lck{mutex};
+                    auto& slot = slots[future->deadlineTick % SLOT_COUNT];
+                    auto it = std::find_if(slot.begin(), slot.end(), [future](const auto& f) { return f.get() == future; });
+                    if (it == slot.end()) {
+                        //note the task is already taken by the timer thread
+                        return;
+                    }
+                    task = std::move(future->task);
+                    slot.erase(it);
+                    pending -= 1;
+                    cond.notify_all();
+                }
+                //note the captures of the task go out of scope outside the wheel lock
+            }
+
+            void wait() {
+                std::unique_lock lck{mutex};
+                cond.wait(lck, [this]{ return pending == 0; });
+            }
+
+            void stop() {
+                {
+                    std::unique_lock lck{mutex};
+                    cond.wait(lck, [this]{ return pending == 0; });
+                    active = false;
+                    cond.notify_all();
+                }
+                if (thread.joinable()) {
+                    thread.join();
+                }
+            }
+        private:
+            std::uint64_t ticksSinceStart() const {
+                return (std::uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            }
+
+            void collectExpired(std::uint64_t now, std::vector<std::shared_ptr<DefaultDelayedScheduledFuture>>& expired) {
+                //note should be called while mutex is lock.
+                std::uint64_t first = processedTick + 1;
+                std::uint64_t last = std::min(now, processedTick + SLOT_COUNT);
+                for (std::uint64_t tick = first; tick <= last; ++tick) {
+                    auto& slot = slots[tick % SLOT_COUNT];
+                    auto it = slot.begin();
+                    while (it != slot.end()) {
+                        if ((*it)->deadlineTick <= now) {
+                            expired.emplace_back(std::move(*it));
+                            it = slot.erase(it);
+                        } else {
+                            ++it;
+                        }
+                    }
+                }
+                processedTick = now;
+            }
+
+            std::uint64_t nextWakeupTick() const {
+                //note should be called while mutex is lock.
+                for (std::uint64_t tick = processedTick + 1; tick <= processedTick + SLOT_COUNT; ++tick) {
+                    if (!slots[tick % SLOT_COUNT].empty()) {
+                        return tick;
+                    }
+                }
+                return UINT64_MAX;
+            }
+
+            void run() {
+                std::vector<std::shared_ptr<DefaultDelayedScheduledFuture>> expired{};
+                std::unique_lock lck{mutex};
+                while (active) {
+                    collectExpired(ticksSinceStart(), expired);
+                    if (!expired.empty()) {
+                        lck.unlock();
+                        for (auto& future : expired) {
+                            if (!future->isCancelled()) {
+                                try {
+                                    future->task();
+                                } catch (...) {
+                                    //note exceptions of a scheduled task are dropped
+                                }
+                            }
+                            future->task = nullptr; //to ensure captures of task go out of scope
+                            future->setDone();
+                        }
+                        auto count = expired.size();
+                        expired.clear();
+                        lck.lock();
+                        pending -= count;
+                        cond.notify_all();
+                        continue;
+                    }
+                    wakeupTick = nextWakeupTick();
+                    if (wakeupTick == UINT64_MAX) {
+                        cond.wait(lck);
+                    } else {
+                        cond.wait_until(lck, start + std::chrono::milliseconds{(std::int64_t)wakeupTick});
+                    }
+                    wakeupTick = UINT64_MAX;
+                }
+            }
+
+            const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+            std::mutex mutex{}; //protects below
+            std::condition_variable cond{};
+            std::vector<std::vector<std::shared_ptr<DefaultDelayedScheduledFuture>>> slots{SLOT_COUNT};
+            std::uint64_t processedTick{0};
+            std::uint64_t wakeupTick{UINT64_MAX};
+            std::size_t pending{0};
+            bool active{true};
+            std::thread thread{};
+        };
+    }
+
+    inline void DefaultDelayedScheduledFuture::cancel() {
+        {
+            std::lock_guard lock{mutex};
+            if (!done) {
+                cancelled = true;
+                done = true;
+            }
+            cond.notify_all();
+        }
+        auto w = wheel.lock();
+        if (w) {
+            w->cancel(this);
+        }
+    }
+
     /**
-     * @brief Simple default scheduled executor which uses std::async to run delayed tasks and steady_clock to measure delay.
+     * @brief Default scheduled executor which uses a timer wheel to run delayed tasks and steady_clock to measure delay.
      *
+     * All delayed tasks are run by a single timer thread (started on the first schedule call) with a resolution of
+     * 1ms, so tasks should be short; e.g. resolving a deferred, which runs its callbacks on the promise executor.
      * Does not support priority argument.
      */
     class DefaultScheduledExecutor : public celix::IScheduledExecutor {
     public:
+        DefaultScheduledExecutor() = default;
+
+        /**
+         * @brief Waits for the scheduled tasks and stops the timer thread.
+         */
+        ~DefaultScheduledExecutor() noexcept override {
+            wheel->stop();
+        }
+
+        DefaultScheduledExecutor(DefaultScheduledExecutor&&) = delete;
+        DefaultScheduledExecutor& operator=(DefaultScheduledExecutor&&) = delete;
+        DefaultScheduledExecutor(const DefaultScheduledExecutor&) = delete;
+        DefaultScheduledExecutor& operator=(const DefaultScheduledExecutor&) = delete;
+
         std::shared_ptr<celix::IScheduledFuture> scheduleInMilli(int /*priority*/, std::chrono::duration<double, std::milli> delay, std::function<void()> task) override {
             auto scheduledFuture = std::make_shared<DefaultDelayedScheduledFuture>(delay);
             try {
-                auto future = std::async(std::launch::async, [task = std::move(task), scheduledFuture] {
-                    auto startTime = std::chrono::steady_clock::now();
-                    auto t = std::chrono::steady_clock::now();
-                    while (!scheduledFuture->isCancelled() && std::chrono::duration_cast<std::chrono::milliseconds>(t - startTime) < scheduledFuture->getDelayInMs()) {
-                        auto timeLeft = scheduledFuture->getDelayInMs() - std::chrono::duration_cast<std::chrono::milliseconds>(t - startTime);
-                        scheduledFuture->waitFor(timeLeft);
-                        t = std::chrono::steady_clock::now();
-                    }
-                    if (!scheduledFuture->isCancelled()) {
-                        task();
-                    }
-                    scheduledFuture->setDone();
-                });
-                future.wait_for(std::chrono::seconds{0}); //trigger async execution
-                std::lock_guard<std::mutex> lck{mutex};
-                futures[scheduledFuture] = std::move(future);
-                removeCompletedFutures();
-                return scheduledFuture;
+                wheel->schedule(scheduledFuture, std::move(task));
             } catch (std::system_error& /*sysExp*/) {
                 throw celix::RejectedExecutionException{};
             }
+            return scheduledFuture;
         }
 
         void wait() override {
-            bool done = false;
-            while (!done) {
-                std::unique_lock lck{mutex};
-                removeCompletedFutures();
-                done = futures.empty();
-                if (!done) {
-                    cond.wait_for(lck, std::chrono::milliseconds{1});
-                }
-            }
+            wheel->wait();
         }
     private:
-        void removeCompletedFutures() {
-            //note should be called while mutex is lock.
-            auto it = futures.begin();
-            while (it != futures.end()) {
-                if (it->first->isDone()) {
-                    //remove scheduled future
-                    it = futures.erase(it);
-                    cond.notify_all();
-                } else {
-                    ++it;
-                }
-            }
-        }
-
-        std::mutex mutex{}; //protect futures.
-        std::condition_variable cond{};
-        std::unordered_map<std::shared_ptr<DefaultDelayedScheduledFuture>, std::future<void>> futures{};
+        const std::shared_ptr<celix::impl::TimerWheel> wheel{std::make_shared<celix::impl::TimerWheel>()};
     };
-}
\ No newline at end of file
+}
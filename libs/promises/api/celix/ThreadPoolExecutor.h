@@ -0,0 +1,218 @@
+/**
+ *Licensed to the Apache Software Foundation (ASF) under one
+ *or more contributor license agreements.  See the NOTICE file
+ *distributed with this work for additional information
+ *regarding copyright ownership.  The ASF licenses this file
+ *to you under the Apache License, Version 2.0 (the
+ *"License"); you may not use this file except in compliance
+ *with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing,
+ *software distributed under the License is distributed on an
+ *"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ *specific language governing permissions and limitations
+ *under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "celix/IExecutor.h"
+
+namespace celix {
+
+    /**
+     * @brief Executor with a fixed number of worker threads and a task queue per worker.
+     *
+     * Tasks executed from a worker thread (e.g. the continuations of a promise chain) are queued on the queue of that
+     * worker, other tasks are distributed round-robin over the worker queues. An idle worker steals tasks from the
+     * queues of the other workers.
+     *
+     * Supports the priority argument: a worker runs the task with the highest priority value of its queue first, and
+     * steals the task with the highest priority value of another queue. Tasks with the same priority run in LIFO order
+     * on the owning worker (which favors the continuations of the task just run) and are stolen in FIFO order.
+     *
+     * @note Tasks that block on other tasks of the same executor (e.g. by waiting on a promise) occupy a worker, so
+     * with a fixed number of workers this can deadlock. wait() must not be called from a task of the executor.
+     */
+    class ThreadPoolExecutor : public celix::IExecutor {
+    public:
+        /**
+         * @brief Create a thread pool executor.
+         * @param nrOfThreads The number of worker threads. If 0, std::thread::hardware_concurrency() is used.
+         * @param maxQueuedTasks The max number of queued (not yet running) tasks. If exceeded, execute throws a
+         * celix::RejectedExecutionException.
+         */
+        explicit ThreadPoolExecutor(std::size_t nrOfThreads = 0, std::size_t maxQueuedTasks = std::numeric_limits<std::size_t>::max()) :
+                maxQueued{maxQueuedTasks} {
+            if (nrOfThreads == 0) {
+                nrOfThreads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            workers.reserve(nrOfThreads);
+            for (std::size_t i = 0; i < nrOfThreads; ++i) {
+                workers.emplace_back(std::make_unique<Worker>());
+            }
+            for (std::size_t i = 0; i < nrOfThreads; ++i) {
+                workers[i]->thread = std::thread{&ThreadPoolExecutor::run, this, i};
+            }
+        }
+
+        /**
+         * @brief Runs the queued tasks and stops the worker threads.
+         */
+        ~ThreadPoolExecutor() noexcept override {
+            {
+                std::lock_guard lck{sleepMutex};
+                active = false;
+            }
+            sleepCond.notify_all();
+            for (auto& worker : workers) {
+                worker->thread.join();
+            }
+        }
+
+        ThreadPoolExecutor(ThreadPoolExecutor&&) = delete;
+        ThreadPoolExecutor& operator=(ThreadPoolExecutor&&) = delete;
+        ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+        ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+        using celix::IExecutor::execute;
+
+        void execute(int priority, std::function<void()> task) override {
+            if (!active.load(std::memory_order_relaxed) && currentWorker.pool != this) {
+                //note while stopping, the running tasks can still execute tasks (e.g. promise continuations)
+                throw celix::RejectedExecutionException{};
+            }
+            if (queued.fetch_add(1) >= maxQueued) {
+                queued.fetch_sub(1);
+                throw celix::RejectedExecutionException{};
+            }
+            pending.fetch_add(1);
+            Worker* worker = currentWorker.pool == this ? currentWorker.worker : nullptr;
+            if (worker == nullptr) {
+                worker = workers[nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size()].get();
+            }
+            {
+                std::lock_guard lck{worker->mutex};
+                worker->tasks[priority].emplace_back(std::move(task));
+            }
+            if (idleWorkers.load() > 0) {
+                //note the sleep mutex ensures the notification is not lost for a worker which is about to sleep
+                { std::lock_guard lck{sleepMutex}; }
+                sleepCond.notify_one();
+            }
+        }
+
+        void wait() override {
+            std::unique_lock lck{idleMutex};
+            idleCond.wait(lck, [this]{ return pending.load() == 0; });
+        }
+
+        /**
+         * @brief The number of worker threads.
+         */
+        [[nodiscard]] std::size_t getNrOfThreads() const {
+            return workers.size();
+        }
+    private:
+        struct Worker {
+            std::thread thread{};
+            std::mutex mutex{}; //protects below
+            std::map<int, std::deque<std::function<void()>>, std::greater<>> tasks{}; //key is priority, highest first
+        };
+
+        struct CurrentWorker {
+            const ThreadPoolExecutor* pool;
+            Worker* worker;
+        };
+
+        static bool popTask(Worker& worker, bool steal, std::function<void()>& task) {
+            std::lock_guard lck{worker.mutex};
+            auto it = worker.tasks.begin();
+            if (it == worker.tasks.end()) {
+                return false;
+            }
+            auto& queue = it->second;
+            if (steal) {
+                task = std::move(queue.front());
+                queue.pop_front();
+            } else {
+                task = std::move(queue.back());
+                queue.pop_back();
+            }
+            if (queue.empty()) {
+                worker.tasks.erase(it);
+            }
+            return true;
+        }
+
+        bool nextTask(std::size_t index, std::function<void()>& task) {
+            if (popTask(*workers[index], false, task)) {
+                return true;
+            }
+            for (std::size_t i = 1; i < workers.size(); ++i) {
+                if (popTask(*workers[(index + i) % workers.size()], true, task)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void run(std::size_t index) {
+            currentWorker = CurrentWorker{this, workers[index].get()};
+            std::function<void()> task{};
+            while (true) {
+                if (nextTask(index, task)) {
+                    queued.fetch_sub(1);
+                    try {
+                        task();
+                    } catch (...) {
+                        //note same as the DefaultExecutor, exceptions of a task are dropped
+                    }
+                    task = nullptr; //to ensure captures of task go out of scope
+                    if (pending.fetch_sub(1) == 1) {
+                        { std::lock_guard lck{idleMutex}; }
+                        idleCond.notify_all();
+                    }
+                    continue;
+                }
+                std::unique_lock lck{sleepMutex};
+                idleWorkers.fetch_add(1);
+                sleepCond.wait(lck, [this]{ return !active.load() || queued.load() > 0; });
+                idleWorkers.fetch_sub(1);
+                if (!active.load() && queued.load() == 0) {
+                    break;
+                }
+            }
+            currentWorker = CurrentWorker{};
+        }
+
+        inline static thread_local CurrentWorker currentWorker{};
+
+        const std::size_t maxQueued;
+        std::vector<std::unique_ptr<Worker>> workers{};
+        std::atomic<std::size_t> nextWorker{0};
+        std::atomic<std::size_t> queued{0}; //tasks in the worker queues
+        std::atomic<std::size_t> pending{0}; //queued and running tasks
+        std::atomic<std::size_t> idleWorkers{0};
+        std::atomic<bool> active{true};
+        std::mutex sleepMutex{};
+        std::condition_variable sleepCond{};
+        std::mutex idleMutex{};
+        std::condition_variable idleCond{};
+    };
+}
@@ -0,0 +1,214 @@
+/**
+ *Licensed to the Apache Software Foundation (ASF) under one
+ *or more contributor license agreements.  See the NOTICE file
+ *distributed with this work for additional information
+ *regarding copyright ownership.  The ASF licenses this file
+ *to you under the Apache License, Version 2.0 (the
+ *"License"); you may not use this file except in compliance
+ *with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing,
+ *software distributed under the License is distributed on an
+ *"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ *specific language governing permissions and limitations
+ *under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "celix/IExecutor.h"
+
+namespace celix::impl {
+
+    /**
+     * @brief A type-erased `void()` callable for the continuations of a promise.
+     *
+     * Unlike std::function, callables up to BUFFER_SIZE bytes (e.g. a chain step capturing two promise states and a
+     * std::function) are stored inline, so registering a continuation does not allocate.
+     */
+    class Continuation {
+    public:
+        static constexpr std::size_t BUFFER_SIZE = 10 * sizeof(void*);
+
+        Continuation() = default;
+
+        template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Continuation>>>
+        Continuation(F&& f) { // NOLINT(google-explicit-constructor)
+            using Callable = std::decay_t<F>;
+            if constexpr (sizeof(Callable) <= BUFFER_SIZE && alignof(Callable) <= alignof(std::max_align_t)
+                    && std::is_nothrow_move_constructible_v<Callable>) {
+                new (&buffer) Callable(std::forward<F>(f));
+                ops = &inlineOps<Callable>;
+            } else {
+                *reinterpret_cast<Callable**>(&buffer) = new Callable(std::forward<F>(f));
+                ops = &heapOps<Callable>;
+            }
+        }
+
+        Continuation(const Continuation& other) {
+            if (other.ops) {
+                other.ops->copy(&buffer, &other.buffer);
+                ops = other.ops;
+            }
+        }
+
+        Continuation(Continuation&& other) noexcept {
+            if (other.ops) {
+                other.ops->move(&buffer, &other.buffer);
+                ops = other.ops;
+                other.reset();
+            }
+        }
+
+        Continuation& operator=(Continuation other) noexcept {
+            reset();
+            if (other.ops) {
+                other.ops->move(&buffer, &other.buffer);
+                ops = other.ops;
+                other.reset();
+            }
+            return *this;
+        }
+
+        ~Continuation() noexcept {
+            reset();
+        }
+
+        explicit operator bool() const {
+            return ops != nullptr;
+        }
+
+        void operator()() {
+            ops->invoke(&buffer);
+        }
+    private:
+        struct Ops {
+            void (*invoke)(void* self);
+            void (*copy)(void* dst, const void* src);
+            void (*move)(void* dst, void* src) noexcept;
+            void (*destroy)(void* self) noexcept;
+        };
+
+        template<typename Callable>
+        static constexpr Ops inlineOps{
+            [](void* self) { (*static_cast<Callable*>(self))(); },
+            [](void* dst, const void* src) { new (dst) Callable(*static_cast<const Callable*>(src)); },
+            [](void* dst, void* src) noexcept { new (dst) Callable(std::move(*static_cast<Callable*>(src))); },
+            [](void* self) noexcept { static_cast<Callable*>(self)->~Callable(); }
+        };
+
+        template<typename Callable>
+        static constexpr Ops heapOps{
+            [](void* self) { (**static_cast<Callable**>(self))(); },
+            [](void* dst, const void* src) { *static_cast<Callable**>(dst) = new Callable(**static_cast<Callable* const*>(src)); },
+            [](void* dst, void* src) noexcept { *static_cast<Callable**>(dst) = *static_cast<Callable**>(src); *static_cast<Callable**>(src) = nullptr; },
+            [](void* self) noexcept { delete *static_cast<Callable**>(self); }
+        };
+
+        void reset() noexcept {
+            if (ops) {
+                ops->destroy(&buffer);
+                ops = nullptr;
+            }
+        }
+
+        std::aligned_storage_t<BUFFER_SIZE, alignof(std::max_align_t)> buffer{};
+        const Ops* ops{nullptr};
+    };
+
+    /**
+     * @brief The continuations of a promise, the first one (the common case) is stored inline.
+     */
+    class ContinuationList {
+    public:
+        [[nodiscard]] bool empty() const {
+            return !first;
+        }
+
+        void push(Continuation&& continuation) {
+            if (!first) {
+                first = std::move(continuation);
+            } else {
+                more.emplace_back(std::move(continuation));
+            }
+        }
+
+        template<typename F>
+        void forEach(F&& f) {
+            if (first) {
+                f(first);
+            }
+            for (auto& continuation : more) {
+                f(continuation);
+            }
+        }
+
+        void swap(ContinuationList& other) noexcept {
+            std::swap(first, other.first);
+            more.swap(other.more);
+        }
+    private:
+        Continuation first{};
+        std::vector<Continuation> more{};
+    };
+
+    /**
+     * @brief The executor and priority of the promise task run by the current thread.
+     */
+    struct ExecutionContext {
+        const celix::IExecutor* executor;
+        int priority;
+        int inlineDepth;
+    };
+
+    inline thread_local ExecutionContext currentExecutionContext{nullptr, 0, 0};
+
+    /**
+     * @brief The max nesting of continuations run inline, so that resolving a long chain does not overflow the stack.
+     */
+    constexpr int MAX_INLINE_CONTINUATION_DEPTH = 16;
+
+    /**
+     * @brief Run a continuation of a promise with the executor and priority of the promise.
+     *
+     * If the current thread already runs a promise task of the same executor and priority, the continuation is run
+     * inline instead of being handed over to the executor. Otherwise it is executed on the executor, marking the
+     * executing thread, so that the continuations of the continuation can run inline.
+     */
+    inline void executeContinuation(const std::shared_ptr<celix::IExecutor>& executor, int priority, Continuation&& continuation) {
+        auto& ctx = currentExecutionContext;
+        if (ctx.executor == executor.get() && ctx.priority == priority && ctx.inlineDepth < MAX_INLINE_CONTINUATION_DEPTH) {
+            ++ctx.inlineDepth;
+            try {
+                continuation();
+            } catch (...) {
+                //note same as for a task on the executor, exceptions of a continuation are dropped
+            }
+            --ctx.inlineDepth;
+            return;
+        }
+        executor->execute(priority, [exec = executor.get(), priority, continuation = std::move(continuation)]() mutable {
+            auto& taskCtx = currentExecutionContext;
+            auto outer = taskCtx;
+            taskCtx = ExecutionContext{exec, priority, 0};
+            try {
+                continuation();
+            } catch (...) {
+                taskCtx = outer;
+                throw;
+            }
+            continuation = Continuation{}; //to ensure captures of the continuation go out of scope
+            taskCtx = outer;
+        });
+    }
+}
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <type_traits>
 #include <functional>
 #include <chrono>
@@ -34,6 +35,7 @@
 
 #include "celix/PromiseInvocationException.h"
 #include "celix/PromiseTimeoutException.h"
+#include "celix/impl/Continuation.h"
 
 namespace celix::impl {
 
@@ -41,9 +43,15 @@ namespace celix::impl {
     class SharedPromiseState {
         // Pointers make using promises properly unnecessarily complicated.
         static_assert(!std::is_pointer_v<T>, "Cannot use pointers with promises.");
+        struct PrivateTag { explicit PrivateTag() = default; };
     public:
         static std::shared_ptr<SharedPromiseState<T>> create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority);
 
+        /**
+         * @brief Use create, the constructor is only public for std::make_shared.
+         */
+        SharedPromiseState(PrivateTag, std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority);
+
         ~SharedPromiseState() noexcept = default;
 
         template<typename U>
@@ -101,7 +109,12 @@ namespace celix::impl {
         template<typename Rep, typename Period>
         std::shared_ptr<SharedPromiseState<T>> setTimeout(std::chrono::duration<Rep, Period> duration);
 
-        void addChain(std::function<void()> chainFunction);
+        /**
+         * @brief Add a continuation, which is run when the promise is resolved.
+         * @see celix::impl::executeContinuation for the execution policy.
+         */
+        template<typename F>
+        void addChain(F&& chainFunction);
 
         [[nodiscard]] std::shared_ptr<celix::IExecutor> getExecutor() const;
 
@@ -111,8 +124,6 @@ namespace celix::impl {
 
         [[nodiscard]] std::weak_ptr<SharedPromiseState<T>> getSelf() const;
     private:
-        explicit SharedPromiseState(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority);
-
         void setSelf(std::weak_ptr<SharedPromiseState<T>> self);
 
         /**
@@ -131,20 +142,27 @@ namespace celix::impl {
         const int priority;
         std::weak_ptr<SharedPromiseState<T>> self{};
 
+        std::atomic<bool> resolved{false}; //lock-free resolved fast path, set after exp and data are final
         mutable std::mutex mutex{}; //protects below
         mutable std::condition_variable cond{};
         bool done = false;
-        bool dataMoved = false;
-        std::vector<std::function<void()>> chain{}; //chain tasks are executed on thread pool.
+        std::atomic<bool> dataMoved{false};
+        ContinuationList chain{}; //chain tasks are executed on the executor, or inline (see executeContinuation).
         std::exception_ptr exp{nullptr};
         std::optional<T> data{};
     };
 
     template<>
     class SharedPromiseState<void> {
+        struct PrivateTag { explicit PrivateTag() = default; };
     public:
         static std::shared_ptr<SharedPromiseState<void>> create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority);
 
+        /**
+         * @brief Use create, the constructor is only public for std::make_shared.
+         */
+        SharedPromiseState(PrivateTag, std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority);
+
         ~SharedPromiseState() noexcept = default;
 
         bool tryResolve();
@@ -190,7 +208,12 @@ namespace celix::impl {
         template<typename Rep, typename Period>
         std::shared_ptr<SharedPromiseState<void>> setTimeout(std::chrono::duration<Rep, Period> duration);
 
-        void addChain(std::function<void()> chainFunction);
+        /**
+         * @brief Add a continuation, which is run when the promise is resolved.
+         * @see celix::impl::executeContinuation for the execution policy.
+         */
+        template<typename F>
+        void addChain(F&& chainFunction);
 
         [[nodiscard]] std::shared_ptr<celix::IExecutor> getExecutor() const;
 
@@ -200,8 +223,6 @@ namespace celix::impl {
 
         [[nodiscard]] std::weak_ptr<SharedPromiseState<void>> getSelf() const;
     private:
-        explicit SharedPromiseState(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority);
-
         void setSelf(std::weak_ptr<SharedPromiseState<void>> self);
 
         /**
@@ -220,10 +241,11 @@ namespace celix::impl {
         const int priority;
         std::weak_ptr<SharedPromiseState<void>> self{};
 
+        std::atomic<bool> resolved{false}; //lock-free resolved fast path, set after exp is final
         mutable std::mutex mutex{}; //protects below
         mutable std::condition_variable cond{};
         bool done = false;
-        std::vector<std::function<void()>> chain{}; //chain tasks are executed on thread pool.
+        ContinuationList chain{}; //chain tasks are executed on the executor, or inline (see executeContinuation).
         std::exception_ptr exp{nullptr};
     };
 }
@@ -235,21 +257,22 @@ namespace celix::impl {
 
 template<typename T>
 std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseState<T>::create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority) {
-    auto state = std::shared_ptr<celix::impl::SharedPromiseState<T>>{new celix::impl::SharedPromiseState<T>{std::move(_executor), std::move(_scheduledExecutor), priority}};
+    //note make_shared allocates the state and the control block at once
+    auto state = std::make_shared<celix::impl::SharedPromiseState<T>>(PrivateTag{}, std::move(_executor), std::move(_scheduledExecutor), priority);
     state->setSelf(state);
     return state;
 }
 
 inline std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::SharedPromiseState<void>::create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority) {
-    auto state = std::shared_ptr<celix::impl::SharedPromiseState<void>>{new celix::impl::SharedPromiseState<void>{std::move(_executor), std::move(_scheduledExecutor), priority}};
+    auto state = std::make_shared<celix::impl::SharedPromiseState<void>>(PrivateTag{}, std::move(_executor), std::move(_scheduledExecutor), priority);
     state->setSelf(state);
     return state;
 }
 
 template<typename T>
-celix::impl::SharedPromiseState<T>::SharedPromiseState(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority) : executor{std::move(_executor)}, scheduledExecutor{std::move(_scheduledExecutor)}, priority{_priority} {}
+celix::impl::SharedPromiseState<T>::SharedPromiseState(PrivateTag, std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority) : executor{std::move(_executor)}, scheduledExecutor{std::move(_scheduledExecutor)}, priority{_priority} {}
 
-inline celix::impl::SharedPromiseState<void>::SharedPromiseState(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority) : executor{std::move(_executor)}, scheduledExecutor{std::move(_scheduledExecutor)}, priority{_priority} {}
+inline celix::impl::SharedPromiseState<void>::SharedPromiseState(PrivateTag, std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority) : executor{std::move(_executor)}, scheduledExecutor{std::move(_scheduledExecutor)}, priority{_priority} {}
 
 template<typename T>
 void celix::impl::SharedPromiseState<T>::setSelf(std::weak_ptr<SharedPromiseState<T>> _self) {
@@ -343,24 +366,21 @@ bool celix::impl::SharedPromiseState<void>::tryFail(const E& e) {
 
 template<typename T>
 bool celix::impl::SharedPromiseState<T>::isDone() const {
-    std::lock_guard lck{mutex};
-    return done;
+    return resolved.load(std::memory_order_acquire);
 }
 
 inline bool celix::impl::SharedPromiseState<void>::isDone() const {
-    std::lock_guard lck{mutex};
-    return done;
+    return resolved.load(std::memory_order_acquire);
 }
 
 template<typename T>
 bool celix::impl::SharedPromiseState<T>::isSuccessfullyResolved() const {
-    std::lock_guard lck{mutex};
-    return done && !exp;
+    //note exp is not changed after the promise is resolved
+    return resolved.load(std::memory_order_acquire) && !exp;
 }
 
 inline bool celix::impl::SharedPromiseState<void>::isSuccessfullyResolved() const {
-    std::lock_guard lck{mutex};
-    return done && !exp;
+    return resolved.load(std::memory_order_acquire) && !exp;
 }
 
 
@@ -409,6 +429,9 @@ inline void celix::impl::SharedPromiseState<void>::waitForAndCheckData(std::uniq
 
 template<typename T>
 T& celix::impl::SharedPromiseState<T>::getValue() & {
+    if (resolved.load(std::memory_order_acquire) && !exp && !dataMoved.load(std::memory_order_relaxed)) {
+        return *data;
+    }
     std::unique_lock<std::mutex> lck{mutex};
     waitForAndCheckData(lck, true);
     return *data;
@@ -416,6 +439,9 @@ T& celix::impl::SharedPromiseState<T>::getValue() & {
 
 template<typename T>
 const T& celix::impl::SharedPromiseState<T>::getValue() const & {
+    if (resolved.load(std::memory_order_acquire) && !exp && !dataMoved.load(std::memory_order_relaxed)) {
+        return *data;
+    }
     std::unique_lock<std::mutex> lck{mutex};
     waitForAndCheckData(lck, true);
     return *data;
@@ -482,11 +508,17 @@ inline int celix::impl::SharedPromiseState<void>::getPriority() const {
 
 template<typename T>
 void celix::impl::SharedPromiseState<T>::wait() const {
+    if (resolved.load(std::memory_order_acquire)) {
+        return;
+    }
     std::unique_lock<std::mutex> lck{mutex};
     cond.wait(lck, [this]{return done;});
 }
 
 inline void celix::impl::SharedPromiseState<void>::wait() const {
+    if (resolved.load(std::memory_order_acquire)) {
+        return;
+    }
     std::unique_lock<std::mutex> lck{mutex};
     cond.wait(lck, [this]{return done;});
 }
@@ -712,38 +744,30 @@ inline std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::Share
 }
 
 template<typename T>
-void celix::impl::SharedPromiseState<T>::addChain(std::function<void()> chainFunction) {
-    std::function<void()> localChain{};
-    {
+template<typename F>
+void celix::impl::SharedPromiseState<T>::addChain(F&& chainFunction) {
+    celix::impl::Continuation continuation{std::forward<F>(chainFunction)};
+    if (!resolved.load(std::memory_order_acquire)) {
         std::lock_guard lck{mutex};
         if (!done) {
-            chain.emplace_back([func = std::move(chainFunction)]() {
-                func();
-            });
-        } else {
-            localChain = std::move(chainFunction);
+            chain.push(std::move(continuation));
+            return;
         }
     }
-    if (localChain) {
-        executor->execute(priority, std::move(localChain));
-    }
+    celix::impl::executeContinuation(executor, priority, std::move(continuation));
 }
 
-inline void celix::impl::SharedPromiseState<void>::addChain(std::function<void()> chainFunction) {
-    std::function<void()> localChain{};
-    {
+template<typename F>
+void celix::impl::SharedPromiseState<void>::addChain(F&& chainFunction) {
+    celix::impl::Continuation continuation{std::forward<F>(chainFunction)};
+    if (!resolved.load(std::memory_order_acquire)) {
         std::lock_guard lck{mutex};
         if (!done) {
-            chain.emplace_back([func = std::move(chainFunction)]() {
-                func();
-            });
-        } else {
-            localChain = std::move(chainFunction);
+            chain.push(std::move(continuation));
+            return;
         }
     }
-    if (localChain) {
-        executor->execute(priority, std::move(localChain));
-    }
+    celix::impl::executeContinuation(executor, priority, std::move(continuation));
 }
 
 template<typename T>
@@ -925,17 +949,15 @@ void celix::impl::SharedPromiseState<T>::complete(std::unique_lock<std::mutex>&
     }
     if (!done) {
         done = true;
+        resolved.store(true, std::memory_order_release);
         cond.notify_all();
-        while (!chain.empty()) {
-            std::vector<std::function<void()>> localChains{};
-            localChains.swap(chain);
-            lck.unlock();
-            for (auto &chainTask: localChains) {
-                executor->execute(priority, std::move(chainTask));
-            }
-            localChains.clear();
-            lck.lock();
-        }
+        //note no continuations are added after done is set
+        ContinuationList localChains{};
+        localChains.swap(chain);
+        lck.unlock();
+        localChains.forEach([this](celix::impl::Continuation& chainTask) {
+            celix::impl::executeContinuation(executor, priority, std::move(chainTask));
+        });
     }
 }
 
@@ -945,16 +967,14 @@ inline void celix::impl::SharedPromiseState<void>::complete(std::unique_lock<std
     }
     if (!done) {
         done = true;
+        resolved.store(true, std::memory_order_release);
         cond.notify_all();
-        while (!chain.empty()) {
-            std::vector<std::function<void()>> localChains{};
-            localChains.swap(chain);
-            lck.unlock();
-            for (auto &chainTask: localChains) {
-                executor->execute(priority, std::move(chainTask));
-            }
-            localChains.clear();
-            lck.lock();
-        }
+        //note no continuations are added after done is set
+        ContinuationList localChains{};
+        localChains.swap(chain);
+        lck.unlock();
+        localChains.forEach([this](celix::impl::Continuation& chainTask) {
+            celix::impl::executeContinuation(executor, priority, std::move(chainTask));
+        });
     }
 }
\ No newline at end of file
@@ -0,0 +1,200 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "celix/DefaultExecutor.h"
+#include "celix/DefaultScheduledExecutor.h"
+#include "celix/PromiseFactory.h"
+#include "celix/ThreadPoolExecutor.h"
+
+namespace {
+    std::atomic<size_t> allocations{0};
+}
+
+//note counts the heap allocations of the benchmarks
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc{};
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+    enum class ExecutorType {
+        Default,
+        ThreadPool,
+    };
+
+    std::shared_ptr<celix::IExecutor> createExecutor(ExecutorType type) {
+        if (type == ExecutorType::ThreadPool) {
+            return std::make_shared<celix::ThreadPoolExecutor>();
+        }
+        return std::make_shared<celix::DefaultExecutor>();
+    }
+}
+
+/**
+ * Chains of promise steps, where every step is run as a task on the executor of the promise factory.
+ * Note that a Promise::then step returning a promise is the flatMap of the OSGi promises specification.
+ */
+class PromiseChainBenchmark {
+public:
+    explicit PromiseChainBenchmark(ExecutorType type) :
+            executor{createExecutor(type)},
+            factory{executor, std::make_shared<celix::DefaultScheduledExecutor>()} {}
+
+    ~PromiseChainBenchmark() {
+        executor->wait();
+    }
+
+    PromiseChainBenchmark(PromiseChainBenchmark&&) = delete;
+    PromiseChainBenchmark& operator=(PromiseChainBenchmark&&) = delete;
+    PromiseChainBenchmark(const PromiseChainBenchmark&) = delete;
+    PromiseChainBenchmark& operator=(const PromiseChainBenchmark&) = delete;
+
+    std::shared_ptr<celix::IExecutor> executor;
+    celix::PromiseFactory factory;
+};
+
+template<ExecutorType type>
+static void PromiseChainBenchmark_map(benchmark::State& state) {
+    PromiseChainBenchmark benchmark{type};
+    for (auto _ : state) {
+        auto deferred = benchmark.factory.deferred<long>();
+        auto promise = deferred.getPromise();
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            promise = promise.map<long>([](long v) { return v + 1; });
+        }
+        deferred.resolve(0);
+        benchmark::DoNotOptimize(promise.getValue());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<ExecutorType type>
+static void PromiseChainBenchmark_thenAccept(benchmark::State& state) {
+    PromiseChainBenchmark benchmark{type};
+    for (auto _ : state) {
+        auto deferred = benchmark.factory.deferred<long>();
+        auto promise = deferred.getPromise();
+        long sum = 0;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            promise = promise.thenAccept([&sum](long v) { sum += v; });
+        }
+        deferred.resolve(1);
+        promise.wait();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<ExecutorType type>
+static void PromiseChainBenchmark_flatMap(benchmark::State& state) {
+    PromiseChainBenchmark benchmark{type};
+    auto& factory = benchmark.factory;
+    for (auto _ : state) {
+        auto deferred = factory.deferred<long>();
+        auto promise = deferred.getPromise();
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            promise = promise.then<long>([&factory](celix::Promise<long> p) {
+                return factory.resolved<long>(p.getValue() + 1);
+            });
+        }
+        deferred.resolve(0);
+        benchmark::DoNotOptimize(promise.getValue());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<ExecutorType type>
+static void PromiseChainBenchmark_parallelChains(benchmark::State& state) {
+    PromiseChainBenchmark benchmark{type};
+    for (auto _ : state) {
+        std::vector<celix::Promise<long>> promises{};
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            celix::Promise<long> promise = benchmark.factory.deferredTask<long>([i](auto d) { d.resolve(i); });
+            for (int j = 0; j < 8; ++j) {
+                promise = promise.map<long>([](long v) { return v + 1; });
+            }
+            promises.emplace_back(std::move(promise));
+        }
+        for (auto& promise : promises) {
+            benchmark::DoNotOptimize(promise.getValue());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 9);
+}
+
+/**
+ * A short pipeline on a resolved promise (map, filter and thenAccept), created and consumed by a promise continuation,
+ * e.g. the handling of a remote call result. Reports the heap allocations per pipeline.
+ */
+template<ExecutorType type>
+static void PromiseChainBenchmark_shortPipelineInTask(benchmark::State& state) {
+    PromiseChainBenchmark benchmark{type};
+    auto& factory = benchmark.factory;
+    std::promise<void> done{};
+    size_t allocs = 0;
+    //note the pipeline is run from a continuation, so the continuations of the resolved promises run inline
+    factory.resolved().thenAccept([&] {
+        for (auto _ : state) {
+            auto before = allocations.load(std::memory_order_relaxed);
+            long sum = 0;
+            auto p = factory.resolved<long>(42)
+                    .map<long>([](long v) { return v * 2; })
+                    .filter([](long v) { return v > 0; })
+                    .thenAccept([&sum](long v) { sum += v; });
+            benchmark::DoNotOptimize(p.getValue());
+            allocs += allocations.load(std::memory_order_relaxed) - before;
+        }
+        done.set_value();
+    });
+    done.get_future().wait();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs"] = benchmark::Counter((double)allocs, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_TEMPLATE(PromiseChainBenchmark_shortPipelineInTask, ExecutorType::Default)->Name("PromiseChainBenchmark_shortPipelineInTask/DefaultExecutor")->UseRealTime();
+BENCHMARK_TEMPLATE(PromiseChainBenchmark_shortPipelineInTask, ExecutorType::ThreadPool)->Name("PromiseChainBenchmark_shortPipelineInTask/ThreadPoolExecutor")->UseRealTime();
+BENCHMARK_TEMPLATE(PromiseChainBenchmark_map, ExecutorType::Default)->Name("PromiseChainBenchmark_map/DefaultExecutor")->RangeMultiplier(8)->Range(8, 512)->UseRealTime();
+BENCHMARK_TEMPLATE(PromiseChainBenchmark_map, ExecutorType::ThreadPool)->Name("PromiseChainBenchmark_map/ThreadPoolExecutor")->RangeMultiplier(8)->Range(8, 512)->UseRealTime();
+BENCHMARK_TEMPLATE(PromiseChainBenchmark_thenAccept, ExecutorType::Default)->Name("PromiseChainBenchmark_thenAccept/DefaultExecutor")->RangeMultiplier(8)->Range(8, 512)->UseRealTime();
+BENCHMARK_TEMPLATE(PromiseChainBenchmark_thenAccept, ExecutorType::ThreadPool)->Name("PromiseChainBenchmark_thenAccept/ThreadPoolExecutor")->RangeMultiplier(8)->Range(8, 512)->UseRealTime();
+BENCHMARK_TEMPLATE(PromiseChainBenchmark_flatMap, ExecutorType::Default)->Name("PromiseChainBenchmark_flatMap/DefaultExecutor")->RangeMultiplier(8)->Range(8, 512)->UseRealTime();
+BENCHMARK_TEMPLATE(PromiseChainBenchmark_flatMap, ExecutorType::ThreadPool)->Name("PromiseChainBenchmark_flatMap/ThreadPoolExecutor")->RangeMultiplier(8)->Range(8, 512)->UseRealTime();
+BENCHMARK_TEMPLATE(PromiseChainBenchmark_parallelChains, ExecutorType::Default)->Name("PromiseChainBenchmark_parallelChains/DefaultExecutor")->RangeMultiplier(8)->Range(8, 512)->UseRealTime();
+BENCHMARK_TEMPLATE(PromiseChainBenchmark_parallelChains, ExecutorType::ThreadPool)->Name("PromiseChainBenchmark_parallelChains/ThreadPoolExecutor")->RangeMultiplier(8)->Range(8, 512)->UseRealTime();
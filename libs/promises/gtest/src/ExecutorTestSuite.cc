@@ -20,10 +20,15 @@
 #include <gtest/gtest.h>
 
 #include <future>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "celix/DefaultExecutor.h"
 #include "celix/DefaultScheduledExecutor.h"
+#include "celix/PromiseFactory.h"
+#include "celix/ThreadPoolExecutor.h"
 
 class ExecutorTestSuite : public ::testing::Test {
 public:
@@ -53,4 +58,122 @@ TEST_F(ExecutorTestSuite, ScheduledExecuteTasks) {
     auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1);
     EXPECT_EQ(3, counter.load());
     EXPECT_GT(diff, std::chrono::milliseconds{49});
-}
\ No newline at end of file
+}
+
+TEST_F(ExecutorTestSuite, CancelScheduledTask) {
+    std::atomic<int> counter{0};
+    auto t1 = std::chrono::steady_clock::now();
+    auto future = scheduledExecutor->schedule(std::chrono::seconds{10}, [&counter]{counter++;});
+    scheduledExecutor->schedule(std::chrono::milliseconds{10}, [&counter]{counter++;});
+    future->cancel();
+    EXPECT_TRUE(future->isCancelled());
+    EXPECT_TRUE(future->isDone());
+    scheduledExecutor->wait();
+    auto t2 = std::chrono::steady_clock::now();
+    EXPECT_EQ(1, counter.load());
+    EXPECT_LT(t2 - t1, std::chrono::seconds{5}); //note the cancelled task is not waited for
+}
+
+TEST_F(ExecutorTestSuite, ScheduledExecuteTasksInDelayOrder) {
+    std::mutex mutex{};
+    std::vector<int> order{};
+    //note the delays span multiple rounds of the timer wheel
+    for (int delay : {700, 30, 0, 520, 5}) {
+        scheduledExecutor->schedule(std::chrono::milliseconds{delay}, [&mutex, &order, delay]{
+            std::lock_guard lck{mutex};
+            order.push_back(delay);
+        });
+    }
+    scheduledExecutor->wait();
+    EXPECT_EQ((std::vector<int>{0, 5, 30, 520, 700}), order);
+}
+
+TEST_F(ExecutorTestSuite, ThreadPoolExecuteTasks) {
+    auto pool = std::make_shared<celix::ThreadPoolExecutor>(4);
+    EXPECT_EQ(4, pool->getNrOfThreads());
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 1000; ++i) {
+        pool->execute([&counter, &pool]{
+            counter++;
+            //note tasks executed from a worker are queued on the queue of the worker
+            pool->execute([&counter]{counter++;});
+        });
+    }
+    pool->wait();
+    EXPECT_EQ(2000, counter.load());
+}
+
+TEST_F(ExecutorTestSuite, ThreadPoolExecuteTasksWithPriority) {
+    celix::ThreadPoolExecutor pool{1};
+    std::promise<void> blocked{};
+    auto blockedFuture = blocked.get_future();
+    pool.execute([&blockedFuture]{ blockedFuture.wait(); });
+
+    std::mutex mutex{};
+    std::vector<int> order{};
+    for (int prio : {1, 10, -5, 3}) {
+        pool.execute(prio, [&mutex, &order, prio]{
+            std::lock_guard lck{mutex};
+            order.push_back(prio);
+        });
+    }
+    blocked.set_value();
+    pool.wait();
+    EXPECT_EQ((std::vector<int>{10, 3, 1, -5}), order);
+}
+
+TEST_F(ExecutorTestSuite, ThreadPoolRejectsTasksIfQueueIsFull) {
+    celix::ThreadPoolExecutor pool{1, 2};
+    std::promise<void> started{};
+    std::promise<void> blocked{};
+    auto blockedFuture = blocked.get_future();
+    pool.execute([&started, &blockedFuture]{
+        started.set_value();
+        blockedFuture.wait();
+    });
+    started.get_future().wait(); //note a running task is not queued anymore
+
+    pool.execute([]{});
+    pool.execute([]{});
+    EXPECT_THROW(pool.execute([]{}), celix::RejectedExecutionException);
+    blocked.set_value();
+    pool.wait();
+}
+
+TEST_F(ExecutorTestSuite, ThreadPoolExecutesPromiseChain) {
+    auto pool = std::make_shared<celix::ThreadPoolExecutor>(2);
+    celix::PromiseFactory factory{pool, scheduledExecutor};
+    auto p = factory.deferredTask<long>([](auto d) { d.resolve(1); });
+    for (int i = 0; i < 100; ++i) {
+        p = p.map<long>([](long v) { return v + 1; });
+    }
+    auto deferred = factory.deferred<long>();
+    auto timedOut = deferred.getPromise().timeout(std::chrono::milliseconds{10});
+    EXPECT_EQ(101, p.getValue());
+    timedOut.wait();
+    EXPECT_FALSE(timedOut.isSuccessfullyResolved());
+    deferred.resolve(0);
+    pool->wait();
+}
+
+TEST_F(ExecutorTestSuite, ContinuationsRunInlineInTaskOfSameExecutor) {
+    //note a single worker, so blocking on a continuation that is not run inline would deadlock
+    auto pool = std::make_shared<celix::ThreadPoolExecutor>(1);
+    celix::PromiseFactory factory{pool, scheduledExecutor};
+    auto result = factory.resolved().map<long>([&factory] {
+        auto caller = std::this_thread::get_id();
+        auto p = factory.resolved<long>(1)
+                .map<long>([caller](long v) { return std::this_thread::get_id() == caller ? v + 1 : -1; })
+                .map<long>([caller](long v) { return std::this_thread::get_id() == caller ? v + 1 : -1; });
+        return p.getValue();
+    });
+    EXPECT_EQ(3, result.getValue());
+
+    //note the nesting of inline continuations is limited, the remaining continuations are executed on the executor
+    auto p = factory.resolved<long>(0);
+    for (int i = 0; i < 100; ++i) {
+        p = p.map<long>([](long v) { return v + 1; });
+    }
+    EXPECT_EQ(100, p.getValue());
+    pool->wait();
+}
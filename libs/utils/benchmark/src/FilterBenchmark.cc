@@ -0,0 +1,106 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <benchmark/benchmark.h>
+#include <iostream>
+
+#include "celix_filter.h"
+#include "celix_properties.h"
+
+class FilterBenchmark {
+public:
+    explicit FilterBenchmark(const char* filterStr) : filter{celix_filter_create(filterStr)} {
+        if (filter == nullptr) {
+            std::cerr << "Cannot create filter " << filterStr << std::endl;
+            abort();
+        }
+        celix_properties_set(props, "objectClass", "org.example.Calculator");
+        celix_properties_set(props, "service.vendor", "Apache Celix");
+        celix_properties_setLong(props, "service.ranking", 42);
+        celix_properties_setLong(props, "service.id", 1000);
+        celix_properties_set(props, "service.version", "1.2.3");
+        celix_properties_set(props, "service.description", "A calculator service providing add, sub and sqrt methods");
+    }
+
+    ~FilterBenchmark() {
+        celix_filter_destroy(filter);
+        celix_properties_destroy(props);
+    }
+
+    FilterBenchmark(FilterBenchmark&&) = delete;
+    FilterBenchmark& operator=(FilterBenchmark&&) = delete;
+    FilterBenchmark(const FilterBenchmark&) = delete;
+    FilterBenchmark& operator=(const FilterBenchmark&) = delete;
+
+    void match(benchmark::State& state, bool expectedMatch) {
+        for (auto _ : state) {
+            // This code gets timed
+            bool match = celix_filter_match(filter, props);
+            if (match != expectedMatch) {
+                std::cerr << "Unexpected match result for filter " << celix_filter_getFilterString(filter) << std::endl;
+                abort();
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    celix_filter_t* filter;
+    celix_properties_t* props{celix_properties_create()};
+};
+
+static void FilterBenchmark_equalsFilter(benchmark::State& state) {
+    FilterBenchmark benchmark{"(service.vendor=Apache Celix)"};
+    benchmark.match(state, true);
+}
+
+static void FilterBenchmark_longRangeFilter(benchmark::State& state) {
+    FilterBenchmark benchmark{"(&(service.ranking>=10)(service.ranking<100))"};
+    benchmark.match(state, true);
+}
+
+static void FilterBenchmark_versionRangeFilter(benchmark::State& state) {
+    FilterBenchmark benchmark{"(&(service.version>=1.0.0)(!(service.version>=2.0.0)))"};
+    benchmark.match(state, true);
+}
+
+static void FilterBenchmark_substringFilter(benchmark::State& state) {
+    FilterBenchmark benchmark{"(service.description=A calculator*add*sqrt*)"};
+    benchmark.match(state, true);
+}
+
+static void FilterBenchmark_serviceTrackerFilter(benchmark::State& state) {
+    FilterBenchmark benchmark{"(&(objectClass=org.example.Calculator)(|(service.vendor=Other)(service.ranking>=10))(service.version>=1.0.0)(!(service.version>=2.0.0)))"};
+    benchmark.match(state, true);
+}
+
+static void FilterBenchmark_nonMatchingFilter(benchmark::State& state) {
+    FilterBenchmark benchmark{"(&(objectClass=org.example.Calculator)(service.ranking<10))"};
+    benchmark.match(state, false);
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond)
+
+CELIX_BENCHMARK(FilterBenchmark_equalsFilter);
+CELIX_BENCHMARK(FilterBenchmark_longRangeFilter);
+CELIX_BENCHMARK(FilterBenchmark_versionRangeFilter);
+CELIX_BENCHMARK(FilterBenchmark_substringFilter);
+CELIX_BENCHMARK(FilterBenchmark_serviceTrackerFilter);
+CELIX_BENCHMARK(FilterBenchmark_nonMatchingFilter);
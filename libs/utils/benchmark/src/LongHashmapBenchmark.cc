@@ -23,6 +23,10 @@
 #include <random>
 #include <iostream>
 #include <climits>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
 #include "hash_map.h"
 #include "celix_long_hash_map.h"
@@ -73,6 +77,34 @@ public:
         return result;
     }
 
+    long createMissingKey() {
+        long key = createRandomKey();
+        while (testVectorsMap.find(key) != testVectorsMap.end()) {
+            key = createRandomKey();
+        }
+        return key;
+    }
+
+    std::vector<long> createKeys() const {
+        std::vector<long> keys{};
+        keys.reserve(testVectorsMap.size());
+        for (const auto& pair : testVectorsMap) {
+            keys.push_back(pair.first);
+        }
+        return keys;
+    }
+
+    /**
+     * @brief Returns the nr of bytes currently allocated with malloc or -1 if this is not supported.
+     */
+    static long allocatedBytes() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+        return (long)mallinfo2().uordblks;
+#else
+        return -1;
+#endif
+    }
+
     long createRandomKey() {
         return keyDistribution(generator);
     }
@@ -202,6 +234,99 @@ static void LongHashmapBenchmark_fillDeprecatedHashMap(benchmark::State& state)
     state.SetItemsProcessed(state.iterations() * benchmark.testVectorsMap.size());
 }
 
+static void LongHashmapBenchmark_findMissingEntryFromStdMap(benchmark::State& state) {
+    LongHashmapBenchmark benchmark{state.range(0)};
+    benchmark.fillStdMap();
+    long missingKey = benchmark.createMissingKey();
+    for (auto _ : state) {
+        // This code gets timed
+        auto it = benchmark.stdMap.find(missingKey);
+        if (it != benchmark.stdMap.end()) {
+            std::cerr << "Unexpected entry " << missingKey << " for std unordered_map." << std::endl;
+            abort();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void LongHashmapBenchmark_findMissingEntryFromCelixMap(benchmark::State& state) {
+    LongHashmapBenchmark benchmark{state.range(0)};
+    benchmark.fillCelixHashMap();
+    long missingKey = benchmark.createMissingKey();
+    for (auto _ : state) {
+        // This code gets timed
+        bool hasKey = celix_longHashMap_hasKey(benchmark.celixHashMap, missingKey);
+        if (hasKey) {
+            std::cerr << "Unexpected entry " << missingKey << " for celix hash map." << std::endl;
+            abort();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void LongHashmapBenchmark_churnStdMap(benchmark::State& state) {
+    LongHashmapBenchmark benchmark{state.range(0)};
+    benchmark.fillStdMap();
+    auto keys = benchmark.createKeys();
+    size_t index = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        benchmark.stdMap.erase(keys[index]);
+        keys[index] = benchmark.createRandomKey();
+        benchmark.stdMap[keys[index]] = 42;
+        index = (index + 1) % keys.size();
+    }
+    state.SetItemsProcessed(state.iterations() * 2); //note remove and add per iteration
+}
+
+static void LongHashmapBenchmark_churnCelixHashMap(benchmark::State& state) {
+    LongHashmapBenchmark benchmark{state.range(0)};
+    benchmark.fillCelixHashMap();
+    auto keys = benchmark.createKeys();
+    size_t index = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        celix_longHashMap_remove(benchmark.celixHashMap, keys[index]);
+        keys[index] = benchmark.createRandomKey();
+        celix_longHashMap_putLong(benchmark.celixHashMap, keys[index], 42);
+        index = (index + 1) % keys.size();
+    }
+    state.SetItemsProcessed(state.iterations() * 2); //note remove and add per iteration
+}
+
+static void LongHashmapBenchmark_memoryFootprintStdMap(benchmark::State& state) {
+    LongHashmapBenchmark benchmark{state.range(0)};
+    long bytes = 0;
+    for (auto _ : state) {
+        long before = LongHashmapBenchmark::allocatedBytes();
+        benchmark.fillStdMap();
+        bytes = LongHashmapBenchmark::allocatedBytes() - before;
+        state.PauseTiming();
+        benchmark.stdMap = std::unordered_map<long, int>{}; //note clear does not release the buckets
+        state.ResumeTiming();
+    }
+    if (LongHashmapBenchmark::allocatedBytes() < 0) {
+        state.SkipWithError("Measuring allocated bytes is not supported on this platform");
+    }
+    state.counters["bytesPerEntry"] = (double)bytes / (double)state.range(0);
+}
+
+static void LongHashmapBenchmark_memoryFootprintCelixHashMap(benchmark::State& state) {
+    LongHashmapBenchmark benchmark{state.range(0)};
+    long bytes = 0;
+    for (auto _ : state) {
+        celix_longHashMap_destroy(benchmark.celixHashMap);
+        long before = LongHashmapBenchmark::allocatedBytes();
+        benchmark.celixHashMap = celix_longHashMap_create();
+        benchmark.fillCelixHashMap();
+        bytes = LongHashmapBenchmark::allocatedBytes() - before;
+    }
+    if (LongHashmapBenchmark::allocatedBytes() < 0) {
+        state.SkipWithError("Measuring allocated bytes is not supported on this platform");
+    }
+    state.counters["bytesPerEntry"] = (double)bytes / (double)state.range(0);
+}
+
 #define CELIX_BENCHMARK(name) \
     BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMicrosecond)
 
@@ -216,3 +341,12 @@ CELIX_BENCHMARK(LongHashmapBenchmark_findEntryFromDeprecatedMap)->RangeMultiplie
 CELIX_BENCHMARK(LongHashmapBenchmark_fillStdMap)->RangeMultiplier(10)->Range(100, 10000); //reference
 CELIX_BENCHMARK(LongHashmapBenchmark_fillCelixHashMap)->RangeMultiplier(10)->Range(100, 10000);
 CELIX_BENCHMARK(LongHashmapBenchmark_fillDeprecatedHashMap)->RangeMultiplier(10)->Range(100, 10000);
+
+CELIX_BENCHMARK(LongHashmapBenchmark_findMissingEntryFromStdMap)->RangeMultiplier(10)->Range(100, 10000); //reference
+CELIX_BENCHMARK(LongHashmapBenchmark_findMissingEntryFromCelixMap)->RangeMultiplier(10)->Range(100, 10000);
+
+CELIX_BENCHMARK(LongHashmapBenchmark_churnStdMap)->RangeMultiplier(10)->Range(100, 10000); //reference
+CELIX_BENCHMARK(LongHashmapBenchmark_churnCelixHashMap)->RangeMultiplier(10)->Range(100, 10000);
+
+CELIX_BENCHMARK(LongHashmapBenchmark_memoryFootprintStdMap)->RangeMultiplier(10)->Range(100, 10000); //reference
+CELIX_BENCHMARK(LongHashmapBenchmark_memoryFootprintCelixHashMap)->RangeMultiplier(10)->Range(100, 10000);
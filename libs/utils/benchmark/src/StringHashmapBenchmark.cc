@@ -24,6 +24,10 @@
 #include <random>
 #include <iostream>
 #include <climits>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
 #include "hash_map.h"
 #include "celix_properties.h"
@@ -96,6 +100,40 @@ public:
         return std::string{buf};
     }
 
+    std::string createMissingString() {
+        std::string str = createRandomString();
+        while (testVectorsMap.find(str) != testVectorsMap.end()) {
+            str = createRandomString();
+        }
+        return str;
+    }
+
+    /**
+     * @brief Returns the keys of the test vectors, followed by the same nr of missing keys.
+     */
+    std::vector<std::string> createChurnKeys() {
+        std::vector<std::string> keys{};
+        keys.reserve(testVectorsMap.size() * 2);
+        for (const auto& pair : testVectorsMap) {
+            keys.push_back(pair.first);
+        }
+        for (size_t i = 0; i < testVectorsMap.size(); ++i) {
+            keys.push_back(createMissingString());
+        }
+        return keys;
+    }
+
+    /**
+     * @brief Returns the nr of bytes currently allocated with malloc or -1 if this is not supported.
+     */
+    static long allocatedBytes() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+        return (long)mallinfo2().uordblks;
+#else
+        return -1;
+#endif
+    }
+
     int createRandomValue() {
         return valDistribution(generator);
     }
@@ -263,6 +301,107 @@ static void StringHashmapBenchmark_fillProperties(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * benchmark.testVectorsMap.size());
 }
 
+static void StringHashmapBenchmark_findMissingEntryFromStdMap(benchmark::State& state) {
+    StringHashmapBenchmark benchmark{state.range(0)};
+    benchmark.fillStdMap();
+    std::string missingKey = benchmark.createMissingString();
+    for (auto _ : state) {
+        // This code gets timed
+        auto it = benchmark.stdMap.find(missingKey);
+        if (it != benchmark.stdMap.end()) {
+            std::cerr << "Unexpected entry " << missingKey << " for std unordered_map." << std::endl;
+            abort();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void StringHashmapBenchmark_findMissingEntryFromCelixMap(benchmark::State& state) {
+    StringHashmapBenchmark benchmark{state.range(0)};
+    benchmark.fillCelixHashMap();
+    std::string missingKey = benchmark.createMissingString();
+    for (auto _ : state) {
+        // This code gets timed
+        bool hasKey = celix_stringHashMap_hasKey(benchmark.celixHashMap, missingKey.c_str());
+        if (hasKey) {
+            std::cerr << "Unexpected entry " << missingKey << " for celix hash map." << std::endl;
+            abort();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void StringHashmapBenchmark_churnStdMap(benchmark::State& state) {
+    StringHashmapBenchmark benchmark{state.range(0)};
+    benchmark.fillStdMap();
+    auto keys = benchmark.createChurnKeys();
+    size_t nrOfEntries = benchmark.testVectorsMap.size();
+    size_t index = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        benchmark.stdMap.erase(keys[index]);
+        benchmark.stdMap[keys[(index + nrOfEntries) % keys.size()]] = 42;
+        index = (index + 1) % keys.size();
+    }
+    state.SetItemsProcessed(state.iterations() * 2); //note remove and add per iteration
+}
+
+static void StringHashmapBenchmark_churnCelixHashMap(benchmark::State& state) {
+    StringHashmapBenchmark benchmark{state.range(0)};
+    auto keys = benchmark.createChurnKeys();
+    size_t nrOfEntries = benchmark.testVectorsMap.size();
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        //note keys are stored weakly, so use the keys vector as storage
+        celix_stringHashMap_putLong(benchmark.celixHashMap, keys[i].c_str(), 42);
+    }
+    size_t index = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        celix_stringHashMap_remove(benchmark.celixHashMap, keys[index].c_str());
+        celix_stringHashMap_putLong(benchmark.celixHashMap, keys[(index + nrOfEntries) % keys.size()].c_str(), 42);
+        index = (index + 1) % keys.size();
+    }
+    state.SetItemsProcessed(state.iterations() * 2); //note remove and add per iteration
+}
+
+static void StringHashmapBenchmark_memoryFootprintStdMap(benchmark::State& state) {
+    StringHashmapBenchmark benchmark{state.range(0)};
+    long bytes = 0;
+    for (auto _ : state) {
+        long before = StringHashmapBenchmark::allocatedBytes();
+        benchmark.fillStdMap();
+        bytes = StringHashmapBenchmark::allocatedBytes() - before;
+        state.PauseTiming();
+        benchmark.stdMap = std::unordered_map<std::string, int>{}; //note clear does not release the buckets
+        state.ResumeTiming();
+    }
+    if (StringHashmapBenchmark::allocatedBytes() < 0) {
+        state.SkipWithError("Measuring allocated bytes is not supported on this platform");
+    }
+    state.counters["bytesPerEntry"] = (double)bytes / (double)state.range(0);
+}
+
+static void StringHashmapBenchmark_memoryFootprintCelixHashMap(benchmark::State& state) {
+    StringHashmapBenchmark benchmark{state.range(0)};
+    long bytes = 0;
+    for (auto _ : state) {
+        //note using a celix hash map which copies the keys, so that the footprint is comparable with the std map.
+        long before = StringHashmapBenchmark::allocatedBytes();
+        celix_string_hash_map_t* map = celix_stringHashMap_create();
+        for (const auto& pair : benchmark.testVectorsMap) {
+            celix_stringHashMap_putLong(map, pair.first.c_str(), pair.second);
+        }
+        bytes = StringHashmapBenchmark::allocatedBytes() - before;
+        state.PauseTiming();
+        celix_stringHashMap_destroy(map);
+        state.ResumeTiming();
+    }
+    if (StringHashmapBenchmark::allocatedBytes() < 0) {
+        state.SkipWithError("Measuring allocated bytes is not supported on this platform");
+    }
+    state.counters["bytesPerEntry"] = (double)bytes / (double)state.range(0);
+}
+
 #define CELIX_BENCHMARK(name) \
     BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMicrosecond)
 
@@ -279,4 +418,13 @@ CELIX_BENCHMARK(StringHashmapBenchmark_findEntryFromCelixProperties)->RangeMulti
 CELIX_BENCHMARK(StringHashmapBenchmark_fillStdMap)->RangeMultiplier(10)->Range(100, 10000); //reference
 CELIX_BENCHMARK(StringHashmapBenchmark_fillCelixHashMap)->RangeMultiplier(10)->Range(100, 10000);
 CELIX_BENCHMARK(StringHashmapBenchmark_fillDeprecatedHashMap)->RangeMultiplier(10)->Range(100, 10000);
-CELIX_BENCHMARK(StringHashmapBenchmark_fillProperties)->RangeMultiplier(10)->Range(100, 10000);
\ No newline at end of file
+CELIX_BENCHMARK(StringHashmapBenchmark_fillProperties)->RangeMultiplier(10)->Range(100, 10000);
+
+CELIX_BENCHMARK(StringHashmapBenchmark_findMissingEntryFromStdMap)->RangeMultiplier(10)->Range(100, 10000); //reference
+CELIX_BENCHMARK(StringHashmapBenchmark_findMissingEntryFromCelixMap)->RangeMultiplier(10)->Range(100, 10000);
+
+CELIX_BENCHMARK(StringHashmapBenchmark_churnStdMap)->RangeMultiplier(10)->Range(100, 10000); //reference
+CELIX_BENCHMARK(StringHashmapBenchmark_churnCelixHashMap)->RangeMultiplier(10)->Range(100, 10000);
+
+CELIX_BENCHMARK(StringHashmapBenchmark_memoryFootprintStdMap)->RangeMultiplier(10)->Range(100, 10000); //reference
+CELIX_BENCHMARK(StringHashmapBenchmark_memoryFootprintCelixHashMap)->RangeMultiplier(10)->Range(100, 10000);
@@ -255,6 +255,11 @@ TEST_F(ConvertUtilsTestSuite, ConvertToVersionTest) {
     EXPECT_TRUE(converted);
     celix_version_destroy(result);
 
+    //test for a convert with a version part larger than INT_MAX
+    result = celix_utils_convertStringToVersion("1.99999999999.0", nullptr, &converted);
+    EXPECT_FALSE(converted);
+    EXPECT_EQ(nullptr, result);
+
     //test for a convert with a super long invalid version string
     std::string longString = "1";
     for (int i = 0; i < 128; ++i) {
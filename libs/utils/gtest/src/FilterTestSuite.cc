@@ -431,3 +431,110 @@ TEST_F(FilterTestSuite, deprecatedApi) {
     filter_destroy(f1);
     filter_destroy(f2);
 }
+
+TEST_F(FilterTestSuite, match_substring) {
+    auto* props = celix_properties_create();
+    celix_properties_set(props, "test_attr1", "abcdef");
+
+    struct {
+        const char* filterStr;
+        bool expectedMatch;
+    } testCases[] = {
+        {"(test_attr1=abc*)", true},
+        {"(test_attr1=abd*)", false},
+        {"(test_attr1=*def)", true},
+        {"(test_attr1=*dez)", false},
+        {"(test_attr1=*cd*)", true},
+        {"(test_attr1=*dc*)", false},
+        {"(test_attr1=a*c*f)", true},
+        {"(test_attr1=a*d*c*)", false}, //substrings should be found in order
+        {"(test_attr1=a*fc)", false},
+        {"(test_attr1=abcdefg*)", false}, //substring longer than value
+        {"(test_attr1=*xabcdef)", false},
+        {"(test_attr1=abc*def)", true},
+        {"(test_attr1=abcd*cdef)", false}, //substrings should not overlap
+    };
+    for (const auto& testCase : testCases) {
+        auto* filter = celix_filter_create(testCase.filterStr);
+        ASSERT_TRUE(filter != nullptr) << testCase.filterStr;
+        EXPECT_EQ(testCase.expectedMatch, celix_filter_match(filter, props)) << testCase.filterStr;
+        celix_filter_destroy(filter);
+    }
+
+    celix_properties_destroy(props);
+}
+
+TEST_F(FilterTestSuite, match_versionAndNestedOperators) {
+    auto* props = celix_properties_create();
+    celix_properties_set(props, "version", "1.2.3");
+    celix_properties_set(props, "qualifiedVersion", " 1.2.3.a_very_long_qualifier_which_does_not_fit_in_the_parse_buffer_used_during_matching ");
+    celix_properties_set(props, "notAVersion", "1.2.x");
+    celix_properties_set(props, "tooLargeVersion", "1.99999999999.0");
+    celix_properties_setLong(props, "ranking", 10);
+
+    struct {
+        const char* filterStr;
+        bool expectedMatch;
+    } testCases[] = {
+        {"(version>=1.0.0)", true},
+        {"(version<1.2.4)", true},
+        {"(version=1.2.3)", true},
+        {"(version>1.2.3)", false},
+        {"(&(version>=1.0.0)(!(version>=2.0.0)))", true},
+        {"(qualifiedVersion>1.2.3.a)", true},
+        {"(qualifiedVersion<1.2.3.b)", true},
+        {"(notAVersion>1.0.0)", true}, //fallback on string compare
+        {"(notAVersion<1.2.3)", false},
+        {"(tooLargeVersion<1.10.0)", false}, //minor > INT_MAX, fallback on string compare
+        {"(|(ranking<5)(&(ranking>5)(!(version<1.0.0))))", true},
+        {"(|(ranking<5)(&(ranking>5)(version<1.0.0)))", false},
+        {"(!(|(ranking<5)(version<1.0.0)(missing=*)))", true},
+        {"(&(!(ranking<5))(|(missing=*)(!(ranking>20)))(version=*))", true},
+        {"(&(!(ranking<5))(|(missing=*)(ranking>20))(version=*))", false},
+    };
+    for (const auto& testCase : testCases) {
+        auto* filter = celix_filter_create(testCase.filterStr);
+        ASSERT_TRUE(filter != nullptr) << testCase.filterStr;
+        EXPECT_EQ(testCase.expectedMatch, celix_filter_match(filter, props)) << testCase.filterStr;
+        celix_filter_destroy(filter);
+    }
+
+    celix_properties_destroy(props);
+}
+
+TEST_F(FilterTestSuite, match_typedValues) {
+    auto* props = celix_properties_create();
+    celix_properties_setLong(props, "long", 10);
+    celix_properties_setDouble(props, "double", 2.5);
+    celix_properties_setBool(props, "bool", true);
+    celix_version_t* version = celix_version_createVersion(1, 10, 0, nullptr);
+    celix_properties_setVersion(props, "version", version);
+    celix_version_destroy(version);
+
+    struct {
+        const char* filterStr;
+        bool expectedMatch;
+    } testCases[] = {
+        {"(long=10)", true},
+        {"(long>9)", true},
+        {"(long<9.5)", false},
+        {"(long>=10.0)", true},
+        {"(long<1.0.0)", false}, //fallback on string compare
+        {"(double>2)", true},
+        {"(double<2.6)", true},
+        {"(double=2.5)", true},
+        {"(bool=true)", true},
+        {"(bool=false)", false},
+        {"(version>1.2.0)", true}, //version compare, not a string compare
+        {"(version=1.10.0)", true},
+        {"(version<1.9.9)", false},
+    };
+    for (const auto& testCase : testCases) {
+        auto* filter = celix_filter_create(testCase.filterStr);
+        ASSERT_TRUE(filter != nullptr) << testCase.filterStr;
+        EXPECT_EQ(testCase.expectedMatch, celix_filter_match(filter, props)) << testCase.filterStr;
+        celix_filter_destroy(filter);
+    }
+
+    celix_properties_destroy(props);
+}
@@ -546,3 +546,36 @@ TEST_F(HashMapTestSuite, IterateWithRemoveTest) {
     EXPECT_TRUE(celix_longHashMapIterator_isEnd(&iter2));
     celix_longHashMap_destroy(lMap);
 }
+
+TEST_F(HashMapTestSuite, PutAndRemoveChurnTest) {
+    //note many put/remove cycles with a stable nr of entries, so that removed (DELETED) slots are reused and cleaned
+    auto* lMap = celix_longHashMap_create();
+    auto* sMap = celix_stringHashMap_create();
+    for (long i = 0; i < 100; ++i) {
+        celix_longHashMap_putLong(lMap, i, i);
+        celix_stringHashMap_putLong(sMap, std::to_string(i).c_str(), i);
+    }
+    for (long i = 100; i < 10000; ++i) {
+        EXPECT_TRUE(celix_longHashMap_remove(lMap, i - 100));
+        EXPECT_TRUE(celix_stringHashMap_remove(sMap, std::to_string(i - 100).c_str()));
+        celix_longHashMap_putLong(lMap, i, i);
+        celix_stringHashMap_putLong(sMap, std::to_string(i).c_str(), i);
+        EXPECT_EQ(100, celix_longHashMap_size(lMap));
+        EXPECT_EQ(100, celix_stringHashMap_size(sMap));
+    }
+    for (long i = 0; i < 10000; ++i) {
+        long expected = i >= 9900 ? i : -1;
+        EXPECT_EQ(expected, celix_longHashMap_getLong(lMap, i, -1));
+        EXPECT_EQ(expected, celix_stringHashMap_getLong(sMap, std::to_string(i).c_str(), -1));
+    }
+
+    size_t count = 0;
+    CELIX_LONG_HASH_MAP_ITERATE(lMap, iter) {
+        EXPECT_EQ(iter.key, iter.value.longValue);
+        count++;
+    }
+    EXPECT_EQ(100, count);
+
+    celix_longHashMap_destroy(lMap);
+    celix_stringHashMap_destroy(sMap);
+}
@@ -0,0 +1,194 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <string>
+
+#include "celix_properties.h"
+
+class PropertiesTestSuite : public ::testing::Test {
+public:
+};
+
+TEST_F(PropertiesTestSuite, TypedValuesTest) {
+    auto* props = celix_properties_create();
+    celix_properties_set(props, "str", "value");
+    celix_properties_setLong(props, "long", -42);
+    celix_properties_setDouble(props, "double", 3.5);
+    celix_properties_setBool(props, "bool", true);
+    auto* version = celix_version_createVersion(1, 2, 3, "qualifier");
+    celix_properties_setVersion(props, "version", version);
+    EXPECT_EQ(5, celix_properties_size(props));
+
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_STRING, celix_properties_getType(props, "str"));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_LONG, celix_properties_getType(props, "long"));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_DOUBLE, celix_properties_getType(props, "double"));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_BOOL, celix_properties_getType(props, "bool"));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_VERSION, celix_properties_getType(props, "version"));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_UNSET, celix_properties_getType(props, "missing"));
+
+    //typed values also have a string representation
+    EXPECT_STREQ("value", celix_properties_get(props, "str", nullptr));
+    EXPECT_STREQ("-42", celix_properties_get(props, "long", nullptr));
+    EXPECT_STREQ("3.500000", celix_properties_get(props, "double", nullptr));
+    EXPECT_STREQ("true", celix_properties_get(props, "bool", nullptr));
+    EXPECT_STREQ("1.2.3.qualifier", celix_properties_get(props, "version", nullptr));
+
+    EXPECT_EQ(-42, celix_properties_getAsLong(props, "long", 0));
+    EXPECT_EQ(-42.0, celix_properties_getAsDouble(props, "long", 0.0));
+    EXPECT_EQ(3.5, celix_properties_getAsDouble(props, "double", 0.0));
+    EXPECT_EQ(3, celix_properties_getAsLong(props, "double", 0)); //parsed from the string representation
+    EXPECT_TRUE(celix_properties_getAsBool(props, "bool", false));
+    EXPECT_EQ(-1, celix_properties_getAsLong(props, "str", -1));
+
+    const celix_version_t* stored = celix_properties_getVersion(props, "version", nullptr);
+    ASSERT_NE(nullptr, stored);
+    EXPECT_EQ(0, celix_version_compareTo(version, stored));
+    EXPECT_EQ(nullptr, celix_properties_getVersion(props, "str", nullptr));
+
+    //overriding a typed value with a string value
+    celix_properties_set(props, "version", "2.0.0");
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_STRING, celix_properties_getType(props, "version"));
+    EXPECT_EQ(nullptr, celix_properties_getVersion(props, "version", nullptr));
+    auto* parsed = celix_properties_getAsVersion(props, "version", nullptr);
+    ASSERT_NE(nullptr, parsed);
+    EXPECT_EQ(2, celix_version_getMajor(parsed));
+    celix_version_destroy(parsed);
+    auto* fallback = celix_properties_getAsVersion(props, "str", version);
+    ASSERT_NE(nullptr, fallback);
+    EXPECT_EQ(0, celix_version_compareTo(version, fallback));
+    celix_version_destroy(fallback);
+    EXPECT_EQ(nullptr, celix_properties_getAsVersion(props, "missing", nullptr));
+
+    celix_version_destroy(version);
+    celix_properties_destroy(props);
+}
+
+TEST_F(PropertiesTestSuite, LongFormattingTest) {
+    auto* props = celix_properties_create();
+    celix_properties_setLong(props, "zero", 0);
+    celix_properties_setLong(props, "max", LONG_MAX);
+    celix_properties_setLong(props, "min", LONG_MIN);
+    EXPECT_STREQ("0", celix_properties_get(props, "zero", nullptr));
+    EXPECT_EQ(std::to_string(LONG_MAX), celix_properties_get(props, "max", nullptr));
+    EXPECT_EQ(std::to_string(LONG_MIN), celix_properties_get(props, "min", nullptr));
+    EXPECT_EQ(LONG_MIN, celix_properties_getAsLong(props, "min", 0));
+    celix_properties_destroy(props);
+}
+
+TEST_F(PropertiesTestSuite, ManyEntriesAndUnsetTest) {
+    //note more entries than the inline storage and larger than an arena block
+    auto* props = celix_properties_create();
+    std::string largeValue(1000, 'x');
+    for (int i = 0; i < 100; ++i) {
+        auto key = std::string{"key"} + std::to_string(i);
+        if (i % 10 == 0) {
+            celix_properties_set(props, key.c_str(), largeValue.c_str());
+        } else {
+            celix_properties_setLong(props, key.c_str(), i);
+        }
+    }
+    EXPECT_EQ(100, celix_properties_size(props));
+    for (int i = 0; i < 100; i += 2) {
+        auto key = std::string{"key"} + std::to_string(i);
+        celix_properties_unset(props, key.c_str());
+    }
+    EXPECT_EQ(50, celix_properties_size(props));
+    for (int i = 0; i < 100; ++i) {
+        auto key = std::string{"key"} + std::to_string(i);
+        EXPECT_EQ(i % 2 == 1, celix_properties_hasKey(props, key.c_str()));
+    }
+
+    //note removed entries are reused
+    for (int i = 100; i < 150; ++i) {
+        auto key = std::string{"newKey"} + std::to_string(i);
+        celix_properties_set(props, key.c_str(), largeValue.c_str());
+    }
+    EXPECT_EQ(100, celix_properties_size(props));
+    EXPECT_EQ(largeValue, celix_properties_get(props, "newKey149", ""));
+    EXPECT_EQ(99, celix_properties_getAsLong(props, "key99", 0));
+
+    int count = 0;
+    const char* key;
+    CELIX_PROPERTIES_FOR_EACH(props, key) {
+        EXPECT_TRUE(celix_properties_hasKey(props, key));
+        count++;
+    }
+    EXPECT_EQ(100, count);
+    celix_properties_destroy(props);
+}
+
+TEST_F(PropertiesTestSuite, UpdateValueTest) {
+    auto* props = celix_properties_create();
+    celix_properties_set(props, "key", "short");
+    celix_properties_set(props, "key", "a somewhat longer value, which does not fit in place");
+    EXPECT_STREQ("a somewhat longer value, which does not fit in place", celix_properties_get(props, "key", nullptr));
+    celix_properties_set(props, "key", nullptr);
+    EXPECT_EQ(1, celix_properties_size(props));
+    EXPECT_STREQ("default", celix_properties_get(props, "key", "default"));
+    celix_properties_set(props, "key", "value");
+    EXPECT_STREQ("value", celix_properties_get(props, "key", nullptr));
+    celix_properties_destroy(props);
+}
+
+TEST_F(PropertiesTestSuite, CopyOnWriteTest) {
+    auto* props = celix_properties_create();
+    celix_properties_set(props, "key1", "value1");
+    celix_properties_setLong(props, "key2", 2);
+    const char* value1 = celix_properties_get(props, "key1", nullptr);
+
+    auto* copy = celix_properties_copy(props);
+    EXPECT_EQ(2, celix_properties_size(copy));
+    EXPECT_EQ(value1, celix_properties_get(copy, "key1", nullptr)); //note shared until modified
+
+    //modifying the original does not change the copy, the shared entries are owned by the copy after the modification
+    celix_properties_set(props, "key3", "value3");
+    celix_properties_setLong(props, "key2", 3);
+    EXPECT_EQ(3, celix_properties_size(props));
+    EXPECT_EQ(2, celix_properties_size(copy));
+    EXPECT_EQ(2, celix_properties_getAsLong(copy, "key2", 0));
+    EXPECT_EQ(3, celix_properties_getAsLong(props, "key2", 0));
+    EXPECT_FALSE(celix_properties_hasKey(copy, "key3"));
+    EXPECT_EQ(value1, celix_properties_get(copy, "key1", nullptr));
+    EXPECT_STREQ("value1", celix_properties_get(props, "key1", nullptr));
+    celix_properties_destroy(copy);
+    EXPECT_STREQ("value1", celix_properties_get(props, "key1", nullptr));
+
+    //repeated copy-then-modify cycles do not retain the previously shared entries
+    for (int i = 0; i < 100; ++i) {
+        copy = celix_properties_copy(props);
+        celix_properties_setLong(props, "key2", i);
+        EXPECT_EQ(i == 0 ? 3 : i - 1, celix_properties_getAsLong(copy, "key2", 0));
+        celix_properties_destroy(copy);
+    }
+    celix_properties_setLong(props, "key2", 3);
+
+    //modifying a copy does not change the original
+    copy = celix_properties_copy(props);
+    celix_properties_unset(copy, "key1");
+    EXPECT_FALSE(celix_properties_hasKey(copy, "key1"));
+    EXPECT_TRUE(celix_properties_hasKey(props, "key1"));
+    EXPECT_EQ(CELIX_PROPERTIES_VALUE_TYPE_LONG, celix_properties_getType(copy, "key2"));
+
+    celix_properties_destroy(props);
+    EXPECT_EQ(3, celix_properties_getAsLong(copy, "key2", 0));
+    celix_properties_destroy(copy);
+}
@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+#include "celix_sha256.h"
+
+class Sha256TestSuite : public ::testing::Test {
+public:
+    static std::string hexDigest(const std::string& data) {
+        char hex[CELIX_SHA256_HEX_STRING_SIZE];
+        celix_sha256_hexDigest(data.data(), data.size(), hex);
+        return hex;
+    }
+
+    static std::string incrementalHexDigest(const std::string& data, size_t chunkSize) {
+        celix_sha256_t ctx;
+        celix_sha256_init(&ctx);
+        for (size_t offset = 0; offset < data.size(); offset += chunkSize) {
+            celix_sha256_update(&ctx, data.data() + offset, std::min(chunkSize, data.size() - offset));
+        }
+        unsigned char digest[CELIX_SHA256_DIGEST_SIZE];
+        celix_sha256_final(&ctx, digest);
+        char hex[CELIX_SHA256_HEX_STRING_SIZE];
+        celix_sha256_digestToHexString(digest, hex);
+        return hex;
+    }
+};
+
+TEST_F(Sha256TestSuite, EmptyMessageTest) {
+    EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", hexDigest(""));
+    char hex[CELIX_SHA256_HEX_STRING_SIZE];
+    celix_sha256_hexDigest(nullptr, 0, hex);
+    EXPECT_STREQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", hex);
+}
+
+TEST_F(Sha256TestSuite, OneBlockMessageTest) {
+    //NIST FIPS 180-2 example, "abc"
+    EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", hexDigest("abc"));
+}
+
+TEST_F(Sha256TestSuite, TwoBlockMessageTest) {
+    //NIST FIPS 180-2 example, 448-bit message (padding needs a second block)
+    std::string msg = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    EXPECT_EQ("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", hexDigest(msg));
+    EXPECT_EQ("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", incrementalHexDigest(msg, 1));
+    EXPECT_EQ("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", incrementalHexDigest(msg, 7));
+}
+
+TEST_F(Sha256TestSuite, LongMessageTest) {
+    //NIST FIPS 180-2 example, one million times 'a'
+    std::string msg(1000000, 'a');
+    EXPECT_EQ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", hexDigest(msg));
+    EXPECT_EQ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", incrementalHexDigest(msg, 1000));
+    EXPECT_EQ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", incrementalHexDigest(msg, 63));
+}
+
+TEST_F(Sha256TestSuite, BlockBoundaryMessagesTest) {
+    //Messages around the padding boundaries (55, 56 and 64 bytes) give the same digest incremental and in one go
+    for (size_t size : {55, 56, 63, 64, 65, 119, 120, 128}) {
+        std::string msg(size, 'x');
+        EXPECT_EQ(hexDigest(msg), incrementalHexDigest(msg, 5)) << "size " << size;
+    }
+    EXPECT_EQ("ffe054fe7ae0cb6dc65c3af9b61d5209f439851db43d0ba5997337df154668eb", hexDigest(std::string(64, 'a')));
+}
@@ -96,7 +96,7 @@ typedef struct celix_long_hash_map_create_options {
     /**
      * @brief The initial hash map capacity.
      *
-     * The number of bucket to allocate when creating the hash map.
+     * The number of slots to allocate when creating the hash map. Will be rounded up to a power of 2.
      *
      * If 0 is provided, the hash map initial capacity will be 16 (default hash map capacity).
      * Default is 0.
@@ -107,10 +107,12 @@ typedef struct celix_long_hash_map_create_options {
      * @brief The hash map load factor, which controls the max ratio between nr of entries in the hash map and the
      * hash map capacity.
      *
-     * The load factor controls how large the hash map capacity (nr of buckets) is compared to the nr of entries
+     * The load factor controls how large the hash map capacity (nr of slots) is compared to the nr of entries
      * in the hash map. The load factor is an important property of the hash map which influences how close the
      * hash map performs to O(1) for its get, has and put operations.
      *
+     * The hash map uses open addressing, so a load factor larger than 0.875 will be capped to 0.875.
+     *
      * If the nr of entries increases above the loadFactor * capacity, the hash capacity will be doubled.
      * For example a hash map with capacity 16 and load factor 0.75 will double its capacity when the 13th entry
      * is added to the hash map.
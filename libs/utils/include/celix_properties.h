@@ -25,12 +25,38 @@
 
 #include "celix_errno.h"
 #include "celix_utils_export.h"
+#include "celix_version.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-typedef struct hashMap celix_properties_t; //opaque struct, TODO try to make this a celix_properties struct
+/**
+ * @brief A properties object, which stores typed values (string, long, double, bool or version) for string keys.
+ *
+ * Keys and values are stored in an arena per properties object and for small properties objects (up to 8 entries)
+ * the entries and (short) strings are stored inline. Copying a properties object is cheap: a copy shares the
+ * stored entries with the original until either one is modified (copy-on-write).
+ *
+ * A value returned by celix_properties_get stays valid until the entry is modified or removed, or the properties
+ * object is destroyed. Note that if the properties object shares its entries with a copy, the first modification
+ * clones the entries and invalidates all values returned before that modification.
+ *
+ * A properties object is not thread-safe for modifications; concurrent reads (including reads from copies) are safe.
+ */
+typedef struct celix_properties celix_properties_t; //opaque struct
+
+/**
+ * @brief The value type of a properties entry.
+ */
+typedef enum celix_properties_value_type {
+    CELIX_PROPERTIES_VALUE_TYPE_UNSET = 0, //entry not present
+    CELIX_PROPERTIES_VALUE_TYPE_STRING = 1,
+    CELIX_PROPERTIES_VALUE_TYPE_LONG = 2,
+    CELIX_PROPERTIES_VALUE_TYPE_DOUBLE = 3,
+    CELIX_PROPERTIES_VALUE_TYPE_BOOL = 4,
+    CELIX_PROPERTIES_VALUE_TYPE_VERSION = 5
+} celix_properties_value_type_e;
 
 typedef struct celix_properties_iterator {
     //private data
@@ -80,6 +106,46 @@ CELIX_UTILS_EXPORT void celix_properties_setBool(celix_properties_t *props, cons
 CELIX_UTILS_EXPORT void celix_properties_setDouble(celix_properties_t *props, const char *key, double val);
 CELIX_UTILS_EXPORT double celix_properties_getAsDouble(const celix_properties_t *props, const char *key, double defaultValue);
 
+/**
+ * @brief Set a version value for the provided key. The version is copied.
+ *
+ * The string value of the entry (as returned by celix_properties_get) is the version string.
+ */
+CELIX_UTILS_EXPORT void celix_properties_setVersion(celix_properties_t *props, const char *key, const celix_version_t* version);
+
+/**
+ * @brief Returns the stored version for the provided key or the defaultValue if the key is not present or the
+ * value is not stored as a version (see celix_properties_setVersion).
+ *
+ * The returned version is owned by the properties object.
+ */
+CELIX_UTILS_EXPORT const celix_version_t* celix_properties_getVersion(const celix_properties_t *props, const char *key, const celix_version_t* defaultValue);
+
+/**
+ * @brief Returns a new version for the provided key.
+ *
+ * If the value is stored as a version, a copy of the stored version is returned, otherwise the string value is
+ * parsed as a version. If the key is not present or the value is not a valid version, a copy of the defaultValue
+ * is returned (or NULL if the defaultValue is NULL).
+ *
+ * The caller is the owner of the returned version.
+ */
+CELIX_UTILS_EXPORT celix_version_t* celix_properties_getAsVersion(const celix_properties_t *props, const char *key, const celix_version_t* defaultValue);
+
+/**
+ * @brief Returns the value type of the entry for the provided key or CELIX_PROPERTIES_VALUE_TYPE_UNSET if the key
+ * is not present.
+ *
+ * Note that celix_properties_getAsLong, celix_properties_getAsDouble, celix_properties_getAsBool and
+ * celix_properties_getAsVersion return the stored value without parsing if the type matches.
+ */
+CELIX_UTILS_EXPORT celix_properties_value_type_e celix_properties_getType(const celix_properties_t *props, const char *key);
+
+/**
+ * @brief Returns whether the properties contains the provided key.
+ */
+CELIX_UTILS_EXPORT bool celix_properties_hasKey(const celix_properties_t *props, const char *key);
+
 CELIX_UTILS_EXPORT int celix_properties_size(const celix_properties_t *properties);
 
 CELIX_UTILS_EXPORT celix_properties_iterator_t celix_propertiesIterator_construct(const celix_properties_t *properties);
@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_CELIX_SHA256_H
+#define CELIX_CELIX_SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "celix_utils_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file celix_sha256.h
+ * @brief The celix_sha256.h file contains a SHA-256 (FIPS 180-4) message digest implementation.
+ *
+ * The SHA-256 digest is used to identify content (e.g. bundle zip files in the bundle store) and is not intended
+ * as a replacement for a full crypto library.
+ */
+
+/**
+ * @brief The size in bytes of a SHA-256 digest.
+ */
+#define CELIX_SHA256_DIGEST_SIZE 32
+
+/**
+ * @brief The size of a SHA-256 digest as lowercase hex string, including the terminating '\0'.
+ */
+#define CELIX_SHA256_HEX_STRING_SIZE (CELIX_SHA256_DIGEST_SIZE * 2 + 1)
+
+/**
+ * @brief The SHA-256 context, used to incrementally calculate a SHA-256 digest.
+ *
+ * The fields are an implementation detail and should not be accessed directly.
+ */
+typedef struct celix_sha256 {
+    uint32_t state[8];
+    uint64_t length; //nr of bytes processed
+    unsigned char block[64];
+    size_t blockSize; //nr of bytes in block
+} celix_sha256_t;
+
+/**
+ * @brief Initializes (or resets) the SHA-256 context.
+ */
+CELIX_UTILS_EXPORT void celix_sha256_init(celix_sha256_t* ctx);
+
+/**
+ * @brief Adds size bytes of data to the SHA-256 digest calculation.
+ *
+ * @param[in] ctx The SHA-256 context.
+ * @param[in] data The data. Can be NULL if size is 0.
+ * @param[in] size The size of the data in bytes.
+ */
+CELIX_UTILS_EXPORT void celix_sha256_update(celix_sha256_t* ctx, const void* data, size_t size);
+
+/**
+ * @brief Finishes the SHA-256 digest calculation and writes the digest to digestOut.
+ *
+ * After this call the context must be initialized again before it can be reused.
+ */
+CELIX_UTILS_EXPORT void celix_sha256_final(celix_sha256_t* ctx, unsigned char digestOut[CELIX_SHA256_DIGEST_SIZE]);
+
+/**
+ * @brief Calculates the SHA-256 digest of data and writes it as lowercase hex string to hexOut.
+ *
+ * @param[in] data The data. Can be NULL if size is 0.
+ * @param[in] size The size of the data in bytes.
+ * @param[out] hexOut The output buffer for the hex string (64 hex chars and a terminating '\0').
+ */
+CELIX_UTILS_EXPORT void celix_sha256_hexDigest(const void* data, size_t size, char hexOut[CELIX_SHA256_HEX_STRING_SIZE]);
+
+/**
+ * @brief Writes the SHA-256 digest as lowercase hex string to hexOut.
+ */
+CELIX_UTILS_EXPORT void celix_sha256_digestToHexString(const unsigned char digest[CELIX_SHA256_DIGEST_SIZE],
+                                                       char hexOut[CELIX_SHA256_HEX_STRING_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CELIX_CELIX_SHA256_H
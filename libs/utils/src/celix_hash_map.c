@@ -28,21 +28,27 @@
 #include <stdint.h>
 
 /**
- * Whether to use realloc - instead of calloc - to resize a hash map.
- *
- * With realloc the memory is increased and the
- * map entries are corrected.
- *
- * With alloc a new buckets array is allocated and
- * entries are moved into the new bucket array.
- * And the old buckets array is freed.
+ * The hash map is an open-addressing hash map (SwissTable-style):
+ *  - Entries are stored inline in an entries array, one entry per slot.
+ *  - Every slot has a control byte, which is either EMPTY, DELETED (tombstone) or - for a used slot - the lower
+ *    7 bits of the entry hash (h2).
+ *  - Control bytes are matched per group of 8 slots using a single 64 bit word (SWAR), so that a lookup only
+ *    needs to check the entries of slots with a matching h2.
+ *  - The upper bits of the hash (h1) select the first group to probe, followed by triangular probing over the
+ *    groups until a group with an EMPTY slot is found.
  *
+ * Removed entries are marked DELETED (or EMPTY if possible), so that entries are never moved on removal. This keeps
+ * iterating while removing entries (celix_*HashMapIterator_remove) valid.
  */
-#define CELIX_HASH_MAP_RESIZE_WITH_REALLOC
+#define CELIX_HASH_MAP_GROUP_SIZE 8
+#define CELIX_HASH_MAP_CTRL_EMPTY ((uint8_t)0x80)
+#define CELIX_HASH_MAP_CTRL_DELETED ((uint8_t)0xFE)
+#define CELIX_HASH_MAP_LSBS 0x0101010101010101ULL
+#define CELIX_HASH_MAP_MSBS 0x8080808080808080ULL
 
 static unsigned int DEFAULT_INITIAL_CAPACITY = 16;
 static double DEFAULT_LOAD_FACTOR = 0.75;
-static unsigned int MAXIMUM_CAPACITY = INT32_MAX/10;
+static double MAXIMUM_LOAD_FACTOR = 0.875;
 
 typedef enum celix_hash_map_key_type {
     CELIX_HASH_MAP_STRING_KEY,
@@ -58,19 +64,18 @@ typedef struct celix_hash_map_entry celix_hash_map_entry_t;
 struct celix_hash_map_entry {
     celix_hash_map_key_t key;
     celix_hash_map_value_t value;
-    celix_hash_map_entry_t* next;
-    unsigned int hash;
+    uint64_t hash;
 };
 
 typedef struct celix_hash_map {
-    celix_hash_map_entry_t** buckets;
-    unsigned int bucketsSize; //nr of buckets
-    unsigned int size; //nr of total entries
+    uint8_t* ctrl; //control bytes, 1 per slot
+    celix_hash_map_entry_t* entries; //entries, 1 per slot
+    size_t capacity; //nr of slots, a power of 2 and at least CELIX_HASH_MAP_GROUP_SIZE
+    size_t size; //nr of total entries
+    size_t nrOfDeleted; //nr of DELETED slots
+    size_t growthThreshold; //max nr of used + DELETED slots, before the hash map is rehashed
     double loadFactor;
     celix_hash_map_key_type_e keyType;
-    celix_hash_map_value_t emptyValue;
-    unsigned int (*hashKeyFunction)(const celix_hash_map_key_t* key);
-    bool (*equalsKeyFunction)(const celix_hash_map_key_t* key1, const celix_hash_map_key_t* key2);
     void (*simpleRemovedCallback)(void* value);
     void* removedCallbackData;
     void (*removedStringKeyCallback)(void* data, const char* removedKey, celix_hash_map_value_t removedValue);
@@ -86,28 +91,134 @@ struct celix_long_hash_map {
     celix_hash_map_t genericMap;
 };
 
-static unsigned int celix_stringHashMap_hash(const celix_hash_map_key_t* key) {
-    return celix_utils_stringHash(key->strKey);
+/**
+ * @brief Finalizer of MurmurHash3, used to ensure all bits of the hash are well mixed.
+ */
+static inline uint64_t celix_hashMap_mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
 }
 
-static unsigned int celix_longHashMap_hash(const celix_hash_map_key_t* key) {
-    return key->longKey ^ (key->longKey >> (sizeof(key->longKey)*8/2));
+/**
+ * @brief String hash which processes 8 bytes per step.
+ */
+static uint64_t celix_hashMap_hashString(const char* str) {
+    if (str == NULL) {
+        return 0x9e3779b97f4a7c15ULL; //note NULL is a valid key
+    }
+    size_t len = strlen(str);
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ (len * 0xc6a4a7935bd1e995ULL);
+    while (len >= 8) {
+        uint64_t word;
+        memcpy(&word, str, sizeof(word));
+        h ^= word;
+        h *= 0xc6a4a7935bd1e995ULL;
+        h ^= h >> 32;
+        str += 8;
+        len -= 8;
+    }
+    if (len > 0) {
+        uint64_t word = 0;
+        memcpy(&word, str, len);
+        h ^= word;
+        h *= 0xc6a4a7935bd1e995ULL;
+    }
+    return celix_hashMap_mix(h);
 }
 
-static bool celix_stringHashMap_equals(const celix_hash_map_key_t* key1, const celix_hash_map_key_t* key2) {
-    return celix_utils_stringEquals(key1->strKey, key2->strKey);
+static inline uint64_t celix_hashMap_hash(const celix_hash_map_t* map, const celix_hash_map_key_t* key) {
+    if (map->keyType == CELIX_HASH_MAP_STRING_KEY) {
+        return celix_hashMap_hashString(key->strKey);
+    }
+    return celix_hashMap_mix((uint64_t)key->longKey);
 }
 
-static bool celix_longHashMap_equals(const celix_hash_map_key_t* key1, const celix_hash_map_key_t* key2) {
+static inline bool celix_hashMap_equals(const celix_hash_map_t* map, const celix_hash_map_key_t* key1, const celix_hash_map_key_t* key2) {
+    if (map->keyType == CELIX_HASH_MAP_STRING_KEY) {
+        return celix_utils_stringEquals(key1->strKey, key2->strKey);
+    }
     return key1->longKey == key2->longKey;
 }
 
-static unsigned int celix_hashMap_threshold(celix_hash_map_t* map) {
-    return (unsigned int)floor((double)map->bucketsSize * map->loadFactor);
+static inline uint8_t celix_hashMap_h2(uint64_t hash) {
+    return (uint8_t)(hash & 0x7F);
+}
+
+static inline uint64_t celix_hashMap_loadGroup(const celix_hash_map_t* map, size_t group) {
+    uint64_t ctrl;
+    memcpy(&ctrl, &map->ctrl[group * CELIX_HASH_MAP_GROUP_SIZE], sizeof(ctrl));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    ctrl = __builtin_bswap64(ctrl); //ensure control byte i is byte i of the word (little endian)
+#endif
+    return ctrl;
+}
+
+/**
+ * @brief Returns a mask with the msb set for every control byte which (probably) matches h2.
+ * Note that this can give false positives, so the control byte must be checked again.
+ */
+static inline uint64_t celix_hashMap_matchH2(uint64_t ctrl, uint8_t h2) {
+    uint64_t x = ctrl ^ (CELIX_HASH_MAP_LSBS * h2);
+    return (x - CELIX_HASH_MAP_LSBS) & ~x & CELIX_HASH_MAP_MSBS;
+}
+
+/**
+ * @brief Returns a mask with the msb set for every EMPTY control byte (msb set and bit 1 not set).
+ */
+static inline uint64_t celix_hashMap_matchEmpty(uint64_t ctrl) {
+    return ctrl & ~(ctrl << 6) & CELIX_HASH_MAP_MSBS;
+}
+
+/**
+ * @brief Returns a mask with the msb set for every EMPTY or DELETED control byte.
+ */
+static inline uint64_t celix_hashMap_matchEmptyOrDeleted(uint64_t ctrl) {
+    return ctrl & CELIX_HASH_MAP_MSBS;
+}
+
+static inline size_t celix_hashMap_firstMatch(uint64_t mask) {
+    return (size_t)__builtin_ctzll(mask) / 8;
+}
+
+static inline size_t celix_hashMap_nrOfGroups(const celix_hash_map_t* map) {
+    return map->capacity / CELIX_HASH_MAP_GROUP_SIZE;
+}
+
+static celix_hash_map_entry_t* celix_hashMap_findEntry(const celix_hash_map_t* map, const celix_hash_map_key_t* key, uint64_t hash) {
+    size_t groupMask = celix_hashMap_nrOfGroups(map) - 1;
+    size_t group = (size_t)(hash >> 7) & groupMask;
+    uint8_t h2 = celix_hashMap_h2(hash);
+    for (size_t probe = 1; probe <= groupMask + 1; ++probe) {
+        uint64_t ctrl = celix_hashMap_loadGroup(map, group);
+        for (uint64_t match = celix_hashMap_matchH2(ctrl, h2); match != 0; match &= match - 1) {
+            size_t slot = group * CELIX_HASH_MAP_GROUP_SIZE + celix_hashMap_firstMatch(match);
+            celix_hash_map_entry_t* entry = &map->entries[slot];
+            if (map->ctrl[slot] == h2 && entry->hash == hash && celix_hashMap_equals(map, &entry->key, key)) {
+                return entry;
+            }
+        }
+        if (celix_hashMap_matchEmpty(ctrl) != 0) {
+            break;
+        }
+        group = (group + probe) & groupMask; //triangular probing, visits all groups
+    }
+    return NULL;
 }
 
-static unsigned int celix_hashMap_indexFor(unsigned int h, unsigned int length) {
-    return h & (length - 1);
+static size_t celix_hashMap_findInsertSlot(const celix_hash_map_t* map, uint64_t hash) {
+    size_t groupMask = celix_hashMap_nrOfGroups(map) - 1;
+    size_t group = (size_t)(hash >> 7) & groupMask;
+    for (size_t probe = 1;; ++probe) {
+        uint64_t match = celix_hashMap_matchEmptyOrDeleted(celix_hashMap_loadGroup(map, group));
+        if (match != 0) {
+            return group * CELIX_HASH_MAP_GROUP_SIZE + celix_hashMap_firstMatch(match);
+        }
+        group = (group + probe) & groupMask;
+    }
 }
 
 static celix_hash_map_entry_t* celix_hashMap_getEntry(const celix_hash_map_t* map, const char* strKey, long longKey) {
@@ -117,14 +228,7 @@ static celix_hash_map_entry_t* celix_hashMap_getEntry(const celix_hash_map_t* ma
     } else {
         key.longKey = longKey;
     }
-    unsigned int hash = map->hashKeyFunction(&key);
-    unsigned int index = celix_hashMap_indexFor(hash, map->bucketsSize);
-    for (celix_hash_map_entry_t* entry = map->buckets[index]; entry != NULL; entry = entry->next) {
-        if (entry->hash == hash && map->equalsKeyFunction(&key, &entry->key)) {
-            return entry;
-        }
-    }
-    return NULL;
+    return celix_hashMap_findEntry(map, &key, celix_hashMap_hash(map, &key));
 }
 
 static void* celix_hashMap_get(const celix_hash_map_t* map, const char* strKey, long longKey) {
@@ -163,70 +267,61 @@ bool celix_hashMap_hasKey(const celix_hash_map_t* map, const char* strKey, long
     return celix_hashMap_getEntry(map, strKey, longKey) != NULL;
 }
 
-#ifdef CELIX_HASH_MAP_RESIZE_WITH_REALLOC
-static void celix_hashMap_resize(celix_hash_map_t* map, size_t newCapacity) {
-    if (map->bucketsSize == MAXIMUM_CAPACITY) {
-        return;
-    }
-
-    assert(newCapacity > map->bucketsSize); //hash map can only grow
-    map->buckets = realloc(map->buckets, newCapacity * sizeof(celix_hash_map_entry_t*));
+static size_t celix_hashMap_growthThreshold(size_t capacity, double loadFactor) {
+    size_t threshold = (size_t)floor((double)capacity * loadFactor);
+    //note ensure there is always at least 1 EMPTY slot, so that probing always ends
+    return threshold < capacity ? threshold : capacity - 1;
+}
 
-    //clear newly added mem
-    for (unsigned int i = map->bucketsSize; i < newCapacity; ++i) {
-        map->buckets[i]= NULL;
+static size_t celix_hashMap_capacityFor(size_t minCapacity, size_t nrOfEntries, double loadFactor) {
+    size_t capacity = CELIX_HASH_MAP_GROUP_SIZE;
+    while (capacity < minCapacity || celix_hashMap_growthThreshold(capacity, loadFactor) < nrOfEntries) {
+        capacity *= 2;
     }
-
-    //reinsert old entries
-    for (unsigned i = 0; i < map->bucketsSize; i++) {
-        celix_hash_map_entry_t* entry = map->buckets[i];
-        if (entry != NULL) {
-            map->buckets[i] = NULL;
-            do {
-                celix_hash_map_entry_t* next = entry->next;
-                unsigned int bucketIndex = celix_hashMap_indexFor(entry->hash, newCapacity);
-                entry->next = map->buckets[bucketIndex];
-                map->buckets[bucketIndex] = entry;
-                entry = next;
-            } while (entry != NULL);
-        }
-    }
-
-    //update bucketSize to new capacity
-    map->bucketsSize = newCapacity;
+    return capacity;
 }
-#else
-static void celix_hashMap_resize(celix_hash_map_t* map, size_t newCapacity) {
-    celix_hash_map_entry_t** newTable;
-    unsigned int j;
-    if (map->bucketsSize == MAXIMUM_CAPACITY) {
-        return;
-    }
 
-    newTable = calloc(newCapacity, sizeof(celix_hash_map_entry_t*));
+static void celix_hashMap_allocSlots(celix_hash_map_t* map, size_t capacity) {
+    map->capacity = capacity;
+    map->ctrl = malloc(capacity);
+    memset(map->ctrl, CELIX_HASH_MAP_CTRL_EMPTY, capacity);
+    map->entries = malloc(capacity * sizeof(*map->entries));
+    map->nrOfDeleted = 0;
+    map->growthThreshold = celix_hashMap_growthThreshold(capacity, map->loadFactor);
+}
 
-    for (j = 0; j < map->bucketsSize; j++) {
-        celix_hash_map_entry_t* entry = map->buckets[j];
-        if (entry != NULL) {
-            map->buckets[j] = NULL;
-            do {
-                celix_hash_map_entry_t* next = entry->next;
-                unsigned int i = celix_hashMap_indexFor(entry->hash, newCapacity);
-                entry->next = newTable[i];
-                newTable[i] = entry;
-                entry = next;
-            } while (entry != NULL);
+/**
+ * @brief Rehash all entries into new slot arrays with the provided capacity. Also removes all DELETED slots.
+ */
+static void celix_hashMap_rehash(celix_hash_map_t* map, size_t newCapacity) {
+    uint8_t* oldCtrl = map->ctrl;
+    celix_hash_map_entry_t* oldEntries = map->entries;
+    size_t oldCapacity = map->capacity;
+
+    celix_hashMap_allocSlots(map, newCapacity);
+    for (size_t i = 0; i < oldCapacity; ++i) {
+        if ((oldCtrl[i] & CELIX_HASH_MAP_CTRL_EMPTY) == 0) {
+            size_t slot = celix_hashMap_findInsertSlot(map, oldEntries[i].hash);
+            map->ctrl[slot] = celix_hashMap_h2(oldEntries[i].hash);
+            map->entries[slot] = oldEntries[i];
         }
     }
-    free(map->buckets);
-    map->buckets = newTable;
-    map->bucketsSize = newCapacity;
+    free(oldCtrl);
+    free(oldEntries);
 }
-#endif
 
-static void celix_hashMap_addEntry(celix_hash_map_t* map, unsigned int hash, const celix_hash_map_key_t* key, const celix_hash_map_value_t* value, unsigned int bucketIndex) {
-    celix_hash_map_entry_t* entry = map->buckets[bucketIndex];
-    celix_hash_map_entry_t* newEntry = malloc(sizeof(*newEntry));
+static void celix_hashMap_addEntry(celix_hash_map_t* map, uint64_t hash, const celix_hash_map_key_t* key, const celix_hash_map_value_t* value) {
+    if (map->size + map->nrOfDeleted + 1 > map->growthThreshold) {
+        //note if most of the used slots are DELETED slots, rehash with the same capacity
+        size_t newCapacity = map->size + 1 > map->growthThreshold / 2 ? map->capacity * 2 : map->capacity;
+        celix_hashMap_rehash(map, celix_hashMap_capacityFor(newCapacity, map->size + 1, map->loadFactor));
+    }
+    size_t slot = celix_hashMap_findInsertSlot(map, hash);
+    if (map->ctrl[slot] == CELIX_HASH_MAP_CTRL_DELETED) {
+        map->nrOfDeleted -= 1;
+    }
+    map->ctrl[slot] = celix_hashMap_h2(hash);
+    celix_hash_map_entry_t* newEntry = &map->entries[slot];
     newEntry->hash = hash;
     if (map->keyType == CELIX_HASH_MAP_STRING_KEY) {
         newEntry->key.strKey = map->storeKeysWeakly ? key->strKey : celix_utils_strdup(key->strKey);
@@ -234,11 +329,7 @@ static void celix_hashMap_addEntry(celix_hash_map_t* map, unsigned int hash, con
         newEntry->key.longKey = key->longKey;
     }
     memcpy(&newEntry->value, value, sizeof(*value));
-    newEntry->next = entry;
-    map->buckets[bucketIndex] = newEntry;
-    if (map->size++ >= celix_hashMap_threshold(map)) {
-        celix_hashMap_resize(map, 2 * map->bucketsSize);
-    }
+    map->size += 1;
 }
 
 static bool celix_hashMap_putValue(celix_hash_map_t* map, const char* strKey, long longKey, const celix_hash_map_value_t* value, celix_hash_map_value_t* replacedValueOut) {
@@ -248,19 +339,17 @@ static bool celix_hashMap_putValue(celix_hash_map_t* map, const char* strKey, lo
     } else {
         key.longKey = longKey;
     }
-    unsigned int hash = map->hashKeyFunction(&key);
-    unsigned int index = celix_hashMap_indexFor(hash, map->bucketsSize);
-    for (celix_hash_map_entry_t* entry = map->buckets[index]; entry != NULL; entry = entry->next) {
-        if (entry->hash == hash && map->equalsKeyFunction(&key, &entry->key)) {
-            //entry found, replacing entry
-            if (replacedValueOut != NULL) {
-                *replacedValueOut = entry->value;
-            }
-            memcpy(&entry->value, value, sizeof(*value));
-            return true;
+    uint64_t hash = celix_hashMap_hash(map, &key);
+    celix_hash_map_entry_t* entry = celix_hashMap_findEntry(map, &key, hash);
+    if (entry != NULL) {
+        //entry found, replacing entry
+        if (replacedValueOut != NULL) {
+            *replacedValueOut = entry->value;
         }
+        memcpy(&entry->value, value, sizeof(*value));
+        return true;
     }
-    celix_hashMap_addEntry(map, hash, &key, value, index);
+    celix_hashMap_addEntry(map, hash, &key, value);
     if (replacedValueOut != NULL) {
         memset(replacedValueOut, 0, sizeof(*replacedValueOut));
     }
@@ -304,91 +393,68 @@ static void celix_hashMap_destroyRemovedEntry(celix_hash_map_t* map, celix_hash_
     if (map->keyType == CELIX_HASH_MAP_STRING_KEY && !map->storeKeysWeakly) {
         free((char*)removedEntry->key.strKey);
     }
-    free(removedEntry);
 }
 
 static bool celix_hashMap_remove(celix_hash_map_t* map, const char* strKey, long longKey) {
-    celix_hash_map_key_t key;
-    if (map->keyType == CELIX_HASH_MAP_STRING_KEY) {
-        key.strKey = strKey;
-    } else {
-        key.longKey = longKey;
+    celix_hash_map_entry_t* removedEntry = celix_hashMap_getEntry(map, strKey, longKey);
+    if (removedEntry == NULL) {
+        return false;
     }
 
-    unsigned int hash = map->hashKeyFunction(&key);
-    unsigned int index = celix_hashMap_indexFor(hash, map->bucketsSize);
-    celix_hash_map_entry_t* visit = map->buckets[index];
-    celix_hash_map_entry_t* removedEntry = NULL;
-    celix_hash_map_entry_t* prev = NULL;
-
-    while (visit != NULL) {
-        if (visit->hash == hash && map->equalsKeyFunction(&key, &visit->key)) {
-            //hash & equals -> found entry
-            map->size--;
-            if (map->buckets[index] == visit) {
-                //current entry is first entry in bucket, set next to first entry in bucket
-                map->buckets[index] = visit->next;
-            } else {
-                //entry is in between, update link of prev to next entry
-                prev->next = visit->next;
-            }
-            removedEntry = visit;
-            break;
-        }
-        prev = visit;
-        visit = visit->next;
-    }
-    if (removedEntry != NULL) {
-        celix_hashMap_destroyRemovedEntry(map, removedEntry);
-        return true;
+    size_t slot = removedEntry - map->entries;
+    if (celix_hashMap_matchEmpty(celix_hashMap_loadGroup(map, slot / CELIX_HASH_MAP_GROUP_SIZE)) != 0) {
+        //note if the group has an EMPTY slot, no probe sequence continued past this group, so the slot can be EMPTY
+        map->ctrl[slot] = CELIX_HASH_MAP_CTRL_EMPTY;
+    } else {
+        map->ctrl[slot] = CELIX_HASH_MAP_CTRL_DELETED;
+        map->nrOfDeleted += 1;
     }
-    return false;
+    map->size--;
+
+    celix_hash_map_entry_t removed = *removedEntry;
+    celix_hashMap_destroyRemovedEntry(map, &removed);
+    return true;
 }
 
 static void celix_hashMap_init(
         celix_hash_map_t* map,
         celix_hash_map_key_type_e keyType,
         unsigned int initialCapacity,
-        double loadFactor,
-        unsigned int (*hashKeyFn)(const celix_hash_map_key_t*),
-        bool (*equalsKeyFn)(const celix_hash_map_key_t*, const celix_hash_map_key_t*)) {
-    map->loadFactor = loadFactor;
-    map->buckets = calloc(initialCapacity, sizeof(celix_hash_map_entry_t*));
+        double loadFactor) {
+    map->loadFactor = loadFactor > MAXIMUM_LOAD_FACTOR ? MAXIMUM_LOAD_FACTOR : loadFactor;
     map->size = 0;
-    map->bucketsSize = initialCapacity;
     map->keyType = keyType;
-    memset(&map->emptyValue, 0, sizeof(map->emptyValue));
-    map->hashKeyFunction = hashKeyFn;
-    map->equalsKeyFunction = equalsKeyFn;
     map->simpleRemovedCallback = NULL;
     map->removedCallbackData = NULL;
     map->removedLongKeyCallback = NULL;
     map->removedStringKeyCallback = NULL;
     map->storeKeysWeakly = false;
+    celix_hashMap_allocSlots(map, celix_hashMap_capacityFor(initialCapacity, 0, map->loadFactor));
 }
 
 static void celix_hashMap_clear(celix_hash_map_t* map) {
-    for (unsigned int i = 0; i < map->bucketsSize; i++) {
-        celix_hash_map_entry_t* entry = map->buckets[i];
-        while (entry != NULL) {
-            celix_hash_map_entry_t* removedEntry = entry;
-            entry = entry->next;
-            celix_hashMap_destroyRemovedEntry(map, removedEntry);
+    for (size_t i = 0; i < map->capacity; i++) {
+        if ((map->ctrl[i] & CELIX_HASH_MAP_CTRL_EMPTY) == 0) {
+            map->ctrl[i] = CELIX_HASH_MAP_CTRL_EMPTY;
+            celix_hashMap_destroyRemovedEntry(map, &map->entries[i]);
         }
-        map->buckets[i] = NULL;
     }
+    memset(map->ctrl, CELIX_HASH_MAP_CTRL_EMPTY, map->capacity);
     map->size = 0;
+    map->nrOfDeleted = 0;
 }
 
-static celix_hash_map_entry_t* celix_hashMap_firstEntry(const celix_hash_map_t* map) {
-    celix_hash_map_entry_t* entry = NULL;
-    for (unsigned int index = 0; index < map->bucketsSize; ++index) {
-        entry = map->buckets[index];
-        if (entry != NULL) {
-            break;
+static celix_hash_map_entry_t* celix_hashMap_entryFromSlot(const celix_hash_map_t* map, size_t slot) {
+    for (; slot < map->capacity; ++slot) {
+        if ((map->ctrl[slot] & CELIX_HASH_MAP_CTRL_EMPTY) == 0) {
+            return &map->entries[slot];
         }
     }
-    return entry;
+    return NULL;
+}
+
+static celix_hash_map_entry_t* celix_hashMap_firstEntry(const celix_hash_map_t* map) {
+    return celix_hashMap_entryFromSlot(map, 0);
 }
 
 static celix_hash_map_entry_t* celix_hashMap_nextEntry(const celix_hash_map_t* map, celix_hash_map_entry_t* entry) {
@@ -396,22 +462,8 @@ static celix_hash_map_entry_t* celix_hashMap_nextEntry(const celix_hash_map_t* m
         //end entry, just return NULL
         return NULL;
     }
-
-    celix_hash_map_entry_t* next = NULL;
-    if (entry != NULL) {
-        if (entry->next != NULL) {
-            next = entry->next;
-        } else {
-            unsigned int index = celix_hashMap_indexFor(entry->hash, map->bucketsSize) + 1; //next index
-            while (index < map->bucketsSize) {
-                next = map->buckets[index++];
-                if (next != NULL) {
-                    break;
-                }
-            }
-        }
-    }
-    return next;
+    size_t slot = entry - map->entries;
+    return celix_hashMap_entryFromSlot(map, slot + 1);
 }
 
 
@@ -419,7 +471,7 @@ celix_string_hash_map_t* celix_stringHashMap_createWithOptions(const celix_strin
     celix_string_hash_map_t* map = calloc(1, sizeof(*map));
     unsigned int cap = opts->initialCapacity > 0 ? opts->initialCapacity : DEFAULT_INITIAL_CAPACITY;
     double fac = opts->loadFactor > 0 ? opts->loadFactor : DEFAULT_LOAD_FACTOR;
-    celix_hashMap_init(&map->genericMap, CELIX_HASH_MAP_STRING_KEY, cap, fac, celix_stringHashMap_hash, celix_stringHashMap_equals);
+    celix_hashMap_init(&map->genericMap, CELIX_HASH_MAP_STRING_KEY, cap, fac);
     map->genericMap.simpleRemovedCallback = opts->simpleRemovedCallback;
     map->genericMap.removedCallbackData = opts->removedCallbackData;
     map->genericMap.removedStringKeyCallback = opts->removedCallback;
@@ -436,7 +488,7 @@ celix_long_hash_map_t* celix_longHashMap_createWithOptions(const celix_long_hash
     celix_long_hash_map_t* map = calloc(1, sizeof(*map));
     unsigned int cap = opts->initialCapacity > 0 ? opts->initialCapacity : DEFAULT_INITIAL_CAPACITY;
     double fac = opts->loadFactor > 0 ? opts->loadFactor : DEFAULT_LOAD_FACTOR;
-    celix_hashMap_init(&map->genericMap, CELIX_HASH_MAP_LONG_KEY, cap, fac, celix_longHashMap_hash, celix_longHashMap_equals);
+    celix_hashMap_init(&map->genericMap, CELIX_HASH_MAP_LONG_KEY, cap, fac);
     map->genericMap.simpleRemovedCallback = opts->simpleRemovedCallback;
     map->genericMap.removedCallbackData = opts->removedCallbackData;
     map->genericMap.removedLongKeyCallback = opts->removedCallback;
@@ -452,7 +504,8 @@ celix_long_hash_map_t* celix_longHashMap_create() {
 void celix_stringHashMap_destroy(celix_string_hash_map_t* map) {
     if (map != NULL) {
         celix_hashMap_clear(&map->genericMap);
-        free(map->genericMap.buckets);
+        free(map->genericMap.ctrl);
+        free(map->genericMap.entries);
         free(map);
     }
 }
@@ -460,7 +513,8 @@ void celix_stringHashMap_destroy(celix_string_hash_map_t* map) {
 void celix_longHashMap_destroy(celix_long_hash_map_t* map) {
     if (map != NULL) {
         celix_hashMap_clear(&map->genericMap);
-        free(map->genericMap.buckets);
+        free(map->genericMap.ctrl);
+        free(map->genericMap.entries);
         free(map);
     }
 }
@@ -0,0 +1,147 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_sha256.h"
+
+#include <string.h>
+
+static const uint32_t CELIX_SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define CELIX_SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void celix_sha256_processBlock(uint32_t state[8], const unsigned char* block) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16) |
+               ((uint32_t)block[i * 4 + 2] << 8) | (uint32_t)block[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = CELIX_SHA256_ROTR(w[i - 15], 7) ^ CELIX_SHA256_ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = CELIX_SHA256_ROTR(w[i - 2], 17) ^ CELIX_SHA256_ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; ++i) {
+        uint32_t s1 = CELIX_SHA256_ROTR(e, 6) ^ CELIX_SHA256_ROTR(e, 11) ^ CELIX_SHA256_ROTR(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + CELIX_SHA256_K[i] + w[i];
+        uint32_t s0 = CELIX_SHA256_ROTR(a, 2) ^ CELIX_SHA256_ROTR(a, 13) ^ CELIX_SHA256_ROTR(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+void celix_sha256_init(celix_sha256_t* ctx) {
+    static const uint32_t initialState[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    memcpy(ctx->state, initialState, sizeof(initialState));
+    ctx->length = 0;
+    ctx->blockSize = 0;
+}
+
+void celix_sha256_update(celix_sha256_t* ctx, const void* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    const unsigned char* bytes = data;
+    ctx->length += size;
+    if (ctx->blockSize > 0) {
+        size_t n = sizeof(ctx->block) - ctx->blockSize;
+        n = n < size ? n : size;
+        memcpy(ctx->block + ctx->blockSize, bytes, n);
+        ctx->blockSize += n;
+        bytes += n;
+        size -= n;
+        if (ctx->blockSize < sizeof(ctx->block)) {
+            return;
+        }
+        celix_sha256_processBlock(ctx->state, ctx->block);
+        ctx->blockSize = 0;
+    }
+    //note full blocks are processed directly from data, without copying
+    for (; size >= sizeof(ctx->block); bytes += sizeof(ctx->block), size -= sizeof(ctx->block)) {
+        celix_sha256_processBlock(ctx->state, bytes);
+    }
+    if (size > 0) {
+        memcpy(ctx->block, bytes, size);
+        ctx->blockSize = size;
+    }
+}
+
+void celix_sha256_final(celix_sha256_t* ctx, unsigned char digestOut[CELIX_SHA256_DIGEST_SIZE]) {
+    //note padding: 0x80, zeros and the message length in bits (big endian), in 1 or 2 blocks
+    uint64_t bitLength = ctx->length * 8;
+    ctx->block[ctx->blockSize++] = 0x80;
+    if (ctx->blockSize > 56) {
+        memset(ctx->block + ctx->blockSize, 0, sizeof(ctx->block) - ctx->blockSize);
+        celix_sha256_processBlock(ctx->state, ctx->block);
+        ctx->blockSize = 0;
+    }
+    memset(ctx->block + ctx->blockSize, 0, 56 - ctx->blockSize);
+    for (int i = 0; i < 8; ++i) {
+        ctx->block[63 - i] = (unsigned char)(bitLength >> (i * 8));
+    }
+    celix_sha256_processBlock(ctx->state, ctx->block);
+
+    for (int i = 0; i < 8; ++i) {
+        digestOut[i * 4] = (unsigned char)(ctx->state[i] >> 24);
+        digestOut[i * 4 + 1] = (unsigned char)(ctx->state[i] >> 16);
+        digestOut[i * 4 + 2] = (unsigned char)(ctx->state[i] >> 8);
+        digestOut[i * 4 + 3] = (unsigned char)ctx->state[i];
+    }
+}
+
+void celix_sha256_digestToHexString(const unsigned char digest[CELIX_SHA256_DIGEST_SIZE],
+                                    char hexOut[CELIX_SHA256_HEX_STRING_SIZE]) {
+    static const char hexChars[] = "0123456789abcdef";
+    for (int i = 0; i < CELIX_SHA256_DIGEST_SIZE; ++i) {
+        hexOut[i * 2] = hexChars[digest[i] >> 4];
+        hexOut[i * 2 + 1] = hexChars[digest[i] & 0x0f];
+    }
+    hexOut[CELIX_SHA256_HEX_STRING_SIZE - 1] = '\0';
+}
+
+void celix_sha256_hexDigest(const void* data, size_t size, char hexOut[CELIX_SHA256_HEX_STRING_SIZE]) {
+    celix_sha256_t ctx;
+    unsigned char digest[CELIX_SHA256_DIGEST_SIZE];
+    celix_sha256_init(&ctx);
+    celix_sha256_update(&ctx, data, size);
+    celix_sha256_final(&ctx, digest);
+    celix_sha256_digestToHexString(digest, hexOut);
+}
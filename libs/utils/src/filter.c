@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <assert.h>
+#include <limits.h>
 #include <utils.h>
 
 #include "celix_filter.h"
@@ -29,6 +30,35 @@
 #include "celix_errno.h"
 #include "celix_version.h"
 #include "celix_convert_utils.h"
+#include "version_private.h"
+#include "properties_private.h"
+
+/**
+ * @brief The max length of a version qualifier which can be parsed without allocation during filter matching.
+ */
+#define CELIX_FILTER_VERSION_QUALIFIER_BUFFER_SIZE 64
+
+typedef enum celix_filter_opcode {
+    CELIX_FILTER_OPCODE_MATCH,          //result = match of the leaf filter
+    CELIX_FILTER_OPCODE_JUMP_IF_FALSE,  //if !result, continue at jumpTarget
+    CELIX_FILTER_OPCODE_JUMP_IF_TRUE,   //if result, continue at jumpTarget
+    CELIX_FILTER_OPCODE_NOT,            //result = !result
+} celix_filter_opcode_e;
+
+/**
+ * @brief A compiled filter instruction.
+ *
+ * A filter is compiled to a flat instruction array, so that matching a filter does not need recursion:
+ *  - A leaf filter (compare, present, substring, approx) compiles to a MATCH instruction.
+ *  - AND children compile to the children instructions separated by JUMP_IF_FALSE instructions to the end.
+ *  - OR children compile to the children instructions separated by JUMP_IF_TRUE instructions to the end.
+ *  - NOT compiles to the child instructions followed by a NOT instruction.
+ */
+typedef struct celix_filter_instruction {
+    celix_filter_opcode_e opcode;
+    size_t jumpTarget; //for JUMP_IF_FALSE and JUMP_IF_TRUE
+    const celix_filter_t* leaf; //for MATCH
+} celix_filter_instruction_t;
 
 struct celix_filter_internal {
     bool convertedToLong;
@@ -37,6 +67,9 @@ struct celix_filter_internal {
     double doubleValue;
     bool convertedToVersion;
     celix_version_t *versionValue;
+
+    size_t programSize;
+    celix_filter_instruction_t* program; //compiled (flat) instructions for this (sub)filter
 };
 
 static void filter_skipWhiteSpace(char* filterString, int* pos);
@@ -49,7 +82,7 @@ static char * filter_parseAttr(char* filterString, int* pos);
 static char * filter_parseValue(char* filterString, int* pos);
 static celix_array_list_t* filter_parseSubstring(char* filterString, int* pos);
 
-static celix_status_t filter_compare(const celix_filter_t* filter, const char *propertyValue, bool *result);
+static celix_status_t filter_compare(const celix_filter_t* filter, const celix_properties_entry_t* entry, bool *result);
 
 static void filter_skipWhiteSpace(char * filterString, int * pos) {
     int length;
@@ -427,25 +460,70 @@ static bool celix_filter_isCompareOperand(celix_filter_operand_t operand) {
 }
 
 
-static bool celix_filter_hasFilterChildren(celix_filter_t* filter) {
+static bool celix_filter_hasFilterChildren(const celix_filter_t* filter) {
     return filter->operand == CELIX_FILTER_OPERAND_AND ||
            filter->operand == CELIX_FILTER_OPERAND_OR ||
            filter->operand == CELIX_FILTER_OPERAND_NOT;
 }
 
+static size_t celix_filter_nrOfInstructions(const celix_filter_t* filter) {
+    if (!celix_filter_hasFilterChildren(filter)) {
+        return 1;
+    }
+    int size = celix_arrayList_size(filter->children);
+    size_t count = filter->operand == CELIX_FILTER_OPERAND_NOT ? 1 : (size_t)(size > 0 ? size - 1 : 0);
+    for (int i = 0; i < size; ++i) {
+        count += celix_filter_nrOfInstructions(celix_arrayList_get(filter->children, i));
+    }
+    return count;
+}
+
 /**
- * Compiles the filter, so that the attribute values are converted to the typed values if possible.
+ * Emits the instructions for the provided filter at program[*pos] and updates *pos.
+ */
+static void celix_filter_emitInstructions(const celix_filter_t* filter, celix_filter_instruction_t* program, size_t* pos) {
+    if (!celix_filter_hasFilterChildren(filter)) {
+        program[*pos].opcode = CELIX_FILTER_OPCODE_MATCH;
+        program[*pos].leaf = filter;
+        *pos += 1;
+        return;
+    }
+
+    int size = celix_arrayList_size(filter->children);
+    if (filter->operand == CELIX_FILTER_OPERAND_NOT) {
+        celix_filter_emitInstructions(celix_arrayList_get(filter->children, 0), program, pos);
+        program[*pos].opcode = CELIX_FILTER_OPCODE_NOT;
+        *pos += 1;
+        return;
+    }
+
+    //AND or OR: jump to the end as soon as the result is known
+    size_t endPos = *pos + celix_filter_nrOfInstructions(filter);
+    celix_filter_opcode_e jump = filter->operand == CELIX_FILTER_OPERAND_AND ? CELIX_FILTER_OPCODE_JUMP_IF_FALSE : CELIX_FILTER_OPCODE_JUMP_IF_TRUE;
+    for (int i = 0; i < size; ++i) {
+        celix_filter_emitInstructions(celix_arrayList_get(filter->children, i), program, pos);
+        if (i + 1 < size) {
+            program[*pos].opcode = jump;
+            program[*pos].jumpTarget = endPos;
+            *pos += 1;
+        }
+    }
+}
+
+/**
+ * Compiles the filter, so that the attribute values are converted to the typed values if possible and the filter
+ * is compiled to a flat instruction array.
  */
 static celix_status_t celix_filter_compile(celix_filter_t* filter) {
+    filter->internal = calloc(1, sizeof(*filter->internal));
+    if (filter->internal == NULL) {
+        return CELIX_ENOMEM;
+    }
+
     if (celix_filter_isCompareOperand(filter->operand)) {
-        filter->internal = malloc(sizeof(*filter->internal));
-        if (filter->internal == NULL) {
-            return CELIX_ENOMEM;
-        } else {
-            filter->internal->longValue = celix_utils_convertStringToLong(filter->value, 0, &filter->internal->convertedToLong);
-            filter->internal->doubleValue = celix_utils_convertStringToDouble(filter->value, 0.0, &filter->internal->convertedToDouble);
-            filter->internal->versionValue = celix_utils_convertStringToVersion(filter->value, NULL, &filter->internal->convertedToVersion);
-        }
+        filter->internal->longValue = celix_utils_convertStringToLong(filter->value, 0, &filter->internal->convertedToLong);
+        filter->internal->doubleValue = celix_utils_convertStringToDouble(filter->value, 0.0, &filter->internal->convertedToDouble);
+        filter->internal->versionValue = celix_utils_convertStringToVersion(filter->value, NULL, &filter->internal->convertedToVersion);
     }
 
     if (celix_filter_hasFilterChildren(filter)) {
@@ -458,6 +536,16 @@ static celix_status_t celix_filter_compile(celix_filter_t* filter) {
         }
     }
 
+    size_t programSize = celix_filter_nrOfInstructions(filter);
+    filter->internal->program = calloc(programSize, sizeof(*filter->internal->program));
+    if (filter->internal->program == NULL) {
+        return CELIX_ENOMEM;
+    }
+    size_t pos = 0;
+    celix_filter_emitInstructions(filter, filter->internal->program, &pos);
+    assert(pos == programSize);
+    filter->internal->programSize = programSize;
+
     return CELIX_SUCCESS;
 }
 
@@ -469,21 +557,111 @@ celix_status_t filter_match(celix_filter_t * filter, celix_properties_t *propert
     return CELIX_SUCCESS;
 }
 
-static int celix_filter_compareAttributeValue(const celix_filter_t* filter, const char* propertyValue) {
+/**
+ * @brief Parses a property value as version, using the same rules as celix_utils_convertStringToVersion, but without
+ * allocating a version object.
+ *
+ * The qualifier of the parsed version is written to the provided qualifier buffer. Only if the qualifier does not fit
+ * in the buffer, the qualifier is allocated and should be freed by the caller.
+ */
+static bool celix_filter_parseVersion(const char* str, celix_version_t* version, char* qualifierBuffer, size_t qualifierBufferSize) {
+    //only try to parse a version if the string has at least two dots ('.')
+    const char* firstDot = strchr(str, '.');
+    if (firstDot == NULL || firstDot == strrchr(str, '.')) {
+        return false;
+    }
+
+    const char* begin = str;
+    const char* end = str + strlen(str);
+    while (begin < end && isspace((unsigned char)*begin)) {
+        ++begin;
+    }
+    while (end > begin && isspace((unsigned char)end[-1])) {
+        --end;
+    }
+
+    const char* qualifier;
+    size_t qualifierLen;
+    if (!celix_version_parse(begin, end - begin, &version->major, &version->minor, &version->micro, &qualifier,
+                             &qualifierLen)) {
+        return false;
+    }
+    version->qualifier = qualifierLen < qualifierBufferSize ? qualifierBuffer : malloc(qualifierLen + 1);
+    if (version->qualifier == NULL) {
+        return false;
+    }
+    memcpy(version->qualifier, qualifier, qualifierLen);
+    version->qualifier[qualifierLen] = '\0';
+    return true;
+}
+
+static int celix_filter_compareLong(long value, long filterValue) {
+    if (value < filterValue) {
+        return -1;
+    } else if (value > filterValue) {
+        return 1;
+    }
+    return 0;
+}
+
+static int celix_filter_compareDouble(double value, double filterValue) {
+    if (value < filterValue) {
+        return -1;
+    } else if (value > filterValue) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Compares the typed value of a long, double or version entry with the filter value.
+ * @return true if the typed value could be compared, false if a string based compare is needed.
+ */
+static bool celix_filter_compareTypedValue(const celix_filter_t* filter, const celix_properties_entry_t* entry, int* cmp) {
+    switch (entry->valueType) {
+        case CELIX_PROPERTIES_VALUE_TYPE_LONG:
+            if (filter->internal->convertedToLong) {
+                *cmp = celix_filter_compareLong(entry->typed.longValue, filter->internal->longValue);
+                return true;
+            } else if (filter->internal->convertedToDouble) {
+                *cmp = celix_filter_compareDouble((double)entry->typed.longValue, filter->internal->doubleValue);
+                return true;
+            }
+            return false;
+        case CELIX_PROPERTIES_VALUE_TYPE_DOUBLE:
+            if (filter->internal->convertedToDouble) {
+                *cmp = celix_filter_compareDouble(entry->typed.doubleValue, filter->internal->doubleValue);
+                return true;
+            }
+            return false;
+        case CELIX_PROPERTIES_VALUE_TYPE_VERSION:
+            if (filter->internal->convertedToVersion) {
+                *cmp = celix_version_compareTo(entry->typed.versionValue, filter->internal->versionValue);
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+static int celix_filter_compareAttributeValue(const celix_filter_t* filter, const celix_properties_entry_t* entry) {
+    const char* propertyValue = entry->value;
     if (!filter->internal->convertedToLong && !filter->internal->convertedToDouble && !filter->internal->convertedToVersion) {
         return strcmp(propertyValue, filter->value);
     }
 
+    int cmp;
+    if (celix_filter_compareTypedValue(filter, entry, &cmp)) {
+        return cmp;
+    }
+
+    //note string (or bool) entry, or a typed entry not comparable with the filter value: parse the string value
     if (filter->internal->convertedToLong) {
         bool propertyValueIsLong = false;
         long value = celix_utils_convertStringToLong(propertyValue, 0, &propertyValueIsLong);
         if (propertyValueIsLong) {
-            if (value < filter->internal->longValue)
-                return -1;
-            else if (value > filter->internal->longValue)
-                return 1;
-            else
-                return 0;
+            return celix_filter_compareLong(value, filter->internal->longValue);
         }
     }
 
@@ -491,22 +669,18 @@ static int celix_filter_compareAttributeValue(const celix_filter_t* filter, cons
         bool propertyValueIsDouble = false;
         double value = celix_utils_convertStringToDouble(propertyValue, 0.0, &propertyValueIsDouble);
         if (propertyValueIsDouble) {
-            if (value < filter->internal->doubleValue) {
-                return -1;
-            } else if (value > filter->internal->doubleValue) {
-                return 1;
-            } else {
-                return 0;
-            }
+            return celix_filter_compareDouble(value, filter->internal->doubleValue);
         }
     }
 
     if (filter->internal->convertedToVersion) {
-        bool propertyValueIsVersion = false;
-        celix_version_t *value = celix_utils_convertStringToVersion(propertyValue, NULL, &propertyValueIsVersion);
-        if (propertyValueIsVersion) {
-            int cmp = celix_version_compareTo(value, filter->internal->versionValue);
-            celix_version_destroy(value);
+        char qualifierBuffer[CELIX_FILTER_VERSION_QUALIFIER_BUFFER_SIZE];
+        celix_version_t value;
+        if (celix_filter_parseVersion(propertyValue, &value, qualifierBuffer, sizeof(qualifierBuffer))) {
+            cmp = celix_version_compareTo(&value, filter->internal->versionValue);
+            if (value.qualifier != qualifierBuffer) {
+                free(value.qualifier);
+            }
             return cmp;
         }
     }
@@ -515,68 +689,63 @@ static int celix_filter_compareAttributeValue(const celix_filter_t* filter, cons
     return strcmp(propertyValue, filter->value);
 }
 
-static celix_status_t filter_compare(const celix_filter_t* filter, const char *propertyValue, bool *out) {
+/**
+ * @brief Matches the property value against the substring operands (children) of the filter.
+ *
+ * The operands are the substrings, with a NULL entry for every wildcard ('*'). A substring not preceded by a wildcard
+ * should match at the current position, a last substring preceded by a wildcard should match the end of the value and
+ * other substrings preceded by a wildcard should be found (in order) in the remaining value.
+ */
+static bool celix_filter_matchSubstring(const celix_filter_t* filter, const char* propertyValue) {
+    const char* current = propertyValue;
+    bool wildcard = false;
+    int size = celix_arrayList_size(filter->children);
+    for (int i = 0; i < size; i++) {
+        const char* substr = celix_arrayList_get(filter->children, i);
+        if (substr == NULL) {
+            wildcard = true;
+            continue;
+        }
+        size_t len = strlen(substr);
+        bool last = i + 1 == size;
+        if (!wildcard) {
+            if (strncmp(current, substr, len) != 0) {
+                return false;
+            }
+            current += len;
+            if (last && *current != '\0') {
+                return false;
+            }
+        } else if (last) {
+            size_t remaining = strlen(current);
+            if (remaining < len || strcmp(current + remaining - len, substr) != 0) {
+                return false;
+            }
+        } else {
+            const char* found = strstr(current, substr);
+            if (found == NULL) {
+                return false;
+            }
+            current = found + len;
+        }
+        wildcard = false;
+    }
+    return true;
+}
+
+static celix_status_t filter_compare(const celix_filter_t* filter, const celix_properties_entry_t* entry, bool *out) {
     celix_status_t  status = CELIX_SUCCESS;
     bool result = false;
 
-    if (filter == NULL || propertyValue == NULL) {
+    if (filter == NULL || entry == NULL || entry->value == NULL) {
         *out = false;
         return status;
     }
+    const char* propertyValue = entry->value;
 
     switch (filter->operand) {
         case CELIX_FILTER_OPERAND_SUBSTRING: {
-            int pos = 0;
-            int size = celix_arrayList_size(filter->children);
-            for (int i = 0; i < size; i++) {
-                char * substr = (char *) celix_arrayList_get(filter->children, i);
-
-                if (i + 1 < size) {
-                    if (substr == NULL) {
-                        unsigned int index;
-                        char * substr2 = (char *) celix_arrayList_get(filter->children, i + 1);
-                        if (substr2 == NULL) {
-                            continue;
-                        }
-                        index = strcspn(propertyValue+pos, substr2);
-                        if (index == strlen(propertyValue+pos)) {
-                            *out = false;
-                            return CELIX_SUCCESS;
-                        }
-
-                        pos = index + strlen(substr2);
-                        if (i + 2 < size) {
-                            i++;
-                        }
-                    } else {
-                        unsigned int len = strlen(substr);
-                        char * region = (char *)calloc(1, len+1);
-                        strncpy(region, propertyValue+pos, len);
-                        region[len]    = '\0';
-                        if (strcmp(region, substr) == 0) {
-                            pos += len;
-                        } else {
-                            free(region);
-                            *out = false;
-                            return CELIX_SUCCESS;
-                        }
-                        free(region);
-                    }
-                } else {
-                    unsigned int len;
-                    int begin;
-
-                    if (substr == NULL) {
-                        *out = true;
-                        return CELIX_SUCCESS;
-                    }
-                    len = strlen(substr);
-                    begin = strlen(propertyValue)-len;
-                    *out = (strcmp(propertyValue+begin, substr) == 0);
-                    return CELIX_SUCCESS;
-                }
-            }
-            *out = true;
+            *out = celix_filter_matchSubstring(filter, propertyValue);
             return CELIX_SUCCESS;
         }
         case CELIX_FILTER_OPERAND_APPROX: {
@@ -584,23 +753,23 @@ static celix_status_t filter_compare(const celix_filter_t* filter, const char *p
             return CELIX_SUCCESS;
         }
         case CELIX_FILTER_OPERAND_EQUAL: {
-            *out = (celix_filter_compareAttributeValue(filter, propertyValue) == 0);
+            *out = (celix_filter_compareAttributeValue(filter, entry) == 0);
             return CELIX_SUCCESS;
         }
         case CELIX_FILTER_OPERAND_GREATER: {
-            *out = (celix_filter_compareAttributeValue(filter, propertyValue) > 0);
+            *out = (celix_filter_compareAttributeValue(filter, entry) > 0);
             return CELIX_SUCCESS;
         }
         case CELIX_FILTER_OPERAND_GREATEREQUAL: {
-            *out = (celix_filter_compareAttributeValue(filter, propertyValue) >= 0);
+            *out = (celix_filter_compareAttributeValue(filter, entry) >= 0);
             return CELIX_SUCCESS;
         }
         case CELIX_FILTER_OPERAND_LESS: {
-            *out = (celix_filter_compareAttributeValue(filter, propertyValue) < 0);
+            *out = (celix_filter_compareAttributeValue(filter, entry) < 0);
             return CELIX_SUCCESS;
         }
         case CELIX_FILTER_OPERAND_LESSEQUAL: {
-            *out = (celix_filter_compareAttributeValue(filter, propertyValue) <= 0);
+            *out = (celix_filter_compareAttributeValue(filter, entry) <= 0);
             return CELIX_SUCCESS;
         }
         case CELIX_FILTER_OPERAND_AND:
@@ -700,60 +869,54 @@ void celix_filter_destroy(celix_filter_t *filter) {
         filter->filterStr = NULL;
         if (filter->internal != NULL) {
             celix_version_destroy(filter->internal->versionValue);
+            free(filter->internal->program);
             free(filter->internal);
         }
         free(filter);
     }
 }
 
+static bool celix_filter_matchLeaf(const celix_filter_t *filter, const celix_properties_t* properties) {
+    const celix_properties_entry_t* entry = celix_properties_getEntry(properties, filter->attribute);
+    if (filter->operand == CELIX_FILTER_OPERAND_PRESENT) {
+        return entry != NULL && entry->value != NULL;
+    }
+    bool result = false;
+    filter_compare(filter, entry, &result);
+    return result;
+}
+
 bool celix_filter_match(const celix_filter_t *filter, const celix_properties_t* properties) {
     if (filter == NULL) {
         return true; //matching on null(empty) filter is always true
     }
+    const celix_filter_instruction_t* program = filter->internal->program;
+    size_t programSize = filter->internal->programSize;
     bool result = false;
-    switch (filter->operand) {
-        case CELIX_FILTER_OPERAND_AND: {
-            celix_array_list_t* children = filter->children;
-            for (int i = 0; i < celix_arrayList_size(children); i++) {
-                celix_filter_t * sfilter = (celix_filter_t *) celix_arrayList_get(children, i);
-                bool mresult = celix_filter_match(sfilter, properties);
-                if (!mresult) {
-                    return false;
+    size_t pc = 0;
+    while (pc < programSize) {
+        const celix_filter_instruction_t* instruction = &program[pc];
+        switch (instruction->opcode) {
+            case CELIX_FILTER_OPCODE_MATCH:
+                result = celix_filter_matchLeaf(instruction->leaf, properties);
+                break;
+            case CELIX_FILTER_OPCODE_JUMP_IF_FALSE:
+                if (!result) {
+                    pc = instruction->jumpTarget;
+                    continue;
                 }
-            }
-            return true;
-        }
-        case CELIX_FILTER_OPERAND_OR: {
-            celix_array_list_t* children = filter->children;
-            for (int i = 0; i < celix_arrayList_size(children); i++) {
-                celix_filter_t * sfilter = (celix_filter_t *) celix_arrayList_get(children, i);
-                bool mresult = celix_filter_match(sfilter, properties);
-                if (mresult) {
-                    return true;
+                break;
+            case CELIX_FILTER_OPCODE_JUMP_IF_TRUE:
+                if (result) {
+                    pc = instruction->jumpTarget;
+                    continue;
                 }
-            }
-            return false;
-        }
-        case CELIX_FILTER_OPERAND_NOT: {
-            celix_filter_t * sfilter = celix_arrayList_get(filter->children, 0);
-            bool mresult = celix_filter_match(sfilter, properties);
-            return !mresult;
-        }
-        case CELIX_FILTER_OPERAND_SUBSTRING :
-        case CELIX_FILTER_OPERAND_EQUAL :
-        case CELIX_FILTER_OPERAND_GREATER :
-        case CELIX_FILTER_OPERAND_GREATEREQUAL :
-        case CELIX_FILTER_OPERAND_LESS :
-        case CELIX_FILTER_OPERAND_LESSEQUAL :
-        case CELIX_FILTER_OPERAND_APPROX : {
-            char * value = (properties == NULL) ? NULL: (char*)celix_properties_get(properties, filter->attribute, NULL);
-            filter_compare(filter, value, &result);
-            return result;
-        }
-        case CELIX_FILTER_OPERAND_PRESENT: {
-            char * value = (properties == NULL) ? NULL: (char*)celix_properties_get(properties, filter->attribute, NULL);
-            return value != NULL;
+                break;
+            case CELIX_FILTER_OPCODE_NOT:
+                result = !result;
+                break;
         }
+        pc += 1;
     }
     return result;
 }
@@ -23,17 +23,78 @@
 #include <ctype.h>
 #include <stdbool.h>
 
+#include <errno.h>
+#include <stdint.h>
+
 #include "properties.h"
-#include "celix_build_assert.h"
 #include "celix_properties.h"
+#include "properties_private.h"
+#include "celix_string_hash_map.h"
 #include "celix_utils.h"
 #include "utils.h"
-#include "hash_map_private.h"
-#include <errno.h>
-#include "hash_map.h"
 
 #define MALLOC_BLOCK_SIZE        5
 
+/**
+ * The nr of entries which are stored inline in the properties data. If a properties object has more entries, an
+ * additional key -> entry index (hash map) is created.
+ */
+#define CELIX_PROPERTIES_INLINE_ENTRIES 8
+
+/**
+ * The size of the inline string buffer, used for the first keys and values.
+ */
+#define CELIX_PROPERTIES_INLINE_STRING_BUFFER_SIZE 128
+
+/**
+ * The default size of an arena block, used for keys, values and entries if the inline storage is exhausted.
+ */
+#define CELIX_PROPERTIES_ARENA_BLOCK_SIZE 1024
+
+/**
+ * Values larger than this size are not stored in the arena, but allocated separately. This ensures that
+ * updating large values does not waste arena storage.
+ */
+#define CELIX_PROPERTIES_ARENA_MAX_VALUE_SIZE 256
+
+/**
+ * Max length of a value, longer values are truncated (same as the previous strndup based implementation).
+ */
+#define CELIX_PROPERTIES_MAX_VALUE_LENGTH (1024 * 1024)
+
+typedef struct celix_properties_block celix_properties_block_t;
+struct celix_properties_block {
+    celix_properties_block_t* next;
+    size_t size;
+    char data[];
+};
+
+/**
+ * @brief The (shareable) data of a properties object.
+ *
+ * Entries and strings are allocated from the inline storage or the arena blocks and are never moved, so pointers
+ * to keys and values stay valid until the entry is modified. If the data is shared (refCount > 1) the data is
+ * read-only and a properties object will clone the data before modifying it.
+ */
+typedef struct celix_properties_data {
+    size_t refCount; //atomic
+    size_t size;
+    celix_properties_entry_t* first; //entries in insertion order
+    celix_properties_entry_t* last;
+    celix_properties_entry_t* freeEntries; //removed entries, reused including their key and value storage
+    celix_string_hash_map_t* index; //key -> entry, only created when there are more than CELIX_PROPERTIES_INLINE_ENTRIES entries
+    celix_properties_block_t* blocks;
+    char* arenaPos;
+    size_t arenaAvailable;
+    size_t nrOfInlineEntriesUsed;
+    celix_properties_entry_t inlineEntries[CELIX_PROPERTIES_INLINE_ENTRIES];
+    char inlineStrings[CELIX_PROPERTIES_INLINE_STRING_BUFFER_SIZE];
+} celix_properties_data_t;
+
+struct celix_properties {
+    celix_properties_data_t* data;
+};
+
 static void parseLine(const char* line, celix_properties_t *props);
 
 properties_pt properties_create(void) {
@@ -213,19 +274,284 @@ static void parseLine(const char* line, celix_properties_t *props) {
 
 
 
+static celix_properties_data_t* celix_properties_createData(void) {
+    celix_properties_data_t* data = malloc(sizeof(*data));
+    data->refCount = 1;
+    data->size = 0;
+    data->first = NULL;
+    data->last = NULL;
+    data->freeEntries = NULL;
+    data->index = NULL;
+    data->blocks = NULL;
+    data->arenaPos = data->inlineStrings;
+    data->arenaAvailable = sizeof(data->inlineStrings);
+    data->nrOfInlineEntriesUsed = 0;
+    return data;
+}
+
+static void celix_properties_releaseEntryValue(celix_properties_entry_t* entry) {
+    if (entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_VERSION) {
+        celix_version_destroy(entry->typed.versionValue);
+    }
+    entry->valueType = CELIX_PROPERTIES_VALUE_TYPE_STRING;
+}
+
+static void celix_properties_destroyData(celix_properties_data_t* data) {
+    for (celix_properties_entry_t* entry = data->first; entry != NULL; entry = entry->next) {
+        celix_properties_releaseEntryValue(entry);
+        if (entry->valueIsAllocated) {
+            free(entry->value);
+        }
+    }
+    for (celix_properties_entry_t* entry = data->freeEntries; entry != NULL; entry = entry->next) {
+        if (entry->valueIsAllocated) {
+            free(entry->value);
+        }
+    }
+    celix_stringHashMap_destroy(data->index);
+    celix_properties_block_t* block = data->blocks;
+    while (block != NULL) {
+        celix_properties_block_t* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(data);
+}
+
+static void celix_properties_releaseData(celix_properties_data_t* data) {
+    if (data != NULL && __atomic_sub_fetch(&data->refCount, 1, __ATOMIC_ACQ_REL) == 0) {
+        celix_properties_destroyData(data);
+    }
+}
+
+/**
+ * @brief Ensures that the arena has at least size bytes available in a single block.
+ */
+static void celix_properties_reserve(celix_properties_data_t* data, size_t size) {
+    if (size > data->arenaAvailable) {
+        size_t blockSize = size > CELIX_PROPERTIES_ARENA_BLOCK_SIZE ? size : CELIX_PROPERTIES_ARENA_BLOCK_SIZE;
+        celix_properties_block_t* block = malloc(sizeof(*block) + blockSize);
+        block->size = blockSize;
+        block->next = data->blocks;
+        data->blocks = block;
+        data->arenaPos = block->data;
+        data->arenaAvailable = blockSize;
+    }
+}
+
+static void* celix_properties_allocate(celix_properties_data_t* data, size_t size, size_t alignment) {
+    size_t padding = (alignment - ((uintptr_t)data->arenaPos % alignment)) % alignment;
+    if (size + padding > data->arenaAvailable) {
+        celix_properties_reserve(data, size + alignment);
+        padding = (alignment - ((uintptr_t)data->arenaPos % alignment)) % alignment;
+    }
+    void* result = data->arenaPos + padding;
+    data->arenaPos += padding + size;
+    data->arenaAvailable -= padding + size;
+    return result;
+}
+
+static size_t celix_properties_valueCapacityFor(size_t size) {
+    //note rounding up, so that updating a value with a slightly larger value can be done in place
+    size_t capacity = 16;
+    while (capacity < size) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static void celix_properties_setEntryString(celix_properties_data_t* data, celix_properties_entry_t* entry, const char* value, size_t len) {
+    if (value == NULL) {
+        if (entry->valueIsAllocated) {
+            free(entry->value);
+        }
+        entry->value = NULL;
+        entry->valueIsAllocated = false;
+        entry->valueCapacity = 0;
+        return;
+    }
+    if (len + 1 > entry->valueCapacity) {
+        if (entry->valueIsAllocated) {
+            free(entry->value);
+        }
+        if (len + 1 > CELIX_PROPERTIES_ARENA_MAX_VALUE_SIZE) {
+            entry->valueCapacity = len + 1;
+            entry->value = malloc(entry->valueCapacity);
+            entry->valueIsAllocated = true;
+        } else {
+            entry->valueCapacity = celix_properties_valueCapacityFor(len + 1);
+            entry->value = celix_properties_allocate(data, entry->valueCapacity, 1);
+            entry->valueIsAllocated = false;
+        }
+    }
+    memcpy(entry->value, value, len);
+    entry->value[len] = '\0';
+}
+
+static celix_properties_entry_t* celix_properties_findEntry(const celix_properties_data_t* data, const char* key) {
+    if (key == NULL) {
+        return NULL;
+    }
+    if (data->index != NULL) {
+        return celix_stringHashMap_get(data->index, key);
+    }
+    for (celix_properties_entry_t* entry = data->first; entry != NULL; entry = entry->next) {
+        if (strcmp(entry->key, key) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void celix_properties_createIndex(celix_properties_data_t* data) {
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.storeKeysWeakly = true; //note keys are stored in the entries
+    opts.initialCapacity = CELIX_PROPERTIES_INLINE_ENTRIES * 4;
+    data->index = celix_stringHashMap_createWithOptions(&opts);
+    for (celix_properties_entry_t* entry = data->first; entry != NULL; entry = entry->next) {
+        celix_stringHashMap_put(data->index, entry->key, entry);
+    }
+}
+
+static celix_properties_entry_t* celix_properties_createEntry(celix_properties_data_t* data, const char* key) {
+    size_t keySize = strlen(key) + 1;
+    celix_properties_entry_t* entry;
+    if (data->freeEntries != NULL) {
+        entry = data->freeEntries;
+        data->freeEntries = entry->next;
+    } else {
+        if (data->nrOfInlineEntriesUsed < CELIX_PROPERTIES_INLINE_ENTRIES) {
+            entry = &data->inlineEntries[data->nrOfInlineEntriesUsed++];
+        } else {
+            entry = celix_properties_allocate(data, sizeof(*entry), __alignof__(celix_properties_entry_t));
+        }
+        memset(entry, 0, sizeof(*entry));
+    }
+    if (keySize > entry->keyCapacity) {
+        entry->key = celix_properties_allocate(data, keySize, 1);
+        entry->keyCapacity = keySize;
+    }
+    memcpy(entry->key, key, keySize);
+    entry->valueType = CELIX_PROPERTIES_VALUE_TYPE_STRING;
+
+    entry->next = NULL;
+    entry->prev = data->last;
+    if (data->last != NULL) {
+        data->last->next = entry;
+    } else {
+        data->first = entry;
+    }
+    data->last = entry;
+    data->size += 1;
+
+    if (data->index != NULL) {
+        celix_stringHashMap_put(data->index, entry->key, entry);
+    } else if (data->size > CELIX_PROPERTIES_INLINE_ENTRIES) {
+        celix_properties_createIndex(data);
+    }
+    return entry;
+}
+
+static void celix_properties_removeEntry(celix_properties_data_t* data, celix_properties_entry_t* entry) {
+    if (data->index != NULL) {
+        celix_stringHashMap_remove(data->index, entry->key);
+    }
+    if (entry->prev != NULL) {
+        entry->prev->next = entry->next;
+    } else {
+        data->first = entry->next;
+    }
+    if (entry->next != NULL) {
+        entry->next->prev = entry->prev;
+    } else {
+        data->last = entry->prev;
+    }
+    data->size -= 1;
+
+    celix_properties_releaseEntryValue(entry);
+    entry->prev = NULL;
+    entry->next = data->freeEntries;
+    data->freeEntries = entry;
+}
+
+/**
+ * @brief Creates a (compact) deep copy of the provided data. All strings are stored in at most a single arena block.
+ */
+static celix_properties_data_t* celix_properties_cloneData(const celix_properties_data_t* data) {
+    celix_properties_data_t* clone = celix_properties_createData();
+    size_t required = 0;
+    size_t count = 0;
+    for (const celix_properties_entry_t* entry = data->first; entry != NULL; entry = entry->next) {
+        required += strlen(entry->key) + 1;
+        size_t valueSize = entry->value == NULL ? 0 : strlen(entry->value) + 1;
+        if (valueSize <= CELIX_PROPERTIES_ARENA_MAX_VALUE_SIZE) {
+            required += valueSize;
+        }
+        if (++count > CELIX_PROPERTIES_INLINE_ENTRIES) {
+            required += sizeof(celix_properties_entry_t) + __alignof__(celix_properties_entry_t);
+        }
+    }
+    celix_properties_reserve(clone, required);
+
+    for (const celix_properties_entry_t* entry = data->first; entry != NULL; entry = entry->next) {
+        celix_properties_entry_t* copy = celix_properties_createEntry(clone, entry->key);
+        if (entry->value != NULL) {
+            size_t len = strlen(entry->value);
+            if (len + 1 <= CELIX_PROPERTIES_ARENA_MAX_VALUE_SIZE) {
+                //note exact capacity, a clone is compact
+                copy->value = celix_properties_allocate(clone, len + 1, 1);
+                copy->valueCapacity = len + 1;
+                memcpy(copy->value, entry->value, len + 1);
+            } else {
+                celix_properties_setEntryString(clone, copy, entry->value, len);
+            }
+        }
+        copy->valueType = entry->valueType;
+        copy->typed = entry->typed;
+        if (entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_VERSION) {
+            copy->typed.versionValue = celix_version_copy(entry->typed.versionValue);
+        }
+    }
+    return clone;
+}
+
+/**
+ * @brief Returns the properties data for modification. If the data is shared with a copy, the data is cloned first
+ * and the shared data is released (and destroyed by the last copy releasing it).
+ */
+static celix_properties_data_t* celix_properties_prepareWrite(celix_properties_t* properties) {
+    celix_properties_data_t* data = properties->data;
+    if (__atomic_load_n(&data->refCount, __ATOMIC_ACQUIRE) > 1) {
+        properties->data = celix_properties_cloneData(data);
+        celix_properties_releaseData(data);
+    }
+    return properties->data;
+}
+
+/**
+ * @brief Returns the entry for the provided key, creating one if needed. Any typed value of an existing entry is released.
+ */
+static celix_properties_entry_t* celix_properties_prepareEntry(celix_properties_t* properties, const char* key) {
+    celix_properties_data_t* data = celix_properties_prepareWrite(properties);
+    celix_properties_entry_t* entry = celix_properties_findEntry(data, key);
+    if (entry == NULL) {
+        entry = celix_properties_createEntry(data, key);
+    } else {
+        celix_properties_releaseEntryValue(entry);
+    }
+    return entry;
+}
+
 celix_properties_t* celix_properties_create(void) {
-    return hashMap_create(utils_stringHash, utils_stringHash, utils_stringEquals, utils_stringEquals);
+    celix_properties_t* properties = malloc(sizeof(*properties));
+    properties->data = celix_properties_createData();
+    return properties;
 }
 
 void celix_properties_destroy(celix_properties_t *properties) {
     if (properties != NULL) {
-        hash_map_iterator_pt iter = hashMapIterator_create(properties);
-        while (hashMapIterator_hasNext(iter)) {
-            hash_map_entry_pt entry = hashMapIterator_nextEntry(iter);
-            hashMapEntry_clear(entry, true, true);
-        }
-        hashMapIterator_destroy(iter);
-        hashMap_destroy(properties, false, false);
+        celix_properties_releaseData(properties->data);
+        free(properties);
     }
 }
 
@@ -302,37 +628,24 @@ celix_properties_t* celix_properties_loadFromString(const char *input) {
     return props;
 }
 
+static void celix_properties_storeEscaped(FILE* file, const char* str) {
+    for (size_t i = 0; str != NULL && str[i] != '\0'; i += 1) {
+        if (str[i] == '#' || str[i] == '!' || str[i] == '=' || str[i] == ':') {
+            fputc('\\', file);
+        }
+        fputc(str[i], file);
+    }
+}
+
 void celix_properties_store(celix_properties_t *properties, const char *filename, const char *header) {
     FILE *file = fopen (filename, "w+" );
-    char *str;
 
     if (file != NULL) {
-        if (hashMap_size(properties) > 0) {
-            hash_map_iterator_pt iterator = hashMapIterator_create(properties);
-            while (hashMapIterator_hasNext(iterator)) {
-                hash_map_entry_pt entry = hashMapIterator_nextEntry(iterator);
-                str = hashMapEntry_getKey(entry);
-                for (int i = 0; i < strlen(str); i += 1) {
-                    if (str[i] == '#' || str[i] == '!' || str[i] == '=' || str[i] == ':') {
-                        fputc('\\', file);
-                    }
-                    fputc(str[i], file);
-                }
-
-                fputc('=', file);
-
-                str = hashMapEntry_getValue(entry);
-                for (int i = 0; i < strlen(str); i += 1) {
-                    if (str[i] == '#' || str[i] == '!' || str[i] == '=' || str[i] == ':') {
-                        fputc('\\', file);
-                    }
-                    fputc(str[i], file);
-                }
-
-                fputc('\n', file);
-
-            }
-            hashMapIterator_destroy(iterator);
+        for (const celix_properties_entry_t* entry = properties->data->first; entry != NULL; entry = entry->next) {
+            celix_properties_storeEscaped(file, entry->key);
+            fputc('=', file);
+            celix_properties_storeEscaped(file, entry->value);
+            fputc('\n', file);
         }
         fclose(file);
     } else {
@@ -341,66 +654,54 @@ void celix_properties_store(celix_properties_t *properties, const char *filename
 }
 
 celix_properties_t* celix_properties_copy(const celix_properties_t *properties) {
-    celix_properties_t *copy = celix_properties_create();
-    if (properties != NULL) {
-        hash_map_iterator_t iter = hashMapIterator_construct((hash_map_t*)properties);
-        while (hashMapIterator_hasNext(&iter)) {
-            hash_map_entry_pt entry = hashMapIterator_nextEntry(&iter);
-            char *key = hashMapEntry_getKey(entry);
-            char *value = hashMapEntry_getValue(entry);
-            celix_properties_set(copy, key, value);
-        }
+    if (properties == NULL) {
+        return celix_properties_create();
     }
+    //note copy-on-write, the data is shared until one of the properties objects is modified
+    celix_properties_t* copy = malloc(sizeof(*copy));
+    __atomic_add_fetch(&properties->data->refCount, 1, __ATOMIC_RELAXED);
+    copy->data = properties->data;
     return copy;
 }
 
+const celix_properties_entry_t* celix_properties_getEntry(const celix_properties_t* properties, const char* key) {
+    return properties == NULL ? NULL : celix_properties_findEntry(properties->data, key);
+}
+
 const char* celix_properties_get(const celix_properties_t *properties, const char *key, const char *defaultValue) {
-    const char* value = NULL;
-    if (properties != NULL) {
-        value = hashMap_get((hash_map_t*)properties, (void*)key);
-    }
-    return value == NULL ? defaultValue : value;
+    const celix_properties_entry_t* entry = properties == NULL ? NULL : celix_properties_findEntry(properties->data, key);
+    return entry == NULL || entry->value == NULL ? defaultValue : entry->value;
 }
 
 void celix_properties_set(celix_properties_t *properties, const char *key, const char *value) {
-    if (properties != NULL) {
-        hash_map_entry_pt entry = hashMap_getEntry(properties, key);
-        char *oldVal = NULL;
-        char *newVal = value == NULL ? NULL : strndup(value, 1024 * 1024);
-        if (entry != NULL) {
-            char *oldKey = hashMapEntry_getKey(entry);
-            oldVal = hashMapEntry_getValue(entry);
-            hashMap_put(properties, oldKey, newVal);
-        } else {
-            hashMap_put(properties, strndup(key, 1024 * 1024), newVal);
-        }
-        free(oldVal);
+    if (properties != NULL && key != NULL) {
+        celix_properties_entry_t* entry = celix_properties_prepareEntry(properties, key);
+        size_t len = value == NULL ? 0 : strnlen(value, CELIX_PROPERTIES_MAX_VALUE_LENGTH);
+        celix_properties_setEntryString(properties->data, entry, value, len);
     }
 }
 
 void celix_properties_setWithoutCopy(celix_properties_t *properties, char *key, char *value) {
-    if (properties != NULL) {
-        hash_map_entry_pt entry = hashMap_getEntry(properties, key);
-        char *oldVal = NULL;
-        if (entry != NULL) {
-            char *oldKey = hashMapEntry_getKey(entry);
-            oldVal = hashMapEntry_getValue(entry);
-            hashMap_put(properties, oldKey, value);
-        } else {
-            hashMap_put(properties, key, value);
-        }
-        free(oldVal);
-    }
+    //note the key and value are stored in the properties arena, so the provided strings can be freed directly
+    celix_properties_set(properties, key, value);
+    free(key);
+    free(value);
 }
 
 void celix_properties_unset(celix_properties_t *properties, const char *key) {
-    char* oldValue = hashMap_removeFreeKey(properties, key);
-    free(oldValue);
+    if (properties != NULL && celix_properties_findEntry(properties->data, key) != NULL) {
+        celix_properties_data_t* data = celix_properties_prepareWrite(properties);
+        celix_properties_removeEntry(data, celix_properties_findEntry(data, key));
+    }
 }
 
 long celix_properties_getAsLong(const celix_properties_t *props, const char *key, long defaultValue) {
+    const celix_properties_entry_t* entry = props == NULL ? NULL : celix_properties_findEntry(props->data, key);
+    if (entry != NULL && entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_LONG) {
+        return entry->typed.longValue;
+    }
     long result = defaultValue;
-    const char *val = celix_properties_get(props, key, NULL);
+    const char *val = entry == NULL ? NULL : entry->value;
     if (val != NULL) {
         char *enptr = NULL;
         errno = 0;
@@ -412,19 +713,48 @@ long celix_properties_getAsLong(const celix_properties_t *props, const char *key
     return result;
 }
 
+/**
+ * @brief Formats a long value, returns the length of the formatted string. The buffer should be at least 21 bytes.
+ */
+static size_t celix_properties_formatLong(char* buf, long value) {
+    char tmp[24];
+    size_t len = 0;
+    unsigned long uValue = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+    do {
+        tmp[len++] = (char)('0' + (uValue % 10));
+        uValue /= 10;
+    } while (uValue != 0);
+    size_t pos = 0;
+    if (value < 0) {
+        buf[pos++] = '-';
+    }
+    while (len > 0) {
+        buf[pos++] = tmp[--len];
+    }
+    buf[pos] = '\0';
+    return pos;
+}
+
 void celix_properties_setLong(celix_properties_t *props, const char *key, long value) {
-    char buf[32]; //should be enough to store long long int
-    int writen = snprintf(buf, 32, "%li", value);
-    if (writen <= 31) {
-        celix_properties_set(props, key, buf);
-    } else {
-        fprintf(stderr,"buf to small for value '%li'\n", value);
+    if (props != NULL && key != NULL) {
+        char buf[32];
+        size_t len = celix_properties_formatLong(buf, value);
+        celix_properties_entry_t* entry = celix_properties_prepareEntry(props, key);
+        celix_properties_setEntryString(props->data, entry, buf, len);
+        entry->valueType = CELIX_PROPERTIES_VALUE_TYPE_LONG;
+        entry->typed.longValue = value;
     }
 }
 
 double celix_properties_getAsDouble(const celix_properties_t *props, const char *key, double defaultValue) {
+    const celix_properties_entry_t* entry = props == NULL ? NULL : celix_properties_findEntry(props->data, key);
+    if (entry != NULL && entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_DOUBLE) {
+        return entry->typed.doubleValue;
+    } else if (entry != NULL && entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_LONG) {
+        return (double)entry->typed.longValue;
+    }
     double result = defaultValue;
-    const char *val = celix_properties_get(props, key, NULL);
+    const char *val = entry == NULL ? NULL : entry->value;
     if (val != NULL) {
         char *enptr = NULL;
         errno = 0;
@@ -439,16 +769,23 @@ double celix_properties_getAsDouble(const celix_properties_t *props, const char
 void celix_properties_setDouble(celix_properties_t *props, const char *key, double val) {
     char buf[32]; //should be enough to store long long int
     int writen = snprintf(buf, 32, "%f", val);
-    if (writen <= 31) {
-        celix_properties_set(props, key, buf);
-    } else {
+    if (writen > 31) {
         fprintf(stderr,"buf to small for value '%f'\n", val);
+    } else if (props != NULL && key != NULL) {
+        celix_properties_entry_t* entry = celix_properties_prepareEntry(props, key);
+        celix_properties_setEntryString(props->data, entry, buf, (size_t)writen);
+        entry->valueType = CELIX_PROPERTIES_VALUE_TYPE_DOUBLE;
+        entry->typed.doubleValue = val;
     }
 }
 
 bool celix_properties_getAsBool(const celix_properties_t *props, const char *key, bool defaultValue) {
+    const celix_properties_entry_t* entry = props == NULL ? NULL : celix_properties_findEntry(props->data, key);
+    if (entry != NULL && entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_BOOL) {
+        return entry->typed.boolValue;
+    }
     bool result = defaultValue;
-    const char *val = celix_properties_get(props, key, NULL);
+    const char *val = entry == NULL ? NULL : entry->value;
     if (val != NULL) {
         char buf[32];
         snprintf(buf, 32, "%s", val);
@@ -463,50 +800,95 @@ bool celix_properties_getAsBool(const celix_properties_t *props, const char *key
 }
 
 void celix_properties_setBool(celix_properties_t *props, const char *key, bool val) {
-    celix_properties_set(props, key, val ? "true" : "false");
+    if (props != NULL && key != NULL) {
+        const char* str = val ? "true" : "false";
+        celix_properties_entry_t* entry = celix_properties_prepareEntry(props, key);
+        celix_properties_setEntryString(props->data, entry, str, strlen(str));
+        entry->valueType = CELIX_PROPERTIES_VALUE_TYPE_BOOL;
+        entry->typed.boolValue = val;
+    }
+}
+
+void celix_properties_setVersion(celix_properties_t *props, const char *key, const celix_version_t* version) {
+    if (props != NULL && key != NULL && version != NULL) {
+        char buf[64];
+        const char* qualifier = celix_version_getQualifier(version);
+        int len;
+        if (qualifier != NULL && qualifier[0] != '\0') {
+            len = snprintf(buf, sizeof(buf), "%d.%d.%d.%s", celix_version_getMajor(version), celix_version_getMinor(version), celix_version_getMicro(version), qualifier);
+        } else {
+            len = snprintf(buf, sizeof(buf), "%d.%d.%d", celix_version_getMajor(version), celix_version_getMinor(version), celix_version_getMicro(version));
+        }
+        char* str = len < (int)sizeof(buf) ? buf : celix_version_toString(version);
+        celix_properties_entry_t* entry = celix_properties_prepareEntry(props, key);
+        celix_properties_setEntryString(props->data, entry, str, strlen(str));
+        entry->valueType = CELIX_PROPERTIES_VALUE_TYPE_VERSION;
+        entry->typed.versionValue = celix_version_copy(version);
+        if (str != buf) {
+            free(str);
+        }
+    }
+}
+
+const celix_version_t* celix_properties_getVersion(const celix_properties_t *props, const char *key, const celix_version_t* defaultValue) {
+    const celix_properties_entry_t* entry = props == NULL ? NULL : celix_properties_findEntry(props->data, key);
+    if (entry != NULL && entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_VERSION) {
+        return entry->typed.versionValue;
+    }
+    return defaultValue;
+}
+
+celix_version_t* celix_properties_getAsVersion(const celix_properties_t *props, const char *key, const celix_version_t* defaultValue) {
+    const celix_properties_entry_t* entry = props == NULL ? NULL : celix_properties_findEntry(props->data, key);
+    if (entry != NULL && entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_VERSION) {
+        return celix_version_copy(entry->typed.versionValue);
+    }
+    celix_version_t* result = NULL;
+    if (entry != NULL && entry->value != NULL) {
+        result = celix_version_createVersionFromString(entry->value);
+    }
+    if (result == NULL && defaultValue != NULL) {
+        result = celix_version_copy(defaultValue);
+    }
+    return result;
+}
+
+celix_properties_value_type_e celix_properties_getType(const celix_properties_t *props, const char *key) {
+    const celix_properties_entry_t* entry = props == NULL ? NULL : celix_properties_findEntry(props->data, key);
+    return entry == NULL ? CELIX_PROPERTIES_VALUE_TYPE_UNSET : entry->valueType;
+}
+
+bool celix_properties_hasKey(const celix_properties_t *props, const char *key) {
+    return props != NULL && celix_properties_findEntry(props->data, key) != NULL;
 }
 
 int celix_properties_size(const celix_properties_t *properties) {
-    return hashMap_size((hash_map_t*)properties);
+    return properties == NULL ? 0 : (int)properties->data->size;
 }
 
 celix_properties_iterator_t celix_propertiesIterator_construct(const celix_properties_t *properties) {
     celix_properties_iterator_t iter;
-    CELIX_BUILD_ASSERT(sizeof(celix_properties_iterator_t) == sizeof(hash_map_iterator_t));
-    CELIX_BUILD_ASSERT(__alignof__(celix_properties_iterator_t) == __alignof__(hash_map_iterator_t));
-    hash_map_iterator_t mapIter = hashMapIterator_construct((hash_map_t*)properties);
-    iter._data1 = mapIter.map;
-    iter._data2 = mapIter.next;
-    iter._data3 = mapIter.current;
-    iter._data4 = mapIter.expectedModCount;
-    iter._data5 = mapIter.index;
+    iter._data1 = (void*)properties;
+    iter._data2 = properties == NULL ? NULL : properties->data->first; //next entry
+    iter._data3 = NULL; //current entry
+    iter._data4 = 0;
+    iter._data5 = 0; //index
     return iter;
 }
 
 bool celix_propertiesIterator_hasNext(celix_properties_iterator_t *iter) {
-    hash_map_iterator_t mapIter;
-    mapIter.map = iter->_data1;
-    mapIter.next = iter->_data2;
-    mapIter.current = iter->_data3;
-    mapIter.expectedModCount = iter->_data4;
-    mapIter.index = iter->_data5;
-    bool hasNext = hashMapIterator_hasNext(&mapIter);
-    return hasNext;
+    return iter->_data2 != NULL;
 }
+
 const char* celix_propertiesIterator_nextKey(celix_properties_iterator_t *iter) {
-    hash_map_iterator_t mapIter;
-    mapIter.map = iter->_data1;
-    mapIter.next = iter->_data2;
-    mapIter.current = iter->_data3;
-    mapIter.expectedModCount = iter->_data4;
-    mapIter.index = iter->_data5;
-    const char* result = (const char*)hashMapIterator_nextKey(&mapIter);
-    iter->_data1 = mapIter.map;
-    iter->_data2 = mapIter.next;
-    iter->_data3 = mapIter.current;
-    iter->_data4 = mapIter.expectedModCount;
-    iter->_data5 = mapIter.index;
-    return result;
+    celix_properties_entry_t* entry = iter->_data2;
+    if (entry == NULL) {
+        return NULL;
+    }
+    iter->_data3 = entry;
+    iter->_data2 = entry->next;
+    iter->_data5 += 1;
+    return entry->key;
 }
 
 celix_properties_t* celix_propertiesIterator_properties(celix_properties_iterator_t *iter) {
@@ -0,0 +1,63 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_PROPERTIES_PRIVATE_H_
+#define CELIX_PROPERTIES_PRIVATE_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "celix_properties.h"
+#include "celix_version.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct celix_properties_entry celix_properties_entry_t;
+struct celix_properties_entry {
+    char* key;
+    char* value; //string representation of the value, can be NULL
+    size_t keyCapacity;
+    size_t valueCapacity; //capacity of the value storage, used to update a value in place
+    bool valueIsAllocated; //whether the value storage is allocated separately (not in the arena)
+    celix_properties_value_type_e valueType;
+    union {
+        long longValue;
+        double doubleValue;
+        bool boolValue;
+        celix_version_t* versionValue;
+    } typed;
+    celix_properties_entry_t* prev;
+    celix_properties_entry_t* next;
+};
+
+/**
+ * @brief Returns the entry for the provided key or NULL if the key is not present.
+ *
+ * Used by the filter to match typed values without parsing the string value.
+ * The returned entry is owned by the properties object and is valid until the properties object is modified.
+ */
+const celix_properties_entry_t* celix_properties_getEntry(const celix_properties_t* properties, const char* key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_PROPERTIES_PRIVATE_H_ */
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <limits.h>
 #include <celix_utils.h>
 
 #include "celix_version.h"
@@ -148,81 +149,91 @@ celix_version_t* celix_version_copy(const celix_version_t* version) {
 }
 
 
-celix_version_t* celix_version_createVersionFromString(const char *versionStr) {
-    if (versionStr == NULL) {
-        return NULL;
+static bool celix_version_parseNumber(const char* begin, const char* end, int* number) {
+    long long result = 0;
+    for (const char* c = begin; c < end; ++c) {
+        if (*c < '0' || *c > '9') {
+            return false;
+        }
+        result = result * 10 + (*c - '0');
+        if (result > INT_MAX) {
+            return false;
+        }
     }
+    *number = (int)result;
+    return true;
+}
 
-    int major = 0;
-    int minor = 0;
-    int micro = 0;
-    char * qualifier = NULL;
-
-    char delims[] = ".";
-    char *token = NULL;
-    char *last = NULL;
-
-    int i = 0;
-
-    char* versionWrkStr = strdup(versionStr);
+static bool celix_version_isValidQualifierChar(char ch) {
+    return (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') || ch == '_' || ch == '-';
+}
 
-    celix_status_t status = CELIX_SUCCESS;
-    token = strtok_r(versionWrkStr, delims, &last);
-    if (token != NULL) {
-        for (i = 0; i < strlen(token); i++) {
-            char ch = token[i];
-            if (('0' <= ch) && (ch <= '9')) {
-                continue;
-            }
-            status = CELIX_ILLEGAL_ARGUMENT;
-            break;
+bool celix_version_parse(const char* str, size_t len, int* majorOut, int* minorOut, int* microOut,
+                         const char** qualifierOut, size_t* qualifierLenOut) {
+    *majorOut = 0;
+    *minorOut = 0;
+    *microOut = 0;
+    *qualifierOut = "";
+    *qualifierLenOut = 0;
+
+    //note like strtok, empty tokens (consecutive dots) are skipped
+    const char* end = str + len;
+    const char* token = str;
+    int tokenIndex = 0;
+    while (token < end) {
+        if (*token == '.') {
+            ++token;
+            continue;
         }
-        major = atoi(token);
-        token = strtok_r(NULL, delims, &last);
-        if (token != NULL) {
-            for (i = 0; i < strlen(token); i++) {
-                char ch = token[i];
-                if (('0' <= ch) && (ch <= '9')) {
-                    continue;
-                }
-                status = CELIX_ILLEGAL_ARGUMENT;
-                break;
-            }
-            minor = atoi(token);
-            token = strtok_r(NULL, delims, &last);
-            if (token != NULL) {
-                for (i = 0; i < strlen(token); i++) {
-                    char ch = token[i];
-                    if (('0' <= ch) && (ch <= '9')) {
-                        continue;
-                    }
-                    status = CELIX_ILLEGAL_ARGUMENT;
-                    break;
-                }
-                micro = atoi(token);
-                token = strtok_r(NULL, delims, &last);
-                if (token != NULL) {
-                    qualifier = strdup(token);
-                    token = strtok_r(NULL, delims, &last);
-                    if (token != NULL) {
-                        status = CELIX_ILLEGAL_ARGUMENT;
-                    }
+        const char* tokenEnd = token;
+        while (tokenEnd < end && *tokenEnd != '.') {
+            ++tokenEnd;
+        }
+        if (tokenIndex == 0 && !celix_version_parseNumber(token, tokenEnd, majorOut)) {
+            return false;
+        } else if (tokenIndex == 1 && !celix_version_parseNumber(token, tokenEnd, minorOut)) {
+            return false;
+        } else if (tokenIndex == 2 && !celix_version_parseNumber(token, tokenEnd, microOut)) {
+            return false;
+        } else if (tokenIndex == 3) {
+            for (const char* c = token; c < tokenEnd; ++c) {
+                if (!celix_version_isValidQualifierChar(*c)) {
+                    return false;
                 }
             }
+            *qualifierOut = token;
+            *qualifierLenOut = tokenEnd - token;
+        } else if (tokenIndex > 3) {
+            return false;
         }
+        tokenIndex += 1;
+        token = tokenEnd;
     }
+    return true;
+}
 
-    free(versionWrkStr);
-
-    celix_version_t* version = NULL;
-    if (status == CELIX_SUCCESS) {
-        version = celix_version_createVersion(major, minor, micro, qualifier);
+celix_version_t* celix_version_createVersionFromString(const char *versionStr) {
+    if (versionStr == NULL) {
+        return NULL;
     }
 
-    if (qualifier != NULL) {
-        free(qualifier);
+    int major;
+    int minor;
+    int micro;
+    const char* qualifier;
+    size_t qualifierLen;
+    if (!celix_version_parse(versionStr, strlen(versionStr), &major, &minor, &micro, &qualifier, &qualifierLen)) {
+        return NULL;
     }
 
+    char qualifierBuffer[64];
+    char* qualifierStr = celix_utils_writeOrCreateString(qualifierBuffer, sizeof(qualifierBuffer), "%.*s",
+                                                         (int)qualifierLen, qualifier);
+    if (qualifierStr == NULL) {
+        return NULL;
+    }
+    celix_version_t* version = celix_version_createVersion(major, minor, micro, qualifierStr);
+    celix_utils_freeStringIfNotEqual(qualifierBuffer, qualifierStr);
     return version;
 }
 
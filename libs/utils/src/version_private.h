@@ -20,6 +20,13 @@
 #ifndef VERSION_PRIVATE_H_
 #define VERSION_PRIVATE_H_
 
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 struct celix_version {
     int major;
     int minor;
@@ -27,5 +34,21 @@ struct celix_version {
     char *qualifier;
 };
 
+/**
+ * @brief Parses the version string of len chars without allocating.
+ *
+ * The version string is parsed as "major(.minor(.micro(.qualifier)?)?)?", where empty parts (consecutive dots) are
+ * skipped. The major, minor and micro must be non-negative ints and the qualifier can only contain the characters
+ * [A-Za-z0-9_-]. The qualifier is not copied, qualifierOut points into str and is not '\0' terminated.
+ *
+ * @return true if the string is a valid version.
+ */
+bool celix_version_parse(const char* str, size_t len, int* majorOut, int* minorOut, int* microOut,
+                         const char** qualifierOut, size_t* qualifierLenOut);
+
+#ifdef __cplusplus
+}
+#endif
+
 
 #endif /* VERSION_PRIVATE_H_ */
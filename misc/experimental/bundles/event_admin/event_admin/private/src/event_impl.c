@@ -72,8 +72,8 @@ celix_status_t eventAdmin_event_equals( event_pt *event, event_pt *compare, bool
 	if(event == compare){
 		(*result) = true;
 	}else {
-		int sizeofEvent = hashMap_size((*event)->properties);
-		int sizeofCompare = hashMap_size((*compare)->properties);
+		int sizeofEvent = celix_properties_size((*event)->properties);
+		int sizeofCompare = celix_properties_size((*compare)->properties);
 		if(sizeofEvent == sizeofCompare){
 			(*result) = true;
 		}else {
@@ -93,13 +93,9 @@ celix_status_t eventAdmin_getProperty(event_pt *event, char *propertyKey, const
 celix_status_t eventAdmin_getPropertyNames( event_pt *event, array_list_pt *names){
 	celix_status_t status = CELIX_SUCCESS;
 	properties_pt properties =  (*event)->properties;
-	if (hashMap_size(properties) > 0) {
-		hash_map_iterator_pt iterator = hashMapIterator_create(properties);
-		while (hashMapIterator_hasNext(iterator)) {
-			hash_map_entry_pt entry = hashMapIterator_nextEntry(iterator);
-			char * key =hashMapEntry_getKey(entry);
-			arrayList_add((*names),key);
-		}
+	const char* key;
+	CELIX_PROPERTIES_FOR_EACH(properties, key) {
+		arrayList_add((*names), (char*)key);
 	}
 	return status;
 }